@@ -0,0 +1,210 @@
+package ffi
+
+import (
+	"runtime"
+	"unsafe"
+)
+
+// Event types delivered through an event queue (ShimEventType in shim.h).
+const (
+	EventICECandidate       = 1
+	EventConnectionState    = 2
+	EventICEConnectionState = 3
+	EventICEGatheringState  = 4
+	EventSignalingState     = 5
+	EventNegotiationNeeded  = 6
+	EventTrack              = 7
+	EventDataChannel        = 8
+	EventDataChannelOpen    = 9
+	EventDataChannelClose   = 10
+	EventDataChannelMessage = 11
+	EventVideoFrame         = 12
+	EventAudioFrame         = 13
+	EventRTCPFeedback       = 14
+	EventEncodedVideoFrame  = 15
+)
+
+// Event matches ShimEvent in shim.h.
+type Event struct {
+	Type           int32
+	Value          int32
+	Tag            uint64
+	Object         uintptr
+	Object2        uintptr
+	Width          int32
+	Height         int32
+	TimestampUs    int64
+	PayloadOffset  int32
+	PayloadLen     int32
+	CaptureTimeUs  int64
+	HasCaptureTime int32
+}
+
+// Payload returns the event's payload within the buffer passed to EventQueueDrain.
+func (e *Event) Payload(buf []byte) []byte {
+	return buf[e.PayloadOffset : e.PayloadOffset+e.PayloadLen]
+}
+
+// CreateEventQueue creates an event queue holding up to capacity pending
+// events (rounded up to a power of two; 0 for the default).
+func CreateEventQueue(capacity int) (uintptr, error) {
+	if !libLoaded.Load() || shimEventQueueCreate == nil {
+		return 0, ErrLibraryNotLoaded
+	}
+
+	var errBuf ShimErrorBuffer
+	params := shimEventQueueCreateParams{
+		Capacity: int32(capacity),
+		ErrorOut: errBuf.Ptr(),
+	}
+	queue := shimEventQueueCreate(uintptr(unsafe.Pointer(&params)))
+	runtime.KeepAlive(&params)
+	if queue == 0 {
+		msg := errBuf.String()
+		if msg != "" {
+			return 0, &ShimErrorWithMessage{Code: ShimErrInitFailed, Message: msg}
+		}
+		return 0, ErrInitFailed
+	}
+	return queue, nil
+}
+
+// EventQueueFD returns the queue's non-blocking notification fd, or -1.
+// The fd is owned by the queue; duplicate it before wrapping it in an *os.File.
+func EventQueueFD(queue uintptr) int {
+	if !libLoaded.Load() || shimEventQueueFD == nil || queue == 0 {
+		return -1
+	}
+	return int(shimEventQueueFD(queue))
+}
+
+// EventQueueDestroy destroys an event queue.
+func EventQueueDestroy(queue uintptr) {
+	if !libLoaded.Load() || shimEventQueueDestroy == nil || queue == 0 {
+		return
+	}
+	shimEventQueueDestroy(queue)
+}
+
+// EventQueueDrain moves pending events into events and their payloads into
+// payload. It returns the number of events, the payload bytes used and the
+// number of events dropped because the queue was full. If the first pending
+// payload does not fit, it returns ErrBufferTooSmall with the size needed.
+func EventQueueDrain(queue uintptr, events []Event, payload []byte) (count, payloadLen int, dropped uint64, err error) {
+	if !libLoaded.Load() || shimEventQueueDrain == nil {
+		return 0, 0, 0, ErrLibraryNotLoaded
+	}
+
+	var errBuf ShimErrorBuffer
+	params := shimEventQueueDrainParams{
+		Queue:       queue,
+		Events:      uintptr(unsafe.Pointer(unsafe.SliceData(events))),
+		MaxEvents:   int32(len(events)),
+		Payload:     ByteSlicePtr(payload),
+		PayloadSize: int32(len(payload)),
+		ErrorOut:    errBuf.Ptr(),
+	}
+	result := shimEventQueueDrain(uintptr(unsafe.Pointer(&params)))
+	runtime.KeepAlive(events)
+	runtime.KeepAlive(payload)
+	runtime.KeepAlive(&params)
+
+	return int(params.OutCount), int(params.OutPayloadLen), params.OutDropped, errBuf.ToError(result)
+}
+
+// PeerConnectionSetEventQueue routes a PeerConnection's observer events to
+// queue, tagged with tag. A zero queue restores the registered callbacks.
+func PeerConnectionSetEventQueue(pc, queue uintptr, tag uint64) {
+	if !libLoaded.Load() || shimPeerConnectionSetEventQueue == nil || pc == 0 {
+		return
+	}
+	params := shimPeerConnectionSetEventQueueParams{
+		PC:    pc,
+		Queue: queue,
+		Tag:   tag,
+	}
+	shimPeerConnectionSetEventQueue(uintptr(unsafe.Pointer(&params)))
+	runtime.KeepAlive(&params)
+}
+
+// DataChannelSetEventQueue routes a DataChannel's open/close/message events
+// to queue, tagged with tag. A zero queue restores the registered callbacks.
+func DataChannelSetEventQueue(dc, queue uintptr, tag uint64) {
+	if !libLoaded.Load() || shimDataChannelSetEventQueue == nil || dc == 0 {
+		return
+	}
+	params := shimDataChannelSetEventQueueParams{
+		DC:    dc,
+		Queue: queue,
+		Tag:   tag,
+	}
+	shimDataChannelSetEventQueue(uintptr(unsafe.Pointer(&params)))
+	runtime.KeepAlive(&params)
+}
+
+// TrackSetVideoSinkEventQueue attaches a sink to a remote video track that
+// keeps decoded frames for TrackPullVideoFrame and announces each through
+// the queue. Remove it with TrackRemoveVideoSink.
+func TrackSetVideoSinkEventQueue(track, queue uintptr, tag uint64) error {
+	if !libLoaded.Load() || shimTrackSetVideoSinkEventQueue == nil {
+		return ErrLibraryNotLoaded
+	}
+	params := shimTrackSetEventQueueSinkParams{
+		Track: track,
+		Queue: queue,
+		Tag:   tag,
+	}
+	result := shimTrackSetVideoSinkEventQueue(uintptr(unsafe.Pointer(&params)))
+	runtime.KeepAlive(&params)
+	return ShimError(result)
+}
+
+// TrackSetAudioSinkEventQueue attaches a sink to a remote audio track that
+// queues int16 samples. Remove it with TrackRemoveAudioSink.
+func TrackSetAudioSinkEventQueue(track, queue uintptr, tag uint64) error {
+	if !libLoaded.Load() || shimTrackSetAudioSinkEventQueue == nil {
+		return ErrLibraryNotLoaded
+	}
+	params := shimTrackSetEventQueueSinkParams{
+		Track: track,
+		Queue: queue,
+		Tag:   tag,
+	}
+	result := shimTrackSetAudioSinkEventQueue(uintptr(unsafe.Pointer(&params)))
+	runtime.KeepAlive(&params)
+	return ShimError(result)
+}
+
+// RTPSenderSetRTCPFeedbackEventQueue queues the RTCP feedback batches of a
+// sender of pc, tagged with tag, every intervalMs (0 for the default, 100).
+// A zero queue restores the registered callback.
+func RTPSenderSetRTCPFeedbackEventQueue(pc, sender, queue uintptr, tag uint64, intervalMs int) {
+	if !libLoaded.Load() || shimRTPSenderSetRTCPFeedbackEventQueue == nil || pc == 0 || sender == 0 {
+		return
+	}
+	params := shimRTPSenderSetRTCPFeedbackEventQueueParams{
+		PC:         pc,
+		Sender:     sender,
+		Queue:      queue,
+		Tag:        tag,
+		IntervalMs: int32(intervalMs),
+	}
+	shimRTPSenderSetRTCPFeedbackEventQueue(uintptr(unsafe.Pointer(&params)))
+	runtime.KeepAlive(&params)
+}
+
+// RTPReceiverSetEncodedFrameEventQueue queues the encoded frames of a video
+// receiver, tagged with tag. A zero queue restores the registered callback.
+func RTPReceiverSetEncodedFrameEventQueue(receiver, queue uintptr, tag uint64) error {
+	if !libLoaded.Load() || shimRTPReceiverSetEncodedFrameEventQueue == nil {
+		return ErrLibraryNotLoaded
+	}
+	params := shimRTPReceiverSetEncodedFrameEventQueueParams{
+		Receiver: receiver,
+		Queue:    queue,
+		Tag:      tag,
+	}
+	result := shimRTPReceiverSetEncodedFrameEventQueue(uintptr(unsafe.Pointer(&params)))
+	runtime.KeepAlive(&params)
+	return ShimError(result)
+}
@@ -32,12 +32,34 @@ static void* fn_shim_depacketizer_create;
 static void* fn_shim_depacketizer_push;
 static void* fn_shim_depacketizer_pop;
 static void* fn_shim_depacketizer_destroy;
+static void* fn_shim_srtp_context_create;
+static void* fn_shim_srtp_protect_rtp;
+static void* fn_shim_srtp_protect_rtcp;
+static void* fn_shim_srtp_unprotect_rtp;
+static void* fn_shim_srtp_unprotect_rtcp;
+static void* fn_shim_srtp_context_destroy;
 static void* fn_shim_free_buffer;
 static void* fn_shim_free_packets;
 static void* fn_shim_libwebrtc_version;
 static void* fn_shim_version;
+static void* fn_shim_peer_connection_factory_create;
+static void* fn_shim_peer_connection_factory_destroy;
+static void* fn_shim_thread_group_create;
+static void* fn_shim_thread_group_shard_count;
+static void* fn_shim_thread_group_next_factory;
+static void* fn_shim_thread_group_factory;
+static void* fn_shim_thread_group_destroy;
+static void* fn_shim_set_socket_server;
+static void* fn_shim_socket_server_get_stats;
+static void* fn_shim_loopback_network_create;
+static void* fn_shim_loopback_network_destroy;
+static void* fn_shim_loopback_network_get_stats;
 static void* fn_shim_peer_connection_create;
 static void* fn_shim_peer_connection_destroy;
+static void* fn_shim_peer_connection_pool_create;
+static void* fn_shim_peer_connection_acquire;
+static void* fn_shim_peer_connection_pool_ready;
+static void* fn_shim_peer_connection_pool_destroy;
 static void* fn_shim_peer_connection_set_on_ice_candidate;
 static void* fn_shim_peer_connection_set_on_connection_state_change;
 static void* fn_shim_peer_connection_set_on_track;
@@ -46,6 +68,10 @@ static void* fn_shim_peer_connection_create_offer;
 static void* fn_shim_peer_connection_create_answer;
 static void* fn_shim_peer_connection_set_local_description;
 static void* fn_shim_peer_connection_set_remote_description;
+static void* fn_shim_peer_connection_create_offer_async;
+static void* fn_shim_peer_connection_create_answer_async;
+static void* fn_shim_peer_connection_set_local_description_async;
+static void* fn_shim_peer_connection_set_remote_description_async;
 static void* fn_shim_peer_connection_add_ice_candidate;
 static void* fn_shim_peer_connection_signaling_state;
 static void* fn_shim_peer_connection_ice_connection_state;
@@ -68,8 +94,23 @@ static void* fn_shim_data_channel_close;
 static void* fn_shim_data_channel_destroy;
 static void* fn_shim_video_track_source_create;
 static void* fn_shim_video_track_source_push_frame;
+static void* fn_shim_video_track_source_get_pool_stats;
+static void* fn_shim_video_frame_ring_create;
+static void* fn_shim_video_frame_ring_header;
+static void* fn_shim_video_frame_ring_destroy;
 static void* fn_shim_peer_connection_add_video_track_from_source;
 static void* fn_shim_video_track_source_destroy;
+static void* fn_shim_encoded_video_source_create;
+static void* fn_shim_encoded_video_source_set_on_keyframe_request;
+static void* fn_shim_encoded_video_source_push_frame;
+static void* fn_shim_peer_connection_add_encoded_video_track;
+static void* fn_shim_encoded_video_source_set_max_temporal_layer;
+static void* fn_shim_encoded_video_source_destroy;
+static void* fn_shim_shared_video_encoder_create;
+static void* fn_shim_shared_video_encoder_push_frame;
+static void* fn_shim_shared_video_encoder_set_rates;
+static void* fn_shim_shared_video_encoder_subscribe;
+static void* fn_shim_shared_video_encoder_destroy;
 static void* fn_shim_audio_track_source_create;
 static void* fn_shim_audio_track_source_push_frame;
 static void* fn_shim_peer_connection_add_audio_track_from_source;
@@ -78,19 +119,37 @@ static void* fn_shim_track_set_video_sink;
 static void* fn_shim_track_set_audio_sink;
 static void* fn_shim_track_remove_video_sink;
 static void* fn_shim_track_remove_audio_sink;
+static void* fn_shim_track_set_video_mailbox;
+static void* fn_shim_track_pull_video_frame;
+static void* fn_shim_video_frame_release;
+static void* fn_shim_track_set_video_sink_wants;
+static void* fn_shim_track_set_audio_sink_format;
 static void* fn_shim_track_kind;
 static void* fn_shim_track_id;
+static void* fn_shim_event_queue_create;
+static void* fn_shim_event_queue_fd;
+static void* fn_shim_event_queue_destroy;
+static void* fn_shim_event_queue_drain;
+static void* fn_shim_peer_connection_set_event_queue;
+static void* fn_shim_data_channel_set_event_queue;
+static void* fn_shim_track_set_video_sink_event_queue;
+static void* fn_shim_track_set_audio_sink_event_queue;
+static void* fn_shim_rtp_sender_set_rtcp_feedback_event_queue;
+static void* fn_shim_rtp_receiver_set_encoded_frame_event_queue;
 static void* fn_shim_rtp_sender_get_parameters;
 static void* fn_shim_rtp_sender_set_parameters;
 static void* fn_shim_rtp_sender_get_track;
 static void* fn_shim_rtp_sender_get_stats;
 static void* fn_shim_rtp_sender_set_on_rtcp_feedback;
+static void* fn_shim_peer_connection_set_on_transport_feedback;
 static void* fn_shim_rtp_sender_set_layer_active;
 static void* fn_shim_rtp_sender_set_layer_bitrate;
 static void* fn_shim_rtp_sender_get_active_layers;
 static void* fn_shim_rtp_receiver_get_track;
+static void* fn_shim_rtp_receiver_request_key_frame;
 static void* fn_shim_rtp_receiver_get_stats;
 static void* fn_shim_rtp_receiver_set_jitter_buffer_min_delay;
+static void* fn_shim_rtp_receiver_set_on_encoded_frame;
 static void* fn_shim_transceiver_get_direction;
 static void* fn_shim_transceiver_set_direction;
 static void* fn_shim_transceiver_get_current_direction;
@@ -106,6 +165,12 @@ static void* fn_shim_peer_connection_get_receivers;
 static void* fn_shim_peer_connection_get_transceivers;
 static void* fn_shim_peer_connection_restart_ice;
 static void* fn_shim_peer_connection_get_stats;
+static void* fn_shim_peer_connection_get_stream_stats;
+static void* fn_shim_stats_ring_create;
+static void* fn_shim_stats_ring_header;
+static void* fn_shim_stats_ring_destroy;
+static void* fn_shim_stats_ring_subscribe;
+static void* fn_shim_stats_ring_unsubscribe;
 static void* fn_shim_peer_connection_set_on_signaling_state_change;
 static void* fn_shim_peer_connection_set_on_ice_connection_state_change;
 static void* fn_shim_peer_connection_set_on_ice_gathering_state_change;
@@ -163,12 +228,34 @@ void set_fn_shim_depacketizer_create(void* fn) { fn_shim_depacketizer_create = f
 void set_fn_shim_depacketizer_push(void* fn) { fn_shim_depacketizer_push = fn; }
 void set_fn_shim_depacketizer_pop(void* fn) { fn_shim_depacketizer_pop = fn; }
 void set_fn_shim_depacketizer_destroy(void* fn) { fn_shim_depacketizer_destroy = fn; }
+void set_fn_shim_srtp_context_create(void* fn) { fn_shim_srtp_context_create = fn; }
+void set_fn_shim_srtp_protect_rtp(void* fn) { fn_shim_srtp_protect_rtp = fn; }
+void set_fn_shim_srtp_protect_rtcp(void* fn) { fn_shim_srtp_protect_rtcp = fn; }
+void set_fn_shim_srtp_unprotect_rtp(void* fn) { fn_shim_srtp_unprotect_rtp = fn; }
+void set_fn_shim_srtp_unprotect_rtcp(void* fn) { fn_shim_srtp_unprotect_rtcp = fn; }
+void set_fn_shim_srtp_context_destroy(void* fn) { fn_shim_srtp_context_destroy = fn; }
 void set_fn_shim_free_buffer(void* fn) { fn_shim_free_buffer = fn; }
 void set_fn_shim_free_packets(void* fn) { fn_shim_free_packets = fn; }
 void set_fn_shim_libwebrtc_version(void* fn) { fn_shim_libwebrtc_version = fn; }
 void set_fn_shim_version(void* fn) { fn_shim_version = fn; }
+void set_fn_shim_peer_connection_factory_create(void* fn) { fn_shim_peer_connection_factory_create = fn; }
+void set_fn_shim_peer_connection_factory_destroy(void* fn) { fn_shim_peer_connection_factory_destroy = fn; }
+void set_fn_shim_thread_group_create(void* fn) { fn_shim_thread_group_create = fn; }
+void set_fn_shim_thread_group_shard_count(void* fn) { fn_shim_thread_group_shard_count = fn; }
+void set_fn_shim_thread_group_next_factory(void* fn) { fn_shim_thread_group_next_factory = fn; }
+void set_fn_shim_thread_group_factory(void* fn) { fn_shim_thread_group_factory = fn; }
+void set_fn_shim_thread_group_destroy(void* fn) { fn_shim_thread_group_destroy = fn; }
+void set_fn_shim_set_socket_server(void* fn) { fn_shim_set_socket_server = fn; }
+void set_fn_shim_socket_server_get_stats(void* fn) { fn_shim_socket_server_get_stats = fn; }
+void set_fn_shim_loopback_network_create(void* fn) { fn_shim_loopback_network_create = fn; }
+void set_fn_shim_loopback_network_destroy(void* fn) { fn_shim_loopback_network_destroy = fn; }
+void set_fn_shim_loopback_network_get_stats(void* fn) { fn_shim_loopback_network_get_stats = fn; }
 void set_fn_shim_peer_connection_create(void* fn) { fn_shim_peer_connection_create = fn; }
 void set_fn_shim_peer_connection_destroy(void* fn) { fn_shim_peer_connection_destroy = fn; }
+void set_fn_shim_peer_connection_pool_create(void* fn) { fn_shim_peer_connection_pool_create = fn; }
+void set_fn_shim_peer_connection_acquire(void* fn) { fn_shim_peer_connection_acquire = fn; }
+void set_fn_shim_peer_connection_pool_ready(void* fn) { fn_shim_peer_connection_pool_ready = fn; }
+void set_fn_shim_peer_connection_pool_destroy(void* fn) { fn_shim_peer_connection_pool_destroy = fn; }
 void set_fn_shim_peer_connection_set_on_ice_candidate(void* fn) { fn_shim_peer_connection_set_on_ice_candidate = fn; }
 void set_fn_shim_peer_connection_set_on_connection_state_change(void* fn) { fn_shim_peer_connection_set_on_connection_state_change = fn; }
 void set_fn_shim_peer_connection_set_on_track(void* fn) { fn_shim_peer_connection_set_on_track = fn; }
@@ -177,6 +264,10 @@ void set_fn_shim_peer_connection_create_offer(void* fn) { fn_shim_peer_connectio
 void set_fn_shim_peer_connection_create_answer(void* fn) { fn_shim_peer_connection_create_answer = fn; }
 void set_fn_shim_peer_connection_set_local_description(void* fn) { fn_shim_peer_connection_set_local_description = fn; }
 void set_fn_shim_peer_connection_set_remote_description(void* fn) { fn_shim_peer_connection_set_remote_description = fn; }
+void set_fn_shim_peer_connection_create_offer_async(void* fn) { fn_shim_peer_connection_create_offer_async = fn; }
+void set_fn_shim_peer_connection_create_answer_async(void* fn) { fn_shim_peer_connection_create_answer_async = fn; }
+void set_fn_shim_peer_connection_set_local_description_async(void* fn) { fn_shim_peer_connection_set_local_description_async = fn; }
+void set_fn_shim_peer_connection_set_remote_description_async(void* fn) { fn_shim_peer_connection_set_remote_description_async = fn; }
 void set_fn_shim_peer_connection_add_ice_candidate(void* fn) { fn_shim_peer_connection_add_ice_candidate = fn; }
 void set_fn_shim_peer_connection_signaling_state(void* fn) { fn_shim_peer_connection_signaling_state = fn; }
 void set_fn_shim_peer_connection_ice_connection_state(void* fn) { fn_shim_peer_connection_ice_connection_state = fn; }
@@ -199,8 +290,23 @@ void set_fn_shim_data_channel_close(void* fn) { fn_shim_data_channel_close = fn;
 void set_fn_shim_data_channel_destroy(void* fn) { fn_shim_data_channel_destroy = fn; }
 void set_fn_shim_video_track_source_create(void* fn) { fn_shim_video_track_source_create = fn; }
 void set_fn_shim_video_track_source_push_frame(void* fn) { fn_shim_video_track_source_push_frame = fn; }
+void set_fn_shim_video_track_source_get_pool_stats(void* fn) { fn_shim_video_track_source_get_pool_stats = fn; }
+void set_fn_shim_video_frame_ring_create(void* fn) { fn_shim_video_frame_ring_create = fn; }
+void set_fn_shim_video_frame_ring_header(void* fn) { fn_shim_video_frame_ring_header = fn; }
+void set_fn_shim_video_frame_ring_destroy(void* fn) { fn_shim_video_frame_ring_destroy = fn; }
 void set_fn_shim_peer_connection_add_video_track_from_source(void* fn) { fn_shim_peer_connection_add_video_track_from_source = fn; }
 void set_fn_shim_video_track_source_destroy(void* fn) { fn_shim_video_track_source_destroy = fn; }
+void set_fn_shim_encoded_video_source_create(void* fn) { fn_shim_encoded_video_source_create = fn; }
+void set_fn_shim_encoded_video_source_set_on_keyframe_request(void* fn) { fn_shim_encoded_video_source_set_on_keyframe_request = fn; }
+void set_fn_shim_encoded_video_source_push_frame(void* fn) { fn_shim_encoded_video_source_push_frame = fn; }
+void set_fn_shim_peer_connection_add_encoded_video_track(void* fn) { fn_shim_peer_connection_add_encoded_video_track = fn; }
+void set_fn_shim_encoded_video_source_set_max_temporal_layer(void* fn) { fn_shim_encoded_video_source_set_max_temporal_layer = fn; }
+void set_fn_shim_encoded_video_source_destroy(void* fn) { fn_shim_encoded_video_source_destroy = fn; }
+void set_fn_shim_shared_video_encoder_create(void* fn) { fn_shim_shared_video_encoder_create = fn; }
+void set_fn_shim_shared_video_encoder_push_frame(void* fn) { fn_shim_shared_video_encoder_push_frame = fn; }
+void set_fn_shim_shared_video_encoder_set_rates(void* fn) { fn_shim_shared_video_encoder_set_rates = fn; }
+void set_fn_shim_shared_video_encoder_subscribe(void* fn) { fn_shim_shared_video_encoder_subscribe = fn; }
+void set_fn_shim_shared_video_encoder_destroy(void* fn) { fn_shim_shared_video_encoder_destroy = fn; }
 void set_fn_shim_audio_track_source_create(void* fn) { fn_shim_audio_track_source_create = fn; }
 void set_fn_shim_audio_track_source_push_frame(void* fn) { fn_shim_audio_track_source_push_frame = fn; }
 void set_fn_shim_peer_connection_add_audio_track_from_source(void* fn) { fn_shim_peer_connection_add_audio_track_from_source = fn; }
@@ -209,19 +315,37 @@ void set_fn_shim_track_set_video_sink(void* fn) { fn_shim_track_set_video_sink =
 void set_fn_shim_track_set_audio_sink(void* fn) { fn_shim_track_set_audio_sink = fn; }
 void set_fn_shim_track_remove_video_sink(void* fn) { fn_shim_track_remove_video_sink = fn; }
 void set_fn_shim_track_remove_audio_sink(void* fn) { fn_shim_track_remove_audio_sink = fn; }
+void set_fn_shim_track_set_video_mailbox(void* fn) { fn_shim_track_set_video_mailbox = fn; }
+void set_fn_shim_track_pull_video_frame(void* fn) { fn_shim_track_pull_video_frame = fn; }
+void set_fn_shim_video_frame_release(void* fn) { fn_shim_video_frame_release = fn; }
+void set_fn_shim_track_set_video_sink_wants(void* fn) { fn_shim_track_set_video_sink_wants = fn; }
+void set_fn_shim_track_set_audio_sink_format(void* fn) { fn_shim_track_set_audio_sink_format = fn; }
 void set_fn_shim_track_kind(void* fn) { fn_shim_track_kind = fn; }
 void set_fn_shim_track_id(void* fn) { fn_shim_track_id = fn; }
+void set_fn_shim_event_queue_create(void* fn) { fn_shim_event_queue_create = fn; }
+void set_fn_shim_event_queue_fd(void* fn) { fn_shim_event_queue_fd = fn; }
+void set_fn_shim_event_queue_destroy(void* fn) { fn_shim_event_queue_destroy = fn; }
+void set_fn_shim_event_queue_drain(void* fn) { fn_shim_event_queue_drain = fn; }
+void set_fn_shim_peer_connection_set_event_queue(void* fn) { fn_shim_peer_connection_set_event_queue = fn; }
+void set_fn_shim_data_channel_set_event_queue(void* fn) { fn_shim_data_channel_set_event_queue = fn; }
+void set_fn_shim_track_set_video_sink_event_queue(void* fn) { fn_shim_track_set_video_sink_event_queue = fn; }
+void set_fn_shim_track_set_audio_sink_event_queue(void* fn) { fn_shim_track_set_audio_sink_event_queue = fn; }
+void set_fn_shim_rtp_sender_set_rtcp_feedback_event_queue(void* fn) { fn_shim_rtp_sender_set_rtcp_feedback_event_queue = fn; }
+void set_fn_shim_rtp_receiver_set_encoded_frame_event_queue(void* fn) { fn_shim_rtp_receiver_set_encoded_frame_event_queue = fn; }
 void set_fn_shim_rtp_sender_get_parameters(void* fn) { fn_shim_rtp_sender_get_parameters = fn; }
 void set_fn_shim_rtp_sender_set_parameters(void* fn) { fn_shim_rtp_sender_set_parameters = fn; }
 void set_fn_shim_rtp_sender_get_track(void* fn) { fn_shim_rtp_sender_get_track = fn; }
 void set_fn_shim_rtp_sender_get_stats(void* fn) { fn_shim_rtp_sender_get_stats = fn; }
 void set_fn_shim_rtp_sender_set_on_rtcp_feedback(void* fn) { fn_shim_rtp_sender_set_on_rtcp_feedback = fn; }
+void set_fn_shim_peer_connection_set_on_transport_feedback(void* fn) { fn_shim_peer_connection_set_on_transport_feedback = fn; }
 void set_fn_shim_rtp_sender_set_layer_active(void* fn) { fn_shim_rtp_sender_set_layer_active = fn; }
 void set_fn_shim_rtp_sender_set_layer_bitrate(void* fn) { fn_shim_rtp_sender_set_layer_bitrate = fn; }
 void set_fn_shim_rtp_sender_get_active_layers(void* fn) { fn_shim_rtp_sender_get_active_layers = fn; }
 void set_fn_shim_rtp_receiver_get_track(void* fn) { fn_shim_rtp_receiver_get_track = fn; }
+void set_fn_shim_rtp_receiver_request_key_frame(void* fn) { fn_shim_rtp_receiver_request_key_frame = fn; }
 void set_fn_shim_rtp_receiver_get_stats(void* fn) { fn_shim_rtp_receiver_get_stats = fn; }
 void set_fn_shim_rtp_receiver_set_jitter_buffer_min_delay(void* fn) { fn_shim_rtp_receiver_set_jitter_buffer_min_delay = fn; }
+void set_fn_shim_rtp_receiver_set_on_encoded_frame(void* fn) { fn_shim_rtp_receiver_set_on_encoded_frame = fn; }
 void set_fn_shim_transceiver_get_direction(void* fn) { fn_shim_transceiver_get_direction = fn; }
 void set_fn_shim_transceiver_set_direction(void* fn) { fn_shim_transceiver_set_direction = fn; }
 void set_fn_shim_transceiver_get_current_direction(void* fn) { fn_shim_transceiver_get_current_direction = fn; }
@@ -237,6 +361,12 @@ void set_fn_shim_peer_connection_get_receivers(void* fn) { fn_shim_peer_connecti
 void set_fn_shim_peer_connection_get_transceivers(void* fn) { fn_shim_peer_connection_get_transceivers = fn; }
 void set_fn_shim_peer_connection_restart_ice(void* fn) { fn_shim_peer_connection_restart_ice = fn; }
 void set_fn_shim_peer_connection_get_stats(void* fn) { fn_shim_peer_connection_get_stats = fn; }
+void set_fn_shim_peer_connection_get_stream_stats(void* fn) { fn_shim_peer_connection_get_stream_stats = fn; }
+void set_fn_shim_stats_ring_create(void* fn) { fn_shim_stats_ring_create = fn; }
+void set_fn_shim_stats_ring_header(void* fn) { fn_shim_stats_ring_header = fn; }
+void set_fn_shim_stats_ring_destroy(void* fn) { fn_shim_stats_ring_destroy = fn; }
+void set_fn_shim_stats_ring_subscribe(void* fn) { fn_shim_stats_ring_subscribe = fn; }
+void set_fn_shim_stats_ring_unsubscribe(void* fn) { fn_shim_stats_ring_unsubscribe = fn; }
 void set_fn_shim_peer_connection_set_on_signaling_state_change(void* fn) { fn_shim_peer_connection_set_on_signaling_state_change = fn; }
 void set_fn_shim_peer_connection_set_on_ice_connection_state_change(void* fn) { fn_shim_peer_connection_set_on_ice_connection_state_change = fn; }
 void set_fn_shim_peer_connection_set_on_ice_gathering_state_change(void* fn) { fn_shim_peer_connection_set_on_ice_gathering_state_change = fn; }
@@ -366,6 +496,30 @@ void call_shim_depacketizer_destroy(uintptr_t depacketizer) {
     typedef void (*fn_t)(uintptr_t);
     ((fn_t)fn_shim_depacketizer_destroy)(depacketizer);
 }
+uintptr_t call_shim_srtp_context_create(uintptr_t params) {
+    typedef uintptr_t (*fn_t)(uintptr_t);
+    return ((fn_t)fn_shim_srtp_context_create)(params);
+}
+int32_t call_shim_srtp_protect_rtp(uintptr_t params) {
+    typedef int32_t (*fn_t)(uintptr_t);
+    return ((fn_t)fn_shim_srtp_protect_rtp)(params);
+}
+int32_t call_shim_srtp_protect_rtcp(uintptr_t params) {
+    typedef int32_t (*fn_t)(uintptr_t);
+    return ((fn_t)fn_shim_srtp_protect_rtcp)(params);
+}
+int32_t call_shim_srtp_unprotect_rtp(uintptr_t params) {
+    typedef int32_t (*fn_t)(uintptr_t);
+    return ((fn_t)fn_shim_srtp_unprotect_rtp)(params);
+}
+int32_t call_shim_srtp_unprotect_rtcp(uintptr_t params) {
+    typedef int32_t (*fn_t)(uintptr_t);
+    return ((fn_t)fn_shim_srtp_unprotect_rtcp)(params);
+}
+void call_shim_srtp_context_destroy(uintptr_t context) {
+    typedef void (*fn_t)(uintptr_t);
+    ((fn_t)fn_shim_srtp_context_destroy)(context);
+}
 void call_shim_free_buffer(uintptr_t buffer) {
     typedef void (*fn_t)(uintptr_t);
     ((fn_t)fn_shim_free_buffer)(buffer);
@@ -382,6 +536,54 @@ uintptr_t call_shim_version() {
     typedef uintptr_t (*fn_t)();
     return ((fn_t)fn_shim_version)();
 }
+uintptr_t call_shim_peer_connection_factory_create(uintptr_t params) {
+    typedef uintptr_t (*fn_t)(uintptr_t);
+    return ((fn_t)fn_shim_peer_connection_factory_create)(params);
+}
+void call_shim_peer_connection_factory_destroy(uintptr_t factory) {
+    typedef void (*fn_t)(uintptr_t);
+    ((fn_t)fn_shim_peer_connection_factory_destroy)(factory);
+}
+uintptr_t call_shim_thread_group_create(uintptr_t params) {
+    typedef uintptr_t (*fn_t)(uintptr_t);
+    return ((fn_t)fn_shim_thread_group_create)(params);
+}
+int32_t call_shim_thread_group_shard_count(uintptr_t group) {
+    typedef int32_t (*fn_t)(uintptr_t);
+    return ((fn_t)fn_shim_thread_group_shard_count)(group);
+}
+uintptr_t call_shim_thread_group_next_factory(uintptr_t group) {
+    typedef uintptr_t (*fn_t)(uintptr_t);
+    return ((fn_t)fn_shim_thread_group_next_factory)(group);
+}
+uintptr_t call_shim_thread_group_factory(uintptr_t group, int32_t shard) {
+    typedef uintptr_t (*fn_t)(uintptr_t, int32_t);
+    return ((fn_t)fn_shim_thread_group_factory)(group, shard);
+}
+void call_shim_thread_group_destroy(uintptr_t group) {
+    typedef void (*fn_t)(uintptr_t);
+    ((fn_t)fn_shim_thread_group_destroy)(group);
+}
+int32_t call_shim_set_socket_server(uintptr_t params) {
+    typedef int32_t (*fn_t)(uintptr_t);
+    return ((fn_t)fn_shim_set_socket_server)(params);
+}
+void call_shim_socket_server_get_stats(uintptr_t out) {
+    typedef void (*fn_t)(uintptr_t);
+    ((fn_t)fn_shim_socket_server_get_stats)(out);
+}
+uintptr_t call_shim_loopback_network_create(uintptr_t params) {
+    typedef uintptr_t (*fn_t)(uintptr_t);
+    return ((fn_t)fn_shim_loopback_network_create)(params);
+}
+void call_shim_loopback_network_destroy(uintptr_t network) {
+    typedef void (*fn_t)(uintptr_t);
+    ((fn_t)fn_shim_loopback_network_destroy)(network);
+}
+void call_shim_loopback_network_get_stats(uintptr_t network, uintptr_t out) {
+    typedef void (*fn_t)(uintptr_t, uintptr_t);
+    ((fn_t)fn_shim_loopback_network_get_stats)(network, out);
+}
 uintptr_t call_shim_peer_connection_create(uintptr_t params) {
     typedef uintptr_t (*fn_t)(uintptr_t);
     return ((fn_t)fn_shim_peer_connection_create)(params);
@@ -390,6 +592,22 @@ void call_shim_peer_connection_destroy(uintptr_t pc) {
     typedef void (*fn_t)(uintptr_t);
     ((fn_t)fn_shim_peer_connection_destroy)(pc);
 }
+uintptr_t call_shim_peer_connection_pool_create(uintptr_t params) {
+    typedef uintptr_t (*fn_t)(uintptr_t);
+    return ((fn_t)fn_shim_peer_connection_pool_create)(params);
+}
+uintptr_t call_shim_peer_connection_acquire(uintptr_t params) {
+    typedef uintptr_t (*fn_t)(uintptr_t);
+    return ((fn_t)fn_shim_peer_connection_acquire)(params);
+}
+int32_t call_shim_peer_connection_pool_ready(uintptr_t pool) {
+    typedef int32_t (*fn_t)(uintptr_t);
+    return ((fn_t)fn_shim_peer_connection_pool_ready)(pool);
+}
+void call_shim_peer_connection_pool_destroy(uintptr_t pool) {
+    typedef void (*fn_t)(uintptr_t);
+    ((fn_t)fn_shim_peer_connection_pool_destroy)(pool);
+}
 void call_shim_peer_connection_set_on_ice_candidate(uintptr_t params) {
     typedef void (*fn_t)(uintptr_t);
     ((fn_t)fn_shim_peer_connection_set_on_ice_candidate)(params);
@@ -422,6 +640,22 @@ int32_t call_shim_peer_connection_set_remote_description(uintptr_t params) {
     typedef int32_t (*fn_t)(uintptr_t);
     return ((fn_t)fn_shim_peer_connection_set_remote_description)(params);
 }
+int32_t call_shim_peer_connection_create_offer_async(uintptr_t params) {
+    typedef int32_t (*fn_t)(uintptr_t);
+    return ((fn_t)fn_shim_peer_connection_create_offer_async)(params);
+}
+int32_t call_shim_peer_connection_create_answer_async(uintptr_t params) {
+    typedef int32_t (*fn_t)(uintptr_t);
+    return ((fn_t)fn_shim_peer_connection_create_answer_async)(params);
+}
+int32_t call_shim_peer_connection_set_local_description_async(uintptr_t params) {
+    typedef int32_t (*fn_t)(uintptr_t);
+    return ((fn_t)fn_shim_peer_connection_set_local_description_async)(params);
+}
+int32_t call_shim_peer_connection_set_remote_description_async(uintptr_t params) {
+    typedef int32_t (*fn_t)(uintptr_t);
+    return ((fn_t)fn_shim_peer_connection_set_remote_description_async)(params);
+}
 int32_t call_shim_peer_connection_add_ice_candidate(uintptr_t params) {
     typedef int32_t (*fn_t)(uintptr_t);
     return ((fn_t)fn_shim_peer_connection_add_ice_candidate)(params);
@@ -510,6 +744,22 @@ int32_t call_shim_video_track_source_push_frame(uintptr_t params) {
     typedef int32_t (*fn_t)(uintptr_t);
     return ((fn_t)fn_shim_video_track_source_push_frame)(params);
 }
+int32_t call_shim_video_track_source_get_pool_stats(uintptr_t params) {
+    typedef int32_t (*fn_t)(uintptr_t);
+    return ((fn_t)fn_shim_video_track_source_get_pool_stats)(params);
+}
+uintptr_t call_shim_video_frame_ring_create(uintptr_t params) {
+    typedef uintptr_t (*fn_t)(uintptr_t);
+    return ((fn_t)fn_shim_video_frame_ring_create)(params);
+}
+uintptr_t call_shim_video_frame_ring_header(uintptr_t ring) {
+    typedef uintptr_t (*fn_t)(uintptr_t);
+    return ((fn_t)fn_shim_video_frame_ring_header)(ring);
+}
+void call_shim_video_frame_ring_destroy(uintptr_t ring) {
+    typedef void (*fn_t)(uintptr_t);
+    ((fn_t)fn_shim_video_frame_ring_destroy)(ring);
+}
 uintptr_t call_shim_peer_connection_add_video_track_from_source(uintptr_t params) {
     typedef uintptr_t (*fn_t)(uintptr_t);
     return ((fn_t)fn_shim_peer_connection_add_video_track_from_source)(params);
@@ -518,6 +768,50 @@ void call_shim_video_track_source_destroy(uintptr_t source) {
     typedef void (*fn_t)(uintptr_t);
     ((fn_t)fn_shim_video_track_source_destroy)(source);
 }
+uintptr_t call_shim_encoded_video_source_create(uintptr_t params) {
+    typedef uintptr_t (*fn_t)(uintptr_t);
+    return ((fn_t)fn_shim_encoded_video_source_create)(params);
+}
+void call_shim_encoded_video_source_set_on_keyframe_request(uintptr_t params) {
+    typedef void (*fn_t)(uintptr_t);
+    ((fn_t)fn_shim_encoded_video_source_set_on_keyframe_request)(params);
+}
+int32_t call_shim_encoded_video_source_push_frame(uintptr_t params) {
+    typedef int32_t (*fn_t)(uintptr_t);
+    return ((fn_t)fn_shim_encoded_video_source_push_frame)(params);
+}
+uintptr_t call_shim_peer_connection_add_encoded_video_track(uintptr_t params) {
+    typedef uintptr_t (*fn_t)(uintptr_t);
+    return ((fn_t)fn_shim_peer_connection_add_encoded_video_track)(params);
+}
+int32_t call_shim_encoded_video_source_set_max_temporal_layer(uintptr_t params) {
+    typedef int32_t (*fn_t)(uintptr_t);
+    return ((fn_t)fn_shim_encoded_video_source_set_max_temporal_layer)(params);
+}
+void call_shim_encoded_video_source_destroy(uintptr_t source) {
+    typedef void (*fn_t)(uintptr_t);
+    ((fn_t)fn_shim_encoded_video_source_destroy)(source);
+}
+uintptr_t call_shim_shared_video_encoder_create(uintptr_t params) {
+    typedef uintptr_t (*fn_t)(uintptr_t);
+    return ((fn_t)fn_shim_shared_video_encoder_create)(params);
+}
+int32_t call_shim_shared_video_encoder_push_frame(uintptr_t params) {
+    typedef int32_t (*fn_t)(uintptr_t);
+    return ((fn_t)fn_shim_shared_video_encoder_push_frame)(params);
+}
+int32_t call_shim_shared_video_encoder_set_rates(uintptr_t params) {
+    typedef int32_t (*fn_t)(uintptr_t);
+    return ((fn_t)fn_shim_shared_video_encoder_set_rates)(params);
+}
+uintptr_t call_shim_shared_video_encoder_subscribe(uintptr_t params) {
+    typedef uintptr_t (*fn_t)(uintptr_t);
+    return ((fn_t)fn_shim_shared_video_encoder_subscribe)(params);
+}
+void call_shim_shared_video_encoder_destroy(uintptr_t encoder) {
+    typedef void (*fn_t)(uintptr_t);
+    ((fn_t)fn_shim_shared_video_encoder_destroy)(encoder);
+}
 uintptr_t call_shim_audio_track_source_create(uintptr_t params) {
     typedef uintptr_t (*fn_t)(uintptr_t);
     return ((fn_t)fn_shim_audio_track_source_create)(params);
@@ -550,6 +844,26 @@ void call_shim_track_remove_audio_sink(uintptr_t track) {
     typedef void (*fn_t)(uintptr_t);
     ((fn_t)fn_shim_track_remove_audio_sink)(track);
 }
+int32_t call_shim_track_set_video_mailbox(uintptr_t params) {
+    typedef int32_t (*fn_t)(uintptr_t);
+    return ((fn_t)fn_shim_track_set_video_mailbox)(params);
+}
+int32_t call_shim_track_pull_video_frame(uintptr_t params) {
+    typedef int32_t (*fn_t)(uintptr_t);
+    return ((fn_t)fn_shim_track_pull_video_frame)(params);
+}
+void call_shim_video_frame_release(uintptr_t frame) {
+    typedef void (*fn_t)(uintptr_t);
+    ((fn_t)fn_shim_video_frame_release)(frame);
+}
+int32_t call_shim_track_set_video_sink_wants(uintptr_t params) {
+    typedef int32_t (*fn_t)(uintptr_t);
+    return ((fn_t)fn_shim_track_set_video_sink_wants)(params);
+}
+int32_t call_shim_track_set_audio_sink_format(uintptr_t params) {
+    typedef int32_t (*fn_t)(uintptr_t);
+    return ((fn_t)fn_shim_track_set_audio_sink_format)(params);
+}
 uintptr_t call_shim_track_kind(uintptr_t track) {
     typedef uintptr_t (*fn_t)(uintptr_t);
     return ((fn_t)fn_shim_track_kind)(track);
@@ -558,6 +872,46 @@ uintptr_t call_shim_track_id(uintptr_t track) {
     typedef uintptr_t (*fn_t)(uintptr_t);
     return ((fn_t)fn_shim_track_id)(track);
 }
+uintptr_t call_shim_event_queue_create(uintptr_t params) {
+    typedef uintptr_t (*fn_t)(uintptr_t);
+    return ((fn_t)fn_shim_event_queue_create)(params);
+}
+int32_t call_shim_event_queue_fd(uintptr_t queue) {
+    typedef int32_t (*fn_t)(uintptr_t);
+    return ((fn_t)fn_shim_event_queue_fd)(queue);
+}
+void call_shim_event_queue_destroy(uintptr_t queue) {
+    typedef void (*fn_t)(uintptr_t);
+    ((fn_t)fn_shim_event_queue_destroy)(queue);
+}
+int32_t call_shim_event_queue_drain(uintptr_t params) {
+    typedef int32_t (*fn_t)(uintptr_t);
+    return ((fn_t)fn_shim_event_queue_drain)(params);
+}
+void call_shim_peer_connection_set_event_queue(uintptr_t params) {
+    typedef void (*fn_t)(uintptr_t);
+    ((fn_t)fn_shim_peer_connection_set_event_queue)(params);
+}
+void call_shim_data_channel_set_event_queue(uintptr_t params) {
+    typedef void (*fn_t)(uintptr_t);
+    ((fn_t)fn_shim_data_channel_set_event_queue)(params);
+}
+int32_t call_shim_track_set_video_sink_event_queue(uintptr_t params) {
+    typedef int32_t (*fn_t)(uintptr_t);
+    return ((fn_t)fn_shim_track_set_video_sink_event_queue)(params);
+}
+int32_t call_shim_track_set_audio_sink_event_queue(uintptr_t params) {
+    typedef int32_t (*fn_t)(uintptr_t);
+    return ((fn_t)fn_shim_track_set_audio_sink_event_queue)(params);
+}
+void call_shim_rtp_sender_set_rtcp_feedback_event_queue(uintptr_t params) {
+    typedef void (*fn_t)(uintptr_t);
+    ((fn_t)fn_shim_rtp_sender_set_rtcp_feedback_event_queue)(params);
+}
+int32_t call_shim_rtp_receiver_set_encoded_frame_event_queue(uintptr_t params) {
+    typedef int32_t (*fn_t)(uintptr_t);
+    return ((fn_t)fn_shim_rtp_receiver_set_encoded_frame_event_queue)(params);
+}
 int32_t call_shim_rtp_sender_get_parameters(uintptr_t params) {
     typedef int32_t (*fn_t)(uintptr_t);
     return ((fn_t)fn_shim_rtp_sender_get_parameters)(params);
@@ -578,6 +932,10 @@ void call_shim_rtp_sender_set_on_rtcp_feedback(uintptr_t params) {
     typedef void (*fn_t)(uintptr_t);
     ((fn_t)fn_shim_rtp_sender_set_on_rtcp_feedback)(params);
 }
+void call_shim_peer_connection_set_on_transport_feedback(uintptr_t params) {
+    typedef void (*fn_t)(uintptr_t);
+    ((fn_t)fn_shim_peer_connection_set_on_transport_feedback)(params);
+}
 int32_t call_shim_rtp_sender_set_layer_active(uintptr_t params) {
     typedef int32_t (*fn_t)(uintptr_t);
     return ((fn_t)fn_shim_rtp_sender_set_layer_active)(params);
@@ -594,6 +952,10 @@ uintptr_t call_shim_rtp_receiver_get_track(uintptr_t receiver) {
     typedef uintptr_t (*fn_t)(uintptr_t);
     return ((fn_t)fn_shim_rtp_receiver_get_track)(receiver);
 }
+int32_t call_shim_rtp_receiver_request_key_frame(uintptr_t receiver) {
+    typedef int32_t (*fn_t)(uintptr_t);
+    return ((fn_t)fn_shim_rtp_receiver_request_key_frame)(receiver);
+}
 int32_t call_shim_rtp_receiver_get_stats(uintptr_t params) {
     typedef int32_t (*fn_t)(uintptr_t);
     return ((fn_t)fn_shim_rtp_receiver_get_stats)(params);
@@ -602,6 +964,10 @@ int32_t call_shim_rtp_receiver_set_jitter_buffer_min_delay(uintptr_t params) {
     typedef int32_t (*fn_t)(uintptr_t);
     return ((fn_t)fn_shim_rtp_receiver_set_jitter_buffer_min_delay)(params);
 }
+int32_t call_shim_rtp_receiver_set_on_encoded_frame(uintptr_t params) {
+    typedef int32_t (*fn_t)(uintptr_t);
+    return ((fn_t)fn_shim_rtp_receiver_set_on_encoded_frame)(params);
+}
 int32_t call_shim_transceiver_get_direction(uintptr_t transceiver) {
     typedef int32_t (*fn_t)(uintptr_t);
     return ((fn_t)fn_shim_transceiver_get_direction)(transceiver);
@@ -662,6 +1028,30 @@ int32_t call_shim_peer_connection_get_stats(uintptr_t params) {
     typedef int32_t (*fn_t)(uintptr_t);
     return ((fn_t)fn_shim_peer_connection_get_stats)(params);
 }
+int32_t call_shim_peer_connection_get_stream_stats(uintptr_t params) {
+    typedef int32_t (*fn_t)(uintptr_t);
+    return ((fn_t)fn_shim_peer_connection_get_stream_stats)(params);
+}
+uintptr_t call_shim_stats_ring_create(uintptr_t params) {
+    typedef uintptr_t (*fn_t)(uintptr_t);
+    return ((fn_t)fn_shim_stats_ring_create)(params);
+}
+uintptr_t call_shim_stats_ring_header(uintptr_t ring) {
+    typedef uintptr_t (*fn_t)(uintptr_t);
+    return ((fn_t)fn_shim_stats_ring_header)(ring);
+}
+void call_shim_stats_ring_destroy(uintptr_t ring) {
+    typedef void (*fn_t)(uintptr_t);
+    ((fn_t)fn_shim_stats_ring_destroy)(ring);
+}
+int32_t call_shim_stats_ring_subscribe(uintptr_t params) {
+    typedef int32_t (*fn_t)(uintptr_t);
+    return ((fn_t)fn_shim_stats_ring_subscribe)(params);
+}
+void call_shim_stats_ring_unsubscribe(uintptr_t params) {
+    typedef void (*fn_t)(uintptr_t);
+    ((fn_t)fn_shim_stats_ring_unsubscribe)(params);
+}
 void call_shim_peer_connection_set_on_signaling_state_change(uintptr_t params) {
     typedef void (*fn_t)(uintptr_t);
     ((fn_t)fn_shim_peer_connection_set_on_signaling_state_change)(params);
@@ -827,6 +1217,14 @@ func registerFunctions() error {
 	C.set_fn_shim_depacketizer_pop(unsafe.Pointer(mustDlsym(libHandle, "shim_depacketizer_pop")))
 	C.set_fn_shim_depacketizer_destroy(unsafe.Pointer(mustDlsym(libHandle, "shim_depacketizer_destroy")))
 
+	// SRTP
+	C.set_fn_shim_srtp_context_create(unsafe.Pointer(mustDlsym(libHandle, "shim_srtp_context_create")))
+	C.set_fn_shim_srtp_protect_rtp(unsafe.Pointer(mustDlsym(libHandle, "shim_srtp_protect_rtp")))
+	C.set_fn_shim_srtp_protect_rtcp(unsafe.Pointer(mustDlsym(libHandle, "shim_srtp_protect_rtcp")))
+	C.set_fn_shim_srtp_unprotect_rtp(unsafe.Pointer(mustDlsym(libHandle, "shim_srtp_unprotect_rtp")))
+	C.set_fn_shim_srtp_unprotect_rtcp(unsafe.Pointer(mustDlsym(libHandle, "shim_srtp_unprotect_rtcp")))
+	C.set_fn_shim_srtp_context_destroy(unsafe.Pointer(mustDlsym(libHandle, "shim_srtp_context_destroy")))
+
 	// Memory
 	C.set_fn_shim_free_buffer(unsafe.Pointer(mustDlsym(libHandle, "shim_free_buffer")))
 	C.set_fn_shim_free_packets(unsafe.Pointer(mustDlsym(libHandle, "shim_free_packets")))
@@ -836,8 +1234,24 @@ func registerFunctions() error {
 	C.set_fn_shim_version(unsafe.Pointer(mustDlsym(libHandle, "shim_version")))
 
 	// PeerConnection
+	C.set_fn_shim_peer_connection_factory_create(unsafe.Pointer(mustDlsym(libHandle, "shim_peer_connection_factory_create")))
+	C.set_fn_shim_peer_connection_factory_destroy(unsafe.Pointer(mustDlsym(libHandle, "shim_peer_connection_factory_destroy")))
+	C.set_fn_shim_thread_group_create(unsafe.Pointer(mustDlsym(libHandle, "shim_thread_group_create")))
+	C.set_fn_shim_thread_group_shard_count(unsafe.Pointer(mustDlsym(libHandle, "shim_thread_group_shard_count")))
+	C.set_fn_shim_thread_group_next_factory(unsafe.Pointer(mustDlsym(libHandle, "shim_thread_group_next_factory")))
+	C.set_fn_shim_thread_group_factory(unsafe.Pointer(mustDlsym(libHandle, "shim_thread_group_factory")))
+	C.set_fn_shim_thread_group_destroy(unsafe.Pointer(mustDlsym(libHandle, "shim_thread_group_destroy")))
+	C.set_fn_shim_set_socket_server(unsafe.Pointer(mustDlsym(libHandle, "shim_set_socket_server")))
+	C.set_fn_shim_socket_server_get_stats(unsafe.Pointer(mustDlsym(libHandle, "shim_socket_server_get_stats")))
+	C.set_fn_shim_loopback_network_create(unsafe.Pointer(mustDlsym(libHandle, "shim_loopback_network_create")))
+	C.set_fn_shim_loopback_network_destroy(unsafe.Pointer(mustDlsym(libHandle, "shim_loopback_network_destroy")))
+	C.set_fn_shim_loopback_network_get_stats(unsafe.Pointer(mustDlsym(libHandle, "shim_loopback_network_get_stats")))
 	C.set_fn_shim_peer_connection_create(unsafe.Pointer(mustDlsym(libHandle, "shim_peer_connection_create")))
 	C.set_fn_shim_peer_connection_destroy(unsafe.Pointer(mustDlsym(libHandle, "shim_peer_connection_destroy")))
+	C.set_fn_shim_peer_connection_pool_create(unsafe.Pointer(mustDlsym(libHandle, "shim_peer_connection_pool_create")))
+	C.set_fn_shim_peer_connection_acquire(unsafe.Pointer(mustDlsym(libHandle, "shim_peer_connection_acquire")))
+	C.set_fn_shim_peer_connection_pool_ready(unsafe.Pointer(mustDlsym(libHandle, "shim_peer_connection_pool_ready")))
+	C.set_fn_shim_peer_connection_pool_destroy(unsafe.Pointer(mustDlsym(libHandle, "shim_peer_connection_pool_destroy")))
 	C.set_fn_shim_peer_connection_set_on_ice_candidate(unsafe.Pointer(mustDlsym(libHandle, "shim_peer_connection_set_on_ice_candidate")))
 	C.set_fn_shim_peer_connection_set_on_connection_state_change(unsafe.Pointer(mustDlsym(libHandle, "shim_peer_connection_set_on_connection_state_change")))
 	C.set_fn_shim_peer_connection_set_on_track(unsafe.Pointer(mustDlsym(libHandle, "shim_peer_connection_set_on_track")))
@@ -846,6 +1260,10 @@ func registerFunctions() error {
 	C.set_fn_shim_peer_connection_create_answer(unsafe.Pointer(mustDlsym(libHandle, "shim_peer_connection_create_answer")))
 	C.set_fn_shim_peer_connection_set_local_description(unsafe.Pointer(mustDlsym(libHandle, "shim_peer_connection_set_local_description")))
 	C.set_fn_shim_peer_connection_set_remote_description(unsafe.Pointer(mustDlsym(libHandle, "shim_peer_connection_set_remote_description")))
+	C.set_fn_shim_peer_connection_create_offer_async(unsafe.Pointer(mustDlsym(libHandle, "shim_peer_connection_create_offer_async")))
+	C.set_fn_shim_peer_connection_create_answer_async(unsafe.Pointer(mustDlsym(libHandle, "shim_peer_connection_create_answer_async")))
+	C.set_fn_shim_peer_connection_set_local_description_async(unsafe.Pointer(mustDlsym(libHandle, "shim_peer_connection_set_local_description_async")))
+	C.set_fn_shim_peer_connection_set_remote_description_async(unsafe.Pointer(mustDlsym(libHandle, "shim_peer_connection_set_remote_description_async")))
 	C.set_fn_shim_peer_connection_add_ice_candidate(unsafe.Pointer(mustDlsym(libHandle, "shim_peer_connection_add_ice_candidate")))
 	C.set_fn_shim_peer_connection_signaling_state(unsafe.Pointer(mustDlsym(libHandle, "shim_peer_connection_signaling_state")))
 	C.set_fn_shim_peer_connection_ice_connection_state(unsafe.Pointer(mustDlsym(libHandle, "shim_peer_connection_ice_connection_state")))
@@ -863,6 +1281,12 @@ func registerFunctions() error {
 	C.set_fn_shim_peer_connection_get_transceivers(unsafe.Pointer(mustDlsym(libHandle, "shim_peer_connection_get_transceivers")))
 	C.set_fn_shim_peer_connection_restart_ice(unsafe.Pointer(mustDlsym(libHandle, "shim_peer_connection_restart_ice")))
 	C.set_fn_shim_peer_connection_get_stats(unsafe.Pointer(mustDlsym(libHandle, "shim_peer_connection_get_stats")))
+	C.set_fn_shim_peer_connection_get_stream_stats(unsafe.Pointer(mustDlsym(libHandle, "shim_peer_connection_get_stream_stats")))
+	C.set_fn_shim_stats_ring_create(unsafe.Pointer(mustDlsym(libHandle, "shim_stats_ring_create")))
+	C.set_fn_shim_stats_ring_header(unsafe.Pointer(mustDlsym(libHandle, "shim_stats_ring_header")))
+	C.set_fn_shim_stats_ring_destroy(unsafe.Pointer(mustDlsym(libHandle, "shim_stats_ring_destroy")))
+	C.set_fn_shim_stats_ring_subscribe(unsafe.Pointer(mustDlsym(libHandle, "shim_stats_ring_subscribe")))
+	C.set_fn_shim_stats_ring_unsubscribe(unsafe.Pointer(mustDlsym(libHandle, "shim_stats_ring_unsubscribe")))
 	C.set_fn_shim_peer_connection_set_on_signaling_state_change(unsafe.Pointer(mustDlsym(libHandle, "shim_peer_connection_set_on_signaling_state_change")))
 	C.set_fn_shim_peer_connection_set_on_ice_connection_state_change(unsafe.Pointer(mustDlsym(libHandle, "shim_peer_connection_set_on_ice_connection_state_change")))
 	C.set_fn_shim_peer_connection_set_on_ice_gathering_state_change(unsafe.Pointer(mustDlsym(libHandle, "shim_peer_connection_set_on_ice_gathering_state_change")))
@@ -877,14 +1301,17 @@ func registerFunctions() error {
 	C.set_fn_shim_rtp_sender_get_track(unsafe.Pointer(mustDlsym(libHandle, "shim_rtp_sender_get_track")))
 	C.set_fn_shim_rtp_sender_get_stats(unsafe.Pointer(mustDlsym(libHandle, "shim_rtp_sender_get_stats")))
 	C.set_fn_shim_rtp_sender_set_on_rtcp_feedback(unsafe.Pointer(mustDlsym(libHandle, "shim_rtp_sender_set_on_rtcp_feedback")))
+	C.set_fn_shim_peer_connection_set_on_transport_feedback(unsafe.Pointer(mustDlsym(libHandle, "shim_peer_connection_set_on_transport_feedback")))
 	C.set_fn_shim_rtp_sender_set_layer_active(unsafe.Pointer(mustDlsym(libHandle, "shim_rtp_sender_set_layer_active")))
 	C.set_fn_shim_rtp_sender_set_layer_bitrate(unsafe.Pointer(mustDlsym(libHandle, "shim_rtp_sender_set_layer_bitrate")))
 	C.set_fn_shim_rtp_sender_get_active_layers(unsafe.Pointer(mustDlsym(libHandle, "shim_rtp_sender_get_active_layers")))
 
 	// RTPReceiver
 	C.set_fn_shim_rtp_receiver_get_track(unsafe.Pointer(mustDlsym(libHandle, "shim_rtp_receiver_get_track")))
+	C.set_fn_shim_rtp_receiver_request_key_frame(unsafe.Pointer(mustDlsym(libHandle, "shim_rtp_receiver_request_key_frame")))
 	C.set_fn_shim_rtp_receiver_get_stats(unsafe.Pointer(mustDlsym(libHandle, "shim_rtp_receiver_get_stats")))
 	C.set_fn_shim_rtp_receiver_set_jitter_buffer_min_delay(unsafe.Pointer(mustDlsym(libHandle, "shim_rtp_receiver_set_jitter_buffer_min_delay")))
+	C.set_fn_shim_rtp_receiver_set_on_encoded_frame(unsafe.Pointer(mustDlsym(libHandle, "shim_rtp_receiver_set_on_encoded_frame")))
 
 	// RTPTransceiver
 	C.set_fn_shim_transceiver_get_direction(unsafe.Pointer(mustDlsym(libHandle, "shim_transceiver_get_direction")))
@@ -910,8 +1337,23 @@ func registerFunctions() error {
 	// VideoTrackSource
 	C.set_fn_shim_video_track_source_create(unsafe.Pointer(mustDlsym(libHandle, "shim_video_track_source_create")))
 	C.set_fn_shim_video_track_source_push_frame(unsafe.Pointer(mustDlsym(libHandle, "shim_video_track_source_push_frame")))
+	C.set_fn_shim_video_track_source_get_pool_stats(unsafe.Pointer(mustDlsym(libHandle, "shim_video_track_source_get_pool_stats")))
+	C.set_fn_shim_video_frame_ring_create(unsafe.Pointer(mustDlsym(libHandle, "shim_video_frame_ring_create")))
+	C.set_fn_shim_video_frame_ring_header(unsafe.Pointer(mustDlsym(libHandle, "shim_video_frame_ring_header")))
+	C.set_fn_shim_video_frame_ring_destroy(unsafe.Pointer(mustDlsym(libHandle, "shim_video_frame_ring_destroy")))
 	C.set_fn_shim_peer_connection_add_video_track_from_source(unsafe.Pointer(mustDlsym(libHandle, "shim_peer_connection_add_video_track_from_source")))
 	C.set_fn_shim_video_track_source_destroy(unsafe.Pointer(mustDlsym(libHandle, "shim_video_track_source_destroy")))
+	C.set_fn_shim_encoded_video_source_create(unsafe.Pointer(mustDlsym(libHandle, "shim_encoded_video_source_create")))
+	C.set_fn_shim_encoded_video_source_set_on_keyframe_request(unsafe.Pointer(mustDlsym(libHandle, "shim_encoded_video_source_set_on_keyframe_request")))
+	C.set_fn_shim_encoded_video_source_push_frame(unsafe.Pointer(mustDlsym(libHandle, "shim_encoded_video_source_push_frame")))
+	C.set_fn_shim_peer_connection_add_encoded_video_track(unsafe.Pointer(mustDlsym(libHandle, "shim_peer_connection_add_encoded_video_track")))
+	C.set_fn_shim_encoded_video_source_set_max_temporal_layer(unsafe.Pointer(mustDlsym(libHandle, "shim_encoded_video_source_set_max_temporal_layer")))
+	C.set_fn_shim_encoded_video_source_destroy(unsafe.Pointer(mustDlsym(libHandle, "shim_encoded_video_source_destroy")))
+	C.set_fn_shim_shared_video_encoder_create(unsafe.Pointer(mustDlsym(libHandle, "shim_shared_video_encoder_create")))
+	C.set_fn_shim_shared_video_encoder_push_frame(unsafe.Pointer(mustDlsym(libHandle, "shim_shared_video_encoder_push_frame")))
+	C.set_fn_shim_shared_video_encoder_set_rates(unsafe.Pointer(mustDlsym(libHandle, "shim_shared_video_encoder_set_rates")))
+	C.set_fn_shim_shared_video_encoder_subscribe(unsafe.Pointer(mustDlsym(libHandle, "shim_shared_video_encoder_subscribe")))
+	C.set_fn_shim_shared_video_encoder_destroy(unsafe.Pointer(mustDlsym(libHandle, "shim_shared_video_encoder_destroy")))
 
 	// AudioTrackSource
 	C.set_fn_shim_audio_track_source_create(unsafe.Pointer(mustDlsym(libHandle, "shim_audio_track_source_create")))
@@ -924,9 +1366,26 @@ func registerFunctions() error {
 	C.set_fn_shim_track_set_audio_sink(unsafe.Pointer(mustDlsym(libHandle, "shim_track_set_audio_sink")))
 	C.set_fn_shim_track_remove_video_sink(unsafe.Pointer(mustDlsym(libHandle, "shim_track_remove_video_sink")))
 	C.set_fn_shim_track_remove_audio_sink(unsafe.Pointer(mustDlsym(libHandle, "shim_track_remove_audio_sink")))
+	C.set_fn_shim_track_set_video_mailbox(unsafe.Pointer(mustDlsym(libHandle, "shim_track_set_video_mailbox")))
+	C.set_fn_shim_track_pull_video_frame(unsafe.Pointer(mustDlsym(libHandle, "shim_track_pull_video_frame")))
+	C.set_fn_shim_video_frame_release(unsafe.Pointer(mustDlsym(libHandle, "shim_video_frame_release")))
+	C.set_fn_shim_track_set_video_sink_wants(unsafe.Pointer(mustDlsym(libHandle, "shim_track_set_video_sink_wants")))
+	C.set_fn_shim_track_set_audio_sink_format(unsafe.Pointer(mustDlsym(libHandle, "shim_track_set_audio_sink_format")))
 	C.set_fn_shim_track_kind(unsafe.Pointer(mustDlsym(libHandle, "shim_track_kind")))
 	C.set_fn_shim_track_id(unsafe.Pointer(mustDlsym(libHandle, "shim_track_id")))
 
+	// EventQueue
+	C.set_fn_shim_event_queue_create(unsafe.Pointer(mustDlsym(libHandle, "shim_event_queue_create")))
+	C.set_fn_shim_event_queue_fd(unsafe.Pointer(mustDlsym(libHandle, "shim_event_queue_fd")))
+	C.set_fn_shim_event_queue_destroy(unsafe.Pointer(mustDlsym(libHandle, "shim_event_queue_destroy")))
+	C.set_fn_shim_event_queue_drain(unsafe.Pointer(mustDlsym(libHandle, "shim_event_queue_drain")))
+	C.set_fn_shim_peer_connection_set_event_queue(unsafe.Pointer(mustDlsym(libHandle, "shim_peer_connection_set_event_queue")))
+	C.set_fn_shim_data_channel_set_event_queue(unsafe.Pointer(mustDlsym(libHandle, "shim_data_channel_set_event_queue")))
+	C.set_fn_shim_track_set_video_sink_event_queue(unsafe.Pointer(mustDlsym(libHandle, "shim_track_set_video_sink_event_queue")))
+	C.set_fn_shim_track_set_audio_sink_event_queue(unsafe.Pointer(mustDlsym(libHandle, "shim_track_set_audio_sink_event_queue")))
+	C.set_fn_shim_rtp_sender_set_rtcp_feedback_event_queue(unsafe.Pointer(mustDlsym(libHandle, "shim_rtp_sender_set_rtcp_feedback_event_queue")))
+	C.set_fn_shim_rtp_receiver_set_encoded_frame_event_queue(unsafe.Pointer(mustDlsym(libHandle, "shim_rtp_receiver_set_encoded_frame_event_queue")))
+
 	// ScalabilityMode
 	C.set_fn_shim_rtp_sender_set_scalability_mode(unsafe.Pointer(mustDlsym(libHandle, "shim_rtp_sender_set_scalability_mode")))
 	C.set_fn_shim_rtp_sender_get_scalability_mode(unsafe.Pointer(mustDlsym(libHandle, "shim_rtp_sender_get_scalability_mode")))
@@ -1053,6 +1512,26 @@ func registerFunctions() error {
 		C.call_shim_depacketizer_destroy(C.uintptr_t(depacketizer))
 	}
 
+	// SRTP
+	shimSRTPContextCreate = func(params uintptr) uintptr {
+		return uintptr(C.call_shim_srtp_context_create(C.uintptr_t(params)))
+	}
+	shimSRTPProtectRTP = func(params uintptr) int32 {
+		return int32(C.call_shim_srtp_protect_rtp(C.uintptr_t(params)))
+	}
+	shimSRTPProtectRTCP = func(params uintptr) int32 {
+		return int32(C.call_shim_srtp_protect_rtcp(C.uintptr_t(params)))
+	}
+	shimSRTPUnprotectRTP = func(params uintptr) int32 {
+		return int32(C.call_shim_srtp_unprotect_rtp(C.uintptr_t(params)))
+	}
+	shimSRTPUnprotectRTCP = func(params uintptr) int32 {
+		return int32(C.call_shim_srtp_unprotect_rtcp(C.uintptr_t(params)))
+	}
+	shimSRTPContextDestroy = func(context uintptr) {
+		C.call_shim_srtp_context_destroy(C.uintptr_t(context))
+	}
+
 	// Memory
 	shimFreeBuffer = func(buffer uintptr) {
 		C.call_shim_free_buffer(C.uintptr_t(buffer))
@@ -1070,12 +1549,60 @@ func registerFunctions() error {
 	}
 
 	// PeerConnection
+	shimPeerConnectionFactoryCreate = func(params uintptr) uintptr {
+		return uintptr(C.call_shim_peer_connection_factory_create(C.uintptr_t(params)))
+	}
+	shimPeerConnectionFactoryDestroy = func(factory uintptr) {
+		C.call_shim_peer_connection_factory_destroy(C.uintptr_t(factory))
+	}
+	shimThreadGroupCreate = func(params uintptr) uintptr {
+		return uintptr(C.call_shim_thread_group_create(C.uintptr_t(params)))
+	}
+	shimThreadGroupShardCount = func(group uintptr) int32 {
+		return int32(C.call_shim_thread_group_shard_count(C.uintptr_t(group)))
+	}
+	shimThreadGroupNextFactory = func(group uintptr) uintptr {
+		return uintptr(C.call_shim_thread_group_next_factory(C.uintptr_t(group)))
+	}
+	shimThreadGroupFactory = func(group uintptr, shard int32) uintptr {
+		return uintptr(C.call_shim_thread_group_factory(C.uintptr_t(group), C.int32_t(shard)))
+	}
+	shimThreadGroupDestroy = func(group uintptr) {
+		C.call_shim_thread_group_destroy(C.uintptr_t(group))
+	}
+	shimSetSocketServer = func(params uintptr) int32 {
+		return int32(C.call_shim_set_socket_server(C.uintptr_t(params)))
+	}
+	shimSocketServerGetStats = func(out uintptr) {
+		C.call_shim_socket_server_get_stats(C.uintptr_t(out))
+	}
+	shimLoopbackNetworkCreate = func(params uintptr) uintptr {
+		return uintptr(C.call_shim_loopback_network_create(C.uintptr_t(params)))
+	}
+	shimLoopbackNetworkDestroy = func(network uintptr) {
+		C.call_shim_loopback_network_destroy(C.uintptr_t(network))
+	}
+	shimLoopbackNetworkGetStats = func(network uintptr, out uintptr) {
+		C.call_shim_loopback_network_get_stats(C.uintptr_t(network), C.uintptr_t(out))
+	}
 	shimPeerConnectionCreate = func(params uintptr) uintptr {
 		return uintptr(C.call_shim_peer_connection_create(C.uintptr_t(params)))
 	}
 	shimPeerConnectionDestroy = func(pc uintptr) {
 		C.call_shim_peer_connection_destroy(C.uintptr_t(pc))
 	}
+	shimPeerConnectionPoolCreate = func(params uintptr) uintptr {
+		return uintptr(C.call_shim_peer_connection_pool_create(C.uintptr_t(params)))
+	}
+	shimPeerConnectionAcquire = func(params uintptr) uintptr {
+		return uintptr(C.call_shim_peer_connection_acquire(C.uintptr_t(params)))
+	}
+	shimPeerConnectionPoolReady = func(pool uintptr) int32 {
+		return int32(C.call_shim_peer_connection_pool_ready(C.uintptr_t(pool)))
+	}
+	shimPeerConnectionPoolDestroy = func(pool uintptr) {
+		C.call_shim_peer_connection_pool_destroy(C.uintptr_t(pool))
+	}
 	shimPeerConnectionSetOnICECandidate = func(params uintptr) {
 		C.call_shim_peer_connection_set_on_ice_candidate(C.uintptr_t(params))
 	}
@@ -1100,6 +1627,18 @@ func registerFunctions() error {
 	shimPeerConnectionSetRemoteDescription = func(params uintptr) int32 {
 		return int32(C.call_shim_peer_connection_set_remote_description(C.uintptr_t(params)))
 	}
+	shimPeerConnectionCreateOfferAsync = func(params uintptr) int32 {
+		return int32(C.call_shim_peer_connection_create_offer_async(C.uintptr_t(params)))
+	}
+	shimPeerConnectionCreateAnswerAsync = func(params uintptr) int32 {
+		return int32(C.call_shim_peer_connection_create_answer_async(C.uintptr_t(params)))
+	}
+	shimPeerConnectionSetLocalDescriptionAsync = func(params uintptr) int32 {
+		return int32(C.call_shim_peer_connection_set_local_description_async(C.uintptr_t(params)))
+	}
+	shimPeerConnectionSetRemoteDescriptionAsync = func(params uintptr) int32 {
+		return int32(C.call_shim_peer_connection_set_remote_description_async(C.uintptr_t(params)))
+	}
 	shimPeerConnectionAddICECandidate = func(params uintptr) int32 {
 		return int32(C.call_shim_peer_connection_add_ice_candidate(C.uintptr_t(params)))
 	}
@@ -1147,6 +1686,24 @@ func registerFunctions() error {
 	shimPeerConnectionGetStats = func(params uintptr) int32 {
 		return int32(C.call_shim_peer_connection_get_stats(C.uintptr_t(params)))
 	}
+	shimPeerConnectionGetStreamStats = func(params uintptr) int32 {
+		return int32(C.call_shim_peer_connection_get_stream_stats(C.uintptr_t(params)))
+	}
+	shimStatsRingCreate = func(params uintptr) uintptr {
+		return uintptr(C.call_shim_stats_ring_create(C.uintptr_t(params)))
+	}
+	shimStatsRingHeader = func(ring uintptr) uintptr {
+		return uintptr(C.call_shim_stats_ring_header(C.uintptr_t(ring)))
+	}
+	shimStatsRingDestroy = func(ring uintptr) {
+		C.call_shim_stats_ring_destroy(C.uintptr_t(ring))
+	}
+	shimStatsRingSubscribe = func(params uintptr) int32 {
+		return int32(C.call_shim_stats_ring_subscribe(C.uintptr_t(params)))
+	}
+	shimStatsRingUnsubscribe = func(params uintptr) {
+		C.call_shim_stats_ring_unsubscribe(C.uintptr_t(params))
+	}
 	shimPeerConnectionSetOnSignalingStateChange = func(params uintptr) {
 		C.call_shim_peer_connection_set_on_signaling_state_change(C.uintptr_t(params))
 	}
@@ -1185,6 +1742,9 @@ func registerFunctions() error {
 	shimRTPSenderSetOnRTCPFeedback = func(params uintptr) {
 		C.call_shim_rtp_sender_set_on_rtcp_feedback(C.uintptr_t(params))
 	}
+	shimPeerConnectionSetOnTransportFeedback = func(params uintptr) {
+		C.call_shim_peer_connection_set_on_transport_feedback(C.uintptr_t(params))
+	}
 	shimRTPSenderSetLayerActive = func(params uintptr) int32 {
 		return int32(C.call_shim_rtp_sender_set_layer_active(C.uintptr_t(params)))
 	}
@@ -1199,12 +1759,18 @@ func registerFunctions() error {
 	shimRTPReceiverGetTrack = func(receiver uintptr) uintptr {
 		return uintptr(C.call_shim_rtp_receiver_get_track(C.uintptr_t(receiver)))
 	}
+	shimRTPReceiverRequestKeyFrame = func(receiver uintptr) int32 {
+		return int32(C.call_shim_rtp_receiver_request_key_frame(C.uintptr_t(receiver)))
+	}
 	shimRTPReceiverGetStats = func(params uintptr) int32 {
 		return int32(C.call_shim_rtp_receiver_get_stats(C.uintptr_t(params)))
 	}
 	shimRTPReceiverSetJitterBufferMinDelay = func(params uintptr) int32 {
 		return int32(C.call_shim_rtp_receiver_set_jitter_buffer_min_delay(C.uintptr_t(params)))
 	}
+	shimRTPReceiverSetOnEncodedFrame = func(params uintptr) int32 {
+		return int32(C.call_shim_rtp_receiver_set_on_encoded_frame(C.uintptr_t(params)))
+	}
 
 	// RTPTransceiver
 	shimTransceiverGetDirection = func(transceiver uintptr) int32 {
@@ -1268,12 +1834,57 @@ func registerFunctions() error {
 	shimVideoTrackSourcePushFrame = func(params uintptr) int32 {
 		return int32(C.call_shim_video_track_source_push_frame(C.uintptr_t(params)))
 	}
+	shimVideoTrackSourceGetPoolStats = func(params uintptr) int32 {
+		return int32(C.call_shim_video_track_source_get_pool_stats(C.uintptr_t(params)))
+	}
+	shimVideoFrameRingCreate = func(params uintptr) uintptr {
+		return uintptr(C.call_shim_video_frame_ring_create(C.uintptr_t(params)))
+	}
+	shimVideoFrameRingHeader = func(ring uintptr) uintptr {
+		return uintptr(C.call_shim_video_frame_ring_header(C.uintptr_t(ring)))
+	}
+	shimVideoFrameRingDestroy = func(ring uintptr) {
+		C.call_shim_video_frame_ring_destroy(C.uintptr_t(ring))
+	}
 	shimPeerConnectionAddVideoTrackFromSource = func(params uintptr) uintptr {
 		return uintptr(C.call_shim_peer_connection_add_video_track_from_source(C.uintptr_t(params)))
 	}
 	shimVideoTrackSourceDestroy = func(source uintptr) {
 		C.call_shim_video_track_source_destroy(C.uintptr_t(source))
 	}
+	shimEncodedVideoSourceCreate = func(params uintptr) uintptr {
+		return uintptr(C.call_shim_encoded_video_source_create(C.uintptr_t(params)))
+	}
+	shimEncodedVideoSourceSetOnKeyFrameRequest = func(params uintptr) {
+		C.call_shim_encoded_video_source_set_on_keyframe_request(C.uintptr_t(params))
+	}
+	shimEncodedVideoSourcePushFrame = func(params uintptr) int32 {
+		return int32(C.call_shim_encoded_video_source_push_frame(C.uintptr_t(params)))
+	}
+	shimPeerConnectionAddEncodedVideoTrack = func(params uintptr) uintptr {
+		return uintptr(C.call_shim_peer_connection_add_encoded_video_track(C.uintptr_t(params)))
+	}
+	shimEncodedVideoSourceSetMaxTemporalLayer = func(params uintptr) int32 {
+		return int32(C.call_shim_encoded_video_source_set_max_temporal_layer(C.uintptr_t(params)))
+	}
+	shimEncodedVideoSourceDestroy = func(source uintptr) {
+		C.call_shim_encoded_video_source_destroy(C.uintptr_t(source))
+	}
+	shimSharedVideoEncoderCreate = func(params uintptr) uintptr {
+		return uintptr(C.call_shim_shared_video_encoder_create(C.uintptr_t(params)))
+	}
+	shimSharedVideoEncoderPushFrame = func(params uintptr) int32 {
+		return int32(C.call_shim_shared_video_encoder_push_frame(C.uintptr_t(params)))
+	}
+	shimSharedVideoEncoderSetRates = func(params uintptr) int32 {
+		return int32(C.call_shim_shared_video_encoder_set_rates(C.uintptr_t(params)))
+	}
+	shimSharedVideoEncoderSubscribe = func(params uintptr) uintptr {
+		return uintptr(C.call_shim_shared_video_encoder_subscribe(C.uintptr_t(params)))
+	}
+	shimSharedVideoEncoderDestroy = func(encoder uintptr) {
+		C.call_shim_shared_video_encoder_destroy(C.uintptr_t(encoder))
+	}
 
 	// AudioTrackSource
 	shimAudioTrackSourceCreate = func(params uintptr) uintptr {
@@ -1302,6 +1913,21 @@ func registerFunctions() error {
 	shimTrackRemoveAudioSink = func(track uintptr) {
 		C.call_shim_track_remove_audio_sink(C.uintptr_t(track))
 	}
+	shimTrackSetVideoMailbox = func(params uintptr) int32 {
+		return int32(C.call_shim_track_set_video_mailbox(C.uintptr_t(params)))
+	}
+	shimTrackPullVideoFrame = func(params uintptr) int32 {
+		return int32(C.call_shim_track_pull_video_frame(C.uintptr_t(params)))
+	}
+	shimVideoFrameRelease = func(frame uintptr) {
+		C.call_shim_video_frame_release(C.uintptr_t(frame))
+	}
+	shimTrackSetVideoSinkWants = func(params uintptr) int32 {
+		return int32(C.call_shim_track_set_video_sink_wants(C.uintptr_t(params)))
+	}
+	shimTrackSetAudioSinkFormat = func(params uintptr) int32 {
+		return int32(C.call_shim_track_set_audio_sink_format(C.uintptr_t(params)))
+	}
 	shimTrackKind = func(track uintptr) uintptr {
 		return uintptr(C.call_shim_track_kind(C.uintptr_t(track)))
 	}
@@ -1309,6 +1935,38 @@ func registerFunctions() error {
 		return uintptr(C.call_shim_track_id(C.uintptr_t(track)))
 	}
 
+	// EventQueue
+	shimEventQueueCreate = func(params uintptr) uintptr {
+		return uintptr(C.call_shim_event_queue_create(C.uintptr_t(params)))
+	}
+	shimEventQueueFD = func(queue uintptr) int32 {
+		return int32(C.call_shim_event_queue_fd(C.uintptr_t(queue)))
+	}
+	shimEventQueueDestroy = func(queue uintptr) {
+		C.call_shim_event_queue_destroy(C.uintptr_t(queue))
+	}
+	shimEventQueueDrain = func(params uintptr) int32 {
+		return int32(C.call_shim_event_queue_drain(C.uintptr_t(params)))
+	}
+	shimPeerConnectionSetEventQueue = func(params uintptr) {
+		C.call_shim_peer_connection_set_event_queue(C.uintptr_t(params))
+	}
+	shimDataChannelSetEventQueue = func(params uintptr) {
+		C.call_shim_data_channel_set_event_queue(C.uintptr_t(params))
+	}
+	shimTrackSetVideoSinkEventQueue = func(params uintptr) int32 {
+		return int32(C.call_shim_track_set_video_sink_event_queue(C.uintptr_t(params)))
+	}
+	shimTrackSetAudioSinkEventQueue = func(params uintptr) int32 {
+		return int32(C.call_shim_track_set_audio_sink_event_queue(C.uintptr_t(params)))
+	}
+	shimRTPSenderSetRTCPFeedbackEventQueue = func(params uintptr) {
+		C.call_shim_rtp_sender_set_rtcp_feedback_event_queue(C.uintptr_t(params))
+	}
+	shimRTPReceiverSetEncodedFrameEventQueue = func(params uintptr) int32 {
+		return int32(C.call_shim_rtp_receiver_set_encoded_frame_event_queue(C.uintptr_t(params)))
+	}
+
 	// ScalabilityMode
 	shimRTPSenderSetScalabilityMode = func(params uintptr) int32 {
 		return int32(C.call_shim_rtp_sender_set_scalability_mode(C.uintptr_t(params)))
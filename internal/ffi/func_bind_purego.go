@@ -43,6 +43,14 @@ func registerFunctions() error {
 	registerLibFunc(&shimDepacketizerPop, libHandle, "shim_depacketizer_pop")
 	registerLibFunc(&shimDepacketizerDestroy, libHandle, "shim_depacketizer_destroy")
 
+	// SRTP
+	registerLibFunc(&shimSRTPContextCreate, libHandle, "shim_srtp_context_create")
+	registerLibFunc(&shimSRTPProtectRTP, libHandle, "shim_srtp_protect_rtp")
+	registerLibFunc(&shimSRTPProtectRTCP, libHandle, "shim_srtp_protect_rtcp")
+	registerLibFunc(&shimSRTPUnprotectRTP, libHandle, "shim_srtp_unprotect_rtp")
+	registerLibFunc(&shimSRTPUnprotectRTCP, libHandle, "shim_srtp_unprotect_rtcp")
+	registerLibFunc(&shimSRTPContextDestroy, libHandle, "shim_srtp_context_destroy")
+
 	// Memory
 	registerLibFunc(&shimFreeBuffer, libHandle, "shim_free_buffer")
 	registerLibFunc(&shimFreePackets, libHandle, "shim_free_packets")
@@ -52,8 +60,24 @@ func registerFunctions() error {
 	registerLibFunc(&shimVersion, libHandle, "shim_version")
 
 	// PeerConnection
+	registerLibFunc(&shimPeerConnectionFactoryCreate, libHandle, "shim_peer_connection_factory_create")
+	registerLibFunc(&shimPeerConnectionFactoryDestroy, libHandle, "shim_peer_connection_factory_destroy")
+	registerLibFunc(&shimThreadGroupCreate, libHandle, "shim_thread_group_create")
+	registerLibFunc(&shimThreadGroupShardCount, libHandle, "shim_thread_group_shard_count")
+	registerLibFunc(&shimThreadGroupNextFactory, libHandle, "shim_thread_group_next_factory")
+	registerLibFunc(&shimThreadGroupFactory, libHandle, "shim_thread_group_factory")
+	registerLibFunc(&shimThreadGroupDestroy, libHandle, "shim_thread_group_destroy")
+	registerLibFunc(&shimSetSocketServer, libHandle, "shim_set_socket_server")
+	registerLibFunc(&shimSocketServerGetStats, libHandle, "shim_socket_server_get_stats")
+	registerLibFunc(&shimLoopbackNetworkCreate, libHandle, "shim_loopback_network_create")
+	registerLibFunc(&shimLoopbackNetworkDestroy, libHandle, "shim_loopback_network_destroy")
+	registerLibFunc(&shimLoopbackNetworkGetStats, libHandle, "shim_loopback_network_get_stats")
 	registerLibFunc(&shimPeerConnectionCreate, libHandle, "shim_peer_connection_create")
 	registerLibFunc(&shimPeerConnectionDestroy, libHandle, "shim_peer_connection_destroy")
+	registerLibFunc(&shimPeerConnectionPoolCreate, libHandle, "shim_peer_connection_pool_create")
+	registerLibFunc(&shimPeerConnectionAcquire, libHandle, "shim_peer_connection_acquire")
+	registerLibFunc(&shimPeerConnectionPoolReady, libHandle, "shim_peer_connection_pool_ready")
+	registerLibFunc(&shimPeerConnectionPoolDestroy, libHandle, "shim_peer_connection_pool_destroy")
 	registerLibFunc(&shimPeerConnectionSetOnICECandidate, libHandle, "shim_peer_connection_set_on_ice_candidate")
 	registerLibFunc(&shimPeerConnectionSetOnConnectionStateChange, libHandle, "shim_peer_connection_set_on_connection_state_change")
 	registerLibFunc(&shimPeerConnectionSetOnTrack, libHandle, "shim_peer_connection_set_on_track")
@@ -62,6 +86,10 @@ func registerFunctions() error {
 	registerLibFunc(&shimPeerConnectionCreateAnswer, libHandle, "shim_peer_connection_create_answer")
 	registerLibFunc(&shimPeerConnectionSetLocalDescription, libHandle, "shim_peer_connection_set_local_description")
 	registerLibFunc(&shimPeerConnectionSetRemoteDescription, libHandle, "shim_peer_connection_set_remote_description")
+	registerLibFunc(&shimPeerConnectionCreateOfferAsync, libHandle, "shim_peer_connection_create_offer_async")
+	registerLibFunc(&shimPeerConnectionCreateAnswerAsync, libHandle, "shim_peer_connection_create_answer_async")
+	registerLibFunc(&shimPeerConnectionSetLocalDescriptionAsync, libHandle, "shim_peer_connection_set_local_description_async")
+	registerLibFunc(&shimPeerConnectionSetRemoteDescriptionAsync, libHandle, "shim_peer_connection_set_remote_description_async")
 	registerLibFunc(&shimPeerConnectionAddICECandidate, libHandle, "shim_peer_connection_add_ice_candidate")
 	registerLibFunc(&shimPeerConnectionSignalingState, libHandle, "shim_peer_connection_signaling_state")
 	registerLibFunc(&shimPeerConnectionICEConnectionState, libHandle, "shim_peer_connection_ice_connection_state")
@@ -79,6 +107,12 @@ func registerFunctions() error {
 	registerLibFunc(&shimPeerConnectionGetTransceivers, libHandle, "shim_peer_connection_get_transceivers")
 	registerLibFunc(&shimPeerConnectionRestartICE, libHandle, "shim_peer_connection_restart_ice")
 	registerLibFunc(&shimPeerConnectionGetStats, libHandle, "shim_peer_connection_get_stats")
+	registerLibFunc(&shimPeerConnectionGetStreamStats, libHandle, "shim_peer_connection_get_stream_stats")
+	registerLibFunc(&shimStatsRingCreate, libHandle, "shim_stats_ring_create")
+	registerLibFunc(&shimStatsRingHeader, libHandle, "shim_stats_ring_header")
+	registerLibFunc(&shimStatsRingDestroy, libHandle, "shim_stats_ring_destroy")
+	registerLibFunc(&shimStatsRingSubscribe, libHandle, "shim_stats_ring_subscribe")
+	registerLibFunc(&shimStatsRingUnsubscribe, libHandle, "shim_stats_ring_unsubscribe")
 	registerLibFunc(&shimPeerConnectionSetOnSignalingStateChange, libHandle, "shim_peer_connection_set_on_signaling_state_change")
 	registerLibFunc(&shimPeerConnectionSetOnICEConnectionStateChange, libHandle, "shim_peer_connection_set_on_ice_connection_state_change")
 	registerLibFunc(&shimPeerConnectionSetOnICEGatheringStateChange, libHandle, "shim_peer_connection_set_on_ice_gathering_state_change")
@@ -93,14 +127,17 @@ func registerFunctions() error {
 	registerLibFunc(&shimRTPSenderGetTrack, libHandle, "shim_rtp_sender_get_track")
 	registerLibFunc(&shimRTPSenderGetStats, libHandle, "shim_rtp_sender_get_stats")
 	registerLibFunc(&shimRTPSenderSetOnRTCPFeedback, libHandle, "shim_rtp_sender_set_on_rtcp_feedback")
+	registerLibFunc(&shimPeerConnectionSetOnTransportFeedback, libHandle, "shim_peer_connection_set_on_transport_feedback")
 	registerLibFunc(&shimRTPSenderSetLayerActive, libHandle, "shim_rtp_sender_set_layer_active")
 	registerLibFunc(&shimRTPSenderSetLayerBitrate, libHandle, "shim_rtp_sender_set_layer_bitrate")
 	registerLibFunc(&shimRTPSenderGetActiveLayers, libHandle, "shim_rtp_sender_get_active_layers")
 
 	// RTPReceiver
 	registerLibFunc(&shimRTPReceiverGetTrack, libHandle, "shim_rtp_receiver_get_track")
+	registerLibFunc(&shimRTPReceiverRequestKeyFrame, libHandle, "shim_rtp_receiver_request_key_frame")
 	registerLibFunc(&shimRTPReceiverGetStats, libHandle, "shim_rtp_receiver_get_stats")
 	registerLibFunc(&shimRTPReceiverSetJitterBufferMinDelay, libHandle, "shim_rtp_receiver_set_jitter_buffer_min_delay")
+	registerLibFunc(&shimRTPReceiverSetOnEncodedFrame, libHandle, "shim_rtp_receiver_set_on_encoded_frame")
 
 	// RTPTransceiver
 	registerLibFunc(&shimTransceiverGetDirection, libHandle, "shim_transceiver_get_direction")
@@ -126,8 +163,23 @@ func registerFunctions() error {
 	// VideoTrackSource
 	registerLibFunc(&shimVideoTrackSourceCreate, libHandle, "shim_video_track_source_create")
 	registerLibFunc(&shimVideoTrackSourcePushFrame, libHandle, "shim_video_track_source_push_frame")
+	registerLibFunc(&shimVideoTrackSourceGetPoolStats, libHandle, "shim_video_track_source_get_pool_stats")
+	registerLibFunc(&shimVideoFrameRingCreate, libHandle, "shim_video_frame_ring_create")
+	registerLibFunc(&shimVideoFrameRingHeader, libHandle, "shim_video_frame_ring_header")
+	registerLibFunc(&shimVideoFrameRingDestroy, libHandle, "shim_video_frame_ring_destroy")
 	registerLibFunc(&shimPeerConnectionAddVideoTrackFromSource, libHandle, "shim_peer_connection_add_video_track_from_source")
 	registerLibFunc(&shimVideoTrackSourceDestroy, libHandle, "shim_video_track_source_destroy")
+	registerLibFunc(&shimEncodedVideoSourceCreate, libHandle, "shim_encoded_video_source_create")
+	registerLibFunc(&shimEncodedVideoSourceSetOnKeyFrameRequest, libHandle, "shim_encoded_video_source_set_on_keyframe_request")
+	registerLibFunc(&shimEncodedVideoSourcePushFrame, libHandle, "shim_encoded_video_source_push_frame")
+	registerLibFunc(&shimPeerConnectionAddEncodedVideoTrack, libHandle, "shim_peer_connection_add_encoded_video_track")
+	registerLibFunc(&shimEncodedVideoSourceSetMaxTemporalLayer, libHandle, "shim_encoded_video_source_set_max_temporal_layer")
+	registerLibFunc(&shimEncodedVideoSourceDestroy, libHandle, "shim_encoded_video_source_destroy")
+	registerLibFunc(&shimSharedVideoEncoderCreate, libHandle, "shim_shared_video_encoder_create")
+	registerLibFunc(&shimSharedVideoEncoderPushFrame, libHandle, "shim_shared_video_encoder_push_frame")
+	registerLibFunc(&shimSharedVideoEncoderSetRates, libHandle, "shim_shared_video_encoder_set_rates")
+	registerLibFunc(&shimSharedVideoEncoderSubscribe, libHandle, "shim_shared_video_encoder_subscribe")
+	registerLibFunc(&shimSharedVideoEncoderDestroy, libHandle, "shim_shared_video_encoder_destroy")
 
 	// AudioTrackSource
 	registerLibFunc(&shimAudioTrackSourceCreate, libHandle, "shim_audio_track_source_create")
@@ -140,9 +192,26 @@ func registerFunctions() error {
 	registerLibFunc(&shimTrackSetAudioSink, libHandle, "shim_track_set_audio_sink")
 	registerLibFunc(&shimTrackRemoveVideoSink, libHandle, "shim_track_remove_video_sink")
 	registerLibFunc(&shimTrackRemoveAudioSink, libHandle, "shim_track_remove_audio_sink")
+	registerLibFunc(&shimTrackSetVideoMailbox, libHandle, "shim_track_set_video_mailbox")
+	registerLibFunc(&shimTrackPullVideoFrame, libHandle, "shim_track_pull_video_frame")
+	registerLibFunc(&shimVideoFrameRelease, libHandle, "shim_video_frame_release")
+	registerLibFunc(&shimTrackSetVideoSinkWants, libHandle, "shim_track_set_video_sink_wants")
+	registerLibFunc(&shimTrackSetAudioSinkFormat, libHandle, "shim_track_set_audio_sink_format")
 	registerLibFunc(&shimTrackKind, libHandle, "shim_track_kind")
 	registerLibFunc(&shimTrackID, libHandle, "shim_track_id")
 
+	// EventQueue
+	registerLibFunc(&shimEventQueueCreate, libHandle, "shim_event_queue_create")
+	registerLibFunc(&shimEventQueueFD, libHandle, "shim_event_queue_fd")
+	registerLibFunc(&shimEventQueueDestroy, libHandle, "shim_event_queue_destroy")
+	registerLibFunc(&shimEventQueueDrain, libHandle, "shim_event_queue_drain")
+	registerLibFunc(&shimPeerConnectionSetEventQueue, libHandle, "shim_peer_connection_set_event_queue")
+	registerLibFunc(&shimDataChannelSetEventQueue, libHandle, "shim_data_channel_set_event_queue")
+	registerLibFunc(&shimTrackSetVideoSinkEventQueue, libHandle, "shim_track_set_video_sink_event_queue")
+	registerLibFunc(&shimTrackSetAudioSinkEventQueue, libHandle, "shim_track_set_audio_sink_event_queue")
+	registerLibFunc(&shimRTPSenderSetRTCPFeedbackEventQueue, libHandle, "shim_rtp_sender_set_rtcp_feedback_event_queue")
+	registerLibFunc(&shimRTPReceiverSetEncodedFrameEventQueue, libHandle, "shim_rtp_receiver_set_encoded_frame_event_queue")
+
 	// ScalabilityMode
 	registerLibFunc(&shimRTPSenderSetScalabilityMode, libHandle, "shim_rtp_sender_set_scalability_mode")
 	registerLibFunc(&shimRTPSenderGetScalabilityMode, libHandle, "shim_rtp_sender_get_scalability_mode")
@@ -41,6 +41,14 @@ var (
 	shimDepacketizerPop     func(params uintptr) int32
 	shimDepacketizerDestroy func(depacketizer uintptr)
 
+	// SRTP
+	shimSRTPContextCreate  func(params uintptr) uintptr
+	shimSRTPProtectRTP     func(params uintptr) int32
+	shimSRTPProtectRTCP    func(params uintptr) int32
+	shimSRTPUnprotectRTP   func(params uintptr) int32
+	shimSRTPUnprotectRTCP  func(params uintptr) int32
+	shimSRTPContextDestroy func(context uintptr)
+
 	// Memory
 	shimFreeBuffer  func(buffer uintptr)
 	shimFreePackets func(packets uintptr, sizes uintptr, count int32)
@@ -50,8 +58,24 @@ var (
 	shimVersion          func() uintptr
 
 	// PeerConnection
+	shimPeerConnectionFactoryCreate              func(params uintptr) uintptr
+	shimPeerConnectionFactoryDestroy             func(factory uintptr)
+	shimThreadGroupCreate                        func(params uintptr) uintptr
+	shimThreadGroupShardCount                    func(group uintptr) int32
+	shimThreadGroupNextFactory                   func(group uintptr) uintptr
+	shimThreadGroupFactory                       func(group uintptr, shard int32) uintptr
+	shimThreadGroupDestroy                       func(group uintptr)
+	shimSetSocketServer                          func(params uintptr) int32
+	shimSocketServerGetStats                     func(out uintptr)
+	shimLoopbackNetworkCreate                    func(params uintptr) uintptr
+	shimLoopbackNetworkDestroy                   func(network uintptr)
+	shimLoopbackNetworkGetStats                  func(network uintptr, out uintptr)
 	shimPeerConnectionCreate                     func(params uintptr) uintptr
 	shimPeerConnectionDestroy                    func(pc uintptr)
+	shimPeerConnectionPoolCreate                 func(params uintptr) uintptr
+	shimPeerConnectionAcquire                    func(params uintptr) uintptr
+	shimPeerConnectionPoolReady                  func(pool uintptr) int32
+	shimPeerConnectionPoolDestroy                func(pool uintptr)
 	shimPeerConnectionSetOnICECandidate          func(params uintptr)
 	shimPeerConnectionSetOnConnectionStateChange func(params uintptr)
 	shimPeerConnectionSetOnTrack                 func(params uintptr)
@@ -60,6 +84,10 @@ var (
 	shimPeerConnectionCreateAnswer               func(params uintptr) int32
 	shimPeerConnectionSetLocalDescription        func(params uintptr) int32
 	shimPeerConnectionSetRemoteDescription       func(params uintptr) int32
+	shimPeerConnectionCreateOfferAsync           func(params uintptr) int32
+	shimPeerConnectionCreateAnswerAsync          func(params uintptr) int32
+	shimPeerConnectionSetLocalDescriptionAsync   func(params uintptr) int32
+	shimPeerConnectionSetRemoteDescriptionAsync  func(params uintptr) int32
 	shimPeerConnectionAddICECandidate            func(params uintptr) int32
 	shimPeerConnectionSignalingState             func(pc uintptr) int32
 	shimPeerConnectionICEConnectionState         func(pc uintptr) int32
@@ -77,28 +105,37 @@ var (
 	shimPeerConnectionGetTransceivers               func(params uintptr) int32
 	shimPeerConnectionRestartICE                    func(pc uintptr) int32
 	shimPeerConnectionGetStats                      func(params uintptr) int32
+	shimPeerConnectionGetStreamStats                func(params uintptr) int32
+	shimStatsRingCreate                             func(params uintptr) uintptr
+	shimStatsRingHeader                             func(ring uintptr) uintptr
+	shimStatsRingDestroy                            func(ring uintptr)
+	shimStatsRingSubscribe                          func(params uintptr) int32
+	shimStatsRingUnsubscribe                        func(params uintptr)
 	shimPeerConnectionSetOnSignalingStateChange     func(params uintptr)
 	shimPeerConnectionSetOnICEConnectionStateChange func(params uintptr)
 	shimPeerConnectionSetOnICEGatheringStateChange  func(params uintptr)
 	shimPeerConnectionSetOnNegotiationNeeded        func(params uintptr)
 
 	// RTPSender
-	shimRTPSenderSetBitrate        func(params uintptr) int32
-	shimRTPSenderReplaceTrack      func(params uintptr) int32
-	shimRTPSenderDestroy           func(sender uintptr)
-	shimRTPSenderGetParameters     func(params uintptr) int32
-	shimRTPSenderSetParameters     func(params uintptr) int32
-	shimRTPSenderGetTrack          func(sender uintptr) uintptr
-	shimRTPSenderGetStats          func(params uintptr) int32
-	shimRTPSenderSetOnRTCPFeedback func(params uintptr)
-	shimRTPSenderSetLayerActive    func(params uintptr) int32
-	shimRTPSenderSetLayerBitrate   func(params uintptr) int32
-	shimRTPSenderGetActiveLayers   func(params uintptr) int32
+	shimRTPSenderSetBitrate                  func(params uintptr) int32
+	shimRTPSenderReplaceTrack                func(params uintptr) int32
+	shimRTPSenderDestroy                     func(sender uintptr)
+	shimRTPSenderGetParameters               func(params uintptr) int32
+	shimRTPSenderSetParameters               func(params uintptr) int32
+	shimRTPSenderGetTrack                    func(sender uintptr) uintptr
+	shimRTPSenderGetStats                    func(params uintptr) int32
+	shimRTPSenderSetOnRTCPFeedback           func(params uintptr)
+	shimPeerConnectionSetOnTransportFeedback func(params uintptr)
+	shimRTPSenderSetLayerActive              func(params uintptr) int32
+	shimRTPSenderSetLayerBitrate             func(params uintptr) int32
+	shimRTPSenderGetActiveLayers             func(params uintptr) int32
 
 	// RTPReceiver
 	shimRTPReceiverGetTrack                func(receiver uintptr) uintptr
+	shimRTPReceiverRequestKeyFrame         func(receiver uintptr) int32
 	shimRTPReceiverGetStats                func(params uintptr) int32
 	shimRTPReceiverSetJitterBufferMinDelay func(params uintptr) int32
+	shimRTPReceiverSetOnEncodedFrame       func(params uintptr) int32
 
 	// RTPTransceiver
 	shimTransceiverGetDirection        func(transceiver uintptr) int32
@@ -122,10 +159,25 @@ var (
 	shimDataChannelDestroy      func(dc uintptr)
 
 	// VideoTrackSource
-	shimVideoTrackSourceCreate                func(params uintptr) uintptr
-	shimVideoTrackSourcePushFrame             func(params uintptr) int32
-	shimPeerConnectionAddVideoTrackFromSource func(params uintptr) uintptr
-	shimVideoTrackSourceDestroy               func(source uintptr)
+	shimVideoTrackSourceCreate                 func(params uintptr) uintptr
+	shimVideoTrackSourcePushFrame              func(params uintptr) int32
+	shimVideoTrackSourceGetPoolStats           func(params uintptr) int32
+	shimVideoFrameRingCreate                   func(params uintptr) uintptr
+	shimVideoFrameRingHeader                   func(ring uintptr) uintptr
+	shimVideoFrameRingDestroy                  func(ring uintptr)
+	shimPeerConnectionAddVideoTrackFromSource  func(params uintptr) uintptr
+	shimVideoTrackSourceDestroy                func(source uintptr)
+	shimEncodedVideoSourceCreate               func(params uintptr) uintptr
+	shimEncodedVideoSourceSetOnKeyFrameRequest func(params uintptr)
+	shimEncodedVideoSourcePushFrame            func(params uintptr) int32
+	shimPeerConnectionAddEncodedVideoTrack     func(params uintptr) uintptr
+	shimEncodedVideoSourceSetMaxTemporalLayer  func(params uintptr) int32
+	shimEncodedVideoSourceDestroy              func(source uintptr)
+	shimSharedVideoEncoderCreate               func(params uintptr) uintptr
+	shimSharedVideoEncoderPushFrame            func(params uintptr) int32
+	shimSharedVideoEncoderSetRates             func(params uintptr) int32
+	shimSharedVideoEncoderSubscribe            func(params uintptr) uintptr
+	shimSharedVideoEncoderDestroy              func(encoder uintptr)
 
 	// AudioTrackSource
 	shimAudioTrackSourceCreate                func(params uintptr) uintptr
@@ -134,12 +186,29 @@ var (
 	shimAudioTrackSourceDestroy               func(source uintptr)
 
 	// RemoteTrack
-	shimTrackSetVideoSink    func(params uintptr) int32
-	shimTrackSetAudioSink    func(params uintptr) int32
-	shimTrackRemoveVideoSink func(track uintptr)
-	shimTrackRemoveAudioSink func(track uintptr)
-	shimTrackKind            func(track uintptr) uintptr
-	shimTrackID              func(track uintptr) uintptr
+	shimTrackSetVideoSink       func(params uintptr) int32
+	shimTrackSetAudioSink       func(params uintptr) int32
+	shimTrackRemoveVideoSink    func(track uintptr)
+	shimTrackRemoveAudioSink    func(track uintptr)
+	shimTrackSetVideoMailbox    func(params uintptr) int32
+	shimTrackPullVideoFrame     func(params uintptr) int32
+	shimVideoFrameRelease       func(frame uintptr)
+	shimTrackSetVideoSinkWants  func(params uintptr) int32
+	shimTrackSetAudioSinkFormat func(params uintptr) int32
+	shimTrackKind               func(track uintptr) uintptr
+	shimTrackID                 func(track uintptr) uintptr
+
+	// EventQueue
+	shimEventQueueCreate                     func(params uintptr) uintptr
+	shimEventQueueFD                         func(queue uintptr) int32
+	shimEventQueueDestroy                    func(queue uintptr)
+	shimEventQueueDrain                      func(params uintptr) int32
+	shimPeerConnectionSetEventQueue          func(params uintptr)
+	shimDataChannelSetEventQueue             func(params uintptr)
+	shimTrackSetVideoSinkEventQueue          func(params uintptr) int32
+	shimTrackSetAudioSinkEventQueue          func(params uintptr) int32
+	shimRTPSenderSetRTCPFeedbackEventQueue   func(params uintptr)
+	shimRTPReceiverSetEncodedFrameEventQueue func(params uintptr) int32
 
 	// ScalabilityMode
 	shimRTPSenderSetScalabilityMode func(params uintptr) int32
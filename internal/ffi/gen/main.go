@@ -394,12 +394,14 @@ func sortedCategories(m map[string][]Function) []string {
 		"VideoEncoder", "VideoDecoder",
 		"AudioEncoder", "AudioDecoder",
 		"Packetizer", "Depacketizer",
+		"SRTP",
 		"Memory", "Version",
 		"PeerConnection", "PeerConnectionExtended",
 		"RTPSender", "RTPReceiver", "RTPTransceiver",
 		"DataChannel",
 		"VideoTrackSource", "AudioTrackSource",
 		"RemoteTrack",
+		"EventQueue",
 		"ScalabilityMode", "CodecCapabilities", "RTPSenderCodec",
 		"BandwidthEstimation",
 		"DeviceCapture", "ScreenCapture", "Permissions",
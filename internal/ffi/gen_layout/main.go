@@ -56,6 +56,7 @@ var (
 
 var initialisms = map[string]string{
 	"id":   "ID",
+	"ids":  "IDs",
 	"url":  "URL",
 	"urls": "URLs",
 	"sdp":  "SDP",
@@ -79,6 +80,10 @@ var initialisms = map[string]string{
 	"hw":   "HW",
 	"pc":   "PC",
 	"dc":   "DC",
+	"cpu":  "CPU",
+	"tcp":  "TCP",
+	"udp":  "UDP",
+	"gso":  "GSO",
 }
 
 var specialTokens = map[string]string{
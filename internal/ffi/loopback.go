@@ -0,0 +1,75 @@
+package ffi
+
+import (
+	"runtime"
+	"unsafe"
+)
+
+// LoopbackNetworkConfig configures CreateLoopbackNetwork.
+type LoopbackNetworkConfig struct {
+	DelayMs       int32   // One-way delay added to every packet
+	LossRate      float64 // Probability in [0, 1) that a packet is lost
+	BandwidthKbps int32   // Uplink rate per PeerConnection; 0 = unlimited
+	QueueMs       int32   // Drop packets queued longer than this; 0 = unbounded
+	Seed          uint32  // Seed for the loss generator
+}
+
+// LoopbackNetworkStats matches ShimLoopbackNetworkStats in shim.h.
+type LoopbackNetworkStats struct {
+	PacketsSent      uint64
+	PacketsDelivered uint64
+	BytesDelivered   uint64
+	PacketsLost      uint64
+	PacketsDropped   uint64
+}
+
+// CreateLoopbackNetwork creates an in-process packet network. Pass the handle
+// in PeerConnectionFactoryConfig.LoopbackNetwork to connect PeerConnections
+// over it.
+func CreateLoopbackNetwork(config *LoopbackNetworkConfig) (uintptr, error) {
+	if !libLoaded.Load() || shimLoopbackNetworkCreate == nil {
+		return 0, ErrLibraryNotLoaded
+	}
+	if config == nil {
+		config = &LoopbackNetworkConfig{}
+	}
+
+	var errBuf ShimErrorBuffer
+	params := shimLoopbackNetworkCreateParams{
+		DelayMs:       config.DelayMs,
+		LossRate:      config.LossRate,
+		BandwidthKbps: config.BandwidthKbps,
+		QueueMs:       config.QueueMs,
+		Seed:          config.Seed,
+		ErrorOut:      errBuf.Ptr(),
+	}
+	network := shimLoopbackNetworkCreate(uintptr(unsafe.Pointer(&params)))
+	runtime.KeepAlive(&params)
+	if network == 0 {
+		msg := errBuf.String()
+		if msg != "" {
+			return 0, &ShimErrorWithMessage{Code: ShimErrInvalidParam, Message: msg}
+		}
+		return 0, ErrInitFailed
+	}
+	return network, nil
+}
+
+// LoopbackNetworkDestroy releases a loopback network handle. Factories
+// created with it keep the network alive.
+func LoopbackNetworkDestroy(network uintptr) {
+	if !libLoaded.Load() || shimLoopbackNetworkDestroy == nil || network == 0 {
+		return
+	}
+	shimLoopbackNetworkDestroy(network)
+}
+
+// LoopbackNetworkGetStats returns the network's packet counters.
+func LoopbackNetworkGetStats(network uintptr) LoopbackNetworkStats {
+	var stats LoopbackNetworkStats
+	if !libLoaded.Load() || shimLoopbackNetworkGetStats == nil || network == 0 {
+		return stats
+	}
+	shimLoopbackNetworkGetStats(network, uintptr(unsafe.Pointer(&stats)))
+	return stats
+}
@@ -0,0 +1,57 @@
+package ffi
+
+// shimEventQueueCreateParams matches ShimEventQueueCreateParams in shim.h.
+type shimEventQueueCreateParams struct {
+	Capacity int32
+	ErrorOut uintptr
+}
+
+// shimEventQueueDrainParams matches ShimEventQueueDrainParams in shim.h.
+type shimEventQueueDrainParams struct {
+	Queue         uintptr
+	Events        uintptr
+	MaxEvents     int32
+	Payload       uintptr
+	PayloadSize   int32
+	OutCount      int32
+	OutPayloadLen int32
+	OutDropped    uint64
+	ErrorOut      uintptr
+}
+
+// shimPeerConnectionSetEventQueueParams matches ShimPeerConnectionSetEventQueueParams in shim.h.
+type shimPeerConnectionSetEventQueueParams struct {
+	PC    uintptr
+	Queue uintptr
+	Tag   uint64
+}
+
+// shimDataChannelSetEventQueueParams matches ShimDataChannelSetEventQueueParams in shim.h.
+type shimDataChannelSetEventQueueParams struct {
+	DC    uintptr
+	Queue uintptr
+	Tag   uint64
+}
+
+// shimTrackSetEventQueueSinkParams matches ShimTrackSetEventQueueSinkParams in shim.h.
+type shimTrackSetEventQueueSinkParams struct {
+	Track uintptr
+	Queue uintptr
+	Tag   uint64
+}
+
+// shimRTPSenderSetRTCPFeedbackEventQueueParams matches ShimRTPSenderSetRTCPFeedbackEventQueueParams in shim.h.
+type shimRTPSenderSetRTCPFeedbackEventQueueParams struct {
+	PC         uintptr
+	Sender     uintptr
+	Queue      uintptr
+	Tag        uint64
+	IntervalMs int32
+}
+
+// shimRTPReceiverSetEncodedFrameEventQueueParams matches ShimRTPReceiverSetEncodedFrameEventQueueParams in shim.h.
+type shimRTPReceiverSetEncodedFrameEventQueueParams struct {
+	Receiver uintptr
+	Queue    uintptr
+	Tag      uint64
+}
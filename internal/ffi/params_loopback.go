@@ -0,0 +1,11 @@
+package ffi
+
+// shimLoopbackNetworkCreateParams matches ShimLoopbackNetworkCreateParams in shim.h.
+type shimLoopbackNetworkCreateParams struct {
+	DelayMs       int32
+	LossRate      float64
+	BandwidthKbps int32
+	QueueMs       int32
+	Seed          uint32
+	ErrorOut      uintptr
+}
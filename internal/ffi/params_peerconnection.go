@@ -2,6 +2,31 @@ package ffi
 
 // shimPeerConnectionCreateParams matches ShimPeerConnectionCreateParams in shim.h.
 type shimPeerConnectionCreateParams struct {
+	Config   uintptr
+	Factory  uintptr
+	ErrorOut uintptr
+}
+
+// shimPeerConnectionPoolCreateParams matches ShimPeerConnectionPoolCreateParams in shim.h.
+type shimPeerConnectionPoolCreateParams struct {
+	Config               uintptr
+	Factory              uintptr
+	TargetSize           int32
+	AudioTransceivers    int32
+	VideoTransceivers    int32
+	TransceiverDirection int32
+	ErrorOut             uintptr
+}
+
+// shimPeerConnectionAcquireParams matches ShimPeerConnectionAcquireParams in shim.h.
+type shimPeerConnectionAcquireParams struct {
+	Pool      uintptr
+	OutPooled int32
+	ErrorOut  uintptr
+}
+
+// shimPeerConnectionFactoryCreateParams matches ShimPeerConnectionFactoryCreateParams in shim.h.
+type shimPeerConnectionFactoryCreateParams struct {
 	Config   uintptr
 	ErrorOut uintptr
 }
@@ -64,20 +89,23 @@ type shimPeerConnectionSetOnNegotiationNeededParams struct {
 
 // shimPeerConnectionCreateOfferParams matches ShimPeerConnectionCreateOfferParams in shim.h.
 type shimPeerConnectionCreateOfferParams struct {
-	PC         uintptr
-	SDPOut     uintptr
-	SDPOutSize int32
-	OutSDPLen  int32
-	ErrorOut   uintptr
+	PC                     uintptr
+	ICERestart             int32
+	VoiceActivityDetection int32
+	SDPOut                 uintptr
+	SDPOutSize             int32
+	OutSDPLen              int32
+	ErrorOut               uintptr
 }
 
 // shimPeerConnectionCreateAnswerParams matches ShimPeerConnectionCreateAnswerParams in shim.h.
 type shimPeerConnectionCreateAnswerParams struct {
-	PC         uintptr
-	SDPOut     uintptr
-	SDPOutSize int32
-	OutSDPLen  int32
-	ErrorOut   uintptr
+	PC                     uintptr
+	VoiceActivityDetection int32
+	SDPOut                 uintptr
+	SDPOutSize             int32
+	OutSDPLen              int32
+	ErrorOut               uintptr
 }
 
 // shimPeerConnectionSetLocalDescriptionParams matches ShimPeerConnectionSetLocalDescriptionParams in shim.h.
@@ -96,6 +124,45 @@ type shimPeerConnectionSetRemoteDescriptionParams struct {
 	ErrorOut uintptr
 }
 
+// shimPeerConnectionCreateOfferAsyncParams matches ShimPeerConnectionCreateOfferAsyncParams in shim.h.
+type shimPeerConnectionCreateOfferAsyncParams struct {
+	PC                     uintptr
+	ICERestart             int32
+	VoiceActivityDetection int32
+	Callback               uintptr
+	Ctx                    uintptr
+	ErrorOut               uintptr
+}
+
+// shimPeerConnectionCreateAnswerAsyncParams matches ShimPeerConnectionCreateAnswerAsyncParams in shim.h.
+type shimPeerConnectionCreateAnswerAsyncParams struct {
+	PC                     uintptr
+	VoiceActivityDetection int32
+	Callback               uintptr
+	Ctx                    uintptr
+	ErrorOut               uintptr
+}
+
+// shimPeerConnectionSetLocalDescriptionAsyncParams matches ShimPeerConnectionSetLocalDescriptionAsyncParams in shim.h.
+type shimPeerConnectionSetLocalDescriptionAsyncParams struct {
+	PC       uintptr
+	Type     int32
+	SDP      uintptr
+	Callback uintptr
+	Ctx      uintptr
+	ErrorOut uintptr
+}
+
+// shimPeerConnectionSetRemoteDescriptionAsyncParams matches ShimPeerConnectionSetRemoteDescriptionAsyncParams in shim.h.
+type shimPeerConnectionSetRemoteDescriptionAsyncParams struct {
+	PC       uintptr
+	Type     int32
+	SDP      uintptr
+	Callback uintptr
+	Ctx      uintptr
+	ErrorOut uintptr
+}
+
 // shimPeerConnectionAddICECandidateParams matches ShimPeerConnectionAddICECandidateParams in shim.h.
 type shimPeerConnectionAddICECandidateParams struct {
 	PC            uintptr
@@ -169,3 +236,14 @@ type shimPeerConnectionSetOnBandwidthEstimateParams struct {
 	Callback uintptr
 	Ctx      uintptr
 }
+
+// shimThreadGroupCreateParams matches ShimThreadGroupCreateParams in shim.h.
+type shimThreadGroupCreateParams struct {
+	ShardCount    int32
+	FactoryConfig uintptr
+	PinThreads    int32
+	CPUIDs        uintptr
+	CPUIDCount    int32
+	SocketServer  int32
+	ErrorOut      uintptr
+}
@@ -30,9 +30,19 @@ type shimRTPSenderSetParametersParams struct {
 
 // shimRTPSenderSetOnRTCPFeedbackParams matches ShimRTPSenderSetOnRTCPFeedbackParams in shim.h.
 type shimRTPSenderSetOnRTCPFeedbackParams struct {
-	Sender   uintptr
-	Callback uintptr
-	Ctx      uintptr
+	PC         uintptr
+	Sender     uintptr
+	Callback   uintptr
+	Ctx        uintptr
+	IntervalMs int32
+}
+
+// shimPeerConnectionSetOnTransportFeedbackParams matches ShimPeerConnectionSetOnTransportFeedbackParams in shim.h.
+type shimPeerConnectionSetOnTransportFeedbackParams struct {
+	PC         uintptr
+	Callback   uintptr
+	Ctx        uintptr
+	IntervalMs int32
 }
 
 // shimRTPSenderSetLayerActiveParams matches ShimRTPSenderSetLayerActiveParams in shim.h.
@@ -86,6 +96,13 @@ type shimRTPReceiverSetJitterBufferMinDelayParams struct {
 	MinDelayMs int32
 }
 
+// shimRTPReceiverSetOnEncodedFrameParams matches ShimRTPReceiverSetOnEncodedFrameParams in shim.h.
+type shimRTPReceiverSetOnEncodedFrameParams struct {
+	Receiver uintptr
+	Callback uintptr
+	Ctx      uintptr
+}
+
 // shimTransceiverSetDirectionParams matches ShimTransceiverSetDirectionParams in shim.h.
 type shimTransceiverSetDirectionParams struct {
 	Transceiver uintptr
@@ -0,0 +1,7 @@
+package ffi
+
+// shimSetSocketServerParams matches ShimSetSocketServerParams in shim.h.
+type shimSetSocketServerParams struct {
+	Type     int32
+	ErrorOut uintptr
+}
@@ -0,0 +1,22 @@
+package ffi
+
+// shimSRTPContextCreateParams matches ShimSRTPContextCreateParams in shim.h.
+type shimSRTPContextCreateParams struct {
+	Profile    int32
+	SendKey    uintptr
+	SendKeyLen int32
+	RecvKey    uintptr
+	RecvKeyLen int32
+	ErrorOut   uintptr
+}
+
+// shimSRTPBatchParams matches ShimSRTPBatchParams in shim.h.
+type shimSRTPBatchParams struct {
+	Context    uintptr
+	Packets    uintptr
+	Sizes      uintptr
+	Capacities uintptr
+	Count      int32
+	OutFailed  int32
+	ErrorOut   uintptr
+}
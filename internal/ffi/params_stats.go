@@ -30,18 +30,54 @@ type shimPeerConnectionGetStatsParams struct {
 
 // shimRTPSenderGetStatsParams matches ShimRTPSenderGetStatsParams in shim.h.
 type shimRTPSenderGetStatsParams struct {
+	PC       uintptr
 	Sender   uintptr
 	OutStats RTCStats
 }
 
 // shimRTPReceiverGetStatsParams matches ShimRTPReceiverGetStatsParams in shim.h.
 type shimRTPReceiverGetStatsParams struct {
+	PC       uintptr
 	Receiver uintptr
 	OutStats RTCStats
 }
 
+// shimPeerConnectionGetStreamStatsParams matches ShimPeerConnectionGetStreamStatsParams in shim.h.
+type shimPeerConnectionGetStreamStatsParams struct {
+	PC         uintptr
+	Sender     uintptr
+	Receiver   uintptr
+	Flags      int32
+	Streams    uintptr
+	MaxStreams int32
+	OutCount   int32
+	OutTotal   int32
+	ErrorOut   uintptr
+}
+
 // shimPeerConnectionGetBandwidthEstimateParams matches ShimPeerConnectionGetBandwidthEstimateParams in shim.h.
 type shimPeerConnectionGetBandwidthEstimateParams struct {
 	PC          uintptr
 	OutEstimate BandwidthEstimate
 }
+
+// shimStatsRingCreateParams matches ShimStatsRingCreateParams in shim.h.
+type shimStatsRingCreateParams struct {
+	Capacity int32
+	ErrorOut uintptr
+}
+
+// shimStatsRingSubscribeParams matches ShimStatsRingSubscribeParams in shim.h.
+type shimStatsRingSubscribeParams struct {
+	Ring       uintptr
+	PC         uintptr
+	IntervalMs int32
+	Tag        uint64
+	ErrorOut   uintptr
+}
+
+// shimStatsRingUnsubscribeParams matches ShimStatsRingUnsubscribeParams in shim.h.
+type shimStatsRingUnsubscribeParams struct {
+	Ring uintptr
+	PC   uintptr
+}
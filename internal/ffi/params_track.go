@@ -19,6 +19,20 @@ type shimVideoTrackSourcePushFrameParams struct {
 	TimestampUs int64
 }
 
+// shimVideoTrackSourceGetPoolStatsParams matches ShimVideoTrackSourceGetPoolStatsParams in shim.h.
+type shimVideoTrackSourceGetPoolStatsParams struct {
+	Source     uintptr
+	PoolHits   uint64
+	PoolMisses uint64
+}
+
+// shimVideoFrameRingCreateParams matches ShimVideoFrameRingCreateParams in shim.h.
+type shimVideoFrameRingCreateParams struct {
+	Source   uintptr
+	Slots    int32
+	ErrorOut uintptr
+}
+
 // shimPeerConnectionAddVideoTrackFromSourceParams matches ShimPeerConnectionAddVideoTrackFromSourceParams in shim.h.
 type shimPeerConnectionAddVideoTrackFromSourceParams struct {
 	PC       uintptr
@@ -28,6 +42,89 @@ type shimPeerConnectionAddVideoTrackFromSourceParams struct {
 	ErrorOut uintptr
 }
 
+// shimEncodedVideoSourceCreateParams matches ShimEncodedVideoSourceCreateParams in shim.h.
+type shimEncodedVideoSourceCreateParams struct {
+	Codec                 int32
+	Width                 int32
+	Height                int32
+	MinKeyframeIntervalMs int32
+	ErrorOut              uintptr
+}
+
+// shimEncodedVideoSourceSetOnKeyFrameRequestParams matches ShimEncodedVideoSourceSetOnKeyFrameRequestParams in shim.h.
+type shimEncodedVideoSourceSetOnKeyFrameRequestParams struct {
+	Source   uintptr
+	Callback uintptr
+	Ctx      uintptr
+}
+
+// shimEncodedVideoSourcePushFrameParams matches ShimEncodedVideoSourcePushFrameParams in shim.h.
+type shimEncodedVideoSourcePushFrameParams struct {
+	Source      uintptr
+	Data        uintptr
+	Size        int32
+	Width       int32
+	Height      int32
+	IsKeyframe  int32
+	TemporalID  int32
+	TimestampUs int64
+	ErrorOut    uintptr
+}
+
+// shimPeerConnectionAddEncodedVideoTrackParams matches ShimPeerConnectionAddEncodedVideoTrackParams in shim.h.
+type shimPeerConnectionAddEncodedVideoTrackParams struct {
+	PC       uintptr
+	Source   uintptr
+	TrackID  uintptr
+	StreamID uintptr
+	ErrorOut uintptr
+}
+
+// shimEncodedVideoSourceSetMaxTemporalLayerParams matches ShimEncodedVideoSourceSetMaxTemporalLayerParams in shim.h.
+type shimEncodedVideoSourceSetMaxTemporalLayerParams struct {
+	Source           uintptr
+	MaxTemporalLayer int32
+}
+
+// shimSharedVideoEncoderCreateParams matches ShimSharedVideoEncoderCreateParams in shim.h.
+type shimSharedVideoEncoderCreateParams struct {
+	Codec                 int32
+	Width                 int32
+	Height                int32
+	BitrateBps            int32
+	Framerate             int32
+	TemporalLayers        int32
+	MinKeyframeIntervalMs int32
+	ErrorOut              uintptr
+}
+
+// shimSharedVideoEncoderPushFrameParams matches ShimSharedVideoEncoderPushFrameParams in shim.h.
+type shimSharedVideoEncoderPushFrameParams struct {
+	Encoder     uintptr
+	YPlane      uintptr
+	UPlane      uintptr
+	VPlane      uintptr
+	YStride     int32
+	UStride     int32
+	VStride     int32
+	TimestampUs int64
+	ErrorOut    uintptr
+}
+
+// shimSharedVideoEncoderSetRatesParams matches ShimSharedVideoEncoderSetRatesParams in shim.h.
+type shimSharedVideoEncoderSetRatesParams struct {
+	Encoder    uintptr
+	BitrateBps int32
+	Framerate  int32
+}
+
+// shimSharedVideoEncoderSubscribeParams matches ShimSharedVideoEncoderSubscribeParams in shim.h.
+type shimSharedVideoEncoderSubscribeParams struct {
+	Encoder          uintptr
+	MaxTemporalLayer int32
+	ErrorOut         uintptr
+}
+
 // shimAudioTrackSourceCreateParams matches ShimAudioTrackSourceCreateParams in shim.h.
 type shimAudioTrackSourceCreateParams struct {
 	PC         uintptr
@@ -65,3 +162,41 @@ type shimTrackSetAudioSinkParams struct {
 	Callback uintptr
 	Ctx      uintptr
 }
+
+// shimTrackSetVideoMailboxParams matches ShimTrackSetVideoMailboxParams in shim.h.
+type shimTrackSetVideoMailboxParams struct {
+	Track uintptr
+	Slots int32
+}
+
+// shimTrackPullVideoFrameParams matches ShimTrackPullVideoFrameParams in shim.h.
+type shimTrackPullVideoFrameParams struct {
+	Track         uintptr
+	Frame         uintptr
+	Width         int32
+	Height        int32
+	YPlane        uintptr
+	UPlane        uintptr
+	VPlane        uintptr
+	YStride       int32
+	UStride       int32
+	VStride       int32
+	TimestampUs   int64
+	FramesDropped uint64
+}
+
+// shimTrackSetVideoSinkWantsParams matches ShimTrackSetVideoSinkWantsParams in shim.h.
+type shimTrackSetVideoSinkWantsParams struct {
+	Track            uintptr
+	MaxPixelCount    int32
+	TargetPixelCount int32
+	MaxFramerate     int32
+}
+
+// shimTrackSetAudioSinkFormatParams matches ShimTrackSetAudioSinkFormatParams in shim.h.
+type shimTrackSetAudioSinkFormatParams struct {
+	Track      uintptr
+	BatchMs    int32
+	SampleRate int32
+	Channels   int32
+}
@@ -4,7 +4,6 @@ import (
 	"log"
 	"runtime"
 	"sync"
-	"sync/atomic"
 	"unsafe"
 
 	"github.com/ebitengine/purego"
@@ -25,8 +24,10 @@ func safeCallback(fn func()) {
 // VideoFrameCallback is called when a video frame is received from a remote track.
 type VideoFrameCallback func(width, height int, yPlane, uPlane, vPlane []byte, yStride, uStride, vStride int, timestampUs int64)
 
-// AudioFrameCallback is called when audio samples are received from a remote track.
-type AudioFrameCallback func(samples []int16, sampleRate, channels int, timestampUs int64)
+// AudioFrameCallback is called when audio samples are received from a remote
+// track. timestampUs is the arrival time; captureTimeUs is the sender's NTP
+// capture time, valid if hasCaptureTime.
+type AudioFrameCallback func(samples []int16, sampleRate, channels int, timestampUs, captureTimeUs int64, hasCaptureTime bool)
 
 // Global callback registry for remote track sinks
 var (
@@ -102,9 +103,9 @@ func initCallbacks() {
 	})
 
 	// Create the audio sink callback
-	// Signature: void(ctx, samples, num_samples, sample_rate, channels, timestamp_us)
+	// Signature: void(ctx, samples, num_samples, sample_rate, channels, timestamp_us, capture_time_us, has_capture_time)
 	// NOTE: C uses 'int' (32-bit) for numSamples/sampleRate/channels, so we must use int32 to match
-	audioSinkCallbackPtr = purego.NewCallback(func(ctx uintptr, samples uintptr, numSamples, sampleRate, channels int32, timestampUs int64) uintptr {
+	audioSinkCallbackPtr = purego.NewCallback(func(ctx uintptr, samples uintptr, numSamples, sampleRate, channels int32, timestampUs, captureTimeUs int64, hasCaptureTime int32) uintptr {
 		audioCallbackMu.RLock()
 		cb, ok := audioCallbacks[ctx]
 		audioCallbackMu.RUnlock()
@@ -125,7 +126,7 @@ func initCallbacks() {
 		samplesData := CopyInt16FromC(samples, totalSamples)
 
 		safeCallback(func() {
-			cb(samplesData, int(sampleRate), int(channels), timestampUs)
+			cb(samplesData, int(sampleRate), int(channels), timestampUs, captureTimeUs, hasCaptureTime != 0)
 		})
 		return 0
 	})
@@ -189,8 +190,29 @@ type PeerConnectionConfig struct {
 	BundlePolicy         *byte // C string
 	RTCPMuxPolicy        *byte // C string
 	SDPSemantics         *byte // C string
+
+	ICETransportPolicy     *byte // C string
+	CandidateNetworkPolicy *byte // C string
+	TCPCandidatePolicy     *byte // C string
+	PortRangeMin           int32
+	PortRangeMax           int32
+	ContinualGathering     int32
+	ICECheckIntervalMs     int32
+	ICECheckMinIntervalMs  int32
+
+	NetworkController int32
+	StartBitrateBps   int32
+	MinBitrateBps     int32
+	MaxBitrateBps     int32
+	DisableProbing    int32
 }
 
+// Congestion controllers for PeerConnectionConfig.NetworkController.
+const (
+	NetworkControllerGoogCC = 0
+	NetworkControllerFixed  = 1
+)
+
 // ICEServerConfig matches ShimICEServer in shim.h
 type ICEServerConfig struct {
 	URLs       uintptr // Pointer to array of C strings
@@ -209,8 +231,154 @@ func (c *ICEServerConfig) Ptr() uintptr {
 	return uintptr(unsafe.Pointer(c))
 }
 
-// CreatePeerConnection creates a new PeerConnection.
+// Video codec factory selection for PeerConnectionFactoryConfig.
+// Values match ShimVideoCodecFactoryType in shim.h.
+const (
+	VideoCodecFactoryAuto     int32 = 0
+	VideoCodecFactoryBuiltin  int32 = 1
+	VideoCodecFactorySoftware int32 = 2
+)
+
+// PeerConnectionFactoryConfig matches ShimPeerConnectionFactoryConfig in shim.h
+type PeerConnectionFactoryConfig struct {
+	VideoCodecFactory      int32
+	DisableAudioDevice     int32
+	DisableAudioProcessing int32
+	UDPMuxPort             int32
+	UDPMuxAddress          *byte
+	LoopbackNetwork        uintptr
+	DisableVideoDecoding   int32
+}
+
+// CreatePeerConnectionFactory creates a PeerConnectionFactory that can be
+// shared by many PeerConnections. config may be nil for defaults.
+func CreatePeerConnectionFactory(config *PeerConnectionFactoryConfig) (uintptr, error) {
+	if !libLoaded.Load() || shimPeerConnectionFactoryCreate == nil {
+		return 0, ErrLibraryNotLoaded
+	}
+	var errBuf ShimErrorBuffer
+	var configPtr uintptr
+	if config != nil {
+		configPtr = uintptr(unsafe.Pointer(config))
+	}
+	params := shimPeerConnectionFactoryCreateParams{
+		Config:   configPtr,
+		ErrorOut: errBuf.Ptr(),
+	}
+	factory := shimPeerConnectionFactoryCreate(uintptr(unsafe.Pointer(&params)))
+	runtime.KeepAlive(config)
+	runtime.KeepAlive(&params)
+	if factory == 0 {
+		msg := errBuf.String()
+		if msg != "" {
+			return 0, &ShimErrorWithMessage{Code: ShimErrInitFailed, Message: msg}
+		}
+		return 0, ErrInitFailed
+	}
+	return factory, nil
+}
+
+// PeerConnectionFactoryDestroy releases a PeerConnectionFactory handle.
+// PeerConnections created from it keep their own reference and stay valid.
+func PeerConnectionFactoryDestroy(factory uintptr) {
+	if !libLoaded.Load() || shimPeerConnectionFactoryDestroy == nil || factory == 0 {
+		return
+	}
+	shimPeerConnectionFactoryDestroy(factory)
+}
+
+// ThreadGroupConfig configures CreateThreadGroup.
+type ThreadGroupConfig struct {
+	ShardCount    int                          // 0 = one shard per CPU core
+	FactoryConfig *PeerConnectionFactoryConfig // nil for defaults
+	PinThreads    bool                         // Pin each shard's threads to one CPU (Linux only)
+	CPUIDs        []int32                      // Optional CPU list; shard i uses CPUIDs[i%len]
+	SocketServer  int32                        // SocketServer* for the shards' network threads
+}
+
+// CreateThreadGroup creates a group of signaling/worker/network thread
+// triplets, each with its own PeerConnectionFactory.
+func CreateThreadGroup(config *ThreadGroupConfig) (uintptr, error) {
+	if !libLoaded.Load() || shimThreadGroupCreate == nil {
+		return 0, ErrLibraryNotLoaded
+	}
+	if config == nil {
+		config = &ThreadGroupConfig{}
+	}
+	var errBuf ShimErrorBuffer
+	var factoryConfigPtr uintptr
+	if config.FactoryConfig != nil {
+		factoryConfigPtr = uintptr(unsafe.Pointer(config.FactoryConfig))
+	}
+	var pin int32
+	if config.PinThreads {
+		pin = 1
+	}
+	params := shimThreadGroupCreateParams{
+		ShardCount:    int32(config.ShardCount),
+		FactoryConfig: factoryConfigPtr,
+		PinThreads:    pin,
+		CPUIDs:        Int32SlicePtr(config.CPUIDs),
+		CPUIDCount:    int32(len(config.CPUIDs)),
+		SocketServer:  config.SocketServer,
+		ErrorOut:      errBuf.Ptr(),
+	}
+	group := shimThreadGroupCreate(uintptr(unsafe.Pointer(&params)))
+	runtime.KeepAlive(config)
+	runtime.KeepAlive(&params)
+	if group == 0 {
+		msg := errBuf.String()
+		if msg != "" {
+			return 0, &ShimErrorWithMessage{Code: ShimErrInitFailed, Message: msg}
+		}
+		return 0, ErrInitFailed
+	}
+	return group, nil
+}
+
+// ThreadGroupShardCount returns the number of shards in a thread group.
+func ThreadGroupShardCount(group uintptr) int {
+	if !libLoaded.Load() || shimThreadGroupShardCount == nil || group == 0 {
+		return 0
+	}
+	return int(shimThreadGroupShardCount(group))
+}
+
+// ThreadGroupNextFactory returns the factory of the next shard in round-robin
+// order. The handle is borrowed and valid until the group is destroyed.
+func ThreadGroupNextFactory(group uintptr) uintptr {
+	if !libLoaded.Load() || shimThreadGroupNextFactory == nil || group == 0 {
+		return 0
+	}
+	return shimThreadGroupNextFactory(group)
+}
+
+// ThreadGroupFactory returns the factory of a specific shard, or 0 if shard
+// is out of range. The handle is borrowed and valid until the group is destroyed.
+func ThreadGroupFactory(group uintptr, shard int) uintptr {
+	if !libLoaded.Load() || shimThreadGroupFactory == nil || group == 0 {
+		return 0
+	}
+	return shimThreadGroupFactory(group, int32(shard))
+}
+
+// ThreadGroupDestroy destroys a thread group. PeerConnections created from
+// its factories keep their shard's threads alive until they are destroyed.
+func ThreadGroupDestroy(group uintptr) {
+	if !libLoaded.Load() || shimThreadGroupDestroy == nil || group == 0 {
+		return
+	}
+	shimThreadGroupDestroy(group)
+}
+
+// CreatePeerConnection creates a new PeerConnection with its own factory.
 func CreatePeerConnection(config *PeerConnectionConfig) (uintptr, error) {
+	return CreatePeerConnectionWithFactory(0, config)
+}
+
+// CreatePeerConnectionWithFactory creates a new PeerConnection using a shared
+// factory from CreatePeerConnectionFactory. A zero factory creates a private one.
+func CreatePeerConnectionWithFactory(factory uintptr, config *PeerConnectionConfig) (uintptr, error) {
 	if !libLoaded.Load() || shimPeerConnectionCreate == nil {
 		return 0, ErrLibraryNotLoaded
 	}
@@ -221,6 +389,7 @@ func CreatePeerConnection(config *PeerConnectionConfig) (uintptr, error) {
 	}
 	params := shimPeerConnectionCreateParams{
 		Config:   configPtr,
+		Factory:  factory,
 		ErrorOut: errBuf.Ptr(),
 	}
 	pc := shimPeerConnectionCreate(uintptr(unsafe.Pointer(&params)))
@@ -236,6 +405,90 @@ func CreatePeerConnection(config *PeerConnectionConfig) (uintptr, error) {
 	return pc, nil
 }
 
+// PeerConnectionPoolConfig configures CreatePeerConnectionPool.
+type PeerConnectionPoolConfig struct {
+	Config               *PeerConnectionConfig // Template for every pooled connection
+	Factory              uintptr               // 0 builds one factory for the pool
+	TargetSize           int                   // Idle connections kept ready
+	AudioTransceivers    int                   // Template audio transceivers per connection
+	VideoTransceivers    int                   // Template video transceivers per connection
+	TransceiverDirection TransceiverDirection  // Direction of the template transceivers
+}
+
+// CreatePeerConnectionPool creates a pool that keeps connections created,
+// with their template transceivers and gathered candidates, ahead of time.
+func CreatePeerConnectionPool(config *PeerConnectionPoolConfig) (uintptr, error) {
+	if !libLoaded.Load() || shimPeerConnectionPoolCreate == nil {
+		return 0, ErrLibraryNotLoaded
+	}
+	var errBuf ShimErrorBuffer
+	var configPtr uintptr
+	if config.Config != nil {
+		configPtr = config.Config.Ptr()
+	}
+	params := shimPeerConnectionPoolCreateParams{
+		Config:               configPtr,
+		Factory:              config.Factory,
+		TargetSize:           int32(config.TargetSize),
+		AudioTransceivers:    int32(config.AudioTransceivers),
+		VideoTransceivers:    int32(config.VideoTransceivers),
+		TransceiverDirection: int32(config.TransceiverDirection),
+		ErrorOut:             errBuf.Ptr(),
+	}
+	pool := shimPeerConnectionPoolCreate(uintptr(unsafe.Pointer(&params)))
+	runtime.KeepAlive(config)
+	runtime.KeepAlive(&params)
+	if pool == 0 {
+		msg := errBuf.String()
+		if msg != "" {
+			return 0, &ShimErrorWithMessage{Code: ShimErrInitFailed, Message: msg}
+		}
+		return 0, ErrInitFailed
+	}
+	return pool, nil
+}
+
+// PeerConnectionAcquire takes a ready connection from the pool, or creates
+// one inline when the pool is empty; pooled reports which. The caller owns
+// the connection and releases it with PeerConnectionDestroy.
+func PeerConnectionAcquire(pool uintptr) (pc uintptr, pooled bool, err error) {
+	if !libLoaded.Load() || shimPeerConnectionAcquire == nil {
+		return 0, false, ErrLibraryNotLoaded
+	}
+	var errBuf ShimErrorBuffer
+	params := shimPeerConnectionAcquireParams{
+		Pool:     pool,
+		ErrorOut: errBuf.Ptr(),
+	}
+	pc = shimPeerConnectionAcquire(uintptr(unsafe.Pointer(&params)))
+	runtime.KeepAlive(&params)
+	if pc == 0 {
+		msg := errBuf.String()
+		if msg != "" {
+			return 0, false, &ShimErrorWithMessage{Code: ShimErrInitFailed, Message: msg}
+		}
+		return 0, false, ErrInitFailed
+	}
+	return pc, params.OutPooled != 0, nil
+}
+
+// PeerConnectionPoolReady returns the number of connections ready to acquire.
+func PeerConnectionPoolReady(pool uintptr) int {
+	if !libLoaded.Load() || shimPeerConnectionPoolReady == nil || pool == 0 {
+		return 0
+	}
+	return int(shimPeerConnectionPoolReady(pool))
+}
+
+// PeerConnectionPoolDestroy stops refilling the pool and destroys its idle
+// connections. Acquired connections are unaffected.
+func PeerConnectionPoolDestroy(pool uintptr) {
+	if !libLoaded.Load() || shimPeerConnectionPoolDestroy == nil || pool == 0 {
+		return
+	}
+	shimPeerConnectionPoolDestroy(pool)
+}
+
 // PeerConnectionDestroy destroys a PeerConnection.
 func PeerConnectionDestroy(pc uintptr) {
 	if !libLoaded.Load() || shimPeerConnectionDestroy == nil {
@@ -244,19 +497,43 @@ func PeerConnectionDestroy(pc uintptr) {
 	shimPeerConnectionDestroy(pc)
 }
 
-// PeerConnectionCreateOffer creates an SDP offer.
-// Returns the SDP string written to the provided buffer.
-func PeerConnectionCreateOffer(pc uintptr, sdpBuf []byte) (int, error) {
+// OfferAnswerOptions are the options of an offer or answer. ICERestart only
+// applies to offers.
+type OfferAnswerOptions struct {
+	ICERestart             bool
+	VoiceActivityDetection bool
+}
+
+// flags returns the options as shim flags; nil selects libwebrtc's defaults.
+func (o *OfferAnswerOptions) flags() (iceRestart, voiceActivityDetection int32) {
+	if o == nil {
+		return 0, 1
+	}
+	if o.ICERestart {
+		iceRestart = 1
+	}
+	if o.VoiceActivityDetection {
+		voiceActivityDetection = 1
+	}
+	return iceRestart, voiceActivityDetection
+}
+
+// PeerConnectionCreateOffer creates an SDP offer with opts (nil for the
+// defaults). Returns the SDP string written to the provided buffer.
+func PeerConnectionCreateOffer(pc uintptr, opts *OfferAnswerOptions, sdpBuf []byte) (int, error) {
 	if !libLoaded.Load() || shimPeerConnectionCreateOffer == nil {
 		return 0, ErrLibraryNotLoaded
 	}
 
+	iceRestart, vad := opts.flags()
 	var errBuf ShimErrorBuffer
 	params := shimPeerConnectionCreateOfferParams{
-		PC:         pc,
-		SDPOut:     ByteSlicePtr(sdpBuf),
-		SDPOutSize: int32(len(sdpBuf)),
-		ErrorOut:   errBuf.Ptr(),
+		PC:                     pc,
+		ICERestart:             iceRestart,
+		VoiceActivityDetection: vad,
+		SDPOut:                 ByteSlicePtr(sdpBuf),
+		SDPOutSize:             int32(len(sdpBuf)),
+		ErrorOut:               errBuf.Ptr(),
 	}
 	result := shimPeerConnectionCreateOffer(uintptr(unsafe.Pointer(&params)))
 	runtime.KeepAlive(sdpBuf)
@@ -269,18 +546,21 @@ func PeerConnectionCreateOffer(pc uintptr, sdpBuf []byte) (int, error) {
 	return int(params.OutSDPLen), nil
 }
 
-// PeerConnectionCreateAnswer creates an SDP answer.
-func PeerConnectionCreateAnswer(pc uintptr, sdpBuf []byte) (int, error) {
+// PeerConnectionCreateAnswer creates an SDP answer with opts (nil for the
+// defaults).
+func PeerConnectionCreateAnswer(pc uintptr, opts *OfferAnswerOptions, sdpBuf []byte) (int, error) {
 	if !libLoaded.Load() || shimPeerConnectionCreateAnswer == nil {
 		return 0, ErrLibraryNotLoaded
 	}
 
+	_, vad := opts.flags()
 	var errBuf ShimErrorBuffer
 	params := shimPeerConnectionCreateAnswerParams{
-		PC:         pc,
-		SDPOut:     ByteSlicePtr(sdpBuf),
-		SDPOutSize: int32(len(sdpBuf)),
-		ErrorOut:   errBuf.Ptr(),
+		PC:                     pc,
+		VoiceActivityDetection: vad,
+		SDPOut:                 ByteSlicePtr(sdpBuf),
+		SDPOutSize:             int32(len(sdpBuf)),
+		ErrorOut:               errBuf.Ptr(),
 	}
 	result := shimPeerConnectionCreateAnswer(uintptr(unsafe.Pointer(&params)))
 	runtime.KeepAlive(sdpBuf)
@@ -333,6 +613,198 @@ func PeerConnectionSetRemoteDescription(pc uintptr, sdpType int, sdp string) err
 	return errBuf.ToError(result)
 }
 
+// ============================================================================
+// Async Offer/Answer and Descriptions
+// ============================================================================
+
+// SessionDescriptionCallback receives the result of an async offer/answer or
+// set-description call. sdp is empty for set-description calls.
+// It runs on the signaling thread and must not call the blocking
+// offer/answer/description functions on the same PeerConnection.
+type SessionDescriptionCallback func(sdp string, err error)
+
+var (
+	sdpCompleteCallbackMu  sync.Mutex
+	sdpCompleteCallbacks   = make(map[uintptr]SessionDescriptionCallback)
+	sdpCompleteNextID      uintptr
+	sdpCompleteCallbackPtr uintptr
+	sdpCompleteInitialized bool
+)
+
+func initSDPCompleteCallback() {
+	callbackInitMu.Lock()
+	defer callbackInitMu.Unlock()
+
+	if sdpCompleteInitialized {
+		return
+	}
+
+	sdpCompleteCallbackPtr = purego.NewCallback(func(ctx uintptr, result int32, sdpPtr uintptr, sdpLen int32, errPtr uintptr) uintptr {
+		sdpCompleteCallbackMu.Lock()
+		cb := sdpCompleteCallbacks[ctx]
+		delete(sdpCompleteCallbacks, ctx)
+		sdpCompleteCallbackMu.Unlock()
+
+		// The SDP buffer is ours even if nobody is waiting for it.
+		var sdp string
+		if sdpPtr != 0 {
+			if sdpLen > 0 {
+				sdp = string(CopyBytesFromC(sdpPtr, int(sdpLen)))
+			}
+			shimFreeBuffer(sdpPtr)
+		}
+
+		if cb != nil {
+			var err error
+			if result != ShimOK {
+				err = &ShimErrorWithMessage{Code: result, Message: GoStringFromC(errPtr)}
+			}
+			safeCallback(func() {
+				cb(sdp, err)
+			})
+		}
+		return 0
+	})
+
+	sdpCompleteInitialized = true
+}
+
+// registerSDPComplete stores cb and returns the ctx token passed to the shim.
+func registerSDPComplete(cb SessionDescriptionCallback) uintptr {
+	initSDPCompleteCallback()
+
+	sdpCompleteCallbackMu.Lock()
+	sdpCompleteNextID++
+	id := sdpCompleteNextID
+	sdpCompleteCallbacks[id] = cb
+	sdpCompleteCallbackMu.Unlock()
+	return id
+}
+
+// unregisterSDPComplete drops a callback whose operation was rejected up front.
+func unregisterSDPComplete(id uintptr) {
+	sdpCompleteCallbackMu.Lock()
+	delete(sdpCompleteCallbacks, id)
+	sdpCompleteCallbackMu.Unlock()
+}
+
+// PeerConnectionCreateOfferAsync starts creating an SDP offer and returns
+// immediately. cb is invoked once with the offer or an error, unless this
+// function itself returns an error.
+func PeerConnectionCreateOfferAsync(pc uintptr, opts *OfferAnswerOptions, cb SessionDescriptionCallback) error {
+	if !libLoaded.Load() || shimPeerConnectionCreateOfferAsync == nil {
+		return ErrLibraryNotLoaded
+	}
+
+	id := registerSDPComplete(cb)
+	iceRestart, vad := opts.flags()
+	var errBuf ShimErrorBuffer
+	params := shimPeerConnectionCreateOfferAsyncParams{
+		PC:                     pc,
+		ICERestart:             iceRestart,
+		VoiceActivityDetection: vad,
+		Callback:               sdpCompleteCallbackPtr,
+		Ctx:                    id,
+		ErrorOut:               errBuf.Ptr(),
+	}
+	result := shimPeerConnectionCreateOfferAsync(uintptr(unsafe.Pointer(&params)))
+	runtime.KeepAlive(&params)
+
+	if err := errBuf.ToError(result); err != nil {
+		unregisterSDPComplete(id)
+		return err
+	}
+	return nil
+}
+
+// PeerConnectionCreateAnswerAsync starts creating an SDP answer and returns
+// immediately. cb is invoked once with the answer or an error, unless this
+// function itself returns an error.
+func PeerConnectionCreateAnswerAsync(pc uintptr, opts *OfferAnswerOptions, cb SessionDescriptionCallback) error {
+	if !libLoaded.Load() || shimPeerConnectionCreateAnswerAsync == nil {
+		return ErrLibraryNotLoaded
+	}
+
+	id := registerSDPComplete(cb)
+	_, vad := opts.flags()
+	var errBuf ShimErrorBuffer
+	params := shimPeerConnectionCreateAnswerAsyncParams{
+		PC:                     pc,
+		VoiceActivityDetection: vad,
+		Callback:               sdpCompleteCallbackPtr,
+		Ctx:                    id,
+		ErrorOut:               errBuf.Ptr(),
+	}
+	result := shimPeerConnectionCreateAnswerAsync(uintptr(unsafe.Pointer(&params)))
+	runtime.KeepAlive(&params)
+
+	if err := errBuf.ToError(result); err != nil {
+		unregisterSDPComplete(id)
+		return err
+	}
+	return nil
+}
+
+// PeerConnectionSetLocalDescriptionAsync starts applying a local description
+// and returns immediately. cb is invoked once when it has been applied, unless
+// this function itself returns an error.
+func PeerConnectionSetLocalDescriptionAsync(pc uintptr, sdpType int, sdp string, cb SessionDescriptionCallback) error {
+	if !libLoaded.Load() || shimPeerConnectionSetLocalDescriptionAsync == nil {
+		return ErrLibraryNotLoaded
+	}
+
+	id := registerSDPComplete(cb)
+	sdpCStr := CString(sdp)
+	var errBuf ShimErrorBuffer
+	params := shimPeerConnectionSetLocalDescriptionAsyncParams{
+		PC:       pc,
+		Type:     int32(sdpType),
+		SDP:      ByteSlicePtr(sdpCStr),
+		Callback: sdpCompleteCallbackPtr,
+		Ctx:      id,
+		ErrorOut: errBuf.Ptr(),
+	}
+	result := shimPeerConnectionSetLocalDescriptionAsync(uintptr(unsafe.Pointer(&params)))
+	runtime.KeepAlive(sdpCStr)
+	runtime.KeepAlive(&params)
+
+	if err := errBuf.ToError(result); err != nil {
+		unregisterSDPComplete(id)
+		return err
+	}
+	return nil
+}
+
+// PeerConnectionSetRemoteDescriptionAsync starts applying a remote description
+// and returns immediately. cb is invoked once when it has been applied, unless
+// this function itself returns an error.
+func PeerConnectionSetRemoteDescriptionAsync(pc uintptr, sdpType int, sdp string, cb SessionDescriptionCallback) error {
+	if !libLoaded.Load() || shimPeerConnectionSetRemoteDescriptionAsync == nil {
+		return ErrLibraryNotLoaded
+	}
+
+	id := registerSDPComplete(cb)
+	sdpCStr := CString(sdp)
+	var errBuf ShimErrorBuffer
+	params := shimPeerConnectionSetRemoteDescriptionAsyncParams{
+		PC:       pc,
+		Type:     int32(sdpType),
+		SDP:      ByteSlicePtr(sdpCStr),
+		Callback: sdpCompleteCallbackPtr,
+		Ctx:      id,
+		ErrorOut: errBuf.Ptr(),
+	}
+	result := shimPeerConnectionSetRemoteDescriptionAsync(uintptr(unsafe.Pointer(&params)))
+	runtime.KeepAlive(sdpCStr)
+	runtime.KeepAlive(&params)
+
+	if err := errBuf.ToError(result); err != nil {
+		unregisterSDPComplete(id)
+		return err
+	}
+	return nil
+}
+
 // PeerConnectionAddICECandidate adds an ICE candidate.
 func PeerConnectionAddICECandidate(pc uintptr, candidate, sdpMid string, sdpMLineIndex int) error {
 	if !libLoaded.Load() || shimPeerConnectionAddICECandidate == nil {
@@ -717,40 +1189,313 @@ func UnregisterDataChannelCallbacks(dc uintptr) {
 	delete(dcOpenCallbacks, dc)
 	dcOpenCallbackMu.Unlock()
 
-	dcCloseCallbackMu.Lock()
-	delete(dcCloseCallbacks, dc)
-	dcCloseCallbackMu.Unlock()
+	dcCloseCallbackMu.Lock()
+	delete(dcCloseCallbacks, dc)
+	dcCloseCallbackMu.Unlock()
+}
+
+// VideoTrackSourceCreate creates a video track source for frame injection.
+func VideoTrackSourceCreate(pc uintptr, width, height int) uintptr {
+	if !libLoaded.Load() || shimVideoTrackSourceCreate == nil {
+		return 0
+	}
+	params := shimVideoTrackSourceCreateParams{
+		PC:     pc,
+		Width:  int32(width),
+		Height: int32(height),
+	}
+	result := shimVideoTrackSourceCreate(uintptr(unsafe.Pointer(&params)))
+	runtime.KeepAlive(&params)
+	return result
+}
+
+// VideoTrackSourcePushFrame pushes an I420 frame to the video track source.
+func VideoTrackSourcePushFrame(source uintptr, yPlane, uPlane, vPlane []byte, yStride, uStride, vStride int, timestampUs int64) error {
+	if !libLoaded.Load() || shimVideoTrackSourcePushFrame == nil {
+		return ErrLibraryNotLoaded
+	}
+
+	params := shimVideoTrackSourcePushFrameParams{
+		Source:      source,
+		YPlane:      ByteSlicePtr(yPlane),
+		UPlane:      ByteSlicePtr(uPlane),
+		VPlane:      ByteSlicePtr(vPlane),
+		YStride:     int32(yStride),
+		UStride:     int32(uStride),
+		VStride:     int32(vStride),
+		TimestampUs: timestampUs,
+	}
+	result := shimVideoTrackSourcePushFrame(uintptr(unsafe.Pointer(&params)))
+	runtime.KeepAlive(yPlane)
+	runtime.KeepAlive(uPlane)
+	runtime.KeepAlive(vPlane)
+	runtime.KeepAlive(&params)
+	return ShimError(result)
+}
+
+// VideoTrackSourceGetPoolStats returns how many pushed frames were copied
+// into a recycled buffer (hits) and how many needed a new one (misses).
+func VideoTrackSourceGetPoolStats(source uintptr) (hits, misses uint64, err error) {
+	if !libLoaded.Load() || shimVideoTrackSourceGetPoolStats == nil {
+		return 0, 0, ErrLibraryNotLoaded
+	}
+	params := shimVideoTrackSourceGetPoolStatsParams{
+		Source: source,
+	}
+	result := shimVideoTrackSourceGetPoolStats(uintptr(unsafe.Pointer(&params)))
+	runtime.KeepAlive(&params)
+	if err := ShimError(result); err != nil {
+		return 0, 0, err
+	}
+	return params.PoolHits, params.PoolMisses, nil
+}
+
+// PeerConnectionAddVideoTrackFromSource adds a video track using a source.
+func PeerConnectionAddVideoTrackFromSource(pc, source uintptr, trackID, streamID string) uintptr {
+	if !libLoaded.Load() || shimPeerConnectionAddVideoTrackFromSource == nil {
+		return 0
+	}
+
+	trackIDCStr := CString(trackID)
+	streamIDCStr := CString(streamID)
+	var errBuf ShimErrorBuffer
+	params := shimPeerConnectionAddVideoTrackFromSourceParams{
+		PC:       pc,
+		Source:   source,
+		TrackID:  ByteSlicePtr(trackIDCStr),
+		StreamID: ByteSlicePtr(streamIDCStr),
+		ErrorOut: errBuf.Ptr(),
+	}
+	result := shimPeerConnectionAddVideoTrackFromSource(uintptr(unsafe.Pointer(&params)))
+	runtime.KeepAlive(trackIDCStr)
+	runtime.KeepAlive(streamIDCStr)
+	runtime.KeepAlive(&params)
+	runtime.KeepAlive(&errBuf)
+	return result
+}
+
+// VideoTrackSourceDestroy destroys a video track source.
+func VideoTrackSourceDestroy(source uintptr) {
+	if !libLoaded.Load() || shimVideoTrackSourceDestroy == nil {
+		return
+	}
+	shimVideoTrackSourceDestroy(source)
+}
+
+// KeyFrameRequestCallback is called when an encoded video source must
+// produce a keyframe.
+type KeyFrameRequestCallback func()
+
+var (
+	keyFrameRequestCallbackMu  sync.RWMutex
+	keyFrameRequestCallbacks   = make(map[uintptr]KeyFrameRequestCallback)
+	keyFrameRequestCallbackPtr uintptr
+	keyFrameRequestInitialized bool
+)
+
+func initKeyFrameRequestCallback() {
+	callbackInitMu.Lock()
+	defer callbackInitMu.Unlock()
+	if keyFrameRequestInitialized {
+		return
+	}
+	keyFrameRequestCallbackPtr = purego.NewCallback(func(ctx uintptr) uintptr {
+		keyFrameRequestCallbackMu.RLock()
+		cb, ok := keyFrameRequestCallbacks[ctx]
+		keyFrameRequestCallbackMu.RUnlock()
+		if ok && cb != nil {
+			safeCallback(cb)
+		}
+		return 0
+	})
+	keyFrameRequestInitialized = true
+}
+
+// EncodedVideoSourceCreate creates a source of pre-encoded video frames.
+// Keyframe requests reach the producer at most once per
+// minKeyFrameIntervalMs; 0 means 500.
+func EncodedVideoSourceCreate(codec CodecType, width, height, minKeyFrameIntervalMs int) (uintptr, error) {
+	if !libLoaded.Load() || shimEncodedVideoSourceCreate == nil {
+		return 0, ErrLibraryNotLoaded
+	}
+
+	var errBuf ShimErrorBuffer
+	params := shimEncodedVideoSourceCreateParams{
+		Codec:                 int32(codec),
+		Width:                 int32(width),
+		Height:                int32(height),
+		MinKeyframeIntervalMs: int32(minKeyFrameIntervalMs),
+		ErrorOut:              errBuf.Ptr(),
+	}
+	source := shimEncodedVideoSourceCreate(uintptr(unsafe.Pointer(&params)))
+	runtime.KeepAlive(&params)
+	if source == 0 {
+		msg := errBuf.String()
+		if msg != "" {
+			return 0, &ShimErrorWithMessage{Code: ShimErrInitFailed, Message: msg}
+		}
+		return 0, ErrInitFailed
+	}
+	return source, nil
+}
+
+// EncodedVideoSourceSetOnKeyFrameRequest sets the keyframe request callback
+// of an encoded video source. A nil callback removes it.
+func EncodedVideoSourceSetOnKeyFrameRequest(source uintptr, cb KeyFrameRequestCallback) {
+	if !libLoaded.Load() || shimEncodedVideoSourceSetOnKeyFrameRequest == nil {
+		return
+	}
+
+	initKeyFrameRequestCallback()
+
+	var callback uintptr
+	keyFrameRequestCallbackMu.Lock()
+	if cb != nil {
+		keyFrameRequestCallbacks[source] = cb
+		callback = keyFrameRequestCallbackPtr
+	} else {
+		delete(keyFrameRequestCallbacks, source)
+	}
+	keyFrameRequestCallbackMu.Unlock()
+
+	params := shimEncodedVideoSourceSetOnKeyFrameRequestParams{
+		Source:   source,
+		Callback: callback,
+		Ctx:      source,
+	}
+	shimEncodedVideoSourceSetOnKeyFrameRequest(uintptr(unsafe.Pointer(&params)))
+	runtime.KeepAlive(&params)
+}
+
+// EncodedVideoSourcePushFrame pushes one encoded frame to the source. Width
+// and height of 0 keep the source's size; temporalID is -1 without temporal
+// layers; timestampUs of 0 stamps the frame with the current time.
+func EncodedVideoSourcePushFrame(source uintptr, data []byte, width, height int, keyframe bool, temporalID int, timestampUs int64) error {
+	if !libLoaded.Load() || shimEncodedVideoSourcePushFrame == nil {
+		return ErrLibraryNotLoaded
+	}
+
+	var isKeyframe int32
+	if keyframe {
+		isKeyframe = 1
+	}
+	var errBuf ShimErrorBuffer
+	params := shimEncodedVideoSourcePushFrameParams{
+		Source:      source,
+		Data:        ByteSlicePtr(data),
+		Size:        int32(len(data)),
+		Width:       int32(width),
+		Height:      int32(height),
+		IsKeyframe:  isKeyframe,
+		TemporalID:  int32(temporalID),
+		TimestampUs: timestampUs,
+		ErrorOut:    errBuf.Ptr(),
+	}
+	result := shimEncodedVideoSourcePushFrame(uintptr(unsafe.Pointer(&params)))
+	runtime.KeepAlive(data)
+	runtime.KeepAlive(&params)
+	return errBuf.ToError(result)
+}
+
+// PeerConnectionAddEncodedVideoTrack adds a video track fed by an encoded source.
+func PeerConnectionAddEncodedVideoTrack(pc, source uintptr, trackID, streamID string) (uintptr, error) {
+	if !libLoaded.Load() || shimPeerConnectionAddEncodedVideoTrack == nil {
+		return 0, ErrLibraryNotLoaded
+	}
+
+	trackIDCStr := CString(trackID)
+	streamIDCStr := CString(streamID)
+	var errBuf ShimErrorBuffer
+	params := shimPeerConnectionAddEncodedVideoTrackParams{
+		PC:       pc,
+		Source:   source,
+		TrackID:  ByteSlicePtr(trackIDCStr),
+		StreamID: ByteSlicePtr(streamIDCStr),
+		ErrorOut: errBuf.Ptr(),
+	}
+	sender := shimPeerConnectionAddEncodedVideoTrack(uintptr(unsafe.Pointer(&params)))
+	runtime.KeepAlive(trackIDCStr)
+	runtime.KeepAlive(streamIDCStr)
+	runtime.KeepAlive(&params)
+	if sender == 0 {
+		msg := errBuf.String()
+		if msg != "" {
+			return 0, &ShimErrorWithMessage{Code: ShimErrInitFailed, Message: msg}
+		}
+		return 0, ErrInitFailed
+	}
+	return sender, nil
+}
+
+// EncodedVideoSourceDestroy destroys an encoded video source and drops its
+// keyframe request callback.
+func EncodedVideoSourceDestroy(source uintptr) {
+	if !libLoaded.Load() || shimEncodedVideoSourceDestroy == nil {
+		return
+	}
+	shimEncodedVideoSourceDestroy(source)
+	keyFrameRequestCallbackMu.Lock()
+	delete(keyFrameRequestCallbacks, source)
+	keyFrameRequestCallbackMu.Unlock()
 }
 
-// VideoTrackSourceCreate creates a video track source for frame injection.
-func VideoTrackSourceCreate(pc uintptr, width, height int) uintptr {
-	if !libLoaded.Load() || shimVideoTrackSourceCreate == nil {
-		return 0
+// EncodedVideoSourceSetMaxTemporalLayer limits the temporal layers an
+// encoded source forwards (0-7, 7 forwards all). Raising the limit takes
+// effect at the next keyframe.
+func EncodedVideoSourceSetMaxTemporalLayer(source uintptr, layer int) error {
+	if !libLoaded.Load() || shimEncodedVideoSourceSetMaxTemporalLayer == nil {
+		return ErrLibraryNotLoaded
 	}
-	params := shimVideoTrackSourceCreateParams{
-		PC:     pc,
-		Width:  int32(width),
-		Height: int32(height),
+
+	params := shimEncodedVideoSourceSetMaxTemporalLayerParams{
+		Source:           source,
+		MaxTemporalLayer: int32(layer),
 	}
-	result := shimVideoTrackSourceCreate(uintptr(unsafe.Pointer(&params)))
+	result := shimEncodedVideoSourceSetMaxTemporalLayer(uintptr(unsafe.Pointer(&params)))
 	runtime.KeepAlive(&params)
-	return result
+	return ShimError(result)
 }
 
-// VideoTrackSourcePushFrame pushes an I420 frame to the video track source.
-func VideoTrackSourcePushFrame(source uintptr, yPlane, uPlane, vPlane []byte, yStride, uStride, vStride int, timestampUs int64) error {
-	if !libLoaded.Load() || shimVideoTrackSourcePushFrame == nil {
-		return ErrLibraryNotLoaded
+// SharedVideoEncoderCreate creates an encoder whose output can be sent on
+// any number of PeerConnections. temporalLayers of 0 means 1, and
+// minKeyFrameIntervalMs of 0 means 500.
+func SharedVideoEncoderCreate(codec CodecType, width, height, bitrateBps, framerate, temporalLayers, minKeyFrameIntervalMs int) (uintptr, error) {
+	if !libLoaded.Load() || shimSharedVideoEncoderCreate == nil {
+		return 0, ErrLibraryNotLoaded
+	}
+
+	var errBuf ShimErrorBuffer
+	params := shimSharedVideoEncoderCreateParams{
+		Codec:                 int32(codec),
+		Width:                 int32(width),
+		Height:                int32(height),
+		BitrateBps:            int32(bitrateBps),
+		Framerate:             int32(framerate),
+		TemporalLayers:        int32(temporalLayers),
+		MinKeyframeIntervalMs: int32(minKeyFrameIntervalMs),
+		ErrorOut:              errBuf.Ptr(),
+	}
+	encoder := shimSharedVideoEncoderCreate(uintptr(unsafe.Pointer(&params)))
+	runtime.KeepAlive(&params)
+	if encoder == 0 {
+		msg := errBuf.String()
+		if msg != "" {
+			return 0, &ShimErrorWithMessage{Code: ShimErrInitFailed, Message: msg}
+		}
+		return 0, ErrInitFailed
 	}
+	return encoder, nil
+}
 
-	// DEBUG: Log every 100th call
-	count := atomic.AddUint64(&videoTrackSourcePushCount, 1)
-	if count%100 == 0 {
-		println("DEBUG FFI: VideoTrackSourcePushFrame source=", source, "yLen=", len(yPlane), "ts=", timestampUs)
+// SharedVideoEncoderPushFrame encodes one I420 frame for all subscribers.
+func SharedVideoEncoderPushFrame(encoder uintptr, yPlane, uPlane, vPlane []byte, yStride, uStride, vStride int, timestampUs int64) error {
+	if !libLoaded.Load() || shimSharedVideoEncoderPushFrame == nil {
+		return ErrLibraryNotLoaded
 	}
 
-	params := shimVideoTrackSourcePushFrameParams{
-		Source:      source,
+	var errBuf ShimErrorBuffer
+	params := shimSharedVideoEncoderPushFrameParams{
+		Encoder:     encoder,
 		YPlane:      ByteSlicePtr(yPlane),
 		UPlane:      ByteSlicePtr(uPlane),
 		VPlane:      ByteSlicePtr(vPlane),
@@ -758,47 +1503,66 @@ func VideoTrackSourcePushFrame(source uintptr, yPlane, uPlane, vPlane []byte, yS
 		UStride:     int32(uStride),
 		VStride:     int32(vStride),
 		TimestampUs: timestampUs,
+		ErrorOut:    errBuf.Ptr(),
 	}
-	result := shimVideoTrackSourcePushFrame(uintptr(unsafe.Pointer(&params)))
+	result := shimSharedVideoEncoderPushFrame(uintptr(unsafe.Pointer(&params)))
 	runtime.KeepAlive(yPlane)
 	runtime.KeepAlive(uPlane)
 	runtime.KeepAlive(vPlane)
 	runtime.KeepAlive(&params)
-	return ShimError(result)
+	return errBuf.ToError(result)
 }
 
-var videoTrackSourcePushCount uint64
+// SharedVideoEncoderSetRates changes the target bitrate and framerate of a
+// shared encoder. The bitrate is capped at the one it was created with.
+func SharedVideoEncoderSetRates(encoder uintptr, bitrateBps, framerate int) error {
+	if !libLoaded.Load() || shimSharedVideoEncoderSetRates == nil {
+		return ErrLibraryNotLoaded
+	}
 
-// PeerConnectionAddVideoTrackFromSource adds a video track using a source.
-func PeerConnectionAddVideoTrackFromSource(pc, source uintptr, trackID, streamID string) uintptr {
-	if !libLoaded.Load() || shimPeerConnectionAddVideoTrackFromSource == nil {
-		return 0
+	params := shimSharedVideoEncoderSetRatesParams{
+		Encoder:    encoder,
+		BitrateBps: int32(bitrateBps),
+		Framerate:  int32(framerate),
+	}
+	result := shimSharedVideoEncoderSetRates(uintptr(unsafe.Pointer(&params)))
+	runtime.KeepAlive(&params)
+	return ShimError(result)
+}
+
+// SharedVideoEncoderSubscribe creates an encoded video source fed by a shared
+// encoder. Add it with PeerConnectionAddEncodedVideoTrack and destroy it with
+// EncodedVideoSourceDestroy.
+func SharedVideoEncoderSubscribe(encoder uintptr, maxTemporalLayer int) (uintptr, error) {
+	if !libLoaded.Load() || shimSharedVideoEncoderSubscribe == nil {
+		return 0, ErrLibraryNotLoaded
 	}
 
-	trackIDCStr := CString(trackID)
-	streamIDCStr := CString(streamID)
 	var errBuf ShimErrorBuffer
-	params := shimPeerConnectionAddVideoTrackFromSourceParams{
-		PC:       pc,
-		Source:   source,
-		TrackID:  ByteSlicePtr(trackIDCStr),
-		StreamID: ByteSlicePtr(streamIDCStr),
-		ErrorOut: errBuf.Ptr(),
+	params := shimSharedVideoEncoderSubscribeParams{
+		Encoder:          encoder,
+		MaxTemporalLayer: int32(maxTemporalLayer),
+		ErrorOut:         errBuf.Ptr(),
 	}
-	result := shimPeerConnectionAddVideoTrackFromSource(uintptr(unsafe.Pointer(&params)))
-	runtime.KeepAlive(trackIDCStr)
-	runtime.KeepAlive(streamIDCStr)
+	source := shimSharedVideoEncoderSubscribe(uintptr(unsafe.Pointer(&params)))
 	runtime.KeepAlive(&params)
-	runtime.KeepAlive(&errBuf)
-	return result
+	if source == 0 {
+		msg := errBuf.String()
+		if msg != "" {
+			return 0, &ShimErrorWithMessage{Code: ShimErrInitFailed, Message: msg}
+		}
+		return 0, ErrInitFailed
+	}
+	return source, nil
 }
 
-// VideoTrackSourceDestroy destroys a video track source.
-func VideoTrackSourceDestroy(source uintptr) {
-	if !libLoaded.Load() || shimVideoTrackSourceDestroy == nil {
+// SharedVideoEncoderDestroy releases a shared encoder. Its subscribers stay
+// valid but receive no more frames.
+func SharedVideoEncoderDestroy(encoder uintptr) {
+	if !libLoaded.Load() || shimSharedVideoEncoderDestroy == nil {
 		return
 	}
-	shimVideoTrackSourceDestroy(source)
+	shimSharedVideoEncoderDestroy(encoder)
 }
 
 // AudioTrackSourceCreate creates an audio track source for frame injection.
@@ -912,6 +1676,134 @@ func TrackRemoveAudioSink(track uintptr) {
 	shimTrackRemoveAudioSink(track)
 }
 
+// TrackSetVideoMailbox replaces the video sink of a remote track with a
+// mailbox keeping up to slots decoded frames for TrackPullVideoFrame.
+func TrackSetVideoMailbox(track uintptr, slots int) error {
+	if !libLoaded.Load() || shimTrackSetVideoMailbox == nil {
+		return ErrLibraryNotLoaded
+	}
+	params := shimTrackSetVideoMailboxParams{
+		Track: track,
+		Slots: int32(slots),
+	}
+	result := shimTrackSetVideoMailbox(uintptr(unsafe.Pointer(&params)))
+	runtime.KeepAlive(&params)
+	return ShimError(result)
+}
+
+// MailboxVideoFrame is an I420 frame pulled from a video mailbox. Its planes
+// point into C memory until Release.
+type MailboxVideoFrame struct {
+	handle      uintptr
+	Width       int
+	Height      int
+	planes      [3]uintptr
+	Strides     [3]int
+	TimestampUs int64
+}
+
+// PlaneSize returns the byte length of plane i (0 = Y, 1 = U, 2 = V).
+func (f *MailboxVideoFrame) PlaneSize(i int) int {
+	rows := f.Height
+	if i > 0 {
+		rows = (f.Height + 1) / 2
+	}
+	return f.Strides[i] * rows
+}
+
+// CopyPlane copies plane i into dst, which must hold PlaneSize(i) bytes.
+//
+//go:nocheckptr
+func (f *MailboxVideoFrame) CopyPlane(i int, dst []byte) {
+	if f.planes[i] == 0 {
+		return
+	}
+	copy(dst, unsafe.Slice((*byte)(unsafe.Pointer(f.planes[i])), f.PlaneSize(i)))
+}
+
+// Plane returns plane i without copying. The slice aliases C memory and is
+// only valid until Release.
+//
+//go:nocheckptr
+func (f *MailboxVideoFrame) Plane(i int) []byte {
+	if f.planes[i] == 0 {
+		return nil
+	}
+	return unsafe.Slice((*byte)(unsafe.Pointer(f.planes[i])), f.PlaneSize(i))
+}
+
+// Release returns the frame to the shim.
+func (f *MailboxVideoFrame) Release() {
+	if f.handle == 0 || !libLoaded.Load() || shimVideoFrameRelease == nil {
+		return
+	}
+	shimVideoFrameRelease(f.handle)
+	f.handle = 0
+}
+
+// TrackPullVideoFrame pulls the oldest frame from the video mailbox of a
+// track. It returns nil when the mailbox is empty, along with the number of
+// frames dropped since the mailbox was set.
+func TrackPullVideoFrame(track uintptr) (*MailboxVideoFrame, uint64, error) {
+	if !libLoaded.Load() || shimTrackPullVideoFrame == nil {
+		return nil, 0, ErrLibraryNotLoaded
+	}
+	params := shimTrackPullVideoFrameParams{
+		Track: track,
+	}
+	result := shimTrackPullVideoFrame(uintptr(unsafe.Pointer(&params)))
+	runtime.KeepAlive(&params)
+	if err := ShimError(result); err != nil {
+		return nil, 0, err
+	}
+	if params.Frame == 0 {
+		return nil, params.FramesDropped, nil
+	}
+	return &MailboxVideoFrame{
+		handle:      params.Frame,
+		Width:       int(params.Width),
+		Height:      int(params.Height),
+		planes:      [3]uintptr{params.YPlane, params.UPlane, params.VPlane},
+		Strides:     [3]int{int(params.YStride), int(params.UStride), int(params.VStride)},
+		TimestampUs: params.TimestampUs,
+	}, params.FramesDropped, nil
+}
+
+// TrackSetVideoSinkWants limits the resolution and frame rate delivered by
+// the video sink of a track. Zero means no limit.
+func TrackSetVideoSinkWants(track uintptr, maxPixelCount, targetPixelCount, maxFramerate int) error {
+	if !libLoaded.Load() || shimTrackSetVideoSinkWants == nil {
+		return ErrLibraryNotLoaded
+	}
+	params := shimTrackSetVideoSinkWantsParams{
+		Track:            track,
+		MaxPixelCount:    int32(maxPixelCount),
+		TargetPixelCount: int32(targetPixelCount),
+		MaxFramerate:     int32(maxFramerate),
+	}
+	result := shimTrackSetVideoSinkWants(uintptr(unsafe.Pointer(&params)))
+	runtime.KeepAlive(&params)
+	return ShimError(result)
+}
+
+// TrackSetAudioSinkFormat batches the audio delivered by the audio sink of a
+// track into batchMs chunks converted to sampleRate and channels. Zero keeps
+// 10ms chunks and the source format.
+func TrackSetAudioSinkFormat(track uintptr, batchMs, sampleRate, channels int) error {
+	if !libLoaded.Load() || shimTrackSetAudioSinkFormat == nil {
+		return ErrLibraryNotLoaded
+	}
+	params := shimTrackSetAudioSinkFormatParams{
+		Track:      track,
+		BatchMs:    int32(batchMs),
+		SampleRate: int32(sampleRate),
+		Channels:   int32(channels),
+	}
+	result := shimTrackSetAudioSinkFormat(uintptr(unsafe.Pointer(&params)))
+	runtime.KeepAlive(&params)
+	return ShimError(result)
+}
+
 // TrackKind returns the track kind ("video" or "audio").
 func TrackKind(track uintptr) string {
 	if !libLoaded.Load() || shimTrackKind == nil {
@@ -1053,6 +1945,53 @@ type RTCStats struct {
 	JitterBufferEmittedCount   int64   // Number of samples/frames emitted from buffer
 }
 
+// Stream stats directions.
+const (
+	StreamOutbound = 0
+	StreamInbound  = 1
+)
+
+// StatsFlagDelta fills the interval fields of StreamStats.
+const StatsFlagDelta = 1
+
+// StreamStats matches ShimStreamStats in shim.h.
+type StreamStats struct {
+	SSRC                     uint32
+	Direction                int32
+	Kind                     int32
+	QualityLimitationReason  int32
+	Mid                      [64]byte
+	RID                      [64]byte
+	TimestampUs              int64
+	Bytes                    int64
+	Packets                  int64
+	PacketsLost              int64
+	RetransmittedBytes       int64
+	JitterBufferEmittedCount int64
+	QPSum                    int64
+	JitterMs                 float64
+	RoundTripTimeMs          float64
+	FractionLost             float64
+	TargetBitrateBps         float64
+	FramesPerSecond          float64
+	JitterBufferDelayMs      float64
+	AudioLevel               float64
+	Frames                   int32
+	KeyFrames                int32
+	FramesDropped            int32
+	FrameWidth               int32
+	FrameHeight              int32
+	NACKCount                int32
+	PLICount                 int32
+	FIRCount                 int32
+
+	// Delta mode
+	IntervalUs       int64
+	BitrateBps       float64
+	PacketRate       float64
+	IntervalLossRate float64
+}
+
 // Quality limitation reason constants
 const (
 	QualityLimitationNone      = 0
@@ -1095,13 +2034,15 @@ func ReadBandwidthEstimateFromC(ptr uintptr) *BandwidthEstimate {
 	return &estimate
 }
 
-// RTPSenderGetStats gets statistics for a sender.
-func RTPSenderGetStats(sender uintptr) (*RTCStats, error) {
+// RTPSenderGetStats gets statistics for a sender of pc, using a selector
+// so only the sender's streams are collected.
+func RTPSenderGetStats(pc, sender uintptr) (*RTCStats, error) {
 	if !libLoaded.Load() || shimRTPSenderGetStats == nil {
 		return nil, ErrLibraryNotLoaded
 	}
 
 	params := shimRTPSenderGetStatsParams{
+		PC:     pc,
 		Sender: sender,
 	}
 	result := shimRTPSenderGetStats(uintptr(unsafe.Pointer(&params)))
@@ -1114,8 +2055,28 @@ func RTPSenderGetStats(sender uintptr) (*RTCStats, error) {
 	return &stats, nil
 }
 
-// RTCPFeedbackCallback is called when RTCP feedback is received.
-type RTCPFeedbackCallback func(feedbackType int, ssrc uint32)
+// RTCP feedback types (SHIM_RTCP_FEEDBACK_* in shim.h).
+const (
+	RTCPFeedbackPLI  = 0
+	RTCPFeedbackFIR  = 1
+	RTCPFeedbackNACK = 2
+	RTCPFeedbackREMB = 3
+	RTCPFeedbackTWCC = 4
+)
+
+// RTCPFeedback matches ShimRTCPFeedback in shim.h.
+type RTCPFeedback struct {
+	Type        int32
+	SSRC        uint32
+	Count       int32
+	Lost        int32
+	BitrateBps  int64
+	TimestampUs int64
+}
+
+// RTCPFeedbackCallback is called with each batch of RTCP feedback received.
+// The slice is only valid during the call.
+type RTCPFeedbackCallback func(records []RTCPFeedback)
 
 var (
 	rtcpFeedbackCallbackMu  sync.RWMutex
@@ -1124,6 +2085,28 @@ var (
 	rtcpCallbackInitialized bool
 )
 
+// ReadRTCPFeedbackFromC copies a batch of RTCPFeedback records from C memory.
+//
+//go:nocheckptr
+func ReadRTCPFeedbackFromC(ptr uintptr, count int) []RTCPFeedback {
+	if ptr == 0 || count <= 0 {
+		return nil
+	}
+	src := unsafe.Slice((*RTCPFeedback)(unsafe.Pointer(ptr)), count)
+	return append([]RTCPFeedback(nil), src...)
+}
+
+// RTCPFeedbackFromPayload decodes the payload of an EventRTCPFeedback event.
+// The payload need not be aligned, so the records are copied out bytewise.
+func RTCPFeedbackFromPayload(payload []byte) []RTCPFeedback {
+	size := int(unsafe.Sizeof(RTCPFeedback{}))
+	records := make([]RTCPFeedback, len(payload)/size)
+	if len(records) > 0 {
+		copy(unsafe.Slice((*byte)(unsafe.Pointer(unsafe.SliceData(records))), len(records)*size), payload)
+	}
+	return records
+}
+
 func initRTCPCallback() {
 	callbackInitMu.Lock()
 	defer callbackInitMu.Unlock()
@@ -1132,16 +2115,19 @@ func initRTCPCallback() {
 		return
 	}
 
-	// NOTE: C uses 'int' (32-bit) for feedbackType, so we must use int32 to match
-	rtcpFeedbackCallbackPtr = purego.NewCallback(func(ctx uintptr, feedbackType int32, ssrc uint32) uintptr {
+	// NOTE: C uses 'int' (32-bit) for count, so we must use int32 to match
+	rtcpFeedbackCallbackPtr = purego.NewCallback(func(ctx uintptr, recordsPtr uintptr, count int32) uintptr {
 		rtcpFeedbackCallbackMu.RLock()
 		cb, ok := rtcpFeedbackCallbacks[ctx]
 		rtcpFeedbackCallbackMu.RUnlock()
 
 		if ok && cb != nil {
-			safeCallback(func() {
-				cb(int(feedbackType), ssrc)
-			})
+			records := ReadRTCPFeedbackFromC(recordsPtr, int(count))
+			if len(records) > 0 {
+				safeCallback(func() {
+					cb(records)
+				})
+			}
 		}
 		return 0
 	})
@@ -1149,31 +2135,72 @@ func initRTCPCallback() {
 	rtcpCallbackInitialized = true
 }
 
-// RTPSenderSetOnRTCPFeedback sets the RTCP feedback callback.
-func RTPSenderSetOnRTCPFeedback(sender uintptr, cb RTCPFeedbackCallback) {
+// RTPSenderSetOnRTCPFeedback sets the RTCP feedback callback of a sender of
+// pc. Keyframe requests are reported as they arrive and NACKs every
+// intervalMs (0 for the default, 1000). A nil callback stops reporting.
+func RTPSenderSetOnRTCPFeedback(pc, sender uintptr, intervalMs int, cb RTCPFeedbackCallback) {
 	if !libLoaded.Load() || shimRTPSenderSetOnRTCPFeedback == nil {
 		return
 	}
 
 	initRTCPCallback()
 
+	var callback uintptr
 	rtcpFeedbackCallbackMu.Lock()
-	rtcpFeedbackCallbacks[sender] = cb
+	if cb != nil {
+		rtcpFeedbackCallbacks[sender] = cb
+		callback = rtcpFeedbackCallbackPtr
+	} else {
+		delete(rtcpFeedbackCallbacks, sender)
+	}
 	rtcpFeedbackCallbackMu.Unlock()
 
 	params := shimRTPSenderSetOnRTCPFeedbackParams{
-		Sender:   sender,
-		Callback: rtcpFeedbackCallbackPtr,
-		Ctx:      sender,
+		PC:         pc,
+		Sender:     sender,
+		Callback:   callback,
+		Ctx:        sender,
+		IntervalMs: int32(intervalMs),
 	}
 	shimRTPSenderSetOnRTCPFeedback(uintptr(unsafe.Pointer(&params)))
 	runtime.KeepAlive(&params)
 }
 
-// UnregisterRTCPFeedbackCallback removes the RTCP feedback callback for a sender.
-func UnregisterRTCPFeedbackCallback(sender uintptr) {
+// PeerConnectionSetOnTransportFeedback sets the callback for the REMB and
+// TWCC feedback of pc, batched every intervalMs (0 for the default, 100). A
+// nil callback stops reporting.
+func PeerConnectionSetOnTransportFeedback(pc uintptr, intervalMs int, cb RTCPFeedbackCallback) {
+	if !libLoaded.Load() || shimPeerConnectionSetOnTransportFeedback == nil {
+		return
+	}
+
+	initRTCPCallback()
+
+	var callback uintptr
+	rtcpFeedbackCallbackMu.Lock()
+	if cb != nil {
+		rtcpFeedbackCallbacks[pc] = cb
+		callback = rtcpFeedbackCallbackPtr
+	} else {
+		delete(rtcpFeedbackCallbacks, pc)
+	}
+	rtcpFeedbackCallbackMu.Unlock()
+
+	params := shimPeerConnectionSetOnTransportFeedbackParams{
+		PC:         pc,
+		Callback:   callback,
+		Ctx:        pc,
+		IntervalMs: int32(intervalMs),
+	}
+	shimPeerConnectionSetOnTransportFeedback(uintptr(unsafe.Pointer(&params)))
+	runtime.KeepAlive(&params)
+}
+
+// UnregisterRTCPFeedbackCallback removes the RTCP feedback callback for a
+// sender, or the transport feedback callback for a PeerConnection.
+func UnregisterRTCPFeedbackCallback(handle uintptr) {
 	rtcpFeedbackCallbackMu.Lock()
-	delete(rtcpFeedbackCallbacks, sender)
+	delete(rtcpFeedbackCallbacks, handle)
 	rtcpFeedbackCallbackMu.Unlock()
 }
 
@@ -1248,13 +2275,24 @@ func RTPReceiverGetTrack(receiver uintptr) uintptr {
 	return shimRTPReceiverGetTrack(receiver)
 }
 
-// RTPReceiverGetStats gets statistics for a receiver.
-func RTPReceiverGetStats(receiver uintptr) (*RTCStats, error) {
+// RTPReceiverRequestKeyFrame asks the remote sender of a video receiver for
+// a keyframe by sending a PLI.
+func RTPReceiverRequestKeyFrame(receiver uintptr) error {
+	if !libLoaded.Load() || shimRTPReceiverRequestKeyFrame == nil {
+		return ErrLibraryNotLoaded
+	}
+	return ShimError(shimRTPReceiverRequestKeyFrame(receiver))
+}
+
+// RTPReceiverGetStats gets statistics for a receiver of pc, using a selector
+// so only the receiver's streams are collected.
+func RTPReceiverGetStats(pc, receiver uintptr) (*RTCStats, error) {
 	if !libLoaded.Load() || shimRTPReceiverGetStats == nil {
 		return nil, ErrLibraryNotLoaded
 	}
 
 	params := shimRTPReceiverGetStatsParams{
+		PC:       pc,
 		Receiver: receiver,
 	}
 	result := shimRTPReceiverGetStats(uintptr(unsafe.Pointer(&params)))
@@ -1554,6 +2592,36 @@ func PeerConnectionGetStats(pc uintptr) (*RTCStats, error) {
 	return &stats, nil
 }
 
+// PeerConnectionGetStreamStats writes per-stream statistics into streams.
+// A non-zero sender or receiver restricts collection to its streams. It
+// returns the number of entries written and the number of streams in the
+// report, which exceeds the count when streams is too short.
+func PeerConnectionGetStreamStats(pc, sender, receiver uintptr, flags int32, streams []StreamStats) (count, total int, err error) {
+	if !libLoaded.Load() || shimPeerConnectionGetStreamStats == nil {
+		return 0, 0, ErrLibraryNotLoaded
+	}
+
+	var errBuf ShimErrorBuffer
+	params := shimPeerConnectionGetStreamStatsParams{
+		PC:         pc,
+		Sender:     sender,
+		Receiver:   receiver,
+		Flags:      flags,
+		MaxStreams: int32(len(streams)),
+		ErrorOut:   errBuf.Ptr(),
+	}
+	if len(streams) > 0 {
+		params.Streams = uintptr(unsafe.Pointer(&streams[0]))
+	}
+	result := shimPeerConnectionGetStreamStats(uintptr(unsafe.Pointer(&params)))
+	runtime.KeepAlive(streams)
+	runtime.KeepAlive(&params)
+	if err := errBuf.ToError(result); err != nil {
+		return 0, 0, err
+	}
+	return int(params.OutCount), int(params.OutTotal), nil
+}
+
 // ============================================================================
 // Connection State Change Callback
 // ============================================================================
@@ -2448,6 +3516,121 @@ func RTPReceiverSetJitterBufferMinDelay(receiver uintptr, minDelayMs int) error
 	return ShimError(result)
 }
 
+// MaxFrameDependencies is the number of dependencies reported per encoded
+// frame (SHIM_MAX_FRAME_DEPENDENCIES in shim.h).
+const MaxFrameDependencies = 8
+
+// EncodedFrameInfo matches ShimEncodedVideoFrameInfo in shim.h.
+type EncodedFrameInfo struct {
+	Codec           int32
+	SSRC            uint32
+	RTPTimestamp    uint32
+	PayloadType     int32
+	IsKeyframe      int32
+	Width           int32
+	Height          int32
+	SpatialIndex    int32
+	TemporalIndex   int32
+	NumDependencies int32
+	FrameID         int64
+	Dependencies    [MaxFrameDependencies]int64
+	ReceiveTimeUs   int64
+}
+
+// EncodedFrameCallback is called with each encoded frame of a remote video
+// stream. data is only valid during the call.
+type EncodedFrameCallback func(info *EncodedFrameInfo, data []byte)
+
+var (
+	encodedFrameCallbackMu  sync.RWMutex
+	encodedFrameCallbacks   = make(map[uintptr]EncodedFrameCallback)
+	encodedFrameCallbackPtr uintptr
+	encodedFrameInitialized bool
+)
+
+// readEncodedFrameInfo copies a ShimEncodedVideoFrameInfo from C memory.
+//
+//go:nocheckptr
+func readEncodedFrameInfo(ptr uintptr) EncodedFrameInfo {
+	return *(*EncodedFrameInfo)(unsafe.Pointer(ptr))
+}
+
+// EncodedFrameFromPayload decodes the payload of an EventEncodedVideoFrame
+// event. The payload need not be aligned, so the info is copied out
+// bytewise; data aliases payload.
+func EncodedFrameFromPayload(payload []byte) (info EncodedFrameInfo, data []byte, ok bool) {
+	size := int(unsafe.Sizeof(info))
+	if len(payload) < size {
+		return info, nil, false
+	}
+	copy(unsafe.Slice((*byte)(unsafe.Pointer(&info)), size), payload)
+	return info, payload[size:], true
+}
+
+func initEncodedFrameCallback() {
+	callbackInitMu.Lock()
+	defer callbackInitMu.Unlock()
+
+	if encodedFrameInitialized {
+		return
+	}
+
+	// NOTE: C uses 'int' (32-bit) for size, so we must use int32 to match
+	encodedFrameCallbackPtr = purego.NewCallback(func(ctx uintptr, infoPtr uintptr, dataPtr uintptr, size int32) uintptr {
+		encodedFrameCallbackMu.RLock()
+		cb, ok := encodedFrameCallbacks[ctx]
+		encodedFrameCallbackMu.RUnlock()
+
+		if ok && cb != nil && infoPtr != 0 {
+			info := readEncodedFrameInfo(infoPtr)
+			var data []byte
+			if dataPtr != 0 && size > 0 {
+				data = unsafe.Slice((*byte)(unsafe.Pointer(dataPtr)), int(size))
+			}
+			safeCallback(func() {
+				cb(&info, data)
+			})
+		}
+		return 0
+	})
+
+	encodedFrameInitialized = true
+}
+
+// RTPReceiverSetOnEncodedFrame sets the encoded frame callback of a video
+// receiver. A nil callback removes it.
+func RTPReceiverSetOnEncodedFrame(receiver uintptr, cb EncodedFrameCallback) error {
+	if !libLoaded.Load() || shimRTPReceiverSetOnEncodedFrame == nil {
+		return ErrLibraryNotLoaded
+	}
+
+	initEncodedFrameCallback()
+
+	var callback uintptr
+	encodedFrameCallbackMu.Lock()
+	if cb != nil {
+		encodedFrameCallbacks[receiver] = cb
+		callback = encodedFrameCallbackPtr
+	} else {
+		delete(encodedFrameCallbacks, receiver)
+	}
+	encodedFrameCallbackMu.Unlock()
+
+	params := shimRTPReceiverSetOnEncodedFrameParams{
+		Receiver: receiver,
+		Callback: callback,
+		Ctx:      receiver,
+	}
+	result := shimRTPReceiverSetOnEncodedFrame(uintptr(unsafe.Pointer(&params)))
+	runtime.KeepAlive(&params)
+	if result != 0 && cb != nil {
+		encodedFrameCallbackMu.Lock()
+		delete(encodedFrameCallbacks, receiver)
+		encodedFrameCallbackMu.Unlock()
+	}
+	return ShimError(result)
+}
+
 // ResetForTesting clears all callback registries.
 // This should only be used in tests to ensure test isolation.
 func ResetForTesting() {
@@ -2478,6 +3661,11 @@ func ResetForTesting() {
 	rtcpFeedbackCallbacks = make(map[uintptr]RTCPFeedbackCallback)
 	rtcpFeedbackCallbackMu.Unlock()
 
+	// Encoded frame callbacks
+	encodedFrameCallbackMu.Lock()
+	encodedFrameCallbacks = make(map[uintptr]EncodedFrameCallback)
+	encodedFrameCallbackMu.Unlock()
+
 	// PeerConnection state callbacks
 	connectionStateCallbackMu.Lock()
 	connectionStateCallbacks = make(map[uintptr]ConnectionStateCallback)
@@ -1,7 +1,9 @@
 package ffi
 
 import (
+	"strings"
 	"testing"
+	"time"
 	"unsafe"
 )
 
@@ -22,6 +24,81 @@ func TestCreatePeerConnection(t *testing.T) {
 	t.Logf("Created PeerConnection: handle=%d", handle)
 }
 
+func TestCreatePeerConnectionWithSharedFactory(t *testing.T) {
+	factory, err := CreatePeerConnectionFactory(&PeerConnectionFactoryConfig{
+		DisableAudioDevice: 1,
+	})
+	if err != nil {
+		t.Fatalf("CreatePeerConnectionFactory failed: %v", err)
+	}
+
+	handles := make([]uintptr, 4)
+	for i := range handles {
+		handles[i], err = CreatePeerConnectionWithFactory(factory, &PeerConnectionConfig{})
+		if err != nil {
+			t.Fatalf("CreatePeerConnectionWithFactory(%d) failed: %v", i, err)
+		}
+		defer PeerConnectionDestroy(handles[i])
+	}
+
+	// PeerConnections hold their own factory reference.
+	PeerConnectionFactoryDestroy(factory)
+
+	sdpBuf := make([]byte, 64*1024)
+	if _, err := PeerConnectionCreateOffer(handles[0], nil, sdpBuf); err != nil {
+		t.Fatalf("CreateOffer after factory destroy failed: %v", err)
+	}
+}
+
+func TestCreatePeerConnectionFactoryInvalidConfig(t *testing.T) {
+	_, err := CreatePeerConnectionFactory(&PeerConnectionFactoryConfig{VideoCodecFactory: 99})
+	if err == nil {
+		t.Fatal("expected error for unknown video codec factory")
+	}
+}
+
+func TestThreadGroupFactories(t *testing.T) {
+	group, err := CreateThreadGroup(&ThreadGroupConfig{
+		ShardCount:    3,
+		FactoryConfig: &PeerConnectionFactoryConfig{DisableAudioDevice: 1},
+	})
+	if err != nil {
+		t.Fatalf("CreateThreadGroup failed: %v", err)
+	}
+
+	if n := ThreadGroupShardCount(group); n != 3 {
+		t.Fatalf("ThreadGroupShardCount = %d, want 3", n)
+	}
+	if ThreadGroupFactory(group, 3) != 0 {
+		t.Error("ThreadGroupFactory out of range should return 0")
+	}
+
+	// Round-robin cycles through every shard.
+	seen := make(map[uintptr]bool)
+	for i := 0; i < 3; i++ {
+		seen[ThreadGroupNextFactory(group)] = true
+	}
+	for i := 0; i < 3; i++ {
+		if !seen[ThreadGroupFactory(group, i)] {
+			t.Errorf("shard %d not visited by round-robin", i)
+		}
+	}
+
+	handle, err := CreatePeerConnectionWithFactory(ThreadGroupFactory(group, 1), &PeerConnectionConfig{})
+	if err != nil {
+		t.Fatalf("CreatePeerConnectionWithFactory failed: %v", err)
+	}
+	defer PeerConnectionDestroy(handle)
+
+	// The PeerConnection keeps its shard's threads alive.
+	ThreadGroupDestroy(group)
+
+	sdpBuf := make([]byte, 64*1024)
+	if _, err := PeerConnectionCreateOffer(handle, nil, sdpBuf); err != nil {
+		t.Fatalf("CreateOffer after group destroy failed: %v", err)
+	}
+}
+
 func TestPeerConnectionCreateOffer(t *testing.T) {
 	cfg := &PeerConnectionConfig{}
 	handle, err := CreatePeerConnection(cfg)
@@ -32,7 +109,7 @@ func TestPeerConnectionCreateOffer(t *testing.T) {
 
 	// Create offer
 	sdpBuf := make([]byte, 64*1024)
-	sdpLen, err := PeerConnectionCreateOffer(handle, sdpBuf)
+	sdpLen, err := PeerConnectionCreateOffer(handle, nil, sdpBuf)
 	if err != nil {
 		t.Fatalf("CreateOffer failed: %v", err)
 	}
@@ -56,7 +133,7 @@ func TestPeerConnectionSetLocalDescription(t *testing.T) {
 
 	// Create offer
 	sdpBuf := make([]byte, 64*1024)
-	sdpLen, err := PeerConnectionCreateOffer(handle, sdpBuf)
+	sdpLen, err := PeerConnectionCreateOffer(handle, nil, sdpBuf)
 	if err != nil {
 		t.Fatalf("CreateOffer failed: %v", err)
 	}
@@ -214,7 +291,7 @@ func TestOfferAnswerExchange(t *testing.T) {
 
 	// PC1 creates offer
 	offerBuf := make([]byte, 64*1024)
-	offerLen, err := PeerConnectionCreateOffer(pc1, offerBuf)
+	offerLen, err := PeerConnectionCreateOffer(pc1, nil, offerBuf)
 	if err != nil {
 		t.Fatalf("CreateOffer failed: %v", err)
 	}
@@ -234,7 +311,7 @@ func TestOfferAnswerExchange(t *testing.T) {
 
 	// PC2 creates answer
 	answerBuf := make([]byte, 64*1024)
-	answerLen, err := PeerConnectionCreateAnswer(pc2, answerBuf)
+	answerLen, err := PeerConnectionCreateAnswer(pc2, nil, answerBuf)
 	if err != nil {
 		t.Fatalf("CreateAnswer failed: %v", err)
 	}
@@ -255,6 +332,183 @@ func TestOfferAnswerExchange(t *testing.T) {
 	t.Log("Offer/Answer exchange completed successfully")
 }
 
+func TestOfferAnswerExchangeAsync(t *testing.T) {
+	cfg := &PeerConnectionConfig{}
+
+	pc1, err := CreatePeerConnection(cfg)
+	if err != nil {
+		t.Fatalf("CreatePeerConnection (offerer) failed: %v", err)
+	}
+	defer PeerConnectionDestroy(pc1)
+
+	pc2, err := CreatePeerConnection(cfg)
+	if err != nil {
+		t.Fatalf("CreatePeerConnection (answerer) failed: %v", err)
+	}
+	defer PeerConnectionDestroy(pc2)
+
+	type result struct {
+		sdp string
+		err error
+	}
+	wait := func(name string, start func(SessionDescriptionCallback) error) string {
+		t.Helper()
+		done := make(chan result, 1)
+		if err := start(func(sdp string, err error) {
+			done <- result{sdp, err}
+		}); err != nil {
+			t.Fatalf("%s failed to start: %v", name, err)
+		}
+		select {
+		case r := <-done:
+			if r.err != nil {
+				t.Fatalf("%s failed: %v", name, r.err)
+			}
+			return r.sdp
+		case <-time.After(5 * time.Second):
+			t.Fatalf("%s timed out", name)
+			return ""
+		}
+	}
+
+	offer := wait("CreateOfferAsync", func(cb SessionDescriptionCallback) error {
+		return PeerConnectionCreateOfferAsync(pc1, nil, cb)
+	})
+	if !strings.HasPrefix(offer, "v=0") {
+		t.Fatalf("offer does not look like SDP: %.40q", offer)
+	}
+	wait("PC1 SetLocalDescriptionAsync", func(cb SessionDescriptionCallback) error {
+		return PeerConnectionSetLocalDescriptionAsync(pc1, 0, offer, cb)
+	})
+	wait("PC2 SetRemoteDescriptionAsync", func(cb SessionDescriptionCallback) error {
+		return PeerConnectionSetRemoteDescriptionAsync(pc2, 0, offer, cb)
+	})
+	answer := wait("CreateAnswerAsync", func(cb SessionDescriptionCallback) error {
+		return PeerConnectionCreateAnswerAsync(pc2, nil, cb)
+	})
+	wait("PC2 SetLocalDescriptionAsync", func(cb SessionDescriptionCallback) error {
+		return PeerConnectionSetLocalDescriptionAsync(pc2, 2, answer, cb)
+	})
+	wait("PC1 SetRemoteDescriptionAsync", func(cb SessionDescriptionCallback) error {
+		return PeerConnectionSetRemoteDescriptionAsync(pc1, 2, answer, cb)
+	})
+
+	// Malformed SDP is rejected synchronously and never calls back.
+	called := make(chan struct{}, 1)
+	err = PeerConnectionSetRemoteDescriptionAsync(pc1, 2, "not sdp", func(string, error) {
+		called <- struct{}{}
+	})
+	if err == nil {
+		t.Error("SetRemoteDescriptionAsync with invalid SDP should fail")
+	}
+	select {
+	case <-called:
+		t.Error("callback should not run when the call is rejected")
+	case <-time.After(100 * time.Millisecond):
+	}
+}
+
+func TestAsyncDescriptionDoesNotWaitForSignalingThread(t *testing.T) {
+	pc, err := CreatePeerConnection(&PeerConnectionConfig{})
+	if err != nil {
+		t.Fatalf("CreatePeerConnection failed: %v", err)
+	}
+	defer PeerConnectionDestroy(pc)
+
+	// Completion callbacks run on the signaling thread: hold it busy in one.
+	const busy = 500 * time.Millisecond
+	offers := make(chan string, 1)
+	err = PeerConnectionCreateOfferAsync(pc, nil, func(sdp string, err error) {
+		if err != nil {
+			t.Errorf("CreateOfferAsync failed: %v", err)
+		}
+		offers <- sdp
+		time.Sleep(busy)
+	})
+	if err != nil {
+		t.Fatalf("CreateOfferAsync failed to start: %v", err)
+	}
+	var offer string
+	select {
+	case offer = <-offers:
+	case <-time.After(5 * time.Second):
+		t.Fatal("CreateOfferAsync timed out")
+	}
+
+	done := make(chan error, 2)
+	start := time.Now()
+	if err := PeerConnectionSetLocalDescriptionAsync(pc, 0, offer, func(_ string, err error) {
+		done <- err
+	}); err != nil {
+		t.Fatalf("SetLocalDescriptionAsync failed to start: %v", err)
+	}
+	if err := PeerConnectionCreateOfferAsync(pc, nil, func(_ string, err error) {
+		done <- err
+	}); err != nil {
+		t.Fatalf("CreateOfferAsync failed to start: %v", err)
+	}
+	if elapsed := time.Since(start); elapsed > busy/5 {
+		t.Errorf("async calls took %v on a busy signaling thread, want them to return at once", elapsed)
+	}
+
+	for i := 0; i < 2; i++ {
+		select {
+		case err := <-done:
+			if err != nil {
+				t.Errorf("queued operation failed: %v", err)
+			}
+		case <-time.After(5 * time.Second):
+			t.Fatal("queued operation timed out")
+		}
+	}
+}
+
+func TestCreateOfferICERestart(t *testing.T) {
+	pc, err := CreatePeerConnection(&PeerConnectionConfig{})
+	if err != nil {
+		t.Fatalf("CreatePeerConnection failed: %v", err)
+	}
+	defer PeerConnectionDestroy(pc)
+	// Something to negotiate, so the offer has a transport.
+	if dc := PeerConnectionCreateDataChannel(pc, "data", true, -1, ""); dc == 0 {
+		t.Fatal("CreateDataChannel failed")
+	}
+
+	ufrag := func(sdp string) string {
+		for _, line := range strings.Split(sdp, "\r\n") {
+			if v, ok := strings.CutPrefix(line, "a=ice-ufrag:"); ok {
+				return v
+			}
+		}
+		t.Fatal("no ice-ufrag in SDP")
+		return ""
+	}
+	buf := make([]byte, 65536)
+	n, err := PeerConnectionCreateOffer(pc, nil, buf)
+	if err != nil {
+		t.Fatalf("CreateOffer failed: %v", err)
+	}
+	offer := string(buf[:n])
+	if err := PeerConnectionSetLocalDescription(pc, 0, offer); err != nil {
+		t.Fatalf("SetLocalDescription failed: %v", err)
+	}
+
+	n, err = PeerConnectionCreateOffer(pc, nil, buf)
+	if err != nil {
+		t.Fatalf("CreateOffer failed: %v", err)
+	}
+	if got := ufrag(string(buf[:n])); got != ufrag(offer) {
+		t.Errorf("offer without ICE restart changed ufrag %q to %q", ufrag(offer), got)
+	}
+	n, err = PeerConnectionCreateOffer(pc, &OfferAnswerOptions{ICERestart: true, VoiceActivityDetection: true}, buf)
+	if err != nil {
+		t.Fatalf("CreateOffer with ICE restart failed: %v", err)
+	}
+	if got := ufrag(string(buf[:n])); got == ufrag(offer) {
+		t.Errorf("offer with ICE restart kept ufrag %q", got)
+	}
+}
+
 func TestDataChannelSend(t *testing.T) {
 	cfg := &PeerConnectionConfig{}
 	handle, err := CreatePeerConnection(cfg)
@@ -327,7 +581,7 @@ func BenchmarkFFICreateOffer(b *testing.B) {
 
 	b.ResetTimer()
 	for i := 0; i < b.N; i++ {
-		_, _ = PeerConnectionCreateOffer(handle, sdpBuf)
+		_, _ = PeerConnectionCreateOffer(handle, nil, sdpBuf)
 	}
 }
 
@@ -371,3 +625,73 @@ func TestGetSupportedAudioCodecsFFI(t *testing.T) {
 		t.Error("Expected at least one audio codec")
 	}
 }
+
+func TestEventQueuePeerConnectionEvents(t *testing.T) {
+	queue, err := CreateEventQueue(64)
+	if err != nil {
+		t.Fatalf("CreateEventQueue failed: %v", err)
+	}
+	defer EventQueueDestroy(queue)
+
+	if fd := EventQueueFD(queue); fd < 0 {
+		t.Fatalf("EventQueueFD = %d, want a valid fd", fd)
+	}
+
+	events := make([]Event, 16)
+	payload := make([]byte, 64*1024)
+	count, _, _, err := EventQueueDrain(queue, events, payload)
+	if err != nil || count != 0 {
+		t.Fatalf("drain of empty queue = (%d, %v), want (0, nil)", count, err)
+	}
+
+	pc, err := CreatePeerConnection(&PeerConnectionConfig{})
+	if err != nil {
+		t.Fatalf("CreatePeerConnection failed: %v", err)
+	}
+	defer PeerConnectionDestroy(pc)
+
+	const tag = 42
+	PeerConnectionSetEventQueue(pc, queue, tag)
+
+	if dc := PeerConnectionCreateDataChannel(pc, "events", true, -1, ""); dc == 0 {
+		t.Fatal("CreateDataChannel failed")
+	}
+	sdpBuf := make([]byte, 64*1024)
+	sdpLen, err := PeerConnectionCreateOffer(pc, nil, sdpBuf)
+	if err != nil {
+		t.Fatalf("CreateOffer failed: %v", err)
+	}
+	if err := PeerConnectionSetLocalDescription(pc, 0, string(sdpBuf[:sdpLen])); err != nil {
+		t.Fatalf("SetLocalDescription failed: %v", err)
+	}
+
+	// Setting the offer moves signaling to have-local-offer and starts ICE
+	// gathering.
+	seen := make(map[int32]bool)
+	deadline := time.Now().Add(5 * time.Second)
+	for time.Now().Before(deadline) && !(seen[EventSignalingState] && seen[EventICEGatheringState]) {
+		count, used, _, err := EventQueueDrain(queue, events, payload)
+		if err != nil {
+			t.Fatalf("EventQueueDrain failed: %v", err)
+		}
+		if used > len(payload) {
+			t.Fatalf("payload used %d > buffer %d", used, len(payload))
+		}
+		for _, ev := range events[:count] {
+			if ev.Tag != tag {
+				t.Errorf("event tag = %d, want %d", ev.Tag, tag)
+			}
+			if ev.Type == EventICECandidate && !strings.HasPrefix(string(ev.Payload(payload)), "candidate:") {
+				t.Errorf("candidate payload = %.40q", ev.Payload(payload))
+			}
+			seen[ev.Type] = true
+		}
+		time.Sleep(10 * time.Millisecond)
+	}
+	if !seen[EventSignalingState] {
+		t.Error("no signaling state event was queued")
+	}
+	if !seen[EventICEGatheringState] {
+		t.Error("no ICE gathering state event was queued")
+	}
+}
@@ -0,0 +1,51 @@
+package ffi
+
+import (
+	"runtime"
+	"unsafe"
+)
+
+// Socket servers for network threads (ShimSocketServerType in shim.h).
+const (
+	SocketServerDefault  = 0
+	SocketServerPhysical = 1
+	SocketServerBatched  = 2
+)
+
+// SocketServerStats matches ShimSocketServerStats in shim.h.
+type SocketServerStats struct {
+	RecvCalls   uint64
+	RecvPackets uint64
+	SendCalls   uint64
+	SendPackets uint64
+	GSOSends    uint64
+	SendDrops   uint64
+}
+
+// SetSocketServer selects the process-wide socket server. It fails once the
+// global network thread exists.
+func SetSocketServer(serverType int32) error {
+	if !libLoaded.Load() || shimSetSocketServer == nil {
+		return ErrLibraryNotLoaded
+	}
+
+	var errBuf ShimErrorBuffer
+	params := shimSetSocketServerParams{
+		Type:     serverType,
+		ErrorOut: errBuf.Ptr(),
+	}
+	result := shimSetSocketServer(uintptr(unsafe.Pointer(&params)))
+	runtime.KeepAlive(&params)
+	return errBuf.ToError(result)
+}
+
+// GetSocketServerStats returns cumulative counters for all batched socket
+// servers in the process.
+func GetSocketServerStats() SocketServerStats {
+	var stats SocketServerStats
+	if !libLoaded.Load() || shimSocketServerGetStats == nil {
+		return stats
+	}
+	shimSocketServerGetStats(uintptr(unsafe.Pointer(&stats)))
+	return stats
+}
@@ -0,0 +1,114 @@
+package ffi
+
+import (
+	"runtime"
+	"unsafe"
+)
+
+// SRTPProfile identifies an SRTP protection profile.
+// Values match ShimSRTPProfile in shim.h (IANA DTLS-SRTP registry).
+type SRTPProfile int32
+
+const (
+	SRTPProfileAES128CMHMACSHA1_80 SRTPProfile = 1
+	SRTPProfileAES128CMHMACSHA1_32 SRTPProfile = 2
+	SRTPProfileAEADAES128GCM       SRTPProfile = 7
+	SRTPProfileAEADAES256GCM       SRTPProfile = 8
+)
+
+// SRTPMaxTrailerLen matches SHIM_SRTP_MAX_TRAILER_LEN in shim.h: the most
+// bytes protection can append to a packet.
+const SRTPMaxTrailerLen = 20
+
+// CreateSRTPContext creates an SRTP context. sendKey and recvKey are the
+// concatenated master key and salt; either may be nil for one-way use.
+func CreateSRTPContext(profile SRTPProfile, sendKey, recvKey []byte) (uintptr, error) {
+	if !libLoaded.Load() || shimSRTPContextCreate == nil {
+		return 0, ErrLibraryNotLoaded
+	}
+
+	var errBuf ShimErrorBuffer
+	params := shimSRTPContextCreateParams{
+		Profile:    int32(profile),
+		SendKey:    ByteSlicePtr(sendKey),
+		SendKeyLen: int32(len(sendKey)),
+		RecvKey:    ByteSlicePtr(recvKey),
+		RecvKeyLen: int32(len(recvKey)),
+		ErrorOut:   errBuf.Ptr(),
+	}
+	ctx := shimSRTPContextCreate(uintptr(unsafe.Pointer(&params)))
+	runtime.KeepAlive(sendKey)
+	runtime.KeepAlive(recvKey)
+	runtime.KeepAlive(&params)
+	runtime.KeepAlive(&errBuf)
+	if ctx == 0 {
+		msg := errBuf.String()
+		if msg != "" {
+			return 0, &ShimErrorWithMessage{Code: ShimErrInitFailed, Message: msg}
+		}
+		return 0, ErrInitFailed
+	}
+	return ctx, nil
+}
+
+// SRTPContextDestroy destroys an SRTP context.
+func SRTPContextDestroy(ctx uintptr) {
+	if !libLoaded.Load() || shimSRTPContextDestroy == nil || ctx == 0 {
+		return
+	}
+	shimSRTPContextDestroy(ctx)
+}
+
+// SRTPProtectRTP encrypts RTP packets in place.
+// packets holds the address of each buffer, sizes the packet lengths and
+// capacities the usable length of each buffer. On return sizes holds the
+// protected lengths, or -1 for packets that failed.
+// Returns the number of failed packets.
+func SRTPProtectRTP(ctx uintptr, packets []uintptr, sizes, capacities []int32) (int, error) {
+	return srtpBatch(shimSRTPProtectRTP, ctx, packets, sizes, capacities)
+}
+
+// SRTPProtectRTCP encrypts RTCP packets in place. See SRTPProtectRTP.
+func SRTPProtectRTCP(ctx uintptr, packets []uintptr, sizes, capacities []int32) (int, error) {
+	return srtpBatch(shimSRTPProtectRTCP, ctx, packets, sizes, capacities)
+}
+
+// SRTPUnprotectRTP decrypts and authenticates SRTP packets in place.
+// On return sizes holds the plaintext lengths, or -1 for packets that failed.
+// Returns the number of failed packets.
+func SRTPUnprotectRTP(ctx uintptr, packets []uintptr, sizes []int32) (int, error) {
+	return srtpBatch(shimSRTPUnprotectRTP, ctx, packets, sizes, nil)
+}
+
+// SRTPUnprotectRTCP decrypts and authenticates SRTCP packets in place.
+// See SRTPUnprotectRTP.
+func SRTPUnprotectRTCP(ctx uintptr, packets []uintptr, sizes []int32) (int, error) {
+	return srtpBatch(shimSRTPUnprotectRTCP, ctx, packets, sizes, nil)
+}
+
+func srtpBatch(fn func(uintptr) int32, ctx uintptr, packets []uintptr, sizes, capacities []int32) (int, error) {
+	if !libLoaded.Load() || fn == nil {
+		return 0, ErrLibraryNotLoaded
+	}
+	if ctx == 0 || len(sizes) < len(packets) || (capacities != nil && len(capacities) < len(packets)) {
+		return 0, ErrInvalidParam
+	}
+
+	var errBuf ShimErrorBuffer
+	params := shimSRTPBatchParams{
+		Context:    ctx,
+		Packets:    UintptrSlicePtr(packets),
+		Sizes:      Int32SlicePtr(sizes),
+		Capacities: Int32SlicePtr(capacities),
+		Count:      int32(len(packets)),
+		ErrorOut:   errBuf.Ptr(),
+	}
+	result := fn(uintptr(unsafe.Pointer(&params)))
+	runtime.KeepAlive(packets)
+	runtime.KeepAlive(sizes)
+	runtime.KeepAlive(capacities)
+	runtime.KeepAlive(&params)
+	runtime.KeepAlive(&errBuf)
+
+	return int(params.OutFailed), errBuf.ToError(result)
+}
@@ -0,0 +1,150 @@
+package ffi
+
+import (
+	"fmt"
+	"runtime"
+	"sync/atomic"
+	"unsafe"
+)
+
+// StatsRingHeader matches ShimStatsRingHeader in shim.h.
+type StatsRingHeader struct {
+	Capacity      uint32
+	RecordSize    uint32
+	RecordsOffset uint32
+	Reserved      uint32
+	WriteSeq      uint64
+	ReadSeq       uint64
+	Dropped       uint64
+}
+
+// StatsRecord matches ShimStatsRecord in shim.h.
+type StatsRecord struct {
+	Tag                      uint64
+	RoundUs                  int64
+	StreamIndex              int32
+	StreamCount              int32
+	CurrentRTTMs             float64
+	AvailableOutgoingBitrate float64
+	AvailableIncomingBitrate float64
+	Stream                   StreamStats
+}
+
+// CreateStatsRing creates a stats ring holding up to capacity records
+// (rounded up to a power of two; 0 for the default).
+func CreateStatsRing(capacity int) (uintptr, error) {
+	if !libLoaded.Load() || shimStatsRingCreate == nil {
+		return 0, ErrLibraryNotLoaded
+	}
+
+	var errBuf ShimErrorBuffer
+	params := shimStatsRingCreateParams{
+		Capacity: int32(capacity),
+		ErrorOut: errBuf.Ptr(),
+	}
+	ring := shimStatsRingCreate(uintptr(unsafe.Pointer(&params)))
+	runtime.KeepAlive(&params)
+	if ring == 0 {
+		msg := errBuf.String()
+		if msg != "" {
+			return 0, &ShimErrorWithMessage{Code: ShimErrInitFailed, Message: msg}
+		}
+		return 0, ErrInitFailed
+	}
+	return ring, nil
+}
+
+// StatsRingHeaderPtr returns the address of the ring's shared header.
+func StatsRingHeaderPtr(ring uintptr) uintptr {
+	if !libLoaded.Load() || shimStatsRingHeader == nil || ring == 0 {
+		return 0
+	}
+	return shimStatsRingHeader(ring)
+}
+
+// StatsRingDestroy stops collection and frees the ring. Readers must be
+// done with the ring memory.
+func StatsRingDestroy(ring uintptr) {
+	if !libLoaded.Load() || shimStatsRingDestroy == nil || ring == 0 {
+		return
+	}
+	shimStatsRingDestroy(ring)
+}
+
+// StatsRingSubscribe collects pc's stats into ring every intervalMs,
+// tagging its records with tag.
+func StatsRingSubscribe(ring, pc uintptr, intervalMs int, tag uint64) error {
+	if !libLoaded.Load() || shimStatsRingSubscribe == nil {
+		return ErrLibraryNotLoaded
+	}
+
+	var errBuf ShimErrorBuffer
+	params := shimStatsRingSubscribeParams{
+		Ring:       ring,
+		PC:         pc,
+		IntervalMs: int32(intervalMs),
+		Tag:        tag,
+		ErrorOut:   errBuf.Ptr(),
+	}
+	result := shimStatsRingSubscribe(uintptr(unsafe.Pointer(&params)))
+	runtime.KeepAlive(&params)
+	return errBuf.ToError(result)
+}
+
+// StatsRingUnsubscribe stops collecting pc's stats into ring.
+func StatsRingUnsubscribe(ring, pc uintptr) {
+	if !libLoaded.Load() || shimStatsRingUnsubscribe == nil || ring == 0 {
+		return
+	}
+	params := shimStatsRingUnsubscribeParams{
+		Ring: ring,
+		PC:   pc,
+	}
+	shimStatsRingUnsubscribe(uintptr(unsafe.Pointer(&params)))
+	runtime.KeepAlive(&params)
+}
+
+// StatsRingReader reads a stats ring's shared memory directly, without
+// calling into the shim. A ring has a single reader; Read must not be
+// called concurrently.
+type StatsRingReader struct {
+	header  *StatsRingHeader
+	records []StatsRecord
+	mask    uint64
+}
+
+// NewStatsRingReader maps the ring whose header is at headerPtr.
+//
+//go:nocheckptr
+func NewStatsRingReader(headerPtr uintptr) (*StatsRingReader, error) {
+	if headerPtr == 0 {
+		return nil, ErrInitFailed
+	}
+	header := (*StatsRingHeader)(unsafe.Pointer(headerPtr))
+	if uintptr(header.RecordSize) != unsafe.Sizeof(StatsRecord{}) {
+		return nil, fmt.Errorf("stats record size mismatch: shim %d, Go %d", header.RecordSize, unsafe.Sizeof(StatsRecord{}))
+	}
+	first := (*StatsRecord)(unsafe.Pointer(headerPtr + uintptr(header.RecordsOffset)))
+	return &StatsRingReader{
+		header:  header,
+		records: unsafe.Slice(first, header.Capacity),
+		mask:    uint64(header.Capacity) - 1,
+	}, nil
+}
+
+// Read appends the records published since the previous Read to dst and
+// hands their slots back to the writer.
+func (r *StatsRingReader) Read(dst []StatsRecord) []StatsRecord {
+	write := atomic.LoadUint64(&r.header.WriteSeq)
+	read := atomic.LoadUint64(&r.header.ReadSeq)
+	for ; read < write; read++ {
+		dst = append(dst, r.records[read&r.mask])
+	}
+	atomic.StoreUint64(&r.header.ReadSeq, read)
+	return dst
+}
+
+// Dropped returns the number of records dropped because the ring was full.
+func (r *StatsRingReader) Dropped() uint64 {
+	return atomic.LoadUint64(&r.header.Dropped)
+}
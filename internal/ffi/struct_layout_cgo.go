@@ -186,6 +186,18 @@ func cShimDataChannelSendParamsLayout() cStructLayout {
 	}
 }
 
+func cShimDataChannelSetEventQueueParamsLayout() cStructLayout {
+	var cCfg C.ShimDataChannelSetEventQueueParams
+	return cStructLayout{
+		size: unsafe.Sizeof(cCfg),
+		offsets: map[string]uintptr{
+			"DC":    unsafe.Offsetof(cCfg.dc),
+			"Queue": unsafe.Offsetof(cCfg.queue),
+			"Tag":   unsafe.Offsetof(cCfg.tag),
+		},
+	}
+}
+
 func cShimDataChannelSetOnCloseParamsLayout() cStructLayout {
 	var cCfg C.ShimDataChannelSetOnCloseParams
 	return cStructLayout{
@@ -260,6 +272,83 @@ func cShimDeviceInfoLayout() cStructLayout {
 	}
 }
 
+func cShimEncodedVideoFrameInfoLayout() cStructLayout {
+	var cCfg C.ShimEncodedVideoFrameInfo
+	return cStructLayout{
+		size: unsafe.Sizeof(cCfg),
+		offsets: map[string]uintptr{
+			"Codec":           unsafe.Offsetof(cCfg.codec),
+			"SSRC":            unsafe.Offsetof(cCfg.ssrc),
+			"RTPTimestamp":    unsafe.Offsetof(cCfg.rtp_timestamp),
+			"PayloadType":     unsafe.Offsetof(cCfg.payload_type),
+			"IsKeyframe":      unsafe.Offsetof(cCfg.is_keyframe),
+			"Width":           unsafe.Offsetof(cCfg.width),
+			"Height":          unsafe.Offsetof(cCfg.height),
+			"SpatialIndex":    unsafe.Offsetof(cCfg.spatial_index),
+			"TemporalIndex":   unsafe.Offsetof(cCfg.temporal_index),
+			"NumDependencies": unsafe.Offsetof(cCfg.num_dependencies),
+			"FrameID":         unsafe.Offsetof(cCfg.frame_id),
+			"Dependencies":    unsafe.Offsetof(cCfg.dependencies),
+			"ReceiveTimeUs":   unsafe.Offsetof(cCfg.receive_time_us),
+		},
+	}
+}
+
+func cShimEncodedVideoSourceCreateParamsLayout() cStructLayout {
+	var cCfg C.ShimEncodedVideoSourceCreateParams
+	return cStructLayout{
+		size: unsafe.Sizeof(cCfg),
+		offsets: map[string]uintptr{
+			"Codec":                 unsafe.Offsetof(cCfg.codec),
+			"Width":                 unsafe.Offsetof(cCfg.width),
+			"Height":                unsafe.Offsetof(cCfg.height),
+			"MinKeyframeIntervalMs": unsafe.Offsetof(cCfg.min_keyframe_interval_ms),
+			"ErrorOut":              unsafe.Offsetof(cCfg.error_out),
+		},
+	}
+}
+
+func cShimEncodedVideoSourcePushFrameParamsLayout() cStructLayout {
+	var cCfg C.ShimEncodedVideoSourcePushFrameParams
+	return cStructLayout{
+		size: unsafe.Sizeof(cCfg),
+		offsets: map[string]uintptr{
+			"Source":      unsafe.Offsetof(cCfg.source),
+			"Data":        unsafe.Offsetof(cCfg.data),
+			"Size":        unsafe.Offsetof(cCfg.size),
+			"Width":       unsafe.Offsetof(cCfg.width),
+			"Height":      unsafe.Offsetof(cCfg.height),
+			"IsKeyframe":  unsafe.Offsetof(cCfg.is_keyframe),
+			"TemporalID":  unsafe.Offsetof(cCfg.temporal_id),
+			"TimestampUs": unsafe.Offsetof(cCfg.timestamp_us),
+			"ErrorOut":    unsafe.Offsetof(cCfg.error_out),
+		},
+	}
+}
+
+func cShimEncodedVideoSourceSetMaxTemporalLayerParamsLayout() cStructLayout {
+	var cCfg C.ShimEncodedVideoSourceSetMaxTemporalLayerParams
+	return cStructLayout{
+		size: unsafe.Sizeof(cCfg),
+		offsets: map[string]uintptr{
+			"Source":           unsafe.Offsetof(cCfg.source),
+			"MaxTemporalLayer": unsafe.Offsetof(cCfg.max_temporal_layer),
+		},
+	}
+}
+
+func cShimEncodedVideoSourceSetOnKeyFrameRequestParamsLayout() cStructLayout {
+	var cCfg C.ShimEncodedVideoSourceSetOnKeyFrameRequestParams
+	return cStructLayout{
+		size: unsafe.Sizeof(cCfg),
+		offsets: map[string]uintptr{
+			"Source":   unsafe.Offsetof(cCfg.source),
+			"Callback": unsafe.Offsetof(cCfg.callback),
+			"Ctx":      unsafe.Offsetof(cCfg.ctx),
+		},
+	}
+}
+
 func cShimEnumerateDevicesParamsLayout() cStructLayout {
 	var cCfg C.ShimEnumerateDevicesParams
 	return cStructLayout{
@@ -296,6 +385,56 @@ func cShimErrorBufferLayout() cStructLayout {
 	}
 }
 
+func cShimEventLayout() cStructLayout {
+	var cCfg C.ShimEvent
+	return cStructLayout{
+		size: unsafe.Sizeof(cCfg),
+		offsets: map[string]uintptr{
+			"Type":           unsafe.Offsetof(cCfg._type),
+			"Value":          unsafe.Offsetof(cCfg.value),
+			"Tag":            unsafe.Offsetof(cCfg.tag),
+			"Object":         unsafe.Offsetof(cCfg.object),
+			"Object2":        unsafe.Offsetof(cCfg.object2),
+			"Width":          unsafe.Offsetof(cCfg.width),
+			"Height":         unsafe.Offsetof(cCfg.height),
+			"TimestampUs":    unsafe.Offsetof(cCfg.timestamp_us),
+			"PayloadOffset":  unsafe.Offsetof(cCfg.payload_offset),
+			"PayloadLen":     unsafe.Offsetof(cCfg.payload_len),
+			"CaptureTimeUs":  unsafe.Offsetof(cCfg.capture_time_us),
+			"HasCaptureTime": unsafe.Offsetof(cCfg.has_capture_time),
+		},
+	}
+}
+
+func cShimEventQueueCreateParamsLayout() cStructLayout {
+	var cCfg C.ShimEventQueueCreateParams
+	return cStructLayout{
+		size: unsafe.Sizeof(cCfg),
+		offsets: map[string]uintptr{
+			"Capacity": unsafe.Offsetof(cCfg.capacity),
+			"ErrorOut": unsafe.Offsetof(cCfg.error_out),
+		},
+	}
+}
+
+func cShimEventQueueDrainParamsLayout() cStructLayout {
+	var cCfg C.ShimEventQueueDrainParams
+	return cStructLayout{
+		size: unsafe.Sizeof(cCfg),
+		offsets: map[string]uintptr{
+			"Queue":         unsafe.Offsetof(cCfg.queue),
+			"Events":        unsafe.Offsetof(cCfg.events),
+			"MaxEvents":     unsafe.Offsetof(cCfg.max_events),
+			"Payload":       unsafe.Offsetof(cCfg.payload),
+			"PayloadSize":   unsafe.Offsetof(cCfg.payload_size),
+			"OutCount":      unsafe.Offsetof(cCfg.out_count),
+			"OutPayloadLen": unsafe.Offsetof(cCfg.out_payload_len),
+			"OutDropped":    unsafe.Offsetof(cCfg.out_dropped),
+			"ErrorOut":      unsafe.Offsetof(cCfg.error_out),
+		},
+	}
+}
+
 func cShimGetSupportedAudioCodecsParamsLayout() cStructLayout {
 	var cCfg C.ShimGetSupportedAudioCodecsParams
 	return cStructLayout{
@@ -345,6 +484,35 @@ func cShimICEServerLayout() cStructLayout {
 	}
 }
 
+func cShimLoopbackNetworkCreateParamsLayout() cStructLayout {
+	var cCfg C.ShimLoopbackNetworkCreateParams
+	return cStructLayout{
+		size: unsafe.Sizeof(cCfg),
+		offsets: map[string]uintptr{
+			"DelayMs":       unsafe.Offsetof(cCfg.delay_ms),
+			"LossRate":      unsafe.Offsetof(cCfg.loss_rate),
+			"BandwidthKbps": unsafe.Offsetof(cCfg.bandwidth_kbps),
+			"QueueMs":       unsafe.Offsetof(cCfg.queue_ms),
+			"Seed":          unsafe.Offsetof(cCfg.seed),
+			"ErrorOut":      unsafe.Offsetof(cCfg.error_out),
+		},
+	}
+}
+
+func cShimLoopbackNetworkStatsLayout() cStructLayout {
+	var cCfg C.ShimLoopbackNetworkStats
+	return cStructLayout{
+		size: unsafe.Sizeof(cCfg),
+		offsets: map[string]uintptr{
+			"PacketsSent":      unsafe.Offsetof(cCfg.packets_sent),
+			"PacketsDelivered": unsafe.Offsetof(cCfg.packets_delivered),
+			"BytesDelivered":   unsafe.Offsetof(cCfg.bytes_delivered),
+			"PacketsLost":      unsafe.Offsetof(cCfg.packets_lost),
+			"PacketsDropped":   unsafe.Offsetof(cCfg.packets_dropped),
+		},
+	}
+}
+
 func cShimPacketizerConfigLayout() cStructLayout {
 	var cCfg C.ShimPacketizerConfig
 	return cStructLayout{
@@ -378,6 +546,18 @@ func cShimPacketizerPacketizeParamsLayout() cStructLayout {
 	}
 }
 
+func cShimPeerConnectionAcquireParamsLayout() cStructLayout {
+	var cCfg C.ShimPeerConnectionAcquireParams
+	return cStructLayout{
+		size: unsafe.Sizeof(cCfg),
+		offsets: map[string]uintptr{
+			"Pool":      unsafe.Offsetof(cCfg.pool),
+			"OutPooled": unsafe.Offsetof(cCfg.out_pooled),
+			"ErrorOut":  unsafe.Offsetof(cCfg.error_out),
+		},
+	}
+}
+
 func cShimPeerConnectionAddAudioTrackFromSourceParamsLayout() cStructLayout {
 	var cCfg C.ShimPeerConnectionAddAudioTrackFromSourceParams
 	return cStructLayout{
@@ -392,6 +572,20 @@ func cShimPeerConnectionAddAudioTrackFromSourceParamsLayout() cStructLayout {
 	}
 }
 
+func cShimPeerConnectionAddEncodedVideoTrackParamsLayout() cStructLayout {
+	var cCfg C.ShimPeerConnectionAddEncodedVideoTrackParams
+	return cStructLayout{
+		size: unsafe.Sizeof(cCfg),
+		offsets: map[string]uintptr{
+			"PC":       unsafe.Offsetof(cCfg.pc),
+			"Source":   unsafe.Offsetof(cCfg.source),
+			"TrackID":  unsafe.Offsetof(cCfg.track_id),
+			"StreamID": unsafe.Offsetof(cCfg.stream_id),
+			"ErrorOut": unsafe.Offsetof(cCfg.error_out),
+		},
+	}
+}
+
 func cShimPeerConnectionAddICECandidateParamsLayout() cStructLayout {
 	var cCfg C.ShimPeerConnectionAddICECandidateParams
 	return cStructLayout{
@@ -452,12 +646,39 @@ func cShimPeerConnectionConfigLayout() cStructLayout {
 	return cStructLayout{
 		size: unsafe.Sizeof(cCfg),
 		offsets: map[string]uintptr{
-			"ICEServers":           unsafe.Offsetof(cCfg.ice_servers),
-			"ICEServerCount":       unsafe.Offsetof(cCfg.ice_server_count),
-			"ICECandidatePoolSize": unsafe.Offsetof(cCfg.ice_candidate_pool_size),
-			"BundlePolicy":         unsafe.Offsetof(cCfg.bundle_policy),
-			"RTCPMuxPolicy":        unsafe.Offsetof(cCfg.rtcp_mux_policy),
-			"SDPSemantics":         unsafe.Offsetof(cCfg.sdp_semantics),
+			"ICEServers":             unsafe.Offsetof(cCfg.ice_servers),
+			"ICEServerCount":         unsafe.Offsetof(cCfg.ice_server_count),
+			"ICECandidatePoolSize":   unsafe.Offsetof(cCfg.ice_candidate_pool_size),
+			"BundlePolicy":           unsafe.Offsetof(cCfg.bundle_policy),
+			"RTCPMuxPolicy":          unsafe.Offsetof(cCfg.rtcp_mux_policy),
+			"SDPSemantics":           unsafe.Offsetof(cCfg.sdp_semantics),
+			"ICETransportPolicy":     unsafe.Offsetof(cCfg.ice_transport_policy),
+			"CandidateNetworkPolicy": unsafe.Offsetof(cCfg.candidate_network_policy),
+			"TCPCandidatePolicy":     unsafe.Offsetof(cCfg.tcp_candidate_policy),
+			"PortRangeMin":           unsafe.Offsetof(cCfg.port_range_min),
+			"PortRangeMax":           unsafe.Offsetof(cCfg.port_range_max),
+			"ContinualGathering":     unsafe.Offsetof(cCfg.continual_gathering),
+			"ICECheckIntervalMs":     unsafe.Offsetof(cCfg.ice_check_interval_ms),
+			"ICECheckMinIntervalMs":  unsafe.Offsetof(cCfg.ice_check_min_interval_ms),
+			"NetworkController":      unsafe.Offsetof(cCfg.network_controller),
+			"StartBitrateBps":        unsafe.Offsetof(cCfg.start_bitrate_bps),
+			"MinBitrateBps":          unsafe.Offsetof(cCfg.min_bitrate_bps),
+			"MaxBitrateBps":          unsafe.Offsetof(cCfg.max_bitrate_bps),
+			"DisableProbing":         unsafe.Offsetof(cCfg.disable_probing),
+		},
+	}
+}
+
+func cShimPeerConnectionCreateAnswerAsyncParamsLayout() cStructLayout {
+	var cCfg C.ShimPeerConnectionCreateAnswerAsyncParams
+	return cStructLayout{
+		size: unsafe.Sizeof(cCfg),
+		offsets: map[string]uintptr{
+			"PC":                     unsafe.Offsetof(cCfg.pc),
+			"VoiceActivityDetection": unsafe.Offsetof(cCfg.voice_activity_detection),
+			"Callback":               unsafe.Offsetof(cCfg.callback),
+			"Ctx":                    unsafe.Offsetof(cCfg.ctx),
+			"ErrorOut":               unsafe.Offsetof(cCfg.error_out),
 		},
 	}
 }
@@ -467,11 +688,12 @@ func cShimPeerConnectionCreateAnswerParamsLayout() cStructLayout {
 	return cStructLayout{
 		size: unsafe.Sizeof(cCfg),
 		offsets: map[string]uintptr{
-			"PC":         unsafe.Offsetof(cCfg.pc),
-			"SDPOut":     unsafe.Offsetof(cCfg.sdp_out),
-			"SDPOutSize": unsafe.Offsetof(cCfg.sdp_out_size),
-			"OutSDPLen":  unsafe.Offsetof(cCfg.out_sdp_len),
-			"ErrorOut":   unsafe.Offsetof(cCfg.error_out),
+			"PC":                     unsafe.Offsetof(cCfg.pc),
+			"VoiceActivityDetection": unsafe.Offsetof(cCfg.voice_activity_detection),
+			"SDPOut":                 unsafe.Offsetof(cCfg.sdp_out),
+			"SDPOutSize":             unsafe.Offsetof(cCfg.sdp_out_size),
+			"OutSDPLen":              unsafe.Offsetof(cCfg.out_sdp_len),
+			"ErrorOut":               unsafe.Offsetof(cCfg.error_out),
 		},
 	}
 }
@@ -491,22 +713,67 @@ func cShimPeerConnectionCreateDataChannelParamsLayout() cStructLayout {
 	}
 }
 
+func cShimPeerConnectionCreateOfferAsyncParamsLayout() cStructLayout {
+	var cCfg C.ShimPeerConnectionCreateOfferAsyncParams
+	return cStructLayout{
+		size: unsafe.Sizeof(cCfg),
+		offsets: map[string]uintptr{
+			"PC":                     unsafe.Offsetof(cCfg.pc),
+			"ICERestart":             unsafe.Offsetof(cCfg.ice_restart),
+			"VoiceActivityDetection": unsafe.Offsetof(cCfg.voice_activity_detection),
+			"Callback":               unsafe.Offsetof(cCfg.callback),
+			"Ctx":                    unsafe.Offsetof(cCfg.ctx),
+			"ErrorOut":               unsafe.Offsetof(cCfg.error_out),
+		},
+	}
+}
+
 func cShimPeerConnectionCreateOfferParamsLayout() cStructLayout {
 	var cCfg C.ShimPeerConnectionCreateOfferParams
 	return cStructLayout{
 		size: unsafe.Sizeof(cCfg),
 		offsets: map[string]uintptr{
-			"PC":         unsafe.Offsetof(cCfg.pc),
-			"SDPOut":     unsafe.Offsetof(cCfg.sdp_out),
-			"SDPOutSize": unsafe.Offsetof(cCfg.sdp_out_size),
-			"OutSDPLen":  unsafe.Offsetof(cCfg.out_sdp_len),
-			"ErrorOut":   unsafe.Offsetof(cCfg.error_out),
+			"PC":                     unsafe.Offsetof(cCfg.pc),
+			"ICERestart":             unsafe.Offsetof(cCfg.ice_restart),
+			"VoiceActivityDetection": unsafe.Offsetof(cCfg.voice_activity_detection),
+			"SDPOut":                 unsafe.Offsetof(cCfg.sdp_out),
+			"SDPOutSize":             unsafe.Offsetof(cCfg.sdp_out_size),
+			"OutSDPLen":              unsafe.Offsetof(cCfg.out_sdp_len),
+			"ErrorOut":               unsafe.Offsetof(cCfg.error_out),
 		},
 	}
 }
 
 func cShimPeerConnectionCreateParamsLayout() cStructLayout {
 	var cCfg C.ShimPeerConnectionCreateParams
+	return cStructLayout{
+		size: unsafe.Sizeof(cCfg),
+		offsets: map[string]uintptr{
+			"Config":   unsafe.Offsetof(cCfg.config),
+			"Factory":  unsafe.Offsetof(cCfg.factory),
+			"ErrorOut": unsafe.Offsetof(cCfg.error_out),
+		},
+	}
+}
+
+func cShimPeerConnectionFactoryConfigLayout() cStructLayout {
+	var cCfg C.ShimPeerConnectionFactoryConfig
+	return cStructLayout{
+		size: unsafe.Sizeof(cCfg),
+		offsets: map[string]uintptr{
+			"VideoCodecFactory":      unsafe.Offsetof(cCfg.video_codec_factory),
+			"DisableAudioDevice":     unsafe.Offsetof(cCfg.disable_audio_device),
+			"DisableAudioProcessing": unsafe.Offsetof(cCfg.disable_audio_processing),
+			"UDPMuxPort":             unsafe.Offsetof(cCfg.udp_mux_port),
+			"UDPMuxAddress":          unsafe.Offsetof(cCfg.udp_mux_address),
+			"LoopbackNetwork":        unsafe.Offsetof(cCfg.loopback_network),
+			"DisableVideoDecoding":   unsafe.Offsetof(cCfg.disable_video_decoding),
+		},
+	}
+}
+
+func cShimPeerConnectionFactoryCreateParamsLayout() cStructLayout {
+	var cCfg C.ShimPeerConnectionFactoryCreateParams
 	return cStructLayout{
 		size: unsafe.Sizeof(cCfg),
 		offsets: map[string]uintptr{
@@ -564,6 +831,24 @@ func cShimPeerConnectionGetStatsParamsLayout() cStructLayout {
 	}
 }
 
+func cShimPeerConnectionGetStreamStatsParamsLayout() cStructLayout {
+	var cCfg C.ShimPeerConnectionGetStreamStatsParams
+	return cStructLayout{
+		size: unsafe.Sizeof(cCfg),
+		offsets: map[string]uintptr{
+			"PC":         unsafe.Offsetof(cCfg.pc),
+			"Sender":     unsafe.Offsetof(cCfg.sender),
+			"Receiver":   unsafe.Offsetof(cCfg.receiver),
+			"Flags":      unsafe.Offsetof(cCfg.flags),
+			"Streams":    unsafe.Offsetof(cCfg.streams),
+			"MaxStreams": unsafe.Offsetof(cCfg.max_streams),
+			"OutCount":   unsafe.Offsetof(cCfg.out_count),
+			"OutTotal":   unsafe.Offsetof(cCfg.out_total),
+			"ErrorOut":   unsafe.Offsetof(cCfg.error_out),
+		},
+	}
+}
+
 func cShimPeerConnectionGetTransceiversParamsLayout() cStructLayout {
 	var cCfg C.ShimPeerConnectionGetTransceiversParams
 	return cStructLayout{
@@ -577,6 +862,22 @@ func cShimPeerConnectionGetTransceiversParamsLayout() cStructLayout {
 	}
 }
 
+func cShimPeerConnectionPoolCreateParamsLayout() cStructLayout {
+	var cCfg C.ShimPeerConnectionPoolCreateParams
+	return cStructLayout{
+		size: unsafe.Sizeof(cCfg),
+		offsets: map[string]uintptr{
+			"Config":               unsafe.Offsetof(cCfg.config),
+			"Factory":              unsafe.Offsetof(cCfg.factory),
+			"TargetSize":           unsafe.Offsetof(cCfg.target_size),
+			"AudioTransceivers":    unsafe.Offsetof(cCfg.audio_transceivers),
+			"VideoTransceivers":    unsafe.Offsetof(cCfg.video_transceivers),
+			"TransceiverDirection": unsafe.Offsetof(cCfg.transceiver_direction),
+			"ErrorOut":             unsafe.Offsetof(cCfg.error_out),
+		},
+	}
+}
+
 func cShimPeerConnectionRemoveTrackParamsLayout() cStructLayout {
 	var cCfg C.ShimPeerConnectionRemoveTrackParams
 	return cStructLayout{
@@ -589,6 +890,33 @@ func cShimPeerConnectionRemoveTrackParamsLayout() cStructLayout {
 	}
 }
 
+func cShimPeerConnectionSetEventQueueParamsLayout() cStructLayout {
+	var cCfg C.ShimPeerConnectionSetEventQueueParams
+	return cStructLayout{
+		size: unsafe.Sizeof(cCfg),
+		offsets: map[string]uintptr{
+			"PC":    unsafe.Offsetof(cCfg.pc),
+			"Queue": unsafe.Offsetof(cCfg.queue),
+			"Tag":   unsafe.Offsetof(cCfg.tag),
+		},
+	}
+}
+
+func cShimPeerConnectionSetLocalDescriptionAsyncParamsLayout() cStructLayout {
+	var cCfg C.ShimPeerConnectionSetLocalDescriptionAsyncParams
+	return cStructLayout{
+		size: unsafe.Sizeof(cCfg),
+		offsets: map[string]uintptr{
+			"PC":       unsafe.Offsetof(cCfg.pc),
+			"Type":     unsafe.Offsetof(cCfg._type),
+			"SDP":      unsafe.Offsetof(cCfg.sdp),
+			"Callback": unsafe.Offsetof(cCfg.callback),
+			"Ctx":      unsafe.Offsetof(cCfg.ctx),
+			"ErrorOut": unsafe.Offsetof(cCfg.error_out),
+		},
+	}
+}
+
 func cShimPeerConnectionSetLocalDescriptionParamsLayout() cStructLayout {
 	var cCfg C.ShimPeerConnectionSetLocalDescriptionParams
 	return cStructLayout{
@@ -710,6 +1038,34 @@ func cShimPeerConnectionSetOnTrackParamsLayout() cStructLayout {
 	}
 }
 
+func cShimPeerConnectionSetOnTransportFeedbackParamsLayout() cStructLayout {
+	var cCfg C.ShimPeerConnectionSetOnTransportFeedbackParams
+	return cStructLayout{
+		size: unsafe.Sizeof(cCfg),
+		offsets: map[string]uintptr{
+			"PC":         unsafe.Offsetof(cCfg.pc),
+			"Callback":   unsafe.Offsetof(cCfg.callback),
+			"Ctx":        unsafe.Offsetof(cCfg.ctx),
+			"IntervalMs": unsafe.Offsetof(cCfg.interval_ms),
+		},
+	}
+}
+
+func cShimPeerConnectionSetRemoteDescriptionAsyncParamsLayout() cStructLayout {
+	var cCfg C.ShimPeerConnectionSetRemoteDescriptionAsyncParams
+	return cStructLayout{
+		size: unsafe.Sizeof(cCfg),
+		offsets: map[string]uintptr{
+			"PC":       unsafe.Offsetof(cCfg.pc),
+			"Type":     unsafe.Offsetof(cCfg._type),
+			"SDP":      unsafe.Offsetof(cCfg.sdp),
+			"Callback": unsafe.Offsetof(cCfg.callback),
+			"Ctx":      unsafe.Offsetof(cCfg.ctx),
+			"ErrorOut": unsafe.Offsetof(cCfg.error_out),
+		},
+	}
+}
+
 func cShimPeerConnectionSetRemoteDescriptionParamsLayout() cStructLayout {
 	var cCfg C.ShimPeerConnectionSetRemoteDescriptionParams
 	return cStructLayout{
@@ -723,6 +1079,21 @@ func cShimPeerConnectionSetRemoteDescriptionParamsLayout() cStructLayout {
 	}
 }
 
+func cShimRTCPFeedbackLayout() cStructLayout {
+	var cCfg C.ShimRTCPFeedback
+	return cStructLayout{
+		size: unsafe.Sizeof(cCfg),
+		offsets: map[string]uintptr{
+			"Type":        unsafe.Offsetof(cCfg._type),
+			"SSRC":        unsafe.Offsetof(cCfg.ssrc),
+			"Count":       unsafe.Offsetof(cCfg.count),
+			"Lost":        unsafe.Offsetof(cCfg.lost),
+			"BitrateBps":  unsafe.Offsetof(cCfg.bitrate_bps),
+			"TimestampUs": unsafe.Offsetof(cCfg.timestamp_us),
+		},
+	}
+}
+
 func cShimRTCStatsLayout() cStructLayout {
 	var cCfg C.ShimRTCStats
 	return cStructLayout{
@@ -793,12 +1164,25 @@ func cShimRTPReceiverGetStatsParamsLayout() cStructLayout {
 	return cStructLayout{
 		size: unsafe.Sizeof(cCfg),
 		offsets: map[string]uintptr{
+			"PC":       unsafe.Offsetof(cCfg.pc),
 			"Receiver": unsafe.Offsetof(cCfg.receiver),
 			"OutStats": unsafe.Offsetof(cCfg.out_stats),
 		},
 	}
 }
 
+func cShimRTPReceiverSetEncodedFrameEventQueueParamsLayout() cStructLayout {
+	var cCfg C.ShimRTPReceiverSetEncodedFrameEventQueueParams
+	return cStructLayout{
+		size: unsafe.Sizeof(cCfg),
+		offsets: map[string]uintptr{
+			"Receiver": unsafe.Offsetof(cCfg.receiver),
+			"Queue":    unsafe.Offsetof(cCfg.queue),
+			"Tag":      unsafe.Offsetof(cCfg.tag),
+		},
+	}
+}
+
 func cShimRTPReceiverSetJitterBufferMinDelayParamsLayout() cStructLayout {
 	var cCfg C.ShimRTPReceiverSetJitterBufferMinDelayParams
 	return cStructLayout{
@@ -810,6 +1194,18 @@ func cShimRTPReceiverSetJitterBufferMinDelayParamsLayout() cStructLayout {
 	}
 }
 
+func cShimRTPReceiverSetOnEncodedFrameParamsLayout() cStructLayout {
+	var cCfg C.ShimRTPReceiverSetOnEncodedFrameParams
+	return cStructLayout{
+		size: unsafe.Sizeof(cCfg),
+		offsets: map[string]uintptr{
+			"Receiver": unsafe.Offsetof(cCfg.receiver),
+			"Callback": unsafe.Offsetof(cCfg.callback),
+			"Ctx":      unsafe.Offsetof(cCfg.ctx),
+		},
+	}
+}
+
 func cShimRTPSendParametersLayout() cStructLayout {
 	var cCfg C.ShimRTPSendParameters
 	return cStructLayout{
@@ -877,6 +1273,7 @@ func cShimRTPSenderGetStatsParamsLayout() cStructLayout {
 	return cStructLayout{
 		size: unsafe.Sizeof(cCfg),
 		offsets: map[string]uintptr{
+			"PC":       unsafe.Offsetof(cCfg.pc),
 			"Sender":   unsafe.Offsetof(cCfg.sender),
 			"OutStats": unsafe.Offsetof(cCfg.out_stats),
 		},
@@ -937,9 +1334,11 @@ func cShimRTPSenderSetOnRTCPFeedbackParamsLayout() cStructLayout {
 	return cStructLayout{
 		size: unsafe.Sizeof(cCfg),
 		offsets: map[string]uintptr{
-			"Sender":   unsafe.Offsetof(cCfg.sender),
-			"Callback": unsafe.Offsetof(cCfg.callback),
-			"Ctx":      unsafe.Offsetof(cCfg.ctx),
+			"PC":         unsafe.Offsetof(cCfg.pc),
+			"Sender":     unsafe.Offsetof(cCfg.sender),
+			"Callback":   unsafe.Offsetof(cCfg.callback),
+			"Ctx":        unsafe.Offsetof(cCfg.ctx),
+			"IntervalMs": unsafe.Offsetof(cCfg.interval_ms),
 		},
 	}
 }
@@ -969,6 +1368,20 @@ func cShimRTPSenderSetPreferredCodecParamsLayout() cStructLayout {
 	}
 }
 
+func cShimRTPSenderSetRTCPFeedbackEventQueueParamsLayout() cStructLayout {
+	var cCfg C.ShimRTPSenderSetRTCPFeedbackEventQueueParams
+	return cStructLayout{
+		size: unsafe.Sizeof(cCfg),
+		offsets: map[string]uintptr{
+			"PC":         unsafe.Offsetof(cCfg.pc),
+			"Sender":     unsafe.Offsetof(cCfg.sender),
+			"Queue":      unsafe.Offsetof(cCfg.queue),
+			"Tag":        unsafe.Offsetof(cCfg.tag),
+			"IntervalMs": unsafe.Offsetof(cCfg.interval_ms),
+		},
+	}
+}
+
 func cShimRTPSenderSetScalabilityModeParamsLayout() cStructLayout {
 	var cCfg C.ShimRTPSenderSetScalabilityModeParams
 	return cStructLayout{
@@ -981,6 +1394,37 @@ func cShimRTPSenderSetScalabilityModeParamsLayout() cStructLayout {
 	}
 }
 
+func cShimSRTPBatchParamsLayout() cStructLayout {
+	var cCfg C.ShimSRTPBatchParams
+	return cStructLayout{
+		size: unsafe.Sizeof(cCfg),
+		offsets: map[string]uintptr{
+			"Context":    unsafe.Offsetof(cCfg.context),
+			"Packets":    unsafe.Offsetof(cCfg.packets),
+			"Sizes":      unsafe.Offsetof(cCfg.sizes),
+			"Capacities": unsafe.Offsetof(cCfg.capacities),
+			"Count":      unsafe.Offsetof(cCfg.count),
+			"OutFailed":  unsafe.Offsetof(cCfg.out_failed),
+			"ErrorOut":   unsafe.Offsetof(cCfg.error_out),
+		},
+	}
+}
+
+func cShimSRTPContextCreateParamsLayout() cStructLayout {
+	var cCfg C.ShimSRTPContextCreateParams
+	return cStructLayout{
+		size: unsafe.Sizeof(cCfg),
+		offsets: map[string]uintptr{
+			"Profile":    unsafe.Offsetof(cCfg.profile),
+			"SendKey":    unsafe.Offsetof(cCfg.send_key),
+			"SendKeyLen": unsafe.Offsetof(cCfg.send_key_len),
+			"RecvKey":    unsafe.Offsetof(cCfg.recv_key),
+			"RecvKeyLen": unsafe.Offsetof(cCfg.recv_key_len),
+			"ErrorOut":   unsafe.Offsetof(cCfg.error_out),
+		},
+	}
+}
+
 func cShimScreenCaptureCreateParamsLayout() cStructLayout {
 	var cCfg C.ShimScreenCaptureCreateParams
 	return cStructLayout{
@@ -1030,6 +1474,251 @@ func cShimSessionDescriptionLayout() cStructLayout {
 	}
 }
 
+func cShimSetSocketServerParamsLayout() cStructLayout {
+	var cCfg C.ShimSetSocketServerParams
+	return cStructLayout{
+		size: unsafe.Sizeof(cCfg),
+		offsets: map[string]uintptr{
+			"Type":     unsafe.Offsetof(cCfg._type),
+			"ErrorOut": unsafe.Offsetof(cCfg.error_out),
+		},
+	}
+}
+
+func cShimSharedVideoEncoderCreateParamsLayout() cStructLayout {
+	var cCfg C.ShimSharedVideoEncoderCreateParams
+	return cStructLayout{
+		size: unsafe.Sizeof(cCfg),
+		offsets: map[string]uintptr{
+			"Codec":                 unsafe.Offsetof(cCfg.codec),
+			"Width":                 unsafe.Offsetof(cCfg.width),
+			"Height":                unsafe.Offsetof(cCfg.height),
+			"BitrateBps":            unsafe.Offsetof(cCfg.bitrate_bps),
+			"Framerate":             unsafe.Offsetof(cCfg.framerate),
+			"TemporalLayers":        unsafe.Offsetof(cCfg.temporal_layers),
+			"MinKeyframeIntervalMs": unsafe.Offsetof(cCfg.min_keyframe_interval_ms),
+			"ErrorOut":              unsafe.Offsetof(cCfg.error_out),
+		},
+	}
+}
+
+func cShimSharedVideoEncoderPushFrameParamsLayout() cStructLayout {
+	var cCfg C.ShimSharedVideoEncoderPushFrameParams
+	return cStructLayout{
+		size: unsafe.Sizeof(cCfg),
+		offsets: map[string]uintptr{
+			"Encoder":     unsafe.Offsetof(cCfg.encoder),
+			"YPlane":      unsafe.Offsetof(cCfg.y_plane),
+			"UPlane":      unsafe.Offsetof(cCfg.u_plane),
+			"VPlane":      unsafe.Offsetof(cCfg.v_plane),
+			"YStride":     unsafe.Offsetof(cCfg.y_stride),
+			"UStride":     unsafe.Offsetof(cCfg.u_stride),
+			"VStride":     unsafe.Offsetof(cCfg.v_stride),
+			"TimestampUs": unsafe.Offsetof(cCfg.timestamp_us),
+			"ErrorOut":    unsafe.Offsetof(cCfg.error_out),
+		},
+	}
+}
+
+func cShimSharedVideoEncoderSetRatesParamsLayout() cStructLayout {
+	var cCfg C.ShimSharedVideoEncoderSetRatesParams
+	return cStructLayout{
+		size: unsafe.Sizeof(cCfg),
+		offsets: map[string]uintptr{
+			"Encoder":    unsafe.Offsetof(cCfg.encoder),
+			"BitrateBps": unsafe.Offsetof(cCfg.bitrate_bps),
+			"Framerate":  unsafe.Offsetof(cCfg.framerate),
+		},
+	}
+}
+
+func cShimSharedVideoEncoderSubscribeParamsLayout() cStructLayout {
+	var cCfg C.ShimSharedVideoEncoderSubscribeParams
+	return cStructLayout{
+		size: unsafe.Sizeof(cCfg),
+		offsets: map[string]uintptr{
+			"Encoder":          unsafe.Offsetof(cCfg.encoder),
+			"MaxTemporalLayer": unsafe.Offsetof(cCfg.max_temporal_layer),
+			"ErrorOut":         unsafe.Offsetof(cCfg.error_out),
+		},
+	}
+}
+
+func cShimSocketServerStatsLayout() cStructLayout {
+	var cCfg C.ShimSocketServerStats
+	return cStructLayout{
+		size: unsafe.Sizeof(cCfg),
+		offsets: map[string]uintptr{
+			"RecvCalls":   unsafe.Offsetof(cCfg.recv_calls),
+			"RecvPackets": unsafe.Offsetof(cCfg.recv_packets),
+			"SendCalls":   unsafe.Offsetof(cCfg.send_calls),
+			"SendPackets": unsafe.Offsetof(cCfg.send_packets),
+			"GSOSends":    unsafe.Offsetof(cCfg.gso_sends),
+			"SendDrops":   unsafe.Offsetof(cCfg.send_drops),
+		},
+	}
+}
+
+func cShimStatsRecordLayout() cStructLayout {
+	var cCfg C.ShimStatsRecord
+	return cStructLayout{
+		size: unsafe.Sizeof(cCfg),
+		offsets: map[string]uintptr{
+			"Tag":                      unsafe.Offsetof(cCfg.tag),
+			"RoundUs":                  unsafe.Offsetof(cCfg.round_us),
+			"StreamIndex":              unsafe.Offsetof(cCfg.stream_index),
+			"StreamCount":              unsafe.Offsetof(cCfg.stream_count),
+			"CurrentRTTMs":             unsafe.Offsetof(cCfg.current_rtt_ms),
+			"AvailableOutgoingBitrate": unsafe.Offsetof(cCfg.available_outgoing_bitrate),
+			"AvailableIncomingBitrate": unsafe.Offsetof(cCfg.available_incoming_bitrate),
+			"Stream":                   unsafe.Offsetof(cCfg.stream),
+		},
+	}
+}
+
+func cShimStatsRingCreateParamsLayout() cStructLayout {
+	var cCfg C.ShimStatsRingCreateParams
+	return cStructLayout{
+		size: unsafe.Sizeof(cCfg),
+		offsets: map[string]uintptr{
+			"Capacity": unsafe.Offsetof(cCfg.capacity),
+			"ErrorOut": unsafe.Offsetof(cCfg.error_out),
+		},
+	}
+}
+
+func cShimStatsRingHeaderLayout() cStructLayout {
+	var cCfg C.ShimStatsRingHeader
+	return cStructLayout{
+		size: unsafe.Sizeof(cCfg),
+		offsets: map[string]uintptr{
+			"Capacity":      unsafe.Offsetof(cCfg.capacity),
+			"RecordSize":    unsafe.Offsetof(cCfg.record_size),
+			"RecordsOffset": unsafe.Offsetof(cCfg.records_offset),
+			"Reserved":      unsafe.Offsetof(cCfg.reserved),
+			"WriteSeq":      unsafe.Offsetof(cCfg.write_seq),
+			"ReadSeq":       unsafe.Offsetof(cCfg.read_seq),
+			"Dropped":       unsafe.Offsetof(cCfg.dropped),
+		},
+	}
+}
+
+func cShimStatsRingSubscribeParamsLayout() cStructLayout {
+	var cCfg C.ShimStatsRingSubscribeParams
+	return cStructLayout{
+		size: unsafe.Sizeof(cCfg),
+		offsets: map[string]uintptr{
+			"Ring":       unsafe.Offsetof(cCfg.ring),
+			"PC":         unsafe.Offsetof(cCfg.pc),
+			"IntervalMs": unsafe.Offsetof(cCfg.interval_ms),
+			"Tag":        unsafe.Offsetof(cCfg.tag),
+			"ErrorOut":   unsafe.Offsetof(cCfg.error_out),
+		},
+	}
+}
+
+func cShimStatsRingUnsubscribeParamsLayout() cStructLayout {
+	var cCfg C.ShimStatsRingUnsubscribeParams
+	return cStructLayout{
+		size: unsafe.Sizeof(cCfg),
+		offsets: map[string]uintptr{
+			"Ring": unsafe.Offsetof(cCfg.ring),
+			"PC":   unsafe.Offsetof(cCfg.pc),
+		},
+	}
+}
+
+func cShimStreamStatsLayout() cStructLayout {
+	var cCfg C.ShimStreamStats
+	return cStructLayout{
+		size: unsafe.Sizeof(cCfg),
+		offsets: map[string]uintptr{
+			"SSRC":                     unsafe.Offsetof(cCfg.ssrc),
+			"Direction":                unsafe.Offsetof(cCfg.direction),
+			"Kind":                     unsafe.Offsetof(cCfg.kind),
+			"QualityLimitationReason":  unsafe.Offsetof(cCfg.quality_limitation_reason),
+			"Mid":                      unsafe.Offsetof(cCfg.mid),
+			"RID":                      unsafe.Offsetof(cCfg.rid),
+			"TimestampUs":              unsafe.Offsetof(cCfg.timestamp_us),
+			"Bytes":                    unsafe.Offsetof(cCfg.bytes),
+			"Packets":                  unsafe.Offsetof(cCfg.packets),
+			"PacketsLost":              unsafe.Offsetof(cCfg.packets_lost),
+			"RetransmittedBytes":       unsafe.Offsetof(cCfg.retransmitted_bytes),
+			"JitterBufferEmittedCount": unsafe.Offsetof(cCfg.jitter_buffer_emitted_count),
+			"QPSum":                    unsafe.Offsetof(cCfg.qp_sum),
+			"JitterMs":                 unsafe.Offsetof(cCfg.jitter_ms),
+			"RoundTripTimeMs":          unsafe.Offsetof(cCfg.round_trip_time_ms),
+			"FractionLost":             unsafe.Offsetof(cCfg.fraction_lost),
+			"TargetBitrateBps":         unsafe.Offsetof(cCfg.target_bitrate_bps),
+			"FramesPerSecond":          unsafe.Offsetof(cCfg.frames_per_second),
+			"JitterBufferDelayMs":      unsafe.Offsetof(cCfg.jitter_buffer_delay_ms),
+			"AudioLevel":               unsafe.Offsetof(cCfg.audio_level),
+			"Frames":                   unsafe.Offsetof(cCfg.frames),
+			"KeyFrames":                unsafe.Offsetof(cCfg.key_frames),
+			"FramesDropped":            unsafe.Offsetof(cCfg.frames_dropped),
+			"FrameWidth":               unsafe.Offsetof(cCfg.frame_width),
+			"FrameHeight":              unsafe.Offsetof(cCfg.frame_height),
+			"NACKCount":                unsafe.Offsetof(cCfg.nack_count),
+			"PLICount":                 unsafe.Offsetof(cCfg.pli_count),
+			"FIRCount":                 unsafe.Offsetof(cCfg.fir_count),
+			"IntervalUs":               unsafe.Offsetof(cCfg.interval_us),
+			"BitrateBps":               unsafe.Offsetof(cCfg.bitrate_bps),
+			"PacketRate":               unsafe.Offsetof(cCfg.packet_rate),
+			"IntervalLossRate":         unsafe.Offsetof(cCfg.interval_loss_rate),
+		},
+	}
+}
+
+func cShimThreadGroupCreateParamsLayout() cStructLayout {
+	var cCfg C.ShimThreadGroupCreateParams
+	return cStructLayout{
+		size: unsafe.Sizeof(cCfg),
+		offsets: map[string]uintptr{
+			"ShardCount":    unsafe.Offsetof(cCfg.shard_count),
+			"FactoryConfig": unsafe.Offsetof(cCfg.factory_config),
+			"PinThreads":    unsafe.Offsetof(cCfg.pin_threads),
+			"CPUIDs":        unsafe.Offsetof(cCfg.cpu_ids),
+			"CPUIDCount":    unsafe.Offsetof(cCfg.cpu_id_count),
+			"SocketServer":  unsafe.Offsetof(cCfg.socket_server),
+			"ErrorOut":      unsafe.Offsetof(cCfg.error_out),
+		},
+	}
+}
+
+func cShimTrackPullVideoFrameParamsLayout() cStructLayout {
+	var cCfg C.ShimTrackPullVideoFrameParams
+	return cStructLayout{
+		size: unsafe.Sizeof(cCfg),
+		offsets: map[string]uintptr{
+			"Track":         unsafe.Offsetof(cCfg.track),
+			"Frame":         unsafe.Offsetof(cCfg.frame),
+			"Width":         unsafe.Offsetof(cCfg.width),
+			"Height":        unsafe.Offsetof(cCfg.height),
+			"YPlane":        unsafe.Offsetof(cCfg.y_plane),
+			"UPlane":        unsafe.Offsetof(cCfg.u_plane),
+			"VPlane":        unsafe.Offsetof(cCfg.v_plane),
+			"YStride":       unsafe.Offsetof(cCfg.y_stride),
+			"UStride":       unsafe.Offsetof(cCfg.u_stride),
+			"VStride":       unsafe.Offsetof(cCfg.v_stride),
+			"TimestampUs":   unsafe.Offsetof(cCfg.timestamp_us),
+			"FramesDropped": unsafe.Offsetof(cCfg.frames_dropped),
+		},
+	}
+}
+
+func cShimTrackSetAudioSinkFormatParamsLayout() cStructLayout {
+	var cCfg C.ShimTrackSetAudioSinkFormatParams
+	return cStructLayout{
+		size: unsafe.Sizeof(cCfg),
+		offsets: map[string]uintptr{
+			"Track":      unsafe.Offsetof(cCfg.track),
+			"BatchMs":    unsafe.Offsetof(cCfg.batch_ms),
+			"SampleRate": unsafe.Offsetof(cCfg.sample_rate),
+			"Channels":   unsafe.Offsetof(cCfg.channels),
+		},
+	}
+}
+
 func cShimTrackSetAudioSinkParamsLayout() cStructLayout {
 	var cCfg C.ShimTrackSetAudioSinkParams
 	return cStructLayout{
@@ -1042,6 +1731,29 @@ func cShimTrackSetAudioSinkParamsLayout() cStructLayout {
 	}
 }
 
+func cShimTrackSetEventQueueSinkParamsLayout() cStructLayout {
+	var cCfg C.ShimTrackSetEventQueueSinkParams
+	return cStructLayout{
+		size: unsafe.Sizeof(cCfg),
+		offsets: map[string]uintptr{
+			"Track": unsafe.Offsetof(cCfg.track),
+			"Queue": unsafe.Offsetof(cCfg.queue),
+			"Tag":   unsafe.Offsetof(cCfg.tag),
+		},
+	}
+}
+
+func cShimTrackSetVideoMailboxParamsLayout() cStructLayout {
+	var cCfg C.ShimTrackSetVideoMailboxParams
+	return cStructLayout{
+		size: unsafe.Sizeof(cCfg),
+		offsets: map[string]uintptr{
+			"Track": unsafe.Offsetof(cCfg.track),
+			"Slots": unsafe.Offsetof(cCfg.slots),
+		},
+	}
+}
+
 func cShimTrackSetVideoSinkParamsLayout() cStructLayout {
 	var cCfg C.ShimTrackSetVideoSinkParams
 	return cStructLayout{
@@ -1054,6 +1766,19 @@ func cShimTrackSetVideoSinkParamsLayout() cStructLayout {
 	}
 }
 
+func cShimTrackSetVideoSinkWantsParamsLayout() cStructLayout {
+	var cCfg C.ShimTrackSetVideoSinkWantsParams
+	return cStructLayout{
+		size: unsafe.Sizeof(cCfg),
+		offsets: map[string]uintptr{
+			"Track":            unsafe.Offsetof(cCfg.track),
+			"MaxPixelCount":    unsafe.Offsetof(cCfg.max_pixel_count),
+			"TargetPixelCount": unsafe.Offsetof(cCfg.target_pixel_count),
+			"MaxFramerate":     unsafe.Offsetof(cCfg.max_framerate),
+		},
+	}
+}
+
 func cShimTransceiverGetCodecPreferencesParamsLayout() cStructLayout {
 	var cCfg C.ShimTransceiverGetCodecPreferencesParams
 	return cStructLayout{
@@ -1238,6 +1963,57 @@ func cShimVideoEncoderSetFramerateParamsLayout() cStructLayout {
 	}
 }
 
+func cShimVideoFrameRingCreateParamsLayout() cStructLayout {
+	var cCfg C.ShimVideoFrameRingCreateParams
+	return cStructLayout{
+		size: unsafe.Sizeof(cCfg),
+		offsets: map[string]uintptr{
+			"Source":   unsafe.Offsetof(cCfg.source),
+			"Slots":    unsafe.Offsetof(cCfg.slots),
+			"ErrorOut": unsafe.Offsetof(cCfg.error_out),
+		},
+	}
+}
+
+func cShimVideoFrameRingHeaderLayout() cStructLayout {
+	var cCfg C.ShimVideoFrameRingHeader
+	return cStructLayout{
+		size: unsafe.Sizeof(cCfg),
+		offsets: map[string]uintptr{
+			"SlotCount":       unsafe.Offsetof(cCfg.slot_count),
+			"SlotSize":        unsafe.Offsetof(cCfg.slot_size),
+			"SlotsOffset":     unsafe.Offsetof(cCfg.slots_offset),
+			"Width":           unsafe.Offsetof(cCfg.width),
+			"Height":          unsafe.Offsetof(cCfg.height),
+			"YStride":         unsafe.Offsetof(cCfg.y_stride),
+			"UStride":         unsafe.Offsetof(cCfg.u_stride),
+			"VStride":         unsafe.Offsetof(cCfg.v_stride),
+			"YOffset":         unsafe.Offsetof(cCfg.y_offset),
+			"UOffset":         unsafe.Offsetof(cCfg.u_offset),
+			"VOffset":         unsafe.Offsetof(cCfg.v_offset),
+			"NotifyFd":        unsafe.Offsetof(cCfg.notify_fd),
+			"Reserved0":       unsafe.Offsetof(cCfg.reserved0),
+			"WriteSeq":        unsafe.Offsetof(cCfg.write_seq),
+			"Reserved1":       unsafe.Offsetof(cCfg.reserved1),
+			"ReadSeq":         unsafe.Offsetof(cCfg.read_seq),
+			"ConsumerWaiting": unsafe.Offsetof(cCfg.consumer_waiting),
+			"Reserved2":       unsafe.Offsetof(cCfg.reserved2),
+			"Reserved3":       unsafe.Offsetof(cCfg.reserved3),
+		},
+	}
+}
+
+func cShimVideoFrameSlotHeaderLayout() cStructLayout {
+	var cCfg C.ShimVideoFrameSlotHeader
+	return cStructLayout{
+		size: unsafe.Sizeof(cCfg),
+		offsets: map[string]uintptr{
+			"TimestampUs": unsafe.Offsetof(cCfg.timestamp_us),
+			"Reserved":    unsafe.Offsetof(cCfg.reserved),
+		},
+	}
+}
+
 func cShimVideoTrackSourceCreateParamsLayout() cStructLayout {
 	var cCfg C.ShimVideoTrackSourceCreateParams
 	return cStructLayout{
@@ -1250,6 +2026,18 @@ func cShimVideoTrackSourceCreateParamsLayout() cStructLayout {
 	}
 }
 
+func cShimVideoTrackSourceGetPoolStatsParamsLayout() cStructLayout {
+	var cCfg C.ShimVideoTrackSourceGetPoolStatsParams
+	return cStructLayout{
+		size: unsafe.Sizeof(cCfg),
+		offsets: map[string]uintptr{
+			"Source":     unsafe.Offsetof(cCfg.source),
+			"PoolHits":   unsafe.Offsetof(cCfg.pool_hits),
+			"PoolMisses": unsafe.Offsetof(cCfg.pool_misses),
+		},
+	}
+}
+
 func cShimVideoTrackSourcePushFrameParamsLayout() cStructLayout {
 	var cCfg C.ShimVideoTrackSourcePushFrameParams
 	return cStructLayout{
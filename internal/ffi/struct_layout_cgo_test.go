@@ -141,6 +141,15 @@ func TestShimStructLayoutCgo(t *testing.T) {
 		checkOffsetEqual(t, "ShimDataChannelSendParams.ErrorOut", unsafe.Offsetof(goCfg.ErrorOut), layout.offsets["ErrorOut"])
 	})
 
+	t.Run("ShimDataChannelSetEventQueueParams", func(t *testing.T) {
+		var goCfg shimDataChannelSetEventQueueParams
+		layout := cShimDataChannelSetEventQueueParamsLayout()
+		checkSizeEqual(t, "ShimDataChannelSetEventQueueParams", unsafe.Sizeof(goCfg), layout.size)
+		checkOffsetEqual(t, "ShimDataChannelSetEventQueueParams.DC", unsafe.Offsetof(goCfg.DC), layout.offsets["DC"])
+		checkOffsetEqual(t, "ShimDataChannelSetEventQueueParams.Queue", unsafe.Offsetof(goCfg.Queue), layout.offsets["Queue"])
+		checkOffsetEqual(t, "ShimDataChannelSetEventQueueParams.Tag", unsafe.Offsetof(goCfg.Tag), layout.offsets["Tag"])
+	})
+
 	t.Run("ShimDataChannelSetOnCloseParams", func(t *testing.T) {
 		var goCfg shimDataChannelSetOnCloseParams
 		layout := cShimDataChannelSetOnCloseParamsLayout()
@@ -197,6 +206,68 @@ func TestShimStructLayoutCgo(t *testing.T) {
 		checkOffsetEqual(t, "ShimDeviceInfo.kind", unsafe.Offsetof(goCfg.kind), layout.offsets["kind"])
 	})
 
+	t.Run("ShimEncodedVideoFrameInfo", func(t *testing.T) {
+		var goCfg EncodedFrameInfo
+		layout := cShimEncodedVideoFrameInfoLayout()
+		checkSizeEqual(t, "ShimEncodedVideoFrameInfo", unsafe.Sizeof(goCfg), layout.size)
+		checkOffsetEqual(t, "ShimEncodedVideoFrameInfo.Codec", unsafe.Offsetof(goCfg.Codec), layout.offsets["Codec"])
+		checkOffsetEqual(t, "ShimEncodedVideoFrameInfo.SSRC", unsafe.Offsetof(goCfg.SSRC), layout.offsets["SSRC"])
+		checkOffsetEqual(t, "ShimEncodedVideoFrameInfo.RTPTimestamp", unsafe.Offsetof(goCfg.RTPTimestamp), layout.offsets["RTPTimestamp"])
+		checkOffsetEqual(t, "ShimEncodedVideoFrameInfo.PayloadType", unsafe.Offsetof(goCfg.PayloadType), layout.offsets["PayloadType"])
+		checkOffsetEqual(t, "ShimEncodedVideoFrameInfo.IsKeyframe", unsafe.Offsetof(goCfg.IsKeyframe), layout.offsets["IsKeyframe"])
+		checkOffsetEqual(t, "ShimEncodedVideoFrameInfo.Width", unsafe.Offsetof(goCfg.Width), layout.offsets["Width"])
+		checkOffsetEqual(t, "ShimEncodedVideoFrameInfo.Height", unsafe.Offsetof(goCfg.Height), layout.offsets["Height"])
+		checkOffsetEqual(t, "ShimEncodedVideoFrameInfo.SpatialIndex", unsafe.Offsetof(goCfg.SpatialIndex), layout.offsets["SpatialIndex"])
+		checkOffsetEqual(t, "ShimEncodedVideoFrameInfo.TemporalIndex", unsafe.Offsetof(goCfg.TemporalIndex), layout.offsets["TemporalIndex"])
+		checkOffsetEqual(t, "ShimEncodedVideoFrameInfo.NumDependencies", unsafe.Offsetof(goCfg.NumDependencies), layout.offsets["NumDependencies"])
+		checkOffsetEqual(t, "ShimEncodedVideoFrameInfo.FrameID", unsafe.Offsetof(goCfg.FrameID), layout.offsets["FrameID"])
+		checkOffsetEqual(t, "ShimEncodedVideoFrameInfo.Dependencies", unsafe.Offsetof(goCfg.Dependencies), layout.offsets["Dependencies"])
+		checkOffsetEqual(t, "ShimEncodedVideoFrameInfo.ReceiveTimeUs", unsafe.Offsetof(goCfg.ReceiveTimeUs), layout.offsets["ReceiveTimeUs"])
+	})
+
+	t.Run("ShimEncodedVideoSourceCreateParams", func(t *testing.T) {
+		var goCfg shimEncodedVideoSourceCreateParams
+		layout := cShimEncodedVideoSourceCreateParamsLayout()
+		checkSizeEqual(t, "ShimEncodedVideoSourceCreateParams", unsafe.Sizeof(goCfg), layout.size)
+		checkOffsetEqual(t, "ShimEncodedVideoSourceCreateParams.Codec", unsafe.Offsetof(goCfg.Codec), layout.offsets["Codec"])
+		checkOffsetEqual(t, "ShimEncodedVideoSourceCreateParams.Width", unsafe.Offsetof(goCfg.Width), layout.offsets["Width"])
+		checkOffsetEqual(t, "ShimEncodedVideoSourceCreateParams.Height", unsafe.Offsetof(goCfg.Height), layout.offsets["Height"])
+		checkOffsetEqual(t, "ShimEncodedVideoSourceCreateParams.MinKeyframeIntervalMs", unsafe.Offsetof(goCfg.MinKeyframeIntervalMs), layout.offsets["MinKeyframeIntervalMs"])
+		checkOffsetEqual(t, "ShimEncodedVideoSourceCreateParams.ErrorOut", unsafe.Offsetof(goCfg.ErrorOut), layout.offsets["ErrorOut"])
+	})
+
+	t.Run("ShimEncodedVideoSourcePushFrameParams", func(t *testing.T) {
+		var goCfg shimEncodedVideoSourcePushFrameParams
+		layout := cShimEncodedVideoSourcePushFrameParamsLayout()
+		checkSizeEqual(t, "ShimEncodedVideoSourcePushFrameParams", unsafe.Sizeof(goCfg), layout.size)
+		checkOffsetEqual(t, "ShimEncodedVideoSourcePushFrameParams.Source", unsafe.Offsetof(goCfg.Source), layout.offsets["Source"])
+		checkOffsetEqual(t, "ShimEncodedVideoSourcePushFrameParams.Data", unsafe.Offsetof(goCfg.Data), layout.offsets["Data"])
+		checkOffsetEqual(t, "ShimEncodedVideoSourcePushFrameParams.Size", unsafe.Offsetof(goCfg.Size), layout.offsets["Size"])
+		checkOffsetEqual(t, "ShimEncodedVideoSourcePushFrameParams.Width", unsafe.Offsetof(goCfg.Width), layout.offsets["Width"])
+		checkOffsetEqual(t, "ShimEncodedVideoSourcePushFrameParams.Height", unsafe.Offsetof(goCfg.Height), layout.offsets["Height"])
+		checkOffsetEqual(t, "ShimEncodedVideoSourcePushFrameParams.IsKeyframe", unsafe.Offsetof(goCfg.IsKeyframe), layout.offsets["IsKeyframe"])
+		checkOffsetEqual(t, "ShimEncodedVideoSourcePushFrameParams.TemporalID", unsafe.Offsetof(goCfg.TemporalID), layout.offsets["TemporalID"])
+		checkOffsetEqual(t, "ShimEncodedVideoSourcePushFrameParams.TimestampUs", unsafe.Offsetof(goCfg.TimestampUs), layout.offsets["TimestampUs"])
+		checkOffsetEqual(t, "ShimEncodedVideoSourcePushFrameParams.ErrorOut", unsafe.Offsetof(goCfg.ErrorOut), layout.offsets["ErrorOut"])
+	})
+
+	t.Run("ShimEncodedVideoSourceSetMaxTemporalLayerParams", func(t *testing.T) {
+		var goCfg shimEncodedVideoSourceSetMaxTemporalLayerParams
+		layout := cShimEncodedVideoSourceSetMaxTemporalLayerParamsLayout()
+		checkSizeEqual(t, "ShimEncodedVideoSourceSetMaxTemporalLayerParams", unsafe.Sizeof(goCfg), layout.size)
+		checkOffsetEqual(t, "ShimEncodedVideoSourceSetMaxTemporalLayerParams.Source", unsafe.Offsetof(goCfg.Source), layout.offsets["Source"])
+		checkOffsetEqual(t, "ShimEncodedVideoSourceSetMaxTemporalLayerParams.MaxTemporalLayer", unsafe.Offsetof(goCfg.MaxTemporalLayer), layout.offsets["MaxTemporalLayer"])
+	})
+
+	t.Run("ShimEncodedVideoSourceSetOnKeyFrameRequestParams", func(t *testing.T) {
+		var goCfg shimEncodedVideoSourceSetOnKeyFrameRequestParams
+		layout := cShimEncodedVideoSourceSetOnKeyFrameRequestParamsLayout()
+		checkSizeEqual(t, "ShimEncodedVideoSourceSetOnKeyFrameRequestParams", unsafe.Sizeof(goCfg), layout.size)
+		checkOffsetEqual(t, "ShimEncodedVideoSourceSetOnKeyFrameRequestParams.Source", unsafe.Offsetof(goCfg.Source), layout.offsets["Source"])
+		checkOffsetEqual(t, "ShimEncodedVideoSourceSetOnKeyFrameRequestParams.Callback", unsafe.Offsetof(goCfg.Callback), layout.offsets["Callback"])
+		checkOffsetEqual(t, "ShimEncodedVideoSourceSetOnKeyFrameRequestParams.Ctx", unsafe.Offsetof(goCfg.Ctx), layout.offsets["Ctx"])
+	})
+
 	t.Run("ShimEnumerateDevicesParams", func(t *testing.T) {
 		var goCfg shimEnumerateDevicesParams
 		layout := cShimEnumerateDevicesParamsLayout()
@@ -224,6 +295,47 @@ func TestShimStructLayoutCgo(t *testing.T) {
 		checkOffsetEqual(t, "ShimErrorBuffer.Message", unsafe.Offsetof(goCfg.Message), layout.offsets["Message"])
 	})
 
+	t.Run("ShimEvent", func(t *testing.T) {
+		var goCfg Event
+		layout := cShimEventLayout()
+		checkSizeEqual(t, "ShimEvent", unsafe.Sizeof(goCfg), layout.size)
+		checkOffsetEqual(t, "ShimEvent.Type", unsafe.Offsetof(goCfg.Type), layout.offsets["Type"])
+		checkOffsetEqual(t, "ShimEvent.Value", unsafe.Offsetof(goCfg.Value), layout.offsets["Value"])
+		checkOffsetEqual(t, "ShimEvent.Tag", unsafe.Offsetof(goCfg.Tag), layout.offsets["Tag"])
+		checkOffsetEqual(t, "ShimEvent.Object", unsafe.Offsetof(goCfg.Object), layout.offsets["Object"])
+		checkOffsetEqual(t, "ShimEvent.Object2", unsafe.Offsetof(goCfg.Object2), layout.offsets["Object2"])
+		checkOffsetEqual(t, "ShimEvent.Width", unsafe.Offsetof(goCfg.Width), layout.offsets["Width"])
+		checkOffsetEqual(t, "ShimEvent.Height", unsafe.Offsetof(goCfg.Height), layout.offsets["Height"])
+		checkOffsetEqual(t, "ShimEvent.TimestampUs", unsafe.Offsetof(goCfg.TimestampUs), layout.offsets["TimestampUs"])
+		checkOffsetEqual(t, "ShimEvent.PayloadOffset", unsafe.Offsetof(goCfg.PayloadOffset), layout.offsets["PayloadOffset"])
+		checkOffsetEqual(t, "ShimEvent.PayloadLen", unsafe.Offsetof(goCfg.PayloadLen), layout.offsets["PayloadLen"])
+		checkOffsetEqual(t, "ShimEvent.CaptureTimeUs", unsafe.Offsetof(goCfg.CaptureTimeUs), layout.offsets["CaptureTimeUs"])
+		checkOffsetEqual(t, "ShimEvent.HasCaptureTime", unsafe.Offsetof(goCfg.HasCaptureTime), layout.offsets["HasCaptureTime"])
+	})
+
+	t.Run("ShimEventQueueCreateParams", func(t *testing.T) {
+		var goCfg shimEventQueueCreateParams
+		layout := cShimEventQueueCreateParamsLayout()
+		checkSizeEqual(t, "ShimEventQueueCreateParams", unsafe.Sizeof(goCfg), layout.size)
+		checkOffsetEqual(t, "ShimEventQueueCreateParams.Capacity", unsafe.Offsetof(goCfg.Capacity), layout.offsets["Capacity"])
+		checkOffsetEqual(t, "ShimEventQueueCreateParams.ErrorOut", unsafe.Offsetof(goCfg.ErrorOut), layout.offsets["ErrorOut"])
+	})
+
+	t.Run("ShimEventQueueDrainParams", func(t *testing.T) {
+		var goCfg shimEventQueueDrainParams
+		layout := cShimEventQueueDrainParamsLayout()
+		checkSizeEqual(t, "ShimEventQueueDrainParams", unsafe.Sizeof(goCfg), layout.size)
+		checkOffsetEqual(t, "ShimEventQueueDrainParams.Queue", unsafe.Offsetof(goCfg.Queue), layout.offsets["Queue"])
+		checkOffsetEqual(t, "ShimEventQueueDrainParams.Events", unsafe.Offsetof(goCfg.Events), layout.offsets["Events"])
+		checkOffsetEqual(t, "ShimEventQueueDrainParams.MaxEvents", unsafe.Offsetof(goCfg.MaxEvents), layout.offsets["MaxEvents"])
+		checkOffsetEqual(t, "ShimEventQueueDrainParams.Payload", unsafe.Offsetof(goCfg.Payload), layout.offsets["Payload"])
+		checkOffsetEqual(t, "ShimEventQueueDrainParams.PayloadSize", unsafe.Offsetof(goCfg.PayloadSize), layout.offsets["PayloadSize"])
+		checkOffsetEqual(t, "ShimEventQueueDrainParams.OutCount", unsafe.Offsetof(goCfg.OutCount), layout.offsets["OutCount"])
+		checkOffsetEqual(t, "ShimEventQueueDrainParams.OutPayloadLen", unsafe.Offsetof(goCfg.OutPayloadLen), layout.offsets["OutPayloadLen"])
+		checkOffsetEqual(t, "ShimEventQueueDrainParams.OutDropped", unsafe.Offsetof(goCfg.OutDropped), layout.offsets["OutDropped"])
+		checkOffsetEqual(t, "ShimEventQueueDrainParams.ErrorOut", unsafe.Offsetof(goCfg.ErrorOut), layout.offsets["ErrorOut"])
+	})
+
 	t.Run("ShimGetSupportedAudioCodecsParams", func(t *testing.T) {
 		var goCfg shimGetSupportedAudioCodecsParams
 		layout := cShimGetSupportedAudioCodecsParamsLayout()
@@ -261,6 +373,29 @@ func TestShimStructLayoutCgo(t *testing.T) {
 		checkOffsetEqual(t, "ShimICEServer.Credential", unsafe.Offsetof(goCfg.Credential), layout.offsets["Credential"])
 	})
 
+	t.Run("ShimLoopbackNetworkCreateParams", func(t *testing.T) {
+		var goCfg shimLoopbackNetworkCreateParams
+		layout := cShimLoopbackNetworkCreateParamsLayout()
+		checkSizeEqual(t, "ShimLoopbackNetworkCreateParams", unsafe.Sizeof(goCfg), layout.size)
+		checkOffsetEqual(t, "ShimLoopbackNetworkCreateParams.DelayMs", unsafe.Offsetof(goCfg.DelayMs), layout.offsets["DelayMs"])
+		checkOffsetEqual(t, "ShimLoopbackNetworkCreateParams.LossRate", unsafe.Offsetof(goCfg.LossRate), layout.offsets["LossRate"])
+		checkOffsetEqual(t, "ShimLoopbackNetworkCreateParams.BandwidthKbps", unsafe.Offsetof(goCfg.BandwidthKbps), layout.offsets["BandwidthKbps"])
+		checkOffsetEqual(t, "ShimLoopbackNetworkCreateParams.QueueMs", unsafe.Offsetof(goCfg.QueueMs), layout.offsets["QueueMs"])
+		checkOffsetEqual(t, "ShimLoopbackNetworkCreateParams.Seed", unsafe.Offsetof(goCfg.Seed), layout.offsets["Seed"])
+		checkOffsetEqual(t, "ShimLoopbackNetworkCreateParams.ErrorOut", unsafe.Offsetof(goCfg.ErrorOut), layout.offsets["ErrorOut"])
+	})
+
+	t.Run("ShimLoopbackNetworkStats", func(t *testing.T) {
+		var goCfg LoopbackNetworkStats
+		layout := cShimLoopbackNetworkStatsLayout()
+		checkSizeEqual(t, "ShimLoopbackNetworkStats", unsafe.Sizeof(goCfg), layout.size)
+		checkOffsetEqual(t, "ShimLoopbackNetworkStats.PacketsSent", unsafe.Offsetof(goCfg.PacketsSent), layout.offsets["PacketsSent"])
+		checkOffsetEqual(t, "ShimLoopbackNetworkStats.PacketsDelivered", unsafe.Offsetof(goCfg.PacketsDelivered), layout.offsets["PacketsDelivered"])
+		checkOffsetEqual(t, "ShimLoopbackNetworkStats.BytesDelivered", unsafe.Offsetof(goCfg.BytesDelivered), layout.offsets["BytesDelivered"])
+		checkOffsetEqual(t, "ShimLoopbackNetworkStats.PacketsLost", unsafe.Offsetof(goCfg.PacketsLost), layout.offsets["PacketsLost"])
+		checkOffsetEqual(t, "ShimLoopbackNetworkStats.PacketsDropped", unsafe.Offsetof(goCfg.PacketsDropped), layout.offsets["PacketsDropped"])
+	})
+
 	t.Run("ShimPacketizerConfig", func(t *testing.T) {
 		var goCfg PacketizerConfig
 		layout := cShimPacketizerConfigLayout()
@@ -288,6 +423,15 @@ func TestShimStructLayoutCgo(t *testing.T) {
 		checkOffsetEqual(t, "ShimPacketizerPacketizeParams.OutCount", unsafe.Offsetof(goCfg.OutCount), layout.offsets["OutCount"])
 	})
 
+	t.Run("ShimPeerConnectionAcquireParams", func(t *testing.T) {
+		var goCfg shimPeerConnectionAcquireParams
+		layout := cShimPeerConnectionAcquireParamsLayout()
+		checkSizeEqual(t, "ShimPeerConnectionAcquireParams", unsafe.Sizeof(goCfg), layout.size)
+		checkOffsetEqual(t, "ShimPeerConnectionAcquireParams.Pool", unsafe.Offsetof(goCfg.Pool), layout.offsets["Pool"])
+		checkOffsetEqual(t, "ShimPeerConnectionAcquireParams.OutPooled", unsafe.Offsetof(goCfg.OutPooled), layout.offsets["OutPooled"])
+		checkOffsetEqual(t, "ShimPeerConnectionAcquireParams.ErrorOut", unsafe.Offsetof(goCfg.ErrorOut), layout.offsets["ErrorOut"])
+	})
+
 	t.Run("ShimPeerConnectionAddAudioTrackFromSourceParams", func(t *testing.T) {
 		var goCfg shimPeerConnectionAddAudioTrackFromSourceParams
 		layout := cShimPeerConnectionAddAudioTrackFromSourceParamsLayout()
@@ -299,6 +443,17 @@ func TestShimStructLayoutCgo(t *testing.T) {
 		checkOffsetEqual(t, "ShimPeerConnectionAddAudioTrackFromSourceParams.ErrorOut", unsafe.Offsetof(goCfg.ErrorOut), layout.offsets["ErrorOut"])
 	})
 
+	t.Run("ShimPeerConnectionAddEncodedVideoTrackParams", func(t *testing.T) {
+		var goCfg shimPeerConnectionAddEncodedVideoTrackParams
+		layout := cShimPeerConnectionAddEncodedVideoTrackParamsLayout()
+		checkSizeEqual(t, "ShimPeerConnectionAddEncodedVideoTrackParams", unsafe.Sizeof(goCfg), layout.size)
+		checkOffsetEqual(t, "ShimPeerConnectionAddEncodedVideoTrackParams.PC", unsafe.Offsetof(goCfg.PC), layout.offsets["PC"])
+		checkOffsetEqual(t, "ShimPeerConnectionAddEncodedVideoTrackParams.Source", unsafe.Offsetof(goCfg.Source), layout.offsets["Source"])
+		checkOffsetEqual(t, "ShimPeerConnectionAddEncodedVideoTrackParams.TrackID", unsafe.Offsetof(goCfg.TrackID), layout.offsets["TrackID"])
+		checkOffsetEqual(t, "ShimPeerConnectionAddEncodedVideoTrackParams.StreamID", unsafe.Offsetof(goCfg.StreamID), layout.offsets["StreamID"])
+		checkOffsetEqual(t, "ShimPeerConnectionAddEncodedVideoTrackParams.ErrorOut", unsafe.Offsetof(goCfg.ErrorOut), layout.offsets["ErrorOut"])
+	})
+
 	t.Run("ShimPeerConnectionAddICECandidateParams", func(t *testing.T) {
 		var goCfg shimPeerConnectionAddICECandidateParams
 		layout := cShimPeerConnectionAddICECandidateParamsLayout()
@@ -352,6 +507,30 @@ func TestShimStructLayoutCgo(t *testing.T) {
 		checkOffsetEqual(t, "ShimPeerConnectionConfig.BundlePolicy", unsafe.Offsetof(goCfg.BundlePolicy), layout.offsets["BundlePolicy"])
 		checkOffsetEqual(t, "ShimPeerConnectionConfig.RTCPMuxPolicy", unsafe.Offsetof(goCfg.RTCPMuxPolicy), layout.offsets["RTCPMuxPolicy"])
 		checkOffsetEqual(t, "ShimPeerConnectionConfig.SDPSemantics", unsafe.Offsetof(goCfg.SDPSemantics), layout.offsets["SDPSemantics"])
+		checkOffsetEqual(t, "ShimPeerConnectionConfig.ICETransportPolicy", unsafe.Offsetof(goCfg.ICETransportPolicy), layout.offsets["ICETransportPolicy"])
+		checkOffsetEqual(t, "ShimPeerConnectionConfig.CandidateNetworkPolicy", unsafe.Offsetof(goCfg.CandidateNetworkPolicy), layout.offsets["CandidateNetworkPolicy"])
+		checkOffsetEqual(t, "ShimPeerConnectionConfig.TCPCandidatePolicy", unsafe.Offsetof(goCfg.TCPCandidatePolicy), layout.offsets["TCPCandidatePolicy"])
+		checkOffsetEqual(t, "ShimPeerConnectionConfig.PortRangeMin", unsafe.Offsetof(goCfg.PortRangeMin), layout.offsets["PortRangeMin"])
+		checkOffsetEqual(t, "ShimPeerConnectionConfig.PortRangeMax", unsafe.Offsetof(goCfg.PortRangeMax), layout.offsets["PortRangeMax"])
+		checkOffsetEqual(t, "ShimPeerConnectionConfig.ContinualGathering", unsafe.Offsetof(goCfg.ContinualGathering), layout.offsets["ContinualGathering"])
+		checkOffsetEqual(t, "ShimPeerConnectionConfig.ICECheckIntervalMs", unsafe.Offsetof(goCfg.ICECheckIntervalMs), layout.offsets["ICECheckIntervalMs"])
+		checkOffsetEqual(t, "ShimPeerConnectionConfig.ICECheckMinIntervalMs", unsafe.Offsetof(goCfg.ICECheckMinIntervalMs), layout.offsets["ICECheckMinIntervalMs"])
+		checkOffsetEqual(t, "ShimPeerConnectionConfig.NetworkController", unsafe.Offsetof(goCfg.NetworkController), layout.offsets["NetworkController"])
+		checkOffsetEqual(t, "ShimPeerConnectionConfig.StartBitrateBps", unsafe.Offsetof(goCfg.StartBitrateBps), layout.offsets["StartBitrateBps"])
+		checkOffsetEqual(t, "ShimPeerConnectionConfig.MinBitrateBps", unsafe.Offsetof(goCfg.MinBitrateBps), layout.offsets["MinBitrateBps"])
+		checkOffsetEqual(t, "ShimPeerConnectionConfig.MaxBitrateBps", unsafe.Offsetof(goCfg.MaxBitrateBps), layout.offsets["MaxBitrateBps"])
+		checkOffsetEqual(t, "ShimPeerConnectionConfig.DisableProbing", unsafe.Offsetof(goCfg.DisableProbing), layout.offsets["DisableProbing"])
+	})
+
+	t.Run("ShimPeerConnectionCreateAnswerAsyncParams", func(t *testing.T) {
+		var goCfg shimPeerConnectionCreateAnswerAsyncParams
+		layout := cShimPeerConnectionCreateAnswerAsyncParamsLayout()
+		checkSizeEqual(t, "ShimPeerConnectionCreateAnswerAsyncParams", unsafe.Sizeof(goCfg), layout.size)
+		checkOffsetEqual(t, "ShimPeerConnectionCreateAnswerAsyncParams.PC", unsafe.Offsetof(goCfg.PC), layout.offsets["PC"])
+		checkOffsetEqual(t, "ShimPeerConnectionCreateAnswerAsyncParams.VoiceActivityDetection", unsafe.Offsetof(goCfg.VoiceActivityDetection), layout.offsets["VoiceActivityDetection"])
+		checkOffsetEqual(t, "ShimPeerConnectionCreateAnswerAsyncParams.Callback", unsafe.Offsetof(goCfg.Callback), layout.offsets["Callback"])
+		checkOffsetEqual(t, "ShimPeerConnectionCreateAnswerAsyncParams.Ctx", unsafe.Offsetof(goCfg.Ctx), layout.offsets["Ctx"])
+		checkOffsetEqual(t, "ShimPeerConnectionCreateAnswerAsyncParams.ErrorOut", unsafe.Offsetof(goCfg.ErrorOut), layout.offsets["ErrorOut"])
 	})
 
 	t.Run("ShimPeerConnectionCreateAnswerParams", func(t *testing.T) {
@@ -359,6 +538,7 @@ func TestShimStructLayoutCgo(t *testing.T) {
 		layout := cShimPeerConnectionCreateAnswerParamsLayout()
 		checkSizeEqual(t, "ShimPeerConnectionCreateAnswerParams", unsafe.Sizeof(goCfg), layout.size)
 		checkOffsetEqual(t, "ShimPeerConnectionCreateAnswerParams.PC", unsafe.Offsetof(goCfg.PC), layout.offsets["PC"])
+		checkOffsetEqual(t, "ShimPeerConnectionCreateAnswerParams.VoiceActivityDetection", unsafe.Offsetof(goCfg.VoiceActivityDetection), layout.offsets["VoiceActivityDetection"])
 		checkOffsetEqual(t, "ShimPeerConnectionCreateAnswerParams.SDPOut", unsafe.Offsetof(goCfg.SDPOut), layout.offsets["SDPOut"])
 		checkOffsetEqual(t, "ShimPeerConnectionCreateAnswerParams.SDPOutSize", unsafe.Offsetof(goCfg.SDPOutSize), layout.offsets["SDPOutSize"])
 		checkOffsetEqual(t, "ShimPeerConnectionCreateAnswerParams.OutSDPLen", unsafe.Offsetof(goCfg.OutSDPLen), layout.offsets["OutSDPLen"])
@@ -377,11 +557,25 @@ func TestShimStructLayoutCgo(t *testing.T) {
 		checkOffsetEqual(t, "ShimPeerConnectionCreateDataChannelParams.ErrorOut", unsafe.Offsetof(goCfg.ErrorOut), layout.offsets["ErrorOut"])
 	})
 
+	t.Run("ShimPeerConnectionCreateOfferAsyncParams", func(t *testing.T) {
+		var goCfg shimPeerConnectionCreateOfferAsyncParams
+		layout := cShimPeerConnectionCreateOfferAsyncParamsLayout()
+		checkSizeEqual(t, "ShimPeerConnectionCreateOfferAsyncParams", unsafe.Sizeof(goCfg), layout.size)
+		checkOffsetEqual(t, "ShimPeerConnectionCreateOfferAsyncParams.PC", unsafe.Offsetof(goCfg.PC), layout.offsets["PC"])
+		checkOffsetEqual(t, "ShimPeerConnectionCreateOfferAsyncParams.ICERestart", unsafe.Offsetof(goCfg.ICERestart), layout.offsets["ICERestart"])
+		checkOffsetEqual(t, "ShimPeerConnectionCreateOfferAsyncParams.VoiceActivityDetection", unsafe.Offsetof(goCfg.VoiceActivityDetection), layout.offsets["VoiceActivityDetection"])
+		checkOffsetEqual(t, "ShimPeerConnectionCreateOfferAsyncParams.Callback", unsafe.Offsetof(goCfg.Callback), layout.offsets["Callback"])
+		checkOffsetEqual(t, "ShimPeerConnectionCreateOfferAsyncParams.Ctx", unsafe.Offsetof(goCfg.Ctx), layout.offsets["Ctx"])
+		checkOffsetEqual(t, "ShimPeerConnectionCreateOfferAsyncParams.ErrorOut", unsafe.Offsetof(goCfg.ErrorOut), layout.offsets["ErrorOut"])
+	})
+
 	t.Run("ShimPeerConnectionCreateOfferParams", func(t *testing.T) {
 		var goCfg shimPeerConnectionCreateOfferParams
 		layout := cShimPeerConnectionCreateOfferParamsLayout()
 		checkSizeEqual(t, "ShimPeerConnectionCreateOfferParams", unsafe.Sizeof(goCfg), layout.size)
 		checkOffsetEqual(t, "ShimPeerConnectionCreateOfferParams.PC", unsafe.Offsetof(goCfg.PC), layout.offsets["PC"])
+		checkOffsetEqual(t, "ShimPeerConnectionCreateOfferParams.ICERestart", unsafe.Offsetof(goCfg.ICERestart), layout.offsets["ICERestart"])
+		checkOffsetEqual(t, "ShimPeerConnectionCreateOfferParams.VoiceActivityDetection", unsafe.Offsetof(goCfg.VoiceActivityDetection), layout.offsets["VoiceActivityDetection"])
 		checkOffsetEqual(t, "ShimPeerConnectionCreateOfferParams.SDPOut", unsafe.Offsetof(goCfg.SDPOut), layout.offsets["SDPOut"])
 		checkOffsetEqual(t, "ShimPeerConnectionCreateOfferParams.SDPOutSize", unsafe.Offsetof(goCfg.SDPOutSize), layout.offsets["SDPOutSize"])
 		checkOffsetEqual(t, "ShimPeerConnectionCreateOfferParams.OutSDPLen", unsafe.Offsetof(goCfg.OutSDPLen), layout.offsets["OutSDPLen"])
@@ -393,9 +587,31 @@ func TestShimStructLayoutCgo(t *testing.T) {
 		layout := cShimPeerConnectionCreateParamsLayout()
 		checkSizeEqual(t, "ShimPeerConnectionCreateParams", unsafe.Sizeof(goCfg), layout.size)
 		checkOffsetEqual(t, "ShimPeerConnectionCreateParams.Config", unsafe.Offsetof(goCfg.Config), layout.offsets["Config"])
+		checkOffsetEqual(t, "ShimPeerConnectionCreateParams.Factory", unsafe.Offsetof(goCfg.Factory), layout.offsets["Factory"])
 		checkOffsetEqual(t, "ShimPeerConnectionCreateParams.ErrorOut", unsafe.Offsetof(goCfg.ErrorOut), layout.offsets["ErrorOut"])
 	})
 
+	t.Run("ShimPeerConnectionFactoryConfig", func(t *testing.T) {
+		var goCfg PeerConnectionFactoryConfig
+		layout := cShimPeerConnectionFactoryConfigLayout()
+		checkSizeEqual(t, "ShimPeerConnectionFactoryConfig", unsafe.Sizeof(goCfg), layout.size)
+		checkOffsetEqual(t, "ShimPeerConnectionFactoryConfig.VideoCodecFactory", unsafe.Offsetof(goCfg.VideoCodecFactory), layout.offsets["VideoCodecFactory"])
+		checkOffsetEqual(t, "ShimPeerConnectionFactoryConfig.DisableAudioDevice", unsafe.Offsetof(goCfg.DisableAudioDevice), layout.offsets["DisableAudioDevice"])
+		checkOffsetEqual(t, "ShimPeerConnectionFactoryConfig.DisableAudioProcessing", unsafe.Offsetof(goCfg.DisableAudioProcessing), layout.offsets["DisableAudioProcessing"])
+		checkOffsetEqual(t, "ShimPeerConnectionFactoryConfig.UDPMuxPort", unsafe.Offsetof(goCfg.UDPMuxPort), layout.offsets["UDPMuxPort"])
+		checkOffsetEqual(t, "ShimPeerConnectionFactoryConfig.UDPMuxAddress", unsafe.Offsetof(goCfg.UDPMuxAddress), layout.offsets["UDPMuxAddress"])
+		checkOffsetEqual(t, "ShimPeerConnectionFactoryConfig.LoopbackNetwork", unsafe.Offsetof(goCfg.LoopbackNetwork), layout.offsets["LoopbackNetwork"])
+		checkOffsetEqual(t, "ShimPeerConnectionFactoryConfig.DisableVideoDecoding", unsafe.Offsetof(goCfg.DisableVideoDecoding), layout.offsets["DisableVideoDecoding"])
+	})
+
+	t.Run("ShimPeerConnectionFactoryCreateParams", func(t *testing.T) {
+		var goCfg shimPeerConnectionFactoryCreateParams
+		layout := cShimPeerConnectionFactoryCreateParamsLayout()
+		checkSizeEqual(t, "ShimPeerConnectionFactoryCreateParams", unsafe.Sizeof(goCfg), layout.size)
+		checkOffsetEqual(t, "ShimPeerConnectionFactoryCreateParams.Config", unsafe.Offsetof(goCfg.Config), layout.offsets["Config"])
+		checkOffsetEqual(t, "ShimPeerConnectionFactoryCreateParams.ErrorOut", unsafe.Offsetof(goCfg.ErrorOut), layout.offsets["ErrorOut"])
+	})
+
 	t.Run("ShimPeerConnectionGetBandwidthEstimateParams", func(t *testing.T) {
 		var goCfg shimPeerConnectionGetBandwidthEstimateParams
 		layout := cShimPeerConnectionGetBandwidthEstimateParamsLayout()
@@ -432,6 +648,21 @@ func TestShimStructLayoutCgo(t *testing.T) {
 		checkOffsetEqual(t, "ShimPeerConnectionGetStatsParams.OutStats", unsafe.Offsetof(goCfg.OutStats), layout.offsets["OutStats"])
 	})
 
+	t.Run("ShimPeerConnectionGetStreamStatsParams", func(t *testing.T) {
+		var goCfg shimPeerConnectionGetStreamStatsParams
+		layout := cShimPeerConnectionGetStreamStatsParamsLayout()
+		checkSizeEqual(t, "ShimPeerConnectionGetStreamStatsParams", unsafe.Sizeof(goCfg), layout.size)
+		checkOffsetEqual(t, "ShimPeerConnectionGetStreamStatsParams.PC", unsafe.Offsetof(goCfg.PC), layout.offsets["PC"])
+		checkOffsetEqual(t, "ShimPeerConnectionGetStreamStatsParams.Sender", unsafe.Offsetof(goCfg.Sender), layout.offsets["Sender"])
+		checkOffsetEqual(t, "ShimPeerConnectionGetStreamStatsParams.Receiver", unsafe.Offsetof(goCfg.Receiver), layout.offsets["Receiver"])
+		checkOffsetEqual(t, "ShimPeerConnectionGetStreamStatsParams.Flags", unsafe.Offsetof(goCfg.Flags), layout.offsets["Flags"])
+		checkOffsetEqual(t, "ShimPeerConnectionGetStreamStatsParams.Streams", unsafe.Offsetof(goCfg.Streams), layout.offsets["Streams"])
+		checkOffsetEqual(t, "ShimPeerConnectionGetStreamStatsParams.MaxStreams", unsafe.Offsetof(goCfg.MaxStreams), layout.offsets["MaxStreams"])
+		checkOffsetEqual(t, "ShimPeerConnectionGetStreamStatsParams.OutCount", unsafe.Offsetof(goCfg.OutCount), layout.offsets["OutCount"])
+		checkOffsetEqual(t, "ShimPeerConnectionGetStreamStatsParams.OutTotal", unsafe.Offsetof(goCfg.OutTotal), layout.offsets["OutTotal"])
+		checkOffsetEqual(t, "ShimPeerConnectionGetStreamStatsParams.ErrorOut", unsafe.Offsetof(goCfg.ErrorOut), layout.offsets["ErrorOut"])
+	})
+
 	t.Run("ShimPeerConnectionGetTransceiversParams", func(t *testing.T) {
 		var goCfg shimPeerConnectionGetTransceiversParams
 		layout := cShimPeerConnectionGetTransceiversParamsLayout()
@@ -442,6 +673,19 @@ func TestShimStructLayoutCgo(t *testing.T) {
 		checkOffsetEqual(t, "ShimPeerConnectionGetTransceiversParams.OutCount", unsafe.Offsetof(goCfg.OutCount), layout.offsets["OutCount"])
 	})
 
+	t.Run("ShimPeerConnectionPoolCreateParams", func(t *testing.T) {
+		var goCfg shimPeerConnectionPoolCreateParams
+		layout := cShimPeerConnectionPoolCreateParamsLayout()
+		checkSizeEqual(t, "ShimPeerConnectionPoolCreateParams", unsafe.Sizeof(goCfg), layout.size)
+		checkOffsetEqual(t, "ShimPeerConnectionPoolCreateParams.Config", unsafe.Offsetof(goCfg.Config), layout.offsets["Config"])
+		checkOffsetEqual(t, "ShimPeerConnectionPoolCreateParams.Factory", unsafe.Offsetof(goCfg.Factory), layout.offsets["Factory"])
+		checkOffsetEqual(t, "ShimPeerConnectionPoolCreateParams.TargetSize", unsafe.Offsetof(goCfg.TargetSize), layout.offsets["TargetSize"])
+		checkOffsetEqual(t, "ShimPeerConnectionPoolCreateParams.AudioTransceivers", unsafe.Offsetof(goCfg.AudioTransceivers), layout.offsets["AudioTransceivers"])
+		checkOffsetEqual(t, "ShimPeerConnectionPoolCreateParams.VideoTransceivers", unsafe.Offsetof(goCfg.VideoTransceivers), layout.offsets["VideoTransceivers"])
+		checkOffsetEqual(t, "ShimPeerConnectionPoolCreateParams.TransceiverDirection", unsafe.Offsetof(goCfg.TransceiverDirection), layout.offsets["TransceiverDirection"])
+		checkOffsetEqual(t, "ShimPeerConnectionPoolCreateParams.ErrorOut", unsafe.Offsetof(goCfg.ErrorOut), layout.offsets["ErrorOut"])
+	})
+
 	t.Run("ShimPeerConnectionRemoveTrackParams", func(t *testing.T) {
 		var goCfg shimPeerConnectionRemoveTrackParams
 		layout := cShimPeerConnectionRemoveTrackParamsLayout()
@@ -451,6 +695,27 @@ func TestShimStructLayoutCgo(t *testing.T) {
 		checkOffsetEqual(t, "ShimPeerConnectionRemoveTrackParams.ErrorOut", unsafe.Offsetof(goCfg.ErrorOut), layout.offsets["ErrorOut"])
 	})
 
+	t.Run("ShimPeerConnectionSetEventQueueParams", func(t *testing.T) {
+		var goCfg shimPeerConnectionSetEventQueueParams
+		layout := cShimPeerConnectionSetEventQueueParamsLayout()
+		checkSizeEqual(t, "ShimPeerConnectionSetEventQueueParams", unsafe.Sizeof(goCfg), layout.size)
+		checkOffsetEqual(t, "ShimPeerConnectionSetEventQueueParams.PC", unsafe.Offsetof(goCfg.PC), layout.offsets["PC"])
+		checkOffsetEqual(t, "ShimPeerConnectionSetEventQueueParams.Queue", unsafe.Offsetof(goCfg.Queue), layout.offsets["Queue"])
+		checkOffsetEqual(t, "ShimPeerConnectionSetEventQueueParams.Tag", unsafe.Offsetof(goCfg.Tag), layout.offsets["Tag"])
+	})
+
+	t.Run("ShimPeerConnectionSetLocalDescriptionAsyncParams", func(t *testing.T) {
+		var goCfg shimPeerConnectionSetLocalDescriptionAsyncParams
+		layout := cShimPeerConnectionSetLocalDescriptionAsyncParamsLayout()
+		checkSizeEqual(t, "ShimPeerConnectionSetLocalDescriptionAsyncParams", unsafe.Sizeof(goCfg), layout.size)
+		checkOffsetEqual(t, "ShimPeerConnectionSetLocalDescriptionAsyncParams.PC", unsafe.Offsetof(goCfg.PC), layout.offsets["PC"])
+		checkOffsetEqual(t, "ShimPeerConnectionSetLocalDescriptionAsyncParams.Type", unsafe.Offsetof(goCfg.Type), layout.offsets["Type"])
+		checkOffsetEqual(t, "ShimPeerConnectionSetLocalDescriptionAsyncParams.SDP", unsafe.Offsetof(goCfg.SDP), layout.offsets["SDP"])
+		checkOffsetEqual(t, "ShimPeerConnectionSetLocalDescriptionAsyncParams.Callback", unsafe.Offsetof(goCfg.Callback), layout.offsets["Callback"])
+		checkOffsetEqual(t, "ShimPeerConnectionSetLocalDescriptionAsyncParams.Ctx", unsafe.Offsetof(goCfg.Ctx), layout.offsets["Ctx"])
+		checkOffsetEqual(t, "ShimPeerConnectionSetLocalDescriptionAsyncParams.ErrorOut", unsafe.Offsetof(goCfg.ErrorOut), layout.offsets["ErrorOut"])
+	})
+
 	t.Run("ShimPeerConnectionSetLocalDescriptionParams", func(t *testing.T) {
 		var goCfg shimPeerConnectionSetLocalDescriptionParams
 		layout := cShimPeerConnectionSetLocalDescriptionParamsLayout()
@@ -542,6 +807,28 @@ func TestShimStructLayoutCgo(t *testing.T) {
 		checkOffsetEqual(t, "ShimPeerConnectionSetOnTrackParams.Ctx", unsafe.Offsetof(goCfg.Ctx), layout.offsets["Ctx"])
 	})
 
+	t.Run("ShimPeerConnectionSetOnTransportFeedbackParams", func(t *testing.T) {
+		var goCfg shimPeerConnectionSetOnTransportFeedbackParams
+		layout := cShimPeerConnectionSetOnTransportFeedbackParamsLayout()
+		checkSizeEqual(t, "ShimPeerConnectionSetOnTransportFeedbackParams", unsafe.Sizeof(goCfg), layout.size)
+		checkOffsetEqual(t, "ShimPeerConnectionSetOnTransportFeedbackParams.PC", unsafe.Offsetof(goCfg.PC), layout.offsets["PC"])
+		checkOffsetEqual(t, "ShimPeerConnectionSetOnTransportFeedbackParams.Callback", unsafe.Offsetof(goCfg.Callback), layout.offsets["Callback"])
+		checkOffsetEqual(t, "ShimPeerConnectionSetOnTransportFeedbackParams.Ctx", unsafe.Offsetof(goCfg.Ctx), layout.offsets["Ctx"])
+		checkOffsetEqual(t, "ShimPeerConnectionSetOnTransportFeedbackParams.IntervalMs", unsafe.Offsetof(goCfg.IntervalMs), layout.offsets["IntervalMs"])
+	})
+
+	t.Run("ShimPeerConnectionSetRemoteDescriptionAsyncParams", func(t *testing.T) {
+		var goCfg shimPeerConnectionSetRemoteDescriptionAsyncParams
+		layout := cShimPeerConnectionSetRemoteDescriptionAsyncParamsLayout()
+		checkSizeEqual(t, "ShimPeerConnectionSetRemoteDescriptionAsyncParams", unsafe.Sizeof(goCfg), layout.size)
+		checkOffsetEqual(t, "ShimPeerConnectionSetRemoteDescriptionAsyncParams.PC", unsafe.Offsetof(goCfg.PC), layout.offsets["PC"])
+		checkOffsetEqual(t, "ShimPeerConnectionSetRemoteDescriptionAsyncParams.Type", unsafe.Offsetof(goCfg.Type), layout.offsets["Type"])
+		checkOffsetEqual(t, "ShimPeerConnectionSetRemoteDescriptionAsyncParams.SDP", unsafe.Offsetof(goCfg.SDP), layout.offsets["SDP"])
+		checkOffsetEqual(t, "ShimPeerConnectionSetRemoteDescriptionAsyncParams.Callback", unsafe.Offsetof(goCfg.Callback), layout.offsets["Callback"])
+		checkOffsetEqual(t, "ShimPeerConnectionSetRemoteDescriptionAsyncParams.Ctx", unsafe.Offsetof(goCfg.Ctx), layout.offsets["Ctx"])
+		checkOffsetEqual(t, "ShimPeerConnectionSetRemoteDescriptionAsyncParams.ErrorOut", unsafe.Offsetof(goCfg.ErrorOut), layout.offsets["ErrorOut"])
+	})
+
 	t.Run("ShimPeerConnectionSetRemoteDescriptionParams", func(t *testing.T) {
 		var goCfg shimPeerConnectionSetRemoteDescriptionParams
 		layout := cShimPeerConnectionSetRemoteDescriptionParamsLayout()
@@ -552,6 +839,18 @@ func TestShimStructLayoutCgo(t *testing.T) {
 		checkOffsetEqual(t, "ShimPeerConnectionSetRemoteDescriptionParams.ErrorOut", unsafe.Offsetof(goCfg.ErrorOut), layout.offsets["ErrorOut"])
 	})
 
+	t.Run("ShimRTCPFeedback", func(t *testing.T) {
+		var goCfg RTCPFeedback
+		layout := cShimRTCPFeedbackLayout()
+		checkSizeEqual(t, "ShimRTCPFeedback", unsafe.Sizeof(goCfg), layout.size)
+		checkOffsetEqual(t, "ShimRTCPFeedback.Type", unsafe.Offsetof(goCfg.Type), layout.offsets["Type"])
+		checkOffsetEqual(t, "ShimRTCPFeedback.SSRC", unsafe.Offsetof(goCfg.SSRC), layout.offsets["SSRC"])
+		checkOffsetEqual(t, "ShimRTCPFeedback.Count", unsafe.Offsetof(goCfg.Count), layout.offsets["Count"])
+		checkOffsetEqual(t, "ShimRTCPFeedback.Lost", unsafe.Offsetof(goCfg.Lost), layout.offsets["Lost"])
+		checkOffsetEqual(t, "ShimRTCPFeedback.BitrateBps", unsafe.Offsetof(goCfg.BitrateBps), layout.offsets["BitrateBps"])
+		checkOffsetEqual(t, "ShimRTCPFeedback.TimestampUs", unsafe.Offsetof(goCfg.TimestampUs), layout.offsets["TimestampUs"])
+	})
+
 	t.Run("ShimRTCStats", func(t *testing.T) {
 		var goCfg RTCStats
 		layout := cShimRTCStatsLayout()
@@ -615,10 +914,20 @@ func TestShimStructLayoutCgo(t *testing.T) {
 		var goCfg shimRTPReceiverGetStatsParams
 		layout := cShimRTPReceiverGetStatsParamsLayout()
 		checkSizeEqual(t, "ShimRTPReceiverGetStatsParams", unsafe.Sizeof(goCfg), layout.size)
+		checkOffsetEqual(t, "ShimRTPReceiverGetStatsParams.PC", unsafe.Offsetof(goCfg.PC), layout.offsets["PC"])
 		checkOffsetEqual(t, "ShimRTPReceiverGetStatsParams.Receiver", unsafe.Offsetof(goCfg.Receiver), layout.offsets["Receiver"])
 		checkOffsetEqual(t, "ShimRTPReceiverGetStatsParams.OutStats", unsafe.Offsetof(goCfg.OutStats), layout.offsets["OutStats"])
 	})
 
+	t.Run("ShimRTPReceiverSetEncodedFrameEventQueueParams", func(t *testing.T) {
+		var goCfg shimRTPReceiverSetEncodedFrameEventQueueParams
+		layout := cShimRTPReceiverSetEncodedFrameEventQueueParamsLayout()
+		checkSizeEqual(t, "ShimRTPReceiverSetEncodedFrameEventQueueParams", unsafe.Sizeof(goCfg), layout.size)
+		checkOffsetEqual(t, "ShimRTPReceiverSetEncodedFrameEventQueueParams.Receiver", unsafe.Offsetof(goCfg.Receiver), layout.offsets["Receiver"])
+		checkOffsetEqual(t, "ShimRTPReceiverSetEncodedFrameEventQueueParams.Queue", unsafe.Offsetof(goCfg.Queue), layout.offsets["Queue"])
+		checkOffsetEqual(t, "ShimRTPReceiverSetEncodedFrameEventQueueParams.Tag", unsafe.Offsetof(goCfg.Tag), layout.offsets["Tag"])
+	})
+
 	t.Run("ShimRTPReceiverSetJitterBufferMinDelayParams", func(t *testing.T) {
 		var goCfg shimRTPReceiverSetJitterBufferMinDelayParams
 		layout := cShimRTPReceiverSetJitterBufferMinDelayParamsLayout()
@@ -627,6 +936,15 @@ func TestShimStructLayoutCgo(t *testing.T) {
 		checkOffsetEqual(t, "ShimRTPReceiverSetJitterBufferMinDelayParams.MinDelayMs", unsafe.Offsetof(goCfg.MinDelayMs), layout.offsets["MinDelayMs"])
 	})
 
+	t.Run("ShimRTPReceiverSetOnEncodedFrameParams", func(t *testing.T) {
+		var goCfg shimRTPReceiverSetOnEncodedFrameParams
+		layout := cShimRTPReceiverSetOnEncodedFrameParamsLayout()
+		checkSizeEqual(t, "ShimRTPReceiverSetOnEncodedFrameParams", unsafe.Sizeof(goCfg), layout.size)
+		checkOffsetEqual(t, "ShimRTPReceiverSetOnEncodedFrameParams.Receiver", unsafe.Offsetof(goCfg.Receiver), layout.offsets["Receiver"])
+		checkOffsetEqual(t, "ShimRTPReceiverSetOnEncodedFrameParams.Callback", unsafe.Offsetof(goCfg.Callback), layout.offsets["Callback"])
+		checkOffsetEqual(t, "ShimRTPReceiverSetOnEncodedFrameParams.Ctx", unsafe.Offsetof(goCfg.Ctx), layout.offsets["Ctx"])
+	})
+
 	t.Run("ShimRTPSendParameters", func(t *testing.T) {
 		var goCfg RTPSendParameters
 		layout := cShimRTPSendParametersLayout()
@@ -678,6 +996,7 @@ func TestShimStructLayoutCgo(t *testing.T) {
 		var goCfg shimRTPSenderGetStatsParams
 		layout := cShimRTPSenderGetStatsParamsLayout()
 		checkSizeEqual(t, "ShimRTPSenderGetStatsParams", unsafe.Sizeof(goCfg), layout.size)
+		checkOffsetEqual(t, "ShimRTPSenderGetStatsParams.PC", unsafe.Offsetof(goCfg.PC), layout.offsets["PC"])
 		checkOffsetEqual(t, "ShimRTPSenderGetStatsParams.Sender", unsafe.Offsetof(goCfg.Sender), layout.offsets["Sender"])
 		checkOffsetEqual(t, "ShimRTPSenderGetStatsParams.OutStats", unsafe.Offsetof(goCfg.OutStats), layout.offsets["OutStats"])
 	})
@@ -723,9 +1042,11 @@ func TestShimStructLayoutCgo(t *testing.T) {
 		var goCfg shimRTPSenderSetOnRTCPFeedbackParams
 		layout := cShimRTPSenderSetOnRTCPFeedbackParamsLayout()
 		checkSizeEqual(t, "ShimRTPSenderSetOnRTCPFeedbackParams", unsafe.Sizeof(goCfg), layout.size)
+		checkOffsetEqual(t, "ShimRTPSenderSetOnRTCPFeedbackParams.PC", unsafe.Offsetof(goCfg.PC), layout.offsets["PC"])
 		checkOffsetEqual(t, "ShimRTPSenderSetOnRTCPFeedbackParams.Sender", unsafe.Offsetof(goCfg.Sender), layout.offsets["Sender"])
 		checkOffsetEqual(t, "ShimRTPSenderSetOnRTCPFeedbackParams.Callback", unsafe.Offsetof(goCfg.Callback), layout.offsets["Callback"])
 		checkOffsetEqual(t, "ShimRTPSenderSetOnRTCPFeedbackParams.Ctx", unsafe.Offsetof(goCfg.Ctx), layout.offsets["Ctx"])
+		checkOffsetEqual(t, "ShimRTPSenderSetOnRTCPFeedbackParams.IntervalMs", unsafe.Offsetof(goCfg.IntervalMs), layout.offsets["IntervalMs"])
 	})
 
 	t.Run("ShimRTPSenderSetParametersParams", func(t *testing.T) {
@@ -747,6 +1068,17 @@ func TestShimStructLayoutCgo(t *testing.T) {
 		checkOffsetEqual(t, "ShimRTPSenderSetPreferredCodecParams.ErrorOut", unsafe.Offsetof(goCfg.ErrorOut), layout.offsets["ErrorOut"])
 	})
 
+	t.Run("ShimRTPSenderSetRTCPFeedbackEventQueueParams", func(t *testing.T) {
+		var goCfg shimRTPSenderSetRTCPFeedbackEventQueueParams
+		layout := cShimRTPSenderSetRTCPFeedbackEventQueueParamsLayout()
+		checkSizeEqual(t, "ShimRTPSenderSetRTCPFeedbackEventQueueParams", unsafe.Sizeof(goCfg), layout.size)
+		checkOffsetEqual(t, "ShimRTPSenderSetRTCPFeedbackEventQueueParams.PC", unsafe.Offsetof(goCfg.PC), layout.offsets["PC"])
+		checkOffsetEqual(t, "ShimRTPSenderSetRTCPFeedbackEventQueueParams.Sender", unsafe.Offsetof(goCfg.Sender), layout.offsets["Sender"])
+		checkOffsetEqual(t, "ShimRTPSenderSetRTCPFeedbackEventQueueParams.Queue", unsafe.Offsetof(goCfg.Queue), layout.offsets["Queue"])
+		checkOffsetEqual(t, "ShimRTPSenderSetRTCPFeedbackEventQueueParams.Tag", unsafe.Offsetof(goCfg.Tag), layout.offsets["Tag"])
+		checkOffsetEqual(t, "ShimRTPSenderSetRTCPFeedbackEventQueueParams.IntervalMs", unsafe.Offsetof(goCfg.IntervalMs), layout.offsets["IntervalMs"])
+	})
+
 	t.Run("ShimRTPSenderSetScalabilityModeParams", func(t *testing.T) {
 		var goCfg shimRTPSenderSetScalabilityModeParams
 		layout := cShimRTPSenderSetScalabilityModeParamsLayout()
@@ -756,6 +1088,31 @@ func TestShimStructLayoutCgo(t *testing.T) {
 		checkOffsetEqual(t, "ShimRTPSenderSetScalabilityModeParams.ErrorOut", unsafe.Offsetof(goCfg.ErrorOut), layout.offsets["ErrorOut"])
 	})
 
+	t.Run("ShimSRTPBatchParams", func(t *testing.T) {
+		var goCfg shimSRTPBatchParams
+		layout := cShimSRTPBatchParamsLayout()
+		checkSizeEqual(t, "ShimSRTPBatchParams", unsafe.Sizeof(goCfg), layout.size)
+		checkOffsetEqual(t, "ShimSRTPBatchParams.Context", unsafe.Offsetof(goCfg.Context), layout.offsets["Context"])
+		checkOffsetEqual(t, "ShimSRTPBatchParams.Packets", unsafe.Offsetof(goCfg.Packets), layout.offsets["Packets"])
+		checkOffsetEqual(t, "ShimSRTPBatchParams.Sizes", unsafe.Offsetof(goCfg.Sizes), layout.offsets["Sizes"])
+		checkOffsetEqual(t, "ShimSRTPBatchParams.Capacities", unsafe.Offsetof(goCfg.Capacities), layout.offsets["Capacities"])
+		checkOffsetEqual(t, "ShimSRTPBatchParams.Count", unsafe.Offsetof(goCfg.Count), layout.offsets["Count"])
+		checkOffsetEqual(t, "ShimSRTPBatchParams.OutFailed", unsafe.Offsetof(goCfg.OutFailed), layout.offsets["OutFailed"])
+		checkOffsetEqual(t, "ShimSRTPBatchParams.ErrorOut", unsafe.Offsetof(goCfg.ErrorOut), layout.offsets["ErrorOut"])
+	})
+
+	t.Run("ShimSRTPContextCreateParams", func(t *testing.T) {
+		var goCfg shimSRTPContextCreateParams
+		layout := cShimSRTPContextCreateParamsLayout()
+		checkSizeEqual(t, "ShimSRTPContextCreateParams", unsafe.Sizeof(goCfg), layout.size)
+		checkOffsetEqual(t, "ShimSRTPContextCreateParams.Profile", unsafe.Offsetof(goCfg.Profile), layout.offsets["Profile"])
+		checkOffsetEqual(t, "ShimSRTPContextCreateParams.SendKey", unsafe.Offsetof(goCfg.SendKey), layout.offsets["SendKey"])
+		checkOffsetEqual(t, "ShimSRTPContextCreateParams.SendKeyLen", unsafe.Offsetof(goCfg.SendKeyLen), layout.offsets["SendKeyLen"])
+		checkOffsetEqual(t, "ShimSRTPContextCreateParams.RecvKey", unsafe.Offsetof(goCfg.RecvKey), layout.offsets["RecvKey"])
+		checkOffsetEqual(t, "ShimSRTPContextCreateParams.RecvKeyLen", unsafe.Offsetof(goCfg.RecvKeyLen), layout.offsets["RecvKeyLen"])
+		checkOffsetEqual(t, "ShimSRTPContextCreateParams.ErrorOut", unsafe.Offsetof(goCfg.ErrorOut), layout.offsets["ErrorOut"])
+	})
+
 	t.Run("ShimScreenCaptureCreateParams", func(t *testing.T) {
 		var goCfg shimScreenCaptureCreateParams
 		layout := cShimScreenCaptureCreateParamsLayout()
@@ -793,6 +1150,206 @@ func TestShimStructLayoutCgo(t *testing.T) {
 		checkOffsetEqual(t, "ShimSessionDescription.SDP", unsafe.Offsetof(goCfg.SDP), layout.offsets["SDP"])
 	})
 
+	t.Run("ShimSetSocketServerParams", func(t *testing.T) {
+		var goCfg shimSetSocketServerParams
+		layout := cShimSetSocketServerParamsLayout()
+		checkSizeEqual(t, "ShimSetSocketServerParams", unsafe.Sizeof(goCfg), layout.size)
+		checkOffsetEqual(t, "ShimSetSocketServerParams.Type", unsafe.Offsetof(goCfg.Type), layout.offsets["Type"])
+		checkOffsetEqual(t, "ShimSetSocketServerParams.ErrorOut", unsafe.Offsetof(goCfg.ErrorOut), layout.offsets["ErrorOut"])
+	})
+
+	t.Run("ShimSharedVideoEncoderCreateParams", func(t *testing.T) {
+		var goCfg shimSharedVideoEncoderCreateParams
+		layout := cShimSharedVideoEncoderCreateParamsLayout()
+		checkSizeEqual(t, "ShimSharedVideoEncoderCreateParams", unsafe.Sizeof(goCfg), layout.size)
+		checkOffsetEqual(t, "ShimSharedVideoEncoderCreateParams.Codec", unsafe.Offsetof(goCfg.Codec), layout.offsets["Codec"])
+		checkOffsetEqual(t, "ShimSharedVideoEncoderCreateParams.Width", unsafe.Offsetof(goCfg.Width), layout.offsets["Width"])
+		checkOffsetEqual(t, "ShimSharedVideoEncoderCreateParams.Height", unsafe.Offsetof(goCfg.Height), layout.offsets["Height"])
+		checkOffsetEqual(t, "ShimSharedVideoEncoderCreateParams.BitrateBps", unsafe.Offsetof(goCfg.BitrateBps), layout.offsets["BitrateBps"])
+		checkOffsetEqual(t, "ShimSharedVideoEncoderCreateParams.Framerate", unsafe.Offsetof(goCfg.Framerate), layout.offsets["Framerate"])
+		checkOffsetEqual(t, "ShimSharedVideoEncoderCreateParams.TemporalLayers", unsafe.Offsetof(goCfg.TemporalLayers), layout.offsets["TemporalLayers"])
+		checkOffsetEqual(t, "ShimSharedVideoEncoderCreateParams.MinKeyframeIntervalMs", unsafe.Offsetof(goCfg.MinKeyframeIntervalMs), layout.offsets["MinKeyframeIntervalMs"])
+		checkOffsetEqual(t, "ShimSharedVideoEncoderCreateParams.ErrorOut", unsafe.Offsetof(goCfg.ErrorOut), layout.offsets["ErrorOut"])
+	})
+
+	t.Run("ShimSharedVideoEncoderPushFrameParams", func(t *testing.T) {
+		var goCfg shimSharedVideoEncoderPushFrameParams
+		layout := cShimSharedVideoEncoderPushFrameParamsLayout()
+		checkSizeEqual(t, "ShimSharedVideoEncoderPushFrameParams", unsafe.Sizeof(goCfg), layout.size)
+		checkOffsetEqual(t, "ShimSharedVideoEncoderPushFrameParams.Encoder", unsafe.Offsetof(goCfg.Encoder), layout.offsets["Encoder"])
+		checkOffsetEqual(t, "ShimSharedVideoEncoderPushFrameParams.YPlane", unsafe.Offsetof(goCfg.YPlane), layout.offsets["YPlane"])
+		checkOffsetEqual(t, "ShimSharedVideoEncoderPushFrameParams.UPlane", unsafe.Offsetof(goCfg.UPlane), layout.offsets["UPlane"])
+		checkOffsetEqual(t, "ShimSharedVideoEncoderPushFrameParams.VPlane", unsafe.Offsetof(goCfg.VPlane), layout.offsets["VPlane"])
+		checkOffsetEqual(t, "ShimSharedVideoEncoderPushFrameParams.YStride", unsafe.Offsetof(goCfg.YStride), layout.offsets["YStride"])
+		checkOffsetEqual(t, "ShimSharedVideoEncoderPushFrameParams.UStride", unsafe.Offsetof(goCfg.UStride), layout.offsets["UStride"])
+		checkOffsetEqual(t, "ShimSharedVideoEncoderPushFrameParams.VStride", unsafe.Offsetof(goCfg.VStride), layout.offsets["VStride"])
+		checkOffsetEqual(t, "ShimSharedVideoEncoderPushFrameParams.TimestampUs", unsafe.Offsetof(goCfg.TimestampUs), layout.offsets["TimestampUs"])
+		checkOffsetEqual(t, "ShimSharedVideoEncoderPushFrameParams.ErrorOut", unsafe.Offsetof(goCfg.ErrorOut), layout.offsets["ErrorOut"])
+	})
+
+	t.Run("ShimSharedVideoEncoderSetRatesParams", func(t *testing.T) {
+		var goCfg shimSharedVideoEncoderSetRatesParams
+		layout := cShimSharedVideoEncoderSetRatesParamsLayout()
+		checkSizeEqual(t, "ShimSharedVideoEncoderSetRatesParams", unsafe.Sizeof(goCfg), layout.size)
+		checkOffsetEqual(t, "ShimSharedVideoEncoderSetRatesParams.Encoder", unsafe.Offsetof(goCfg.Encoder), layout.offsets["Encoder"])
+		checkOffsetEqual(t, "ShimSharedVideoEncoderSetRatesParams.BitrateBps", unsafe.Offsetof(goCfg.BitrateBps), layout.offsets["BitrateBps"])
+		checkOffsetEqual(t, "ShimSharedVideoEncoderSetRatesParams.Framerate", unsafe.Offsetof(goCfg.Framerate), layout.offsets["Framerate"])
+	})
+
+	t.Run("ShimSharedVideoEncoderSubscribeParams", func(t *testing.T) {
+		var goCfg shimSharedVideoEncoderSubscribeParams
+		layout := cShimSharedVideoEncoderSubscribeParamsLayout()
+		checkSizeEqual(t, "ShimSharedVideoEncoderSubscribeParams", unsafe.Sizeof(goCfg), layout.size)
+		checkOffsetEqual(t, "ShimSharedVideoEncoderSubscribeParams.Encoder", unsafe.Offsetof(goCfg.Encoder), layout.offsets["Encoder"])
+		checkOffsetEqual(t, "ShimSharedVideoEncoderSubscribeParams.MaxTemporalLayer", unsafe.Offsetof(goCfg.MaxTemporalLayer), layout.offsets["MaxTemporalLayer"])
+		checkOffsetEqual(t, "ShimSharedVideoEncoderSubscribeParams.ErrorOut", unsafe.Offsetof(goCfg.ErrorOut), layout.offsets["ErrorOut"])
+	})
+
+	t.Run("ShimSocketServerStats", func(t *testing.T) {
+		var goCfg SocketServerStats
+		layout := cShimSocketServerStatsLayout()
+		checkSizeEqual(t, "ShimSocketServerStats", unsafe.Sizeof(goCfg), layout.size)
+		checkOffsetEqual(t, "ShimSocketServerStats.RecvCalls", unsafe.Offsetof(goCfg.RecvCalls), layout.offsets["RecvCalls"])
+		checkOffsetEqual(t, "ShimSocketServerStats.RecvPackets", unsafe.Offsetof(goCfg.RecvPackets), layout.offsets["RecvPackets"])
+		checkOffsetEqual(t, "ShimSocketServerStats.SendCalls", unsafe.Offsetof(goCfg.SendCalls), layout.offsets["SendCalls"])
+		checkOffsetEqual(t, "ShimSocketServerStats.SendPackets", unsafe.Offsetof(goCfg.SendPackets), layout.offsets["SendPackets"])
+		checkOffsetEqual(t, "ShimSocketServerStats.GSOSends", unsafe.Offsetof(goCfg.GSOSends), layout.offsets["GSOSends"])
+		checkOffsetEqual(t, "ShimSocketServerStats.SendDrops", unsafe.Offsetof(goCfg.SendDrops), layout.offsets["SendDrops"])
+	})
+
+	t.Run("ShimStatsRecord", func(t *testing.T) {
+		var goCfg StatsRecord
+		layout := cShimStatsRecordLayout()
+		checkSizeEqual(t, "ShimStatsRecord", unsafe.Sizeof(goCfg), layout.size)
+		checkOffsetEqual(t, "ShimStatsRecord.Tag", unsafe.Offsetof(goCfg.Tag), layout.offsets["Tag"])
+		checkOffsetEqual(t, "ShimStatsRecord.RoundUs", unsafe.Offsetof(goCfg.RoundUs), layout.offsets["RoundUs"])
+		checkOffsetEqual(t, "ShimStatsRecord.StreamIndex", unsafe.Offsetof(goCfg.StreamIndex), layout.offsets["StreamIndex"])
+		checkOffsetEqual(t, "ShimStatsRecord.StreamCount", unsafe.Offsetof(goCfg.StreamCount), layout.offsets["StreamCount"])
+		checkOffsetEqual(t, "ShimStatsRecord.CurrentRTTMs", unsafe.Offsetof(goCfg.CurrentRTTMs), layout.offsets["CurrentRTTMs"])
+		checkOffsetEqual(t, "ShimStatsRecord.AvailableOutgoingBitrate", unsafe.Offsetof(goCfg.AvailableOutgoingBitrate), layout.offsets["AvailableOutgoingBitrate"])
+		checkOffsetEqual(t, "ShimStatsRecord.AvailableIncomingBitrate", unsafe.Offsetof(goCfg.AvailableIncomingBitrate), layout.offsets["AvailableIncomingBitrate"])
+		checkOffsetEqual(t, "ShimStatsRecord.Stream", unsafe.Offsetof(goCfg.Stream), layout.offsets["Stream"])
+	})
+
+	t.Run("ShimStatsRingCreateParams", func(t *testing.T) {
+		var goCfg shimStatsRingCreateParams
+		layout := cShimStatsRingCreateParamsLayout()
+		checkSizeEqual(t, "ShimStatsRingCreateParams", unsafe.Sizeof(goCfg), layout.size)
+		checkOffsetEqual(t, "ShimStatsRingCreateParams.Capacity", unsafe.Offsetof(goCfg.Capacity), layout.offsets["Capacity"])
+		checkOffsetEqual(t, "ShimStatsRingCreateParams.ErrorOut", unsafe.Offsetof(goCfg.ErrorOut), layout.offsets["ErrorOut"])
+	})
+
+	t.Run("ShimStatsRingHeader", func(t *testing.T) {
+		var goCfg StatsRingHeader
+		layout := cShimStatsRingHeaderLayout()
+		checkSizeEqual(t, "ShimStatsRingHeader", unsafe.Sizeof(goCfg), layout.size)
+		checkOffsetEqual(t, "ShimStatsRingHeader.Capacity", unsafe.Offsetof(goCfg.Capacity), layout.offsets["Capacity"])
+		checkOffsetEqual(t, "ShimStatsRingHeader.RecordSize", unsafe.Offsetof(goCfg.RecordSize), layout.offsets["RecordSize"])
+		checkOffsetEqual(t, "ShimStatsRingHeader.RecordsOffset", unsafe.Offsetof(goCfg.RecordsOffset), layout.offsets["RecordsOffset"])
+		checkOffsetEqual(t, "ShimStatsRingHeader.Reserved", unsafe.Offsetof(goCfg.Reserved), layout.offsets["Reserved"])
+		checkOffsetEqual(t, "ShimStatsRingHeader.WriteSeq", unsafe.Offsetof(goCfg.WriteSeq), layout.offsets["WriteSeq"])
+		checkOffsetEqual(t, "ShimStatsRingHeader.ReadSeq", unsafe.Offsetof(goCfg.ReadSeq), layout.offsets["ReadSeq"])
+		checkOffsetEqual(t, "ShimStatsRingHeader.Dropped", unsafe.Offsetof(goCfg.Dropped), layout.offsets["Dropped"])
+	})
+
+	t.Run("ShimStatsRingSubscribeParams", func(t *testing.T) {
+		var goCfg shimStatsRingSubscribeParams
+		layout := cShimStatsRingSubscribeParamsLayout()
+		checkSizeEqual(t, "ShimStatsRingSubscribeParams", unsafe.Sizeof(goCfg), layout.size)
+		checkOffsetEqual(t, "ShimStatsRingSubscribeParams.Ring", unsafe.Offsetof(goCfg.Ring), layout.offsets["Ring"])
+		checkOffsetEqual(t, "ShimStatsRingSubscribeParams.PC", unsafe.Offsetof(goCfg.PC), layout.offsets["PC"])
+		checkOffsetEqual(t, "ShimStatsRingSubscribeParams.IntervalMs", unsafe.Offsetof(goCfg.IntervalMs), layout.offsets["IntervalMs"])
+		checkOffsetEqual(t, "ShimStatsRingSubscribeParams.Tag", unsafe.Offsetof(goCfg.Tag), layout.offsets["Tag"])
+		checkOffsetEqual(t, "ShimStatsRingSubscribeParams.ErrorOut", unsafe.Offsetof(goCfg.ErrorOut), layout.offsets["ErrorOut"])
+	})
+
+	t.Run("ShimStatsRingUnsubscribeParams", func(t *testing.T) {
+		var goCfg shimStatsRingUnsubscribeParams
+		layout := cShimStatsRingUnsubscribeParamsLayout()
+		checkSizeEqual(t, "ShimStatsRingUnsubscribeParams", unsafe.Sizeof(goCfg), layout.size)
+		checkOffsetEqual(t, "ShimStatsRingUnsubscribeParams.Ring", unsafe.Offsetof(goCfg.Ring), layout.offsets["Ring"])
+		checkOffsetEqual(t, "ShimStatsRingUnsubscribeParams.PC", unsafe.Offsetof(goCfg.PC), layout.offsets["PC"])
+	})
+
+	t.Run("ShimStreamStats", func(t *testing.T) {
+		var goCfg StreamStats
+		layout := cShimStreamStatsLayout()
+		checkSizeEqual(t, "ShimStreamStats", unsafe.Sizeof(goCfg), layout.size)
+		checkOffsetEqual(t, "ShimStreamStats.SSRC", unsafe.Offsetof(goCfg.SSRC), layout.offsets["SSRC"])
+		checkOffsetEqual(t, "ShimStreamStats.Direction", unsafe.Offsetof(goCfg.Direction), layout.offsets["Direction"])
+		checkOffsetEqual(t, "ShimStreamStats.Kind", unsafe.Offsetof(goCfg.Kind), layout.offsets["Kind"])
+		checkOffsetEqual(t, "ShimStreamStats.QualityLimitationReason", unsafe.Offsetof(goCfg.QualityLimitationReason), layout.offsets["QualityLimitationReason"])
+		checkOffsetEqual(t, "ShimStreamStats.Mid", unsafe.Offsetof(goCfg.Mid), layout.offsets["Mid"])
+		checkOffsetEqual(t, "ShimStreamStats.RID", unsafe.Offsetof(goCfg.RID), layout.offsets["RID"])
+		checkOffsetEqual(t, "ShimStreamStats.TimestampUs", unsafe.Offsetof(goCfg.TimestampUs), layout.offsets["TimestampUs"])
+		checkOffsetEqual(t, "ShimStreamStats.Bytes", unsafe.Offsetof(goCfg.Bytes), layout.offsets["Bytes"])
+		checkOffsetEqual(t, "ShimStreamStats.Packets", unsafe.Offsetof(goCfg.Packets), layout.offsets["Packets"])
+		checkOffsetEqual(t, "ShimStreamStats.PacketsLost", unsafe.Offsetof(goCfg.PacketsLost), layout.offsets["PacketsLost"])
+		checkOffsetEqual(t, "ShimStreamStats.RetransmittedBytes", unsafe.Offsetof(goCfg.RetransmittedBytes), layout.offsets["RetransmittedBytes"])
+		checkOffsetEqual(t, "ShimStreamStats.JitterBufferEmittedCount", unsafe.Offsetof(goCfg.JitterBufferEmittedCount), layout.offsets["JitterBufferEmittedCount"])
+		checkOffsetEqual(t, "ShimStreamStats.QPSum", unsafe.Offsetof(goCfg.QPSum), layout.offsets["QPSum"])
+		checkOffsetEqual(t, "ShimStreamStats.JitterMs", unsafe.Offsetof(goCfg.JitterMs), layout.offsets["JitterMs"])
+		checkOffsetEqual(t, "ShimStreamStats.RoundTripTimeMs", unsafe.Offsetof(goCfg.RoundTripTimeMs), layout.offsets["RoundTripTimeMs"])
+		checkOffsetEqual(t, "ShimStreamStats.FractionLost", unsafe.Offsetof(goCfg.FractionLost), layout.offsets["FractionLost"])
+		checkOffsetEqual(t, "ShimStreamStats.TargetBitrateBps", unsafe.Offsetof(goCfg.TargetBitrateBps), layout.offsets["TargetBitrateBps"])
+		checkOffsetEqual(t, "ShimStreamStats.FramesPerSecond", unsafe.Offsetof(goCfg.FramesPerSecond), layout.offsets["FramesPerSecond"])
+		checkOffsetEqual(t, "ShimStreamStats.JitterBufferDelayMs", unsafe.Offsetof(goCfg.JitterBufferDelayMs), layout.offsets["JitterBufferDelayMs"])
+		checkOffsetEqual(t, "ShimStreamStats.AudioLevel", unsafe.Offsetof(goCfg.AudioLevel), layout.offsets["AudioLevel"])
+		checkOffsetEqual(t, "ShimStreamStats.Frames", unsafe.Offsetof(goCfg.Frames), layout.offsets["Frames"])
+		checkOffsetEqual(t, "ShimStreamStats.KeyFrames", unsafe.Offsetof(goCfg.KeyFrames), layout.offsets["KeyFrames"])
+		checkOffsetEqual(t, "ShimStreamStats.FramesDropped", unsafe.Offsetof(goCfg.FramesDropped), layout.offsets["FramesDropped"])
+		checkOffsetEqual(t, "ShimStreamStats.FrameWidth", unsafe.Offsetof(goCfg.FrameWidth), layout.offsets["FrameWidth"])
+		checkOffsetEqual(t, "ShimStreamStats.FrameHeight", unsafe.Offsetof(goCfg.FrameHeight), layout.offsets["FrameHeight"])
+		checkOffsetEqual(t, "ShimStreamStats.NACKCount", unsafe.Offsetof(goCfg.NACKCount), layout.offsets["NACKCount"])
+		checkOffsetEqual(t, "ShimStreamStats.PLICount", unsafe.Offsetof(goCfg.PLICount), layout.offsets["PLICount"])
+		checkOffsetEqual(t, "ShimStreamStats.FIRCount", unsafe.Offsetof(goCfg.FIRCount), layout.offsets["FIRCount"])
+		checkOffsetEqual(t, "ShimStreamStats.IntervalUs", unsafe.Offsetof(goCfg.IntervalUs), layout.offsets["IntervalUs"])
+		checkOffsetEqual(t, "ShimStreamStats.BitrateBps", unsafe.Offsetof(goCfg.BitrateBps), layout.offsets["BitrateBps"])
+		checkOffsetEqual(t, "ShimStreamStats.PacketRate", unsafe.Offsetof(goCfg.PacketRate), layout.offsets["PacketRate"])
+		checkOffsetEqual(t, "ShimStreamStats.IntervalLossRate", unsafe.Offsetof(goCfg.IntervalLossRate), layout.offsets["IntervalLossRate"])
+	})
+
+	t.Run("ShimThreadGroupCreateParams", func(t *testing.T) {
+		var goCfg shimThreadGroupCreateParams
+		layout := cShimThreadGroupCreateParamsLayout()
+		checkSizeEqual(t, "ShimThreadGroupCreateParams", unsafe.Sizeof(goCfg), layout.size)
+		checkOffsetEqual(t, "ShimThreadGroupCreateParams.ShardCount", unsafe.Offsetof(goCfg.ShardCount), layout.offsets["ShardCount"])
+		checkOffsetEqual(t, "ShimThreadGroupCreateParams.FactoryConfig", unsafe.Offsetof(goCfg.FactoryConfig), layout.offsets["FactoryConfig"])
+		checkOffsetEqual(t, "ShimThreadGroupCreateParams.PinThreads", unsafe.Offsetof(goCfg.PinThreads), layout.offsets["PinThreads"])
+		checkOffsetEqual(t, "ShimThreadGroupCreateParams.CPUIDs", unsafe.Offsetof(goCfg.CPUIDs), layout.offsets["CPUIDs"])
+		checkOffsetEqual(t, "ShimThreadGroupCreateParams.CPUIDCount", unsafe.Offsetof(goCfg.CPUIDCount), layout.offsets["CPUIDCount"])
+		checkOffsetEqual(t, "ShimThreadGroupCreateParams.SocketServer", unsafe.Offsetof(goCfg.SocketServer), layout.offsets["SocketServer"])
+		checkOffsetEqual(t, "ShimThreadGroupCreateParams.ErrorOut", unsafe.Offsetof(goCfg.ErrorOut), layout.offsets["ErrorOut"])
+	})
+
+	t.Run("ShimTrackPullVideoFrameParams", func(t *testing.T) {
+		var goCfg shimTrackPullVideoFrameParams
+		layout := cShimTrackPullVideoFrameParamsLayout()
+		checkSizeEqual(t, "ShimTrackPullVideoFrameParams", unsafe.Sizeof(goCfg), layout.size)
+		checkOffsetEqual(t, "ShimTrackPullVideoFrameParams.Track", unsafe.Offsetof(goCfg.Track), layout.offsets["Track"])
+		checkOffsetEqual(t, "ShimTrackPullVideoFrameParams.Frame", unsafe.Offsetof(goCfg.Frame), layout.offsets["Frame"])
+		checkOffsetEqual(t, "ShimTrackPullVideoFrameParams.Width", unsafe.Offsetof(goCfg.Width), layout.offsets["Width"])
+		checkOffsetEqual(t, "ShimTrackPullVideoFrameParams.Height", unsafe.Offsetof(goCfg.Height), layout.offsets["Height"])
+		checkOffsetEqual(t, "ShimTrackPullVideoFrameParams.YPlane", unsafe.Offsetof(goCfg.YPlane), layout.offsets["YPlane"])
+		checkOffsetEqual(t, "ShimTrackPullVideoFrameParams.UPlane", unsafe.Offsetof(goCfg.UPlane), layout.offsets["UPlane"])
+		checkOffsetEqual(t, "ShimTrackPullVideoFrameParams.VPlane", unsafe.Offsetof(goCfg.VPlane), layout.offsets["VPlane"])
+		checkOffsetEqual(t, "ShimTrackPullVideoFrameParams.YStride", unsafe.Offsetof(goCfg.YStride), layout.offsets["YStride"])
+		checkOffsetEqual(t, "ShimTrackPullVideoFrameParams.UStride", unsafe.Offsetof(goCfg.UStride), layout.offsets["UStride"])
+		checkOffsetEqual(t, "ShimTrackPullVideoFrameParams.VStride", unsafe.Offsetof(goCfg.VStride), layout.offsets["VStride"])
+		checkOffsetEqual(t, "ShimTrackPullVideoFrameParams.TimestampUs", unsafe.Offsetof(goCfg.TimestampUs), layout.offsets["TimestampUs"])
+		checkOffsetEqual(t, "ShimTrackPullVideoFrameParams.FramesDropped", unsafe.Offsetof(goCfg.FramesDropped), layout.offsets["FramesDropped"])
+	})
+
+	t.Run("ShimTrackSetAudioSinkFormatParams", func(t *testing.T) {
+		var goCfg shimTrackSetAudioSinkFormatParams
+		layout := cShimTrackSetAudioSinkFormatParamsLayout()
+		checkSizeEqual(t, "ShimTrackSetAudioSinkFormatParams", unsafe.Sizeof(goCfg), layout.size)
+		checkOffsetEqual(t, "ShimTrackSetAudioSinkFormatParams.Track", unsafe.Offsetof(goCfg.Track), layout.offsets["Track"])
+		checkOffsetEqual(t, "ShimTrackSetAudioSinkFormatParams.BatchMs", unsafe.Offsetof(goCfg.BatchMs), layout.offsets["BatchMs"])
+		checkOffsetEqual(t, "ShimTrackSetAudioSinkFormatParams.SampleRate", unsafe.Offsetof(goCfg.SampleRate), layout.offsets["SampleRate"])
+		checkOffsetEqual(t, "ShimTrackSetAudioSinkFormatParams.Channels", unsafe.Offsetof(goCfg.Channels), layout.offsets["Channels"])
+	})
+
 	t.Run("ShimTrackSetAudioSinkParams", func(t *testing.T) {
 		var goCfg shimTrackSetAudioSinkParams
 		layout := cShimTrackSetAudioSinkParamsLayout()
@@ -802,6 +1359,23 @@ func TestShimStructLayoutCgo(t *testing.T) {
 		checkOffsetEqual(t, "ShimTrackSetAudioSinkParams.Ctx", unsafe.Offsetof(goCfg.Ctx), layout.offsets["Ctx"])
 	})
 
+	t.Run("ShimTrackSetEventQueueSinkParams", func(t *testing.T) {
+		var goCfg shimTrackSetEventQueueSinkParams
+		layout := cShimTrackSetEventQueueSinkParamsLayout()
+		checkSizeEqual(t, "ShimTrackSetEventQueueSinkParams", unsafe.Sizeof(goCfg), layout.size)
+		checkOffsetEqual(t, "ShimTrackSetEventQueueSinkParams.Track", unsafe.Offsetof(goCfg.Track), layout.offsets["Track"])
+		checkOffsetEqual(t, "ShimTrackSetEventQueueSinkParams.Queue", unsafe.Offsetof(goCfg.Queue), layout.offsets["Queue"])
+		checkOffsetEqual(t, "ShimTrackSetEventQueueSinkParams.Tag", unsafe.Offsetof(goCfg.Tag), layout.offsets["Tag"])
+	})
+
+	t.Run("ShimTrackSetVideoMailboxParams", func(t *testing.T) {
+		var goCfg shimTrackSetVideoMailboxParams
+		layout := cShimTrackSetVideoMailboxParamsLayout()
+		checkSizeEqual(t, "ShimTrackSetVideoMailboxParams", unsafe.Sizeof(goCfg), layout.size)
+		checkOffsetEqual(t, "ShimTrackSetVideoMailboxParams.Track", unsafe.Offsetof(goCfg.Track), layout.offsets["Track"])
+		checkOffsetEqual(t, "ShimTrackSetVideoMailboxParams.Slots", unsafe.Offsetof(goCfg.Slots), layout.offsets["Slots"])
+	})
+
 	t.Run("ShimTrackSetVideoSinkParams", func(t *testing.T) {
 		var goCfg shimTrackSetVideoSinkParams
 		layout := cShimTrackSetVideoSinkParamsLayout()
@@ -811,6 +1385,16 @@ func TestShimStructLayoutCgo(t *testing.T) {
 		checkOffsetEqual(t, "ShimTrackSetVideoSinkParams.Ctx", unsafe.Offsetof(goCfg.Ctx), layout.offsets["Ctx"])
 	})
 
+	t.Run("ShimTrackSetVideoSinkWantsParams", func(t *testing.T) {
+		var goCfg shimTrackSetVideoSinkWantsParams
+		layout := cShimTrackSetVideoSinkWantsParamsLayout()
+		checkSizeEqual(t, "ShimTrackSetVideoSinkWantsParams", unsafe.Sizeof(goCfg), layout.size)
+		checkOffsetEqual(t, "ShimTrackSetVideoSinkWantsParams.Track", unsafe.Offsetof(goCfg.Track), layout.offsets["Track"])
+		checkOffsetEqual(t, "ShimTrackSetVideoSinkWantsParams.MaxPixelCount", unsafe.Offsetof(goCfg.MaxPixelCount), layout.offsets["MaxPixelCount"])
+		checkOffsetEqual(t, "ShimTrackSetVideoSinkWantsParams.TargetPixelCount", unsafe.Offsetof(goCfg.TargetPixelCount), layout.offsets["TargetPixelCount"])
+		checkOffsetEqual(t, "ShimTrackSetVideoSinkWantsParams.MaxFramerate", unsafe.Offsetof(goCfg.MaxFramerate), layout.offsets["MaxFramerate"])
+	})
+
 	t.Run("ShimTransceiverGetCodecPreferencesParams", func(t *testing.T) {
 		var goCfg shimTransceiverGetCodecPreferencesParams
 		layout := cShimTransceiverGetCodecPreferencesParamsLayout()
@@ -956,6 +1540,48 @@ func TestShimStructLayoutCgo(t *testing.T) {
 		checkOffsetEqual(t, "ShimVideoEncoderSetFramerateParams.ErrorOut", unsafe.Offsetof(goCfg.ErrorOut), layout.offsets["ErrorOut"])
 	})
 
+	t.Run("ShimVideoFrameRingCreateParams", func(t *testing.T) {
+		var goCfg shimVideoFrameRingCreateParams
+		layout := cShimVideoFrameRingCreateParamsLayout()
+		checkSizeEqual(t, "ShimVideoFrameRingCreateParams", unsafe.Sizeof(goCfg), layout.size)
+		checkOffsetEqual(t, "ShimVideoFrameRingCreateParams.Source", unsafe.Offsetof(goCfg.Source), layout.offsets["Source"])
+		checkOffsetEqual(t, "ShimVideoFrameRingCreateParams.Slots", unsafe.Offsetof(goCfg.Slots), layout.offsets["Slots"])
+		checkOffsetEqual(t, "ShimVideoFrameRingCreateParams.ErrorOut", unsafe.Offsetof(goCfg.ErrorOut), layout.offsets["ErrorOut"])
+	})
+
+	t.Run("ShimVideoFrameRingHeader", func(t *testing.T) {
+		var goCfg VideoFrameRingHeader
+		layout := cShimVideoFrameRingHeaderLayout()
+		checkSizeEqual(t, "ShimVideoFrameRingHeader", unsafe.Sizeof(goCfg), layout.size)
+		checkOffsetEqual(t, "ShimVideoFrameRingHeader.SlotCount", unsafe.Offsetof(goCfg.SlotCount), layout.offsets["SlotCount"])
+		checkOffsetEqual(t, "ShimVideoFrameRingHeader.SlotSize", unsafe.Offsetof(goCfg.SlotSize), layout.offsets["SlotSize"])
+		checkOffsetEqual(t, "ShimVideoFrameRingHeader.SlotsOffset", unsafe.Offsetof(goCfg.SlotsOffset), layout.offsets["SlotsOffset"])
+		checkOffsetEqual(t, "ShimVideoFrameRingHeader.Width", unsafe.Offsetof(goCfg.Width), layout.offsets["Width"])
+		checkOffsetEqual(t, "ShimVideoFrameRingHeader.Height", unsafe.Offsetof(goCfg.Height), layout.offsets["Height"])
+		checkOffsetEqual(t, "ShimVideoFrameRingHeader.YStride", unsafe.Offsetof(goCfg.YStride), layout.offsets["YStride"])
+		checkOffsetEqual(t, "ShimVideoFrameRingHeader.UStride", unsafe.Offsetof(goCfg.UStride), layout.offsets["UStride"])
+		checkOffsetEqual(t, "ShimVideoFrameRingHeader.VStride", unsafe.Offsetof(goCfg.VStride), layout.offsets["VStride"])
+		checkOffsetEqual(t, "ShimVideoFrameRingHeader.YOffset", unsafe.Offsetof(goCfg.YOffset), layout.offsets["YOffset"])
+		checkOffsetEqual(t, "ShimVideoFrameRingHeader.UOffset", unsafe.Offsetof(goCfg.UOffset), layout.offsets["UOffset"])
+		checkOffsetEqual(t, "ShimVideoFrameRingHeader.VOffset", unsafe.Offsetof(goCfg.VOffset), layout.offsets["VOffset"])
+		checkOffsetEqual(t, "ShimVideoFrameRingHeader.NotifyFd", unsafe.Offsetof(goCfg.NotifyFd), layout.offsets["NotifyFd"])
+		checkOffsetEqual(t, "ShimVideoFrameRingHeader.Reserved0", unsafe.Offsetof(goCfg.Reserved0), layout.offsets["Reserved0"])
+		checkOffsetEqual(t, "ShimVideoFrameRingHeader.WriteSeq", unsafe.Offsetof(goCfg.WriteSeq), layout.offsets["WriteSeq"])
+		checkOffsetEqual(t, "ShimVideoFrameRingHeader.Reserved1", unsafe.Offsetof(goCfg.Reserved1), layout.offsets["Reserved1"])
+		checkOffsetEqual(t, "ShimVideoFrameRingHeader.ReadSeq", unsafe.Offsetof(goCfg.ReadSeq), layout.offsets["ReadSeq"])
+		checkOffsetEqual(t, "ShimVideoFrameRingHeader.ConsumerWaiting", unsafe.Offsetof(goCfg.ConsumerWaiting), layout.offsets["ConsumerWaiting"])
+		checkOffsetEqual(t, "ShimVideoFrameRingHeader.Reserved2", unsafe.Offsetof(goCfg.Reserved2), layout.offsets["Reserved2"])
+		checkOffsetEqual(t, "ShimVideoFrameRingHeader.Reserved3", unsafe.Offsetof(goCfg.Reserved3), layout.offsets["Reserved3"])
+	})
+
+	t.Run("ShimVideoFrameSlotHeader", func(t *testing.T) {
+		var goCfg VideoFrameSlotHeader
+		layout := cShimVideoFrameSlotHeaderLayout()
+		checkSizeEqual(t, "ShimVideoFrameSlotHeader", unsafe.Sizeof(goCfg), layout.size)
+		checkOffsetEqual(t, "ShimVideoFrameSlotHeader.TimestampUs", unsafe.Offsetof(goCfg.TimestampUs), layout.offsets["TimestampUs"])
+		checkOffsetEqual(t, "ShimVideoFrameSlotHeader.Reserved", unsafe.Offsetof(goCfg.Reserved), layout.offsets["Reserved"])
+	})
+
 	t.Run("ShimVideoTrackSourceCreateParams", func(t *testing.T) {
 		var goCfg shimVideoTrackSourceCreateParams
 		layout := cShimVideoTrackSourceCreateParamsLayout()
@@ -965,6 +1591,15 @@ func TestShimStructLayoutCgo(t *testing.T) {
 		checkOffsetEqual(t, "ShimVideoTrackSourceCreateParams.Height", unsafe.Offsetof(goCfg.Height), layout.offsets["Height"])
 	})
 
+	t.Run("ShimVideoTrackSourceGetPoolStatsParams", func(t *testing.T) {
+		var goCfg shimVideoTrackSourceGetPoolStatsParams
+		layout := cShimVideoTrackSourceGetPoolStatsParamsLayout()
+		checkSizeEqual(t, "ShimVideoTrackSourceGetPoolStatsParams", unsafe.Sizeof(goCfg), layout.size)
+		checkOffsetEqual(t, "ShimVideoTrackSourceGetPoolStatsParams.Source", unsafe.Offsetof(goCfg.Source), layout.offsets["Source"])
+		checkOffsetEqual(t, "ShimVideoTrackSourceGetPoolStatsParams.PoolHits", unsafe.Offsetof(goCfg.PoolHits), layout.offsets["PoolHits"])
+		checkOffsetEqual(t, "ShimVideoTrackSourceGetPoolStatsParams.PoolMisses", unsafe.Offsetof(goCfg.PoolMisses), layout.offsets["PoolMisses"])
+	})
+
 	t.Run("ShimVideoTrackSourcePushFrameParams", func(t *testing.T) {
 		var goCfg shimVideoTrackSourcePushFrameParams
 		layout := cShimVideoTrackSourcePushFrameParamsLayout()
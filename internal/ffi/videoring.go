@@ -0,0 +1,154 @@
+package ffi
+
+import (
+	"fmt"
+	"runtime"
+	"sync/atomic"
+	"unsafe"
+)
+
+// VideoFrameRingHeader matches ShimVideoFrameRingHeader in shim.h.
+type VideoFrameRingHeader struct {
+	SlotCount       uint32
+	SlotSize        uint32
+	SlotsOffset     uint32
+	Width           int32
+	Height          int32
+	YStride         int32
+	UStride         int32
+	VStride         int32
+	YOffset         uint32
+	UOffset         uint32
+	VOffset         uint32
+	NotifyFd        int32
+	Reserved0       [4]uint32
+	WriteSeq        uint64
+	Reserved1       [7]uint64
+	ReadSeq         uint64
+	ConsumerWaiting uint32
+	Reserved2       uint32
+	Reserved3       [6]uint64
+}
+
+// VideoFrameSlotHeader matches ShimVideoFrameSlotHeader in shim.h.
+type VideoFrameSlotHeader struct {
+	TimestampUs int64
+	Reserved    [7]int64
+}
+
+// CreateVideoFrameRing creates a frame ring feeding the video track source
+// (slots rounded up to a power of two; 0 for the default).
+func CreateVideoFrameRing(source uintptr, slots int) (uintptr, error) {
+	if !libLoaded.Load() || shimVideoFrameRingCreate == nil {
+		return 0, ErrLibraryNotLoaded
+	}
+
+	var errBuf ShimErrorBuffer
+	params := shimVideoFrameRingCreateParams{
+		Source:   source,
+		Slots:    int32(slots),
+		ErrorOut: errBuf.Ptr(),
+	}
+	ring := shimVideoFrameRingCreate(uintptr(unsafe.Pointer(&params)))
+	runtime.KeepAlive(&params)
+	if ring == 0 {
+		msg := errBuf.String()
+		if msg != "" {
+			return 0, &ShimErrorWithMessage{Code: ShimErrInitFailed, Message: msg}
+		}
+		return 0, ErrInitFailed
+	}
+	return ring, nil
+}
+
+// VideoFrameRingHeaderPtr returns the address of the ring's shared header.
+func VideoFrameRingHeaderPtr(ring uintptr) uintptr {
+	if !libLoaded.Load() || shimVideoFrameRingHeader == nil || ring == 0 {
+		return 0
+	}
+	return shimVideoFrameRingHeader(ring)
+}
+
+// VideoFrameRingDestroy stops the ring's consumer and frees the ring. The
+// writer must be done with the ring memory.
+func VideoFrameRingDestroy(ring uintptr) {
+	if !libLoaded.Load() || shimVideoFrameRingDestroy == nil || ring == 0 {
+		return
+	}
+	shimVideoFrameRingDestroy(ring)
+}
+
+// VideoFrameRingWriter fills a frame ring's slots directly, without calling
+// into the shim. A ring has a single writer; its methods must not be called
+// concurrently.
+type VideoFrameRingWriter struct {
+	header *VideoFrameRingHeader
+	slots  uintptr
+	mask   uint64
+	slot   uintptr // Slot handed out by Next, 0 if none
+}
+
+// NewVideoFrameRingWriter maps the ring whose header is at headerPtr.
+func NewVideoFrameRingWriter(headerPtr uintptr) (*VideoFrameRingWriter, error) {
+	if headerPtr == 0 {
+		return nil, ErrInitFailed
+	}
+	header := videoFrameRingHeaderAt(headerPtr)
+	if header.SlotCount == 0 || header.SlotCount&(header.SlotCount-1) != 0 {
+		return nil, fmt.Errorf("invalid video frame ring slot count %d", header.SlotCount)
+	}
+	return &VideoFrameRingWriter{
+		header: header,
+		slots:  headerPtr + uintptr(header.SlotsOffset),
+		mask:   uint64(header.SlotCount) - 1,
+	}, nil
+}
+
+//go:nocheckptr
+func videoFrameRingHeaderAt(headerPtr uintptr) *VideoFrameRingHeader {
+	return (*VideoFrameRingHeader)(unsafe.Pointer(headerPtr))
+}
+
+// Header returns the ring's layout.
+func (w *VideoFrameRingWriter) Header() *VideoFrameRingHeader {
+	return w.header
+}
+
+// Next returns the planes of the next free slot, for the caller to fill
+// before Publish. It reports false while every slot is queued or still held
+// by the encoder. Calling Next again before Publish returns the same slot.
+//
+//go:nocheckptr
+func (w *VideoFrameRingWriter) Next() (y, u, v []byte, ok bool) {
+	h := w.header
+	write := atomic.LoadUint64(&h.WriteSeq)
+	if write-atomic.LoadUint64(&h.ReadSeq) > w.mask {
+		return nil, nil, nil, false
+	}
+	w.slot = w.slots + uintptr(write&w.mask)*uintptr(h.SlotSize)
+	chromaHeight := (int(h.Height) + 1) / 2
+	y = unsafe.Slice((*byte)(unsafe.Pointer(w.slot+uintptr(h.YOffset))), int(h.YStride)*int(h.Height))
+	u = unsafe.Slice((*byte)(unsafe.Pointer(w.slot+uintptr(h.UOffset))), int(h.UStride)*chromaHeight)
+	v = unsafe.Slice((*byte)(unsafe.Pointer(w.slot+uintptr(h.VOffset))), int(h.VStride)*chromaHeight)
+	return y, u, v, true
+}
+
+// Publish hands the slot returned by Next to the shim, waking its consumer
+// if it sleeps. It reports false if Next did not hand out a slot.
+//
+//go:nocheckptr
+func (w *VideoFrameRingWriter) Publish(timestampUs int64) bool {
+	if w.slot == 0 {
+		return false
+	}
+	h := w.header
+	(*VideoFrameSlotHeader)(unsafe.Pointer(w.slot)).TimestampUs = timestampUs
+	w.slot = 0
+	atomic.StoreUint64(&h.WriteSeq, atomic.LoadUint64(&h.WriteSeq)+1)
+	// The consumer sets ConsumerWaiting before it checks WriteSeq again, so
+	// either it sees this frame or we see it waiting.
+	if atomic.LoadUint32(&h.ConsumerWaiting) != 0 && atomic.CompareAndSwapUint32(&h.ConsumerWaiting, 1, 0) {
+		notifyVideoFrameRing(int(h.NotifyFd))
+	}
+	return true
+}
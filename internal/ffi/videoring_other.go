@@ -0,0 +1,6 @@
+//go:build !unix
+
+package ffi
+
+// notifyVideoFrameRing is a no-op: without a notify fd the consumer polls.
+func notifyVideoFrameRing(int) {}
@@ -0,0 +1,15 @@
+//go:build unix
+
+package ffi
+
+import "syscall"
+
+// notifyVideoFrameRing wakes a ring consumer sleeping on fd, an eventfd or
+// the write end of a pipe.
+func notifyVideoFrameRing(fd int) {
+	if fd < 0 {
+		return
+	}
+	one := [8]byte{1}
+	_, _ = syscall.Write(fd, one[:])
+}
@@ -54,6 +54,13 @@ type AudioFrame struct {
 	// PTS is the RTP timestamp.
 	PTS uint32
 
+	// CaptureTime is the sender's capture time of the first sample on its
+	// NTP clock, for received audio whose sender provides it.
+	CaptureTime time.Duration
+
+	// HasCaptureTime reports whether CaptureTime is set.
+	HasCaptureTime bool
+
 	// pool is the pool this frame belongs to (for recycling).
 	pool *AudioFramePool
 }
@@ -68,13 +75,15 @@ func (f *AudioFrame) Release() {
 // Clone creates a deep copy of the frame.
 func (f *AudioFrame) Clone() *AudioFrame {
 	clone := &AudioFrame{
-		SampleRate: f.SampleRate,
-		Channels:   f.Channels,
-		Format:     f.Format,
-		NumSamples: f.NumSamples,
-		Timestamp:  f.Timestamp,
-		PTS:        f.PTS,
-		Samples:    make([]byte, len(f.Samples)),
+		SampleRate:     f.SampleRate,
+		Channels:       f.Channels,
+		Format:         f.Format,
+		NumSamples:     f.NumSamples,
+		Timestamp:      f.Timestamp,
+		PTS:            f.PTS,
+		CaptureTime:    f.CaptureTime,
+		HasCaptureTime: f.HasCaptureTime,
+		Samples:        make([]byte, len(f.Samples)),
 	}
 	copy(clone.Samples, f.Samples)
 	return clone
@@ -211,6 +220,8 @@ func (p *AudioFramePool) Get() *AudioFrame {
 		// Reset metadata
 		f.Timestamp = 0
 		f.PTS = 0
+		f.CaptureTime = 0
+		f.HasCaptureTime = false
 		return f
 	}
 
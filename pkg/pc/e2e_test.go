@@ -1,11 +1,20 @@
 package pc
 
 import (
+	"errors"
+	"fmt"
 	"os"
+	"strconv"
+	"strings"
+	"sync"
+	"sync/atomic"
 	"testing"
+	"time"
 
 	"github.com/thesyncim/libgowebrtc/internal/ffi"
 	"github.com/thesyncim/libgowebrtc/pkg/codec"
+	"github.com/thesyncim/libgowebrtc/pkg/encoder"
+	"github.com/thesyncim/libgowebrtc/pkg/frame"
 )
 
 // End-to-end tests for PeerConnection that require the shim library.
@@ -622,3 +631,2323 @@ func TestJitterBufferOnNilReceiver(t *testing.T) {
 
 	t.Log("Nil receiver error handling succeeded")
 }
+
+func TestFactorySharedPeerConnections(t *testing.T) {
+	factory, err := NewFactory(FactoryConfig{DisableAudioDevice: true})
+	if err != nil {
+		t.Fatalf("NewFactory failed: %v", err)
+	}
+
+	pc1, err := factory.NewPeerConnection(DefaultConfiguration())
+	if err != nil {
+		t.Fatalf("NewPeerConnection (offerer) failed: %v", err)
+	}
+	defer pc1.Close()
+
+	pc2, err := factory.NewPeerConnection(DefaultConfiguration())
+	if err != nil {
+		t.Fatalf("NewPeerConnection (answerer) failed: %v", err)
+	}
+	defer pc2.Close()
+
+	track, err := pc1.CreateVideoTrack("video-0", codec.VP8, 640, 480)
+	if err != nil {
+		t.Fatalf("CreateVideoTrack failed: %v", err)
+	}
+	if _, err := pc1.AddTrack(track, "stream-0"); err != nil {
+		t.Fatalf("AddTrack failed: %v", err)
+	}
+
+	// Connections must outlive the factory handle.
+	if err := factory.Close(); err != nil {
+		t.Fatalf("Factory Close failed: %v", err)
+	}
+	if _, err := factory.NewPeerConnection(DefaultConfiguration()); err != ErrFactoryClosed {
+		t.Errorf("NewPeerConnection after Close = %v, want ErrFactoryClosed", err)
+	}
+
+	offer, err := pc1.CreateOffer(nil)
+	if err != nil {
+		t.Fatalf("CreateOffer failed: %v", err)
+	}
+	if err := pc1.SetLocalDescription(offer); err != nil {
+		t.Fatalf("PC1 SetLocalDescription failed: %v", err)
+	}
+	if err := pc2.SetRemoteDescription(offer); err != nil {
+		t.Fatalf("PC2 SetRemoteDescription failed: %v", err)
+	}
+	answer, err := pc2.CreateAnswer(nil)
+	if err != nil {
+		t.Fatalf("CreateAnswer failed: %v", err)
+	}
+	if err := pc2.SetLocalDescription(answer); err != nil {
+		t.Fatalf("PC2 SetLocalDescription failed: %v", err)
+	}
+	if err := pc1.SetRemoteDescription(answer); err != nil {
+		t.Fatalf("PC1 SetRemoteDescription failed: %v", err)
+	}
+}
+
+func TestFactorySoftwareCodecsWithoutAudioProcessing(t *testing.T) {
+	factory, err := NewFactory(FactoryConfig{
+		VideoCodecs:            VideoCodecFactorySoftware,
+		DisableAudioDevice:     true,
+		DisableAudioProcessing: true,
+	})
+	if err != nil {
+		t.Fatalf("NewFactory failed: %v", err)
+	}
+	defer factory.Close()
+
+	pc, err := factory.NewPeerConnection(DefaultConfiguration())
+	if err != nil {
+		t.Fatalf("NewPeerConnection failed: %v", err)
+	}
+	defer pc.Close()
+
+	track, err := pc.CreateAudioTrack("audio-0")
+	if err != nil {
+		t.Fatalf("CreateAudioTrack failed: %v", err)
+	}
+	if _, err := pc.AddTrack(track, "stream-0"); err != nil {
+		t.Fatalf("AddTrack failed: %v", err)
+	}
+	if _, err := pc.CreateOffer(nil); err != nil {
+		t.Fatalf("CreateOffer failed: %v", err)
+	}
+}
+
+func TestThreadGroupShardedPeerConnections(t *testing.T) {
+	group, err := NewThreadGroup(ThreadGroupConfig{
+		Shards:  2,
+		Factory: FactoryConfig{DisableAudioDevice: true},
+	})
+	if err != nil {
+		t.Fatalf("NewThreadGroup failed: %v", err)
+	}
+	if group.Shards() != 2 {
+		t.Fatalf("Shards() = %d, want 2", group.Shards())
+	}
+
+	// Offerer and answerer on different shards exchange SDP across threads.
+	pc1, err := group.NewPeerConnectionOnShard(0, DefaultConfiguration())
+	if err != nil {
+		t.Fatalf("NewPeerConnectionOnShard(0) failed: %v", err)
+	}
+	defer pc1.Close()
+
+	pc2, err := group.NewPeerConnectionOnShard(1, DefaultConfiguration())
+	if err != nil {
+		t.Fatalf("NewPeerConnectionOnShard(1) failed: %v", err)
+	}
+	defer pc2.Close()
+
+	if _, err := group.NewPeerConnectionOnShard(2, DefaultConfiguration()); err == nil {
+		t.Error("NewPeerConnectionOnShard(2) should fail for a 2-shard group")
+	}
+
+	pc3, err := group.NewPeerConnection(DefaultConfiguration())
+	if err != nil {
+		t.Fatalf("NewPeerConnection failed: %v", err)
+	}
+	defer pc3.Close()
+
+	track, err := pc1.CreateVideoTrack("video-0", codec.VP8, 640, 480)
+	if err != nil {
+		t.Fatalf("CreateVideoTrack failed: %v", err)
+	}
+	if _, err := pc1.AddTrack(track, "stream-0"); err != nil {
+		t.Fatalf("AddTrack failed: %v", err)
+	}
+
+	// Connections must outlive the group handle.
+	if err := group.Close(); err != nil {
+		t.Fatalf("ThreadGroup Close failed: %v", err)
+	}
+	if _, err := group.NewPeerConnection(DefaultConfiguration()); err != ErrThreadGroupClosed {
+		t.Errorf("NewPeerConnection after Close = %v, want ErrThreadGroupClosed", err)
+	}
+
+	offer, err := pc1.CreateOffer(nil)
+	if err != nil {
+		t.Fatalf("CreateOffer failed: %v", err)
+	}
+	if err := pc1.SetLocalDescription(offer); err != nil {
+		t.Fatalf("PC1 SetLocalDescription failed: %v", err)
+	}
+	if err := pc2.SetRemoteDescription(offer); err != nil {
+		t.Fatalf("PC2 SetRemoteDescription failed: %v", err)
+	}
+	answer, err := pc2.CreateAnswer(nil)
+	if err != nil {
+		t.Fatalf("CreateAnswer failed: %v", err)
+	}
+	if err := pc2.SetLocalDescription(answer); err != nil {
+		t.Fatalf("PC2 SetLocalDescription failed: %v", err)
+	}
+	if err := pc1.SetRemoteDescription(answer); err != nil {
+		t.Fatalf("PC1 SetRemoteDescription failed: %v", err)
+	}
+}
+
+func TestAsyncOfferAnswerConcurrent(t *testing.T) {
+	const pairs = 8
+
+	factory, err := NewFactory(FactoryConfig{DisableAudioDevice: true})
+	if err != nil {
+		t.Fatalf("NewFactory failed: %v", err)
+	}
+	defer factory.Close()
+
+	// Each step starts the next from its completion callback, so no goroutine
+	// ever blocks on the signaling thread.
+	negotiate := func(pc1, pc2 *PeerConnection, done chan<- error) {
+		fail := func(err error) {
+			if err != nil {
+				done <- err
+			}
+		}
+		fail(pc1.CreateOfferAsync(nil, func(offer *SessionDescription, err error) {
+			if err != nil {
+				done <- err
+				return
+			}
+			fail(pc1.SetLocalDescriptionAsync(offer, func(err error) {
+				if err != nil {
+					done <- err
+					return
+				}
+				fail(pc2.SetRemoteDescriptionAsync(offer, func(err error) {
+					if err != nil {
+						done <- err
+						return
+					}
+					fail(pc2.CreateAnswerAsync(nil, func(answer *SessionDescription, err error) {
+						if err != nil {
+							done <- err
+							return
+						}
+						fail(pc2.SetLocalDescriptionAsync(answer, func(err error) {
+							if err != nil {
+								done <- err
+								return
+							}
+							fail(pc1.SetRemoteDescriptionAsync(answer, func(err error) {
+								done <- err
+							}))
+						}))
+					}))
+				}))
+			}))
+		}))
+	}
+
+	var wg sync.WaitGroup
+	errs := make(chan error, pairs)
+	pcs := make([]*PeerConnection, 0, 2*pairs)
+	for i := 0; i < pairs; i++ {
+		pc1, err := factory.NewPeerConnection(DefaultConfiguration())
+		if err != nil {
+			t.Fatalf("NewPeerConnection failed: %v", err)
+		}
+		pc2, err := factory.NewPeerConnection(DefaultConfiguration())
+		if err != nil {
+			t.Fatalf("NewPeerConnection failed: %v", err)
+		}
+		pcs = append(pcs, pc1, pc2)
+		if _, err := pc1.CreateDataChannel("dc", nil); err != nil {
+			t.Fatalf("CreateDataChannel failed: %v", err)
+		}
+
+		wg.Add(1)
+		go func() {
+			defer wg.Done()
+			done := make(chan error, 1)
+			negotiate(pc1, pc2, done)
+			select {
+			case err := <-done:
+				errs <- err
+			case <-time.After(10 * time.Second):
+				errs <- ErrSetDescriptionFailed
+			}
+		}()
+	}
+	defer func() {
+		for _, pc := range pcs {
+			pc.Close()
+		}
+	}()
+
+	wg.Wait()
+	close(errs)
+	for err := range errs {
+		if err != nil {
+			t.Errorf("async negotiation failed: %v", err)
+		}
+	}
+	for _, pc := range pcs {
+		if pc.LocalDescription() == nil || pc.RemoteDescription() == nil {
+			t.Error("descriptions not recorded after async negotiation")
+		}
+	}
+}
+
+func TestEventQueueDataChannel(t *testing.T) {
+	queue, err := NewEventQueue(0)
+	if err != nil {
+		t.Fatalf("NewEventQueue failed: %v", err)
+	}
+	defer queue.Close()
+
+	pc1, err := NewPeerConnection(Configuration{})
+	if err != nil {
+		t.Fatalf("NewPeerConnection failed: %v", err)
+	}
+	defer pc1.Close()
+	pc2, err := NewPeerConnection(Configuration{})
+	if err != nil {
+		t.Fatalf("NewPeerConnection failed: %v", err)
+	}
+	defer pc2.Close()
+
+	// Handlers run on the queue goroutine, so trickling candidates from them
+	// never blocks a libwebrtc thread.
+	pc1.OnICECandidate = func(c *ICECandidate) { pc2.AddICECandidate(c) }
+	pc2.OnICECandidate = func(c *ICECandidate) { pc1.AddICECandidate(c) }
+
+	received := make(chan string, 1)
+	pc2.OnDataChannel = func(dc *DataChannel) {
+		dc.SetOnMessage(func(data []byte) {
+			received <- string(data)
+		})
+	}
+
+	for _, pc := range []*PeerConnection{pc1, pc2} {
+		if err := queue.AttachPeerConnection(pc); err != nil {
+			t.Fatalf("AttachPeerConnection failed: %v", err)
+		}
+	}
+	if err := queue.AttachPeerConnection(pc1); err == nil {
+		t.Error("attaching a PeerConnection twice should fail")
+	}
+
+	dc, err := pc1.CreateDataChannel("events", nil)
+	if err != nil {
+		t.Fatalf("CreateDataChannel failed: %v", err)
+	}
+	opened := make(chan struct{})
+	dc.SetOnOpen(func() { close(opened) })
+
+	offer, err := pc1.CreateOffer(nil)
+	if err != nil {
+		t.Fatalf("CreateOffer failed: %v", err)
+	}
+	if err := pc1.SetLocalDescription(offer); err != nil {
+		t.Fatalf("SetLocalDescription failed: %v", err)
+	}
+	if err := pc2.SetRemoteDescription(offer); err != nil {
+		t.Fatalf("SetRemoteDescription failed: %v", err)
+	}
+	answer, err := pc2.CreateAnswer(nil)
+	if err != nil {
+		t.Fatalf("CreateAnswer failed: %v", err)
+	}
+	if err := pc2.SetLocalDescription(answer); err != nil {
+		t.Fatalf("SetLocalDescription failed: %v", err)
+	}
+	if err := pc1.SetRemoteDescription(answer); err != nil {
+		t.Fatalf("SetRemoteDescription failed: %v", err)
+	}
+
+	select {
+	case <-opened:
+	case <-time.After(10 * time.Second):
+		t.Fatal("data channel did not open")
+	}
+	if err := dc.SendText("hello"); err != nil {
+		t.Fatalf("SendText failed: %v", err)
+	}
+	select {
+	case msg := <-received:
+		if msg != "hello" {
+			t.Errorf("message = %q, want %q", msg, "hello")
+		}
+	case <-time.After(5 * time.Second):
+		t.Fatal("message not delivered through event queue")
+	}
+
+	if pc1.SignalingState() != SignalingStateStable {
+		t.Errorf("SignalingState = %v, want stable", pc1.SignalingState())
+	}
+	if dropped := queue.Dropped(); dropped != 0 {
+		t.Errorf("Dropped = %d, want 0", dropped)
+	}
+}
+
+func TestServerConfigurationCandidates(t *testing.T) {
+	cfg := ServerConfiguration()
+	cfg.PortRangeMin = 42000
+	cfg.PortRangeMax = 42100
+
+	pc, err := NewPeerConnection(cfg)
+	if err != nil {
+		t.Fatalf("NewPeerConnection failed: %v", err)
+	}
+	defer pc.Close()
+
+	var mu sync.Mutex
+	var candidates []string
+	gathered := make(chan struct{})
+	var once sync.Once
+	pc.OnICECandidate = func(c *ICECandidate) {
+		mu.Lock()
+		candidates = append(candidates, c.Candidate)
+		mu.Unlock()
+	}
+	pc.OnICEGatheringStateChange = func(state ICEGatheringState) {
+		if state == ICEGatheringStateComplete {
+			once.Do(func() { close(gathered) })
+		}
+	}
+
+	if _, err := pc.CreateDataChannel("server", nil); err != nil {
+		t.Fatalf("CreateDataChannel failed: %v", err)
+	}
+	offer, err := pc.CreateOffer(nil)
+	if err != nil {
+		t.Fatalf("CreateOffer failed: %v", err)
+	}
+	if err := pc.SetLocalDescription(offer); err != nil {
+		t.Fatalf("SetLocalDescription failed: %v", err)
+	}
+
+	select {
+	case <-gathered:
+	case <-time.After(10 * time.Second):
+		t.Fatal("ICE gathering did not complete")
+	}
+
+	mu.Lock()
+	defer mu.Unlock()
+	if len(candidates) == 0 {
+		t.Skip("no usable network interfaces for host candidates")
+	}
+	for _, c := range candidates {
+		// candidate:<foundation> <component> <protocol> <priority> <ip> <port> typ <type> ...
+		fields := strings.Fields(c)
+		if len(fields) < 8 {
+			t.Errorf("malformed candidate %q", c)
+			continue
+		}
+		if strings.EqualFold(fields[2], "tcp") {
+			t.Errorf("TCP candidate gathered with TCP disabled: %q", c)
+		}
+		port, err := strconv.Atoi(fields[5])
+		if err != nil || port < cfg.PortRangeMin || port > cfg.PortRangeMax {
+			t.Errorf("candidate port %s outside [%d, %d]: %q", fields[5], cfg.PortRangeMin, cfg.PortRangeMax, c)
+		}
+	}
+}
+
+func TestInvalidServerConfiguration(t *testing.T) {
+	tests := []struct {
+		name   string
+		modify func(*Configuration)
+	}{
+		{"bundle policy", func(c *Configuration) { c.BundlePolicy = "max-everything" }},
+		{"tcp candidate policy", func(c *Configuration) { c.TCPCandidatePolicy = "sometimes" }},
+		{"inverted port range", func(c *Configuration) { c.PortRangeMin, c.PortRangeMax = 5000, 4000 }},
+		{"port range too large", func(c *Configuration) { c.PortRangeMin, c.PortRangeMax = 1, 70000 }},
+		{"fixed controller without rate", func(c *Configuration) {
+			c.CongestionControl = CongestionControl{Controller: CongestionControllerFixed}
+		}},
+		{"inverted bitrate bounds", func(c *Configuration) {
+			c.CongestionControl = CongestionControl{MinBitrateBps: 2_000_000, MaxBitrateBps: 1_000_000}
+		}},
+	}
+	for _, tt := range tests {
+		t.Run(tt.name, func(t *testing.T) {
+			cfg := ServerConfiguration()
+			tt.modify(&cfg)
+			pc, err := NewPeerConnection(cfg)
+			if err == nil {
+				pc.Close()
+				t.Fatal("NewPeerConnection succeeded with an invalid configuration")
+			}
+		})
+	}
+}
+
+func TestUDPMuxDataChannels(t *testing.T) {
+	const muxPort = 43000
+	factory, err := NewFactory(FactoryConfig{DisableAudioDevice: true, UDPMuxPort: muxPort})
+	if err != nil {
+		t.Fatalf("NewFactory failed: %v", err)
+	}
+	defer factory.Close()
+
+	// A second factory on the same port must fail rather than split traffic.
+	if other, err := NewFactory(FactoryConfig{UDPMuxPort: muxPort}); err == nil {
+		other.Close()
+		t.Error("NewFactory on a port already in use should fail")
+	}
+
+	// Muxed connections talk to ordinary ones; two connections behind the
+	// same mux share an address and cannot be told apart.
+	const pairs = 3
+	var mu sync.Mutex
+	var muxCandidates []string
+	received := make(chan string, pairs)
+
+	for i := 0; i < pairs; i++ {
+		server, err := factory.NewPeerConnection(Configuration{})
+		if err != nil {
+			t.Fatalf("NewPeerConnection (mux) failed: %v", err)
+		}
+		defer server.Close()
+		client, err := NewPeerConnection(Configuration{})
+		if err != nil {
+			t.Fatalf("NewPeerConnection failed: %v", err)
+		}
+		defer client.Close()
+
+		server.OnICECandidate = func(c *ICECandidate) {
+			mu.Lock()
+			muxCandidates = append(muxCandidates, c.Candidate)
+			mu.Unlock()
+			client.AddICECandidate(c)
+		}
+		client.OnICECandidate = func(c *ICECandidate) { server.AddICECandidate(c) }
+		client.OnDataChannel = func(dc *DataChannel) {
+			dc.SetOnMessage(func(data []byte) { received <- string(data) })
+		}
+
+		dc, err := server.CreateDataChannel("mux", nil)
+		if err != nil {
+			t.Fatalf("CreateDataChannel failed: %v", err)
+		}
+		label := strconv.Itoa(i)
+		dc.SetOnOpen(func() { dc.SendText(label) })
+
+		offer, err := server.CreateOffer(nil)
+		if err != nil {
+			t.Fatalf("CreateOffer failed: %v", err)
+		}
+		if err := server.SetLocalDescription(offer); err != nil {
+			t.Fatalf("SetLocalDescription failed: %v", err)
+		}
+		if err := client.SetRemoteDescription(offer); err != nil {
+			t.Fatalf("SetRemoteDescription failed: %v", err)
+		}
+		answer, err := client.CreateAnswer(nil)
+		if err != nil {
+			t.Fatalf("CreateAnswer failed: %v", err)
+		}
+		if err := client.SetLocalDescription(answer); err != nil {
+			t.Fatalf("SetLocalDescription failed: %v", err)
+		}
+		if err := server.SetRemoteDescription(answer); err != nil {
+			t.Fatalf("SetRemoteDescription failed: %v", err)
+		}
+	}
+
+	seen := make(map[string]bool)
+	for len(seen) < pairs {
+		select {
+		case msg := <-received:
+			seen[msg] = true
+		case <-time.After(15 * time.Second):
+			mu.Lock()
+			n := len(muxCandidates)
+			mu.Unlock()
+			if n == 0 {
+				t.Skip("no usable network interfaces for host candidates")
+			}
+			t.Fatalf("only %d of %d muxed data channels delivered", len(seen), pairs)
+		}
+	}
+
+	mu.Lock()
+	candidates := append([]string(nil), muxCandidates...)
+	mu.Unlock()
+	for _, c := range candidates {
+		// candidate:<foundation> <component> <protocol> <priority> <ip> <port> typ <type> ...
+		fields := strings.Fields(c)
+		if len(fields) < 8 || !strings.EqualFold(fields[2], "udp") {
+			continue
+		}
+		if fields[5] != strconv.Itoa(muxPort) {
+			t.Errorf("muxed UDP candidate not on port %d: %q", muxPort, c)
+		}
+	}
+	addresses := make(map[string]bool)
+	for _, c := range candidates {
+		if fields := strings.Fields(c); len(fields) >= 8 && strings.EqualFold(fields[2], "udp") {
+			addresses[fields[4]] = true
+		}
+	}
+
+	// Both ends of a pair behind the same mux: a check from an address the
+	// mux has not seen is routed by the ufrag it names, so each session must
+	// own only the ufrag of its local description. Traffic between them is
+	// only distinguishable across two different interface addresses.
+	t.Run("SharedFactory", func(t *testing.T) {
+		if len(addresses) < 2 {
+			t.Skip("needs two interface addresses to tell a muxed pair apart")
+		}
+		offerer, answerer := newPeerPair(t, factory, Configuration{})
+		opened := make(chan struct{})
+		answerer.OnDataChannel = func(dc *DataChannel) {
+			dc.SetOnMessage(func([]byte) { close(opened) })
+		}
+		dc, err := offerer.CreateDataChannel("shared", nil)
+		if err != nil {
+			t.Fatalf("CreateDataChannel failed: %v", err)
+		}
+		dc.SetOnOpen(func() { dc.SendText("shared") })
+		negotiate(t, offerer, answerer)
+
+		select {
+		case <-opened:
+		case <-time.After(15 * time.Second):
+			t.Fatal("no message between peers sharing the mux within 15s")
+		}
+	})
+}
+
+// peerConnectionSource is a Factory or ThreadGroup.
+type peerConnectionSource interface {
+	NewPeerConnection(Configuration) (*PeerConnection, error)
+}
+
+// newLoopbackNetwork creates a loopback network closed when the test ends.
+func newLoopbackNetwork(t *testing.T, cfg LoopbackNetworkConfig) *LoopbackNetwork {
+	t.Helper()
+	network, err := NewLoopbackNetwork(cfg)
+	if err != nil {
+		t.Fatalf("NewLoopbackNetwork failed: %v", err)
+	}
+	t.Cleanup(func() { network.Close() })
+	return network
+}
+
+// newTestFactory creates a factory closed when the test ends.
+func newTestFactory(t *testing.T, cfg FactoryConfig) *Factory {
+	t.Helper()
+	factory, err := NewFactory(cfg)
+	if err != nil {
+		t.Fatalf("NewFactory failed: %v", err)
+	}
+	t.Cleanup(func() { factory.Close() })
+	return factory
+}
+
+// newPeerPair creates two peer connections from src with their ICE
+// candidates cross-wired. offererConfig applies to the offerer only.
+func newPeerPair(t *testing.T, src peerConnectionSource, offererConfig Configuration) (offerer, answerer *PeerConnection) {
+	t.Helper()
+	offerer, err := src.NewPeerConnection(offererConfig)
+	if err != nil {
+		t.Fatalf("NewPeerConnection failed: %v", err)
+	}
+	t.Cleanup(func() { offerer.Close() })
+	answerer, err = src.NewPeerConnection(Configuration{})
+	if err != nil {
+		t.Fatalf("NewPeerConnection failed: %v", err)
+	}
+	t.Cleanup(func() { answerer.Close() })
+
+	offerer.OnICECandidate = func(c *ICECandidate) { answerer.AddICECandidate(c) }
+	answerer.OnICECandidate = func(c *ICECandidate) { offerer.AddICECandidate(c) }
+	return offerer, answerer
+}
+
+// newLoopbackPair connects two peer connections over a fresh loopback
+// network with the audio device disabled.
+func newLoopbackPair(t *testing.T, cfg LoopbackNetworkConfig) (offerer, answerer *PeerConnection) {
+	t.Helper()
+	network := newLoopbackNetwork(t, cfg)
+	factory := newTestFactory(t, FactoryConfig{DisableAudioDevice: true, Loopback: network})
+	return newPeerPair(t, factory, Configuration{})
+}
+
+// negotiate runs a full offer/answer exchange from offerer to answerer.
+func negotiate(t *testing.T, offerer, answerer *PeerConnection) (offer, answer *SessionDescription) {
+	t.Helper()
+	offer, err := offerer.CreateOffer(nil)
+	if err != nil {
+		t.Fatalf("CreateOffer failed: %v", err)
+	}
+	if err := offerer.SetLocalDescription(offer); err != nil {
+		t.Fatalf("SetLocalDescription failed: %v", err)
+	}
+	if err := answerer.SetRemoteDescription(offer); err != nil {
+		t.Fatalf("SetRemoteDescription failed: %v", err)
+	}
+	answer, err = answerer.CreateAnswer(nil)
+	if err != nil {
+		t.Fatalf("CreateAnswer failed: %v", err)
+	}
+	if err := answerer.SetLocalDescription(answer); err != nil {
+		t.Fatalf("SetLocalDescription failed: %v", err)
+	}
+	if err := offerer.SetRemoteDescription(answer); err != nil {
+		t.Fatalf("SetRemoteDescription failed: %v", err)
+	}
+	return offer, answer
+}
+
+func TestLoopbackNetworkDataChannel(t *testing.T) {
+	const delay = 40 * time.Millisecond
+	network := newLoopbackNetwork(t, LoopbackNetworkConfig{Delay: delay})
+
+	// Two shards, so packets also cross network threads.
+	group, err := NewThreadGroup(ThreadGroupConfig{
+		Shards:  2,
+		Factory: FactoryConfig{DisableAudioDevice: true, Loopback: network},
+	})
+	if err != nil {
+		t.Fatalf("NewThreadGroup failed: %v", err)
+	}
+	defer group.Close()
+
+	offerer, answerer := newPeerPair(t, group, Configuration{})
+	var mu sync.Mutex
+	var candidates []string
+	offerer.OnICECandidate = func(c *ICECandidate) {
+		mu.Lock()
+		candidates = append(candidates, c.Candidate)
+		mu.Unlock()
+		answerer.AddICECandidate(c)
+	}
+	answerer.OnDataChannel = func(dc *DataChannel) {
+		dc.SetOnMessage(func(data []byte) { dc.Send(data) })
+	}
+
+	dc, err := offerer.CreateDataChannel("loopback", nil)
+	if err != nil {
+		t.Fatalf("CreateDataChannel failed: %v", err)
+	}
+	echoed := make(chan time.Duration, 1)
+	var sentAt time.Time
+	dc.SetOnMessage(func([]byte) {
+		mu.Lock()
+		defer mu.Unlock()
+		echoed <- time.Since(sentAt)
+	})
+	dc.SetOnOpen(func() {
+		mu.Lock()
+		sentAt = time.Now()
+		mu.Unlock()
+		dc.SendText("ping")
+	})
+
+	negotiate(t, offerer, answerer)
+
+	select {
+	case rtt := <-echoed:
+		if rtt < 2*delay {
+			t.Errorf("round trip %v shorter than twice the configured delay %v", rtt, delay)
+		}
+	case <-time.After(15 * time.Second):
+		t.Fatal("data channel echo not received over the loopback network")
+	}
+
+	mu.Lock()
+	for _, c := range candidates {
+		// candidate:<foundation> <component> <protocol> <priority> <ip> <port> typ <type> ...
+		fields := strings.Fields(c)
+		if len(fields) < 8 || !strings.HasPrefix(fields[4], "10.") || fields[7] != "host" {
+			t.Errorf("unexpected loopback candidate: %q", c)
+		}
+	}
+	mu.Unlock()
+
+	stats := network.Stats()
+	if stats.PacketsDelivered == 0 || stats.BytesDelivered == 0 {
+		t.Errorf("no packets delivered: %+v", stats)
+	}
+
+	network.Close()
+	if _, err := NewFactory(FactoryConfig{Loopback: network}); err != ErrLoopbackNetworkClosed {
+		t.Errorf("NewFactory with closed network: got %v, want ErrLoopbackNetworkClosed", err)
+	}
+}
+
+func TestPeerConnectionPool(t *testing.T) {
+	factory, err := NewFactory(FactoryConfig{DisableAudioDevice: true})
+	if err != nil {
+		t.Fatalf("NewFactory failed: %v", err)
+	}
+	defer factory.Close()
+
+	const size = 2
+	pool, err := NewPeerConnectionPool(PoolConfig{
+		Factory:           factory,
+		Size:              size,
+		AudioTransceivers: 1,
+		VideoTransceivers: 1,
+	})
+	if err != nil {
+		t.Fatalf("NewPeerConnectionPool failed: %v", err)
+	}
+	defer pool.Close()
+
+	waitReady := func() {
+		t.Helper()
+		deadline := time.Now().Add(10 * time.Second)
+		for pool.Ready() < size {
+			if time.Now().After(deadline) {
+				t.Fatalf("pool has %d ready connections, want %d", pool.Ready(), size)
+			}
+			time.Sleep(10 * time.Millisecond)
+		}
+	}
+	waitReady()
+
+	pc, err := pool.Acquire()
+	if err != nil {
+		t.Fatalf("Acquire failed: %v", err)
+	}
+	defer pc.Close()
+
+	if n := len(pc.GetTransceivers()); n != 2 {
+		t.Errorf("pooled connection has %d transceivers, want 2", n)
+	}
+	offer, err := pc.CreateOffer(nil)
+	if err != nil {
+		t.Fatalf("CreateOffer failed: %v", err)
+	}
+	if !strings.Contains(offer.SDP, "m=audio") || !strings.Contains(offer.SDP, "m=video") {
+		t.Errorf("offer lacks the template transceivers:\n%s", offer.SDP)
+	}
+
+	// The pool refills behind the acquire.
+	waitReady()
+
+	pool.Close()
+	if _, err := pool.Acquire(); err != ErrPoolClosed {
+		t.Errorf("Acquire after Close: got %v, want ErrPoolClosed", err)
+	}
+}
+
+func TestStreamStats(t *testing.T) {
+	offerer, answerer := newLoopbackPair(t, LoopbackNetworkConfig{})
+
+	track, err := offerer.CreateVideoTrack("video-0", codec.VP8, 320, 240)
+	if err != nil {
+		t.Fatalf("CreateVideoTrack failed: %v", err)
+	}
+	sender, err := offerer.AddTrack(track, "stream-0")
+	if err != nil {
+		t.Fatalf("AddTrack failed: %v", err)
+	}
+	if _, err := offerer.CreateDataChannel("stats", nil); err != nil {
+		t.Fatalf("CreateDataChannel failed: %v", err)
+	}
+
+	negotiate(t, offerer, answerer)
+
+	done := make(chan struct{})
+	defer close(done)
+	go func() {
+		f := frame.NewI420Frame(320, 240)
+		ticker := time.NewTicker(33 * time.Millisecond)
+		defer ticker.Stop()
+		for {
+			select {
+			case <-done:
+				return
+			case <-ticker.C:
+				track.WriteVideoFrame(f)
+			}
+		}
+	}()
+
+	outboundVideo := func(streams []StreamStats) *StreamStats {
+		for i := range streams {
+			if streams[i].Direction == StreamOutbound && streams[i].Kind == "video" {
+				return &streams[i]
+			}
+		}
+		return nil
+	}
+
+	// Wait for media, priming the delta baseline on the way.
+	var streams []StreamStats
+	deadline := time.Now().Add(15 * time.Second)
+	for {
+		streams, err = offerer.AppendStreamStats(streams[:0], StreamStatsOptions{Delta: true})
+		if err != nil {
+			t.Fatalf("AppendStreamStats failed: %v", err)
+		}
+		if s := outboundVideo(streams); s != nil && s.Packets > 0 {
+			break
+		}
+		if time.Now().After(deadline) {
+			t.Fatalf("no outbound video packets in stream stats: %+v", streams)
+		}
+		time.Sleep(100 * time.Millisecond)
+	}
+
+	time.Sleep(500 * time.Millisecond)
+	streams, err = offerer.AppendStreamStats(streams[:0], StreamStatsOptions{Delta: true})
+	if err != nil {
+		t.Fatalf("AppendStreamStats failed: %v", err)
+	}
+	out := outboundVideo(streams)
+	if out == nil {
+		t.Fatalf("outbound video stream missing: %+v", streams)
+	}
+	if out.SSRC == 0 || out.MID == "" || out.Bytes == 0 {
+		t.Errorf("incomplete outbound stream stats: %+v", *out)
+	}
+	if out.Interval <= 0 || out.BitrateBps <= 0 || out.PacketRate <= 0 {
+		t.Errorf("delta mode did not report rates: %+v", *out)
+	}
+
+	// The sender selector only reports the sender's own streams.
+	senderStreams, err := sender.AppendStreamStats(nil, StreamStatsOptions{})
+	if err != nil {
+		t.Fatalf("RTPSender.AppendStreamStats failed: %v", err)
+	}
+	if len(senderStreams) != 1 || senderStreams[0].SSRC != out.SSRC {
+		t.Errorf("sender stats: got %+v, want only SSRC %d", senderStreams, out.SSRC)
+	}
+	if senderStreams[0].Interval != 0 {
+		t.Errorf("non-delta call reported an interval: %v", senderStreams[0].Interval)
+	}
+	senderStats, err := sender.GetStats()
+	if err != nil {
+		t.Fatalf("RTPSender.GetStats failed: %v", err)
+	}
+	if senderStats.PacketsSent == 0 || senderStats.BytesReceived != 0 {
+		t.Errorf("sender GetStats not scoped to the sender: %+v", senderStats)
+	}
+
+	inbound, err := answerer.AppendStreamStats(nil, StreamStatsOptions{})
+	if err != nil {
+		t.Fatalf("AppendStreamStats failed: %v", err)
+	}
+	found := false
+	for _, s := range inbound {
+		if s.Direction == StreamInbound && s.SSRC == out.SSRC {
+			found = s.Packets > 0
+		}
+	}
+	if !found {
+		t.Errorf("answerer has no inbound stream for SSRC %d: %+v", out.SSRC, inbound)
+	}
+}
+
+func TestStatsRing(t *testing.T) {
+	offerer, answerer := newLoopbackPair(t, LoopbackNetworkConfig{})
+
+	track, err := offerer.CreateVideoTrack("video-0", codec.VP8, 320, 240)
+	if err != nil {
+		t.Fatalf("CreateVideoTrack failed: %v", err)
+	}
+	if _, err := offerer.AddTrack(track, "stream-0"); err != nil {
+		t.Fatalf("AddTrack failed: %v", err)
+	}
+
+	ring, err := NewStatsRing(0)
+	if err != nil {
+		t.Fatalf("NewStatsRing failed: %v", err)
+	}
+	defer ring.Close()
+
+	const offererTag, answererTag = 1, 2
+	if err := ring.Subscribe(offerer, 100*time.Millisecond, offererTag); err != nil {
+		t.Fatalf("Subscribe failed: %v", err)
+	}
+	if err := ring.Subscribe(answerer, 100*time.Millisecond, answererTag); err != nil {
+		t.Fatalf("Subscribe failed: %v", err)
+	}
+
+	negotiate(t, offerer, answerer)
+
+	done := make(chan struct{})
+	defer close(done)
+	go func() {
+		f := frame.NewI420Frame(320, 240)
+		ticker := time.NewTicker(33 * time.Millisecond)
+		defer ticker.Stop()
+		for {
+			select {
+			case <-done:
+				return
+			case <-ticker.C:
+				track.WriteVideoFrame(f)
+			}
+		}
+	}()
+
+	// Wait until both sides have pushed a rate for their video stream.
+	var records []StatsRecord
+	var sent, received bool
+	deadline := time.Now().Add(15 * time.Second)
+	for !sent || !received {
+		if time.Now().After(deadline) {
+			t.Fatalf("no stream rates pushed (sent=%v received=%v), last records: %+v", sent, received, records)
+		}
+		time.Sleep(100 * time.Millisecond)
+
+		records, err = ring.Read(records[:0])
+		if err != nil {
+			t.Fatalf("Read failed: %v", err)
+		}
+		for _, rec := range records {
+			s := rec.Stream
+			if rec.StreamCount == 0 || s.Kind != "video" || s.BitrateBps <= 0 {
+				continue
+			}
+			switch {
+			case rec.Tag == offererTag && s.Direction == StreamOutbound:
+				sent = true
+			case rec.Tag == answererTag && s.Direction == StreamInbound:
+				received = true
+			}
+		}
+	}
+	if dropped := ring.Dropped(); dropped != 0 {
+		t.Errorf("ring dropped %d records", dropped)
+	}
+
+	// Once unsubscribed, a PeerConnection stops producing records.
+	ring.Unsubscribe(answerer)
+	time.Sleep(50 * time.Millisecond) // let a round being written finish
+	records, _ = ring.Read(records[:0])
+	time.Sleep(300 * time.Millisecond)
+	records, err = ring.Read(records[:0])
+	if err != nil {
+		t.Fatalf("Read failed: %v", err)
+	}
+	for _, rec := range records {
+		if rec.Tag == answererTag {
+			t.Fatalf("record for unsubscribed PeerConnection: %+v", rec)
+		}
+	}
+	if len(records) == 0 {
+		t.Error("subscribed PeerConnection stopped producing records")
+	}
+
+	// Closing a subscribed PeerConnection unsubscribes it before destroying it.
+	if err := offerer.Close(); err != nil {
+		t.Fatalf("Close failed: %v", err)
+	}
+	if err := ring.Close(); err != nil {
+		t.Fatalf("ring Close failed: %v", err)
+	}
+	if _, err := ring.Read(nil); !errors.Is(err, ErrStatsRingClosed) {
+		t.Errorf("Read after Close: got %v, want ErrStatsRingClosed", err)
+	}
+}
+
+func TestBandwidthEstimate(t *testing.T) {
+	offerer, answerer := newLoopbackPair(t, LoopbackNetworkConfig{BandwidthKbps: 2000, Delay: 10 * time.Millisecond})
+
+	if bwe := offerer.GetCurrentBandwidthEstimate(); bwe == nil || bwe.TargetBitrateBps != 0 {
+		t.Errorf("estimate before connecting: got %+v, want zero", bwe)
+	}
+
+	var mu sync.Mutex
+	var updates []BandwidthEstimate
+	offerer.SetOnBandwidthEstimate(func(bwe *BandwidthEstimate) {
+		mu.Lock()
+		updates = append(updates, *bwe)
+		mu.Unlock()
+	})
+
+	track, err := offerer.CreateVideoTrack("video-0", codec.VP8, 640, 480)
+	if err != nil {
+		t.Fatalf("CreateVideoTrack failed: %v", err)
+	}
+	if _, err := offerer.AddTrack(track, "stream-0"); err != nil {
+		t.Fatalf("AddTrack failed: %v", err)
+	}
+
+	negotiate(t, offerer, answerer)
+
+	done := make(chan struct{})
+	defer close(done)
+	go func() {
+		f := frame.NewI420Frame(640, 480)
+		ticker := time.NewTicker(33 * time.Millisecond)
+		defer ticker.Stop()
+		for {
+			select {
+			case <-done:
+				return
+			case <-ticker.C:
+				track.WriteVideoFrame(f)
+			}
+		}
+	}()
+
+	// The controller reports as soon as the transport comes up, then again
+	// as transport feedback moves the estimate.
+	deadline := time.Now().Add(15 * time.Second)
+	for {
+		mu.Lock()
+		n := len(updates)
+		mu.Unlock()
+		if n >= 2 {
+			break
+		}
+		if time.Now().After(deadline) {
+			t.Fatalf("got %d bandwidth estimate updates, want at least 2", n)
+		}
+		time.Sleep(100 * time.Millisecond)
+	}
+
+	mu.Lock()
+	last := updates[len(updates)-1]
+	mu.Unlock()
+	if last.TargetBitrateBps <= 0 || last.PacingRateBps <= 0 || last.TimestampUs == 0 {
+		t.Errorf("incomplete pushed estimate: %+v", last)
+	}
+
+	bwe := offerer.GetCurrentBandwidthEstimate()
+	if bwe == nil || bwe.TargetBitrateBps <= 0 {
+		t.Fatalf("GetCurrentBandwidthEstimate: got %+v, want a target rate", bwe)
+	}
+	if bwe.TimestampUs < last.TimestampUs {
+		t.Errorf("getter returned an estimate older than the last pushed one: %d < %d", bwe.TimestampUs, last.TimestampUs)
+	}
+}
+
+func TestRTCPFeedback(t *testing.T) {
+	offerer, answerer := newLoopbackPair(t, LoopbackNetworkConfig{BandwidthKbps: 2000, Delay: 10 * time.Millisecond})
+
+	track, err := offerer.CreateVideoTrack("video-0", codec.VP8, 640, 480)
+	if err != nil {
+		t.Fatalf("CreateVideoTrack failed: %v", err)
+	}
+	sender, err := offerer.AddTrack(track, "stream-0")
+	if err != nil {
+		t.Fatalf("AddTrack failed: %v", err)
+	}
+
+	if err := sender.SetOnRTCPFeedbackBatch(time.Microsecond, func([]RTCPFeedback) {}); err == nil {
+		t.Error("SetOnRTCPFeedbackBatch accepted a sub-millisecond interval")
+	}
+
+	batches := make(chan []RTCPFeedback, 64)
+	if err := sender.SetOnRTCPFeedbackBatch(0, func(batch []RTCPFeedback) {
+		select {
+		case batches <- batch:
+		default:
+		}
+	}); err != nil {
+		t.Fatalf("SetOnRTCPFeedbackBatch failed: %v", err)
+	}
+	transport := make(chan []RTCPFeedback, 64)
+	if err := offerer.SetOnTransportFeedback(50*time.Millisecond, func(batch []RTCPFeedback) {
+		select {
+		case transport <- batch:
+		default:
+		}
+	}); err != nil {
+		t.Fatalf("SetOnTransportFeedback failed: %v", err)
+	}
+
+	receivers := make(chan *RTPReceiver, 1)
+	answerer.OnTrack = func(remote *Track, receiver *RTPReceiver, _ []string) {
+		if remote.Kind() == "video" {
+			receivers <- receiver
+		}
+	}
+
+	negotiate(t, offerer, answerer)
+
+	done := make(chan struct{})
+	defer close(done)
+	go func() {
+		f := frame.NewI420Frame(640, 480)
+		ticker := time.NewTicker(33 * time.Millisecond)
+		defer ticker.Stop()
+		for {
+			select {
+			case <-done:
+				return
+			case <-ticker.C:
+				track.WriteVideoFrame(f)
+			}
+		}
+	}()
+
+	var receiver *RTPReceiver
+	select {
+	case receiver = <-receivers:
+	case <-time.After(10 * time.Second):
+		t.Fatal("no remote video track within 10s")
+	}
+
+	waitFor := func(batches <-chan []RTCPFeedback, feedbackType RTCPFeedbackType, poke func()) RTCPFeedback {
+		t.Helper()
+		timeout := time.After(15 * time.Second)
+		retry := time.NewTicker(500 * time.Millisecond)
+		defer retry.Stop()
+		for {
+			select {
+			case batch := <-batches:
+				if len(batch) == 0 {
+					t.Fatal("got an empty feedback batch")
+				}
+				for _, fb := range batch {
+					if fb.Type == feedbackType {
+						return fb
+					}
+				}
+			case <-retry.C:
+				if poke != nil {
+					poke()
+				}
+			case <-timeout:
+				t.Fatalf("no %v feedback within 15s", feedbackType)
+			}
+		}
+	}
+
+	// The receiver acknowledges every media packet with transport-wide
+	// feedback, so TWCC batches arrive as soon as media flows.
+	fb := waitFor(transport, RTCPFeedbackTypeTWCC, nil)
+	if fb.SSRC != 0 || fb.Count <= 0 || fb.Lost < 0 || fb.Lost > fb.Count || fb.TimestampUs == 0 {
+		t.Errorf("implausible TWCC summary: %+v", fb)
+	}
+
+	// Keyframe requests reach the sender without waiting for an interval.
+	requestKeyFrame := func() {
+		if err := receiver.RequestKeyFrame(); err != nil {
+			t.Errorf("RequestKeyFrame failed: %v", err)
+		}
+	}
+	requestKeyFrame()
+	fb = waitFor(batches, RTCPFeedbackTypePLI, requestKeyFrame)
+	if fb.SSRC == 0 || fb.Count <= 0 || fb.TimestampUs == 0 {
+		t.Errorf("implausible PLI: %+v", fb)
+	}
+
+	// Route the same sender's feedback through an event queue instead.
+	q, err := NewEventQueue(0)
+	if err != nil {
+		t.Fatalf("NewEventQueue failed: %v", err)
+	}
+	defer q.Close()
+
+	queued := make(chan []RTCPFeedback, 64)
+	if err := q.SetOnRTCPFeedback(sender, 0, func(batch []RTCPFeedback) {
+		select {
+		case queued <- batch:
+		default:
+		}
+	}); err != nil {
+		t.Fatalf("EventQueue.SetOnRTCPFeedback failed: %v", err)
+	}
+	requestKeyFrame()
+	waitFor(queued, RTCPFeedbackTypePLI, requestKeyFrame)
+
+	if err := q.SetOnRTCPFeedback(sender, 0, nil); err != nil {
+		t.Fatalf("clearing queued feedback failed: %v", err)
+	}
+	if err := offerer.SetOnTransportFeedback(0, nil); err != nil {
+		t.Fatalf("clearing transport feedback failed: %v", err)
+	}
+}
+
+func TestEncodedVideoTrack(t *testing.T) {
+	offerer, answerer := newLoopbackPair(t, LoopbackNetworkConfig{})
+
+	const width, height = 320, 240
+	enc, err := encoder.NewVP8Encoder(codec.VP8Config{Width: width, Height: height, Bitrate: 500_000, FPS: 30})
+	if err != nil {
+		t.Skipf("VP8 encoder not available: %v", err)
+	}
+	defer enc.Close()
+
+	track, err := offerer.CreateEncodedVideoTrack("video-0", codec.VP8, width, height)
+	if err != nil {
+		t.Fatalf("CreateEncodedVideoTrack failed: %v", err)
+	}
+	if err := track.WriteVideoFrame(frame.NewI420Frame(width, height)); err == nil {
+		t.Error("WriteVideoFrame accepted a raw frame on an encoded track")
+	}
+
+	keyFrameRequests := make(chan struct{}, 1)
+	if err := track.SetOnKeyFrameRequest(func() {
+		enc.RequestKeyFrame()
+		select {
+		case keyFrameRequests <- struct{}{}:
+		default:
+		}
+	}); err != nil {
+		t.Fatalf("SetOnKeyFrameRequest failed: %v", err)
+	}
+	if _, err := offerer.AddTrack(track, "stream-0"); err != nil {
+		t.Fatalf("AddTrack failed: %v", err)
+	}
+
+	received := make(chan *frame.VideoFrame, 1)
+	answerer.OnTrack = func(remote *Track, _ *RTPReceiver, _ []string) {
+		if remote.Kind() != "video" {
+			return
+		}
+		remote.SetOnVideoFrame(func(f *frame.VideoFrame) {
+			select {
+			case received <- f:
+			default:
+			}
+		})
+	}
+
+	offer, _ := negotiate(t, offerer, answerer)
+	if !strings.Contains(offer.SDP, "VP8/90000") || strings.Contains(offer.SDP, "H264/90000") {
+		t.Errorf("offer should only carry VP8:\n%s", offer.SDP)
+	}
+
+	// The encoder's first keyframe is thrown away, so the stream starts with
+	// delta frames and the sender has to ask for a keyframe.
+	done := make(chan struct{})
+	defer close(done)
+	go func() {
+		raw := frame.NewI420Frame(width, height)
+		buf := make([]byte, enc.MaxEncodedSize())
+		ticker := time.NewTicker(33 * time.Millisecond)
+		defer ticker.Stop()
+		skipped := false
+		for {
+			select {
+			case <-done:
+				return
+			case <-ticker.C:
+				res, err := enc.EncodeInto(raw, buf, false)
+				if err != nil || res.N == 0 {
+					continue
+				}
+				if !skipped {
+					skipped = true
+					continue
+				}
+				track.WriteEncodedFrame(buf[:res.N], res.IsKeyframe)
+			}
+		}
+	}()
+
+	select {
+	case <-keyFrameRequests:
+	case <-time.After(10 * time.Second):
+		t.Fatal("no keyframe request within 10s")
+	}
+	select {
+	case f := <-received:
+		if f.Width != width || f.Height != height {
+			t.Errorf("received %dx%d, want %dx%d", f.Width, f.Height, width, height)
+		}
+	case <-time.After(15 * time.Second):
+		t.Fatal("no decoded frame within 15s")
+	}
+}
+
+func TestEncodedVideoTrackKeyFrameCache(t *testing.T) {
+	offerer, answerer := newLoopbackPair(t, LoopbackNetworkConfig{})
+
+	const width, height = 320, 240
+	enc, err := encoder.NewVP8Encoder(codec.VP8Config{Width: width, Height: height, Bitrate: 500_000, FPS: 30})
+	if err != nil {
+		t.Skipf("VP8 encoder not available: %v", err)
+	}
+	defer enc.Close()
+
+	track, err := offerer.CreateEncodedVideoTrack("video-0", codec.VP8, width, height)
+	if err != nil {
+		t.Fatalf("CreateEncodedVideoTrack failed: %v", err)
+	}
+	if err := track.SetMinKeyFrameInterval(time.Second); err != nil {
+		t.Fatalf("SetMinKeyFrameInterval failed: %v", err)
+	}
+	if _, err := offerer.AddTrack(track, "stream-0"); err != nil {
+		t.Fatalf("AddTrack failed: %v", err)
+	}
+	if err := track.SetMinKeyFrameInterval(time.Second); err == nil {
+		t.Error("SetMinKeyFrameInterval succeeded after AddTrack")
+	}
+
+	// The producer ignores keyframe requests: its only keyframe is pushed
+	// before the sender starts, so the receiver can only decode the cached
+	// copy.
+	done := make(chan struct{})
+	defer close(done)
+	go func() {
+		raw := frame.NewI420Frame(width, height)
+		buf := make([]byte, enc.MaxEncodedSize())
+		ticker := time.NewTicker(33 * time.Millisecond)
+		defer ticker.Stop()
+		for {
+			select {
+			case <-done:
+				return
+			case <-ticker.C:
+				res, err := enc.EncodeInto(raw, buf, false)
+				if err != nil || res.N == 0 {
+					continue
+				}
+				track.WriteEncodedFrame(buf[:res.N], res.IsKeyframe)
+			}
+		}
+	}()
+	time.Sleep(200 * time.Millisecond)
+
+	received := make(chan *frame.VideoFrame, 1)
+	answerer.OnTrack = func(remote *Track, _ *RTPReceiver, _ []string) {
+		if remote.Kind() != "video" {
+			return
+		}
+		remote.SetOnVideoFrame(func(f *frame.VideoFrame) {
+			select {
+			case received <- f:
+			default:
+			}
+		})
+	}
+
+	negotiate(t, offerer, answerer)
+
+	select {
+	case f := <-received:
+		if f.Width != width || f.Height != height {
+			t.Errorf("received %dx%d, want %dx%d", f.Width, f.Height, width, height)
+		}
+	case <-time.After(15 * time.Second):
+		t.Fatal("no decoded frame within 15s")
+	}
+}
+
+func TestEncodedVideoTrackFrameLoss(t *testing.T) {
+	offerer, answerer := newLoopbackPair(t, LoopbackNetworkConfig{})
+
+	const width, height = 320, 240
+	enc, err := encoder.NewVP8Encoder(codec.VP8Config{Width: width, Height: height, Bitrate: 500_000, FPS: 30})
+	if err != nil {
+		t.Skipf("VP8 encoder not available: %v", err)
+	}
+	defer enc.Close()
+
+	track, err := offerer.CreateEncodedVideoTrack("video-0", codec.VP8, width, height)
+	if err != nil {
+		t.Fatalf("CreateEncodedVideoTrack failed: %v", err)
+	}
+	keyFrameRequests := make(chan struct{}, 1)
+	if err := track.SetOnKeyFrameRequest(func() {
+		enc.RequestKeyFrame()
+		select {
+		case keyFrameRequests <- struct{}{}:
+		default:
+		}
+	}); err != nil {
+		t.Fatalf("SetOnKeyFrameRequest failed: %v", err)
+	}
+	if _, err := offerer.AddTrack(track, "stream-0"); err != nil {
+		t.Fatalf("AddTrack failed: %v", err)
+	}
+
+	received := make(chan *frame.VideoFrame, 1)
+	answerer.OnTrack = func(remote *Track, _ *RTPReceiver, _ []string) {
+		if remote.Kind() != "video" {
+			return
+		}
+		remote.SetOnVideoFrame(func(f *frame.VideoFrame) {
+			select {
+			case received <- f:
+			default:
+			}
+		})
+	}
+
+	negotiate(t, offerer, answerer)
+
+	// A frame stamped with its predecessor's capture time is dropped by
+	// libwebrtc before it reaches the encoder.
+	var dropNext atomic.Bool
+	done := make(chan struct{})
+	defer close(done)
+	go func() {
+		raw := frame.NewI420Frame(width, height)
+		buf := make([]byte, enc.MaxEncodedSize())
+		ticker := time.NewTicker(33 * time.Millisecond)
+		defer ticker.Stop()
+		timestamp := time.Second
+		for {
+			select {
+			case <-done:
+				return
+			case <-ticker.C:
+				res, err := enc.EncodeInto(raw, buf, false)
+				if err != nil || res.N == 0 {
+					continue
+				}
+				if !dropNext.CompareAndSwap(true, false) {
+					timestamp += 33 * time.Millisecond
+				}
+				track.WriteEncodedFrameAt(buf[:res.N], res.IsKeyframe, timestamp)
+			}
+		}
+	}()
+
+	select {
+	case <-received:
+	case <-time.After(15 * time.Second):
+		t.Fatal("no decoded frame within 15s")
+	}
+
+	// Requests from the start of the stream are done by now.
+	time.Sleep(time.Second)
+	select {
+	case <-keyFrameRequests:
+	default:
+	}
+	dropNext.Store(true)
+	select {
+	case <-keyFrameRequests:
+	case <-time.After(5 * time.Second):
+		t.Fatal("no keyframe request within 5s of a lost frame")
+	}
+
+	// The stream recovers with the requested keyframe.
+	select {
+	case <-received:
+	default:
+	}
+	select {
+	case <-received:
+	case <-time.After(5 * time.Second):
+		t.Fatal("no decoded frame within 5s of the keyframe request")
+	}
+}
+
+func TestSharedVideoEncoder(t *testing.T) {
+	network := newLoopbackNetwork(t, LoopbackNetworkConfig{})
+	factory := newTestFactory(t, FactoryConfig{DisableAudioDevice: true, Loopback: network})
+
+	const width, height = 320, 240
+	enc, err := NewSharedVideoEncoder(SharedVideoEncoderConfig{
+		Codec:          codec.VP8,
+		Width:          width,
+		Height:         height,
+		BitrateBps:     500_000,
+		TemporalLayers: 2,
+	})
+	if err != nil {
+		t.Skipf("shared VP8 encoder not available: %v", err)
+	}
+	defer enc.Close()
+
+	// One sender per receiver, all fed by the same encoder. The second
+	// receiver only gets the base layer.
+	const receivers = 2
+	received := make([]chan *frame.VideoFrame, receivers)
+	for i := range received {
+		offerer, answerer := newPeerPair(t, factory, Configuration{})
+		track, err := offerer.CreateSharedVideoTrack(fmt.Sprintf("video-%d", i), enc)
+		if err != nil {
+			t.Fatalf("CreateSharedVideoTrack failed: %v", err)
+		}
+		if err := track.WriteEncodedFrame([]byte{0}, true); err == nil {
+			t.Error("WriteEncodedFrame accepted a frame on a shared track")
+		}
+		if i == 1 {
+			if err := track.SetMaxTemporalLayer(0); err != nil {
+				t.Fatalf("SetMaxTemporalLayer failed: %v", err)
+			}
+		}
+		if _, err := offerer.AddTrack(track, "stream-0"); err != nil {
+			t.Fatalf("AddTrack failed: %v", err)
+		}
+
+		ch := make(chan *frame.VideoFrame, 1)
+		received[i] = ch
+		answerer.OnTrack = func(remote *Track, _ *RTPReceiver, _ []string) {
+			if remote.Kind() != "video" {
+				return
+			}
+			remote.SetOnVideoFrame(func(f *frame.VideoFrame) {
+				select {
+				case ch <- f:
+				default:
+				}
+			})
+		}
+
+		negotiate(t, offerer, answerer)
+	}
+
+	done := make(chan struct{})
+	defer close(done)
+	go func() {
+		raw := frame.NewI420Frame(width, height)
+		ticker := time.NewTicker(33 * time.Millisecond)
+		defer ticker.Stop()
+		for {
+			select {
+			case <-done:
+				return
+			case <-ticker.C:
+				raw.PTS += 3000
+				enc.WriteFrame(raw)
+			}
+		}
+	}()
+
+	for i, ch := range received {
+		select {
+		case f := <-ch:
+			if f.Width != width || f.Height != height {
+				t.Errorf("receiver %d got %dx%d, want %dx%d", i, f.Width, f.Height, width, height)
+			}
+		case <-time.After(15 * time.Second):
+			t.Fatalf("receiver %d got no decoded frame within 15s", i)
+		}
+	}
+}
+
+func TestEncodedFrameSinkReceiveOnly(t *testing.T) {
+	network := newLoopbackNetwork(t, LoopbackNetworkConfig{})
+	factory := newTestFactory(t, FactoryConfig{
+		DisableAudioDevice:   true,
+		DisableVideoDecoding: true,
+		Loopback:             network,
+	})
+	offerer, answerer := newPeerPair(t, factory, Configuration{})
+
+	const width, height = 320, 240
+	track, err := offerer.CreateVideoTrack("video-0", codec.VP8, width, height)
+	if err != nil {
+		t.Fatalf("CreateVideoTrack failed: %v", err)
+	}
+	if _, err := offerer.AddTrack(track, "stream-0"); err != nil {
+		t.Fatalf("AddTrack failed: %v", err)
+	}
+
+	keyframes := make(chan EncodedVideoFrame, 1)
+	var decoded atomic.Int32
+	answerer.OnTrack = func(remote *Track, receiver *RTPReceiver, _ []string) {
+		if remote.Kind() != "video" {
+			return
+		}
+		remote.SetOnVideoFrame(func(*frame.VideoFrame) { decoded.Add(1) })
+		if err := receiver.SetOnEncodedFrame(func(f *EncodedVideoFrame) {
+			if !f.Keyframe {
+				return
+			}
+			copied := *f
+			copied.Data = append([]byte(nil), f.Data...)
+			select {
+			case keyframes <- copied:
+			default:
+			}
+		}); err != nil {
+			t.Errorf("SetOnEncodedFrame failed: %v", err)
+		}
+	}
+
+	negotiate(t, offerer, answerer)
+
+	done := make(chan struct{})
+	defer close(done)
+	go func() {
+		raw := frame.NewI420Frame(width, height)
+		ticker := time.NewTicker(33 * time.Millisecond)
+		defer ticker.Stop()
+		for {
+			select {
+			case <-done:
+				return
+			case <-ticker.C:
+				track.WriteVideoFrame(raw)
+			}
+		}
+	}()
+
+	select {
+	case f := <-keyframes:
+		if f.Codec != codec.VP8 {
+			t.Errorf("codec = %v, want VP8", f.Codec)
+		}
+		if f.Width != width || f.Height != height {
+			t.Errorf("keyframe is %dx%d, want %dx%d", f.Width, f.Height, width, height)
+		}
+		if len(f.Data) == 0 || f.SSRC == 0 {
+			t.Errorf("keyframe without data or SSRC: %+v", f)
+		}
+	case <-time.After(15 * time.Second):
+		t.Fatal("no encoded keyframe within 15s")
+	}
+
+	// Frames keep flowing to the discarding decoder without producing output.
+	time.Sleep(time.Second)
+	if n := decoded.Load(); n != 0 {
+		t.Errorf("received %d decoded frames with decoding disabled", n)
+	}
+}
+
+func TestVideoMailbox(t *testing.T) {
+	offerer, answerer := newLoopbackPair(t, LoopbackNetworkConfig{})
+
+	const width, height = 320, 240
+	track, err := offerer.CreateVideoTrack("video-0", codec.VP8, width, height)
+	if err != nil {
+		t.Fatalf("CreateVideoTrack failed: %v", err)
+	}
+	if _, err := offerer.AddTrack(track, "stream-0"); err != nil {
+		t.Fatalf("AddTrack failed: %v", err)
+	}
+
+	remoteTracks := make(chan *Track, 1)
+	answerer.OnTrack = func(remote *Track, _ *RTPReceiver, _ []string) {
+		if remote.Kind() != "video" {
+			return
+		}
+		if err := remote.SetVideoMailbox(0); err == nil {
+			t.Error("SetVideoMailbox accepted zero slots")
+		}
+		if err := remote.SetVideoMailbox(1); err != nil {
+			t.Errorf("SetVideoMailbox failed: %v", err)
+			return
+		}
+		remoteTracks <- remote
+	}
+
+	negotiate(t, offerer, answerer)
+
+	done := make(chan struct{})
+	defer close(done)
+	go func() {
+		raw := frame.NewI420Frame(width, height)
+		ticker := time.NewTicker(33 * time.Millisecond)
+		defer ticker.Stop()
+		for {
+			select {
+			case <-done:
+				return
+			case <-ticker.C:
+				track.WriteVideoFrame(raw)
+			}
+		}
+	}()
+
+	var remote *Track
+	select {
+	case remote = <-remoteTracks:
+	case <-time.After(10 * time.Second):
+		t.Fatal("no remote video track within 10s")
+	}
+
+	// Read far slower than the sender writes: the single slot keeps only the
+	// latest frame and counts the others as dropped.
+	var f frame.VideoFrame
+	reads := 0
+	deadline := time.After(15 * time.Second)
+	for reads < 3 || remote.DroppedVideoFrames() == 0 {
+		select {
+		case <-deadline:
+			t.Fatalf("read %d frames, %d dropped within 15s", reads, remote.DroppedVideoFrames())
+		case <-time.After(300 * time.Millisecond):
+		}
+		ok, err := remote.ReadVideoFrame(&f)
+		if err != nil {
+			t.Fatalf("ReadVideoFrame failed: %v", err)
+		}
+		if !ok {
+			continue
+		}
+		reads++
+		if f.Width != width || f.Height != height || f.Format != frame.PixelFormatI420 {
+			t.Errorf("read %dx%d format %v, want %dx%d I420", f.Width, f.Height, f.Format, width, height)
+		}
+		if len(f.Data[0]) < f.Stride[0]*height {
+			t.Errorf("Y plane holds %d bytes, want at least %d", len(f.Data[0]), f.Stride[0]*height)
+		}
+	}
+
+	// A frame handler replaces the mailbox.
+	if err := remote.SetOnVideoFrame(func(*frame.VideoFrame) {}); err != nil {
+		t.Fatalf("SetOnVideoFrame failed: %v", err)
+	}
+	if _, err := remote.ReadVideoFrame(&f); err == nil {
+		t.Error("ReadVideoFrame succeeded after the mailbox was replaced")
+	}
+
+	// The sender copied its frames into recycled buffers.
+	stats, err := track.VideoBufferPoolStats()
+	if err != nil {
+		t.Fatalf("VideoBufferPoolStats failed: %v", err)
+	}
+	if stats.Hits == 0 || stats.HitRate() < 0.5 {
+		t.Errorf("buffer pool stats %+v, want mostly hits", stats)
+	}
+}
+
+func TestEventQueueVideoFrames(t *testing.T) {
+	offerer, answerer := newLoopbackPair(t, LoopbackNetworkConfig{})
+
+	q, err := NewEventQueue(0)
+	if err != nil {
+		t.Fatalf("NewEventQueue failed: %v", err)
+	}
+	defer q.Close()
+
+	const width, height = 320, 240
+	track, err := offerer.CreateVideoTrack("video-0", codec.VP8, width, height)
+	if err != nil {
+		t.Fatalf("CreateVideoTrack failed: %v", err)
+	}
+	if _, err := offerer.AddTrack(track, "stream-0"); err != nil {
+		t.Fatalf("AddTrack failed: %v", err)
+	}
+
+	// The handler stalls the queue far longer than the sender's frame
+	// interval, so frames pile up natively and the oldest are dropped.
+	frames := make(chan [2]int, 64)
+	remoteTracks := make(chan *Track, 1)
+	answerer.OnTrack = func(remote *Track, _ *RTPReceiver, _ []string) {
+		if remote.Kind() != "video" {
+			return
+		}
+		if err := q.SetOnVideoFrame(remote, func(f *frame.VideoFrame) {
+			if len(f.Data[0]) < f.Stride[0]*f.Height {
+				t.Errorf("Y plane holds %d bytes, want at least %d", len(f.Data[0]), f.Stride[0]*f.Height)
+			}
+			select {
+			case frames <- [2]int{f.Width, f.Height}:
+			default:
+			}
+			time.Sleep(300 * time.Millisecond)
+		}); err != nil {
+			t.Errorf("EventQueue.SetOnVideoFrame failed: %v", err)
+			return
+		}
+		remoteTracks <- remote
+	}
+
+	negotiate(t, offerer, answerer)
+
+	done := make(chan struct{})
+	defer close(done)
+	go func() {
+		raw := frame.NewI420Frame(width, height)
+		ticker := time.NewTicker(33 * time.Millisecond)
+		defer ticker.Stop()
+		for {
+			select {
+			case <-done:
+				return
+			case <-ticker.C:
+				track.WriteVideoFrame(raw)
+			}
+		}
+	}()
+
+	var remote *Track
+	select {
+	case remote = <-remoteTracks:
+	case <-time.After(10 * time.Second):
+		t.Fatal("no remote video track within 10s")
+	}
+
+	received := 0
+	deadline := time.After(15 * time.Second)
+	for received < 3 || remote.DroppedVideoFrames() == 0 {
+		select {
+		case size := <-frames:
+			received++
+			if size != [2]int{width, height} {
+				t.Errorf("received %dx%d, want %dx%d", size[0], size[1], width, height)
+			}
+		case <-deadline:
+			t.Fatalf("received %d frames, %d dropped within 15s", received, remote.DroppedVideoFrames())
+		}
+	}
+
+	if err := q.SetOnVideoFrame(remote, nil); err != nil {
+		t.Fatalf("removing the queued sink failed: %v", err)
+	}
+}
+
+func TestVideoSinkWants(t *testing.T) {
+	offerer, answerer := newLoopbackPair(t, LoopbackNetworkConfig{})
+
+	const width, height = 640, 480
+	const maxPixels = 320 * 240
+	track, err := offerer.CreateVideoTrack("video-0", codec.VP8, width, height)
+	if err != nil {
+		t.Fatalf("CreateVideoTrack failed: %v", err)
+	}
+	if _, err := offerer.AddTrack(track, "stream-0"); err != nil {
+		t.Fatalf("AddTrack failed: %v", err)
+	}
+
+	var delivered atomic.Int32
+	oversized := make(chan string, 1)
+	answerer.OnTrack = func(remote *Track, _ *RTPReceiver, _ []string) {
+		if remote.Kind() != "video" {
+			return
+		}
+		// Set before the sink: the wants carry over to it.
+		if err := remote.SetVideoSinkWants(VideoSinkWants{MaxPixelCount: maxPixels, MaxFramerate: 5}); err != nil {
+			t.Errorf("SetVideoSinkWants failed: %v", err)
+		}
+		remote.SetOnVideoFrame(func(f *frame.VideoFrame) {
+			delivered.Add(1)
+			if f.Width*f.Height > maxPixels {
+				select {
+				case oversized <- fmt.Sprintf("%dx%d", f.Width, f.Height):
+				default:
+				}
+			}
+		})
+	}
+
+	negotiate(t, offerer, answerer)
+
+	done := make(chan struct{})
+	defer close(done)
+	go func() {
+		raw := frame.NewI420Frame(width, height)
+		ticker := time.NewTicker(33 * time.Millisecond)
+		defer ticker.Stop()
+		for {
+			select {
+			case <-done:
+				return
+			case <-ticker.C:
+				track.WriteVideoFrame(raw)
+			}
+		}
+	}()
+
+	deadline := time.Now().Add(15 * time.Second)
+	for delivered.Load() == 0 {
+		if time.Now().After(deadline) {
+			t.Fatal("no video frame within 15s")
+		}
+		time.Sleep(50 * time.Millisecond)
+	}
+
+	// At 30 fps sent and 5 fps wanted, two seconds deliver about 10 frames.
+	start := delivered.Load()
+	time.Sleep(2 * time.Second)
+	if n := delivered.Load() - start; n > 15 {
+		t.Errorf("delivered %d frames in 2s with a 5 fps limit", n)
+	}
+	select {
+	case size := <-oversized:
+		t.Errorf("delivered a %s frame above %d pixels", size, maxPixels)
+	default:
+	}
+}
+
+func TestPushedVideoFollowsSenderWants(t *testing.T) {
+	offerer, answerer := newLoopbackPair(t, LoopbackNetworkConfig{})
+
+	const width, height = 640, 480
+	track, err := offerer.CreateVideoTrack("video-0", codec.VP8, width, height)
+	if err != nil {
+		t.Fatalf("CreateVideoTrack failed: %v", err)
+	}
+	sender, err := offerer.AddTrack(track, "stream-0")
+	if err != nil {
+		t.Fatalf("AddTrack failed: %v", err)
+	}
+
+	var received atomic.Uint64
+	answerer.OnTrack = func(remote *Track, _ *RTPReceiver, _ []string) {
+		if remote.Kind() == "video" {
+			remote.SetOnVideoFrame(func(*frame.VideoFrame) { received.Add(1) })
+		}
+	}
+
+	negotiate(t, offerer, answerer)
+
+	done := make(chan struct{})
+	defer close(done)
+	go func() {
+		raw := frame.NewI420Frame(width, height)
+		ticker := time.NewTicker(33 * time.Millisecond)
+		defer ticker.Stop()
+		for {
+			select {
+			case <-done:
+				return
+			case <-ticker.C:
+				track.WriteVideoFrame(raw)
+			}
+		}
+	}()
+
+	deadline := time.Now().Add(15 * time.Second)
+	for received.Load() == 0 {
+		if time.Now().After(deadline) {
+			t.Fatal("no remote video frame within 15s")
+		}
+		time.Sleep(50 * time.Millisecond)
+	}
+
+	// Frames reaching the remote, and frames the source copied for the
+	// encoder rather than dropping in PushFrame, over one second.
+	measure := func() (remote, copied uint64) {
+		before, err := track.VideoBufferPoolStats()
+		if err != nil {
+			t.Fatalf("VideoBufferPoolStats failed: %v", err)
+		}
+		start := received.Load()
+		time.Sleep(time.Second)
+		after, err := track.VideoBufferPoolStats()
+		if err != nil {
+			t.Fatalf("VideoBufferPoolStats failed: %v", err)
+		}
+		return received.Load() - start, after.Hits + after.Misses - before.Hits - before.Misses
+	}
+
+	time.Sleep(time.Second)
+	remoteBefore, copiedBefore := measure()
+	if copiedBefore < 15 {
+		t.Fatalf("source copied %d frames per second before the limit, want about 30", copiedBefore)
+	}
+
+	// A frame rate cap on the encoding reaches the source as sink wants.
+	params := sender.GetParameters()
+	if len(params.Encodings) == 0 {
+		t.Fatal("sender has no encodings")
+	}
+	for i := range params.Encodings {
+		params.Encodings[i].MaxFramerate = 5
+	}
+	if err := sender.SetParameters(params); err != nil {
+		t.Fatalf("SetParameters failed: %v", err)
+	}
+
+	time.Sleep(2 * time.Second)
+	remoteAfter, copiedAfter := measure()
+	if copiedAfter > 10 {
+		t.Errorf("source copied %d frames per second at 5 fps wanted, %d before", copiedAfter, copiedBefore)
+	}
+	if remoteAfter == 0 || remoteAfter*2 > remoteBefore {
+		t.Errorf("remote received %d frames per second at 5 fps wanted, %d before", remoteAfter, remoteBefore)
+	}
+}
+
+func TestAudioSinkFormat(t *testing.T) {
+	network := newLoopbackNetwork(t, LoopbackNetworkConfig{})
+	// Remote audio is only pulled through sinks by a playing audio device.
+	factory := newTestFactory(t, FactoryConfig{Loopback: network})
+	offerer, answerer := newPeerPair(t, factory, Configuration{})
+
+	track, err := offerer.CreateAudioTrack("audio-0")
+	if err != nil {
+		t.Fatalf("CreateAudioTrack failed: %v", err)
+	}
+	if _, err := offerer.AddTrack(track, "stream-0"); err != nil {
+		t.Fatalf("AddTrack failed: %v", err)
+	}
+
+	received := make(chan *frame.AudioFrame, 1)
+	answerer.OnTrack = func(remote *Track, _ *RTPReceiver, _ []string) {
+		if remote.Kind() != "audio" {
+			return
+		}
+		if err := remote.SetAudioSinkFormat(AudioSinkFormat{Batch: 200 * time.Millisecond}); err == nil {
+			t.Error("SetAudioSinkFormat accepted a 200ms batch")
+		}
+		if err := remote.SetAudioSinkFormat(AudioSinkFormat{
+			Batch:      40 * time.Millisecond,
+			SampleRate: 16000,
+			Channels:   1,
+		}); err != nil {
+			t.Errorf("SetAudioSinkFormat failed: %v", err)
+		}
+		remote.SetOnAudioFrame(func(f *frame.AudioFrame) {
+			select {
+			case received <- f:
+			default:
+			}
+		})
+	}
+
+	negotiate(t, offerer, answerer)
+
+	done := make(chan struct{})
+	defer close(done)
+	go func() {
+		chunk := frame.NewAudioFrameS16(48000, 2, 480)
+		ticker := time.NewTicker(10 * time.Millisecond)
+		defer ticker.Stop()
+		for {
+			select {
+			case <-done:
+				return
+			case <-ticker.C:
+				track.WriteAudioFrame(chunk)
+			}
+		}
+	}()
+
+	select {
+	case f := <-received:
+		if f.SampleRate != 16000 || f.Channels != 1 {
+			t.Errorf("received %d Hz x %d channels, want 16000 Hz mono", f.SampleRate, f.Channels)
+		}
+		if f.NumSamples != 640 {
+			t.Errorf("received %d samples per channel, want 640 (40ms)", f.NumSamples)
+		}
+		if f.Timestamp == 0 {
+			t.Error("received frame without timestamp")
+		}
+	case <-time.After(10 * time.Second):
+		t.Skip("no remote audio within 10s: no audio device pulls playout")
+	}
+}
+
+func TestCongestionControl(t *testing.T) {
+	tests := []struct {
+		name string
+		cc   CongestionControl
+		// check validates an estimate once the transport is up.
+		check func(bwe *BandwidthEstimate) error
+	}{
+		{
+			name: "fixed",
+			cc:   CongestionControl{Controller: CongestionControllerFixed, StartBitrateBps: 800_000},
+			check: func(bwe *BandwidthEstimate) error {
+				if bwe.TargetBitrateBps != 800_000 || bwe.AvailableSendBps != 800_000 {
+					return fmt.Errorf("fixed controller: got target %d, link %d, want 800000",
+						bwe.TargetBitrateBps, bwe.AvailableSendBps)
+				}
+				return nil
+			},
+		},
+		{
+			name: "googcc-bounded",
+			cc:   CongestionControl{StartBitrateBps: 1_000_000, MaxBitrateBps: 400_000, DisableProbing: true},
+			check: func(bwe *BandwidthEstimate) error {
+				if bwe.TargetBitrateBps <= 0 || bwe.TargetBitrateBps > 400_000 {
+					return fmt.Errorf("bounded GoogCC: target %d outside (0, 400000]", bwe.TargetBitrateBps)
+				}
+				return nil
+			},
+		},
+	}
+
+	for _, tt := range tests {
+		t.Run(tt.name, func(t *testing.T) {
+			network := newLoopbackNetwork(t, LoopbackNetworkConfig{BandwidthKbps: 5000})
+			factory := newTestFactory(t, FactoryConfig{DisableAudioDevice: true, Loopback: network})
+			offerer, answerer := newPeerPair(t, factory, Configuration{CongestionControl: tt.cc})
+
+			var mu sync.Mutex
+			var checkErr error
+			offerer.SetOnBandwidthEstimate(func(bwe *BandwidthEstimate) {
+				if bwe.TargetBitrateBps == 0 {
+					return
+				}
+				if err := tt.check(bwe); err != nil {
+					mu.Lock()
+					if checkErr == nil {
+						checkErr = err
+					}
+					mu.Unlock()
+				}
+			})
+
+			track, err := offerer.CreateVideoTrack("video-0", codec.VP8, 640, 480)
+			if err != nil {
+				t.Fatalf("CreateVideoTrack failed: %v", err)
+			}
+			if _, err := offerer.AddTrack(track, "stream-0"); err != nil {
+				t.Fatalf("AddTrack failed: %v", err)
+			}
+
+			negotiate(t, offerer, answerer)
+
+			done := make(chan struct{})
+			defer close(done)
+			go func() {
+				f := frame.NewI420Frame(640, 480)
+				ticker := time.NewTicker(33 * time.Millisecond)
+				defer ticker.Stop()
+				for {
+					select {
+					case <-done:
+						return
+					case <-ticker.C:
+						track.WriteVideoFrame(f)
+					}
+				}
+			}()
+
+			deadline := time.Now().Add(15 * time.Second)
+			for {
+				bwe := offerer.GetCurrentBandwidthEstimate()
+				if bwe != nil && bwe.TargetBitrateBps > 0 {
+					break
+				}
+				if time.Now().After(deadline) {
+					t.Fatal("no bandwidth estimate")
+				}
+				time.Sleep(100 * time.Millisecond)
+			}
+			// Let the controller react to a couple of seconds of feedback.
+			time.Sleep(2 * time.Second)
+
+			mu.Lock()
+			defer mu.Unlock()
+			if checkErr != nil {
+				t.Error(checkErr)
+			}
+			if err := tt.check(offerer.GetCurrentBandwidthEstimate()); err != nil {
+				t.Error(err)
+			}
+		})
+	}
+}
+
+func TestVideoFrameRing(t *testing.T) {
+	offerer, answerer := newLoopbackPair(t, LoopbackNetworkConfig{})
+
+	const width, height = 320, 240
+	track, err := offerer.CreateVideoTrack("video-0", codec.VP8, width, height)
+	if err != nil {
+		t.Fatalf("CreateVideoTrack failed: %v", err)
+	}
+	sender, err := offerer.AddTrack(track, "stream-0")
+	if err != nil {
+		t.Fatalf("AddTrack failed: %v", err)
+	}
+
+	ring, err := track.NewVideoFrameRing(0)
+	if err != nil {
+		t.Fatalf("NewVideoFrameRing failed: %v", err)
+	}
+	if _, err := track.NewVideoFrameRing(0); err == nil {
+		t.Error("NewVideoFrameRing accepted a second ring")
+	}
+
+	remoteTracks := make(chan *Track, 1)
+	answerer.OnTrack = func(remote *Track, _ *RTPReceiver, _ []string) {
+		if remote.Kind() != "video" {
+			return
+		}
+		if err := remote.SetVideoMailbox(1); err != nil {
+			t.Errorf("SetVideoMailbox failed: %v", err)
+			return
+		}
+		remoteTracks <- remote
+	}
+
+	negotiate(t, offerer, answerer)
+
+	// Render straight into the ring's slots.
+	var published atomic.Int64
+	done := make(chan struct{})
+	stopped := make(chan struct{})
+	go func() {
+		defer close(stopped)
+		ticker := time.NewTicker(33 * time.Millisecond)
+		defer ticker.Stop()
+		var pts uint32
+		for {
+			select {
+			case <-done:
+				return
+			case <-ticker.C:
+			}
+			f, ok := ring.Next()
+			if !ok {
+				continue
+			}
+			if f.Width != width || f.Height != height || f.Stride[0]%64 != 0 {
+				t.Errorf("slot %dx%d stride %d, want %dx%d with 64-byte aligned rows",
+					f.Width, f.Height, f.Stride[0], width, height)
+			}
+			for i, plane := range f.Data {
+				value := byte(128)
+				if i == 0 {
+					value = byte(pts / 3000)
+				}
+				for j := range plane {
+					plane[j] = value
+				}
+			}
+			f.PTS = pts
+			pts += 3000
+			if err := ring.Publish(); err != nil {
+				t.Errorf("Publish failed: %v", err)
+				return
+			}
+			published.Add(1)
+		}
+	}()
+
+	var remote *Track
+	select {
+	case remote = <-remoteTracks:
+	case <-time.After(10 * time.Second):
+		t.Fatal("no remote video track within 10s")
+	}
+
+	var f frame.VideoFrame
+	reads := 0
+	deadline := time.After(15 * time.Second)
+	for reads < 3 {
+		select {
+		case <-deadline:
+			t.Fatalf("read %d frames of %d published within 15s", reads, published.Load())
+		case <-time.After(100 * time.Millisecond):
+		}
+		ok, err := remote.ReadVideoFrame(&f)
+		if err != nil {
+			t.Fatalf("ReadVideoFrame failed: %v", err)
+		}
+		if !ok {
+			continue
+		}
+		reads++
+		if f.Width != width || f.Height != height {
+			t.Errorf("read %dx%d, want %dx%d", f.Width, f.Height, width, height)
+		}
+	}
+	close(done)
+	<-stopped
+
+	// A disabled track drops the frame and keeps its slot.
+	track.SetEnabled(false)
+	gotSlot := false
+	for deadline := time.Now().Add(time.Second); !gotSlot && time.Now().Before(deadline); time.Sleep(10 * time.Millisecond) {
+		_, gotSlot = ring.Next()
+	}
+	if !gotSlot {
+		t.Fatal("Next handed out no slot within 1s")
+	}
+	if err := ring.Publish(); !errors.Is(err, ErrTrackDisabled) {
+		t.Errorf("Publish on a disabled track = %v, want ErrTrackDisabled", err)
+	}
+	held, ok := ring.Next()
+	if !ok {
+		t.Fatal("Next did not hand out the dropped frame's slot again")
+	}
+	track.SetEnabled(true)
+
+	// Removing the track closes its ring, once the writer is done with the
+	// slot it holds.
+	if err := offerer.RemoveTrack(sender); err != nil {
+		t.Fatalf("RemoveTrack failed: %v", err)
+	}
+	for _, plane := range held.Data {
+		plane[0] = 0
+	}
+	if _, ok := ring.Next(); ok {
+		t.Error("Next handed out a slot after the track was removed")
+	}
+	if err := ring.Publish(); !errors.Is(err, ErrVideoFrameRingClosed) {
+		t.Errorf("Publish after close = %v, want ErrVideoFrameRingClosed", err)
+	}
+}
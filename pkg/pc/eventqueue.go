@@ -0,0 +1,503 @@
+package pc
+
+import (
+	"errors"
+	"fmt"
+	"os"
+	"sync"
+	"sync/atomic"
+	"time"
+	"unsafe"
+
+	"github.com/thesyncim/libgowebrtc/internal/ffi"
+	"github.com/thesyncim/libgowebrtc/pkg/frame"
+)
+
+// ErrEventQueueClosed is returned when attaching to a closed EventQueue.
+var ErrEventQueueClosed = errors.New("event queue closed")
+
+const (
+	eventQueueBatch       = 256
+	eventQueuePayloadSize = 1 << 20
+)
+
+// EventQueue delivers events for many PeerConnections, DataChannels and
+// remote tracks from a single goroutine.
+//
+// By default each event crosses from a libwebrtc thread into Go through its
+// own callback. Objects attached to an EventQueue instead push events into a
+// bounded native ring that is drained in batches whenever its file descriptor
+// becomes readable, so a burst of events costs one wakeup instead of one
+// callback each. Handlers run on the queue's goroutine, never on a libwebrtc
+// thread, and may call back into the PeerConnection.
+//
+// When the ring is full new events are dropped; see Dropped.
+type EventQueue struct {
+	handle uintptr
+	file   *os.File
+
+	mu       sync.RWMutex
+	handlers map[uint64]func(ev *ffi.Event, payload []byte)
+	nextTag  atomic.Uint64
+	dropped  atomic.Uint64
+
+	closeOnce sync.Once
+	done      chan struct{}
+}
+
+// NewEventQueue creates an event queue holding up to capacity pending events
+// and starts its delivery goroutine. Zero selects the default capacity (4096).
+func NewEventQueue(capacity int) (*EventQueue, error) {
+	if err := ffi.LoadLibrary(); err != nil {
+		return nil, err
+	}
+	if capacity < 0 {
+		return nil, fmt.Errorf("create event queue: invalid capacity %d", capacity)
+	}
+
+	handle, err := ffi.CreateEventQueue(capacity)
+	if err != nil {
+		return nil, fmt.Errorf("create event queue: %w", err)
+	}
+
+	// The fd belongs to the native queue; poll a duplicate so closing the
+	// *os.File does not close it underneath the shim.
+	fd, err := dupEventFD(ffi.EventQueueFD(handle))
+	if err != nil {
+		ffi.EventQueueDestroy(handle)
+		return nil, fmt.Errorf("create event queue: %w", err)
+	}
+
+	q := &EventQueue{
+		handle:   handle,
+		file:     os.NewFile(uintptr(fd), "shim-event-queue"),
+		handlers: make(map[uint64]func(ev *ffi.Event, payload []byte)),
+		done:     make(chan struct{}),
+	}
+	go q.run()
+	return q, nil
+}
+
+// Dropped returns the number of events dropped because the queue was full.
+func (q *EventQueue) Dropped() uint64 {
+	return q.dropped.Load()
+}
+
+// AttachPeerConnection routes pc's observer events, and those of its data
+// channels, through the queue. The PeerConnection's On* handlers are then
+// called from the queue's goroutine.
+func (q *EventQueue) AttachPeerConnection(pc *PeerConnection) error {
+	if pc.closed.Load() {
+		return ErrPeerConnectionClosed
+	}
+	tag, err := q.register(func(ev *ffi.Event, payload []byte) {
+		q.dispatchPeerConnection(pc, ev, payload)
+	})
+	if err != nil {
+		return err
+	}
+
+	pc.mu.Lock()
+	defer pc.mu.Unlock()
+
+	if !pc.eventQueue.CompareAndSwap(nil, q) {
+		q.unregister(tag)
+		return errors.New("peer connection already attached to an event queue")
+	}
+	pc.eventTag = tag
+	ffi.PeerConnectionSetEventQueue(pc.handle, q.handle, tag)
+	return nil
+}
+
+// SetOnVideoFrame is Track.SetOnVideoFrame with frames delivered through the
+// queue. Decoded frames wait natively, a few at most, and the queue only
+// carries a notice for each; frames the handler falls behind on are dropped
+// and counted by Track.DroppedVideoFrames. The frame's planes alias native
+// memory and are only valid until the handler returns. Pass nil to remove
+// the sink.
+func (q *EventQueue) SetOnVideoFrame(t *Track, handler VideoFrameHandler) error {
+	if t.kind != "video" {
+		return errors.New("not a video track")
+	}
+	if t.handle == 0 {
+		return errors.New("track handle not initialized")
+	}
+
+	t.mu.Lock()
+	defer t.mu.Unlock()
+
+	t.removeQueuedSink()
+	t.removeVideoMailbox()
+	if t.onVideoFrame != nil {
+		ffi.TrackRemoveVideoSink(t.handle)
+		ffi.UnregisterVideoCallback(t.handle)
+		t.onVideoFrame = nil
+	}
+	if handler == nil {
+		return nil
+	}
+
+	tag, err := q.register(func(ev *ffi.Event, _ []byte) {
+		if ev.Type == ffi.EventVideoFrame {
+			q.deliverVideoFrame(t)
+		}
+	})
+	if err != nil {
+		return err
+	}
+	if err := ffi.TrackSetVideoSinkEventQueue(t.handle, q.handle, tag); err != nil {
+		q.unregister(tag)
+		return err
+	}
+
+	t.onVideoFrame = handler
+	t.sinkQueue = q
+	t.sinkTag = tag
+	t.framesDropped.Store(0)
+	return t.applySinkWants()
+}
+
+// SetOnAudioFrame is Track.SetOnAudioFrame with frames delivered through the
+// queue. Pass nil to remove the sink.
+func (q *EventQueue) SetOnAudioFrame(t *Track, handler AudioFrameHandler) error {
+	if t.kind != "audio" {
+		return errors.New("not an audio track")
+	}
+	if t.handle == 0 {
+		return errors.New("track handle not initialized")
+	}
+
+	t.mu.Lock()
+	defer t.mu.Unlock()
+
+	t.removeQueuedSink()
+	if t.onAudioFrame != nil {
+		ffi.TrackRemoveAudioSink(t.handle)
+		ffi.UnregisterAudioCallback(t.handle)
+		t.onAudioFrame = nil
+	}
+	if handler == nil {
+		return nil
+	}
+
+	tag, err := q.register(func(ev *ffi.Event, payload []byte) {
+		if ev.Type != ffi.EventAudioFrame || len(payload) < 2 {
+			return
+		}
+		samples := unsafe.Slice((*int16)(unsafe.Pointer(&payload[0])), len(payload)/2)
+		f := frame.NewAudioFrameFromS16(samples, int(ev.Value), int(ev.Width))
+		f.Timestamp = time.Duration(ev.TimestampUs) * time.Microsecond
+		f.PTS = uint32(ev.TimestampUs / 1000) // Convert to milliseconds
+		f.CaptureTime = time.Duration(ev.CaptureTimeUs) * time.Microsecond
+		f.HasCaptureTime = ev.HasCaptureTime != 0
+		handler(f)
+	})
+	if err != nil {
+		return err
+	}
+	if err := ffi.TrackSetAudioSinkEventQueue(t.handle, q.handle, tag); err != nil {
+		q.unregister(tag)
+		return err
+	}
+
+	t.onAudioFrame = handler
+	t.sinkQueue = q
+	t.sinkTag = tag
+	return t.applySinkFormat()
+}
+
+// SetOnRTCPFeedback is RTPSender.SetOnRTCPFeedbackBatch with feedback
+// delivered through the queue. Pass nil to stop reporting.
+func (q *EventQueue) SetOnRTCPFeedback(s *RTPSender, interval time.Duration, handler func([]RTCPFeedback)) error {
+	intervalMs, err := rtcpFeedbackIntervalMs(interval)
+	if err != nil {
+		return err
+	}
+
+	s.mu.RLock()
+	defer s.mu.RUnlock()
+
+	if s.handle == 0 || s.pc == nil {
+		return errors.New("sender not initialized")
+	}
+	pcHandle, err := s.pc.rlockHandle()
+	if err != nil {
+		return err
+	}
+	defer s.pc.mu.RUnlock()
+
+	s.feedbackMu.Lock()
+	defer s.feedbackMu.Unlock()
+
+	s.removeQueuedFeedback(pcHandle)
+	if handler == nil {
+		ffi.RTPSenderSetOnRTCPFeedback(pcHandle, s.handle, 0, nil)
+		return nil
+	}
+
+	tag, err := q.register(func(ev *ffi.Event, payload []byte) {
+		if ev.Type != ffi.EventRTCPFeedback {
+			return
+		}
+		handler(convertRTCPFeedback(ffi.RTCPFeedbackFromPayload(payload)))
+	})
+	if err != nil {
+		return err
+	}
+	// Attach the queue before dropping the callback so the sender keeps its
+	// counters.
+	ffi.RTPSenderSetRTCPFeedbackEventQueue(pcHandle, s.handle, q.handle, tag, intervalMs)
+	ffi.RTPSenderSetOnRTCPFeedback(pcHandle, s.handle, intervalMs, nil)
+
+	s.feedbackQueue = q
+	s.feedbackTag = tag
+	return nil
+}
+
+// SetOnEncodedFrame is RTPReceiver.SetOnEncodedFrame with frames delivered
+// through the queue. Pass nil to remove the sink.
+func (q *EventQueue) SetOnEncodedFrame(r *RTPReceiver, handler func(*EncodedVideoFrame)) error {
+	if r.handle == 0 || r.pc == nil {
+		return errors.New("receiver not initialized")
+	}
+	if _, err := r.pc.rlockHandle(); err != nil {
+		return err
+	}
+	defer r.pc.mu.RUnlock()
+
+	r.encodedMu.Lock()
+	defer r.encodedMu.Unlock()
+
+	r.removeQueuedEncodedSink(true)
+	if handler == nil {
+		if !r.onEncoded {
+			return nil
+		}
+		r.onEncoded = false
+		return ffi.RTPReceiverSetOnEncodedFrame(r.handle, nil)
+	}
+
+	tag, err := q.register(func(ev *ffi.Event, payload []byte) {
+		if ev.Type != ffi.EventEncodedVideoFrame {
+			return
+		}
+		info, data, ok := ffi.EncodedFrameFromPayload(payload)
+		if !ok {
+			return
+		}
+		handler(convertEncodedFrame(&info, data))
+	})
+	if err != nil {
+		return err
+	}
+	// Attach the queue before dropping the callback so the receiver keeps
+	// its sink installed.
+	if err := ffi.RTPReceiverSetEncodedFrameEventQueue(r.handle, q.handle, tag); err != nil {
+		q.unregister(tag)
+		return err
+	}
+	if r.onEncoded {
+		_ = ffi.RTPReceiverSetOnEncodedFrame(r.handle, nil)
+		r.onEncoded = false
+	}
+
+	r.encodedQueue = q
+	r.encodedTag = tag
+	return nil
+}
+
+// Close stops delivery and releases the queue. Objects still attached keep
+// running but their events are discarded. Must not be called from a handler.
+func (q *EventQueue) Close() error {
+	q.closeOnce.Do(func() {
+		q.mu.Lock()
+		q.handlers = nil
+		q.mu.Unlock()
+
+		// Closing the file unblocks the pending Read in run.
+		q.file.Close()
+		<-q.done
+		ffi.EventQueueDestroy(q.handle)
+	})
+	return nil
+}
+
+// attachDataChannel routes dc's events through the queue. Failures leave the
+// channel on its callbacks.
+func (q *EventQueue) attachDataChannel(dc *DataChannel) {
+	tag, err := q.register(func(ev *ffi.Event, payload []byte) {
+		q.dispatchDataChannel(dc, ev, payload)
+	})
+	if err != nil {
+		return
+	}
+	dc.eventQueue = q
+	dc.eventTag = tag
+	ffi.DataChannelSetEventQueue(dc.handle, q.handle, tag)
+}
+
+func (q *EventQueue) register(handler func(ev *ffi.Event, payload []byte)) (uint64, error) {
+	q.mu.Lock()
+	defer q.mu.Unlock()
+
+	if q.handlers == nil {
+		return 0, ErrEventQueueClosed
+	}
+	tag := q.nextTag.Add(1)
+	q.handlers[tag] = handler
+	return tag, nil
+}
+
+func (q *EventQueue) unregister(tag uint64) {
+	q.mu.Lock()
+	defer q.mu.Unlock()
+
+	if q.handlers != nil {
+		delete(q.handlers, tag)
+	}
+}
+
+func (q *EventQueue) run() {
+	defer close(q.done)
+
+	events := make([]ffi.Event, eventQueueBatch)
+	payload := make([]byte, eventQueuePayloadSize)
+	var wake [64]byte
+
+	for {
+		// One read clears the notification however many events are pending.
+		if _, err := q.file.Read(wake[:]); err != nil {
+			return
+		}
+
+		for {
+			count, used, dropped, err := ffi.EventQueueDrain(q.handle, events, payload)
+			if dropped > 0 {
+				q.dropped.Add(dropped)
+			}
+			if errors.Is(err, ffi.ErrBufferTooSmall) {
+				// The next payload (e.g. a large video frame) needs used bytes.
+				payload = make([]byte, max(used, 2*len(payload)))
+				continue
+			}
+			if err != nil || count == 0 {
+				break
+			}
+
+			q.dispatch(events[:count], payload)
+			if count < len(events) {
+				break
+			}
+		}
+	}
+}
+
+func (q *EventQueue) dispatch(events []ffi.Event, payload []byte) {
+	for i := range events {
+		ev := &events[i]
+
+		// Handlers may attach new objects, so the lock is not held across them.
+		q.mu.RLock()
+		handler := q.handlers[ev.Tag]
+		q.mu.RUnlock()
+
+		if handler != nil {
+			handler(ev, ev.Payload(payload))
+		}
+	}
+}
+
+func (q *EventQueue) dispatchPeerConnection(pc *PeerConnection, ev *ffi.Event, payload []byte) {
+	switch ev.Type {
+	case ffi.EventICECandidate:
+		// Payload is "candidate\x00sdp_mid"
+		candidate, sdpMid := string(payload), ""
+		for i, b := range payload {
+			if b == 0 {
+				candidate, sdpMid = string(payload[:i]), string(payload[i+1:])
+				break
+			}
+		}
+		pc.handleICECandidate(candidate, sdpMid, int(ev.Value))
+	case ffi.EventConnectionState:
+		pc.handleConnectionStateChange(int(ev.Value))
+	case ffi.EventICEConnectionState:
+		pc.handleICEConnectionStateChange(int(ev.Value))
+	case ffi.EventICEGatheringState:
+		pc.handleICEGatheringStateChange(int(ev.Value))
+	case ffi.EventSignalingState:
+		pc.handleSignalingStateChange(int(ev.Value))
+	case ffi.EventNegotiationNeeded:
+		pc.handleNegotiationNeeded()
+	case ffi.EventTrack:
+		pc.handleTrack(ev.Object, ev.Object2, "")
+	case ffi.EventDataChannel:
+		pc.handleDataChannel(ev.Object)
+	}
+}
+
+func (q *EventQueue) dispatchDataChannel(dc *DataChannel, ev *ffi.Event, payload []byte) {
+	switch ev.Type {
+	case ffi.EventDataChannelOpen:
+		if dc.onOpen != nil {
+			dc.onOpen()
+		}
+	case ffi.EventDataChannelClose:
+		if dc.onClose != nil {
+			dc.onClose()
+		}
+	case ffi.EventDataChannelMessage:
+		if dc.onMessage != nil {
+			// Copy out of the drain buffer, which is reused for the next batch
+			dc.onMessage(append([]byte{}, payload...))
+		}
+	}
+}
+
+// removeQueuedSink detaches a sink installed through an EventQueue.
+// Must be called with t.mu held.
+// deliverVideoFrame pulls the frame a SHIM_EVENT_VIDEO_FRAME notice
+// announced and hands it to the track's handler. A notice may find the
+// frame already dropped, or the sink replaced, and then does nothing.
+func (q *EventQueue) deliverVideoFrame(t *Track) {
+	t.mu.Lock()
+	if t.sinkQueue != q {
+		t.mu.Unlock()
+		return
+	}
+	handler := t.onVideoFrame
+	mf, dropped, err := ffi.TrackPullVideoFrame(t.handle)
+	if err == nil {
+		t.framesDropped.Store(dropped)
+	}
+	t.mu.Unlock()
+	if mf == nil {
+		return
+	}
+	defer mf.Release()
+
+	handler(&frame.VideoFrame{
+		Width:  mf.Width,
+		Height: mf.Height,
+		Format: frame.PixelFormatI420,
+		Data:   [][]byte{mf.Plane(0), mf.Plane(1), mf.Plane(2)},
+		Stride: []int{mf.Strides[0], mf.Strides[1], mf.Strides[2]},
+		PTS:    uint32(mf.TimestampUs / 1000), // Convert to milliseconds
+	})
+}
+
+func (t *Track) removeQueuedSink() {
+	if t.sinkQueue == nil {
+		return
+	}
+	if t.kind == "video" {
+		ffi.TrackRemoveVideoSink(t.handle)
+	} else {
+		ffi.TrackRemoveAudioSink(t.handle)
+	}
+	t.sinkQueue.unregister(t.sinkTag)
+	t.sinkQueue = nil
+	t.sinkTag = 0
+	t.onVideoFrame = nil
+	t.onAudioFrame = nil
+}
@@ -0,0 +1,11 @@
+//go:build !unix
+
+package pc
+
+import "github.com/thesyncim/libgowebrtc/internal/ffi"
+
+// dupEventFD reports that event queues need a pollable fd, which the shim
+// only provides on POSIX platforms.
+func dupEventFD(fd int) (int, error) {
+	return -1, ffi.ErrNotSupported
+}
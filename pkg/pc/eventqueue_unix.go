@@ -0,0 +1,18 @@
+//go:build unix
+
+package pc
+
+import "syscall"
+
+// dupEventFD duplicates the queue's notification fd for the Go poller.
+func dupEventFD(fd int) (int, error) {
+	syscall.ForkLock.RLock()
+	defer syscall.ForkLock.RUnlock()
+
+	dup, err := syscall.Dup(fd)
+	if err != nil {
+		return -1, err
+	}
+	syscall.CloseOnExec(dup)
+	return dup, nil
+}
@@ -0,0 +1,141 @@
+package pc
+
+import (
+	"errors"
+	"fmt"
+	"sync"
+
+	"github.com/thesyncim/libgowebrtc/internal/ffi"
+)
+
+// ErrFactoryClosed is returned when creating a PeerConnection from a closed Factory.
+var ErrFactoryClosed = errors.New("peer connection factory closed")
+
+// VideoCodecFactory selects which video encoder/decoder factories a Factory uses.
+type VideoCodecFactory int
+
+const (
+	// VideoCodecFactoryAuto uses the builtin factories unless
+	// LIBWEBRTC_PREFER_SOFTWARE_CODECS is set.
+	VideoCodecFactoryAuto VideoCodecFactory = iota
+	// VideoCodecFactoryBuiltin uses the builtin factories, including
+	// hardware codecs where the platform provides them.
+	VideoCodecFactoryBuiltin
+	// VideoCodecFactorySoftware uses only libwebrtc's internal software codecs.
+	VideoCodecFactorySoftware
+)
+
+// FactoryConfig configures the media engine owned by a Factory.
+// The zero value matches the engine NewPeerConnection builds.
+type FactoryConfig struct {
+	VideoCodecs VideoCodecFactory
+
+	// DisableAudioDevice replaces the platform audio device module with a
+	// dummy one. Use it for servers that never play or capture audio locally.
+	DisableAudioDevice bool
+
+	// DisableAudioProcessing skips the audio processing module
+	// (echo cancellation, noise suppression, gain control).
+	DisableAudioProcessing bool
+
+	// UDPMuxPort, when non-zero, makes every PeerConnection created from the
+	// factory share one UDP socket per address family bound to this port
+	// instead of opening sockets of its own, so a server needs a single
+	// firewall rule and a constant number of file descriptors. Shard i of a
+	// ThreadGroup binds UDPMuxPort+i. Linux and macOS only.
+	//
+	// Packets are routed to connections by remote address and ICE username
+	// fragment; TURN relays are not demultiplexed and should not be combined
+	// with the mux.
+	UDPMuxPort int
+
+	// UDPMuxAddress optionally restricts the mux, and host candidates, to a
+	// single local IP.
+	UDPMuxAddress string
+
+	// Loopback, when set, connects the factory's PeerConnections over an
+	// in-process network instead of UDP. It cannot be combined with UDPMuxPort.
+	Loopback *LoopbackNetwork
+
+	// DisableVideoDecoding makes the factory's PeerConnections receive video
+	// without decoding it, for recorders and relays that only need the
+	// bitstream. Remote video tracks then deliver no decoded frames; use
+	// RTPReceiver.SetOnEncodedFrame. Sending is unaffected.
+	DisableVideoDecoding bool
+}
+
+func (cfg FactoryConfig) toFFI() *ffi.PeerConnectionFactoryConfig {
+	ffiConfig := &ffi.PeerConnectionFactoryConfig{
+		VideoCodecFactory: int32(cfg.VideoCodecs),
+	}
+	if cfg.DisableAudioDevice {
+		ffiConfig.DisableAudioDevice = 1
+	}
+	if cfg.DisableAudioProcessing {
+		ffiConfig.DisableAudioProcessing = 1
+	}
+	if cfg.DisableVideoDecoding {
+		ffiConfig.DisableVideoDecoding = 1
+	}
+	ffiConfig.UDPMuxPort = int32(cfg.UDPMuxPort)
+	if cfg.UDPMuxAddress != "" {
+		// Referenced from the config, so it lives as long as the config does.
+		ffiConfig.UDPMuxAddress = &ffi.CString(cfg.UDPMuxAddress)[0]
+	}
+	if cfg.Loopback != nil {
+		// Callers hold the network with acquire while the config is in use.
+		ffiConfig.LoopbackNetwork = cfg.Loopback.handle
+	}
+	return ffiConfig
+}
+
+// Factory owns a libwebrtc media engine (codec factories, audio device and
+// audio processing) that is shared by every PeerConnection it creates.
+//
+// Building the engine is the dominant cost of NewPeerConnection, so servers
+// creating many connections should create one Factory and reuse it.
+// Closing a Factory does not affect PeerConnections already created from it.
+type Factory struct {
+	handle uintptr
+	mu     sync.RWMutex
+}
+
+// NewFactory creates a shared PeerConnection factory.
+func NewFactory(cfg FactoryConfig) (*Factory, error) {
+	if err := ffi.LoadLibrary(); err != nil {
+		return nil, err
+	}
+	if err := cfg.Loopback.acquire(); err != nil {
+		return nil, err
+	}
+	defer cfg.Loopback.release()
+
+	handle, err := ffi.CreatePeerConnectionFactory(cfg.toFFI())
+	if err != nil {
+		return nil, fmt.Errorf("create peer connection factory: %w", err)
+	}
+	return &Factory{handle: handle}, nil
+}
+
+// NewPeerConnection creates a PeerConnection that uses this factory's media engine.
+func (f *Factory) NewPeerConnection(config Configuration) (*PeerConnection, error) {
+	f.mu.RLock()
+	defer f.mu.RUnlock()
+
+	if f.handle == 0 {
+		return nil, ErrFactoryClosed
+	}
+	return newPeerConnection(f.handle, config)
+}
+
+// Close releases the factory handle.
+func (f *Factory) Close() error {
+	f.mu.Lock()
+	defer f.mu.Unlock()
+
+	if f.handle != 0 {
+		ffi.PeerConnectionFactoryDestroy(f.handle)
+		f.handle = 0
+	}
+	return nil
+}
@@ -7,6 +7,7 @@ import (
 	"fmt"
 	"sync"
 	"sync/atomic"
+	"time"
 
 	"github.com/thesyncim/libgowebrtc/internal/ffi"
 	"github.com/thesyncim/libgowebrtc/pkg/codec"
@@ -193,6 +194,34 @@ type ICEServer struct {
 	Credential string
 }
 
+// CongestionController selects a PeerConnection's congestion controller.
+type CongestionController int
+
+const (
+	// CongestionControllerGoogCC is libwebrtc's delay- and loss-based
+	// controller (GCC), the default.
+	CongestionControllerGoogCC CongestionController = ffi.NetworkControllerGoogCC
+	// CongestionControllerFixed sends at CongestionControl.StartBitrateBps
+	// regardless of loss and delay. Use it only on provisioned links, such
+	// as between datacenters, where backing off only costs throughput.
+	CongestionControllerFixed CongestionController = ffi.NetworkControllerFixed
+)
+
+// CongestionControl configures a PeerConnection's congestion controller.
+// The zero value is GoogCC with libwebrtc's defaults.
+type CongestionControl struct {
+	Controller CongestionController
+
+	// StartBitrateBps is GoogCC's initial estimate, or the fixed rate.
+	StartBitrateBps int
+	// MinBitrateBps and MaxBitrateBps bound the target rate; zero is unbounded.
+	MinBitrateBps int
+	MaxBitrateBps int
+	// DisableProbing stops GoogCC from sending bandwidth probes, so it only
+	// ramps up on the media it actually sends.
+	DisableProbing bool
+}
+
 // Configuration for PeerConnection.
 type Configuration struct {
 	ICEServers           []ICEServer
@@ -202,6 +231,17 @@ type Configuration struct {
 	PeerIdentity         string
 	SDPSemantics         string // "unified-plan" or "plan-b"
 	ICECandidatePoolSize int
+
+	// Server-oriented options; zero values keep libwebrtc's defaults.
+	CandidateNetworkPolicy string        // "all" or "low-cost"
+	TCPCandidatePolicy     string        // "enabled" or "disabled"
+	PortRangeMin           int           // Local port range for candidates; both 0 = any
+	PortRangeMax           int           // Upper bound of the port range, inclusive
+	ContinualGathering     bool          // Keep gathering candidates as networks change
+	ICECheckInterval       time.Duration // STUN check interval once connectivity is strong
+	ICECheckMinInterval    time.Duration // Minimum interval between checks on one pair
+
+	CongestionControl CongestionControl
 }
 
 // DefaultConfiguration returns a default configuration.
@@ -216,17 +256,46 @@ func DefaultConfiguration() Configuration {
 	}
 }
 
-// OfferOptions for createOffer.
+// ServerConfiguration returns a configuration for server-side endpoints with
+// many connections: no STUN servers, one bundled transport with RTCP muxed,
+// UDP host candidates only and relaxed connectivity checks. Set PortRangeMin
+// and PortRangeMax to confine candidates to firewall-opened ports.
+func ServerConfiguration() Configuration {
+	return Configuration{
+		BundlePolicy:           "max-bundle",
+		RTCPMuxPolicy:          "require",
+		SDPSemantics:           "unified-plan",
+		CandidateNetworkPolicy: "low-cost",
+		TCPCandidatePolicy:     "disabled",
+		ICECheckInterval:       2500 * time.Millisecond,
+	}
+}
+
+// OfferOptions for createOffer. Nil options keep voice activity detection on.
 type OfferOptions struct {
 	ICERestart             bool
 	VoiceActivityDetection bool
 }
 
-// AnswerOptions for createAnswer.
+func (o *OfferOptions) ffiOptions() *ffi.OfferAnswerOptions {
+	if o == nil {
+		return nil
+	}
+	return &ffi.OfferAnswerOptions{ICERestart: o.ICERestart, VoiceActivityDetection: o.VoiceActivityDetection}
+}
+
+// AnswerOptions for createAnswer. Nil options keep voice activity detection on.
 type AnswerOptions struct {
 	VoiceActivityDetection bool
 }
 
+func (o *AnswerOptions) ffiOptions() *ffi.OfferAnswerOptions {
+	if o == nil {
+		return nil
+	}
+	return &ffi.OfferAnswerOptions{VoiceActivityDetection: o.VoiceActivityDetection}
+}
+
 // CodecCapability represents a supported codec.
 type CodecCapability struct {
 	MimeType    string
@@ -280,6 +349,11 @@ type RTPSender struct {
 	pc     *PeerConnection
 	id     string
 	mu     sync.RWMutex
+
+	// RTCP feedback routed through an EventQueue; taken after pc.mu.
+	feedbackMu    sync.Mutex
+	feedbackQueue *EventQueue
+	feedbackTag   uint64
 }
 
 // IsValid returns true if the sender has a valid native handle.
@@ -385,16 +459,22 @@ func (s *RTPSender) GetParameters() RTPSendParameters {
 	return params
 }
 
-// GetStats gets statistics for this sender.
+// GetStats gets statistics for this sender. Only the sender's streams are
+// collected, not the full PeerConnection report.
 func (s *RTPSender) GetStats() (*RTCStats, error) {
 	s.mu.RLock()
 	defer s.mu.RUnlock()
 
-	if s.handle == 0 {
+	if s.handle == 0 || s.pc == nil {
 		return nil, errors.New("sender not initialized")
 	}
+	pcHandle, err := s.pc.rlockHandle()
+	if err != nil {
+		return nil, err
+	}
+	defer s.pc.mu.RUnlock()
 
-	ffiStats, err := ffi.RTPSenderGetStats(s.handle)
+	ffiStats, err := ffi.RTPSenderGetStats(pcHandle, s.handle)
 	if err != nil {
 		return nil, err
 	}
@@ -438,18 +518,86 @@ func (s *RTPSender) GetActiveLayers() (spatial, temporal int, err error) {
 	return ffi.RTPSenderGetActiveLayers(s.handle)
 }
 
-// SetOnRTCPFeedback sets a callback for RTCP feedback events.
+// SetOnRTCPFeedback sets a callback for RTCP feedback events. It is called
+// once for each feedback type and SSRC received in a batch; use
+// SetOnRTCPFeedbackBatch for the counts. Pass nil to stop reporting.
+//
+// Wire it to pkg/track's VideoTrack.HandleRTCPFeedback only for tracks whose
+// frames pass through this sender's encoder; tracks of a Pion
+// PeerConnection get their feedback from Pion.
 func (s *RTPSender) SetOnRTCPFeedback(cb func(feedbackType RTCPFeedbackType, ssrc uint32)) {
-	s.mu.Lock()
-	defer s.mu.Unlock()
-
-	if s.handle == 0 {
+	if cb == nil {
+		_ = s.SetOnRTCPFeedbackBatch(0, nil)
 		return
 	}
+	_ = s.SetOnRTCPFeedbackBatch(0, func(batch []RTCPFeedback) {
+		for i := range batch {
+			cb(batch[i].Type, batch[i].SSRC)
+		}
+	})
+}
+
+// SetOnRTCPFeedbackBatch reports the RTCP feedback received for this sender.
+// Keyframe requests are reported as they reach the sender's encoder, as PLI
+// since the encoder cannot tell a FIR from a PLI; a request is reported to
+// every sender of the same track. NACK counts are read from the sender's
+// stats at most once per interval (zero selects 1s) and reported for
+// intervals with NACKs. REMB and TWCC are reported by
+// PeerConnection.SetOnTransportFeedback. The handler runs on a libwebrtc
+// thread. Replaces any handler set through SetOnRTCPFeedback or an
+// EventQueue. Pass nil to stop reporting.
+func (s *RTPSender) SetOnRTCPFeedbackBatch(interval time.Duration, handler func([]RTCPFeedback)) error {
+	intervalMs, err := rtcpFeedbackIntervalMs(interval)
+	if err != nil {
+		return err
+	}
+
+	s.mu.RLock()
+	defer s.mu.RUnlock()
+
+	if s.handle == 0 || s.pc == nil {
+		return errors.New("sender not initialized")
+	}
+	pcHandle, err := s.pc.rlockHandle()
+	if err != nil {
+		return err
+	}
+	defer s.pc.mu.RUnlock()
+
+	s.feedbackMu.Lock()
+	defer s.feedbackMu.Unlock()
 
-	ffi.RTPSenderSetOnRTCPFeedback(s.handle, func(feedbackType int, ssrc uint32) {
-		cb(RTCPFeedbackType(feedbackType), ssrc)
+	s.removeQueuedFeedback(pcHandle)
+	if handler == nil {
+		ffi.RTPSenderSetOnRTCPFeedback(pcHandle, s.handle, 0, nil)
+		return nil
+	}
+	ffi.RTPSenderSetOnRTCPFeedback(pcHandle, s.handle, intervalMs, func(records []ffi.RTCPFeedback) {
+		handler(convertRTCPFeedback(records))
 	})
+	return nil
+}
+
+// removeQueuedFeedback detaches feedback delivered through an EventQueue.
+// A zero pcHandle skips the native call, for PeerConnections being destroyed.
+// Must be called with s.feedbackMu held.
+func (s *RTPSender) removeQueuedFeedback(pcHandle uintptr) {
+	if s.feedbackQueue == nil {
+		return
+	}
+	if pcHandle != 0 {
+		ffi.RTPSenderSetRTCPFeedbackEventQueue(pcHandle, s.handle, 0, 0, 0)
+	}
+	s.feedbackQueue.unregister(s.feedbackTag)
+	s.feedbackQueue = nil
+	s.feedbackTag = 0
+}
+
+func rtcpFeedbackIntervalMs(interval time.Duration) (int, error) {
+	if interval < 0 || (interval > 0 && interval < time.Millisecond) {
+		return 0, fmt.Errorf("rtcp feedback: interval %v below 1ms", interval)
+	}
+	return int(interval / time.Millisecond), nil
 }
 
 // SetScalabilityMode sets the SVC scalability mode (e.g., "L3T3_KEY", "L1T2").
@@ -526,6 +674,8 @@ const (
 	RTCPFeedbackTypePLI  RTCPFeedbackType = 0
 	RTCPFeedbackTypeFIR  RTCPFeedbackType = 1
 	RTCPFeedbackTypeNACK RTCPFeedbackType = 2
+	RTCPFeedbackTypeREMB RTCPFeedbackType = 3
+	RTCPFeedbackTypeTWCC RTCPFeedbackType = 4
 )
 
 func (t RTCPFeedbackType) String() string {
@@ -536,11 +686,48 @@ func (t RTCPFeedbackType) String() string {
 		return "FIR"
 	case RTCPFeedbackTypeNACK:
 		return "NACK"
+	case RTCPFeedbackTypeREMB:
+		return "REMB"
+	case RTCPFeedbackTypeTWCC:
+		return "TWCC"
 	default:
 		return "unknown"
 	}
 }
 
+// RTCPFeedback is the feedback of one type received since the previous batch.
+type RTCPFeedback struct {
+	Type RTCPFeedbackType
+	// SSRC of the media stream for PLI, FIR and NACK. REMB and TWCC apply to
+	// the whole transport: their SSRC is 0 and they are reported once per
+	// PeerConnection.
+	SSRC uint32
+	// Count is the number of messages received; for TWCC, the number of
+	// packets they reported on.
+	Count int
+	// Lost is the number of packets TWCC reported lost.
+	Lost int
+	// BitrateBps is the latest REMB estimate.
+	BitrateBps  int64
+	TimestampUs int64
+}
+
+func convertRTCPFeedback(records []ffi.RTCPFeedback) []RTCPFeedback {
+	batch := make([]RTCPFeedback, len(records))
+	for i := range records {
+		r := &records[i]
+		batch[i] = RTCPFeedback{
+			Type:        RTCPFeedbackType(r.Type),
+			SSRC:        r.SSRC,
+			Count:       int(r.Count),
+			Lost:        int(r.Lost),
+			BitrateBps:  r.BitrateBps,
+			TimestampUs: r.TimestampUs,
+		}
+	}
+	return batch
+}
+
 // RTCStats represents connection statistics.
 type RTCStats struct {
 	TimestampUs              int64
@@ -672,6 +859,12 @@ type RTPReceiver struct {
 	handle uintptr
 	track  *Track
 	pc     *PeerConnection
+
+	// Encoded frame sink; taken after pc.mu.
+	encodedMu    sync.Mutex
+	onEncoded    bool
+	encodedQueue *EventQueue
+	encodedTag   uint64
 }
 
 // IsValid returns true if the receiver has a valid native handle.
@@ -684,13 +877,19 @@ func (r *RTPReceiver) Track() *Track {
 	return r.track
 }
 
-// GetStats gets statistics for this receiver.
+// GetStats gets statistics for this receiver. Only the receiver's streams
+// are collected, not the full PeerConnection report.
 func (r *RTPReceiver) GetStats() (*RTCStats, error) {
-	if r.handle == 0 {
+	if r.handle == 0 || r.pc == nil {
 		return nil, errors.New("receiver not initialized")
 	}
+	pcHandle, err := r.pc.rlockHandle()
+	if err != nil {
+		return nil, err
+	}
+	defer r.pc.mu.RUnlock()
 
-	ffiStats, err := ffi.RTPReceiverGetStats(r.handle)
+	ffiStats, err := ffi.RTPReceiverGetStats(pcHandle, r.handle)
 	if err != nil {
 		return nil, err
 	}
@@ -716,6 +915,125 @@ func (r *RTPReceiver) SetJitterBufferMinDelay(minDelayMs int) error {
 	return ffi.RTPReceiverSetJitterBufferMinDelay(r.handle, minDelayMs)
 }
 
+// RequestKeyFrame asks the remote sender of a video receiver for a keyframe
+// by sending a PLI.
+func (r *RTPReceiver) RequestKeyFrame() error {
+	if r.handle == 0 {
+		return errors.New("receiver not initialized")
+	}
+
+	return ffi.RTPReceiverRequestKeyFrame(r.handle)
+}
+
+// EncodedVideoFrame is a frame of a remote video stream as assembled from
+// its RTP packets, before decoding.
+type EncodedVideoFrame struct {
+	Codec         codec.Type
+	SSRC          uint32
+	RTPTimestamp  uint32
+	PayloadType   int
+	Keyframe      bool
+	Width         int // Zero unless carried by the frame (keyframes)
+	Height        int
+	SpatialIndex  int
+	TemporalIndex int
+	// FrameID and Dependencies (the FrameIDs this frame references) come from
+	// the dependency descriptor or the codec's frame numbering; FrameID is -1
+	// when neither is present.
+	FrameID       int64
+	Dependencies  []int64
+	ReceiveTimeUs int64
+	// Data is only valid during the handler call.
+	Data []byte
+}
+
+func convertEncodedFrame(info *ffi.EncodedFrameInfo, data []byte) *EncodedVideoFrame {
+	n := int(info.NumDependencies)
+	if n > len(info.Dependencies) {
+		n = len(info.Dependencies)
+	}
+	var deps []int64
+	if n > 0 {
+		deps = append([]int64(nil), info.Dependencies[:n]...)
+	}
+	return &EncodedVideoFrame{
+		Codec:         codec.Type(info.Codec),
+		SSRC:          info.SSRC,
+		RTPTimestamp:  info.RTPTimestamp,
+		PayloadType:   int(info.PayloadType),
+		Keyframe:      info.IsKeyframe != 0,
+		Width:         int(info.Width),
+		Height:        int(info.Height),
+		SpatialIndex:  int(info.SpatialIndex),
+		TemporalIndex: int(info.TemporalIndex),
+		FrameID:       info.FrameID,
+		Dependencies:  deps,
+		ReceiveTimeUs: info.ReceiveTimeUs,
+		Data:          data,
+	}
+}
+
+// SetOnEncodedFrame delivers the encoded frames of this video receiver to
+// handler, on a libwebrtc thread. Frames still go on to the decoder; create
+// the PeerConnection from a Factory with DisableVideoDecoding to skip it.
+// Replaces any handler set through an EventQueue. Pass nil to remove it.
+func (r *RTPReceiver) SetOnEncodedFrame(handler func(*EncodedVideoFrame)) error {
+	if r.handle == 0 || r.pc == nil {
+		return errors.New("receiver not initialized")
+	}
+	if _, err := r.pc.rlockHandle(); err != nil {
+		return err
+	}
+	defer r.pc.mu.RUnlock()
+
+	r.encodedMu.Lock()
+	defer r.encodedMu.Unlock()
+
+	r.removeQueuedEncodedSink(true)
+	if handler == nil {
+		if !r.onEncoded {
+			return nil
+		}
+		r.onEncoded = false
+		return ffi.RTPReceiverSetOnEncodedFrame(r.handle, nil)
+	}
+	if err := ffi.RTPReceiverSetOnEncodedFrame(r.handle, func(info *ffi.EncodedFrameInfo, data []byte) {
+		handler(convertEncodedFrame(info, data))
+	}); err != nil {
+		return err
+	}
+	r.onEncoded = true
+	return nil
+}
+
+// removeQueuedEncodedSink detaches encoded frames delivered through an
+// EventQueue, skipping the native call unless native is set.
+// Must be called with r.encodedMu held.
+func (r *RTPReceiver) removeQueuedEncodedSink(native bool) {
+	if r.encodedQueue == nil {
+		return
+	}
+	if native {
+		_ = ffi.RTPReceiverSetEncodedFrameEventQueue(r.handle, 0, 0)
+	}
+	r.encodedQueue.unregister(r.encodedTag)
+	r.encodedQueue = nil
+	r.encodedTag = 0
+}
+
+// removeEncodedSink drops any encoded frame sink so the native side releases
+// the receiver. Must be called with pc.mu held and the handle still valid.
+func (r *RTPReceiver) removeEncodedSink() {
+	r.encodedMu.Lock()
+	defer r.encodedMu.Unlock()
+
+	r.removeQueuedEncodedSink(true)
+	if r.onEncoded {
+		_ = ffi.RTPReceiverSetOnEncodedFrame(r.handle, nil)
+		r.onEncoded = false
+	}
+}
+
 // RTPTransceiver represents an RTP transceiver.
 type RTPTransceiver struct {
 	handle    uintptr
@@ -846,9 +1164,37 @@ type RTPEncodingParameters struct {
 // VideoFrameHandler is called when a video frame is received on a remote track.
 type VideoFrameHandler func(f *frame.VideoFrame)
 
+// VideoSinkWants limits the frames a remote video track delivers. Zero
+// fields mean no limit.
+type VideoSinkWants struct {
+	// MaxPixelCount caps width*height; larger frames are scaled down.
+	MaxPixelCount int
+
+	// TargetPixelCount is the preferred frame size. Larger frames are scaled
+	// down to it; it takes precedence over a higher MaxPixelCount.
+	TargetPixelCount int
+
+	// MaxFramerate drops frames arriving faster than this many per second.
+	MaxFramerate int
+}
+
 // AudioFrameHandler is called when an audio frame is received on a remote track.
 type AudioFrameHandler func(f *frame.AudioFrame)
 
+// AudioSinkFormat batches and converts the audio a remote track delivers.
+// Zero fields keep 10ms frames and the source format.
+type AudioSinkFormat struct {
+	// Batch is the duration delivered per frame, up to 100ms, in multiples
+	// of the 10ms the track produces. Larger batches mean fewer calls.
+	Batch time.Duration
+
+	// SampleRate resamples to this rate in Hz.
+	SampleRate int
+
+	// Channels mixes to mono (1) or stereo (2).
+	Channels int
+}
+
 // Track represents a media track (can be local or remote).
 type Track struct {
 	handle  uintptr
@@ -867,10 +1213,36 @@ type Track struct {
 	sampleRate   int
 	channels     int
 
+	// Set for tracks fed with already encoded frames (video only)
+	encoded             bool
+	onKeyFrameRequest   func()
+	minKeyFrameInterval time.Duration
+
+	// Set for encoded tracks fed by a SharedVideoEncoder
+	shared           *SharedVideoEncoder
+	maxTemporalLayer int
+
 	// Frame handlers (remote tracks)
 	onVideoFrame VideoFrameHandler
 	onAudioFrame AudioFrameHandler
 
+	// Set while the sink delivers through an EventQueue
+	sinkQueue *EventQueue
+	sinkTag   uint64
+
+	// Set while decoded frames wait in a mailbox for ReadVideoFrame
+	mailbox       bool
+	framesDropped atomic.Uint64
+
+	// Limits applied to every video sink of the track
+	sinkWants VideoSinkWants
+
+	// Batching and format applied to every audio sink of the track
+	sinkFormat AudioSinkFormat
+
+	// Set while a VideoFrameRing feeds the track source
+	frameRing *VideoFrameRing
+
 	// For writing frames
 	mu sync.Mutex
 }
@@ -913,6 +1285,8 @@ func (t *Track) SetOnVideoFrame(handler VideoFrameHandler) error {
 	defer t.mu.Unlock()
 
 	// Remove existing sink if any
+	t.removeQueuedSink()
+	t.removeVideoMailbox()
 	if t.onVideoFrame != nil {
 		ffi.TrackRemoveVideoSink(t.handle)
 		ffi.UnregisterVideoCallback(t.handle)
@@ -939,7 +1313,141 @@ func (t *Track) SetOnVideoFrame(handler VideoFrameHandler) error {
 	})
 
 	// Set the native sink - use track handle as context for callback lookup
-	return ffi.TrackSetVideoSink(t.handle, ffi.GetVideoSinkCallbackPtr(), t.handle)
+	if err := ffi.TrackSetVideoSink(t.handle, ffi.GetVideoSinkCallbackPtr(), t.handle); err != nil {
+		return err
+	}
+	return t.applySinkWants()
+}
+
+// SetVideoSinkWants limits the resolution and frame rate of the frames the
+// track delivers through SetOnVideoFrame, EventQueue.SetOnVideoFrame or
+// ReadVideoFrame. The limits are passed to the source so it can adapt, and
+// the shim scales down or drops what still exceeds them before converting
+// the frame. They stay in effect across sink changes.
+func (t *Track) SetVideoSinkWants(wants VideoSinkWants) error {
+	if t.kind != "video" {
+		return errors.New("not a video track")
+	}
+	if t.handle == 0 {
+		return errors.New("track handle not initialized")
+	}
+	if wants.MaxPixelCount < 0 || wants.TargetPixelCount < 0 || wants.MaxFramerate < 0 {
+		return fmt.Errorf("invalid video sink wants %+v", wants)
+	}
+
+	t.mu.Lock()
+	defer t.mu.Unlock()
+
+	t.sinkWants = wants
+	if t.onVideoFrame == nil && !t.mailbox {
+		// Applied when a sink is set
+		return nil
+	}
+	return t.applySinkWants()
+}
+
+// applySinkWants passes the sink wants to a newly set video sink. Must hold
+// t.mu.
+func (t *Track) applySinkWants() error {
+	if t.sinkWants == (VideoSinkWants{}) {
+		return nil
+	}
+	w := t.sinkWants
+	return ffi.TrackSetVideoSinkWants(t.handle, w.MaxPixelCount, w.TargetPixelCount, w.MaxFramerate)
+}
+
+// SetVideoMailbox makes a remote video track keep up to slots decoded frames
+// (1-64) for ReadVideoFrame, replacing any frame handler. When the mailbox is
+// full the oldest frame is dropped, so a slow reader sees fresh frames
+// instead of holding up decoding. With one slot only the latest frame is
+// kept. Frames are converted to I420 when read, on the reader's goroutine.
+func (t *Track) SetVideoMailbox(slots int) error {
+	if t.kind != "video" {
+		return errors.New("not a video track")
+	}
+	if t.handle == 0 {
+		return errors.New("track handle not initialized")
+	}
+	if slots < 1 || slots > 64 {
+		return fmt.Errorf("invalid mailbox slots %d", slots)
+	}
+
+	t.mu.Lock()
+	defer t.mu.Unlock()
+
+	// Setting the mailbox replaces the native sink
+	t.removeQueuedSink()
+	if t.onVideoFrame != nil {
+		ffi.UnregisterVideoCallback(t.handle)
+		t.onVideoFrame = nil
+	}
+
+	if err := ffi.TrackSetVideoMailbox(t.handle, slots); err != nil {
+		t.mailbox = false
+		return err
+	}
+	t.mailbox = true
+	t.framesDropped.Store(0)
+	return t.applySinkWants()
+}
+
+// ReadVideoFrame copies the oldest frame of the video mailbox into f as I420,
+// reusing its plane buffers when they are large enough. It returns false
+// when no frame is waiting.
+func (t *Track) ReadVideoFrame(f *frame.VideoFrame) (bool, error) {
+	t.mu.Lock()
+	defer t.mu.Unlock()
+
+	if !t.mailbox {
+		return false, errors.New("track has no video mailbox")
+	}
+	mf, dropped, err := ffi.TrackPullVideoFrame(t.handle)
+	if err != nil {
+		return false, err
+	}
+	t.framesDropped.Store(dropped)
+	if mf == nil {
+		return false, nil
+	}
+	defer mf.Release()
+
+	if len(f.Data) != 3 {
+		f.Data = make([][]byte, 3)
+	}
+	if len(f.Stride) != 3 {
+		f.Stride = make([]int, 3)
+	}
+	for i := range 3 {
+		size := mf.PlaneSize(i)
+		if cap(f.Data[i]) < size {
+			f.Data[i] = make([]byte, size)
+		}
+		f.Data[i] = f.Data[i][:size]
+		mf.CopyPlane(i, f.Data[i])
+		f.Stride[i] = mf.Strides[i]
+	}
+	f.Width = mf.Width
+	f.Height = mf.Height
+	f.Format = frame.PixelFormatI420
+	f.Timestamp = time.Duration(mf.TimestampUs) * time.Microsecond
+	f.PTS = uint32(mf.TimestampUs / 1000) // Convert to milliseconds
+	return true, nil
+}
+
+// DroppedVideoFrames returns how many frames the video mailbox, or the
+// EventQueue video sink, dropped because they were not read in time, as of
+// the last frame read.
+func (t *Track) DroppedVideoFrames() uint64 {
+	return t.framesDropped.Load()
+}
+
+// removeVideoMailbox removes the video mailbox sink. Must hold t.mu.
+func (t *Track) removeVideoMailbox() {
+	if !t.mailbox {
+		return
+	}
+	ffi.TrackRemoveVideoSink(t.handle)
+	t.mailbox = false
 }
 
 // SetOnAudioFrame sets a callback to receive audio frames from a remote track.
@@ -956,6 +1464,7 @@ func (t *Track) SetOnAudioFrame(handler AudioFrameHandler) error {
 	defer t.mu.Unlock()
 
 	// Remove existing sink if any
+	t.removeQueuedSink()
 	if t.onAudioFrame != nil {
 		ffi.TrackRemoveAudioSink(t.handle)
 		ffi.UnregisterAudioCallback(t.handle)
@@ -968,15 +1477,60 @@ func (t *Track) SetOnAudioFrame(handler AudioFrameHandler) error {
 	}
 
 	// Register the callback in the FFI layer
-	ffi.RegisterAudioCallback(t.handle, func(samples []int16, sampleRate, channels int, timestampUs int64) {
+	ffi.RegisterAudioCallback(t.handle, func(samples []int16, sampleRate, channels int, timestampUs, captureTimeUs int64, hasCaptureTime bool) {
 		// Convert to frame.AudioFrame
 		f := frame.NewAudioFrameFromS16(samples, sampleRate, channels)
+		f.Timestamp = time.Duration(timestampUs) * time.Microsecond
 		f.PTS = uint32(timestampUs / 1000) // Convert to milliseconds
+		f.CaptureTime = time.Duration(captureTimeUs) * time.Microsecond
+		f.HasCaptureTime = hasCaptureTime
 		handler(f)
 	})
 
 	// Set the native sink - use track handle as context for callback lookup
-	return ffi.TrackSetAudioSink(t.handle, ffi.GetAudioSinkCallbackPtr(), t.handle)
+	if err := ffi.TrackSetAudioSink(t.handle, ffi.GetAudioSinkCallbackPtr(), t.handle); err != nil {
+		return err
+	}
+	return t.applySinkFormat()
+}
+
+// SetAudioSinkFormat batches and converts the frames the track delivers
+// through SetOnAudioFrame or EventQueue.SetOnAudioFrame. Batching cuts the
+// number of calls into Go. A frame's Timestamp is the arrival time of its
+// first sample; CaptureTime is that sample's capture time on the sender's
+// clock, when the sender provides it. The format stays in effect across sink
+// changes.
+func (t *Track) SetAudioSinkFormat(format AudioSinkFormat) error {
+	if t.kind != "audio" {
+		return errors.New("not an audio track")
+	}
+	if t.handle == 0 {
+		return errors.New("track handle not initialized")
+	}
+	if format.Batch < 0 || format.Batch > 100*time.Millisecond || format.SampleRate < 0 ||
+		format.Channels < 0 || format.Channels > 2 {
+		return fmt.Errorf("invalid audio sink format %+v", format)
+	}
+
+	t.mu.Lock()
+	defer t.mu.Unlock()
+
+	t.sinkFormat = format
+	if t.onAudioFrame == nil {
+		// Applied when a sink is set
+		return nil
+	}
+	return t.applySinkFormat()
+}
+
+// applySinkFormat passes the sink format to a newly set audio sink. Must
+// hold t.mu.
+func (t *Track) applySinkFormat() error {
+	if t.sinkFormat == (AudioSinkFormat{}) {
+		return nil
+	}
+	f := t.sinkFormat
+	return ffi.TrackSetAudioSinkFormat(t.handle, int(f.Batch.Milliseconds()), f.SampleRate, f.Channels)
 }
 
 // WriteVideoFrame writes a video frame to the track.
@@ -984,6 +1538,9 @@ func (t *Track) WriteVideoFrame(f *frame.VideoFrame) error {
 	if t.kind != "video" {
 		return errors.New("not a video track")
 	}
+	if t.encoded {
+		return errors.New("encoded video track: use WriteEncodedFrame")
+	}
 	if !t.enabled.Load() {
 		return nil
 	}
@@ -1016,6 +1573,153 @@ func (t *Track) WriteVideoFrame(f *frame.VideoFrame) error {
 	)
 }
 
+// VideoBufferPoolStats counts how the frames written to a video track were
+// stored: in a buffer recycled from the track's pool, or a newly allocated
+// one.
+type VideoBufferPoolStats struct {
+	Hits   uint64
+	Misses uint64
+}
+
+// HitRate returns the share of frames that reused a buffer.
+func (s VideoBufferPoolStats) HitRate() float64 {
+	total := s.Hits + s.Misses
+	if total == 0 {
+		return 0
+	}
+	return float64(s.Hits) / float64(total)
+}
+
+// VideoBufferPoolStats returns buffer pool statistics of a local video track
+// written with WriteVideoFrame. Written frames are copied into buffers
+// recycled once the encoder is done with them; a low hit rate means frames
+// stay queued in the encoder longer than the pool can cover.
+func (t *Track) VideoBufferPoolStats() (VideoBufferPoolStats, error) {
+	if t.kind != "video" || t.encoded {
+		return VideoBufferPoolStats{}, errors.New("not a raw video track")
+	}
+
+	t.mu.Lock()
+	defer t.mu.Unlock()
+
+	if t.sourceHandle == 0 {
+		return VideoBufferPoolStats{}, errors.New("track source not initialized")
+	}
+	hits, misses, err := ffi.VideoTrackSourceGetPoolStats(t.sourceHandle)
+	if err != nil {
+		return VideoBufferPoolStats{}, err
+	}
+	return VideoBufferPoolStats{Hits: hits, Misses: misses}, nil
+}
+
+// WriteEncodedFrame writes one already encoded frame to a track created with
+// CreateEncodedVideoTrack. The frame is sent as is, without re-encoding.
+// H.264 must be Annex B; SPS/PPS are only needed before the IDR frames where
+// they first appear or change. Delta frames are dropped until the first
+// keyframe, and after a frame lost on the way to the encoder until the
+// keyframe the loss requests. The frame is stamped with the current time.
+func (t *Track) WriteEncodedFrame(data []byte, keyframe bool) error {
+	return t.WriteEncodedFrameAt(data, keyframe, 0)
+}
+
+// WriteEncodedFrameAt is WriteEncodedFrame with the frame's capture time, or
+// 0 for the current time. Capture times must increase: libwebrtc drops a
+// frame that is not later than the previous one.
+func (t *Track) WriteEncodedFrameAt(data []byte, keyframe bool, timestamp time.Duration) error {
+	if timestamp < 0 {
+		return errors.New("negative timestamp")
+	}
+	if !t.encoded {
+		return errors.New("not an encoded video track")
+	}
+	if t.shared != nil {
+		return errors.New("shared video track: write to its SharedVideoEncoder")
+	}
+	if !t.enabled.Load() {
+		return nil
+	}
+	if len(data) == 0 {
+		return errors.New("empty encoded frame")
+	}
+
+	t.mu.Lock()
+	defer t.mu.Unlock()
+
+	if t.sourceHandle == 0 {
+		return errors.New("track source not initialized")
+	}
+	return ffi.EncodedVideoSourcePushFrame(t.sourceHandle, data, 0, 0, keyframe, -1, timestamp.Microseconds())
+}
+
+// SetOnKeyFrameRequest sets the handler called when an encoded video track
+// must produce a keyframe, because a receiver sent PLI/FIR, a sender has no
+// cached keyframe to start with, or a frame was lost. A sender that starts
+// from the cached keyframe does not request a new one, so producers should
+// send keyframes at a regular interval. The handler runs on a libwebrtc
+// thread and should only schedule the keyframe. A nil handler removes it.
+func (t *Track) SetOnKeyFrameRequest(handler func()) error {
+	if !t.encoded {
+		return errors.New("not an encoded video track")
+	}
+
+	t.mu.Lock()
+	defer t.mu.Unlock()
+
+	t.onKeyFrameRequest = handler
+	if t.sourceHandle != 0 {
+		ffi.EncodedVideoSourceSetOnKeyFrameRequest(t.sourceHandle, handler)
+	}
+	return nil
+}
+
+// SetMinKeyFrameInterval sets the least time between keyframe requests
+// passed to the SetOnKeyFrameRequest handler; requests within it are merged
+// into one. Zero means 500ms. It must be set before AddTrack; shared tracks
+// take it from SharedVideoEncoderConfig.
+//
+// A track added after the producer's latest keyframe starts by sending that
+// keyframe again, so receivers show a picture right away and the next
+// requested keyframe resumes motion.
+func (t *Track) SetMinKeyFrameInterval(d time.Duration) error {
+	if !t.encoded || t.shared != nil {
+		return errors.New("not an encoded video track")
+	}
+	if d < 0 {
+		return fmt.Errorf("invalid keyframe interval %v", d)
+	}
+
+	t.mu.Lock()
+	defer t.mu.Unlock()
+
+	if t.sourceHandle != 0 {
+		return errors.New("keyframe interval must be set before AddTrack")
+	}
+	t.minKeyFrameInterval = d
+	return nil
+}
+
+// SetMaxTemporalLayer limits an encoded video track to the temporal layers
+// up to layer (0-7), for example to halve the frame rate sent to one
+// receiver of a SharedVideoEncoder with two layers. Dropping layers applies
+// to the next frame; adding them waits for a keyframe, which is requested.
+func (t *Track) SetMaxTemporalLayer(layer int) error {
+	if !t.encoded {
+		return errors.New("not an encoded video track")
+	}
+	if layer < 0 || layer > maxTemporalLayer {
+		return fmt.Errorf("invalid temporal layer %d", layer)
+	}
+
+	t.mu.Lock()
+	defer t.mu.Unlock()
+
+	t.maxTemporalLayer = layer
+	if t.sourceHandle != 0 {
+		return ffi.EncodedVideoSourceSetMaxTemporalLayer(t.sourceHandle, layer)
+	}
+	return nil
+}
+
 // WriteAudioFrame writes an audio frame to the track.
 func (t *Track) WriteAudioFrame(f *frame.AudioFrame) error {
 	if t.kind != "audio" {
@@ -1075,6 +1779,13 @@ type PeerConnection struct {
 	OnNegotiationNeeded        func()
 	OnDataChannel              func(dc *DataChannel)
 
+	// Set while events are delivered through an EventQueue
+	eventQueue atomic.Pointer[EventQueue]
+	eventTag   uint64
+
+	// Stats rings this PeerConnection is subscribed to, guarded by mu
+	statsRings []*StatsRing
+
 	mu     sync.RWMutex
 	closed atomic.Bool
 }
@@ -1120,6 +1831,10 @@ type DataChannel struct {
 	onClose   func()
 	onMessage func(data []byte)
 	onError   func(err error)
+
+	// Set while events are delivered through an EventQueue
+	eventQueue *EventQueue
+	eventTag   uint64
 }
 
 // IsValid returns true if the DataChannel has a valid native handle.
@@ -1204,6 +1919,11 @@ func (dc *DataChannel) Close() error {
 		return nil
 	}
 	ffi.UnregisterDataChannelCallbacks(dc.handle)
+	if dc.eventQueue != nil {
+		ffi.DataChannelSetEventQueue(dc.handle, 0, 0)
+		dc.eventQueue.unregister(dc.eventTag)
+		dc.eventQueue = nil
+	}
 	ffi.DataChannelClose(dc.handle)
 	return nil
 }
@@ -1275,17 +1995,71 @@ func buildFFIConfig(config *Configuration) *ffiConfigData {
 		data.strings = append(data.strings, sdpStr)
 		data.config.SDPSemantics = &sdpStr[0]
 	}
+	if config.ICETransportPolicy != "" {
+		policyStr := ffi.CString(config.ICETransportPolicy)
+		data.strings = append(data.strings, policyStr)
+		data.config.ICETransportPolicy = &policyStr[0]
+	}
+	if config.CandidateNetworkPolicy != "" {
+		policyStr := ffi.CString(config.CandidateNetworkPolicy)
+		data.strings = append(data.strings, policyStr)
+		data.config.CandidateNetworkPolicy = &policyStr[0]
+	}
+	if config.TCPCandidatePolicy != "" {
+		policyStr := ffi.CString(config.TCPCandidatePolicy)
+		data.strings = append(data.strings, policyStr)
+		data.config.TCPCandidatePolicy = &policyStr[0]
+	}
+
+	// Server-oriented options
+	data.config.PortRangeMin = int32(config.PortRangeMin)
+	data.config.PortRangeMax = int32(config.PortRangeMax)
+	data.config.ICECheckIntervalMs = int32(config.ICECheckInterval.Milliseconds())
+	data.config.ICECheckMinIntervalMs = int32(config.ICECheckMinInterval.Milliseconds())
+	if config.ContinualGathering {
+		data.config.ContinualGathering = 1
+	}
+
+	cc := config.CongestionControl
+	data.config.NetworkController = int32(cc.Controller)
+	data.config.StartBitrateBps = int32(cc.StartBitrateBps)
+	data.config.MinBitrateBps = int32(cc.MinBitrateBps)
+	data.config.MaxBitrateBps = int32(cc.MaxBitrateBps)
+	if cc.DisableProbing {
+		data.config.DisableProbing = 1
+	}
 
 	return data
 }
 
-// NewPeerConnection creates a new libwebrtc-backed PeerConnection.
+// NewPeerConnection creates a new libwebrtc-backed PeerConnection with its
+// own media engine. Use a Factory to share one engine across many connections.
 func NewPeerConnection(config Configuration) (*PeerConnection, error) {
 	if err := ffi.LoadLibrary(); err != nil {
 		return nil, err
 	}
+	return newPeerConnection(0, config)
+}
+
+// newPeerConnection creates a PeerConnection on the given native factory
+// (0 for a private one). The library must already be loaded.
+func newPeerConnection(factory uintptr, config Configuration) (*PeerConnection, error) {
+	// Build FFI config - keep data alive during FFI call
+	configData := buildFFIConfig(&config)
+	handle, err := ffi.CreatePeerConnectionWithFactory(factory, configData.config)
+	// Ensure configData is kept alive until after FFI call completes
+	_ = configData
+	if err != nil {
+		return nil, fmt.Errorf("create peer connection: %w", err)
+	}
+	return wrapPeerConnection(handle, config), nil
+}
 
+// wrapPeerConnection takes ownership of a shim PeerConnection handle and
+// registers the observer callbacks.
+func wrapPeerConnection(handle uintptr, config Configuration) *PeerConnection {
 	pc := &PeerConnection{
+		handle:       handle,
 		config:       config,
 		senders:      make([]*RTPSender, 0),
 		receivers:    make([]*RTPReceiver, 0),
@@ -1298,143 +2072,146 @@ func NewPeerConnection(config Configuration) (*PeerConnection, error) {
 	pc.iceGatheringState.Store(ICEGatheringStateNew)
 	pc.connectionState.Store(PeerConnectionStateNew)
 
-	// Build FFI config - keep data alive during FFI call
-	configData := buildFFIConfig(&config)
-	handle, err := ffi.CreatePeerConnection(configData.config)
-	// Ensure configData is kept alive until after FFI call completes
-	_ = configData
-	if err != nil {
-		return nil, fmt.Errorf("create peer connection: %w", err)
+	ffi.PeerConnectionSetOnConnectionStateChange(handle, pc.handleConnectionStateChange)
+	ffi.PeerConnectionSetOnICECandidate(handle, pc.handleICECandidate)
+	ffi.PeerConnectionSetOnTrack(handle, pc.handleTrack)
+	ffi.PeerConnectionSetOnDataChannel(handle, pc.handleDataChannel)
+	ffi.PeerConnectionSetOnSignalingStateChange(handle, pc.handleSignalingStateChange)
+	ffi.PeerConnectionSetOnICEConnectionStateChange(handle, pc.handleICEConnectionStateChange)
+	ffi.PeerConnectionSetOnICEGatheringStateChange(handle, pc.handleICEGatheringStateChange)
+	ffi.PeerConnectionSetOnNegotiationNeeded(handle, pc.handleNegotiationNeeded)
+
+	return pc
+}
+
+// The handlers below receive observer events, either from the per-event
+// callbacks registered in wrapPeerConnection or from an attached EventQueue.
+
+func (pc *PeerConnection) handleConnectionStateChange(state int) {
+	if pc.closed.Load() {
+		return // Ignore if closed
 	}
-	pc.handle = handle
+	newState := PeerConnectionState(state)
+	pc.connectionState.Store(newState)
+	if pc.OnConnectionStateChange != nil {
+		pc.OnConnectionStateChange(newState)
+	}
+}
 
-	// Set up connection state change callback
-	ffi.PeerConnectionSetOnConnectionStateChange(handle, func(state int) {
-		if pc.closed.Load() {
-			return // Ignore if closed
-		}
-		newState := PeerConnectionState(state)
-		pc.connectionState.Store(newState)
-		if pc.OnConnectionStateChange != nil {
-			pc.OnConnectionStateChange(newState)
-		}
-	})
+func (pc *PeerConnection) handleICECandidate(candidate, sdpMid string, sdpMLineIndex int) {
+	if pc.closed.Load() {
+		return // Ignore if closed
+	}
+	if pc.OnICECandidate != nil {
+		pc.OnICECandidate(&ICECandidate{
+			Candidate:     candidate,
+			SDPMid:        sdpMid,
+			SDPMLineIndex: uint16(sdpMLineIndex),
+		})
+	}
+}
 
-	// Set up ICE candidate callback
-	ffi.PeerConnectionSetOnICECandidate(handle, func(candidate, sdpMid string, sdpMLineIndex int) {
-		if pc.closed.Load() {
-			return // Ignore if closed
-		}
-		if pc.OnICECandidate != nil {
-			pc.OnICECandidate(&ICECandidate{
-				Candidate:     candidate,
-				SDPMid:        sdpMid,
-				SDPMLineIndex: uint16(sdpMLineIndex),
-			})
+func (pc *PeerConnection) handleTrack(trackHandle, receiverHandle uintptr, streams string) {
+	if pc.closed.Load() {
+		return // Ignore if closed
+	}
+	if pc.OnTrack != nil {
+		// Create track wrapper
+		kind := ffi.TrackKind(trackHandle)
+		trackID := ffi.TrackID(trackHandle)
+
+		track := &Track{
+			handle: trackHandle,
+			id:     trackID,
+			kind:   kind,
+			pc:     pc,
 		}
-	})
+		track.enabled.Store(true)
 
-	// Set up track callback
-	ffi.PeerConnectionSetOnTrack(handle, func(trackHandle, receiverHandle uintptr, streams string) {
-		if pc.closed.Load() {
-			return // Ignore if closed
+		receiver := &RTPReceiver{
+			handle: receiverHandle,
+			track:  track,
+			pc:     pc,
 		}
-		if pc.OnTrack != nil {
-			// Create track wrapper
-			kind := ffi.TrackKind(trackHandle)
-			trackID := ffi.TrackID(trackHandle)
-
-			track := &Track{
-				handle: trackHandle,
-				id:     trackID,
-				kind:   kind,
-				pc:     pc,
-			}
-			track.enabled.Store(true)
-
-			receiver := &RTPReceiver{
-				handle: receiverHandle,
-				track:  track,
-				pc:     pc,
-			}
 
-			pc.mu.Lock()
-			pc.receivers = append(pc.receivers, receiver)
-			pc.mu.Unlock()
-
-			// Split streams by comma if multiple
-			var streamIDs []string
-			if streams != "" {
-				streamIDs = []string{streams}
-			}
+		pc.mu.Lock()
+		pc.receivers = append(pc.receivers, receiver)
+		pc.mu.Unlock()
 
-			pc.OnTrack(track, receiver, streamIDs)
+		// Split streams by comma if multiple
+		var streamIDs []string
+		if streams != "" {
+			streamIDs = []string{streams}
 		}
-	})
 
-	// Set up data channel callback
-	ffi.PeerConnectionSetOnDataChannel(handle, func(dcHandle uintptr) {
-		if pc.closed.Load() {
-			return // Ignore if closed
-		}
-		if pc.OnDataChannel != nil {
-			label := ffi.DataChannelLabel(dcHandle)
-			dc := &DataChannel{
-				handle: dcHandle,
-				label:  label,
-				pc:     pc,
-			}
-			pc.OnDataChannel(dc)
-		}
-	})
+		pc.OnTrack(track, receiver, streamIDs)
+	}
+}
 
-	// Set up signaling state change callback
-	ffi.PeerConnectionSetOnSignalingStateChange(handle, func(state int) {
-		if pc.closed.Load() {
-			return // Ignore if closed
-		}
-		newState := SignalingState(state)
-		pc.signalingState.Store(newState)
-		if pc.OnSignalingStateChange != nil {
-			pc.OnSignalingStateChange(newState)
+func (pc *PeerConnection) handleDataChannel(dcHandle uintptr) {
+	if pc.closed.Load() {
+		return // Ignore if closed
+	}
+	if pc.OnDataChannel != nil {
+		label := ffi.DataChannelLabel(dcHandle)
+		dc := &DataChannel{
+			handle: dcHandle,
+			label:  label,
+			pc:     pc,
 		}
-	})
+		pc.attachDataChannel(dc)
+		pc.OnDataChannel(dc)
+	}
+}
 
-	// Set up ICE connection state change callback
-	ffi.PeerConnectionSetOnICEConnectionStateChange(handle, func(state int) {
-		if pc.closed.Load() {
-			return // Ignore if closed
-		}
-		newState := ICEConnectionState(state)
-		pc.iceConnectionState.Store(newState)
-		if pc.OnICEConnectionStateChange != nil {
-			pc.OnICEConnectionStateChange(newState)
-		}
-	})
+func (pc *PeerConnection) handleSignalingStateChange(state int) {
+	if pc.closed.Load() {
+		return // Ignore if closed
+	}
+	newState := SignalingState(state)
+	pc.signalingState.Store(newState)
+	if pc.OnSignalingStateChange != nil {
+		pc.OnSignalingStateChange(newState)
+	}
+}
 
-	// Set up ICE gathering state change callback
-	ffi.PeerConnectionSetOnICEGatheringStateChange(handle, func(state int) {
-		if pc.closed.Load() {
-			return // Ignore if closed
-		}
-		newState := ICEGatheringState(state)
-		pc.iceGatheringState.Store(newState)
-		if pc.OnICEGatheringStateChange != nil {
-			pc.OnICEGatheringStateChange(newState)
-		}
-	})
+func (pc *PeerConnection) handleICEConnectionStateChange(state int) {
+	if pc.closed.Load() {
+		return // Ignore if closed
+	}
+	newState := ICEConnectionState(state)
+	pc.iceConnectionState.Store(newState)
+	if pc.OnICEConnectionStateChange != nil {
+		pc.OnICEConnectionStateChange(newState)
+	}
+}
 
-	// Set up negotiation needed callback
-	ffi.PeerConnectionSetOnNegotiationNeeded(handle, func() {
-		if pc.closed.Load() {
-			return // Ignore if closed
-		}
-		if pc.OnNegotiationNeeded != nil {
-			pc.OnNegotiationNeeded()
-		}
-	})
+func (pc *PeerConnection) handleICEGatheringStateChange(state int) {
+	if pc.closed.Load() {
+		return // Ignore if closed
+	}
+	newState := ICEGatheringState(state)
+	pc.iceGatheringState.Store(newState)
+	if pc.OnICEGatheringStateChange != nil {
+		pc.OnICEGatheringStateChange(newState)
+	}
+}
+
+func (pc *PeerConnection) handleNegotiationNeeded() {
+	if pc.closed.Load() {
+		return // Ignore if closed
+	}
+	if pc.OnNegotiationNeeded != nil {
+		pc.OnNegotiationNeeded()
+	}
+}
 
-	return pc, nil
+// attachDataChannel routes a channel's events through the connection's
+// EventQueue, if it has one.
+func (pc *PeerConnection) attachDataChannel(dc *DataChannel) {
+	if q := pc.eventQueue.Load(); q != nil {
+		q.attachDataChannel(dc)
+	}
 }
 
 // CreateOffer creates an SDP offer.
@@ -1446,7 +2223,7 @@ func (pc *PeerConnection) CreateOffer(options *OfferOptions) (*SessionDescriptio
 	// Note: Don't hold lock during FFI call - it can trigger callbacks that need the lock.
 	// Allocate buffer for SDP output
 	sdpBuf := make([]byte, maxSDPSize)
-	sdpLen, err := ffi.PeerConnectionCreateOffer(pc.handle, sdpBuf)
+	sdpLen, err := ffi.PeerConnectionCreateOffer(pc.handle, options.ffiOptions(), sdpBuf)
 	if err != nil {
 		return nil, ErrCreateOfferFailed
 	}
@@ -1466,7 +2243,7 @@ func (pc *PeerConnection) CreateAnswer(options *AnswerOptions) (*SessionDescript
 	// Note: Don't hold lock during FFI call - it can trigger callbacks that need the lock.
 	// Allocate buffer for SDP output
 	sdpBuf := make([]byte, maxSDPSize)
-	sdpLen, err := ffi.PeerConnectionCreateAnswer(pc.handle, sdpBuf)
+	sdpLen, err := ffi.PeerConnectionCreateAnswer(pc.handle, options.ffiOptions(), sdpBuf)
 	if err != nil {
 		return nil, ErrCreateAnswerFailed
 	}
@@ -1511,6 +2288,102 @@ func (pc *PeerConnection) SetRemoteDescription(desc *SessionDescription) error {
 	return nil
 }
 
+// CreateOfferAsync starts creating an SDP offer and returns without blocking
+// the calling OS thread on the signaling thread. cb is called once, on a new
+// goroutine, with the offer or an error.
+func (pc *PeerConnection) CreateOfferAsync(options *OfferOptions, cb func(*SessionDescription, error)) error {
+	if pc.closed.Load() {
+		return ErrPeerConnectionClosed
+	}
+
+	// The shim completes on the signaling thread; leave it before running cb so
+	// cb may call blocking PeerConnection methods.
+	err := ffi.PeerConnectionCreateOfferAsync(pc.handle, options.ffiOptions(), func(sdp string, err error) {
+		go func() {
+			if err != nil {
+				cb(nil, fmt.Errorf("%w: %w", ErrCreateOfferFailed, err))
+				return
+			}
+			cb(&SessionDescription{Type: SDPTypeOffer, SDP: sdp}, nil)
+		}()
+	})
+	if err != nil {
+		return ErrCreateOfferFailed
+	}
+	return nil
+}
+
+// CreateAnswerAsync starts creating an SDP answer. See CreateOfferAsync.
+func (pc *PeerConnection) CreateAnswerAsync(options *AnswerOptions, cb func(*SessionDescription, error)) error {
+	if pc.closed.Load() {
+		return ErrPeerConnectionClosed
+	}
+
+	err := ffi.PeerConnectionCreateAnswerAsync(pc.handle, options.ffiOptions(), func(sdp string, err error) {
+		go func() {
+			if err != nil {
+				cb(nil, fmt.Errorf("%w: %w", ErrCreateAnswerFailed, err))
+				return
+			}
+			cb(&SessionDescription{Type: SDPTypeAnswer, SDP: sdp}, nil)
+		}()
+	})
+	if err != nil {
+		return ErrCreateAnswerFailed
+	}
+	return nil
+}
+
+// SetLocalDescriptionAsync starts applying the local description. cb is called
+// once, on a new goroutine, when it has been applied or has failed.
+func (pc *PeerConnection) SetLocalDescriptionAsync(desc *SessionDescription, cb func(error)) error {
+	if pc.closed.Load() {
+		return ErrPeerConnectionClosed
+	}
+
+	err := ffi.PeerConnectionSetLocalDescriptionAsync(pc.handle, int(desc.Type), desc.SDP, func(_ string, err error) {
+		go func() {
+			if err != nil {
+				cb(fmt.Errorf("%w: %w", ErrSetDescriptionFailed, err))
+				return
+			}
+			pc.mu.Lock()
+			pc.localDescription = desc
+			pc.mu.Unlock()
+			cb(nil)
+		}()
+	})
+	if err != nil {
+		return ErrSetDescriptionFailed
+	}
+	return nil
+}
+
+// SetRemoteDescriptionAsync starts applying the remote description. cb is called
+// once, on a new goroutine, when it has been applied or has failed.
+func (pc *PeerConnection) SetRemoteDescriptionAsync(desc *SessionDescription, cb func(error)) error {
+	if pc.closed.Load() {
+		return ErrPeerConnectionClosed
+	}
+
+	err := ffi.PeerConnectionSetRemoteDescriptionAsync(pc.handle, int(desc.Type), desc.SDP, func(_ string, err error) {
+		go func() {
+			if err != nil {
+				cb(fmt.Errorf("%w: %w", ErrSetDescriptionFailed, err))
+				return
+			}
+			pc.mu.Lock()
+			pc.remoteDescription = desc
+			pc.mu.Unlock()
+			cb(nil)
+		}()
+	})
+	if err != nil {
+		return ErrSetDescriptionFailed
+	}
+	return nil
+}
+
 // AddICECandidate adds an ICE candidate.
 func (pc *PeerConnection) AddICECandidate(candidate *ICECandidate) error {
 	if pc.closed.Load() {
@@ -1578,7 +2451,35 @@ func (pc *PeerConnection) AddTrack(track *Track, streams ...string) (*RTPSender,
 
 	var senderHandle uintptr
 
-	if track.kind == "video" {
+	if track.encoded {
+		var sourceHandle uintptr
+		var err error
+		if track.shared != nil {
+			sourceHandle, err = track.shared.subscribe(track.maxTemporalLayer)
+		} else {
+			sourceHandle, err = ffi.EncodedVideoSourceCreate(ffi.CodecType(track.codec), track.width, track.height,
+				int(track.minKeyFrameInterval.Milliseconds()))
+		}
+		if err != nil {
+			return nil, err
+		}
+
+		senderHandle, err = ffi.PeerConnectionAddEncodedVideoTrack(pc.handle, sourceHandle, track.id, streamID)
+		if err != nil {
+			ffi.EncodedVideoSourceDestroy(sourceHandle)
+			return nil, err
+		}
+
+		track.mu.Lock()
+		track.sourceHandle = sourceHandle
+		if track.onKeyFrameRequest != nil {
+			ffi.EncodedVideoSourceSetOnKeyFrameRequest(sourceHandle, track.onKeyFrameRequest)
+		}
+		if track.shared == nil && track.maxTemporalLayer != maxTemporalLayer {
+			_ = ffi.EncodedVideoSourceSetMaxTemporalLayer(sourceHandle, track.maxTemporalLayer)
+		}
+		track.mu.Unlock()
+	} else if track.kind == "video" {
 		// Create video track source for frame injection
 		sourceHandle := ffi.VideoTrackSourceCreate(pc.handle, track.width, track.height)
 		if sourceHandle == 0 {
@@ -1667,7 +2568,18 @@ func (pc *PeerConnection) RemoveTrack(sender *RTPSender) error {
 	}
 
 	if trackToRemove != nil && trackToRemove.sourceHandle != 0 {
-		if trackToRemove.kind == "video" {
+		if trackToRemove.encoded {
+			trackToRemove.mu.Lock()
+			ffi.EncodedVideoSourceDestroy(trackToRemove.sourceHandle)
+			trackToRemove.sourceHandle = 0
+			trackToRemove.mu.Unlock()
+		} else if trackToRemove.kind == "video" {
+			trackToRemove.mu.Lock()
+			ring := trackToRemove.frameRing
+			trackToRemove.mu.Unlock()
+			if ring != nil {
+				ring.closeFromTrack()
+			}
 			ffi.VideoTrackSourceDestroy(trackToRemove.sourceHandle)
 		} else if trackToRemove.kind == "audio" {
 			ffi.AudioTrackSourceDestroy(trackToRemove.sourceHandle)
@@ -1853,6 +2765,7 @@ func (pc *PeerConnection) CreateDataChannel(label string, options *DataChannelIn
 		label:  label,
 		pc:     pc,
 	}
+	pc.attachDataChannel(dc)
 
 	return dc, nil
 }
@@ -1888,6 +2801,34 @@ func (pc *PeerConnection) Close() error {
 		ffi.UnregisterICEGatheringStateCallback(pc.handle)
 		ffi.UnregisterNegotiationNeededCallback(pc.handle)
 		ffi.UnregisterBandwidthEstimateCallback(pc.handle)
+		ffi.UnregisterRTCPFeedbackCallback(pc.handle)
+		if q := pc.eventQueue.Load(); q != nil {
+			ffi.PeerConnectionSetEventQueue(pc.handle, 0, 0)
+			q.unregister(pc.eventTag)
+		}
+		for _, r := range pc.statsRings {
+			r.unsubscribe(pc.handle)
+		}
+		pc.statsRings = nil
+		for _, s := range pc.senders {
+			s.feedbackMu.Lock()
+			ffi.UnregisterRTCPFeedbackCallback(s.handle)
+			s.removeQueuedFeedback(0)
+			s.feedbackMu.Unlock()
+		}
+		for _, r := range pc.receivers {
+			r.removeEncodedSink()
+		}
+		// Close the frame rings as RemoveTrack does; a slot a writer still
+		// holds keeps its ring mapped until the writer's next call.
+		for _, t := range pc.localTracks {
+			t.mu.Lock()
+			ring := t.frameRing
+			t.mu.Unlock()
+			if ring != nil {
+				ring.closeFromTrack()
+			}
+		}
 
 		ffi.PeerConnectionClose(pc.handle)
 		ffi.PeerConnectionDestroy(pc.handle)
@@ -1925,6 +2866,29 @@ func (pc *PeerConnection) CreateVideoTrack(id string, codecType codec.Type, widt
 	return track, nil
 }
 
+// CreateEncodedVideoTrack creates a video track fed with already encoded
+// frames (see Track.WriteEncodedFrame), for sending video from a camera, a
+// file or another peer without decoding and re-encoding it. Only codecType is
+// offered for the track, and width and height are the default frame size.
+func (pc *PeerConnection) CreateEncodedVideoTrack(id string, codecType codec.Type, width, height int) (*Track, error) {
+	if width <= 0 || height <= 0 {
+		return nil, errors.New("invalid video dimensions")
+	}
+	switch codecType {
+	case codec.H264, codec.VP8, codec.VP9, codec.AV1:
+	default:
+		return nil, fmt.Errorf("unsupported codec for encoded track: %s", codecType)
+	}
+
+	track, err := pc.CreateVideoTrack(id, codecType, width, height)
+	if err != nil {
+		return nil, err
+	}
+	track.encoded = true
+	track.maxTemporalLayer = maxTemporalLayer
+	return track, nil
+}
+
 // CreateAudioTrack creates an audio track for this peer connection.
 // Uses 48kHz stereo by default (can be overridden with CreateAudioTrackWithOptions).
 func (pc *PeerConnection) CreateAudioTrack(id string) (*Track, error) {
@@ -1994,17 +2958,19 @@ func (pc *PeerConnection) RestartICE() error {
 // BandwidthEstimate contains bandwidth estimation data from libwebrtc's BWE engine.
 type BandwidthEstimate struct {
 	TimestampUs      int64
-	TargetBitrateBps int64
-	AvailableSendBps int64
-	AvailableRecvBps int64
+	TargetBitrateBps int64 // Rate the encoders are told to target
+	AvailableSendBps int64 // Estimated link capacity
+	AvailableRecvBps int64 // Not known to the send-side controller; always 0
 	PacingRateBps    int64
-	CongestionWindow int32
+	CongestionWindow int32 // Bytes in flight allowed; 0 when unlimited
 	LossRate         float64
 }
 
 // SetOnBandwidthEstimate sets a callback for bandwidth estimation updates from libwebrtc.
-// This exposes libwebrtc's internal BWE (TWCC/GCC) for observability or for wiring
-// to pkg/track tracks when using Pion interop.
+// It runs on a libwebrtc thread each time the congestion controller changes its
+// target, pacing rate or congestion window, typically within milliseconds of
+// the transport feedback that caused it. Wire it to pkg/track's
+// VideoTrack.OnBandwidthEstimate to adapt without polling.
 func (pc *PeerConnection) SetOnBandwidthEstimate(cb func(*BandwidthEstimate)) {
 	if pc.closed.Load() || pc.handle == 0 {
 		return
@@ -2025,7 +2991,34 @@ func (pc *PeerConnection) SetOnBandwidthEstimate(cb func(*BandwidthEstimate)) {
 	})
 }
 
-// GetCurrentBandwidthEstimate returns the current bandwidth estimate from libwebrtc.
+// SetOnTransportFeedback reports the REMB and transport-wide congestion
+// control (TWCC) feedback of the PeerConnection in batches: at most one per
+// interval (zero selects 100ms) and none for intervals without feedback.
+// The handler runs on a libwebrtc thread. Pass nil to stop reporting.
+func (pc *PeerConnection) SetOnTransportFeedback(interval time.Duration, handler func([]RTCPFeedback)) error {
+	intervalMs, err := rtcpFeedbackIntervalMs(interval)
+	if err != nil {
+		return err
+	}
+
+	pcHandle, err := pc.rlockHandle()
+	if err != nil {
+		return err
+	}
+	defer pc.mu.RUnlock()
+
+	if handler == nil {
+		ffi.PeerConnectionSetOnTransportFeedback(pcHandle, 0, nil)
+		return nil
+	}
+	ffi.PeerConnectionSetOnTransportFeedback(pcHandle, intervalMs, func(records []ffi.RTCPFeedback) {
+		handler(convertRTCPFeedback(records))
+	})
+	return nil
+}
+
+// GetCurrentBandwidthEstimate returns the last estimate reported by libwebrtc's
+// congestion controller. The fields are zero until the transport is up.
 func (pc *PeerConnection) GetCurrentBandwidthEstimate() *BandwidthEstimate {
 	if pc.closed.Load() || pc.handle == 0 {
 		return nil
@@ -0,0 +1,121 @@
+package pc
+
+import (
+	"errors"
+	"fmt"
+	"sync"
+
+	"github.com/thesyncim/libgowebrtc/internal/ffi"
+)
+
+// ErrPoolClosed is returned when acquiring from a closed PeerConnectionPool.
+var ErrPoolClosed = errors.New("peer connection pool closed")
+
+// PoolConfig configures a PeerConnectionPool.
+type PoolConfig struct {
+	// Configuration is applied to every pooled PeerConnection.
+	// ICECandidatePoolSize is raised to at least 1 so host candidates are
+	// gathered while a connection waits in the pool.
+	Configuration Configuration
+
+	// Factory supplies the media engine. Nil builds one engine for the pool.
+	Factory *Factory
+
+	// Size is the number of idle PeerConnections kept ready. Zero means 4.
+	Size int
+
+	// AudioTransceivers and VideoTransceivers are added to every pooled
+	// PeerConnection with TransceiverDirection.
+	AudioTransceivers    int
+	VideoTransceivers    int
+	TransceiverDirection TransceiverDirection
+}
+
+// PeerConnectionPool keeps PeerConnections created ahead of time so a new
+// session does not wait for connection setup and ICE gathering.
+//
+// A background thread refills the pool to its size after every Acquire.
+// Acquired connections behave like ones from NewPeerConnection, except that
+// the template transceivers already exist and no OnNegotiationNeeded fires
+// for them: create the offer right after Acquire.
+type PeerConnectionPool struct {
+	handle uintptr
+	config Configuration
+	mu     sync.RWMutex
+}
+
+// NewPeerConnectionPool creates a pool and starts filling it.
+func NewPeerConnectionPool(cfg PoolConfig) (*PeerConnectionPool, error) {
+	if err := ffi.LoadLibrary(); err != nil {
+		return nil, err
+	}
+	if cfg.Size < 0 {
+		return nil, fmt.Errorf("create peer connection pool: invalid size %d", cfg.Size)
+	}
+	size := cfg.Size
+	if size == 0 {
+		size = 4
+	}
+
+	var factory uintptr
+	if cfg.Factory != nil {
+		cfg.Factory.mu.RLock()
+		defer cfg.Factory.mu.RUnlock()
+		if cfg.Factory.handle == 0 {
+			return nil, ErrFactoryClosed
+		}
+		factory = cfg.Factory.handle
+	}
+
+	configData := buildFFIConfig(&cfg.Configuration)
+	handle, err := ffi.CreatePeerConnectionPool(&ffi.PeerConnectionPoolConfig{
+		Config:               configData.config,
+		Factory:              factory,
+		TargetSize:           size,
+		AudioTransceivers:    cfg.AudioTransceivers,
+		VideoTransceivers:    cfg.VideoTransceivers,
+		TransceiverDirection: ffi.TransceiverDirection(cfg.TransceiverDirection),
+	})
+	// Ensure configData is kept alive until after FFI call completes
+	_ = configData
+	if err != nil {
+		return nil, fmt.Errorf("create peer connection pool: %w", err)
+	}
+	return &PeerConnectionPool{handle: handle, config: cfg.Configuration}, nil
+}
+
+// Acquire takes a ready PeerConnection from the pool. When the pool is
+// empty it creates one inline, at the cost of NewPeerConnection.
+func (p *PeerConnectionPool) Acquire() (*PeerConnection, error) {
+	p.mu.RLock()
+	defer p.mu.RUnlock()
+
+	if p.handle == 0 {
+		return nil, ErrPoolClosed
+	}
+	handle, _, err := ffi.PeerConnectionAcquire(p.handle)
+	if err != nil {
+		return nil, fmt.Errorf("acquire peer connection: %w", err)
+	}
+	return wrapPeerConnection(handle, p.config), nil
+}
+
+// Ready returns the number of PeerConnections waiting in the pool.
+func (p *PeerConnectionPool) Ready() int {
+	p.mu.RLock()
+	defer p.mu.RUnlock()
+	return ffi.PeerConnectionPoolReady(p.handle)
+}
+
+// Close stops refilling and releases the idle PeerConnections.
+// Acquired PeerConnections are unaffected.
+func (p *PeerConnectionPool) Close() error {
+	p.mu.Lock()
+	defer p.mu.Unlock()
+
+	if p.handle != 0 {
+		ffi.PeerConnectionPoolDestroy(p.handle)
+		p.handle = 0
+	}
+	return nil
+}
@@ -0,0 +1,171 @@
+package pc
+
+import (
+	"errors"
+	"fmt"
+	"sync"
+	"time"
+
+	"github.com/thesyncim/libgowebrtc/internal/ffi"
+	"github.com/thesyncim/libgowebrtc/pkg/codec"
+	"github.com/thesyncim/libgowebrtc/pkg/frame"
+)
+
+// ErrSharedVideoEncoderClosed is returned when using a closed SharedVideoEncoder.
+var ErrSharedVideoEncoderClosed = errors.New("shared video encoder closed")
+
+// maxTemporalLayer is the highest temporal layer id; a track limited to it
+// forwards every layer.
+const maxTemporalLayer = 7
+
+// SharedVideoEncoderConfig configures a SharedVideoEncoder.
+type SharedVideoEncoderConfig struct {
+	Codec  codec.Type
+	Width  int
+	Height int
+
+	// BitrateBps is the target bitrate, and the highest one SetRates accepts.
+	BitrateBps int
+
+	// FPS is the expected frame rate. Zero means 30.
+	FPS int
+
+	// TemporalLayers (1-3) lets tracks forward only the lower layers with
+	// Track.SetMaxTemporalLayer. Zero means 1.
+	TemporalLayers int
+
+	// MinKeyFrameInterval is the least time between keyframes encoded on
+	// request; requests of all tracks within it are merged. Zero means
+	// 500ms.
+	MinKeyFrameInterval time.Duration
+}
+
+// SharedVideoEncoder encodes one video source once for any number of tracks,
+// so the same stream sent on many PeerConnections costs a single encode.
+//
+// Create tracks with PeerConnection.CreateSharedVideoTrack. Keyframe requests
+// of all tracks are merged into the next encoded frame, and a track added
+// mid-stream starts with the latest keyframe instead of asking for a new one
+// for everyone.
+//
+// The encoder runs at its configured rates: the bandwidth estimate of each
+// PeerConnection does not change them, so pick rates every subscriber can
+// receive or call SetRates from the application.
+type SharedVideoEncoder struct {
+	handle uintptr
+	codec  codec.Type
+	width  int
+	height int
+	mu     sync.RWMutex
+}
+
+// NewSharedVideoEncoder creates a shared encoder.
+func NewSharedVideoEncoder(cfg SharedVideoEncoderConfig) (*SharedVideoEncoder, error) {
+	if err := ffi.LoadLibrary(); err != nil {
+		return nil, err
+	}
+	switch cfg.Codec {
+	case codec.H264, codec.VP8, codec.VP9, codec.AV1:
+	default:
+		return nil, fmt.Errorf("unsupported codec for shared encoder: %s", cfg.Codec)
+	}
+	if cfg.Width <= 0 || cfg.Height <= 0 {
+		return nil, errors.New("invalid video dimensions")
+	}
+	if cfg.BitrateBps <= 0 {
+		return nil, fmt.Errorf("create shared video encoder: invalid bitrate %d", cfg.BitrateBps)
+	}
+	if cfg.TemporalLayers < 0 || cfg.TemporalLayers > 3 {
+		return nil, fmt.Errorf("create shared video encoder: invalid temporal layers %d", cfg.TemporalLayers)
+	}
+	fps := cfg.FPS
+	if fps <= 0 {
+		fps = 30
+	}
+
+	handle, err := ffi.SharedVideoEncoderCreate(ffi.CodecType(cfg.Codec), cfg.Width, cfg.Height, cfg.BitrateBps, fps,
+		cfg.TemporalLayers, int(cfg.MinKeyFrameInterval.Milliseconds()))
+	if err != nil {
+		return nil, err
+	}
+	return &SharedVideoEncoder{
+		handle: handle,
+		codec:  cfg.Codec,
+		width:  cfg.Width,
+		height: cfg.Height,
+	}, nil
+}
+
+// WriteFrame encodes an I420 frame and sends it on every track of the
+// encoder. PTS is in 90kHz units, as for Track.WriteVideoFrame.
+func (e *SharedVideoEncoder) WriteFrame(f *frame.VideoFrame) error {
+	if f.Format != frame.PixelFormatI420 {
+		return errors.New("only I420 format supported")
+	}
+	if len(f.Data) < 3 || len(f.Stride) < 3 {
+		return errors.New("invalid I420 frame data")
+	}
+
+	e.mu.RLock()
+	defer e.mu.RUnlock()
+
+	if e.handle == 0 {
+		return ErrSharedVideoEncoderClosed
+	}
+	timestampUs := int64(f.PTS) * 1000000 / 90000
+	return ffi.SharedVideoEncoderPushFrame(
+		e.handle,
+		f.Data[0], f.Data[1], f.Data[2],
+		f.Stride[0], f.Stride[1], f.Stride[2],
+		timestampUs,
+	)
+}
+
+// SetRates changes the target bitrate and frame rate. The bitrate is capped
+// at the configured one.
+func (e *SharedVideoEncoder) SetRates(bitrateBps, fps int) error {
+	e.mu.RLock()
+	defer e.mu.RUnlock()
+
+	if e.handle == 0 {
+		return ErrSharedVideoEncoderClosed
+	}
+	return ffi.SharedVideoEncoderSetRates(e.handle, bitrateBps, fps)
+}
+
+// Close releases the encoder. Its tracks stay added but send no more frames.
+func (e *SharedVideoEncoder) Close() error {
+	e.mu.Lock()
+	defer e.mu.Unlock()
+
+	if e.handle != 0 {
+		ffi.SharedVideoEncoderDestroy(e.handle)
+		e.handle = 0
+	}
+	return nil
+}
+
+// subscribe creates an encoded source fed by the encoder.
+func (e *SharedVideoEncoder) subscribe(layer int) (uintptr, error) {
+	e.mu.RLock()
+	defer e.mu.RUnlock()
+
+	if e.handle == 0 {
+		return 0, ErrSharedVideoEncoderClosed
+	}
+	return ffi.SharedVideoEncoderSubscribe(e.handle, layer)
+}
+
+// CreateSharedVideoTrack creates a video track fed by a shared encoder. Each
+// PeerConnection sending the stream gets its own track; none re-encodes.
+func (pc *PeerConnection) CreateSharedVideoTrack(id string, enc *SharedVideoEncoder) (*Track, error) {
+	if enc == nil {
+		return nil, errors.New("nil shared video encoder")
+	}
+	track, err := pc.CreateEncodedVideoTrack(id, enc.codec, enc.width, enc.height)
+	if err != nil {
+		return nil, err
+	}
+	track.shared = enc
+	return track, nil
+}
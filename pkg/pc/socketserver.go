@@ -0,0 +1,65 @@
+package pc
+
+import (
+	"fmt"
+
+	"github.com/thesyncim/libgowebrtc/internal/ffi"
+)
+
+// SocketServer selects how a network thread performs UDP I/O.
+type SocketServer int
+
+const (
+	// SocketServerDefault uses the process-wide selection made with
+	// SetSocketServer, or the batched server when LIBWEBRTC_BATCHED_UDP is set
+	// on Linux.
+	SocketServerDefault SocketServer = iota
+	// SocketServerPhysical is libwebrtc's socket server: one syscall per packet.
+	SocketServerPhysical
+	// SocketServerBatched reads with recvmmsg and UDP GRO and flushes sends
+	// with sendmmsg and UDP GSO once the network thread goes idle or 64
+	// packets are queued. Linux only.
+	SocketServerBatched
+)
+
+// SetSocketServer selects the socket server used by the global network thread
+// and by thread groups created with SocketServerDefault. It must be called
+// before the first PeerConnection, Factory or ThreadGroup is created.
+func SetSocketServer(server SocketServer) error {
+	if err := ffi.LoadLibrary(); err != nil {
+		return err
+	}
+	if err := ffi.SetSocketServer(int32(server)); err != nil {
+		return fmt.Errorf("set socket server: %w", err)
+	}
+	return nil
+}
+
+// SocketServerStats holds cumulative counters for every batched socket
+// server in the process. Packets per call (RecvPackets/RecvCalls and
+// SendPackets/SendCalls) show how much batching the workload gets.
+type SocketServerStats struct {
+	RecvCalls   uint64 // recvmmsg calls, including empty reads
+	RecvPackets uint64 // Packets received; GRO segments count separately
+	SendCalls   uint64 // sendmmsg calls
+	SendPackets uint64 // Packets flushed
+	GSOSends    uint64 // Messages carrying more than one GSO segment
+	SendDrops   uint64 // Packets the kernel refused, e.g. on a full send buffer
+}
+
+// GetSocketServerStats returns the batched socket server counters. They stay
+// zero when the library is not loaded or no batched server is in use.
+func GetSocketServerStats() SocketServerStats {
+	if err := ffi.LoadLibrary(); err != nil {
+		return SocketServerStats{}
+	}
+	s := ffi.GetSocketServerStats()
+	return SocketServerStats{
+		RecvCalls:   s.RecvCalls,
+		RecvPackets: s.RecvPackets,
+		SendCalls:   s.SendCalls,
+		SendPackets: s.SendPackets,
+		GSOSends:    s.GSOSends,
+		SendDrops:   s.SendDrops,
+	}
+}
@@ -0,0 +1,217 @@
+package pc
+
+import (
+	"errors"
+	"sync"
+	"time"
+
+	"github.com/thesyncim/libgowebrtc/internal/ffi"
+)
+
+// StreamDirection tells whether a stream is sent or received.
+type StreamDirection int
+
+const (
+	StreamOutbound StreamDirection = ffi.StreamOutbound
+	StreamInbound  StreamDirection = ffi.StreamInbound
+)
+
+func (d StreamDirection) String() string {
+	switch d {
+	case StreamOutbound:
+		return "outbound"
+	case StreamInbound:
+		return "inbound"
+	default:
+		return "unknown"
+	}
+}
+
+// StreamStats holds the statistics of one RTP stream (one SSRC).
+// Counters are cumulative since the stream started.
+type StreamStats struct {
+	SSRC      uint32
+	Direction StreamDirection
+	Kind      string // "audio" or "video"
+	MID       string // MID of the owning transceiver
+	RID       string // Simulcast RID (outbound only)
+
+	TimestampUs              int64
+	Bytes                    int64 // Payload bytes sent or received
+	Packets                  int64 // Packets sent or received
+	PacketsLost              int64 // Inbound: local count; outbound: reported by the remote
+	RetransmittedBytes       int64 // Outbound only
+	JitterBufferEmittedCount int64
+	QPSum                    int64
+
+	JitterMs            float64 // Inbound: local; outbound: reported by the remote
+	RoundTripTimeMs     float64 // Outbound only, from RTCP receiver reports
+	FractionLost        float64 // Outbound only, from the last receiver report
+	TargetBitrateBps    float64 // Outbound only
+	FramesPerSecond     float64
+	JitterBufferDelayMs float64 // Inbound: mean delay per emitted sample or frame
+	AudioLevel          float64 // Inbound audio only
+
+	Frames                  int // Frames encoded or decoded
+	KeyFrames               int
+	FramesDropped           int // Inbound only
+	FrameWidth              int
+	FrameHeight             int
+	NACKCount               int
+	PLICount                int
+	FIRCount                int
+	QualityLimitationReason QualityLimitationReason
+
+	// Set only by delta-mode calls: rates since the previous delta-mode call
+	// for this stream. Interval is zero on a stream's first sample.
+	Interval         time.Duration
+	BitrateBps       float64
+	PacketRate       float64
+	IntervalLossRate float64 // Lost / (packets + lost) over the interval
+}
+
+// StreamStatsOptions configures AppendStreamStats.
+type StreamStatsOptions struct {
+	// Delta fills the interval fields. The previous counters are kept per
+	// PeerConnection, so only one poller per PeerConnection should use it.
+	Delta bool
+}
+
+// streamStatsScratch holds C-layout buffers reused across stats calls.
+var streamStatsScratch = sync.Pool{
+	New: func() any {
+		buf := make([]ffi.StreamStats, 8)
+		return &buf
+	},
+}
+
+func appendStreamStats(dst []StreamStats, pcHandle, sender, receiver uintptr, opts StreamStatsOptions) ([]StreamStats, error) {
+	var flags int32
+	if opts.Delta {
+		flags |= ffi.StatsFlagDelta
+	}
+
+	bufp := streamStatsScratch.Get().(*[]ffi.StreamStats)
+	defer streamStatsScratch.Put(bufp)
+
+	count, total, err := ffi.PeerConnectionGetStreamStats(pcHandle, sender, receiver, flags, *bufp)
+	if err != nil {
+		return dst, err
+	}
+	if total > count {
+		// Retrying within the stats cache window returns the same report,
+		// and delta mode repeats the same rates for it.
+		*bufp = make([]ffi.StreamStats, total)
+		count, _, err = ffi.PeerConnectionGetStreamStats(pcHandle, sender, receiver, flags, *bufp)
+		if err != nil {
+			return dst, err
+		}
+	}
+
+	for i := range (*bufp)[:count] {
+		dst = append(dst, convertFFIStreamStats(&(*bufp)[i]))
+	}
+	return dst, nil
+}
+
+func convertFFIStreamStats(s *ffi.StreamStats) StreamStats {
+	kind := "audio"
+	if s.Kind == 1 {
+		kind = "video"
+	}
+	return StreamStats{
+		SSRC:                     s.SSRC,
+		Direction:                StreamDirection(s.Direction),
+		Kind:                     kind,
+		MID:                      ffi.ByteArrayToString(s.Mid[:]),
+		RID:                      ffi.ByteArrayToString(s.RID[:]),
+		TimestampUs:              s.TimestampUs,
+		Bytes:                    s.Bytes,
+		Packets:                  s.Packets,
+		PacketsLost:              s.PacketsLost,
+		RetransmittedBytes:       s.RetransmittedBytes,
+		JitterBufferEmittedCount: s.JitterBufferEmittedCount,
+		QPSum:                    s.QPSum,
+		JitterMs:                 s.JitterMs,
+		RoundTripTimeMs:          s.RoundTripTimeMs,
+		FractionLost:             s.FractionLost,
+		TargetBitrateBps:         s.TargetBitrateBps,
+		FramesPerSecond:          s.FramesPerSecond,
+		JitterBufferDelayMs:      s.JitterBufferDelayMs,
+		AudioLevel:               s.AudioLevel,
+		Frames:                   int(s.Frames),
+		KeyFrames:                int(s.KeyFrames),
+		FramesDropped:            int(s.FramesDropped),
+		FrameWidth:               int(s.FrameWidth),
+		FrameHeight:              int(s.FrameHeight),
+		NACKCount:                int(s.NACKCount),
+		PLICount:                 int(s.PLICount),
+		FIRCount:                 int(s.FIRCount),
+		QualityLimitationReason:  QualityLimitationReason(s.QualityLimitationReason),
+		Interval:                 time.Duration(s.IntervalUs) * time.Microsecond,
+		BitrateBps:               s.BitrateBps,
+		PacketRate:               s.PacketRate,
+		IntervalLossRate:         s.IntervalLossRate,
+	}
+}
+
+// AppendStreamStats appends the statistics of every RTP stream to dst.
+// Reuse dst across polls to avoid allocating.
+func (pc *PeerConnection) AppendStreamStats(dst []StreamStats, opts StreamStatsOptions) ([]StreamStats, error) {
+	handle, err := pc.rlockHandle()
+	if err != nil {
+		return dst, err
+	}
+	defer pc.mu.RUnlock()
+
+	return appendStreamStats(dst, handle, 0, 0, opts)
+}
+
+// AppendStreamStats appends the statistics of this sender's streams
+// (one per simulcast layer) to dst. Only the sender's stats are collected,
+// which is much cheaper than a full PeerConnection report.
+func (s *RTPSender) AppendStreamStats(dst []StreamStats, opts StreamStatsOptions) ([]StreamStats, error) {
+	s.mu.RLock()
+	defer s.mu.RUnlock()
+
+	if s.handle == 0 || s.pc == nil {
+		return dst, errors.New("sender not initialized")
+	}
+	pcHandle, err := s.pc.rlockHandle()
+	if err != nil {
+		return dst, err
+	}
+	defer s.pc.mu.RUnlock()
+
+	return appendStreamStats(dst, pcHandle, s.handle, 0, opts)
+}
+
+// AppendStreamStats appends the statistics of this receiver's streams to
+// dst. Only the receiver's stats are collected.
+func (r *RTPReceiver) AppendStreamStats(dst []StreamStats, opts StreamStatsOptions) ([]StreamStats, error) {
+	if r.handle == 0 || r.pc == nil {
+		return dst, errors.New("receiver not initialized")
+	}
+	pcHandle, err := r.pc.rlockHandle()
+	if err != nil {
+		return dst, err
+	}
+	defer r.pc.mu.RUnlock()
+
+	return appendStreamStats(dst, pcHandle, 0, r.handle, opts)
+}
+
+// rlockHandle read-locks pc and returns its native handle. On success the
+// caller must release pc.mu with RUnlock.
+func (pc *PeerConnection) rlockHandle() (uintptr, error) {
+	if pc.closed.Load() {
+		return 0, ErrPeerConnectionClosed
+	}
+
+	pc.mu.RLock()
+	if pc.handle == 0 {
+		pc.mu.RUnlock()
+		return 0, errors.New("peer connection not initialized")
+	}
+	return pc.handle, nil
+}
@@ -0,0 +1,196 @@
+package pc
+
+import (
+	"errors"
+	"fmt"
+	"sync"
+	"time"
+
+	"github.com/thesyncim/libgowebrtc/internal/ffi"
+)
+
+// ErrStatsRingClosed is returned when using a closed StatsRing.
+var ErrStatsRingClosed = errors.New("stats ring closed")
+
+// StatsRecord is one RTP stream of one collection round.
+type StatsRecord struct {
+	// Tag is the value given to Subscribe for the PeerConnection.
+	Tag uint64
+	// Round identifies the collection round; the records of one round share it.
+	Round time.Duration
+	// StreamIndex and StreamCount place the record within its round. A round
+	// of a PeerConnection without RTP streams is a single record with
+	// StreamCount zero and only the transport fields set.
+	StreamIndex int
+	StreamCount int
+
+	// Transport fields from the selected ICE candidate pair, repeated in
+	// every record of a round.
+	CurrentRoundTripTimeMs   float64
+	AvailableOutgoingBitrate float64
+	AvailableIncomingBitrate float64
+
+	// Stream holds the stream's counters. Its interval fields are relative to
+	// the subscription's previous round.
+	Stream StreamStats
+}
+
+// StatsRing collects the stats of subscribed PeerConnections in the
+// background and publishes them as fixed-layout records in native memory.
+//
+// Each subscription is collected on a shim thread at its own interval without
+// blocking any libwebrtc thread, and Read copies the records straight out of
+// the ring, so polling many PeerConnections costs no calls into the shim.
+// A ring has a single reader; when it falls behind, new records are dropped
+// (see Dropped).
+type StatsRing struct {
+	handle uintptr
+	reader *ffi.StatsRingReader
+
+	mu      sync.Mutex // guards handle for Subscribe, Unsubscribe and Close
+	readMu  sync.Mutex // serializes Read against Close
+	scratch []ffi.StatsRecord
+}
+
+// NewStatsRing creates a stats ring holding up to capacity unread records.
+// Zero selects the default capacity (4096).
+func NewStatsRing(capacity int) (*StatsRing, error) {
+	if err := ffi.LoadLibrary(); err != nil {
+		return nil, err
+	}
+	if capacity < 0 {
+		return nil, fmt.Errorf("create stats ring: invalid capacity %d", capacity)
+	}
+
+	handle, err := ffi.CreateStatsRing(capacity)
+	if err != nil {
+		return nil, fmt.Errorf("create stats ring: %w", err)
+	}
+	reader, err := ffi.NewStatsRingReader(ffi.StatsRingHeaderPtr(handle))
+	if err != nil {
+		ffi.StatsRingDestroy(handle)
+		return nil, fmt.Errorf("create stats ring: %w", err)
+	}
+	return &StatsRing{handle: handle, reader: reader}, nil
+}
+
+// Subscribe collects pc's stats into the ring every interval, tagging its
+// records with tag. Subscribing again replaces the interval and tag.
+// Closing pc unsubscribes it.
+func (r *StatsRing) Subscribe(pc *PeerConnection, interval time.Duration, tag uint64) error {
+	if interval < time.Millisecond {
+		return fmt.Errorf("subscribe stats: interval %v below 1ms", interval)
+	}
+	if pc.closed.Load() {
+		return ErrPeerConnectionClosed
+	}
+
+	pc.mu.Lock()
+	defer pc.mu.Unlock()
+	if pc.handle == 0 {
+		return ErrPeerConnectionClosed
+	}
+
+	r.mu.Lock()
+	defer r.mu.Unlock()
+	if r.handle == 0 {
+		return ErrStatsRingClosed
+	}
+
+	if err := ffi.StatsRingSubscribe(r.handle, pc.handle, int(interval/time.Millisecond), tag); err != nil {
+		return fmt.Errorf("subscribe stats: %w", err)
+	}
+	for _, ring := range pc.statsRings {
+		if ring == r {
+			return nil
+		}
+	}
+	pc.statsRings = append(pc.statsRings, r)
+	return nil
+}
+
+// Unsubscribe stops collecting pc's stats. Records already in the ring are
+// still returned by Read.
+func (r *StatsRing) Unsubscribe(pc *PeerConnection) {
+	pc.mu.Lock()
+	defer pc.mu.Unlock()
+
+	for i, ring := range pc.statsRings {
+		if ring == r {
+			pc.statsRings = append(pc.statsRings[:i], pc.statsRings[i+1:]...)
+			break
+		}
+	}
+	if pc.handle != 0 {
+		r.unsubscribe(pc.handle)
+	}
+}
+
+// unsubscribe removes a native PeerConnection. Callers hold its pc.mu.
+func (r *StatsRing) unsubscribe(pcHandle uintptr) {
+	r.mu.Lock()
+	defer r.mu.Unlock()
+
+	if r.handle != 0 {
+		ffi.StatsRingUnsubscribe(r.handle, pcHandle)
+	}
+}
+
+// Read appends the records published since the previous Read to dst, in
+// publication order. Reuse dst across polls to avoid allocating.
+func (r *StatsRing) Read(dst []StatsRecord) ([]StatsRecord, error) {
+	r.readMu.Lock()
+	defer r.readMu.Unlock()
+
+	if r.reader == nil {
+		return dst, ErrStatsRingClosed
+	}
+	r.scratch = r.reader.Read(r.scratch[:0])
+	for i := range r.scratch {
+		rec := &r.scratch[i]
+		dst = append(dst, StatsRecord{
+			Tag:                      rec.Tag,
+			Round:                    time.Duration(rec.RoundUs) * time.Microsecond,
+			StreamIndex:              int(rec.StreamIndex),
+			StreamCount:              int(rec.StreamCount),
+			CurrentRoundTripTimeMs:   rec.CurrentRTTMs,
+			AvailableOutgoingBitrate: rec.AvailableOutgoingBitrate,
+			AvailableIncomingBitrate: rec.AvailableIncomingBitrate,
+			Stream:                   convertFFIStreamStats(&rec.Stream),
+		})
+	}
+	return dst, nil
+}
+
+// Dropped returns the number of records dropped because the reader fell
+// behind.
+func (r *StatsRing) Dropped() uint64 {
+	r.readMu.Lock()
+	defer r.readMu.Unlock()
+
+	if r.reader == nil {
+		return 0
+	}
+	return r.reader.Dropped()
+}
+
+// Close stops collection for every subscribed PeerConnection and frees the
+// ring.
+func (r *StatsRing) Close() error {
+	r.mu.Lock()
+	handle := r.handle
+	r.handle = 0
+	r.mu.Unlock()
+	if handle == 0 {
+		return nil
+	}
+
+	// The ring memory goes away with the handle; wait out any Read.
+	r.readMu.Lock()
+	r.reader = nil
+	r.scratch = nil
+	r.readMu.Unlock()
+
+	ffi.StatsRingDestroy(handle)
+	return nil
+}
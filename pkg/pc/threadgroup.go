@@ -0,0 +1,125 @@
+package pc
+
+import (
+	"errors"
+	"fmt"
+	"sync"
+
+	"github.com/thesyncim/libgowebrtc/internal/ffi"
+)
+
+// ErrThreadGroupClosed is returned when creating a PeerConnection from a closed ThreadGroup.
+var ErrThreadGroupClosed = errors.New("thread group closed")
+
+// ThreadGroupConfig configures a ThreadGroup.
+type ThreadGroupConfig struct {
+	// Shards is the number of signaling/worker/network thread triplets.
+	// Zero creates one shard per CPU core.
+	Shards int
+
+	// Factory configures the media engine built for each shard.
+	Factory FactoryConfig
+
+	// PinThreads pins each shard's threads to a single CPU. Linux only.
+	PinThreads bool
+
+	// CPUs lists the CPUs used when PinThreads is set; shard i is pinned to
+	// CPUs[i%len(CPUs)]. Empty pins shard i to CPU i modulo the core count.
+	CPUs []int
+
+	// SocketServer selects the socket server behind each shard's network
+	// thread. The zero value uses the process-wide selection.
+	SocketServer SocketServer
+}
+
+// ThreadGroup spreads PeerConnections across several independent
+// signaling/worker/network thread triplets, each with its own Factory.
+//
+// By default every PeerConnection shares the same three libwebrtc threads,
+// which caps a process at roughly one core of signaling and network work.
+// A ThreadGroup lets that work scale with the number of shards.
+// Closing a ThreadGroup does not affect PeerConnections already created from it;
+// they keep their shard's threads alive until they are closed.
+type ThreadGroup struct {
+	handle uintptr
+	shards int
+	mu     sync.RWMutex
+}
+
+// NewThreadGroup creates a sharded thread group.
+func NewThreadGroup(cfg ThreadGroupConfig) (*ThreadGroup, error) {
+	if err := ffi.LoadLibrary(); err != nil {
+		return nil, err
+	}
+	if cfg.Shards < 0 {
+		return nil, fmt.Errorf("create thread group: invalid shard count %d", cfg.Shards)
+	}
+	if err := cfg.Factory.Loopback.acquire(); err != nil {
+		return nil, err
+	}
+	defer cfg.Factory.Loopback.release()
+
+	var cpus []int32
+	if len(cfg.CPUs) > 0 {
+		cpus = make([]int32, len(cfg.CPUs))
+		for i, cpu := range cfg.CPUs {
+			cpus[i] = int32(cpu)
+		}
+	}
+
+	handle, err := ffi.CreateThreadGroup(&ffi.ThreadGroupConfig{
+		ShardCount:    cfg.Shards,
+		FactoryConfig: cfg.Factory.toFFI(),
+		PinThreads:    cfg.PinThreads,
+		CPUIDs:        cpus,
+		SocketServer:  int32(cfg.SocketServer),
+	})
+	if err != nil {
+		return nil, fmt.Errorf("create thread group: %w", err)
+	}
+	return &ThreadGroup{handle: handle, shards: ffi.ThreadGroupShardCount(handle)}, nil
+}
+
+// Shards returns the number of shards in the group.
+func (g *ThreadGroup) Shards() int {
+	return g.shards
+}
+
+// NewPeerConnection creates a PeerConnection on the next shard in round-robin order.
+func (g *ThreadGroup) NewPeerConnection(config Configuration) (*PeerConnection, error) {
+	g.mu.RLock()
+	defer g.mu.RUnlock()
+
+	if g.handle == 0 {
+		return nil, ErrThreadGroupClosed
+	}
+	return newPeerConnection(ffi.ThreadGroupNextFactory(g.handle), config)
+}
+
+// NewPeerConnectionOnShard creates a PeerConnection on a specific shard.
+// Use it to co-locate connections that exchange media with each other.
+func (g *ThreadGroup) NewPeerConnectionOnShard(shard int, config Configuration) (*PeerConnection, error) {
+	g.mu.RLock()
+	defer g.mu.RUnlock()
+
+	if g.handle == 0 {
+		return nil, ErrThreadGroupClosed
+	}
+	factory := ffi.ThreadGroupFactory(g.handle, shard)
+	if factory == 0 {
+		return nil, fmt.Errorf("shard %d out of range [0, %d)", shard, g.shards)
+	}
+	return newPeerConnection(factory, config)
+}
+
+// Close releases the thread group handle.
+func (g *ThreadGroup) Close() error {
+	g.mu.Lock()
+	defer g.mu.Unlock()
+
+	if g.handle != 0 {
+		ffi.ThreadGroupDestroy(g.handle)
+		g.handle = 0
+	}
+	return nil
+}
@@ -0,0 +1,185 @@
+package pc
+
+import (
+	"errors"
+	"fmt"
+	"sync"
+
+	"github.com/thesyncim/libgowebrtc/internal/ffi"
+	"github.com/thesyncim/libgowebrtc/pkg/frame"
+)
+
+// ErrVideoFrameRingClosed is returned when using a closed VideoFrameRing.
+var ErrVideoFrameRingClosed = errors.New("video frame ring closed")
+
+// ErrTrackDisabled is returned by VideoFrameRing.Publish when the frame was
+// dropped because its track is disabled.
+var ErrTrackDisabled = errors.New("track disabled")
+
+// VideoFrameRing feeds a local video track through frame slots in native
+// memory, as a zero-copy alternative to Track.WriteVideoFrame.
+//
+// Next hands out the planes of a free slot for the application to render or
+// decode into, and Publish queues the slot without calling into the shim: a
+// shim thread sends it to the track, and frames sent at full size reach the
+// encoder without a copy. The slot is reused once the encoder is done with
+// it. A ring has a single writer.
+type VideoFrameRing struct {
+	track  *Track
+	handle uintptr
+	writer *ffi.VideoFrameRingWriter
+	frame  frame.VideoFrame
+	ready  bool // A slot is handed out by Next
+	// The track closed the ring while the writer held a slot; the writer's
+	// next call destroys it, as the slot's planes stay mapped until then.
+	orphaned bool
+
+	mu sync.Mutex
+}
+
+// NewVideoFrameRing creates a frame ring with the given number of slots
+// (rounded up to a power of two, at most 64; zero selects 4) for a raw video
+// track added to a PeerConnection. A track has at most one ring; it is
+// closed with the track's removal or when the PeerConnection is closed. A slot
+// handed out by Next at that time stays valid until the writer's next call.
+func (t *Track) NewVideoFrameRing(slots int) (*VideoFrameRing, error) {
+	if t.kind != "video" || t.encoded {
+		return nil, errors.New("not a raw video track")
+	}
+	if slots < 0 || slots > 64 {
+		return nil, fmt.Errorf("create video frame ring: invalid slots %d", slots)
+	}
+
+	t.mu.Lock()
+	defer t.mu.Unlock()
+
+	if t.sourceHandle == 0 {
+		return nil, errors.New("track source not initialized")
+	}
+	if t.frameRing != nil {
+		return nil, errors.New("track already has a video frame ring")
+	}
+	handle, err := ffi.CreateVideoFrameRing(t.sourceHandle, slots)
+	if err != nil {
+		return nil, fmt.Errorf("create video frame ring: %w", err)
+	}
+	writer, err := ffi.NewVideoFrameRingWriter(ffi.VideoFrameRingHeaderPtr(handle))
+	if err != nil {
+		ffi.VideoFrameRingDestroy(handle)
+		return nil, fmt.Errorf("create video frame ring: %w", err)
+	}
+	h := writer.Header()
+	r := &VideoFrameRing{
+		track:  t,
+		handle: handle,
+		writer: writer,
+		frame: frame.VideoFrame{
+			Width:  int(h.Width),
+			Height: int(h.Height),
+			Format: frame.PixelFormatI420,
+			Stride: []int{int(h.YStride), int(h.UStride), int(h.VStride)},
+		},
+	}
+	t.frameRing = r
+	return r, nil
+}
+
+// Next returns the next free slot as an I420 frame whose planes live in the
+// ring. Fill the planes and PTS, then call Publish. It reports false while
+// every slot is queued or held by the encoder, or after Close. Calling Next
+// again before Publish returns the same slot.
+//
+// The frame and its planes belong to the ring: they must not be used after
+// Publish or Close.
+func (r *VideoFrameRing) Next() (*frame.VideoFrame, bool) {
+	r.mu.Lock()
+	defer r.mu.Unlock()
+
+	if r.handle == 0 {
+		return nil, false
+	}
+	if r.orphaned {
+		r.destroy()
+		return nil, false
+	}
+	y, u, v, ok := r.writer.Next()
+	if !ok {
+		return nil, false
+	}
+	r.frame.Data = append(r.frame.Data[:0], y, u, v)
+	r.frame.PTS = 0
+	r.ready = true
+	return &r.frame, true
+}
+
+// Publish sends the frame returned by Next, stamped with its PTS (90kHz, as
+// for Track.WriteVideoFrame). While the track is disabled the frame is
+// dropped, Publish returns ErrTrackDisabled and Next hands out the slot again.
+func (r *VideoFrameRing) Publish() error {
+	r.mu.Lock()
+	defer r.mu.Unlock()
+
+	if r.handle == 0 {
+		return ErrVideoFrameRingClosed
+	}
+	if r.orphaned {
+		r.destroy()
+		return ErrVideoFrameRingClosed
+	}
+	if !r.ready {
+		return errors.New("no frame from Next to publish")
+	}
+	if !r.track.enabled.Load() {
+		return ErrTrackDisabled
+	}
+	r.ready = false
+	r.writer.Publish(int64(r.frame.PTS) * 1000000 / 90000)
+	r.frame.Data = r.frame.Data[:0]
+	return nil
+}
+
+// Close stops the ring. Published frames the ring has not yet passed to the
+// track are dropped; frames already passed on may still be sent.
+func (r *VideoFrameRing) Close() error {
+	r.mu.Lock()
+	if r.handle != 0 {
+		r.destroy()
+	}
+	r.mu.Unlock()
+	r.unlink()
+	return nil
+}
+
+// closeFromTrack closes the ring on behalf of its track, from a goroutine
+// other than the writer's. A slot the writer holds keeps the ring until the
+// writer's next call.
+func (r *VideoFrameRing) closeFromTrack() {
+	r.mu.Lock()
+	if r.handle != 0 {
+		if r.ready {
+			r.orphaned = true
+		} else {
+			r.destroy()
+		}
+	}
+	r.mu.Unlock()
+	r.unlink()
+}
+
+// destroy must be called with r.mu held.
+func (r *VideoFrameRing) destroy() {
+	ffi.VideoFrameRingDestroy(r.handle)
+	r.handle = 0
+	r.ready = false
+	r.orphaned = false
+	r.frame.Data = nil
+}
+
+func (r *VideoFrameRing) unlink() {
+	t := r.track
+	t.mu.Lock()
+	if t.frameRing == r {
+		t.frameRing = nil
+	}
+	t.mu.Unlock()
+}
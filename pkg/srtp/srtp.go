@@ -0,0 +1,208 @@
+// Package srtp provides batch SRTP/SRTCP protection using libwebrtc's libsrtp.
+//
+// It is meant for media that is transported outside a libwebrtc
+// PeerConnection (for example an SFU forwarding path keyed from pion's DTLS),
+// moving bulk encryption out of Go and into libsrtp's optimized AES code.
+package srtp
+
+import (
+	"errors"
+	"sync/atomic"
+	"unsafe"
+
+	"github.com/thesyncim/libgowebrtc/internal/ffi"
+)
+
+// Errors
+var (
+	ErrContextClosed = errors.New("srtp context is closed")
+	ErrInvalidKey    = errors.New("invalid srtp key or salt length")
+)
+
+// Profile identifies an SRTP protection profile.
+type Profile int32
+
+// Supported protection profiles (RFC 5764, RFC 7714).
+const (
+	ProfileAES128CMHMACSHA1_80 = Profile(ffi.SRTPProfileAES128CMHMACSHA1_80)
+	ProfileAES128CMHMACSHA1_32 = Profile(ffi.SRTPProfileAES128CMHMACSHA1_32)
+	ProfileAEADAES128GCM       = Profile(ffi.SRTPProfileAEADAES128GCM)
+	ProfileAEADAES256GCM       = Profile(ffi.SRTPProfileAEADAES256GCM)
+)
+
+// MaxTrailerLen is the most bytes protection appends to a packet.
+// Buffers passed to ProtectRTP/ProtectRTCP need this much spare capacity.
+const MaxTrailerLen = ffi.SRTPMaxTrailerLen
+
+// KeyLen returns the master key length in bytes for the profile.
+func (p Profile) KeyLen() int {
+	switch p {
+	case ProfileAES128CMHMACSHA1_80, ProfileAES128CMHMACSHA1_32, ProfileAEADAES128GCM:
+		return 16
+	case ProfileAEADAES256GCM:
+		return 32
+	default:
+		return 0
+	}
+}
+
+// SaltLen returns the master salt length in bytes for the profile.
+func (p Profile) SaltLen() int {
+	switch p {
+	case ProfileAES128CMHMACSHA1_80, ProfileAES128CMHMACSHA1_32:
+		return 14
+	case ProfileAEADAES128GCM, ProfileAEADAES256GCM:
+		return 12
+	default:
+		return 0
+	}
+}
+
+// Keys holds the master key and salt for one direction.
+type Keys struct {
+	Key  []byte
+	Salt []byte
+}
+
+// Config configures an SRTP context.
+// Either direction may be left empty for send-only or receive-only use.
+type Config struct {
+	Profile Profile
+	Local   Keys // Used by ProtectRTP/ProtectRTCP
+	Remote  Keys // Used by UnprotectRTP/UnprotectRTCP
+}
+
+// Context protects and unprotects batches of packets in place.
+//
+// A Context takes no locks: it must not be used from multiple goroutines at
+// once. Use one Context per transport (or per goroutine) for parallelism.
+type Context struct {
+	handle uintptr
+	closed atomic.Bool
+
+	// Scratch arrays reused across calls so batches don't allocate.
+	ptrs  []uintptr
+	sizes []int32
+	caps  []int32
+}
+
+// NewContext creates an SRTP context from DTLS-SRTP keying material.
+func NewContext(cfg Config) (*Context, error) {
+	if err := ffi.LoadLibrary(); err != nil {
+		return nil, err
+	}
+
+	sendKey, err := masterKey(cfg.Profile, cfg.Local)
+	if err != nil {
+		return nil, err
+	}
+	recvKey, err := masterKey(cfg.Profile, cfg.Remote)
+	if err != nil {
+		return nil, err
+	}
+
+	handle, err := ffi.CreateSRTPContext(ffi.SRTPProfile(cfg.Profile), sendKey, recvKey)
+	clear(sendKey)
+	clear(recvKey)
+	if err != nil {
+		return nil, err
+	}
+	return &Context{handle: handle}, nil
+}
+
+// masterKey concatenates key and salt as libsrtp expects them.
+// Returns nil if the direction is unused.
+func masterKey(p Profile, k Keys) ([]byte, error) {
+	if len(k.Key) == 0 && len(k.Salt) == 0 {
+		return nil, nil
+	}
+	if len(k.Key) != p.KeyLen() || len(k.Salt) != p.SaltLen() {
+		return nil, ErrInvalidKey
+	}
+	out := make([]byte, 0, len(k.Key)+len(k.Salt))
+	out = append(out, k.Key...)
+	return append(out, k.Salt...), nil
+}
+
+// ProtectRTP encrypts RTP packets in place.
+//
+// Each packets[i] must have at least MaxTrailerLen bytes of spare capacity;
+// on return it is resliced to the protected length. Every packet is
+// processed; packets that fail are set to nil and an error is returned.
+func (c *Context) ProtectRTP(packets [][]byte) error {
+	return c.run(packets, ffi.SRTPProtectRTP)
+}
+
+// ProtectRTCP encrypts RTCP packets in place. See ProtectRTP.
+func (c *Context) ProtectRTCP(packets [][]byte) error {
+	return c.run(packets, ffi.SRTPProtectRTCP)
+}
+
+// UnprotectRTP authenticates and decrypts SRTP packets in place.
+//
+// On return each packets[i] is resliced to the plaintext length. Packets
+// that fail authentication or replay checks are set to nil and an error is
+// returned after the whole batch has been processed.
+func (c *Context) UnprotectRTP(packets [][]byte) error {
+	return c.run(packets, func(ctx uintptr, p []uintptr, s, _ []int32) (int, error) {
+		return ffi.SRTPUnprotectRTP(ctx, p, s)
+	})
+}
+
+// UnprotectRTCP authenticates and decrypts SRTCP packets in place.
+// See UnprotectRTP.
+func (c *Context) UnprotectRTCP(packets [][]byte) error {
+	return c.run(packets, func(ctx uintptr, p []uintptr, s, _ []int32) (int, error) {
+		return ffi.SRTPUnprotectRTCP(ctx, p, s)
+	})
+}
+
+type batchFunc func(ctx uintptr, packets []uintptr, sizes, capacities []int32) (int, error)
+
+func (c *Context) run(packets [][]byte, fn batchFunc) error {
+	if c.closed.Load() {
+		return ErrContextClosed
+	}
+	if len(packets) == 0 {
+		return nil
+	}
+
+	n := len(packets)
+	if cap(c.ptrs) < n {
+		c.ptrs = make([]uintptr, n)
+		c.sizes = make([]int32, n)
+		c.caps = make([]int32, n)
+	}
+	ptrs, sizes, caps := c.ptrs[:n], c.sizes[:n], c.caps[:n]
+	for i, p := range packets {
+		sizes[i] = int32(len(p))
+		caps[i] = int32(cap(p))
+		if cap(p) > 0 {
+			ptrs[i] = uintptr(unsafe.Pointer(unsafe.SliceData(p)))
+		} else {
+			ptrs[i] = 0
+		}
+	}
+
+	_, err := fn(c.handle, ptrs, sizes, caps)
+
+	for i := range packets {
+		if sizes[i] < 0 {
+			packets[i] = nil
+		} else {
+			packets[i] = packets[i][:sizes[i]]
+		}
+		ptrs[i] = 0
+	}
+	return err
+}
+
+// Close releases the context. Further calls return ErrContextClosed.
+func (c *Context) Close() error {
+	if c.closed.Swap(true) {
+		return nil
+	}
+	ffi.SRTPContextDestroy(c.handle)
+	c.handle = 0
+	return nil
+}
@@ -0,0 +1,213 @@
+package srtp
+
+import (
+	"bytes"
+	"errors"
+	"os"
+	"testing"
+
+	"github.com/thesyncim/libgowebrtc/internal/ffi"
+)
+
+func TestMain(m *testing.M) {
+	if err := ffi.LoadLibrary(); err != nil {
+		os.Exit(0) // Skip all tests if shim unavailable
+	}
+	os.Exit(m.Run())
+}
+
+var profiles = []struct {
+	name    string
+	profile Profile
+}{
+	{"AES128_CM_SHA1_80", ProfileAES128CMHMACSHA1_80},
+	{"AES128_CM_SHA1_32", ProfileAES128CMHMACSHA1_32},
+	{"AEAD_AES_128_GCM", ProfileAEADAES128GCM},
+	{"AEAD_AES_256_GCM", ProfileAEADAES256GCM},
+}
+
+func testKeys(p Profile, seed byte) Keys {
+	k := Keys{Key: make([]byte, p.KeyLen()), Salt: make([]byte, p.SaltLen())}
+	for i := range k.Key {
+		k.Key[i] = seed + byte(i)
+	}
+	for i := range k.Salt {
+		k.Salt[i] = seed ^ byte(i*7)
+	}
+	return k
+}
+
+// newPair returns a sender and receiver context sharing keys.
+func newPair(t *testing.T, p Profile) (*Context, *Context) {
+	t.Helper()
+	keys := testKeys(p, 1)
+	tx, err := NewContext(Config{Profile: p, Local: keys})
+	if err != nil {
+		t.Fatalf("NewContext(send): %v", err)
+	}
+	rx, err := NewContext(Config{Profile: p, Remote: keys})
+	if err != nil {
+		tx.Close()
+		t.Fatalf("NewContext(recv): %v", err)
+	}
+	t.Cleanup(func() {
+		tx.Close()
+		rx.Close()
+	})
+	return tx, rx
+}
+
+func rtpPacket(seq uint16, payloadLen int) []byte {
+	buf := make([]byte, 12+payloadLen, 12+payloadLen+MaxTrailerLen)
+	buf[0] = 0x80
+	buf[1] = 96
+	buf[2] = byte(seq >> 8)
+	buf[3] = byte(seq)
+	buf[4], buf[5], buf[6], buf[7] = 0, 0, byte(seq>>8), byte(seq)
+	buf[8], buf[9], buf[10], buf[11] = 0xCA, 0xFE, 0xBA, 0xBE
+	for i := 12; i < len(buf); i++ {
+		buf[i] = byte(i + int(seq))
+	}
+	return buf
+}
+
+// rtcpReceiverReport builds an empty RTCP RR.
+func rtcpReceiverReport() []byte {
+	buf := make([]byte, 8, 8+MaxTrailerLen)
+	copy(buf, []byte{0x80, 201, 0x00, 0x01, 0xCA, 0xFE, 0xBA, 0xBE})
+	return buf
+}
+
+func TestRTPRoundTrip(t *testing.T) {
+	for _, tc := range profiles {
+		t.Run(tc.name, func(t *testing.T) {
+			tx, rx := newPair(t, tc.profile)
+
+			const n = 16
+			packets := make([][]byte, n)
+			want := make([][]byte, n)
+			for i := range packets {
+				packets[i] = rtpPacket(uint16(i+1), 100+i*50)
+				want[i] = append([]byte(nil), packets[i]...)
+			}
+
+			if err := tx.ProtectRTP(packets); err != nil {
+				t.Fatalf("ProtectRTP: %v", err)
+			}
+			for i, p := range packets {
+				if len(p) <= len(want[i]) {
+					t.Fatalf("packet %d: protected len %d not larger than %d", i, len(p), len(want[i]))
+				}
+				if bytes.Equal(p[12:len(want[i])], want[i][12:]) {
+					t.Fatalf("packet %d: payload not encrypted", i)
+				}
+			}
+
+			if err := rx.UnprotectRTP(packets); err != nil {
+				t.Fatalf("UnprotectRTP: %v", err)
+			}
+			for i, p := range packets {
+				if !bytes.Equal(p, want[i]) {
+					t.Fatalf("packet %d: round trip mismatch", i)
+				}
+			}
+		})
+	}
+}
+
+func TestRTCPRoundTrip(t *testing.T) {
+	for _, tc := range profiles {
+		t.Run(tc.name, func(t *testing.T) {
+			tx, rx := newPair(t, tc.profile)
+
+			packets := [][]byte{rtcpReceiverReport(), rtcpReceiverReport()}
+			want := append([]byte(nil), packets[0]...)
+
+			if err := tx.ProtectRTCP(packets); err != nil {
+				t.Fatalf("ProtectRTCP: %v", err)
+			}
+			if err := rx.UnprotectRTCP(packets); err != nil {
+				t.Fatalf("UnprotectRTCP: %v", err)
+			}
+			for i, p := range packets {
+				if !bytes.Equal(p, want) {
+					t.Fatalf("packet %d: round trip mismatch", i)
+				}
+			}
+		})
+	}
+}
+
+func TestUnprotectRejectsTamperedAndReplayed(t *testing.T) {
+	tx, rx := newPair(t, ProfileAES128CMHMACSHA1_80)
+
+	packets := [][]byte{rtpPacket(1, 200), rtpPacket(2, 200), rtpPacket(3, 200)}
+	if err := tx.ProtectRTP(packets); err != nil {
+		t.Fatalf("ProtectRTP: %v", err)
+	}
+	replay := append([]byte(nil), packets[0]...)
+	packets[1][20] ^= 0xFF
+
+	err := rx.UnprotectRTP(packets)
+	if !errors.Is(err, ffi.ErrDecodeFailed) {
+		t.Fatalf("UnprotectRTP error = %v, want ErrDecodeFailed", err)
+	}
+	if packets[0] == nil || packets[2] == nil {
+		t.Fatal("valid packets should survive a failure elsewhere in the batch")
+	}
+	if packets[1] != nil {
+		t.Fatal("tampered packet should be nil")
+	}
+
+	replayed := [][]byte{replay}
+	if err := rx.UnprotectRTP(replayed); err == nil || replayed[0] != nil {
+		t.Fatal("replayed packet should be rejected")
+	}
+}
+
+func TestProtectRequiresCapacity(t *testing.T) {
+	tx, _ := newPair(t, ProfileAEADAES128GCM)
+
+	full := rtpPacket(1, 100)
+	packets := [][]byte{full[:len(full):len(full)], rtpPacket(2, 100)}
+	if err := tx.ProtectRTP(packets); err == nil {
+		t.Fatal("expected error for packet without trailer capacity")
+	}
+	if packets[0] != nil || packets[1] == nil {
+		t.Fatal("only the undersized packet should fail")
+	}
+}
+
+func TestDirectionWithoutKey(t *testing.T) {
+	tx, rx := newPair(t, ProfileAES128CMHMACSHA1_80)
+
+	if err := tx.UnprotectRTP([][]byte{rtpPacket(1, 10)}); err == nil {
+		t.Fatal("send-only context should reject UnprotectRTP")
+	}
+	if err := rx.ProtectRTP([][]byte{rtpPacket(1, 10)}); err == nil {
+		t.Fatal("receive-only context should reject ProtectRTP")
+	}
+}
+
+func TestNewContextInvalidKey(t *testing.T) {
+	keys := testKeys(ProfileAES128CMHMACSHA1_80, 1)
+	_, err := NewContext(Config{Profile: ProfileAEADAES256GCM, Local: keys})
+	if !errors.Is(err, ErrInvalidKey) {
+		t.Fatalf("NewContext error = %v, want ErrInvalidKey", err)
+	}
+	if _, err := NewContext(Config{Profile: ProfileAES128CMHMACSHA1_80}); err == nil {
+		t.Fatal("expected error for context without keys")
+	}
+}
+
+func TestClosedContext(t *testing.T) {
+	ctx, err := NewContext(Config{Profile: ProfileAES128CMHMACSHA1_80, Local: testKeys(ProfileAES128CMHMACSHA1_80, 1)})
+	if err != nil {
+		t.Fatalf("NewContext: %v", err)
+	}
+	ctx.Close()
+	ctx.Close()
+	if err := ctx.ProtectRTP([][]byte{rtpPacket(1, 10)}); !errors.Is(err, ErrContextClosed) {
+		t.Fatalf("ProtectRTP after Close = %v, want ErrContextClosed", err)
+	}
+}
@@ -500,8 +500,23 @@ func (t *VideoTrack) SetBWESource(source BandwidthEstimateSource) {
 	}
 }
 
+// OnBandwidthEstimate adapts the track to a pushed estimate immediately.
+// Use it with sources that report every change, such as
+// pc.PeerConnection.SetOnBandwidthEstimate, instead of waiting for the
+// 100ms poll of a BandwidthEstimateSource.
+func (t *VideoTrack) OnBandwidthEstimate(bwe *BandwidthEstimate) {
+	if bwe == nil || t.closed.Load() {
+		return
+	}
+	if !t.config.AutoBitrate && !t.config.AutoFramerate && !t.config.AutoResolution {
+		return
+	}
+	t.adapt(bwe)
+}
+
 // HandleRTCPFeedback handles RTCP feedback for browser-like behavior.
-// feedbackType: 0=PLI, 1=FIR, 2=NACK
+// feedbackType: 0=PLI, 1=FIR, 2=NACK, 3=REMB, 4=TWCC, the values of
+// pc.RTCPFeedbackType, so it can be passed to pc.RTPSender.SetOnRTCPFeedback.
 func (t *VideoTrack) HandleRTCPFeedback(feedbackType int, ssrc uint32) {
 	if !t.config.AutoKeyframe {
 		return
@@ -512,6 +527,7 @@ func (t *VideoTrack) HandleRTCPFeedback(feedbackType int, ssrc uint32) {
 		t.keyframePend.Store(true)
 	case 2: // NACK - handled by packetizer/transport layer
 		// No action needed here
+	case 3, 4: // REMB, TWCC - drive the bandwidth estimate, see OnBandwidthEstimate
 	}
 }
 
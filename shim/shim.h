@@ -79,6 +79,7 @@ typedef struct ShimAudioEncoder ShimAudioEncoder;
 typedef struct ShimAudioDecoder ShimAudioDecoder;
 typedef struct ShimPacketizer ShimPacketizer;
 typedef struct ShimDepacketizer ShimDepacketizer;
+typedef struct ShimSRTPContext ShimSRTPContext;
 
 /* ============================================================================
  * Video Encoder Configuration
@@ -374,6 +375,261 @@ SHIM_EXPORT int shim_depacketizer_pop(
 
 SHIM_EXPORT void shim_depacketizer_destroy(ShimDepacketizer* depacketizer);
 
+/* ============================================================================
+ * SRTP API (Allocation-Free)
+ *
+ * Bulk SRTP/SRTCP protection backed by libwebrtc's SrtpSession (libsrtp).
+ * Intended for media that is transported outside a PeerConnection (e.g. an
+ * SFU forwarding path) and needs keying material from an external DTLS stack.
+ *
+ * A context holds independent send and receive sessions and takes no locks:
+ * calls on different contexts may run concurrently, but each context must be
+ * driven from one thread at a time (or externally synchronized).
+ * ========================================================================== */
+
+/* SRTP protection profiles (values match the IANA DTLS-SRTP registry) */
+typedef enum {
+    SHIM_SRTP_AES128_CM_SHA1_80 = 1,
+    SHIM_SRTP_AES128_CM_SHA1_32 = 2,
+    SHIM_SRTP_AEAD_AES_128_GCM = 7,
+    SHIM_SRTP_AEAD_AES_256_GCM = 8,
+} ShimSRTPProfile;
+
+/*
+ * Maximum number of bytes protection can append to a packet
+ * (16-byte auth tag + 4-byte SRTCP index).
+ */
+#define SHIM_SRTP_MAX_TRAILER_LEN 20
+
+/*
+ * Keys are the concatenated master key and master salt for the profile
+ * (30 bytes for AES-CM, 28 for AES-128-GCM, 44 for AES-256-GCM).
+ * Either direction may be omitted (NULL key) for send-only or receive-only use.
+ */
+typedef struct {
+    int profile;                    /* ShimSRTPProfile */
+    const uint8_t* send_key;        /* Optional: local master key || salt */
+    int send_key_len;
+    const uint8_t* recv_key;        /* Optional: remote master key || salt */
+    int recv_key_len;
+    ShimErrorBuffer* error_out;     /* Optional: buffer for error message */
+} ShimSRTPContextCreateParams;
+
+SHIM_EXPORT ShimSRTPContext* shim_srtp_context_create(
+    ShimSRTPContextCreateParams* params
+);
+
+/*
+ * Protect or unprotect a batch of packets in place.
+ *
+ * Every packet in the batch is processed even if an earlier one fails.
+ * On return sizes[i] holds the new length of packet i, or -1 if that packet
+ * failed (auth failure, replay, or insufficient capacity).
+ *
+ * @param params Batch parameters (inputs + outputs)
+ * @return SHIM_OK if all packets succeeded, SHIM_ERROR_ENCODE_FAILED (protect)
+ *         or SHIM_ERROR_DECODE_FAILED (unprotect) if any packet failed
+ */
+/* Batch parameters. Caller-owned buffers; shim uses them only during the call. */
+typedef struct {
+    ShimSRTPContext* context;
+    uint8_t** packets;              /* Packet buffers, transformed in place */
+    int* sizes;                     /* In: packet lengths; Out: new lengths or -1 */
+    const int* capacities;          /* Protect only: usable bytes per buffer */
+    int count;
+    int out_failed;                 /* Number of packets that failed */
+    ShimErrorBuffer* error_out;     /* Optional: buffer for error message */
+} ShimSRTPBatchParams;
+
+SHIM_EXPORT int shim_srtp_protect_rtp(ShimSRTPBatchParams* params);
+SHIM_EXPORT int shim_srtp_protect_rtcp(ShimSRTPBatchParams* params);
+SHIM_EXPORT int shim_srtp_unprotect_rtp(ShimSRTPBatchParams* params);
+SHIM_EXPORT int shim_srtp_unprotect_rtcp(ShimSRTPBatchParams* params);
+SHIM_EXPORT void shim_srtp_context_destroy(ShimSRTPContext* context);
+
+/* ============================================================================
+ * PeerConnectionFactory API
+ *
+ * A factory owns the media engine: codec factories, audio device module and
+ * audio processing. Creating it once and sharing it across PeerConnections
+ * avoids rebuilding those components per connection. Each PeerConnection
+ * holds a reference to its factory, so a factory may be destroyed while
+ * connections created from it are still open.
+ * ========================================================================== */
+
+typedef struct ShimPeerConnectionFactory ShimPeerConnectionFactory;
+typedef struct ShimLoopbackNetwork ShimLoopbackNetwork;
+
+/* Video codec factory selection */
+typedef enum {
+    SHIM_VIDEO_CODEC_FACTORY_AUTO = 0,      /* Builtin unless LIBWEBRTC_PREFER_SOFTWARE_CODECS is set */
+    SHIM_VIDEO_CODEC_FACTORY_BUILTIN = 1,   /* Builtin factory (hardware codecs where available) */
+    SHIM_VIDEO_CODEC_FACTORY_SOFTWARE = 2,  /* libwebrtc internal software codecs only */
+} ShimVideoCodecFactoryType;
+
+/* PeerConnectionFactory configuration. Zero-initialized means defaults. */
+typedef struct {
+    int video_codec_factory;        /* ShimVideoCodecFactoryType */
+    int disable_audio_device;       /* Non-zero: dummy ADM, no audio hardware access */
+    int disable_audio_processing;   /* Non-zero: no AEC/NS/AGC audio processing module */
+
+    /*
+     * UDP mux (POSIX only). When udp_mux_port is non-zero, every PeerConnection
+     * created from the factory shares one UDP socket per local IP bound to that
+     * port instead of opening its own, so the socket count stays constant as
+     * connections scale. Thread-group shard i binds udp_mux_port + i.
+     * Packets are demultiplexed by remote address and ICE username fragment;
+     * TURN relays are not demultiplexed and should not be used with the mux.
+     */
+    int udp_mux_port;
+    const char* udp_mux_address;    /* Optional: only gather host candidates on this local IP */
+
+    /* Optional: connect PeerConnections over this in-process network instead of UDP */
+    ShimLoopbackNetwork* loopback_network;
+
+    /*
+     * Receive-only video. Non-zero: incoming video is never decoded; remote
+     * video tracks deliver no decoded frames and only encoded frame sinks
+     * (shim_rtp_receiver_set_on_encoded_frame) see the streams. Sending is
+     * unaffected.
+     */
+    int disable_video_decoding;
+} ShimPeerConnectionFactoryConfig;
+
+typedef struct {
+    const ShimPeerConnectionFactoryConfig* config;  /* Optional: NULL for defaults */
+    ShimErrorBuffer* error_out;  /* Optional: buffer for error message */
+} ShimPeerConnectionFactoryCreateParams;
+
+SHIM_EXPORT ShimPeerConnectionFactory* shim_peer_connection_factory_create(
+    ShimPeerConnectionFactoryCreateParams* params
+);
+SHIM_EXPORT void shim_peer_connection_factory_destroy(ShimPeerConnectionFactory* factory);
+
+/* ============================================================================
+ * Socket Server API
+ *
+ * Network threads use libwebrtc's PhysicalSocketServer by default, which makes
+ * one syscall per UDP packet. The batched socket server (Linux only) reads
+ * with recvmmsg and UDP GRO, and queues sends until the network thread goes
+ * idle or 64 packets are pending, then flushes them with one sendmmsg,
+ * coalescing equal-sized packets to one destination with UDP GSO.
+ *
+ * The process-wide choice applies to the global network thread and to thread
+ * groups created with SHIM_SOCKET_SERVER_DEFAULT. It is read once, when the
+ * first PeerConnection, factory or thread group is created; setting
+ * LIBWEBRTC_BATCHED_UDP=1 selects the batched server when nothing was set
+ * (on Linux; elsewhere it is ignored).
+ * ========================================================================== */
+
+typedef enum {
+    SHIM_SOCKET_SERVER_DEFAULT = 0,     /* Process-wide selection */
+    SHIM_SOCKET_SERVER_PHYSICAL = 1,    /* libwebrtc PhysicalSocketServer */
+    SHIM_SOCKET_SERVER_BATCHED = 2,     /* recvmmsg/sendmmsg with GRO/GSO (Linux) */
+} ShimSocketServerType;
+
+typedef struct {
+    int type;                       /* ShimSocketServerType */
+    ShimErrorBuffer* error_out;     /* Optional: buffer for error message */
+} ShimSetSocketServerParams;
+
+/*
+ * Select the process-wide socket server. Fails once the global network
+ * thread exists.
+ */
+SHIM_EXPORT int shim_set_socket_server(ShimSetSocketServerParams* params);
+
+/* Cumulative counters for all batched socket servers in the process */
+typedef struct {
+    uint64_t recv_calls;            /* recvmmsg calls, including empty reads */
+    uint64_t recv_packets;          /* Packets received (GRO segments counted separately) */
+    uint64_t send_calls;            /* sendmmsg calls */
+    uint64_t send_packets;          /* Packets flushed */
+    uint64_t gso_sends;             /* Messages carrying more than one GSO segment */
+    uint64_t send_drops;            /* Packets the kernel refused (e.g. full send buffer) */
+} ShimSocketServerStats;
+
+SHIM_EXPORT void shim_socket_server_get_stats(ShimSocketServerStats* out);
+
+/* ============================================================================
+ * Loopback Network API
+ *
+ * An in-process packet network for PeerConnections in the same process.
+ * Factories configured with a loopback network give each PeerConnection its
+ * own virtual IPv4 address in 10.0.0.0/8 and UDP sockets that exist only in
+ * memory, so connections between them never touch the kernel. Every host has
+ * an uplink with the configured delay, random loss and bandwidth.
+ *
+ * Only UDP host candidates are gathered; STUN, TURN and TCP are disabled, and
+ * PeerConnections on a loopback network cannot reach ones outside it.
+ * ========================================================================== */
+
+typedef struct {
+    int delay_ms;                   /* One-way delay added to every packet */
+    double loss_rate;               /* Probability in [0, 1) that a packet is lost */
+    int bandwidth_kbps;             /* Uplink rate per PeerConnection; 0 = unlimited */
+    int queue_ms;                   /* Drop packets queued longer than this; 0 = unbounded */
+    uint32_t seed;                  /* Seed for the loss generator, for repeatable runs */
+    ShimErrorBuffer* error_out;     /* Optional: buffer for error message */
+} ShimLoopbackNetworkCreateParams;
+
+typedef struct {
+    uint64_t packets_sent;          /* Packets handed to the network */
+    uint64_t packets_delivered;     /* Packets received by a socket */
+    uint64_t bytes_delivered;
+    uint64_t packets_lost;          /* Dropped by loss_rate */
+    uint64_t packets_dropped;       /* Dropped by the queue limit or with no socket at the destination */
+} ShimLoopbackNetworkStats;
+
+SHIM_EXPORT ShimLoopbackNetwork* shim_loopback_network_create(ShimLoopbackNetworkCreateParams* params);
+
+/*
+ * Release the handle. Factories created with the network keep it alive, so
+ * their PeerConnections stay connected.
+ */
+SHIM_EXPORT void shim_loopback_network_destroy(ShimLoopbackNetwork* network);
+
+SHIM_EXPORT void shim_loopback_network_get_stats(ShimLoopbackNetwork* network,
+                                                 ShimLoopbackNetworkStats* out);
+
+/* ============================================================================
+ * Thread Group API
+ *
+ * By default every PeerConnection shares one signaling, one worker and one
+ * network thread. A thread group creates N shards, each with its own thread
+ * triplet and its own PeerConnectionFactory, so independent connections can
+ * run on different cores. Pass a shard's factory to shim_peer_connection_create.
+ *
+ * Factory handles returned by a group are borrowed and remain valid until the
+ * group is destroyed. PeerConnections keep their shard's threads alive, so a
+ * group may be destroyed while connections created from it are still open.
+ * ========================================================================== */
+
+typedef struct ShimThreadGroup ShimThreadGroup;
+
+typedef struct {
+    int shard_count;                /* Number of thread triplets; 0 = one per CPU core */
+    const ShimPeerConnectionFactoryConfig* factory_config;  /* Optional: NULL for defaults */
+    int pin_threads;                /* Non-zero: pin each shard's threads to one CPU (Linux only) */
+    const int* cpu_ids;             /* Optional: shard i uses cpu_ids[i % cpu_id_count] */
+    int cpu_id_count;
+    int socket_server;              /* ShimSocketServerType for the shards' network threads */
+    ShimErrorBuffer* error_out;     /* Optional: buffer for error message */
+} ShimThreadGroupCreateParams;
+
+SHIM_EXPORT ShimThreadGroup* shim_thread_group_create(
+    ShimThreadGroupCreateParams* params
+);
+SHIM_EXPORT int shim_thread_group_shard_count(ShimThreadGroup* group);
+
+/* Factory of the next shard in round-robin order (borrowed). */
+SHIM_EXPORT ShimPeerConnectionFactory* shim_thread_group_next_factory(ShimThreadGroup* group);
+
+/* Factory of a specific shard (borrowed), or NULL if shard is out of range. */
+SHIM_EXPORT ShimPeerConnectionFactory* shim_thread_group_factory(ShimThreadGroup* group, int shard);
+
+SHIM_EXPORT void shim_thread_group_destroy(ShimThreadGroup* group);
+
 /* ============================================================================
  * PeerConnection API
  * ========================================================================== */
@@ -391,6 +647,10 @@ typedef struct {
     const char* credential;     /* Optional TURN credential */
 } ShimICEServer;
 
+/* Congestion controllers (ShimPeerConnectionConfig.network_controller) */
+#define SHIM_NETWORK_CONTROLLER_GOOG_CC 0   /* libwebrtc's GoogCC, optionally tuned */
+#define SHIM_NETWORK_CONTROLLER_FIXED 1     /* Constant rate, ignores feedback; trusted links only */
+
 /* PeerConnection configuration */
 typedef struct {
     ShimICEServer* ice_servers;
@@ -399,6 +659,23 @@ typedef struct {
     const char* bundle_policy;      /* "balanced", "max-compat", "max-bundle" */
     const char* rtcp_mux_policy;    /* "require", "negotiate" */
     const char* sdp_semantics;      /* "unified-plan", "plan-b" */
+
+    /* Server-oriented options; NULL or 0 keeps libwebrtc's default */
+    const char* ice_transport_policy;       /* "all", "relay", "nohost" */
+    const char* candidate_network_policy;   /* "all", "low-cost" */
+    const char* tcp_candidate_policy;       /* "enabled", "disabled" */
+    int port_range_min;                     /* Local port range for candidates; both 0 = any */
+    int port_range_max;
+    int continual_gathering;                /* 1 = keep gathering as networks change */
+    int ice_check_interval_ms;              /* STUN check interval once connectivity is strong */
+    int ice_check_min_interval_ms;          /* Minimum interval between checks on one pair */
+
+    /* Congestion control; 0 keeps GoogCC with libwebrtc's defaults */
+    int network_controller;                 /* SHIM_NETWORK_CONTROLLER_* */
+    int start_bitrate_bps;                  /* GoogCC: initial estimate; fixed: the rate (required) */
+    int min_bitrate_bps;                    /* Floor of the target rate */
+    int max_bitrate_bps;                    /* Ceiling of the target rate */
+    int disable_probing;                    /* GoogCC: 1 = never send bandwidth probes */
 } ShimPeerConnectionConfig;
 
 /* Session Description */
@@ -426,6 +703,7 @@ typedef void (*ShimOnDataChannel)(void* ctx, void* channel);
 /* Create/Destroy PeerConnection */
 typedef struct {
     const ShimPeerConnectionConfig* config;
+    ShimPeerConnectionFactory* factory;  /* Optional: shared factory; NULL creates a private one */
     ShimErrorBuffer* error_out;  /* Optional: buffer for error message */
 } ShimPeerConnectionCreateParams;
 
@@ -434,6 +712,51 @@ SHIM_EXPORT ShimPeerConnection* shim_peer_connection_create(
 );
 SHIM_EXPORT void shim_peer_connection_destroy(ShimPeerConnection* pc);
 
+/*
+ * PeerConnection pool. Keeps target_size connections created ahead of time
+ * on a background thread, each with the template transceivers added and,
+ * through ice_candidate_pool_size, its host candidates already gathered, so
+ * acquiring one skips factory, PeerConnection and gathering latency. The
+ * pool refills after every acquire.
+ *
+ * Pooled connections have no callbacks until the caller sets them, so the
+ * negotiation-needed event for the template transceivers is not delivered;
+ * create the offer right after acquiring.
+ */
+typedef struct ShimPeerConnectionPool ShimPeerConnectionPool;
+
+typedef struct {
+    const ShimPeerConnectionConfig* config;  /* Template; ice_candidate_pool_size is raised to at least 1 */
+    ShimPeerConnectionFactory* factory;      /* Optional: NULL builds one factory for the pool */
+    int target_size;                /* Idle connections kept ready (> 0) */
+    int audio_transceivers;         /* Audio transceivers added to each connection */
+    int video_transceivers;         /* Video transceivers added to each connection */
+    int transceiver_direction;      /* ShimTransceiverDirection of the template transceivers */
+    ShimErrorBuffer* error_out;     /* Optional: buffer for error message */
+} ShimPeerConnectionPoolCreateParams;
+
+SHIM_EXPORT ShimPeerConnectionPool* shim_peer_connection_pool_create(
+    ShimPeerConnectionPoolCreateParams* params
+);
+
+typedef struct {
+    ShimPeerConnectionPool* pool;
+    int out_pooled;                 /* Non-zero if the connection came ready from the pool */
+    ShimErrorBuffer* error_out;     /* Optional: buffer for error message */
+} ShimPeerConnectionAcquireParams;
+
+/*
+ * Take a ready connection, or create one inline when the pool is empty.
+ * The caller owns it and releases it with shim_peer_connection_destroy.
+ */
+SHIM_EXPORT ShimPeerConnection* shim_peer_connection_acquire(ShimPeerConnectionAcquireParams* params);
+
+/* Number of connections ready to acquire. */
+SHIM_EXPORT int shim_peer_connection_pool_ready(ShimPeerConnectionPool* pool);
+
+/* Stop refilling and destroy the idle connections. Acquired ones are unaffected. */
+SHIM_EXPORT void shim_peer_connection_pool_destroy(ShimPeerConnectionPool* pool);
+
 /* Set callbacks */
 typedef struct {
     ShimPeerConnection* pc;
@@ -521,6 +844,8 @@ SHIM_EXPORT void shim_peer_connection_set_on_negotiation_needed(
 /* Create offer/answer */
 typedef struct {
     ShimPeerConnection* pc;
+    int ice_restart;            /* Non-zero: gather new ICE credentials */
+    int voice_activity_detection; /* Non-zero: offer comfort noise (libwebrtc default) */
     char* sdp_out;              /* Caller-provided buffer for SDP */
     int sdp_out_size;
     int out_sdp_len;
@@ -533,6 +858,7 @@ SHIM_EXPORT int shim_peer_connection_create_offer(
 
 typedef struct {
     ShimPeerConnection* pc;
+    int voice_activity_detection; /* As for create_offer */
     char* sdp_out;
     int sdp_out_size;
     int out_sdp_len;
@@ -566,6 +892,77 @@ SHIM_EXPORT int shim_peer_connection_set_remote_description(
     ShimPeerConnectionSetRemoteDescriptionParams* params
 );
 
+/*
+ * Asynchronous offer/answer and description APIs.
+ *
+ * These post the operation to the signaling thread and return without waiting
+ * for it, even when the signaling thread is busy; completion is reported
+ * through the callback, which runs on the signaling thread.
+ * A non-zero return means the operation was rejected up front and the callback
+ * will not be invoked.
+ *
+ * On success of create_offer/create_answer, sdp is a NUL-terminated buffer
+ * owned by the caller; release it with shim_free_buffer (it may be kept past
+ * the callback). For set_*_description sdp is NULL. On failure, result is a
+ * SHIM_ERROR_* code and error is valid only for the duration of the callback.
+ *
+ * The callback must not call the blocking variants above on the same
+ * PeerConnection, since they wait on the signaling thread it is running on.
+ */
+typedef void (*ShimOnSessionDescriptionComplete)(
+    void* ctx, int result, char* sdp, int sdp_len, const char* error);
+
+typedef struct {
+    ShimPeerConnection* pc;
+    int ice_restart;            /* As for create_offer */
+    int voice_activity_detection;
+    ShimOnSessionDescriptionComplete callback;
+    void* ctx;
+    ShimErrorBuffer* error_out; /* Optional: buffer for error message */
+} ShimPeerConnectionCreateOfferAsyncParams;
+
+SHIM_EXPORT int shim_peer_connection_create_offer_async(
+    ShimPeerConnectionCreateOfferAsyncParams* params
+);
+
+typedef struct {
+    ShimPeerConnection* pc;
+    int voice_activity_detection; /* As for create_offer */
+    ShimOnSessionDescriptionComplete callback;
+    void* ctx;
+    ShimErrorBuffer* error_out; /* Optional: buffer for error message */
+} ShimPeerConnectionCreateAnswerAsyncParams;
+
+SHIM_EXPORT int shim_peer_connection_create_answer_async(
+    ShimPeerConnectionCreateAnswerAsyncParams* params
+);
+
+typedef struct {
+    ShimPeerConnection* pc;
+    int type;                   /* SDP type */
+    const char* sdp;            /* Copied before returning */
+    ShimOnSessionDescriptionComplete callback;
+    void* ctx;
+    ShimErrorBuffer* error_out; /* Optional: buffer for error message */
+} ShimPeerConnectionSetLocalDescriptionAsyncParams;
+
+SHIM_EXPORT int shim_peer_connection_set_local_description_async(
+    ShimPeerConnectionSetLocalDescriptionAsyncParams* params
+);
+
+typedef struct {
+    ShimPeerConnection* pc;
+    int type;
+    const char* sdp;            /* Copied before returning */
+    ShimOnSessionDescriptionComplete callback;
+    void* ctx;
+    ShimErrorBuffer* error_out; /* Optional: buffer for error message */
+} ShimPeerConnectionSetRemoteDescriptionAsyncParams;
+
+SHIM_EXPORT int shim_peer_connection_set_remote_description_async(
+    ShimPeerConnectionSetRemoteDescriptionAsyncParams* params
+);
+
 /* Add ICE candidate */
 typedef struct {
     ShimPeerConnection* pc;
@@ -1074,14 +1471,14 @@ SHIM_EXPORT int shim_transceiver_get_codec_preferences(
  * Bandwidth Estimation API
  * ========================================================================== */
 
-/* Bandwidth estimation info */
+/* Bandwidth estimation info, from the PeerConnection's congestion controller */
 typedef struct {
     int64_t timestamp_us;
     int64_t target_bitrate_bps;      /* Target bitrate from BWE */
     int64_t available_send_bps;       /* Available send bandwidth */
-    int64_t available_recv_bps;       /* Available receive bandwidth */
+    int64_t available_recv_bps;       /* Not known to the send-side controller; always 0 */
     int64_t pacing_rate_bps;          /* Current pacing rate */
-    int congestion_window;            /* Congestion window size */
+    int congestion_window;            /* Congestion window in bytes; 0 = unlimited */
     double loss_rate;                 /* Observed packet loss rate (0.0-1.0) */
 } ShimBandwidthEstimate;
 
@@ -1091,6 +1488,9 @@ typedef void (*ShimOnBandwidthEstimate)(void* ctx, const ShimBandwidthEstimate*
 /*
  * Set bandwidth estimate callback.
  *
+ * Called on the transport task queue whenever the congestion controller
+ * changes its target rate, pacing rate or congestion window.
+ *
  * @param params Input parameters (pc + callback + ctx)
  */
 typedef struct {
@@ -1104,7 +1504,7 @@ SHIM_EXPORT void shim_peer_connection_set_on_bandwidth_estimate(
 );
 
 /*
- * Get current bandwidth estimate.
+ * Get the last bandwidth estimate (all zero until the transport is up).
  *
  * @param params Output parameters (pc + estimate)
  * @return SHIM_OK on success
@@ -1136,13 +1536,15 @@ SHIM_EXPORT int shim_peer_connection_get_stats(
 );
 
 /*
- * Get statistics for a specific sender.
+ * Get statistics for a specific sender. Only the sender's streams are
+ * collected (selector-based GetStats).
  *
- * @param params Output parameters (sender + stats)
+ * @param params Output parameters (pc + sender + stats)
  * @return SHIM_OK on success
  */
 /* Stats parameters. Caller-owned buffers; shim uses them only during the call. */
 typedef struct {
+    ShimPeerConnection* pc;         /* PeerConnection that owns the sender */
     ShimRTPSender* sender;
     ShimRTCStats out_stats;
 } ShimRTPSenderGetStatsParams;
@@ -1152,13 +1554,15 @@ SHIM_EXPORT int shim_rtp_sender_get_stats(
 );
 
 /*
- * Get statistics for a specific receiver.
+ * Get statistics for a specific receiver. Only the receiver's streams are
+ * collected (selector-based GetStats).
  *
- * @param params Output parameters (receiver + stats)
+ * @param params Output parameters (pc + receiver + stats)
  * @return SHIM_OK on success
  */
 /* Stats parameters. Caller-owned buffers; shim uses them only during the call. */
 typedef struct {
+    ShimPeerConnection* pc;         /* PeerConnection that owns the receiver */
     ShimRTPReceiver* receiver;
     ShimRTCStats out_stats;
 } ShimRTPReceiverGetStatsParams;
@@ -1167,41 +1571,254 @@ SHIM_EXPORT int shim_rtp_receiver_get_stats(
     ShimRTPReceiverGetStatsParams* params
 );
 
+/* Stream stats direction */
+#define SHIM_STREAM_OUTBOUND 0
+#define SHIM_STREAM_INBOUND  1
+
+/* Stream stats flags */
+#define SHIM_STATS_FLAG_DELTA 1  /* Fill the interval fields and remember counters */
+
+/*
+ * Statistics for one RTP stream (one SSRC). Counters are cumulative; the
+ * interval fields are only filled in delta mode.
+ */
+typedef struct {
+    uint32_t ssrc;
+    int direction;                  /* SHIM_STREAM_OUTBOUND or SHIM_STREAM_INBOUND */
+    int kind;                       /* 0=audio, 1=video */
+    int quality_limitation_reason;  /* Outbound video only */
+    char mid[64];                   /* MID of the owning transceiver */
+    char rid[64];                   /* Simulcast RID (outbound only) */
+    int64_t timestamp_us;
+
+    int64_t bytes;                  /* Payload bytes sent or received */
+    int64_t packets;                /* Packets sent or received */
+    int64_t packets_lost;           /* Inbound: local count; outbound: reported by the remote */
+    int64_t retransmitted_bytes;    /* Outbound only */
+    int64_t jitter_buffer_emitted_count;
+    int64_t qp_sum;
+
+    double jitter_ms;               /* Inbound: local; outbound: reported by the remote */
+    double round_trip_time_ms;      /* Outbound only, from RTCP receiver reports */
+    double fraction_lost;           /* Outbound only, from the last receiver report */
+    double target_bitrate_bps;      /* Outbound only */
+    double frames_per_second;
+    double jitter_buffer_delay_ms;  /* Inbound: mean delay per emitted sample or frame */
+    double audio_level;             /* Inbound audio only */
+
+    int frames;                     /* Frames encoded or decoded */
+    int key_frames;
+    int frames_dropped;             /* Inbound only */
+    int frame_width;
+    int frame_height;
+    int nack_count;
+    int pli_count;
+    int fir_count;
+
+    /* Delta mode: rates since the previous delta-mode call for this stream */
+    int64_t interval_us;            /* 0 on the first sample of a stream */
+    double bitrate_bps;
+    double packet_rate;
+    double interval_loss_rate;      /* Lost / (packets + lost) over the interval */
+} ShimStreamStats;
+
+/*
+ * Get per-stream statistics.
+ *
+ * With a sender or receiver selector only the streams of that sender or
+ * receiver are collected, which is much cheaper than a full report. Delta
+ * mode keeps the previous counters per PeerConnection, so a single poller
+ * per PeerConnection should use it.
+ *
+ * out_total is the number of streams in the report; when it exceeds
+ * max_streams only the first max_streams are written.
+ */
+typedef struct {
+    ShimPeerConnection* pc;
+    ShimRTPSender* sender;          /* Optional selector */
+    ShimRTPReceiver* receiver;      /* Optional selector, ignored if sender is set */
+    int flags;                      /* SHIM_STATS_FLAG_* */
+    ShimStreamStats* streams;       /* Caller-owned array */
+    int max_streams;
+    int out_count;
+    int out_total;
+    ShimErrorBuffer* error_out;     /* Optional: buffer for error message */
+} ShimPeerConnectionGetStreamStatsParams;
+
+SHIM_EXPORT int shim_peer_connection_get_stream_stats(
+    ShimPeerConnectionGetStreamStatsParams* params
+);
+
+/* ============================================================================
+ * Stats Ring API
+ *
+ * Push-based alternative to polling. PeerConnections subscribe to a ring with
+ * an interval; a shim thread requests their stats on the signaling thread
+ * without blocking and writes one fixed-layout record per RTP stream into a
+ * preallocated single-reader ring. The ring memory is owned by the shim and
+ * read directly by the consumer, without calls into the shim:
+ *
+ *   load write_seq (acquire), copy records [read_seq, write_seq) at
+ *   index seq & (capacity - 1), then store read_seq (release).
+ *
+ * Records that do not fit because the reader fell behind are dropped and
+ * counted in dropped. Unsubscribe a PeerConnection before destroying it.
+ * ========================================================================== */
+
+typedef struct ShimStatsRing ShimStatsRing;
+
+/* Shared ring header; records start records_offset bytes after it */
+typedef struct {
+    uint32_t capacity;              /* Records, a power of two */
+    uint32_t record_size;           /* sizeof(ShimStatsRecord) */
+    uint32_t records_offset;
+    uint32_t reserved;
+    uint64_t write_seq;             /* Records published, stored by the shim with release */
+    uint64_t read_seq;              /* Records consumed, stored by the reader with release */
+    uint64_t dropped;               /* Records dropped because the ring was full */
+} ShimStatsRingHeader;
+
+/*
+ * One RTP stream of one collection round. Interval fields of the stream are
+ * relative to the subscription's previous round.
+ */
+typedef struct {
+    uint64_t tag;                   /* Tag given when the PeerConnection subscribed */
+    int64_t round_us;               /* Shared by the records of one round */
+    int stream_index;
+    int stream_count;               /* 0: no RTP streams, only the transport fields are set */
+    double current_rtt_ms;          /* Selected ICE candidate pair */
+    double available_outgoing_bitrate;
+    double available_incoming_bitrate;
+    ShimStreamStats stream;
+} ShimStatsRecord;
+
+typedef struct {
+    int capacity;                   /* Records, rounded up to a power of two; 0 = 4096 */
+    ShimErrorBuffer* error_out;     /* Optional: buffer for error message */
+} ShimStatsRingCreateParams;
+
+SHIM_EXPORT ShimStatsRing* shim_stats_ring_create(
+    ShimStatsRingCreateParams* params
+);
+
+/* Returns the ring header; valid until shim_stats_ring_destroy */
+SHIM_EXPORT ShimStatsRingHeader* shim_stats_ring_header(ShimStatsRing* ring);
+
+/*
+ * Stops collection. The reader must stop reading the ring first.
+ */
+SHIM_EXPORT void shim_stats_ring_destroy(ShimStatsRing* ring);
+
+/* Subscribe a PeerConnection (replaces its interval and tag if already subscribed) */
+typedef struct {
+    ShimStatsRing* ring;
+    ShimPeerConnection* pc;
+    int interval_ms;
+    uint64_t tag;
+    ShimErrorBuffer* error_out;     /* Optional: buffer for error message */
+} ShimStatsRingSubscribeParams;
+
+SHIM_EXPORT int shim_stats_ring_subscribe(
+    ShimStatsRingSubscribeParams* params
+);
+
+typedef struct {
+    ShimStatsRing* ring;
+    ShimPeerConnection* pc;
+} ShimStatsRingUnsubscribeParams;
+
+SHIM_EXPORT void shim_stats_ring_unsubscribe(
+    ShimStatsRingUnsubscribeParams* params
+);
+
 /* ============================================================================
  * RTCP Feedback API
  * ========================================================================== */
 
 /*
- * Request a keyframe from the sender (send PLI).
+ * Request a keyframe from the sender of a video receiver (send PLI).
  *
  * @param receiver RTPReceiver handle
- * @return SHIM_OK on success
+ * @return SHIM_OK on success, SHIM_ERROR_INVALID_PARAM for audio receivers
  */
+SHIM_EXPORT int shim_rtp_receiver_request_key_frame(ShimRTPReceiver* receiver);
+
+/* RTCP feedback types */
+#define SHIM_RTCP_FEEDBACK_PLI 0
+#define SHIM_RTCP_FEEDBACK_FIR 1
+#define SHIM_RTCP_FEEDBACK_NACK 2
+#define SHIM_RTCP_FEEDBACK_REMB 3
+#define SHIM_RTCP_FEEDBACK_TWCC 4
 
 /*
- * Callback for RTCP feedback events.
+ * Feedback of one type.
  *
- * @param ctx User context
- * @param type Feedback type (0=PLI, 1=FIR, 2=NACK)
- * @param ssrc SSRC of the affected stream
+ * PLI, FIR and NACK are per media SSRC and reported to senders. REMB and
+ * TWCC apply to the whole transport, have ssrc 0 and are reported once per
+ * PeerConnection (see shim_peer_connection_set_on_transport_feedback).
+ */
+typedef struct {
+    int type;                   /* SHIM_RTCP_FEEDBACK_* */
+    uint32_t ssrc;
+    int count;                  /* Messages received; TWCC: packets reported on */
+    int lost;                   /* TWCC: packets reported lost */
+    int64_t bitrate_bps;        /* REMB: latest receiver estimate */
+    int64_t timestamp_us;
+} ShimRTCPFeedback;
+
+/*
+ * Callback for a batch of RTCP feedback. records is only valid during the
+ * call. Called on the PeerConnection's signaling thread.
  */
-typedef void (*ShimOnRTCPFeedback)(void* ctx, int type, uint32_t ssrc);
+typedef void (*ShimOnRTCPFeedback)(void* ctx, const ShimRTCPFeedback* records, int count);
 
 /*
- * Set RTCP feedback callback on a sender.
+ * Set RTCP feedback callback on a video sender of pc.
  *
- * @param params Input parameters (sender + callback + ctx)
+ * Keyframe requests are reported as they reach the sender's encoder, one
+ * SHIM_RTCP_FEEDBACK_PLI record per simulcast stream asking. The encoder
+ * cannot tell a FIR from a PLI, so FIRs are reported as PLI too. The
+ * keyframe every stream starts with is not reported. A request reaching
+ * one sender is reported to every sender of the same track source.
+ *
+ * NACK counts are read from the sender's stats and reported at most once
+ * per interval, and not at all for intervals without NACKs.
+ *
+ * A NULL callback stops reporting unless a queue is set (see
+ * shim_rtp_sender_set_rtcp_feedback_event_queue).
+ *
+ * @param params Input parameters (pc + sender + callback + ctx + interval)
  */
 typedef struct {
+    ShimPeerConnection* pc;
     ShimRTPSender* sender;
     ShimOnRTCPFeedback callback;
     void* ctx;
+    int interval_ms;            /* NACK interval; 0 = 1000 */
 } ShimRTPSenderSetOnRTCPFeedbackParams;
 
 SHIM_EXPORT void shim_rtp_sender_set_on_rtcp_feedback(
     ShimRTPSenderSetOnRTCPFeedbackParams* params
 );
 
+/*
+ * Set the callback for the REMB and TWCC feedback of pc.
+ *
+ * Feedback is batched: at most one call per interval, and none for
+ * intervals without feedback. A NULL callback stops reporting.
+ */
+typedef struct {
+    ShimPeerConnection* pc;
+    ShimOnRTCPFeedback callback;
+    void* ctx;
+    int interval_ms;            /* Batch interval; 0 = 100 */
+} ShimPeerConnectionSetOnTransportFeedbackParams;
+
+SHIM_EXPORT void shim_peer_connection_set_on_transport_feedback(
+    ShimPeerConnectionSetOnTransportFeedbackParams* params
+);
+
 /* ============================================================================
  * Simulcast/SVC Layer Control API
  * ========================================================================== */
@@ -1363,8 +1980,340 @@ SHIM_EXPORT ShimRTPSender* shim_peer_connection_add_video_track_from_source(
     ShimPeerConnectionAddVideoTrackFromSourceParams* params
 );
 
+/*
+ * Get buffer pool statistics of a video track source. Pushed frames are
+ * copied into buffers recycled once the encoder is done with them; a miss
+ * is a frame that needed a newly allocated buffer.
+ *
+ * @param source Track source handle
+ * @param pool_hits Frames copied into a recycled buffer (output)
+ * @param pool_misses Frames that needed a new buffer (output)
+ * @return SHIM_OK on success
+ */
+typedef struct {
+    ShimVideoTrackSource* source;
+    /* Outputs */
+    uint64_t pool_hits;
+    uint64_t pool_misses;
+} ShimVideoTrackSourceGetPoolStatsParams;
+
+SHIM_EXPORT int shim_video_track_source_get_pool_stats(
+    ShimVideoTrackSourceGetPoolStatsParams* params
+);
+
+/* ============================================================================
+ * Video Frame Ring API
+ *
+ * Zero-copy alternative to shim_video_track_source_push_frame. The shim maps
+ * a ring of I420 frame slots for a video track source, and a shim thread
+ * sends the published slots to the source's sinks. The single producer
+ * writes pixels straight into the next free slot and publishes it without
+ * calling into the shim:
+ *
+ *   load read_seq (acquire); the ring is full while write_seq - read_seq
+ *   equals slot_count. Otherwise fill slot write_seq & (slot_count - 1) and
+ *   its timestamp_us, then store write_seq + 1. If consumer_waiting is set,
+ *   swap it to 0 and write a uint64_t 1 to notify_fd (when not -1).
+ *
+ * The stores of write_seq and consumer_waiting must be sequentially
+ * consistent on both sides so a wake-up is never lost.
+ *
+ * A slot is handed to the encoder without copying when the frame is sent
+ * at full size, and comes back to the producer (read_seq passes it) once
+ * the encoder releases it. Slots the sinks scale down are copied out, and
+ * slots they drop are released right away.
+ *
+ * Slots start on a cache line; every plane starts on a cache line and has a
+ * stride that is a multiple of 64 bytes, so rows suit any SIMD width.
+ * ========================================================================== */
+
+typedef struct ShimVideoFrameRing ShimVideoFrameRing;
+
+/* Shared ring header; slots start slots_offset bytes after it */
+typedef struct {
+    uint32_t slot_count;            /* A power of two */
+    uint32_t slot_size;             /* Bytes, a multiple of 64 */
+    uint32_t slots_offset;
+    int32_t width;
+    int32_t height;
+    int32_t y_stride;
+    int32_t u_stride;
+    int32_t v_stride;
+    uint32_t y_offset;              /* Plane offsets within a slot */
+    uint32_t u_offset;
+    uint32_t v_offset;
+    int32_t notify_fd;              /* -1: the consumer polls */
+    uint32_t reserved0[4];
+    /* Written by the producer, on its own cache line */
+    uint64_t write_seq;             /* Slots published, stored by the producer */
+    uint64_t reserved1[7];
+    /* Written by the shim, on its own cache line */
+    uint64_t read_seq;              /* Slots released, stored by the shim with release */
+    uint32_t consumer_waiting;      /* Set while the consumer sleeps on notify_fd */
+    uint32_t reserved2;
+    uint64_t reserved3[6];
+} ShimVideoFrameRingHeader;
+
+/* Start of every slot, followed by the planes */
+typedef struct {
+    int64_t timestamp_us;           /* As in shim_video_track_source_push_frame */
+    int64_t reserved[7];
+} ShimVideoFrameSlotHeader;
+
+typedef struct {
+    ShimVideoTrackSource* source;
+    int slots;                      /* Rounded up to a power of two; 0 = 4, at most 64 */
+    ShimErrorBuffer* error_out;     /* Optional: buffer for error message */
+} ShimVideoFrameRingCreateParams;
+
+SHIM_EXPORT ShimVideoFrameRing* shim_video_frame_ring_create(
+    ShimVideoFrameRingCreateParams* params
+);
+
+/* Returns the ring header; valid until shim_video_frame_ring_destroy */
+SHIM_EXPORT ShimVideoFrameRingHeader* shim_video_frame_ring_header(ShimVideoFrameRing* ring);
+
+/*
+ * Stops the consumer thread. The producer must stop writing first. Slots
+ * still held by the encoder stay mapped until it releases them.
+ */
+SHIM_EXPORT void shim_video_frame_ring_destroy(ShimVideoFrameRing* ring);
+
 SHIM_EXPORT void shim_video_track_source_destroy(ShimVideoTrackSource* source);
 
+/* ============================================================================
+ * Encoded Video Source API (for pre-encoded frame injection)
+ * ========================================================================== */
+
+typedef struct ShimEncodedVideoSource ShimEncodedVideoSource;
+
+/*
+ * Keyframe cache: a source keeps its latest keyframe, with the H.264 SPS/PPS
+ * or AV1 sequence header last pushed in front of it if the keyframe lacks
+ * them. A sender that starts after that keyframe sends it right away instead
+ * of waiting for the next one, then holds that picture until the producer's
+ * next keyframe. It does not request one, so producers should push keyframes
+ * at a regular interval; PLI/FIR from the receiver still reach the producer.
+ * VP8 and VP9 keyframes carry everything needed to decode them.
+ *
+ * Keyframe requests reaching the producer are rate limited: requests within
+ * min_keyframe_interval_ms of the last forwarded request or pushed keyframe
+ * are merged into one, forwarded when the interval has passed unless a
+ * keyframe arrived first.
+ */
+
+/*
+ * Called when the stream needs a keyframe: a receiver sent PLI/FIR, a sender
+ * has no keyframe to start with, or a frame was lost on the way to the
+ * encoder. Repeated requests are coalesced
+ * until a keyframe is pushed. Called on a libwebrtc encoder thread, or from
+ * shim_encoded_video_source_push_frame for a request that was held back by
+ * the rate limit.
+ */
+typedef void (*ShimOnKeyFrameRequest)(void* ctx);
+
+/*
+ * Create a source of already encoded video. Its frames are sent without
+ * being decoded or re-encoded: libwebrtc only packetizes, paces and protects
+ * them. One source can be added to several PeerConnections.
+ *
+ * @param codec Codec of the bitstream (H264, VP8, VP9 or AV1)
+ * @param width Frame width
+ * @param height Frame height
+ * @param min_keyframe_interval_ms Keyframe request rate limit; 0 = 500 ms
+ * @return Source handle, or NULL on failure
+ */
+typedef struct {
+    ShimCodecType codec;
+    int width;
+    int height;
+    int min_keyframe_interval_ms;
+    ShimErrorBuffer* error_out;
+} ShimEncodedVideoSourceCreateParams;
+
+SHIM_EXPORT ShimEncodedVideoSource* shim_encoded_video_source_create(
+    ShimEncodedVideoSourceCreateParams* params
+);
+
+/*
+ * Set the keyframe request callback. A NULL callback removes it.
+ */
+typedef struct {
+    ShimEncodedVideoSource* source;
+    ShimOnKeyFrameRequest callback;
+    void* ctx;
+} ShimEncodedVideoSourceSetOnKeyFrameRequestParams;
+
+SHIM_EXPORT void shim_encoded_video_source_set_on_keyframe_request(
+    ShimEncodedVideoSourceSetOnKeyFrameRequestParams* params
+);
+
+/*
+ * Push one encoded frame. The data is copied. H.264 must be Annex B; SPS/PPS
+ * are only needed in front of the IDRs where they first appear or change, as
+ * the keyframe cache adds them for senders that start later. VP8, VP9 and AV1
+ * frames are sent as the encoder produced them. Delta frames are dropped until the first keyframe,
+ * and after a frame lost on the way to the encoder until the keyframe that
+ * the loss requests.
+ *
+ * @param data Encoded frame
+ * @param size Size of data in bytes
+ * @param width Frame width, or 0 for the source's
+ * @param height Frame height, or 0 for the source's
+ * @param is_keyframe Non-zero for keyframes
+ * @param temporal_id Temporal layer (0-7), or -1 for none
+ * @param timestamp_us Capture time in microseconds, or 0 for now. libwebrtc
+ *        drops a frame whose timestamp is not later than the previous one's.
+ * @return SHIM_OK on success
+ */
+typedef struct {
+    ShimEncodedVideoSource* source;
+    const uint8_t* data;
+    int size;
+    int width;
+    int height;
+    int is_keyframe;
+    int temporal_id;
+    int64_t timestamp_us;
+    ShimErrorBuffer* error_out;
+} ShimEncodedVideoSourcePushFrameParams;
+
+SHIM_EXPORT int shim_encoded_video_source_push_frame(
+    ShimEncodedVideoSourcePushFrameParams* params
+);
+
+/*
+ * Add a video track fed by an encoded source. The track's transceiver only
+ * offers the source's codec (plus RTX/RED/FEC), and its sender never scales
+ * or drops frames to adapt.
+ *
+ * @return RTPSender handle, or NULL on failure
+ */
+typedef struct {
+    ShimPeerConnection* pc;
+    ShimEncodedVideoSource* source;
+    const char* track_id;
+    const char* stream_id;
+    ShimErrorBuffer* error_out;  /* Optional: buffer for error message */
+} ShimPeerConnectionAddEncodedVideoTrackParams;
+
+SHIM_EXPORT ShimRTPSender* shim_peer_connection_add_encoded_video_track(
+    ShimPeerConnectionAddEncodedVideoTrackParams* params
+);
+
+/*
+ * Only forward frames up to a temporal layer (0-7; 7 forwards all, the
+ * default). Frames pushed with temporal_id -1 are always forwarded. Lowering
+ * the limit applies to the next frame; raising it waits for a keyframe,
+ * which is requested, so the receiver never gets frames whose references it
+ * did not receive.
+ */
+typedef struct {
+    ShimEncodedVideoSource* source;
+    int max_temporal_layer;
+} ShimEncodedVideoSourceSetMaxTemporalLayerParams;
+
+SHIM_EXPORT int shim_encoded_video_source_set_max_temporal_layer(
+    ShimEncodedVideoSourceSetMaxTemporalLayerParams* params
+);
+
+/*
+ * Destroy a source. Tracks added from it stay valid but receive no frames.
+ * Sources of a shared encoder are unsubscribed from it.
+ */
+SHIM_EXPORT void shim_encoded_video_source_destroy(ShimEncodedVideoSource* source);
+
+/* ============================================================================
+ * Shared Video Encoder API (encode once, send to many PeerConnections)
+ *
+ * A video track source added to N PeerConnections is encoded N times, once
+ * per sender. A shared encoder encodes each raw frame once and hands the
+ * result to every subscriber, an encoded video source added to a
+ * PeerConnection with shim_peer_connection_add_encoded_video_track.
+ *
+ * Keyframe requests from all subscribers are coalesced: any number of
+ * requests before the next frame produce a single keyframe, and they are
+ * rate limited as for encoded sources. Subscribers share the encoder's
+ * keyframe cache, so a late subscriber starts without a new keyframe being
+ * encoded for everyone.
+ *
+ * The encoder runs at the configured rates; subscribers' bandwidth estimates
+ * do not change them, so pick rates every receiver can sustain, or use
+ * temporal layers and give constrained subscribers a lower
+ * max_temporal_layer.
+ * ========================================================================== */
+
+typedef struct ShimSharedVideoEncoder ShimSharedVideoEncoder;
+
+typedef struct {
+    ShimCodecType codec;
+    int width;
+    int height;
+    int bitrate_bps;
+    int framerate;
+    int temporal_layers;            /* 1-3; 0 = 1 */
+    int min_keyframe_interval_ms;   /* 0 = 500 ms */
+    ShimErrorBuffer* error_out;
+} ShimSharedVideoEncoderCreateParams;
+
+SHIM_EXPORT ShimSharedVideoEncoder* shim_shared_video_encoder_create(
+    ShimSharedVideoEncoderCreateParams* params
+);
+
+/*
+ * Encode an I420 frame of the encoder's size and send it to all subscribers.
+ * The planes are copied.
+ */
+typedef struct {
+    ShimSharedVideoEncoder* encoder;
+    const uint8_t* y_plane;
+    const uint8_t* u_plane;
+    const uint8_t* v_plane;
+    int y_stride;
+    int u_stride;
+    int v_stride;
+    int64_t timestamp_us;
+    ShimErrorBuffer* error_out;
+} ShimSharedVideoEncoderPushFrameParams;
+
+SHIM_EXPORT int shim_shared_video_encoder_push_frame(
+    ShimSharedVideoEncoderPushFrameParams* params
+);
+
+typedef struct {
+    ShimSharedVideoEncoder* encoder;
+    int bitrate_bps;
+    int framerate;
+} ShimSharedVideoEncoderSetRatesParams;
+
+SHIM_EXPORT int shim_shared_video_encoder_set_rates(
+    ShimSharedVideoEncoderSetRatesParams* params
+);
+
+/*
+ * Create an encoded video source fed by the encoder. Add it to a
+ * PeerConnection with shim_peer_connection_add_encoded_video_track and
+ * destroy it with shim_encoded_video_source_destroy; frames cannot be pushed
+ * to it directly.
+ *
+ * @param max_temporal_layer See shim_encoded_video_source_set_max_temporal_layer
+ * @return Source handle, or NULL on failure
+ */
+typedef struct {
+    ShimSharedVideoEncoder* encoder;
+    int max_temporal_layer;
+    ShimErrorBuffer* error_out;
+} ShimSharedVideoEncoderSubscribeParams;
+
+SHIM_EXPORT ShimEncodedVideoSource* shim_shared_video_encoder_subscribe(
+    ShimSharedVideoEncoderSubscribeParams* params
+);
+
+/*
+ * Destroy the encoder. Its subscribers stay valid but receive no frames.
+ */
+SHIM_EXPORT void shim_shared_video_encoder_destroy(ShimSharedVideoEncoder* encoder);
+
 /* ============================================================================
  * Audio Track Source API (for frame injection)
  * ========================================================================== */
@@ -1473,7 +2422,11 @@ typedef void (*ShimOnVideoFrame)(
  * @param num_samples Number of samples per channel
  * @param sample_rate Sample rate
  * @param channels Number of channels
- * @param timestamp_us Timestamp in microseconds
+ * @param timestamp_us Arrival time of the first sample in the TimeMicros clock
+ * @param capture_time_us Capture time of the first sample on the sender's
+ *        NTP clock, with millisecond precision; valid if has_capture_time
+ * @param has_capture_time Non-zero if the sender provides the capture time
+ *        (abs-capture-time header extension)
  */
 typedef void (*ShimOnAudioFrame)(
     void* ctx,
@@ -1481,7 +2434,9 @@ typedef void (*ShimOnAudioFrame)(
     int num_samples,
     int sample_rate,
     int channels,
-    int64_t timestamp_us
+    int64_t timestamp_us,
+    int64_t capture_time_us,
+    int has_capture_time
 );
 
 /*
@@ -1532,6 +2487,107 @@ SHIM_EXPORT void shim_track_remove_video_sink(void* track);
  */
 SHIM_EXPORT void shim_track_remove_audio_sink(void* track);
 
+/*
+ * Video mailbox sink.
+ *
+ * Instead of converting and handing over every frame on the decode thread,
+ * the track keeps up to `slots` decoded frames and the application pulls
+ * them when ready. When the mailbox is full the oldest frame is dropped and
+ * counted. With one slot only the latest frame is kept and the decode thread
+ * never takes a lock. Conversion to I420 happens in
+ * shim_track_pull_video_frame, on the caller's thread.
+ *
+ * Setting a mailbox replaces any video sink of the track; remove it with
+ * shim_track_remove_video_sink.
+ */
+#define SHIM_MAX_VIDEO_MAILBOX_SLOTS 64
+
+typedef struct ShimVideoFrame ShimVideoFrame;
+
+typedef struct {
+    void* track;
+    int slots;  /* 1..SHIM_MAX_VIDEO_MAILBOX_SLOTS */
+} ShimTrackSetVideoMailboxParams;
+
+SHIM_EXPORT int shim_track_set_video_mailbox(
+    ShimTrackSetVideoMailboxParams* params
+);
+
+/*
+ * Pull the oldest frame from a track's video mailbox.
+ *
+ * On SHIM_OK with frame == NULL the mailbox was empty. Otherwise the plane
+ * pointers stay valid until shim_video_frame_release(frame).
+ * Returns SHIM_ERROR_NOT_FOUND if the track has no mailbox.
+ */
+typedef struct {
+    void* track;
+    /* Outputs */
+    ShimVideoFrame* frame;
+    int width;
+    int height;
+    const uint8_t* y_plane;
+    const uint8_t* u_plane;
+    const uint8_t* v_plane;
+    int y_stride;
+    int u_stride;
+    int v_stride;
+    int64_t timestamp_us;
+    uint64_t frames_dropped;  /* Frames dropped since the mailbox was set */
+} ShimTrackPullVideoFrameParams;
+
+SHIM_EXPORT int shim_track_pull_video_frame(
+    ShimTrackPullVideoFrameParams* params
+);
+
+SHIM_EXPORT void shim_video_frame_release(ShimVideoFrame* frame);
+
+/*
+ * Limit the frames delivered by a track's video sink (callback, event queue
+ * or mailbox). The limits are passed upstream as VideoSinkWants so the
+ * source can adapt; frames still above them are dropped (frame rate) or
+ * scaled down to the target, else the max, pixel count before delivery.
+ * Zero means no limit. The limits apply to the current sink and are reset
+ * when a new sink is set.
+ *
+ * Returns SHIM_ERROR_NOT_FOUND if the track has no video sink.
+ */
+typedef struct {
+    void* track;
+    int max_pixel_count;
+    int target_pixel_count;
+    int max_framerate;
+} ShimTrackSetVideoSinkWantsParams;
+
+SHIM_EXPORT int shim_track_set_video_sink_wants(
+    ShimTrackSetVideoSinkWantsParams* params
+);
+
+/*
+ * Batch and convert the audio delivered by a track's audio sink (callback
+ * or event queue). Audio arrives in 10 ms chunks; with batch_ms set, chunks
+ * are collected in a preallocated buffer and delivered batch_ms at a time,
+ * stamped with the times of their first sample. Samples of any depth are
+ * converted to S16, then mixed to `channels` (1 or 2) and resampled to
+ * `sample_rate`. Rates the resampler cannot convert are delivered as
+ * received. Zero keeps 10 ms chunks and the source format. The settings
+ * apply to the current sink and are reset when a new sink is set.
+ *
+ * Returns SHIM_ERROR_NOT_FOUND if the track has no audio sink.
+ */
+#define SHIM_MAX_AUDIO_SINK_BATCH_MS 100
+
+typedef struct {
+    void* track;
+    int batch_ms;     /* 0..SHIM_MAX_AUDIO_SINK_BATCH_MS */
+    int sample_rate;  /* Hz */
+    int channels;     /* 0, 1 or 2 */
+} ShimTrackSetAudioSinkFormatParams;
+
+SHIM_EXPORT int shim_track_set_audio_sink_format(
+    ShimTrackSetAudioSinkFormatParams* params
+);
+
 /*
  * Get track kind ("audio" or "video").
  */
@@ -1879,6 +2935,230 @@ SHIM_EXPORT int shim_rtp_receiver_set_jitter_buffer_min_delay(
     ShimRTPReceiverSetJitterBufferMinDelayParams* params
 );
 
+/* ============================================================================
+ * Encoded Frame Receiving API
+ *
+ * Delivers a remote video stream's assembled encoded frames, before decoding,
+ * for recorders and relays that only need the bitstream. Combine with
+ * disable_video_decoding in the factory config to skip decoding entirely.
+ * ========================================================================== */
+
+#define SHIM_MAX_FRAME_DEPENDENCIES 8
+
+typedef struct {
+    int codec;                  /* ShimCodecType, -1 if unknown */
+    uint32_t ssrc;
+    uint32_t rtp_timestamp;
+    int payload_type;
+    int is_keyframe;
+    int width;                  /* 0 unless carried by the frame (keyframes) */
+    int height;
+    int spatial_index;
+    int temporal_index;
+    int num_dependencies;
+    int64_t frame_id;           /* -1 without a dependency descriptor or codec frame id */
+    int64_t dependencies[SHIM_MAX_FRAME_DEPENDENCIES];  /* frame_ids this frame references */
+    int64_t receive_time_us;    /* Arrival of the frame's last packet, 0 if unknown */
+} ShimEncodedVideoFrameInfo;
+
+/*
+ * Callback for an encoded frame of a remote video stream. info and data are
+ * only valid during the call. Called on the worker thread - should return
+ * quickly!
+ */
+typedef void (*ShimOnEncodedVideoFrame)(
+    void* ctx,
+    const ShimEncodedVideoFrameInfo* info,
+    const uint8_t* data,
+    int size
+);
+
+/*
+ * Set the encoded frame callback of a video receiver. A NULL callback removes
+ * it unless a queue is set (see shim_rtp_receiver_set_encoded_frame_event_queue).
+ * Frames still go on to the decoder, if any.
+ *
+ * @param params Input parameters (receiver + callback + ctx)
+ * @return SHIM_OK on success, SHIM_ERROR_INVALID_PARAM for audio receivers
+ */
+typedef struct {
+    ShimRTPReceiver* receiver;
+    ShimOnEncodedVideoFrame callback;
+    void* ctx;
+} ShimRTPReceiverSetOnEncodedFrameParams;
+
+SHIM_EXPORT int shim_rtp_receiver_set_on_encoded_frame(
+    ShimRTPReceiverSetOnEncodedFrameParams* params
+);
+
+/* ============================================================================
+ * Event Queue API
+ *
+ * Opt-in alternative to the per-event callbacks above. Objects attached to a
+ * queue push typed events into a bounded lock-free ring instead of calling
+ * back, and the queue signals a file descriptor (an eventfd on Linux, a pipe
+ * elsewhere) when events are pending. One consumer thread waits on the fd and
+ * drains many events per call with shim_event_queue_drain.
+ *
+ * When the ring is full new events are dropped and counted in out_dropped;
+ * size the capacity for the expected burst.
+ * ========================================================================== */
+
+typedef struct ShimEventQueue ShimEventQueue;
+
+typedef enum {
+    SHIM_EVENT_ICE_CANDIDATE = 1,          /* payload: "candidate\0sdp_mid", value: sdp_mline_index */
+    SHIM_EVENT_CONNECTION_STATE = 2,       /* value: state */
+    SHIM_EVENT_ICE_CONNECTION_STATE = 3,   /* value: state */
+    SHIM_EVENT_ICE_GATHERING_STATE = 4,    /* value: state */
+    SHIM_EVENT_SIGNALING_STATE = 5,        /* value: state */
+    SHIM_EVENT_NEGOTIATION_NEEDED = 6,
+    SHIM_EVENT_TRACK = 7,                  /* object: track, object2: receiver */
+    SHIM_EVENT_DATA_CHANNEL = 8,           /* object: data channel */
+    SHIM_EVENT_DATA_CHANNEL_OPEN = 9,      /* object: data channel */
+    SHIM_EVENT_DATA_CHANNEL_CLOSE = 10,    /* object: data channel */
+    SHIM_EVENT_DATA_CHANNEL_MESSAGE = 11,  /* object: data channel, payload: message, value: is_binary */
+    SHIM_EVENT_VIDEO_FRAME = 12,           /* no payload; width/height, timestamp_us of a frame
+                                              waiting for shim_track_pull_video_frame */
+    SHIM_EVENT_AUDIO_FRAME = 13,           /* payload: int16 samples, value: sample_rate,
+                                              width: channels, height: samples per channel,
+                                              timestamp_us, capture_time_us as for
+                                              ShimOnAudioFrame */
+    SHIM_EVENT_RTCP_FEEDBACK = 14,         /* object: sender, payload: ShimRTCPFeedback[value] */
+    SHIM_EVENT_ENCODED_VIDEO_FRAME = 15,   /* object: receiver, payload: ShimEncodedVideoFrameInfo
+                                              followed by the frame data, value: frame size */
+} ShimEventType;
+
+typedef struct {
+    int type;                   /* ShimEventType */
+    int value;                  /* Type-specific, see ShimEventType */
+    uint64_t tag;               /* Tag given when the source was attached */
+    void* object;
+    void* object2;
+    int width;
+    int height;
+    int64_t timestamp_us;
+    int payload_offset;         /* Offset into the drain payload buffer */
+    int payload_len;
+    int64_t capture_time_us;    /* Audio frames: valid if has_capture_time */
+    int has_capture_time;
+} ShimEvent;
+
+typedef struct {
+    int capacity;               /* Max pending events, rounded up to a power of two; 0 = 4096 */
+    ShimErrorBuffer* error_out; /* Optional: buffer for error message */
+} ShimEventQueueCreateParams;
+
+SHIM_EXPORT ShimEventQueue* shim_event_queue_create(
+    ShimEventQueueCreateParams* params
+);
+
+/*
+ * Returns the non-blocking fd that becomes readable when events are pending.
+ * Owned by the queue; read it to clear the notification before draining.
+ */
+SHIM_EXPORT int shim_event_queue_fd(ShimEventQueue* queue);
+
+/*
+ * Sources still attached keep the ring alive but their events are discarded.
+ */
+SHIM_EXPORT void shim_event_queue_destroy(ShimEventQueue* queue);
+
+typedef struct {
+    ShimEventQueue* queue;
+    ShimEvent* events;          /* Caller-provided array */
+    int max_events;
+    uint8_t* payload;           /* Caller-provided buffer for event payloads */
+    int payload_size;
+    int out_count;
+    int out_payload_len;        /* Bytes used, or bytes needed if BUFFER_TOO_SMALL */
+    uint64_t out_dropped;       /* Events dropped since the previous drain */
+    ShimErrorBuffer* error_out; /* Optional: buffer for error message */
+} ShimEventQueueDrainParams;
+
+/*
+ * Move up to max_events pending events into events, copying their payloads
+ * into payload. Stops early when the next payload does not fit; returns
+ * SHIM_ERROR_BUFFER_TOO_SMALL only if not even the first one fits.
+ * Must not be called concurrently for the same queue.
+ */
+SHIM_EXPORT int shim_event_queue_drain(ShimEventQueueDrainParams* params);
+
+/* Route a PeerConnection's observer events to a queue (NULL restores callbacks) */
+typedef struct {
+    ShimPeerConnection* pc;
+    ShimEventQueue* queue;
+    uint64_t tag;
+} ShimPeerConnectionSetEventQueueParams;
+
+SHIM_EXPORT void shim_peer_connection_set_event_queue(
+    ShimPeerConnectionSetEventQueueParams* params
+);
+
+/* Route a DataChannel's open/close/message events to a queue (NULL restores callbacks) */
+typedef struct {
+    ShimDataChannel* dc;
+    ShimEventQueue* queue;
+    uint64_t tag;
+} ShimDataChannelSetEventQueueParams;
+
+SHIM_EXPORT void shim_data_channel_set_event_queue(
+    ShimDataChannelSetEventQueueParams* params
+);
+
+/*
+ * Attach a remote track sink that queues frames instead of calling back.
+ * Replaces any existing sink; remove it with shim_track_remove_video_sink or
+ * shim_track_remove_audio_sink.
+ *
+ * Video frames are not copied into the queue: the sink keeps the last few
+ * decoded frames in a mailbox, as shim_track_set_video_mailbox does, and
+ * announces each with a SHIM_EVENT_VIDEO_FRAME event. Pull them with
+ * shim_track_pull_video_frame; frames not pulled in time are dropped and
+ * counted in frames_dropped.
+ */
+typedef struct {
+    void* track;
+    ShimEventQueue* queue;
+    uint64_t tag;
+} ShimTrackSetEventQueueSinkParams;
+
+SHIM_EXPORT int shim_track_set_video_sink_event_queue(
+    ShimTrackSetEventQueueSinkParams* params
+);
+
+SHIM_EXPORT int shim_track_set_audio_sink_event_queue(
+    ShimTrackSetEventQueueSinkParams* params
+);
+
+/*
+ * Queue a sender's RTCP feedback batches instead of calling back (NULL
+ * restores the callback). NACKs are read at the interval last given here
+ * or to shim_rtp_sender_set_on_rtcp_feedback.
+ */
+typedef struct {
+    ShimPeerConnection* pc;
+    ShimRTPSender* sender;
+    ShimEventQueue* queue;
+    uint64_t tag;
+    int interval_ms;            /* NACK interval; 0 = 1000 */
+} ShimRTPSenderSetRTCPFeedbackEventQueueParams;
+
+SHIM_EXPORT void shim_rtp_sender_set_rtcp_feedback_event_queue(
+    ShimRTPSenderSetRTCPFeedbackEventQueueParams* params
+);
+
+/* Queue a video receiver's encoded frames instead of calling back (NULL restores the callback) */
+typedef struct {
+    ShimRTPReceiver* receiver;
+    ShimEventQueue* queue;
+    uint64_t tag;
+} ShimRTPReceiverSetEncodedFrameEventQueueParams;
+
+SHIM_EXPORT int shim_rtp_receiver_set_encoded_frame_event_queue(
+    ShimRTPReceiverSetEncodedFrameEventQueueParams* params
+);
+
 /* ============================================================================
  * Memory helpers
  * ========================================================================== */
@@ -0,0 +1,403 @@
+/*
+ * shim_bandwidth.cc - Congestion control and bandwidth estimate observation
+ *
+ * Each PeerConnection is created with a NetworkControllerFactory that wraps
+ * its congestion controller: libwebrtc's GoogCC, optionally with tuned rate
+ * bounds and probing, or a fixed-rate controller for trusted links. The
+ * wrapper forwards every transport event to the real controller and records
+ * the target rate, pacing rate and congestion window of each update it
+ * returns, so callers get the estimate as soon as the controller changes it
+ * instead of through stats polling. It also counts the REMB and transport-wide
+ * feedback it forwards for RTCP feedback reporting.
+ */
+
+#include "shim_common.h"
+#include "shim_internal.h"
+
+#include <algorithm>
+#include <cstring>
+#include <limits>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <string>
+#include <utility>
+
+#include "api/transport/goog_cc_factory.h"
+#include "api/transport/network_control.h"
+#include "api/transport/network_types.h"
+#include "rtc_base/time_utils.h"
+
+namespace shim {
+
+/* ============================================================================
+ * BandwidthEstimator
+ * ========================================================================== */
+
+void BandwidthEstimator::SetCallback(ShimOnBandwidthEstimate callback, void* ctx) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    callback_ = callback;
+    ctx_ = ctx;
+}
+
+ShimBandwidthEstimate BandwidthEstimator::Latest() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return latest_;
+}
+
+TransportFeedbackTotals BandwidthEstimator::FeedbackTotals() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return feedback_;
+}
+
+void BandwidthEstimator::OnRemoteBitrateReport(const webrtc::RemoteBitrateReport& report) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    feedback_.remb_reports++;
+    feedback_.remb_bitrate_bps = report.bandwidth.bps_or(0);
+}
+
+void BandwidthEstimator::OnTransportPacketsFeedback(const webrtc::TransportPacketsFeedback& feedback) {
+    int64_t lost = 0;
+    for (const webrtc::PacketResult& packet : feedback.packet_feedbacks) {
+        if (!packet.IsReceived()) {
+            lost++;
+        }
+    }
+    std::lock_guard<std::mutex> lock(mutex_);
+    feedback_.twcc_reports++;
+    feedback_.twcc_packets += static_cast<int64_t>(feedback.packet_feedbacks.size());
+    feedback_.twcc_lost += lost;
+}
+
+void BandwidthEstimator::OnUpdate(const webrtc::NetworkControlUpdate& update) {
+    if (!update.target_rate && !update.pacer_config && !update.congestion_window) {
+        return;
+    }
+
+    ShimBandwidthEstimate estimate;
+    ShimOnBandwidthEstimate callback;
+    void* ctx;
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        // Updates carry only what changed; merge into the last estimate.
+        if (update.target_rate) {
+            const webrtc::TargetTransferRate& target = *update.target_rate;
+            latest_.target_bitrate_bps = target.target_rate.bps_or(0);
+            latest_.available_send_bps = target.network_estimate.bandwidth.IsFinite()
+                ? target.network_estimate.bandwidth.bps()
+                : 0;
+            latest_.loss_rate = target.network_estimate.loss_rate_ratio;
+        }
+        if (update.pacer_config) {
+            latest_.pacing_rate_bps = update.pacer_config->data_rate().bps_or(0);
+        }
+        if (update.congestion_window) {
+            // Infinite when the controller does not limit data in flight.
+            const webrtc::DataSize window = *update.congestion_window;
+            latest_.congestion_window = window.IsFinite()
+                ? static_cast<int>(std::min<int64_t>(window.bytes(), std::numeric_limits<int>::max()))
+                : 0;
+        }
+        latest_.timestamp_us = webrtc::TimeMicros();
+        estimate = latest_;
+        callback = callback_;
+        ctx = ctx_;
+    }
+
+    if (callback) {
+        callback(ctx, &estimate);
+    }
+}
+
+bool BuildNetworkControllerSettings(
+    const ShimPeerConnectionConfig* config,
+    NetworkControllerSettings* settings,
+    ShimErrorBuffer* error_out
+) {
+    *settings = NetworkControllerSettings();
+    if (!config) {
+        return true;
+    }
+
+    if (config->network_controller != SHIM_NETWORK_CONTROLLER_GOOG_CC &&
+        config->network_controller != SHIM_NETWORK_CONTROLLER_FIXED) {
+        SetErrorMessage(error_out, "invalid network_controller: " + std::to_string(config->network_controller),
+                        SHIM_ERROR_INVALID_PARAM);
+        return false;
+    }
+    if (config->start_bitrate_bps < 0 || config->min_bitrate_bps < 0 || config->max_bitrate_bps < 0) {
+        SetErrorMessage(error_out, "invalid bitrate: must be >= 0", SHIM_ERROR_INVALID_PARAM);
+        return false;
+    }
+    if (config->max_bitrate_bps > 0 && config->min_bitrate_bps > config->max_bitrate_bps) {
+        SetErrorMessage(error_out, "invalid bitrate: min_bitrate_bps above max_bitrate_bps",
+                        SHIM_ERROR_INVALID_PARAM);
+        return false;
+    }
+    if (config->network_controller == SHIM_NETWORK_CONTROLLER_FIXED && config->start_bitrate_bps <= 0) {
+        SetErrorMessage(error_out, "fixed network controller requires start_bitrate_bps",
+                        SHIM_ERROR_INVALID_PARAM);
+        return false;
+    }
+
+    settings->type = config->network_controller;
+    settings->start_bitrate_bps = config->start_bitrate_bps;
+    settings->min_bitrate_bps = config->min_bitrate_bps;
+    settings->max_bitrate_bps = config->max_bitrate_bps;
+    settings->disable_probing = config->disable_probing != 0;
+    return true;
+}
+
+namespace {
+
+// Pacing headroom over the target rate, as GoogCC uses by default.
+constexpr double kFixedRatePacingFactor = 2.5;
+
+// Apply the configured bounds to constraints from the call (SDP bandwidth,
+// encoding max bitrates). Unset configured values leave them alone.
+webrtc::TargetRateConstraints Constrain(webrtc::TargetRateConstraints constraints,
+                                        const NetworkControllerSettings& settings) {
+    if (settings.min_bitrate_bps > 0) {
+        const auto floor = webrtc::DataRate::BitsPerSec(settings.min_bitrate_bps);
+        constraints.min_data_rate = constraints.min_data_rate ? std::max(*constraints.min_data_rate, floor) : floor;
+    }
+    if (settings.max_bitrate_bps > 0) {
+        const auto ceiling = webrtc::DataRate::BitsPerSec(settings.max_bitrate_bps);
+        constraints.max_data_rate = constraints.max_data_rate ? std::min(*constraints.max_data_rate, ceiling) : ceiling;
+    }
+    return constraints;
+}
+
+/* ============================================================================
+ * Fixed-Rate Network Controller
+ * ========================================================================== */
+
+// Targets a constant rate regardless of loss and delay. Meant for trusted,
+// provisioned links where probing and backing off only cost throughput.
+class FixedRateNetworkController : public webrtc::NetworkControllerInterface {
+public:
+    FixedRateNetworkController(const webrtc::TargetRateConstraints& constraints, webrtc::DataRate rate)
+        : rate_(rate) {
+        ApplyConstraints(constraints);
+    }
+
+    webrtc::NetworkControlUpdate OnNetworkAvailability(webrtc::NetworkAvailability msg) override {
+        return Report(msg.at_time);
+    }
+    webrtc::NetworkControlUpdate OnNetworkRouteChange(webrtc::NetworkRouteChange msg) override {
+        ApplyConstraints(msg.constraints);
+        return Report(msg.at_time);
+    }
+    webrtc::NetworkControlUpdate OnProcessInterval(webrtc::ProcessInterval msg) override {
+        return Report(msg.at_time);
+    }
+    webrtc::NetworkControlUpdate OnRemoteBitrateReport(webrtc::RemoteBitrateReport) override {
+        return webrtc::NetworkControlUpdate();
+    }
+    webrtc::NetworkControlUpdate OnRoundTripTimeUpdate(webrtc::RoundTripTimeUpdate msg) override {
+        if (msg.round_trip_time.IsFinite() && !msg.smoothed) {
+            rtt_ = msg.round_trip_time;
+        }
+        return webrtc::NetworkControlUpdate();
+    }
+    webrtc::NetworkControlUpdate OnSentPacket(webrtc::SentPacket) override {
+        return webrtc::NetworkControlUpdate();
+    }
+    webrtc::NetworkControlUpdate OnReceivedPacket(webrtc::ReceivedPacket) override {
+        return webrtc::NetworkControlUpdate();
+    }
+    webrtc::NetworkControlUpdate OnStreamsConfig(webrtc::StreamsConfig) override {
+        return webrtc::NetworkControlUpdate();
+    }
+    webrtc::NetworkControlUpdate OnTargetRateConstraints(webrtc::TargetRateConstraints msg) override {
+        ApplyConstraints(msg);
+        return Report(msg.at_time);
+    }
+    webrtc::NetworkControlUpdate OnTransportLossReport(webrtc::TransportLossReport) override {
+        return webrtc::NetworkControlUpdate();
+    }
+    webrtc::NetworkControlUpdate OnTransportPacketsFeedback(webrtc::TransportPacketsFeedback) override {
+        return webrtc::NetworkControlUpdate();
+    }
+    webrtc::NetworkControlUpdate OnNetworkStateEstimate(webrtc::NetworkStateEstimate) override {
+        return webrtc::NetworkControlUpdate();
+    }
+
+private:
+    void ApplyConstraints(const webrtc::TargetRateConstraints& constraints) {
+        max_ = constraints.max_data_rate.value_or(webrtc::DataRate::PlusInfinity());
+    }
+
+    // Report the rate when it changes; the first process interval reports it
+    // once the transport is set up.
+    webrtc::NetworkControlUpdate Report(webrtc::Timestamp at_time) {
+        webrtc::NetworkControlUpdate update;
+        const webrtc::DataRate rate = std::min(rate_, max_);
+        if (reported_ && rate == *reported_) {
+            return update;
+        }
+        reported_ = rate;
+
+        webrtc::TargetTransferRate target;
+        target.at_time = at_time;
+        target.target_rate = rate;
+        target.stable_target_rate = rate;
+        target.network_estimate.at_time = at_time;
+        target.network_estimate.bandwidth = rate;
+        target.network_estimate.round_trip_time = rtt_;
+        target.network_estimate.bwe_period = webrtc::TimeDelta::Seconds(3);
+        target.network_estimate.loss_rate_ratio = 0;
+        update.target_rate = target;
+
+        webrtc::PacerConfig pacer;
+        pacer.at_time = at_time;
+        pacer.time_window = webrtc::TimeDelta::Seconds(1);
+        pacer.data_window = rate * kFixedRatePacingFactor * pacer.time_window;
+        pacer.pad_window = webrtc::DataSize::Zero();
+        update.pacer_config = pacer;
+        return update;
+    }
+
+    const webrtc::DataRate rate_;
+    webrtc::DataRate max_ = webrtc::DataRate::PlusInfinity();
+    webrtc::TimeDelta rtt_ = webrtc::TimeDelta::Millis(100);
+    std::optional<webrtc::DataRate> reported_;
+};
+
+/* ============================================================================
+ * Observing Network Controller
+ * ========================================================================== */
+
+// Forwards to the wrapped controller, applies the configured rate bounds and
+// probing policy, and reports each update it returns. Runs on the call's
+// transport task queue.
+class ObservingNetworkController : public webrtc::NetworkControllerInterface {
+public:
+    ObservingNetworkController(std::unique_ptr<webrtc::NetworkControllerInterface> controller,
+                               const NetworkControllerSettings& settings,
+                               std::shared_ptr<BandwidthEstimator> estimator)
+        : controller_(std::move(controller)), settings_(settings), estimator_(std::move(estimator)) {}
+
+    webrtc::NetworkControlUpdate OnNetworkAvailability(webrtc::NetworkAvailability msg) override {
+        return Observe(controller_->OnNetworkAvailability(msg));
+    }
+    webrtc::NetworkControlUpdate OnNetworkRouteChange(webrtc::NetworkRouteChange msg) override {
+        msg.constraints = Constrain(msg.constraints, settings_);
+        return Observe(controller_->OnNetworkRouteChange(msg));
+    }
+    webrtc::NetworkControlUpdate OnProcessInterval(webrtc::ProcessInterval msg) override {
+        return Observe(controller_->OnProcessInterval(msg));
+    }
+    webrtc::NetworkControlUpdate OnRemoteBitrateReport(webrtc::RemoteBitrateReport msg) override {
+        estimator_->OnRemoteBitrateReport(msg);
+        return Observe(controller_->OnRemoteBitrateReport(msg));
+    }
+    webrtc::NetworkControlUpdate OnRoundTripTimeUpdate(webrtc::RoundTripTimeUpdate msg) override {
+        return Observe(controller_->OnRoundTripTimeUpdate(msg));
+    }
+    webrtc::NetworkControlUpdate OnSentPacket(webrtc::SentPacket msg) override {
+        return Observe(controller_->OnSentPacket(msg));
+    }
+    webrtc::NetworkControlUpdate OnReceivedPacket(webrtc::ReceivedPacket msg) override {
+        return Observe(controller_->OnReceivedPacket(msg));
+    }
+    webrtc::NetworkControlUpdate OnStreamsConfig(webrtc::StreamsConfig msg) override {
+        return Observe(controller_->OnStreamsConfig(msg));
+    }
+    webrtc::NetworkControlUpdate OnTargetRateConstraints(webrtc::TargetRateConstraints msg) override {
+        return Observe(controller_->OnTargetRateConstraints(Constrain(msg, settings_)));
+    }
+    webrtc::NetworkControlUpdate OnTransportLossReport(webrtc::TransportLossReport msg) override {
+        return Observe(controller_->OnTransportLossReport(msg));
+    }
+    webrtc::NetworkControlUpdate OnTransportPacketsFeedback(webrtc::TransportPacketsFeedback msg) override {
+        estimator_->OnTransportPacketsFeedback(msg);
+        return Observe(controller_->OnTransportPacketsFeedback(msg));
+    }
+    webrtc::NetworkControlUpdate OnNetworkStateEstimate(webrtc::NetworkStateEstimate msg) override {
+        return Observe(controller_->OnNetworkStateEstimate(msg));
+    }
+
+private:
+    webrtc::NetworkControlUpdate Observe(webrtc::NetworkControlUpdate update) {
+        if (settings_.disable_probing) {
+            update.probe_cluster_configs.clear();
+        }
+        estimator_->OnUpdate(update);
+        return update;
+    }
+
+    std::unique_ptr<webrtc::NetworkControllerInterface> controller_;
+    const NetworkControllerSettings settings_;
+    std::shared_ptr<BandwidthEstimator> estimator_;
+};
+
+class ObservingNetworkControllerFactory : public webrtc::NetworkControllerFactoryInterface {
+public:
+    ObservingNetworkControllerFactory(const NetworkControllerSettings& settings,
+                                      std::shared_ptr<BandwidthEstimator> estimator)
+        : settings_(settings), estimator_(std::move(estimator)) {}
+
+    std::unique_ptr<webrtc::NetworkControllerInterface> Create(webrtc::NetworkControllerConfig config) override {
+        config.constraints = Constrain(config.constraints, settings_);
+
+        std::unique_ptr<webrtc::NetworkControllerInterface> controller;
+        if (settings_.type == SHIM_NETWORK_CONTROLLER_FIXED) {
+            controller = std::make_unique<FixedRateNetworkController>(
+                config.constraints, webrtc::DataRate::BitsPerSec(settings_.start_bitrate_bps));
+        } else {
+            if (settings_.start_bitrate_bps > 0) {
+                config.constraints.starting_rate = webrtc::DataRate::BitsPerSec(settings_.start_bitrate_bps);
+            }
+            controller = goog_cc_.Create(config);
+        }
+        return std::make_unique<ObservingNetworkController>(std::move(controller), settings_, estimator_);
+    }
+
+    webrtc::TimeDelta GetProcessInterval() const override {
+        return goog_cc_.GetProcessInterval();
+    }
+
+private:
+    const NetworkControllerSettings settings_;
+    std::shared_ptr<BandwidthEstimator> estimator_;
+    webrtc::GoogCcNetworkControllerFactory goog_cc_;
+};
+
+}  // namespace
+
+std::unique_ptr<webrtc::NetworkControllerFactoryInterface> CreateNetworkControllerFactory(
+    const NetworkControllerSettings& settings,
+    std::shared_ptr<BandwidthEstimator> estimator) {
+    return std::make_unique<ObservingNetworkControllerFactory>(settings, std::move(estimator));
+}
+
+}  // namespace shim
+
+/* ============================================================================
+ * C API Implementation
+ * ========================================================================== */
+
+extern "C" {
+
+SHIM_EXPORT void shim_peer_connection_set_on_bandwidth_estimate(ShimPeerConnectionSetOnBandwidthEstimateParams* params) {
+    if (!params || !params->pc || !params->pc->bandwidth) {
+        return;
+    }
+    params->pc->bandwidth->SetCallback(params->callback, params->ctx);
+}
+
+SHIM_EXPORT int shim_peer_connection_get_bandwidth_estimate(ShimPeerConnectionGetBandwidthEstimateParams* params) {
+    if (!params) {
+        return SHIM_ERROR_INVALID_PARAM;
+    }
+    memset(&params->out_estimate, 0, sizeof(ShimBandwidthEstimate));
+    if (!params->pc || !params->pc->bandwidth) {
+        return SHIM_ERROR_INVALID_PARAM;
+    }
+
+    params->out_estimate = params->pc->bandwidth->Latest();
+    return SHIM_OK;
+}
+
+}  // extern "C"
@@ -55,7 +55,7 @@ void InitializeGlobals() {
         g_worker_thread->SetName("worker_thread", nullptr);
         g_worker_thread->Start();
 
-        g_network_thread = webrtc::Thread::CreateWithSocketServer();
+        g_network_thread = CreateNetworkThread(SHIM_SOCKET_SERVER_DEFAULT);
         g_network_thread->SetName("network_thread", nullptr);
         g_network_thread->Start();
     });
@@ -89,6 +89,16 @@ bool ShouldUseSoftwareCodecs() {
     return IsTruthyEnv(std::getenv("LIBWEBRTC_PREFER_SOFTWARE_CODECS"));
 }
 
+bool ShouldUseBatchedSocketServer() {
+#if defined(WEBRTC_LINUX)
+    return IsTruthyEnv(std::getenv("LIBWEBRTC_BATCHED_UDP"));
+#else
+    // The batched server needs recvmmsg/sendmmsg; elsewhere the variable is
+    // ignored rather than leaving the default network thread unset.
+    return false;
+#endif
+}
+
 webrtc::VideoCodecType ToWebRTCCodecType(ShimCodecType codec) {
     switch (codec) {
         case SHIM_CODEC_H264: return webrtc::kVideoCodecH264;
@@ -44,6 +44,14 @@ webrtc::Thread* GetNetworkThread();
 // Software codec preference
 bool ShouldUseSoftwareCodecs();
 
+// Batched socket server preference (LIBWEBRTC_BATCHED_UDP, Linux only)
+bool ShouldUseBatchedSocketServer();
+
+// Create an unstarted network thread backed by a ShimSocketServerType.
+// SHIM_SOCKET_SERVER_DEFAULT uses the process-wide selection and locks it.
+// Returns nullptr if the type is not supported on this platform.
+std::unique_ptr<webrtc::Thread> CreateNetworkThread(int type);
+
 // Codec type conversions
 webrtc::VideoCodecType ToWebRTCCodecType(ShimCodecType codec);
 std::string CodecTypeToString(ShimCodecType codec);
@@ -5,6 +5,7 @@
  */
 
 #include "shim_common.h"
+#include "shim_internal.h"
 
 #include <map>
 #include <cstring>
@@ -26,6 +27,9 @@ struct ShimDataChannelWrapper {
     void* on_open_ctx = nullptr;
     ShimOnDataChannelClose on_close = nullptr;
     void* on_close_ctx = nullptr;
+
+    // Replaces the callbacks above while a queue is attached
+    shim::EventTarget events;
 };
 
 class DataChannelObserverImpl : public webrtc::DataChannelObserver {
@@ -36,6 +40,16 @@ public:
     void OnStateChange() override {
         if (!wrapper_) return;
         auto state = wrapper_->channel->state();
+        if (state == webrtc::DataChannelInterface::kOpen || state == webrtc::DataChannelInterface::kClosed) {
+            ShimEvent event{};
+            event.type = state == webrtc::DataChannelInterface::kOpen
+                ? SHIM_EVENT_DATA_CHANNEL_OPEN
+                : SHIM_EVENT_DATA_CHANNEL_CLOSE;
+            event.object = wrapper_->channel;
+            if (wrapper_->events.Emit(event)) {
+                return;
+            }
+        }
         if (state == webrtc::DataChannelInterface::kOpen && wrapper_->on_open) {
             wrapper_->on_open(wrapper_->on_open_ctx);
         } else if (state == webrtc::DataChannelInterface::kClosed && wrapper_->on_close) {
@@ -44,7 +58,15 @@ public:
     }
 
     void OnMessage(const webrtc::DataBuffer& buffer) override {
-        if (wrapper_ && wrapper_->on_message) {
+        if (!wrapper_) return;
+        ShimEvent event{};
+        event.type = SHIM_EVENT_DATA_CHANNEL_MESSAGE;
+        event.value = buffer.binary ? 1 : 0;
+        event.object = wrapper_->channel;
+        if (wrapper_->events.Emit(event, std::vector<uint8_t>(buffer.data.cdata(), buffer.data.cdata() + buffer.data.size()))) {
+            return;
+        }
+        if (wrapper_->on_message) {
             wrapper_->on_message(
                 wrapper_->on_message_ctx,
                 buffer.data.data(),
@@ -135,6 +157,16 @@ SHIM_EXPORT void shim_data_channel_set_on_close(ShimDataChannelSetOnCloseParams*
     }
 }
 
+SHIM_EXPORT void shim_data_channel_set_event_queue(ShimDataChannelSetEventQueueParams* params) {
+    if (!params) {
+        return;
+    }
+    auto* wrapper = GetOrCreateWrapper(params->dc);
+    if (wrapper) {
+        wrapper->events.Attach(params->queue ? params->queue->ring : nullptr, params->tag);
+    }
+}
+
 SHIM_EXPORT int shim_data_channel_send(ShimDataChannelSendParams* params) {
     if (!params || !params->dc || !params->data) {
         shim::SetErrorMessage(params ? params->error_out : nullptr, "invalid parameter", SHIM_ERROR_INVALID_PARAM);
@@ -0,0 +1,322 @@
+/*
+ * shim_encoded_sink.cc - Encoded frames of remote video streams
+ *
+ * Recorders and relays only need the bitstream, so decoding every received
+ * stream is wasted work:
+ *
+ * - An encoded frame sink is a receiver frame transformer (EncodedFrameSink).
+ *   libwebrtc hands it each frame once the packet buffer has assembled it,
+ *   before the decoder; the sink reports the frame and passes it on
+ *   unchanged.
+ * - Factories created with disable_video_decoding wrap their decoder factory
+ *   so it still negotiates every codec but creates decoders that discard
+ *   frames (DiscardingVideoDecoder). No real decoder is ever instantiated.
+ *   Frames are still passed to it rather than dropped before the frame
+ *   buffer, which would stall the jitter buffer and make the receiver
+ *   request keyframes over and over.
+ */
+
+#include "shim_common.h"
+#include "shim_internal.h"
+
+#include <algorithm>
+#include <cstring>
+#include <memory>
+#include <mutex>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+#include "api/frame_transformer_interface.h"
+#include "api/rtp_receiver_interface.h"
+#include "api/scoped_refptr.h"
+#include "api/video/encoded_image.h"
+#include "api/video/video_frame_metadata.h"
+#include "api/video_codecs/sdp_video_format.h"
+#include "api/video_codecs/video_decoder.h"
+#include "api/video_codecs/video_decoder_factory.h"
+#include "modules/video_coding/include/video_error_codes.h"
+
+namespace {
+
+/* ============================================================================
+ * Receive-only decoding
+ * ========================================================================== */
+
+class DiscardingVideoDecoder : public webrtc::VideoDecoder {
+public:
+    bool Configure(const Settings& settings) override { return true; }
+
+    int32_t Decode(const webrtc::EncodedImage& input_image, int64_t render_time_ms) override {
+        return WEBRTC_VIDEO_CODEC_OK;
+    }
+
+    int32_t RegisterDecodeCompleteCallback(webrtc::DecodedImageCallback* callback) override {
+        return WEBRTC_VIDEO_CODEC_OK;
+    }
+
+    int32_t Release() override { return WEBRTC_VIDEO_CODEC_OK; }
+
+    DecoderInfo GetDecoderInfo() const override {
+        DecoderInfo info;
+        info.implementation_name = ImplementationName();
+        return info;
+    }
+
+    const char* ImplementationName() const override { return "DiscardingDecoder"; }
+};
+
+class DiscardingVideoDecoderFactory : public webrtc::VideoDecoderFactory {
+public:
+    explicit DiscardingVideoDecoderFactory(std::unique_ptr<webrtc::VideoDecoderFactory> factory)
+        : factory_(std::move(factory)) {}
+
+    std::vector<webrtc::SdpVideoFormat> GetSupportedFormats() const override {
+        return factory_->GetSupportedFormats();
+    }
+
+    CodecSupport QueryCodecSupport(const webrtc::SdpVideoFormat& format,
+                                   bool reference_scaling) const override {
+        return factory_->QueryCodecSupport(format, reference_scaling);
+    }
+
+    std::unique_ptr<webrtc::VideoDecoder> Create(const webrtc::Environment& env,
+                                                 const webrtc::SdpVideoFormat& format) override {
+        if (!format.IsCodecInList(factory_->GetSupportedFormats())) {
+            return nullptr;
+        }
+        return std::make_unique<DiscardingVideoDecoder>();
+    }
+
+private:
+    std::unique_ptr<webrtc::VideoDecoderFactory> factory_;
+};
+
+/* ============================================================================
+ * Encoded frame sink
+ * ========================================================================== */
+
+int ToShimCodecType(webrtc::VideoCodecType codec) {
+    switch (codec) {
+        case webrtc::kVideoCodecH264: return SHIM_CODEC_H264;
+        case webrtc::kVideoCodecVP8: return SHIM_CODEC_VP8;
+        case webrtc::kVideoCodecVP9: return SHIM_CODEC_VP9;
+        case webrtc::kVideoCodecAV1: return SHIM_CODEC_AV1;
+        default: return -1;
+    }
+}
+
+ShimEncodedVideoFrameInfo FrameInfo(const webrtc::TransformableVideoFrameInterface& frame) {
+    const webrtc::VideoFrameMetadata metadata = frame.Metadata();
+
+    ShimEncodedVideoFrameInfo info;
+    memset(&info, 0, sizeof(info));
+    info.codec = ToShimCodecType(metadata.GetCodec());
+    info.ssrc = frame.GetSsrc();
+    info.rtp_timestamp = frame.GetTimestamp();
+    info.payload_type = frame.GetPayloadType();
+    info.is_keyframe = frame.IsKeyFrame() ? 1 : 0;
+    info.width = metadata.GetWidth();
+    info.height = metadata.GetHeight();
+    info.spatial_index = metadata.GetSpatialIndex();
+    info.temporal_index = metadata.GetTemporalIndex();
+    info.frame_id = metadata.GetFrameId().value_or(-1);
+
+    const auto dependencies = metadata.GetFrameDependencies();
+    const size_t count = std::min<size_t>(dependencies.size(), SHIM_MAX_FRAME_DEPENDENCIES);
+    for (size_t i = 0; i < count; i++) {
+        info.dependencies[i] = dependencies[i];
+    }
+    info.num_dependencies = static_cast<int>(count);
+
+    if (auto receive_time = frame.ReceiveTime()) {
+        info.receive_time_us = receive_time->us();
+    }
+    return info;
+}
+
+// Installed as the receiver's frame transformer. Reports each frame to the
+// queue or callback, then returns it to the receive stream it came from.
+class EncodedFrameSink : public webrtc::FrameTransformerInterface {
+public:
+    explicit EncodedFrameSink(void* receiver) : receiver_(receiver) {}
+
+    void Transform(std::unique_ptr<webrtc::TransformableFrameInterface> frame) override {
+        if (frame->GetDirection() == webrtc::TransformableFrameInterface::Direction::kReceiver) {
+            Deliver(static_cast<const webrtc::TransformableVideoFrameInterface&>(*frame));
+        }
+
+        webrtc::scoped_refptr<webrtc::TransformedFrameCallback> callback;
+        {
+            std::lock_guard<std::mutex> lock(callbacks_mutex_);
+            auto it = sink_callbacks_.find(frame->GetSsrc());
+            callback = it != sink_callbacks_.end() ? it->second : callback_;
+        }
+        if (callback) {
+            callback->OnTransformedFrame(std::move(frame));
+        }
+    }
+
+    void RegisterTransformedFrameCallback(
+        webrtc::scoped_refptr<webrtc::TransformedFrameCallback> callback) override {
+        std::lock_guard<std::mutex> lock(callbacks_mutex_);
+        callback_ = std::move(callback);
+    }
+
+    void RegisterTransformedFrameSinkCallback(
+        webrtc::scoped_refptr<webrtc::TransformedFrameCallback> callback, uint32_t ssrc) override {
+        std::lock_guard<std::mutex> lock(callbacks_mutex_);
+        sink_callbacks_[ssrc] = std::move(callback);
+    }
+
+    void UnregisterTransformedFrameCallback() override {
+        std::lock_guard<std::mutex> lock(callbacks_mutex_);
+        callback_ = nullptr;
+    }
+
+    void UnregisterTransformedFrameSinkCallback(uint32_t ssrc) override {
+        std::lock_guard<std::mutex> lock(callbacks_mutex_);
+        sink_callbacks_.erase(ssrc);
+    }
+
+    void SetCallback(ShimOnEncodedVideoFrame callback, void* ctx) {
+        std::lock_guard<std::mutex> lock(mutex_);
+        callback_fn_ = callback;
+        ctx_ = ctx;
+    }
+
+    void SetQueue(ShimEventQueue* queue, uint64_t tag) {
+        events_.Attach(queue ? queue->ring : nullptr, tag);
+        std::lock_guard<std::mutex> lock(mutex_);
+        queued_ = queue != nullptr;
+    }
+
+    // True while the sink has somewhere to deliver frames.
+    bool Active() {
+        std::lock_guard<std::mutex> lock(mutex_);
+        return callback_fn_ || queued_;
+    }
+
+private:
+    void Deliver(const webrtc::TransformableVideoFrameInterface& frame) {
+        const ShimEncodedVideoFrameInfo info = FrameInfo(frame);
+        const auto data = frame.GetData();
+
+        ShimEvent header{};
+        header.type = SHIM_EVENT_ENCODED_VIDEO_FRAME;
+        header.value = static_cast<int>(data.size());
+        header.object = receiver_;
+        header.width = info.width;
+        header.height = info.height;
+        header.timestamp_us = info.receive_time_us;
+        std::vector<uint8_t> payload(sizeof(info) + data.size());
+        memcpy(payload.data(), &info, sizeof(info));
+        if (!data.empty()) {
+            memcpy(payload.data() + sizeof(info), data.data(), data.size());
+        }
+        if (events_.Emit(header, std::move(payload))) {
+            return;
+        }
+
+        ShimOnEncodedVideoFrame callback;
+        void* ctx;
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            callback = callback_fn_;
+            ctx = ctx_;
+        }
+        if (callback) {
+            callback(ctx, &info, data.data(), static_cast<int>(data.size()));
+        }
+    }
+
+    void* const receiver_;
+
+    // Replaces the callback while a queue is attached
+    shim::EventTarget events_;
+
+    std::mutex mutex_;  // guards the fields below
+    ShimOnEncodedVideoFrame callback_fn_ = nullptr;
+    void* ctx_ = nullptr;
+    bool queued_ = false;
+
+    // Where frames go back to libwebrtc, per SSRC
+    std::mutex callbacks_mutex_;
+    webrtc::scoped_refptr<webrtc::TransformedFrameCallback> callback_;
+    std::unordered_map<uint32_t, webrtc::scoped_refptr<webrtc::TransformedFrameCallback>> sink_callbacks_;
+};
+
+struct EncodedSinkEntry {
+    // Held so the receiver's address is not reused while it has an entry
+    webrtc::scoped_refptr<webrtc::RtpReceiverInterface> receiver;
+    webrtc::scoped_refptr<EncodedFrameSink> sink;
+};
+
+std::mutex g_encoded_sinks_mutex;
+std::unordered_map<webrtc::RtpReceiverInterface*, EncodedSinkEntry> g_encoded_sinks;
+
+// Find or install the receiver's sink and apply update to it. The entry is
+// dropped once the sink has neither a callback nor a queue; the transformer
+// stays installed and passes frames through.
+template <typename Update>
+int UpdateSink(ShimRTPReceiver* receiver, Update update) {
+    auto webrtc_receiver = reinterpret_cast<webrtc::RtpReceiverInterface*>(receiver);
+    if (webrtc_receiver->media_type() != webrtc::MediaType::VIDEO) {
+        return SHIM_ERROR_INVALID_PARAM;
+    }
+
+    std::lock_guard<std::mutex> lock(g_encoded_sinks_mutex);
+    auto it = g_encoded_sinks.find(webrtc_receiver);
+    if (it == g_encoded_sinks.end()) {
+        EncodedSinkEntry entry;
+        entry.receiver = webrtc::scoped_refptr<webrtc::RtpReceiverInterface>(webrtc_receiver);
+        entry.sink = webrtc::make_ref_counted<EncodedFrameSink>(receiver);
+        webrtc_receiver->SetFrameTransformer(entry.sink);
+        it = g_encoded_sinks.emplace(webrtc_receiver, std::move(entry)).first;
+    }
+
+    update(it->second.sink.get());
+    if (!it->second.sink->Active()) {
+        g_encoded_sinks.erase(it);
+    }
+    return SHIM_OK;
+}
+
+}  // namespace
+
+namespace shim {
+
+std::unique_ptr<webrtc::VideoDecoderFactory> CreateDiscardingDecoderFactory(
+    std::unique_ptr<webrtc::VideoDecoderFactory> factory) {
+    return std::make_unique<DiscardingVideoDecoderFactory>(std::move(factory));
+}
+
+}  // namespace shim
+
+/* ============================================================================
+ * C API Implementation
+ * ========================================================================== */
+
+extern "C" {
+
+SHIM_EXPORT int shim_rtp_receiver_set_on_encoded_frame(ShimRTPReceiverSetOnEncodedFrameParams* params) {
+    if (!params || !params->receiver) {
+        return SHIM_ERROR_INVALID_PARAM;
+    }
+    return UpdateSink(params->receiver, [params](EncodedFrameSink* sink) {
+        sink->SetCallback(params->callback, params->ctx);
+    });
+}
+
+SHIM_EXPORT int shim_rtp_receiver_set_encoded_frame_event_queue(
+    ShimRTPReceiverSetEncodedFrameEventQueueParams* params
+) {
+    if (!params || !params->receiver) {
+        return SHIM_ERROR_INVALID_PARAM;
+    }
+    return UpdateSink(params->receiver, [params](EncodedFrameSink* sink) {
+        sink->SetQueue(params->queue, params->tag);
+    });
+}
+
+}  // extern "C"
@@ -0,0 +1,1541 @@
+/*
+ * shim_encoded_source.cc - Pre-encoded video sources
+ *
+ * Sends video that is already encoded (by a camera, read from a file or
+ * received from another peer) without decoding and re-encoding it.
+ * libwebrtc's send pipeline always runs frames through an encoder, and frame
+ * transformers can only rewrite frames an encoder produced, so the bitstream
+ * is carried through the pipeline instead:
+ *
+ * - EncodedVideoTrackSource wraps each pushed frame in a native
+ *   VideoFrameBuffer (EncodedFrameBuffer) holding the encoded data.
+ * - Every PeerConnectionFactory wraps its encoder factory, so the encoders it
+ *   creates (PassthroughVideoEncoder) hand such buffers to the RTP stack as
+ *   they are, with the codec-specific info the packetizer needs. Raw frames
+ *   still go to the real encoder, which is released once a stream carries
+ *   encoded frames.
+ *
+ * Packetization, pacing, RTX/FEC and congestion control stay in libwebrtc.
+ * Keyframe requests (PLI/FIR, or a stream that must start with a keyframe)
+ * are passed to the producer through the source's callback. The encoders
+ * also report the requests they receive to RTCP feedback
+ * (shim_rtcp_feedback.cc), for raw and encoded frames alike.
+ *
+ * Each producer keeps its latest keyframe (KeyFrameCache), so a sender that
+ * starts mid-stream sends it at once instead of asking for a new one, and
+ * rate limits the keyframe requests it receives (KeyFrameRequester).
+ *
+ * A shared encoder (SharedVideoEncoder) is such a producer inside the shim:
+ * it encodes raw frames once and pushes the result to any number of encoded
+ * sources, its subscribers, so a stream sent to many PeerConnections costs
+ * one encode instead of one per sender.
+ */
+
+#include "shim_common.h"
+#include "shim_internal.h"
+
+#include <algorithm>
+#include <atomic>
+#include <cctype>
+#include <cstring>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <string>
+#include <unordered_set>
+#include <utility>
+#include <vector>
+
+#include "api/media_stream_interface.h"
+#include "api/peer_connection_interface.h"
+#include "api/rtp_sender_interface.h"
+#include "api/rtp_transceiver_interface.h"
+#include "api/video/builtin_video_bitrate_allocator_factory.h"
+#include "api/video/encoded_image.h"
+#include "api/video/i420_buffer.h"
+#include "api/video/recordable_encoded_frame.h"
+#include "api/video/video_bitrate_allocator.h"
+#include "api/video/video_frame.h"
+#include "api/video/video_frame_buffer.h"
+#include "api/video_codecs/builtin_video_encoder_factory.h"
+#include "api/video_codecs/scalability_mode.h"
+#include "api/video_codecs/video_codec.h"
+#include "api/video_codecs/video_encoder.h"
+#include "api/video_codecs/video_encoder_factory.h"
+#include "media/engine/internal_encoder_factory.h"
+#include "modules/video_coding/codecs/interface/common_constants.h"
+#include "modules/video_coding/include/video_codec_interface.h"
+#include "modules/video_coding/include/video_error_codes.h"
+#include "rtc_base/time_utils.h"
+
+namespace {
+
+// Minimum time between keyframe requests while waiting for a keyframe,
+// and the default minimum time between requests reaching a producer.
+constexpr int64_t kKeyFrameRequestIntervalMs = 500;
+
+// Minimum time between requests reaching a producer configured as
+// min_keyframe_interval_ms.
+int64_t KeyFrameRequestInterval(int min_keyframe_interval_ms) {
+    return min_keyframe_interval_ms > 0 ? min_keyframe_interval_ms : kKeyFrameRequestIntervalMs;
+}
+
+// Highest temporal layer id a pushed frame may carry.
+constexpr int kMaxTemporalLayer = 7;
+
+// The producer's keyframe request callback. Shared by a source and the
+// frames it pushed, so encoders can still reach it while frames are queued.
+//
+// Requests within min_interval_ms of the last forwarded request or keyframe
+// are merged into one, forwarded by the first frame pushed after the
+// interval unless that frame is a keyframe. An interval of 0 forwards every
+// request.
+class KeyFrameRequester {
+public:
+    // on_request runs on every forwarded request, before the callback.
+    explicit KeyFrameRequester(int64_t min_interval_ms, std::function<void()> on_request = nullptr)
+        : min_interval_ms_(min_interval_ms), on_request_(std::move(on_request)) {}
+
+    void SetCallback(ShimOnKeyFrameRequest callback, void* ctx) {
+        std::lock_guard<std::mutex> lock(mutex_);
+        callback_ = callback;
+        ctx_ = ctx;
+    }
+
+    void Request() {
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            const int64_t now_ms = webrtc::TimeMillis();
+            if (min_interval_ms_ > 0 && last_ms_ && now_ms - *last_ms_ < min_interval_ms_) {
+                deferred_ = true;
+                return;
+            }
+            last_ms_ = now_ms;
+            deferred_ = false;
+        }
+        Forward();
+    }
+
+    // Called for every frame the producer pushes.
+    void OnFrame(bool keyframe) {
+        if (min_interval_ms_ <= 0) {
+            return;
+        }
+        bool forward = false;
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            const int64_t now_ms = webrtc::TimeMillis();
+            if (keyframe) {
+                last_ms_ = now_ms;
+                deferred_ = false;
+            } else if (deferred_ && now_ms - *last_ms_ >= min_interval_ms_) {
+                last_ms_ = now_ms;
+                deferred_ = false;
+                forward = true;
+            }
+        }
+        if (forward) {
+            Forward();
+        }
+    }
+
+private:
+    void Forward() {
+        if (on_request_) {
+            on_request_();
+        }
+        ShimOnKeyFrameRequest callback;
+        void* ctx;
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            callback = callback_;
+            ctx = ctx_;
+        }
+        if (callback) {
+            callback(ctx);
+        }
+    }
+
+    const int64_t min_interval_ms_;
+    const std::function<void()> on_request_;
+    std::mutex mutex_;  // guards the fields below
+    ShimOnKeyFrameRequest callback_ = nullptr;
+    void* ctx_ = nullptr;
+    std::optional<int64_t> last_ms_;
+    bool deferred_ = false;
+};
+
+class KeyFrameCache;
+
+// An encoded frame travelling through the video pipeline as a native buffer.
+// libwebrtc is built without RTTI, so live buffers are kept in a registry to
+// tell them apart from other native buffers.
+class EncodedFrameBuffer : public webrtc::VideoFrameBuffer {
+public:
+    EncodedFrameBuffer(webrtc::scoped_refptr<webrtc::EncodedImageBuffer> data,
+                       webrtc::VideoCodecType codec, int width, int height,
+                       bool keyframe, int temporal_id,
+                       std::shared_ptr<KeyFrameRequester> requester,
+                       std::shared_ptr<KeyFrameCache> cache,
+                       std::shared_ptr<const webrtc::CodecSpecificInfo> codec_specific = nullptr,
+                       uint64_t sequence = 0)
+        : data_(std::move(data)), codec_(codec), width_(width), height_(height),
+          keyframe_(keyframe), temporal_id_(temporal_id), requester_(std::move(requester)),
+          cache_(std::move(cache)), codec_specific_(std::move(codec_specific)), sequence_(sequence) {
+        std::lock_guard<std::mutex> lock(RegistryMutex());
+        Registry().insert(this);
+    }
+
+    ~EncodedFrameBuffer() override {
+        std::lock_guard<std::mutex> lock(RegistryMutex());
+        Registry().erase(this);
+    }
+
+    // Returns buffer as an EncodedFrameBuffer, or nullptr if it is not one.
+    static const EncodedFrameBuffer* From(const webrtc::VideoFrameBuffer* buffer) {
+        if (!buffer || buffer->type() != Type::kNative) {
+            return nullptr;
+        }
+        std::lock_guard<std::mutex> lock(RegistryMutex());
+        if (Registry().count(buffer) == 0) {
+            return nullptr;
+        }
+        return static_cast<const EncodedFrameBuffer*>(buffer);
+    }
+
+    Type type() const override { return Type::kNative; }
+    int width() const override { return width_; }
+    int height() const override { return height_; }
+
+    // The bitstream cannot be converted; passthrough encoders never ask.
+    webrtc::scoped_refptr<webrtc::I420BufferInterface> ToI420() override { return nullptr; }
+
+    // Scaling would need a re-encode, so the frame is passed on whole.
+    webrtc::scoped_refptr<webrtc::VideoFrameBuffer> CropAndScale(
+        int, int, int, int, int, int) override {
+        return webrtc::scoped_refptr<webrtc::VideoFrameBuffer>(this);
+    }
+
+    const webrtc::scoped_refptr<webrtc::EncodedImageBuffer>& data() const { return data_; }
+    webrtc::VideoCodecType codec() const { return codec_; }
+    bool keyframe() const { return keyframe_; }
+    int temporal_id() const { return temporal_id_; }
+    // Position in the stream of the source that pushed the frame, without
+    // gaps unless a frame was lost on the way to the encoder.
+    uint64_t sequence() const { return sequence_; }
+    // The info the encoder produced the frame with, generic frame info
+    // included, or nullptr for frames pushed from outside the shim.
+    const webrtc::CodecSpecificInfo* codec_specific() const { return codec_specific_.get(); }
+    void RequestKeyFrame() const { requester_->Request(); }
+
+    // The producer's latest keyframe, or nullptr.
+    webrtc::scoped_refptr<EncodedFrameBuffer> CachedKeyFrame() const;
+
+    // A copy without the cache, sharing the data, to be kept by the cache.
+    webrtc::scoped_refptr<EncodedFrameBuffer> WithData(
+        webrtc::scoped_refptr<webrtc::EncodedImageBuffer> data) const {
+        return webrtc::make_ref_counted<EncodedFrameBuffer>(
+            std::move(data), codec_, width_, height_, keyframe_, temporal_id_, requester_, nullptr,
+            codec_specific_);
+    }
+
+    // A copy sharing the data, numbered by the source pushing it.
+    webrtc::scoped_refptr<EncodedFrameBuffer> WithSequence(uint64_t sequence) const {
+        return webrtc::make_ref_counted<EncodedFrameBuffer>(
+            data_, codec_, width_, height_, keyframe_, temporal_id_, requester_, cache_,
+            codec_specific_, sequence);
+    }
+
+private:
+    static std::mutex& RegistryMutex() {
+        static std::mutex mutex;
+        return mutex;
+    }
+    static std::unordered_set<const webrtc::VideoFrameBuffer*>& Registry() {
+        static std::unordered_set<const webrtc::VideoFrameBuffer*> registry;
+        return registry;
+    }
+
+    const webrtc::scoped_refptr<webrtc::EncodedImageBuffer> data_;
+    const webrtc::VideoCodecType codec_;
+    const int width_;
+    const int height_;
+    const bool keyframe_;
+    const int temporal_id_;
+    const std::shared_ptr<KeyFrameRequester> requester_;
+    const std::shared_ptr<KeyFrameCache> cache_;
+    const std::shared_ptr<const webrtc::CodecSpecificInfo> codec_specific_;
+    const uint64_t sequence_;
+};
+
+/* ============================================================================
+ * Keyframe cache
+ * ========================================================================== */
+
+constexpr uint8_t kAnnexBStartCode[] = {0, 0, 0, 1};
+
+// Calls visit(type, nalu) for each H.264 NAL unit (header included, start
+// code excluded) up to the first slice, where parameter sets end.
+template <typename Visit>
+void ForEachH264LeadingNalu(const uint8_t* data, size_t size, Visit visit) {
+    auto next_start = [&](size_t from) {
+        for (size_t i = from; i + 3 <= size; i++) {
+            if (data[i] == 0 && data[i + 1] == 0 && data[i + 2] == 1) {
+                return i;
+            }
+        }
+        return size;
+    };
+    size_t start = next_start(0);
+    while (start < size) {
+        const size_t nalu = start + 3;
+        size_t end = next_start(nalu);
+        const size_t next = end;
+        // The zero of a four byte start code belongs to the next start code.
+        while (end > nalu && data[end - 1] == 0) {
+            end--;
+        }
+        if (end > nalu) {
+            const uint8_t type = data[nalu] & 0x1F;
+            visit(type, data + nalu, end - nalu);
+            if (type >= 1 && type <= 5) {
+                return;
+            }
+        }
+        start = next;
+    }
+}
+
+// Reads an OBU header and size. Returns false on a truncated OBU.
+bool ParseObu(const uint8_t* data, size_t size, uint8_t* type, size_t* obu_size) {
+    if (size == 0) {
+        return false;
+    }
+    *type = (data[0] >> 3) & 0x0F;
+    size_t header = (data[0] & 0x04) ? 2 : 1;
+    if (!(data[0] & 0x02)) {
+        // Without a size field the OBU runs to the end of the frame.
+        *obu_size = size;
+        return header <= size;
+    }
+    uint64_t payload = 0;
+    for (int i = 0; i < 8; i++) {
+        if (header >= size) {
+            return false;
+        }
+        const uint8_t byte = data[header++];
+        payload |= static_cast<uint64_t>(byte & 0x7F) << (7 * i);
+        if (!(byte & 0x80)) {
+            break;
+        }
+    }
+    if (payload > size - header) {
+        return false;
+    }
+    *obu_size = header + static_cast<size_t>(payload);
+    return true;
+}
+
+constexpr uint8_t kObuSequenceHeader = 1;
+constexpr uint8_t kObuTemporalDelimiter = 2;
+constexpr uint8_t kObuFrameHeader = 3;
+constexpr uint8_t kObuFrame = 6;
+
+// Latest keyframe of a producer, with the parameter sets it needs to be
+// decoded on its own. Shared by the producer's sources and frames.
+class KeyFrameCache {
+public:
+    // Record the parameter sets of a pushed frame and keep it if it is a
+    // keyframe. Only the first NAL units or OBUs of a frame are read.
+    void Update(const EncodedFrameBuffer& frame) {
+        const auto& data = frame.data();
+        switch (frame.codec()) {
+            case webrtc::kVideoCodecH264:
+                UpdateH264(frame, data->data(), data->size());
+                break;
+            case webrtc::kVideoCodecAV1:
+                UpdateAv1(frame, data->data(), data->size());
+                break;
+            default:
+                if (frame.keyframe()) {
+                    Store(frame.WithData(data));
+                }
+                break;
+        }
+    }
+
+    webrtc::scoped_refptr<EncodedFrameBuffer> Get() {
+        std::lock_guard<std::mutex> lock(mutex_);
+        return keyframe_;
+    }
+
+private:
+    void Store(webrtc::scoped_refptr<EncodedFrameBuffer> keyframe) {
+        std::lock_guard<std::mutex> lock(mutex_);
+        keyframe_ = std::move(keyframe);
+    }
+
+    void UpdateH264(const EncodedFrameBuffer& frame, const uint8_t* data, size_t size) {
+        bool has_sps = false;
+        bool has_pps = false;
+        ForEachH264LeadingNalu(data, size, [&](uint8_t type, const uint8_t* nalu, size_t nalu_size) {
+            if (type == 7) {
+                has_sps = true;
+                std::lock_guard<std::mutex> lock(mutex_);
+                sps_.assign(nalu, nalu + nalu_size);
+            } else if (type == 8) {
+                has_pps = true;
+                std::lock_guard<std::mutex> lock(mutex_);
+                pps_.assign(nalu, nalu + nalu_size);
+            }
+        });
+        if (!frame.keyframe()) {
+            return;
+        }
+
+        std::vector<uint8_t> prefix;
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            if (!has_sps && !sps_.empty()) {
+                prefix.insert(prefix.end(), std::begin(kAnnexBStartCode), std::end(kAnnexBStartCode));
+                prefix.insert(prefix.end(), sps_.begin(), sps_.end());
+            }
+            if (!has_pps && !pps_.empty()) {
+                prefix.insert(prefix.end(), std::begin(kAnnexBStartCode), std::end(kAnnexBStartCode));
+                prefix.insert(prefix.end(), pps_.begin(), pps_.end());
+            }
+        }
+        Store(frame.WithData(Insert(frame.data(), 0, prefix)));
+    }
+
+    void UpdateAv1(const EncodedFrameBuffer& frame, const uint8_t* data, size_t size) {
+        bool has_sequence_header = false;
+        size_t insert_at = 0;
+        size_t offset = 0;
+        uint8_t type;
+        size_t obu_size;
+        while (offset < size && ParseObu(data + offset, size - offset, &type, &obu_size)) {
+            if (type == kObuFrameHeader || type == kObuFrame) {
+                break;
+            }
+            // A sequence header is reused elsewhere only if it has a size field.
+            if (type == kObuSequenceHeader && (data[offset] & 0x02)) {
+                has_sequence_header = true;
+                std::lock_guard<std::mutex> lock(mutex_);
+                sequence_header_.assign(data + offset, data + offset + obu_size);
+            } else if (type == kObuTemporalDelimiter && offset == 0) {
+                insert_at = obu_size;
+            }
+            offset += obu_size;
+        }
+        if (!frame.keyframe()) {
+            return;
+        }
+
+        std::vector<uint8_t> prefix;
+        if (!has_sequence_header) {
+            std::lock_guard<std::mutex> lock(mutex_);
+            prefix = sequence_header_;
+        }
+        Store(frame.WithData(Insert(frame.data(), insert_at, prefix)));
+    }
+
+    // data with bytes inserted at offset; data itself if there are none.
+    static webrtc::scoped_refptr<webrtc::EncodedImageBuffer> Insert(
+        const webrtc::scoped_refptr<webrtc::EncodedImageBuffer>& data, size_t offset,
+        const std::vector<uint8_t>& bytes) {
+        if (bytes.empty()) {
+            return data;
+        }
+        auto result = webrtc::EncodedImageBuffer::Create(data->size() + bytes.size());
+        memcpy(result->data(), data->data(), offset);
+        memcpy(result->data() + offset, bytes.data(), bytes.size());
+        memcpy(result->data() + offset + bytes.size(), data->data() + offset, data->size() - offset);
+        return result;
+    }
+
+    std::mutex mutex_;  // guards the fields below
+    webrtc::scoped_refptr<EncodedFrameBuffer> keyframe_;
+    std::vector<uint8_t> sps_;
+    std::vector<uint8_t> pps_;
+    std::vector<uint8_t> sequence_header_;
+};
+
+webrtc::scoped_refptr<EncodedFrameBuffer> EncodedFrameBuffer::CachedKeyFrame() const {
+    return cache_ ? cache_->Get() : nullptr;
+}
+
+// Video track source that delivers pushed encoded frames to its sinks.
+class EncodedVideoTrackSource : public webrtc::VideoTrackSourceInterface {
+public:
+    EncodedVideoTrackSource(int width, int height, std::shared_ptr<KeyFrameRequester> requester)
+        : width_(width), height_(height), requester_(std::move(requester)) {}
+
+    ~EncodedVideoTrackSource() override { shim::ReleaseVideoSourceId(id_); }
+
+    // Carried by the source's frames; see shim::AcquireVideoSourceId.
+    uint16_t id() const { return id_; }
+
+    // VideoTrackSourceInterface
+    bool is_screencast() const override { return false; }
+    std::optional<bool> needs_denoising() const override { return std::nullopt; }
+
+    bool GetStats(Stats* stats) override {
+        if (!stats) return false;
+        stats->input_width = width_;
+        stats->input_height = height_;
+        return true;
+    }
+
+    // MediaSourceInterface
+    SourceState state() const override { return kLive; }
+    bool remote() const override { return false; }
+
+    // NotifierInterface
+    void RegisterObserver(webrtc::ObserverInterface* observer) override {
+        std::lock_guard<std::mutex> lock(mutex_);
+        observers_.push_back(observer);
+    }
+
+    void UnregisterObserver(webrtc::ObserverInterface* observer) override {
+        std::lock_guard<std::mutex> lock(mutex_);
+        observers_.erase(
+            std::remove(observers_.begin(), observers_.end(), observer),
+            observers_.end()
+        );
+    }
+
+    // webrtc::VideoSourceInterface<VideoFrame>
+    void AddOrUpdateSink(webrtc::VideoSinkInterface<webrtc::VideoFrame>* sink,
+                         const webrtc::VideoSinkWants& wants) override {
+        std::lock_guard<std::mutex> lock(mutex_);
+        if (std::find(sinks_.begin(), sinks_.end(), sink) == sinks_.end()) {
+            sinks_.push_back(sink);
+        }
+    }
+
+    void RemoveSink(webrtc::VideoSinkInterface<webrtc::VideoFrame>* sink) override {
+        std::lock_guard<std::mutex> lock(mutex_);
+        sinks_.erase(
+            std::remove(sinks_.begin(), sinks_.end(), sink),
+            sinks_.end()
+        );
+    }
+
+    bool SupportsEncodedOutput() const override { return false; }
+    void GenerateKeyFrame() override { requester_->Request(); }
+    void AddEncodedSink(webrtc::VideoSinkInterface<webrtc::RecordableEncodedFrame>*) override {}
+    void RemoveEncodedSink(webrtc::VideoSinkInterface<webrtc::RecordableEncodedFrame>*) override {}
+
+    // Dropping layers takes effect at once. Adding layers waits for a
+    // keyframe, since their frames may reference frames that were dropped.
+    void SetMaxTemporalLayer(int layer) {
+        bool request = false;
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            if (layer <= max_temporal_layer_) {
+                max_temporal_layer_ = layer;
+                pending_max_temporal_layer_.reset();
+            } else {
+                pending_max_temporal_layer_ = layer;
+                request = true;
+            }
+        }
+        if (request) {
+            requester_->Request();
+        }
+    }
+
+    // Frames are numbered after the temporal layer filter, so the encoder
+    // can tell frames lost on the way from layers dropped on purpose.
+    // timestamp_us of 0 stamps the frame with the current time.
+    void PushFrame(const EncodedFrameBuffer& buffer, int64_t timestamp_us = 0) {
+        if (timestamp_us == 0) {
+            timestamp_us = webrtc::TimeMicros();
+        }
+
+        std::lock_guard<std::mutex> lock(mutex_);
+        if (pending_max_temporal_layer_ && buffer.keyframe()) {
+            max_temporal_layer_ = *pending_max_temporal_layer_;
+            pending_max_temporal_layer_.reset();
+        }
+        if (buffer.temporal_id() > max_temporal_layer_) {
+            return;
+        }
+        webrtc::VideoFrame frame = webrtc::VideoFrame::Builder()
+            .set_video_frame_buffer(buffer.WithSequence(next_sequence_++))
+            .set_timestamp_us(timestamp_us)
+            .set_timestamp_rtp(static_cast<uint32_t>(timestamp_us * 90 / 1000))
+            .set_rotation(webrtc::kVideoRotation_0)
+            .set_id(id_)
+            .build();
+        for (auto* sink : sinks_) {
+            sink->OnFrame(frame);
+        }
+    }
+
+private:
+    const int width_;
+    const int height_;
+    const std::shared_ptr<KeyFrameRequester> requester_;
+    const uint16_t id_ = shim::AcquireVideoSourceId();
+    std::mutex mutex_;
+    std::vector<webrtc::ObserverInterface*> observers_;
+    std::vector<webrtc::VideoSinkInterface<webrtc::VideoFrame>*> sinks_;
+    int max_temporal_layer_ = kMaxTemporalLayer;
+    std::optional<int> pending_max_temporal_layer_;
+    uint64_t next_sequence_ = 0;
+};
+
+// Encoder that sends frames of encoded sources as they are and hands raw
+// frames to the real encoder. The real encoder is created up front so its
+// info drives the stream configuration, dropped when the first encoded frame
+// arrives and recreated if raw frames follow.
+class PassthroughVideoEncoder : public webrtc::VideoEncoder {
+public:
+    PassthroughVideoEncoder(const webrtc::Environment& env,
+                            webrtc::VideoEncoderFactory* factory,
+                            webrtc::SdpVideoFormat format,
+                            std::unique_ptr<webrtc::VideoEncoder> encoder)
+        : env_(env), factory_(factory), format_(std::move(format)), encoder_(std::move(encoder)) {}
+
+    void SetFecControllerOverride(webrtc::FecControllerOverride* fec_controller_override) override {
+        fec_controller_override_ = fec_controller_override;
+        if (encoder_) {
+            encoder_->SetFecControllerOverride(fec_controller_override);
+        }
+    }
+
+    int InitEncode(const webrtc::VideoCodec* codec_settings, const Settings& settings) override {
+        if (!codec_settings) {
+            return WEBRTC_VIDEO_CODEC_ERR_PARAMETER;
+        }
+        codec_settings_ = *codec_settings;
+        settings_ = settings;
+        started_ = false;
+        return encoder_ ? encoder_->InitEncode(codec_settings, settings) : WEBRTC_VIDEO_CODEC_OK;
+    }
+
+    int32_t RegisterEncodeCompleteCallback(webrtc::EncodedImageCallback* callback) override {
+        callback_ = callback;
+        return encoder_ ? encoder_->RegisterEncodeCompleteCallback(callback) : WEBRTC_VIDEO_CODEC_OK;
+    }
+
+    int32_t Release() override {
+        settings_.reset();
+        return encoder_ ? encoder_->Release() : WEBRTC_VIDEO_CODEC_OK;
+    }
+
+    int32_t Encode(const webrtc::VideoFrame& frame,
+                   const std::vector<webrtc::VideoFrameType>* frame_types) override {
+        ReportKeyFrameRequests(frame, frame_types);
+        const EncodedFrameBuffer* encoded = EncodedFrameBuffer::From(frame.video_frame_buffer().get());
+        if (encoded) {
+            return SendEncoded(frame, *encoded, frame_types);
+        }
+        return EncodeRaw(frame, frame_types);
+    }
+
+    void SetRates(const RateControlParameters& parameters) override {
+        rates_ = parameters;
+        if (encoder_) {
+            encoder_->SetRates(parameters);
+        }
+    }
+
+    void OnPacketLossRateUpdate(float packet_loss_rate) override {
+        if (encoder_) encoder_->OnPacketLossRateUpdate(packet_loss_rate);
+    }
+
+    void OnRttUpdate(int64_t rtt_ms) override {
+        if (encoder_) encoder_->OnRttUpdate(rtt_ms);
+    }
+
+    void OnLossNotification(const LossNotification& loss_notification) override {
+        if (encoder_) encoder_->OnLossNotification(loss_notification);
+    }
+
+    EncoderInfo GetEncoderInfo() const override {
+        EncoderInfo info;
+        if (encoder_) {
+            info = encoder_->GetEncoderInfo();
+        } else {
+            info.implementation_name = "PassthroughEncoder";
+            info.has_trusted_rate_controller = true;
+            info.scaling_settings = ScalingSettings::kOff;
+        }
+        // Encoded frames arrive as native buffers and must not be converted.
+        info.supports_native_handle = true;
+        return info;
+    }
+
+private:
+    // Report keyframe requests to RTCP feedback, except the one the stream
+    // starts with after InitEncode.
+    void ReportKeyFrameRequests(const webrtc::VideoFrame& frame,
+                                const std::vector<webrtc::VideoFrameType>* frame_types) {
+        const bool started = started_;
+        started_ = true;
+        if (!started || !frame_types || frame.id() == webrtc::VideoFrame::kNotSetId) {
+            return;
+        }
+        uint32_t streams = 0;
+        for (size_t i = 0; i < frame_types->size() && i < 32; ++i) {
+            if ((*frame_types)[i] == webrtc::VideoFrameType::kVideoFrameKey) {
+                streams |= 1u << i;
+            }
+        }
+        shim::OnKeyFrameRequest(frame.id(), streams);
+    }
+
+    int32_t SendEncoded(const webrtc::VideoFrame& frame, const EncodedFrameBuffer& encoded,
+                        const std::vector<webrtc::VideoFrameType>* frame_types) {
+        if (encoder_) {
+            encoder_->Release();
+            encoder_.reset();
+        }
+        if (!callback_ || !settings_) {
+            return WEBRTC_VIDEO_CODEC_UNINITIALIZED;
+        }
+        if (encoded.codec() != codec_settings_.codecType) {
+            // The PeerConnection negotiated another codec than the bitstream's.
+            return WEBRTC_VIDEO_CODEC_ERROR;
+        }
+        if (frame.id() != source_id_) {
+            // A replaced track: the new source's deltas reference frames
+            // that were never sent.
+            source_id_ = frame.id();
+            sent_keyframe_ = false;
+            primed_ = false;
+            lost_frame_ = false;
+        } else if (encoded.sequence() != last_sequence_ + 1) {
+            // A frame was dropped on the way here (e.g. the encoder queue was
+            // full) and the deltas that follow may reference it.
+            lost_frame_ = true;
+        }
+        last_sequence_ = encoded.sequence();
+
+        const bool keyframe = encoded.keyframe();
+        // A primed stream waits for the producer's next keyframe rather than
+        // ask for one, so senders joining mid-stream cost no extra keyframe.
+        const bool keyframe_wanted = !sent_keyframe_ || lost_frame_ || (frame_types &&
+            std::find(frame_types->begin(), frame_types->end(),
+                      webrtc::VideoFrameType::kVideoFrameKey) != frame_types->end());
+        if (keyframe) {
+            sent_keyframe_ = true;
+            primed_ = false;
+            lost_frame_ = false;
+            last_keyframe_request_ms_.reset();
+        } else if (keyframe_wanted) {
+            // Coalesce requests until the producer's keyframe arrives.
+            const int64_t now_ms = webrtc::TimeMillis();
+            if (!last_keyframe_request_ms_ ||
+                now_ms - *last_keyframe_request_ms_ >= kKeyFrameRequestIntervalMs) {
+                last_keyframe_request_ms_ = now_ms;
+                encoded.RequestKeyFrame();
+            }
+        }
+        if (!sent_keyframe_) {
+            // Nothing is decodable before the first keyframe. Start with the
+            // producer's latest one rather than wait for the next; the deltas
+            // that follow it were never sent, so its picture is held until a
+            // new keyframe arrives.
+            auto cached = encoded.CachedKeyFrame();
+            if (!cached || cached->codec() != codec_settings_.codecType) {
+                return WEBRTC_VIDEO_CODEC_OK;
+            }
+            sent_keyframe_ = true;
+            primed_ = true;
+            return Send(frame, *cached);
+        }
+        if (primed_ || lost_frame_) {
+            return WEBRTC_VIDEO_CODEC_OK;
+        }
+        return Send(frame, encoded);
+    }
+
+    int32_t Send(const webrtc::VideoFrame& frame, const EncodedFrameBuffer& encoded) {
+        const bool keyframe = encoded.keyframe();
+        webrtc::EncodedImage image;
+        image.SetEncodedData(encoded.data());
+        image.SetRtpTimestamp(frame.rtp_timestamp());
+        image.capture_time_ms_ = frame.render_time_ms();
+        image.ntp_time_ms_ = frame.ntp_time_ms();
+        image.rotation_ = frame.rotation();
+        image._frameType = keyframe ? webrtc::VideoFrameType::kVideoFrameKey
+                                    : webrtc::VideoFrameType::kVideoFrameDelta;
+        image._encodedWidth = encoded.width();
+        image._encodedHeight = encoded.height();
+        if (encoded.temporal_id() >= 0) {
+            image.SetTemporalIndex(encoded.temporal_id());
+        }
+
+        webrtc::CodecSpecificInfo info = encoded.codec_specific()
+            ? ForwardedCodecSpecific(*encoded.codec_specific())
+            : CodecSpecific(encoded);
+        auto result = callback_->OnEncodedImage(image, &info);
+        if (result.error != webrtc::EncodedImageCallback::Result::OK) {
+            return WEBRTC_VIDEO_CODEC_ERROR;
+        }
+        return WEBRTC_VIDEO_CODEC_OK;
+    }
+
+    // The producing encoder's info, with the packetization mode this stream
+    // negotiated.
+    webrtc::CodecSpecificInfo ForwardedCodecSpecific(const webrtc::CodecSpecificInfo& produced) const {
+        webrtc::CodecSpecificInfo info = produced;
+        if (info.codecType == webrtc::kVideoCodecH264) {
+            info.codecSpecific.H264.packetization_mode = PacketizationMode();
+        }
+        return info;
+    }
+
+    webrtc::H264PacketizationMode PacketizationMode() const {
+        auto it = format_.parameters.find("packetization-mode");
+        return (it != format_.parameters.end() && it->second == "0")
+            ? webrtc::H264PacketizationMode::SingleNalUnit
+            : webrtc::H264PacketizationMode::NonInterleaved;
+    }
+
+    // Codec-specific info for a single-layer stream pushed from outside the
+    // shim, as the packetizer needs it. Every VP9 delta is taken to reference
+    // the frame before it, which only holds without temporal layers.
+    webrtc::CodecSpecificInfo CodecSpecific(const EncodedFrameBuffer& encoded) const {
+        const bool keyframe = encoded.keyframe();
+        const uint8_t temporal_idx = encoded.temporal_id() >= 0
+            ? static_cast<uint8_t>(encoded.temporal_id())
+            : webrtc::kNoTemporalIdx;
+
+        webrtc::CodecSpecificInfo info;
+        info.codecType = encoded.codec();
+        info.end_of_picture = true;
+        switch (encoded.codec()) {
+            case webrtc::kVideoCodecVP8:
+                info.codecSpecific.VP8.nonReference = false;
+                info.codecSpecific.VP8.temporalIdx = temporal_idx;
+                info.codecSpecific.VP8.layerSync = false;
+                info.codecSpecific.VP8.keyIdx = webrtc::kNoKeyIdx;
+                break;
+            case webrtc::kVideoCodecVP9: {
+                auto& vp9 = info.codecSpecific.VP9;
+                vp9.first_frame_in_picture = true;
+                vp9.inter_pic_predicted = !keyframe;
+                vp9.flexible_mode = true;
+                vp9.non_ref_for_inter_layer_pred = true;
+                vp9.temporal_idx = temporal_idx;
+                vp9.num_spatial_layers = 1;
+                vp9.first_active_layer = 0;
+                vp9.ss_data_available = keyframe;
+                vp9.spatial_layer_resolution_present = keyframe;
+                vp9.width[0] = encoded.width();
+                vp9.height[0] = encoded.height();
+                // Each delta frame references the previous frame.
+                vp9.num_ref_pics = keyframe ? 0 : 1;
+                vp9.p_diff[0] = 1;
+                break;
+            }
+            case webrtc::kVideoCodecH264: {
+                info.codecSpecific.H264.packetization_mode = PacketizationMode();
+                info.codecSpecific.H264.temporal_idx = temporal_idx;
+                info.codecSpecific.H264.base_layer_sync = false;
+                info.codecSpecific.H264.idr_frame = keyframe;
+                break;
+            }
+            default:
+                break;
+        }
+        return info;
+    }
+
+    int32_t EncodeRaw(const webrtc::VideoFrame& frame,
+                      const std::vector<webrtc::VideoFrameType>* frame_types) {
+        if (!encoder_ && !CreateEncoder()) {
+            return WEBRTC_VIDEO_CODEC_ERROR;
+        }
+        // Native handle support is always advertised for encoded frames; map
+        // other native buffers for encoders that cannot take them.
+        if (frame.video_frame_buffer()->type() == webrtc::VideoFrameBuffer::Type::kNative &&
+            !encoder_->GetEncoderInfo().supports_native_handle) {
+            auto i420 = frame.video_frame_buffer()->ToI420();
+            if (!i420) {
+                return WEBRTC_VIDEO_CODEC_ERROR;
+            }
+            webrtc::VideoFrame mapped = frame;
+            mapped.set_video_frame_buffer(i420);
+            return encoder_->Encode(mapped, frame_types);
+        }
+        return encoder_->Encode(frame, frame_types);
+    }
+
+    // Recreate the real encoder after encoded frames replaced it.
+    bool CreateEncoder() {
+        if (!settings_) {
+            return false;
+        }
+        auto encoder = factory_->Create(env_, format_);
+        if (!encoder) {
+            return false;
+        }
+        encoder->SetFecControllerOverride(fec_controller_override_);
+        if (callback_) {
+            encoder->RegisterEncodeCompleteCallback(callback_);
+        }
+        if (encoder->InitEncode(&codec_settings_, *settings_) != WEBRTC_VIDEO_CODEC_OK) {
+            return false;
+        }
+        if (rates_) {
+            encoder->SetRates(*rates_);
+        }
+        encoder_ = std::move(encoder);
+        sent_keyframe_ = false;
+        primed_ = false;
+        lost_frame_ = false;
+        return true;
+    }
+
+    const webrtc::Environment env_;
+    webrtc::VideoEncoderFactory* const factory_;
+    const webrtc::SdpVideoFormat format_;
+    std::unique_ptr<webrtc::VideoEncoder> encoder_;
+
+    webrtc::VideoCodec codec_settings_;
+    std::optional<Settings> settings_;
+    std::optional<RateControlParameters> rates_;
+    webrtc::EncodedImageCallback* callback_ = nullptr;
+    webrtc::FecControllerOverride* fec_controller_override_ = nullptr;
+
+    bool started_ = false;  // Encoded a frame since InitEncode
+    bool sent_keyframe_ = false;
+    bool primed_ = false;  // Sent a cached keyframe, waiting for a live one
+    bool lost_frame_ = false;  // Dropping deltas after a gap until a keyframe
+    uint16_t source_id_ = webrtc::VideoFrame::kNotSetId;
+    uint64_t last_sequence_ = 0;
+    std::optional<int64_t> last_keyframe_request_ms_;
+};
+
+class PassthroughVideoEncoderFactory : public webrtc::VideoEncoderFactory {
+public:
+    explicit PassthroughVideoEncoderFactory(std::unique_ptr<webrtc::VideoEncoderFactory> factory)
+        : factory_(std::move(factory)) {}
+
+    std::vector<webrtc::SdpVideoFormat> GetSupportedFormats() const override {
+        return factory_->GetSupportedFormats();
+    }
+
+    std::vector<webrtc::SdpVideoFormat> GetImplementations() const override {
+        return factory_->GetImplementations();
+    }
+
+    CodecSupport QueryCodecSupport(const webrtc::SdpVideoFormat& format,
+                                   std::optional<std::string> scalability_mode) const override {
+        return factory_->QueryCodecSupport(format, std::move(scalability_mode));
+    }
+
+    std::unique_ptr<webrtc::VideoEncoder> Create(const webrtc::Environment& env,
+                                                 const webrtc::SdpVideoFormat& format) override {
+        auto encoder = factory_->Create(env, format);
+        if (!encoder) {
+            return nullptr;
+        }
+        return std::make_unique<PassthroughVideoEncoder>(env, factory_.get(), format, std::move(encoder));
+    }
+
+    std::unique_ptr<EncoderSelectorInterface> GetEncoderSelector() const override {
+        return factory_->GetEncoderSelector();
+    }
+
+private:
+    std::unique_ptr<webrtc::VideoEncoderFactory> factory_;
+};
+
+bool SameCodecName(const std::string& a, const std::string& b) {
+    return a.size() == b.size() &&
+           std::equal(a.begin(), a.end(), b.begin(), [](unsigned char x, unsigned char y) {
+               return std::tolower(x) == std::tolower(y);
+           });
+}
+
+// Limit the transceiver to codec, keeping the resilience codecs, since only
+// the source's own codec can be sent without re-encoding.
+webrtc::RTCError PreferCodec(webrtc::PeerConnectionFactoryInterface* factory,
+                             webrtc::RtpTransceiverInterface* transceiver,
+                             webrtc::VideoCodecType codec) {
+    const std::string name = webrtc::CodecTypeToPayloadString(codec);
+    auto capabilities = factory->GetRtpSenderCapabilities(webrtc::MediaType::VIDEO);
+
+    std::vector<webrtc::RtpCodecCapability> preferred;
+    bool found = false;
+    for (const auto& capability : capabilities.codecs) {
+        if (SameCodecName(capability.name, name)) {
+            preferred.push_back(capability);
+            found = true;
+        } else if (SameCodecName(capability.name, "rtx") || SameCodecName(capability.name, "red") ||
+                   SameCodecName(capability.name, "ulpfec") || SameCodecName(capability.name, "flexfec-03")) {
+            preferred.push_back(capability);
+        }
+    }
+    if (!found) {
+        return webrtc::RTCError(webrtc::RTCErrorType::UNSUPPORTED_PARAMETER,
+                                name + " is not supported by the PeerConnectionFactory");
+    }
+    return transceiver->SetCodecPreferences(preferred);
+}
+
+/* ============================================================================
+ * Shared encoder
+ * ========================================================================== */
+
+webrtc::ScalabilityMode TemporalScalabilityMode(int temporal_layers) {
+    switch (temporal_layers) {
+        case 2: return webrtc::ScalabilityMode::kL1T2;
+        case 3: return webrtc::ScalabilityMode::kL1T3;
+        default: return webrtc::ScalabilityMode::kL1T1;
+    }
+}
+
+// Single-stream codec settings with temporal_layers temporal layers. The
+// bitrate is both the start and the maximum.
+webrtc::VideoCodec SharedCodecSettings(webrtc::VideoCodecType type, int width, int height,
+                                       int bitrate_bps, int framerate, int temporal_layers) {
+    webrtc::VideoCodec codec;
+    codec.codecType = type;
+    codec.width = static_cast<uint16_t>(width);
+    codec.height = static_cast<uint16_t>(height);
+    codec.startBitrate = static_cast<unsigned int>(bitrate_bps / 1000);
+    codec.maxBitrate = codec.startBitrate;
+    codec.minBitrate = std::min(30u, codec.startBitrate);
+    codec.maxFramerate = static_cast<uint32_t>(framerate);
+    codec.qpMax = type == webrtc::kVideoCodecAV1 ? 63 : (type == webrtc::kVideoCodecH264 ? 51 : 56);
+    codec.SetScalabilityMode(TemporalScalabilityMode(temporal_layers));
+
+    switch (type) {
+        case webrtc::kVideoCodecVP8:
+            *codec.VP8() = webrtc::VideoEncoder::GetDefaultVp8Settings();
+            codec.VP8()->numberOfTemporalLayers = static_cast<unsigned char>(temporal_layers);
+            break;
+        case webrtc::kVideoCodecVP9:
+            *codec.VP9() = webrtc::VideoEncoder::GetDefaultVp9Settings();
+            codec.VP9()->numberOfTemporalLayers = static_cast<unsigned char>(temporal_layers);
+            codec.VP9()->numberOfSpatialLayers = 1;
+            break;
+        case webrtc::kVideoCodecH264:
+            *codec.H264() = webrtc::VideoEncoder::GetDefaultH264Settings();
+            codec.H264()->numberOfTemporalLayers = static_cast<unsigned char>(temporal_layers);
+            break;
+        case webrtc::kVideoCodecAV1:
+            codec.AV1()->automatic_resize_on = false;
+            break;
+        default:
+            break;
+    }
+
+    // The rate allocators read the layer layout from the stream settings.
+    auto& stream = type == webrtc::kVideoCodecVP9 ? codec.spatialLayers[0] : codec.simulcastStream[0];
+    stream.width = codec.width;
+    stream.height = codec.height;
+    stream.maxFramerate = static_cast<float>(framerate);
+    stream.numberOfTemporalLayers = static_cast<unsigned char>(temporal_layers);
+    stream.maxBitrate = codec.maxBitrate;
+    stream.targetBitrate = codec.maxBitrate;
+    stream.minBitrate = codec.minBitrate;
+    stream.qpMax = codec.qpMax;
+    stream.active = true;
+    if (type != webrtc::kVideoCodecVP9) {
+        codec.numberOfSimulcastStreams = 1;
+    }
+    return codec;
+}
+
+// Temporal layer of an encoder output, or -1 if it has none.
+int OutputTemporalId(const webrtc::EncodedImage& image, const webrtc::CodecSpecificInfo* info) {
+    if (info) {
+        uint8_t temporal_idx = webrtc::kNoTemporalIdx;
+        switch (info->codecType) {
+            case webrtc::kVideoCodecVP8: temporal_idx = info->codecSpecific.VP8.temporalIdx; break;
+            case webrtc::kVideoCodecVP9: temporal_idx = info->codecSpecific.VP9.temporal_idx; break;
+            case webrtc::kVideoCodecH264: temporal_idx = info->codecSpecific.H264.temporal_idx; break;
+            default: break;
+        }
+        if (temporal_idx != webrtc::kNoTemporalIdx) {
+            return temporal_idx;
+        }
+        if (info->generic_frame_info) {
+            return info->generic_frame_info->temporal_id;
+        }
+    }
+    return image.TemporalIndex().value_or(-1);
+}
+
+// Encodes raw frames once for any number of encoded sources (subscribers).
+// Keyframe requests only set a flag that the next frame consumes, so the
+// requests of all subscribers up to that frame produce one keyframe. The
+// subscribers share the encoder's requester and keyframe cache.
+class SharedVideoEncoder : public webrtc::EncodedImageCallback,
+                           public std::enable_shared_from_this<SharedVideoEncoder> {
+public:
+    SharedVideoEncoder(ShimCodecType codec, int width, int height, int bitrate_bps, int framerate,
+                       int temporal_layers)
+        : codec_(shim::ToWebRTCCodecType(codec)), width_(width), height_(height),
+          temporal_layers_(temporal_layers), bitrate_bps_(bitrate_bps), framerate_(framerate),
+          settings_(SharedCodecSettings(codec_, width, height, bitrate_bps, framerate, temporal_layers)) {}
+
+    ~SharedVideoEncoder() override { Close(); }
+
+    static std::shared_ptr<SharedVideoEncoder> Create(const ShimSharedVideoEncoderCreateParams& params) {
+        const int temporal_layers = params.temporal_layers > 0 ? params.temporal_layers : 1;
+        auto encoder = std::make_shared<SharedVideoEncoder>(
+            params.codec, params.width, params.height, params.bitrate_bps, params.framerate, temporal_layers);
+        if (!encoder->Init(params.codec, params.error_out)) {
+            return nullptr;
+        }
+        // Frames and subscribers can outlive the encoder.
+        std::weak_ptr<SharedVideoEncoder> weak = encoder;
+        encoder->requester_ = std::make_shared<KeyFrameRequester>(
+            KeyFrameRequestInterval(params.min_keyframe_interval_ms), [weak]() {
+                if (auto encoder = weak.lock()) {
+                    encoder->keyframe_pending_.store(true, std::memory_order_relaxed);
+                }
+            });
+        return encoder;
+    }
+
+    // Request hook for the requesters of subscribers, which only add their
+    // track's requests to the encoder's.
+    std::function<void()> KeyFrameHook() {
+        std::weak_ptr<SharedVideoEncoder> weak = weak_from_this();
+        return [weak]() {
+            if (auto encoder = weak.lock()) {
+                encoder->requester_->Request();
+            }
+        };
+    }
+
+    const std::shared_ptr<KeyFrameCache>& cache() const { return cache_; }
+
+    int Encode(const ShimSharedVideoEncoderPushFrameParams& params) {
+        auto buffer = webrtc::I420Buffer::Copy(
+            width_, height_,
+            params.y_plane, params.y_stride,
+            params.u_plane, params.u_stride,
+            params.v_plane, params.v_stride);
+        if (!buffer) {
+            return shim::SetErrorMessage(params.error_out, "out of memory", SHIM_ERROR_OUT_OF_MEMORY);
+        }
+        webrtc::VideoFrame frame = webrtc::VideoFrame::Builder()
+            .set_video_frame_buffer(buffer)
+            .set_timestamp_us(params.timestamp_us)
+            .set_timestamp_rtp(static_cast<uint32_t>(params.timestamp_us * 90 / 1000))
+            .set_rotation(webrtc::kVideoRotation_0)
+            .build();
+
+        std::lock_guard<std::mutex> lock(encode_mutex_);
+        if (!encoder_) {
+            return shim::SetErrorMessage(params.error_out, "encoder destroyed", SHIM_ERROR_INVALID_PARAM);
+        }
+        const bool keyframe = keyframe_pending_.exchange(false, std::memory_order_relaxed);
+        std::vector<webrtc::VideoFrameType> frame_types{
+            keyframe ? webrtc::VideoFrameType::kVideoFrameKey : webrtc::VideoFrameType::kVideoFrameDelta};
+        const int result = encoder_->Encode(frame, &frame_types);
+        if (result != WEBRTC_VIDEO_CODEC_OK) {
+            if (keyframe) {
+                keyframe_pending_.store(true, std::memory_order_relaxed);
+            }
+            return shim::SetErrorMessage(params.error_out, "encode failed (" + std::to_string(result) + ")",
+                                         SHIM_ERROR_ENCODE_FAILED);
+        }
+        return SHIM_OK;
+    }
+
+    // The bitrate given at creation is the maximum.
+    int SetRates(int bitrate_bps, int framerate) {
+        std::lock_guard<std::mutex> lock(encode_mutex_);
+        if (!encoder_) {
+            return SHIM_ERROR_INVALID_PARAM;
+        }
+        bitrate_bps_ = std::min<int64_t>(bitrate_bps, static_cast<int64_t>(settings_.maxBitrate) * 1000);
+        framerate_ = framerate;
+        ApplyRates();
+        return SHIM_OK;
+    }
+
+    void Subscribe(webrtc::scoped_refptr<EncodedVideoTrackSource> source) {
+        std::lock_guard<std::mutex> lock(subscribers_mutex_);
+        subscribers_.push_back(std::move(source));
+    }
+
+    void Unsubscribe(EncodedVideoTrackSource* source) {
+        std::lock_guard<std::mutex> lock(subscribers_mutex_);
+        subscribers_.erase(
+            std::remove_if(subscribers_.begin(), subscribers_.end(),
+                           [source](const auto& subscriber) { return subscriber.get() == source; }),
+            subscribers_.end());
+    }
+
+    // Release the encoder; subscribers receive no more frames.
+    void Close() {
+        std::lock_guard<std::mutex> lock(encode_mutex_);
+        if (encoder_) {
+            encoder_->RegisterEncodeCompleteCallback(nullptr);
+            encoder_->Release();
+            encoder_.reset();
+        }
+    }
+
+    webrtc::VideoCodecType codec() const { return codec_; }
+    int width() const { return width_; }
+    int height() const { return height_; }
+
+    webrtc::EncodedImageCallback::Result OnEncodedImage(
+        const webrtc::EncodedImage& image,
+        const webrtc::CodecSpecificInfo* codec_specific_info) override {
+        const int temporal_id = temporal_layers_ > 1 ? OutputTemporalId(image, codec_specific_info) : -1;
+        auto frame = webrtc::make_ref_counted<EncodedFrameBuffer>(
+            webrtc::EncodedImageBuffer::Create(image.data(), image.size()), codec_,
+            image._encodedWidth > 0 ? static_cast<int>(image._encodedWidth) : width_,
+            image._encodedHeight > 0 ? static_cast<int>(image._encodedHeight) : height_,
+            image._frameType == webrtc::VideoFrameType::kVideoFrameKey,
+            std::min(temporal_id, kMaxTemporalLayer), requester_, cache_,
+            codec_specific_info ? std::make_shared<const webrtc::CodecSpecificInfo>(*codec_specific_info)
+                                : nullptr);
+        cache_->Update(*frame);
+        requester_->OnFrame(frame->keyframe());
+
+        std::vector<webrtc::scoped_refptr<EncodedVideoTrackSource>> subscribers;
+        {
+            std::lock_guard<std::mutex> lock(subscribers_mutex_);
+            subscribers = subscribers_;
+        }
+        for (const auto& subscriber : subscribers) {
+            subscriber->PushFrame(*frame);
+        }
+        return webrtc::EncodedImageCallback::Result(webrtc::EncodedImageCallback::Result::OK);
+    }
+
+private:
+    // Create the encoder from the factory the shim prefers, falling back to
+    // the other one as shim_video_encoder_create does.
+    bool Init(ShimCodecType codec, ShimErrorBuffer* error_out) {
+        const auto format = shim::CreateSdpVideoFormat(codec);
+        const webrtc::VideoEncoder::Settings encoder_settings(
+            webrtc::VideoEncoder::Capabilities(false),
+            1,     // number_of_cores
+            1200   // max_payload_size
+        );
+        const bool software = shim::ShouldUseSoftwareCodecs();
+        for (bool use_software : {software, !software}) {
+            std::unique_ptr<webrtc::VideoEncoderFactory> factory;
+            if (use_software) {
+                factory = std::make_unique<webrtc::InternalEncoderFactory>();
+            } else {
+                factory = webrtc::CreateBuiltinVideoEncoderFactory();
+            }
+            auto encoder = factory ? factory->Create(shim::GetEnvironment(), format) : nullptr;
+            if (encoder && encoder->InitEncode(&settings_, encoder_settings) == WEBRTC_VIDEO_CODEC_OK) {
+                factory_ = std::move(factory);
+                encoder_ = std::move(encoder);
+                break;
+            }
+        }
+        if (!encoder_) {
+            shim::SetErrorMessage(error_out, "no encoder available for " + shim::CodecTypeToString(codec),
+                                  SHIM_ERROR_NOT_SUPPORTED);
+            return false;
+        }
+
+        encoder_->RegisterEncodeCompleteCallback(this);
+        allocator_ = webrtc::CreateBuiltinVideoBitrateAllocatorFactory()->Create(shim::GetEnvironment(), settings_);
+        ApplyRates();
+        return true;
+    }
+
+    // Must be called with encode_mutex_ held.
+    void ApplyRates() {
+        webrtc::VideoBitrateAllocation allocation;
+        if (allocator_) {
+            allocation = allocator_->Allocate(webrtc::VideoBitrateAllocationParameters(
+                static_cast<uint32_t>(bitrate_bps_), static_cast<double>(framerate_)));
+        } else {
+            allocation.SetBitrate(0, 0, static_cast<uint32_t>(bitrate_bps_));
+        }
+        encoder_->SetRates(webrtc::VideoEncoder::RateControlParameters(allocation, static_cast<double>(framerate_)));
+    }
+
+    const webrtc::VideoCodecType codec_;
+    const int width_;
+    const int height_;
+    const int temporal_layers_;
+
+    std::mutex encode_mutex_;  // guards the fields below
+    int64_t bitrate_bps_;
+    int framerate_;
+    webrtc::VideoCodec settings_;
+    std::unique_ptr<webrtc::VideoEncoderFactory> factory_;
+    std::unique_ptr<webrtc::VideoEncoder> encoder_;
+    std::unique_ptr<webrtc::VideoBitrateAllocator> allocator_;
+
+    // The first frame is always a keyframe.
+    std::atomic<bool> keyframe_pending_{true};
+    // Shared by the frames; only forwards requests to keyframe_pending_.
+    std::shared_ptr<KeyFrameRequester> requester_;
+    const std::shared_ptr<KeyFrameCache> cache_ = std::make_shared<KeyFrameCache>();
+
+    std::mutex subscribers_mutex_;
+    std::vector<webrtc::scoped_refptr<EncodedVideoTrackSource>> subscribers_;
+};
+
+}  // namespace
+
+namespace shim {
+
+std::unique_ptr<webrtc::VideoEncoderFactory> CreatePassthroughEncoderFactory(
+    std::unique_ptr<webrtc::VideoEncoderFactory> factory) {
+    return std::make_unique<PassthroughVideoEncoderFactory>(std::move(factory));
+}
+
+}  // namespace shim
+
+struct ShimEncodedVideoSource {
+    std::shared_ptr<KeyFrameRequester> requester;
+    std::shared_ptr<KeyFrameCache> cache;
+    webrtc::scoped_refptr<EncodedVideoTrackSource> source;
+    webrtc::VideoCodecType codec;
+    int width;
+    int height;
+    std::shared_ptr<SharedVideoEncoder> shared;  // Set for subscribers of a shared encoder
+};
+
+struct ShimSharedVideoEncoder {
+    std::shared_ptr<SharedVideoEncoder> encoder;
+};
+
+/* ============================================================================
+ * C API Implementation
+ * ========================================================================== */
+
+extern "C" {
+
+SHIM_EXPORT ShimEncodedVideoSource* shim_encoded_video_source_create(
+    ShimEncodedVideoSourceCreateParams* params
+) {
+    if (!params || params->width <= 0 || params->height <= 0) {
+        shim::SetErrorMessage(params ? params->error_out : nullptr, "invalid parameter", SHIM_ERROR_INVALID_PARAM);
+        return nullptr;
+    }
+    switch (params->codec) {
+        case SHIM_CODEC_H264:
+        case SHIM_CODEC_VP8:
+        case SHIM_CODEC_VP9:
+        case SHIM_CODEC_AV1:
+            break;
+        default:
+            shim::SetErrorMessage(params->error_out, "unsupported codec", SHIM_ERROR_NOT_SUPPORTED);
+            return nullptr;
+    }
+
+    auto source = std::make_unique<ShimEncodedVideoSource>();
+    source->requester = std::make_shared<KeyFrameRequester>(
+        KeyFrameRequestInterval(params->min_keyframe_interval_ms));
+    source->cache = std::make_shared<KeyFrameCache>();
+    source->source = webrtc::make_ref_counted<EncodedVideoTrackSource>(
+        params->width, params->height, source->requester);
+    source->codec = shim::ToWebRTCCodecType(params->codec);
+    source->width = params->width;
+    source->height = params->height;
+    return source.release();
+}
+
+SHIM_EXPORT void shim_encoded_video_source_set_on_keyframe_request(
+    ShimEncodedVideoSourceSetOnKeyFrameRequestParams* params
+) {
+    if (!params || !params->source) {
+        return;
+    }
+    params->source->requester->SetCallback(params->callback, params->ctx);
+}
+
+SHIM_EXPORT int shim_encoded_video_source_push_frame(
+    ShimEncodedVideoSourcePushFrameParams* params
+) {
+    if (!params || !params->source || !params->data || params->size <= 0 ||
+        params->width < 0 || params->height < 0 || params->temporal_id > kMaxTemporalLayer ||
+        params->timestamp_us < 0) {
+        shim::SetErrorMessage(params ? params->error_out : nullptr, "invalid parameter", SHIM_ERROR_INVALID_PARAM);
+        return SHIM_ERROR_INVALID_PARAM;
+    }
+
+    auto source = params->source;
+    if (source->shared) {
+        shim::SetErrorMessage(params->error_out, "source is fed by a shared encoder", SHIM_ERROR_INVALID_PARAM);
+        return SHIM_ERROR_INVALID_PARAM;
+    }
+    auto data = webrtc::EncodedImageBuffer::Create(params->data, static_cast<size_t>(params->size));
+
+    auto frame = webrtc::make_ref_counted<EncodedFrameBuffer>(
+        std::move(data), source->codec,
+        params->width > 0 ? params->width : source->width,
+        params->height > 0 ? params->height : source->height,
+        params->is_keyframe != 0, params->temporal_id, source->requester, source->cache);
+    source->cache->Update(*frame);
+    source->requester->OnFrame(frame->keyframe());
+    source->source->PushFrame(*frame, params->timestamp_us);
+    return SHIM_OK;
+}
+
+SHIM_EXPORT ShimRTPSender* shim_peer_connection_add_encoded_video_track(
+    ShimPeerConnectionAddEncodedVideoTrackParams* params
+) {
+    if (!params || !params->pc || !params->pc->peer_connection || !params->pc->factory || !params->source || !params->track_id) {
+        shim::SetErrorMessage(params ? params->error_out : nullptr, "invalid parameter");
+        return nullptr;
+    }
+
+    auto pc = params->pc;
+    auto source = params->source;
+    ShimErrorBuffer* error_out = params->error_out;
+
+    auto track = pc->factory->CreateVideoTrack(source->source, params->track_id);
+    if (!track) {
+        shim::SetErrorMessage(error_out, "CreateVideoTrack failed");
+        return nullptr;
+    }
+    shim::RegisterVideoSourceTrack(source->source->id(), track.get());
+
+    std::vector<std::string> stream_ids;
+    if (params->stream_id) {
+        stream_ids.push_back(params->stream_id);
+    }
+
+    auto result = pc->peer_connection->AddTrack(track, stream_ids);
+    if (!result.ok()) {
+        shim::SetErrorFromRTCError(error_out, result.error());
+        return nullptr;
+    }
+    auto sender = result.value();
+
+    webrtc::RTCError error = webrtc::RTCError::OK();
+    for (const auto& transceiver : pc->peer_connection->GetTransceivers()) {
+        if (transceiver->sender() == sender) {
+            error = PreferCodec(pc->factory.get(), transceiver.get(), source->codec);
+            break;
+        }
+    }
+    if (error.ok()) {
+        // The bitstream cannot be scaled or have frames dropped by the encoder.
+        webrtc::RtpParameters parameters = sender->GetParameters();
+        parameters.degradation_preference = webrtc::DegradationPreference::DISABLED;
+        error = sender->SetParameters(parameters);
+    }
+    if (!error.ok()) {
+        pc->peer_connection->RemoveTrackOrError(sender);
+        shim::SetErrorFromRTCError(error_out, error);
+        return nullptr;
+    }
+
+    pc->senders.push_back(sender);
+    return reinterpret_cast<ShimRTPSender*>(sender.get());
+}
+
+SHIM_EXPORT int shim_encoded_video_source_set_max_temporal_layer(
+    ShimEncodedVideoSourceSetMaxTemporalLayerParams* params
+) {
+    if (!params || !params->source || params->max_temporal_layer < 0 ||
+        params->max_temporal_layer > kMaxTemporalLayer) {
+        return SHIM_ERROR_INVALID_PARAM;
+    }
+    params->source->source->SetMaxTemporalLayer(params->max_temporal_layer);
+    return SHIM_OK;
+}
+
+SHIM_EXPORT void shim_encoded_video_source_destroy(ShimEncodedVideoSource* source) {
+    if (source) {
+        if (source->shared) {
+            source->shared->Unsubscribe(source->source.get());
+        }
+        // Frames still in the pipeline share the requester; silence it.
+        source->requester->SetCallback(nullptr, nullptr);
+        delete source;
+    }
+}
+
+SHIM_EXPORT ShimSharedVideoEncoder* shim_shared_video_encoder_create(
+    ShimSharedVideoEncoderCreateParams* params
+) {
+    if (!params || params->width <= 0 || params->height <= 0 || params->bitrate_bps <= 0 ||
+        params->framerate <= 0 || params->temporal_layers < 0 || params->temporal_layers > 3) {
+        shim::SetErrorMessage(params ? params->error_out : nullptr, "invalid parameter", SHIM_ERROR_INVALID_PARAM);
+        return nullptr;
+    }
+    switch (params->codec) {
+        case SHIM_CODEC_H264:
+        case SHIM_CODEC_VP8:
+        case SHIM_CODEC_VP9:
+        case SHIM_CODEC_AV1:
+            break;
+        default:
+            shim::SetErrorMessage(params->error_out, "unsupported codec", SHIM_ERROR_NOT_SUPPORTED);
+            return nullptr;
+    }
+
+    auto encoder = SharedVideoEncoder::Create(*params);
+    if (!encoder) {
+        return nullptr;
+    }
+    auto shared = std::make_unique<ShimSharedVideoEncoder>();
+    shared->encoder = std::move(encoder);
+    return shared.release();
+}
+
+SHIM_EXPORT int shim_shared_video_encoder_push_frame(
+    ShimSharedVideoEncoderPushFrameParams* params
+) {
+    if (!params || !params->encoder || !params->y_plane || !params->u_plane || !params->v_plane) {
+        shim::SetErrorMessage(params ? params->error_out : nullptr, "invalid parameter", SHIM_ERROR_INVALID_PARAM);
+        return SHIM_ERROR_INVALID_PARAM;
+    }
+    return params->encoder->encoder->Encode(*params);
+}
+
+SHIM_EXPORT int shim_shared_video_encoder_set_rates(
+    ShimSharedVideoEncoderSetRatesParams* params
+) {
+    if (!params || !params->encoder || params->bitrate_bps <= 0 || params->framerate <= 0) {
+        return SHIM_ERROR_INVALID_PARAM;
+    }
+    return params->encoder->encoder->SetRates(params->bitrate_bps, params->framerate);
+}
+
+SHIM_EXPORT ShimEncodedVideoSource* shim_shared_video_encoder_subscribe(
+    ShimSharedVideoEncoderSubscribeParams* params
+) {
+    if (!params || !params->encoder || params->max_temporal_layer < 0 ||
+        params->max_temporal_layer > kMaxTemporalLayer) {
+        shim::SetErrorMessage(params ? params->error_out : nullptr, "invalid parameter", SHIM_ERROR_INVALID_PARAM);
+        return nullptr;
+    }
+
+    auto& encoder = params->encoder->encoder;
+    auto source = std::make_unique<ShimEncodedVideoSource>();
+    // Keyframe requests of the subscriber's track go to the encoder.
+    source->requester = std::make_shared<KeyFrameRequester>(0, encoder->KeyFrameHook());
+    source->cache = encoder->cache();
+    source->source = webrtc::make_ref_counted<EncodedVideoTrackSource>(
+        encoder->width(), encoder->height(), source->requester);
+    source->source->SetMaxTemporalLayer(params->max_temporal_layer);
+    source->codec = encoder->codec();
+    source->width = encoder->width();
+    source->height = encoder->height();
+    source->shared = encoder;
+    encoder->Subscribe(source->source);
+    return source.release();
+}
+
+SHIM_EXPORT void shim_shared_video_encoder_destroy(ShimSharedVideoEncoder* encoder) {
+    if (encoder) {
+        // Subscribers may keep the encoder object alive; release the codec now.
+        encoder->encoder->Close();
+        delete encoder;
+    }
+}
+
+}  // extern "C"
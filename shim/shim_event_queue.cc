@@ -0,0 +1,282 @@
+/*
+ * shim_event_queue.cc - Bounded event ring with fd notification
+ *
+ * Lets PeerConnections, DataChannels and remote track sinks hand events to Go
+ * without a callback trampoline per event. Producers push into a lock-free
+ * ring from libwebrtc threads; a single consumer waits on the notification fd
+ * and drains batches of events in one call.
+ */
+
+#include "shim_common.h"
+#include "shim_internal.h"
+
+#include <cerrno>
+#include <cstring>
+#include <string>
+
+#if defined(WEBRTC_LINUX)
+#include <sys/eventfd.h>
+#include <unistd.h>
+#elif defined(WEBRTC_POSIX)
+#include <fcntl.h>
+#include <unistd.h>
+#endif
+
+namespace {
+
+constexpr int kDefaultEventQueueCapacity = 4096;
+
+size_t RoundUpToPowerOfTwo(size_t n) {
+    size_t p = 1;
+    while (p < n) {
+        p <<= 1;
+    }
+    return p;
+}
+
+}  // namespace
+
+namespace shim {
+
+/* ============================================================================
+ * EventRing
+ * ========================================================================== */
+
+EventRing::EventRing(size_t capacity)
+    : cells_(new Cell[capacity]), mask_(capacity - 1) {
+    for (size_t i = 0; i < capacity; i++) {
+        cells_[i].sequence.store(i, std::memory_order_relaxed);
+    }
+}
+
+EventRing::~EventRing() {
+#if defined(WEBRTC_POSIX)
+    if (write_fd_ >= 0 && write_fd_ != read_fd_) {
+        close(write_fd_);
+    }
+    if (read_fd_ >= 0) {
+        close(read_fd_);
+    }
+#endif
+}
+
+bool EventRing::Init(ShimErrorBuffer* error_out) {
+#if defined(WEBRTC_LINUX)
+    read_fd_ = eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC);
+    if (read_fd_ < 0) {
+        shim::SetErrorMessage(error_out, std::string("eventfd failed: ") + strerror(errno));
+        return false;
+    }
+    write_fd_ = read_fd_;
+    return true;
+#elif defined(WEBRTC_POSIX)
+    int fds[2];
+    if (pipe(fds) != 0) {
+        shim::SetErrorMessage(error_out, std::string("pipe failed: ") + strerror(errno));
+        return false;
+    }
+    for (int fd : fds) {
+        fcntl(fd, F_SETFL, fcntl(fd, F_GETFL) | O_NONBLOCK);
+        fcntl(fd, F_SETFD, FD_CLOEXEC);
+    }
+    read_fd_ = fds[0];
+    write_fd_ = fds[1];
+    return true;
+#else
+    shim::SetErrorMessage(error_out, "event queues are not supported on this platform",
+                          SHIM_ERROR_NOT_SUPPORTED);
+    return false;
+#endif
+}
+
+bool EventRing::Push(Event event) {
+    Cell* cell;
+    size_t pos = enqueue_pos_.load(std::memory_order_relaxed);
+    for (;;) {
+        cell = &cells_[pos & mask_];
+        size_t seq = cell->sequence.load(std::memory_order_acquire);
+        intptr_t diff = static_cast<intptr_t>(seq) - static_cast<intptr_t>(pos);
+        if (diff == 0) {
+            if (enqueue_pos_.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed)) {
+                break;
+            }
+        } else if (diff < 0) {
+            dropped_.fetch_add(1, std::memory_order_relaxed);
+            Notify();
+            return false;
+        } else {
+            pos = enqueue_pos_.load(std::memory_order_relaxed);
+        }
+    }
+
+    cell->event = std::move(event);
+    cell->sequence.store(pos + 1, std::memory_order_release);
+    Notify();
+    return true;
+}
+
+void EventRing::Notify() {
+    // Only the first producer after a drain pays for the syscall.
+    if (notify_pending_.exchange(true, std::memory_order_acq_rel)) {
+        return;
+    }
+#if defined(WEBRTC_LINUX)
+    uint64_t one = 1;
+    ssize_t ignored = write(write_fd_, &one, sizeof(one));
+    (void)ignored;
+#elif defined(WEBRTC_POSIX)
+    uint8_t one = 1;
+    ssize_t ignored = write(write_fd_, &one, sizeof(one));
+    (void)ignored;
+#endif
+}
+
+int EventRing::Drain(ShimEventQueueDrainParams* params) {
+    std::lock_guard<std::mutex> lock(drain_mutex_);
+
+    // Re-arm before draining so events pushed from here on notify again. The
+    // exchange also acquires the cells of producers that skipped notifying.
+    notify_pending_.exchange(false, std::memory_order_acq_rel);
+    params->out_dropped = dropped_.exchange(0, std::memory_order_relaxed);
+
+    int count = 0;
+    int used = 0;
+    while (count < params->max_events) {
+        Cell* cell = &cells_[dequeue_pos_ & mask_];
+        size_t seq = cell->sequence.load(std::memory_order_acquire);
+        if (seq != dequeue_pos_ + 1) {
+            break;  // Empty
+        }
+
+        int payload_len = static_cast<int>(cell->event.payload.size());
+        if (payload_len > params->payload_size - used) {
+            if (count == 0) {
+                params->out_payload_len = payload_len;
+                return shim::SetErrorMessage(params->error_out, "event payload buffer too small",
+                                             SHIM_ERROR_BUFFER_TOO_SMALL);
+            }
+            break;
+        }
+
+        ShimEvent& out = params->events[count];
+        out = cell->event.header;
+        out.payload_offset = used;
+        out.payload_len = payload_len;
+        if (payload_len > 0) {
+            memcpy(params->payload + used, cell->event.payload.data(), payload_len);
+            used += payload_len;
+        }
+
+        cell->event = Event();
+        cell->sequence.store(dequeue_pos_ + mask_ + 1, std::memory_order_release);
+        dequeue_pos_++;
+        count++;
+    }
+
+    // Events left behind (out of slots or payload space) must keep the fd
+    // readable so the consumer comes back for them.
+    if (cells_[dequeue_pos_ & mask_].sequence.load(std::memory_order_acquire) == dequeue_pos_ + 1) {
+        notify_pending_.store(false, std::memory_order_release);
+        Notify();
+    }
+
+    params->out_count = count;
+    params->out_payload_len = used;
+    shim::ClearError(params->error_out);
+    return SHIM_OK;
+}
+
+/* ============================================================================
+ * EventTarget
+ * ========================================================================== */
+
+void EventTarget::Attach(std::shared_ptr<EventRing> ring, uint64_t tag) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    ring_ = std::move(ring);
+    tag_ = tag;
+}
+
+bool EventTarget::Emit(ShimEvent header, std::vector<uint8_t> payload) {
+    std::shared_ptr<EventRing> ring;
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        if (!ring_) {
+            return false;
+        }
+        ring = ring_;
+        header.tag = tag_;
+    }
+
+    Event event;
+    event.header = header;
+    event.payload = std::move(payload);
+    ring->Push(std::move(event));
+    return true;
+}
+
+}  // namespace shim
+
+/* ============================================================================
+ * C API Implementation
+ * ========================================================================== */
+
+extern "C" {
+
+SHIM_EXPORT ShimEventQueue* shim_event_queue_create(ShimEventQueueCreateParams* params) {
+    if (!params) {
+        return nullptr;
+    }
+    if (params->capacity < 0) {
+        shim::SetErrorMessage(params->error_out, "capacity must be >= 0", SHIM_ERROR_INVALID_PARAM);
+        return nullptr;
+    }
+
+    size_t capacity = RoundUpToPowerOfTwo(
+        params->capacity > 0 ? static_cast<size_t>(params->capacity) : kDefaultEventQueueCapacity);
+    if (capacity < 2) {
+        capacity = 2;
+    }
+
+    auto ring = std::make_shared<shim::EventRing>(capacity);
+    if (!ring->Init(params->error_out)) {
+        return nullptr;
+    }
+
+    auto queue = std::make_unique<ShimEventQueue>();
+    queue->ring = std::move(ring);
+    shim::ClearError(params->error_out);
+    return queue.release();
+}
+
+SHIM_EXPORT int shim_event_queue_fd(ShimEventQueue* queue) {
+    if (!queue) {
+        return -1;
+    }
+    return queue->ring->fd();
+}
+
+SHIM_EXPORT void shim_event_queue_destroy(ShimEventQueue* queue) {
+    delete queue;
+}
+
+SHIM_EXPORT int shim_event_queue_drain(ShimEventQueueDrainParams* params) {
+    if (!params) {
+        return SHIM_ERROR_INVALID_PARAM;
+    }
+    params->out_count = 0;
+    params->out_payload_len = 0;
+    params->out_dropped = 0;
+    if (!params->queue || !params->events || params->max_events <= 0 || params->payload_size < 0 ||
+        (params->payload_size > 0 && !params->payload)) {
+        return shim::SetErrorMessage(params->error_out, "invalid parameter", SHIM_ERROR_INVALID_PARAM);
+    }
+    return params->queue->ring->Drain(params);
+}
+
+SHIM_EXPORT void shim_peer_connection_set_event_queue(ShimPeerConnectionSetEventQueueParams* params) {
+    if (params && params->pc) {
+        params->pc->events.Attach(params->queue ? params->queue->ring : nullptr, params->tag);
+    }
+}
+
+}  // extern "C"
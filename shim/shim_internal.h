@@ -9,20 +9,285 @@
 
 #include "shim_common.h"
 
+#include <atomic>
+#include <memory>
 #include <mutex>
+#include <unordered_map>
 #include <vector>
 
 #include "api/peer_connection_interface.h"
 #include "api/rtp_sender_interface.h"
 #include "api/data_channel_interface.h"
 #include "api/scoped_refptr.h"
+#include "api/transport/network_control.h"
+#include "api/video_codecs/video_decoder_factory.h"
+#include "api/video_codecs/video_encoder_factory.h"
+
+/* ============================================================================
+ * PeerConnectionFactory Internal Structure
+ * ========================================================================== */
+
+// Dedicated signaling/worker/network threads owned by a thread-group shard.
+// Shared by the shard's factory and every object created from it, so the
+// threads outlive the last PeerConnection that runs on them.
+struct ShimThreadSet {
+    std::unique_ptr<webrtc::Thread> signaling;
+    std::unique_ptr<webrtc::Thread> worker;
+    std::unique_ptr<webrtc::Thread> network;
+};
+
+namespace shim {
+class UDPMux;
+class UDPMuxSession;
+class LoopbackNetwork;
+class LoopbackSession;
+}  // namespace shim
+
+struct ShimPeerConnectionFactory {
+    // Declared first so it is destroyed after the factory. Null when the
+    // factory runs on the global shim threads.
+    std::shared_ptr<ShimThreadSet> threads;
+    // Shared UDP sockets for the factory's PeerConnections; null unless
+    // udp_mux_port was configured.
+    std::shared_ptr<shim::UDPMux> udp_mux;
+    // In-process network for the factory's PeerConnections; null unless
+    // loopback_network was configured.
+    std::shared_ptr<shim::LoopbackNetwork> loopback_network;
+    webrtc::scoped_refptr<webrtc::PeerConnectionFactoryInterface> factory;
+};
+
+struct ShimLoopbackNetwork {
+    std::shared_ptr<shim::LoopbackNetwork> network;
+};
+
+namespace shim {
+
+// Counters of one RTP stream at the previous delta-mode stats call, and the
+// rates computed then (repeated while GetStats returns the same cached report).
+struct StreamCounters {
+    int64_t timestamp_us = 0;
+    int64_t bytes = 0;
+    int64_t packets = 0;
+    int64_t packets_lost = 0;
+    int64_t interval_us = 0;
+    double bitrate_bps = 0;
+    double packet_rate = 0;
+    double interval_loss_rate = 0;
+};
+
+// Transport-wide RTCP feedback seen by a network controller since the
+// PeerConnection was created.
+struct TransportFeedbackTotals {
+    int64_t remb_reports = 0;
+    int64_t remb_bitrate_bps = 0;  // Latest report
+    int64_t twcc_reports = 0;
+    int64_t twcc_packets = 0;
+    int64_t twcc_lost = 0;
+};
+
+// Latest send-side bandwidth estimate of one PeerConnection, fed by its
+// network controller on the transport task queue.
+class BandwidthEstimator {
+public:
+    void SetCallback(ShimOnBandwidthEstimate callback, void* ctx);
+    ShimBandwidthEstimate Latest() const;
+    TransportFeedbackTotals FeedbackTotals() const;
+
+    // Merge a controller update and report it to the callback.
+    void OnUpdate(const webrtc::NetworkControlUpdate& update);
+
+    // Count feedback messages handed to the controller.
+    void OnRemoteBitrateReport(const webrtc::RemoteBitrateReport& report);
+    void OnTransportPacketsFeedback(const webrtc::TransportPacketsFeedback& feedback);
+
+private:
+    mutable std::mutex mutex_;
+    ShimBandwidthEstimate latest_{};
+    TransportFeedbackTotals feedback_;
+    ShimOnBandwidthEstimate callback_ = nullptr;
+    void* ctx_ = nullptr;
+};
+
+// Congestion control fields of a ShimPeerConnectionConfig.
+struct NetworkControllerSettings {
+    int type = SHIM_NETWORK_CONTROLLER_GOOG_CC;
+    int start_bitrate_bps = 0;
+    int min_bitrate_bps = 0;
+    int max_bitrate_bps = 0;
+    bool disable_probing = false;
+};
+
+// Validate config's congestion control fields; config may be NULL.
+// Returns false with error_out set on failure.
+bool BuildNetworkControllerSettings(
+    const ShimPeerConnectionConfig* config,
+    NetworkControllerSettings* settings,
+    ShimErrorBuffer* error_out);
+
+// Build the congestion controller selected by settings, wrapped so its
+// updates reach estimator. Hand the result to the PeerConnection in
+// PeerConnectionDependencies.
+std::unique_ptr<webrtc::NetworkControllerFactoryInterface> CreateNetworkControllerFactory(
+    const NetworkControllerSettings& settings,
+    std::shared_ptr<BandwidthEstimator> estimator);
+
+// RTCP feedback reporting of one sender, and of the transport of one
+// PeerConnection; see shim_rtcp_feedback.cc.
+struct RTCPFeedbackSubscription;
+struct TransportFeedbackSubscription;
+
+// Stop every RTCP feedback subscription of pc. Call before destroying it.
+void StopRTCPFeedback(ShimPeerConnection* pc);
+
+// Ids of the shim's video sources. Their frames carry the id
+// (VideoFrame::id) so keyframe requests reaching an encoder can be reported
+// to the senders of the source. 0 means no id, also returned when all are
+// taken.
+uint16_t AcquireVideoSourceId();
+
+// Release id and forget the tracks registered for it.
+void ReleaseVideoSourceId(uint16_t id);
+
+// Record that track sends the frames of the source with id.
+void RegisterVideoSourceTrack(uint16_t id, const webrtc::MediaStreamTrackInterface* track);
+
+// Record that sender now sends track (NULL once removed), so its RTCP
+// feedback subscription receives the keyframe requests of track's source.
+void SetSenderTrack(const webrtc::RtpSenderInterface* sender, const webrtc::MediaStreamTrackInterface* track);
+
+// Report keyframe requests an encoder received for a frame of the source
+// with id; bit i of streams is set if simulcast stream i asked.
+void OnKeyFrameRequest(uint16_t id, uint32_t streams);
+
+}  // namespace shim
+
+namespace shim {
+
+// Set up a UDP mux for config->udp_mux_port + port_offset on network_thread.
+// *mux stays null when config (which may be NULL) does not ask for one.
+// Returns false with error_out set on failure.
+bool CreateUDPMux(
+    const ShimPeerConnectionFactoryConfig* config,
+    int port_offset,
+    webrtc::Thread* network_thread,
+    std::shared_ptr<UDPMux>* mux,
+    ShimErrorBuffer* error_out);
+
+// Per-PeerConnection view of a mux. The returned allocator must be handed to
+// the PeerConnection and the session kept alive until it is closed.
+std::shared_ptr<UDPMuxSession> CreateUDPMuxSession(std::shared_ptr<UDPMux> mux);
+std::unique_ptr<webrtc::PortAllocator> CreateUDPMuxPortAllocator(UDPMuxSession* session);
+
+// Route connectivity checks for the ICE username fragments in a local SDP.
+void UDPMuxSessionAddLocalDescription(UDPMuxSession* session, const std::string& sdp);
+
+// Per-PeerConnection host on a loopback network: one virtual IP whose
+// sockets are created on network_thread. The returned allocator must be handed
+// to the PeerConnection and the session kept alive until it is closed.
+std::shared_ptr<LoopbackSession> CreateLoopbackSession(
+    std::shared_ptr<LoopbackNetwork> network, webrtc::Thread* network_thread);
+std::unique_ptr<webrtc::PortAllocator> CreateLoopbackPortAllocator(LoopbackSession* session);
+
+// Build a PeerConnectionFactory. threads may be NULL to use the global shim
+// threads; config may be NULL for defaults.
+// Returns nullptr with error_out set on failure.
+webrtc::scoped_refptr<webrtc::PeerConnectionFactoryInterface> CreatePeerConnectionFactory(
+    const ShimPeerConnectionFactoryConfig* config,
+    const ShimThreadSet* threads,
+    ShimErrorBuffer* error_out);
+
+// Wrap factory so its encoders send frames of encoded video sources as they
+// are instead of encoding them; see shim_encoded_source.cc.
+std::unique_ptr<webrtc::VideoEncoderFactory> CreatePassthroughEncoderFactory(
+    std::unique_ptr<webrtc::VideoEncoderFactory> factory);
+
+// Wrap factory so it negotiates the same codecs but its decoders discard
+// frames without decoding them; see shim_encoded_sink.cc.
+std::unique_ptr<webrtc::VideoDecoderFactory> CreateDiscardingDecoderFactory(
+    std::unique_ptr<webrtc::VideoDecoderFactory> factory);
+
+}  // namespace shim
+
+/* ============================================================================
+ * Event Queue Internal Structure
+ * ========================================================================== */
+
+namespace shim {
+
+// A queued event: the public header plus its payload bytes.
+struct Event {
+    ShimEvent header{};
+    std::vector<uint8_t> payload;
+};
+
+// Bounded multi-producer/single-consumer ring (Vyukov's sequence-per-cell
+// design). Producers are libwebrtc threads and never block: when the ring is
+// full the event is dropped and counted. The consumer is serialized by
+// drain_mutex_.
+class EventRing {
+public:
+    explicit EventRing(size_t capacity);
+    ~EventRing();
+
+    // Create the notification fd. Returns false with error_out set on failure.
+    bool Init(ShimErrorBuffer* error_out);
+    int fd() const { return read_fd_; }
+
+    // Returns false if the ring was full and the event was dropped.
+    bool Push(Event event);
+    int Drain(ShimEventQueueDrainParams* params);
+
+private:
+    struct Cell {
+        std::atomic<size_t> sequence;
+        Event event;
+    };
+
+    void Notify();
+
+    std::unique_ptr<Cell[]> cells_;
+    size_t mask_;
+    alignas(64) std::atomic<size_t> enqueue_pos_{0};
+    alignas(64) size_t dequeue_pos_ = 0;
+    std::atomic<uint64_t> dropped_{0};
+    std::atomic<bool> notify_pending_{false};
+    std::mutex drain_mutex_;
+    int read_fd_ = -1;
+    int write_fd_ = -1;
+};
+
+// Where an object sends its events. Unattached targets report false from
+// Emit so the caller falls back to its callback.
+class EventTarget {
+public:
+    void Attach(std::shared_ptr<EventRing> ring, uint64_t tag);
+    bool Emit(ShimEvent header, std::vector<uint8_t> payload = {});
+
+private:
+    std::mutex mutex_;
+    std::shared_ptr<EventRing> ring_;
+    uint64_t tag_ = 0;
+};
+
+}  // namespace shim
+
+struct ShimEventQueue {
+    std::shared_ptr<shim::EventRing> ring;
+};
 
 /* ============================================================================
  * PeerConnection Internal Structure
  * ========================================================================== */
 
 struct ShimPeerConnection {
+    // Thread-group threads (if any); declared first so they outlive the PC.
+    std::shared_ptr<ShimThreadSet> threads;
     webrtc::scoped_refptr<webrtc::PeerConnectionFactoryInterface> factory;
+    // Set when the factory muxes UDP; outlives peer_connection, whose port
+    // allocator creates sockets through it.
+    std::shared_ptr<shim::UDPMuxSession> udp_mux_session;
+    // Set when the factory uses a loopback network; same lifetime rule.
+    std::shared_ptr<shim::LoopbackSession> loopback_session;
     webrtc::scoped_refptr<webrtc::PeerConnectionInterface> peer_connection;
     std::mutex mutex;
 
@@ -44,11 +309,27 @@ struct ShimPeerConnection {
     ShimOnNegotiationNeeded on_negotiation_needed = nullptr;
     void* on_negotiation_needed_ctx = nullptr;
 
+    // Replaces the callbacks above while a queue is attached
+    shim::EventTarget events;
+
     // Track senders
     std::vector<webrtc::scoped_refptr<webrtc::RtpSenderInterface>> senders;
 
     // Data channels (owned references to prevent leaks)
     std::vector<webrtc::scoped_refptr<webrtc::DataChannelInterface>> data_channels;
+
+    // Delta-mode stats state, keyed by direction << 32 | SSRC
+    std::mutex stats_mutex;
+    std::unordered_map<uint64_t, shim::StreamCounters> stats_history;
+
+    // Fed by the PeerConnection's network controller; shared with it because
+    // the controller lives in the call, which may outlive this struct.
+    std::shared_ptr<shim::BandwidthEstimator> bandwidth;
+
+    // RTCP feedback subscriptions, keyed by sender, and of the transport
+    std::mutex rtcp_feedback_mutex;
+    std::unordered_map<webrtc::RtpSenderInterface*, std::shared_ptr<shim::RTCPFeedbackSubscription>> rtcp_feedback;
+    std::shared_ptr<shim::TransportFeedbackSubscription> transport_feedback;
 };
 
 // Alias for internal struct reference
@@ -0,0 +1,456 @@
+/*
+ * shim_loopback.cc - In-process packet network for PeerConnections
+ *
+ * A LoopbackNetwork stands in for the wire between PeerConnections in the
+ * same process. Each PeerConnection created from a factory with a loopback
+ * network gets a LoopbackSession: a virtual host with its own 10.x.y.z
+ * address, a network manager that reports only that address, and UDP sockets
+ * that hand packets to the network instead of the kernel. The network applies
+ * the uplink model (queueing at the configured bandwidth, delay and random
+ * loss) and posts each surviving packet to the destination socket's network
+ * thread, so connections on different thread-group shards work as well.
+ */
+
+#include "shim_common.h"
+#include "shim_internal.h"
+
+#include <algorithm>
+#include <atomic>
+#include <cerrno>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <random>
+#include <string>
+#include <vector>
+
+#include "api/task_queue/pending_task_safety_flag.h"
+#include "api/units/time_delta.h"
+#include "api/units/timestamp.h"
+#include "p2p/base/basic_packet_socket_factory.h"
+#include "p2p/client/basic_port_allocator.h"
+#include "rtc_base/async_packet_socket.h"
+#include "rtc_base/copy_on_write_buffer.h"
+#include "rtc_base/ip_address.h"
+#include "rtc_base/network.h"
+#include "rtc_base/network/received_packet.h"
+#include "rtc_base/network/sent_packet.h"
+#include "rtc_base/socket_address.h"
+#include "rtc_base/thread.h"
+#include "rtc_base/time_utils.h"
+
+namespace shim {
+
+namespace {
+
+// Virtual hosts are numbered within 10.0.0.0/8.
+constexpr uint32_t kLoopbackPrefix = 0x0A000000;
+constexpr int kLoopbackPrefixLength = 8;
+constexpr uint32_t kMaxLoopbackHosts = 0x00FFFFFE;
+
+// Ports handed out when the allocator does not ask for a range.
+constexpr uint16_t kFirstEphemeralPort = 49152;
+
+}  // namespace
+
+class LoopbackSocket;
+
+/* ============================================================================
+ * LoopbackNetwork - the shared medium, used from any network thread
+ * ========================================================================== */
+
+class LoopbackNetwork {
+public:
+    explicit LoopbackNetwork(const ShimLoopbackNetworkCreateParams& params)
+        : delay_us_(static_cast<int64_t>(params.delay_ms) * 1000),
+          loss_rate_(params.loss_rate),
+          bandwidth_kbps_(params.bandwidth_kbps),
+          queue_us_(static_cast<int64_t>(params.queue_ms) * 1000),
+          rng_(params.seed) {}
+
+    // Returns false once the address space is exhausted.
+    bool AllocateHost(webrtc::IPAddress* ip);
+
+    // Network thread of socket. Picks a free port in [min_port, max_port]
+    // (any port when both are zero) and fills in address.
+    bool Bind(LoopbackSocket* socket, webrtc::SocketAddress* address,
+              uint16_t min_port, uint16_t max_port);
+    void Unbind(const webrtc::SocketAddress& address);
+
+    // Any thread. Loss and queue drops are silent, as on a real link.
+    void Send(const webrtc::SocketAddress& from, const webrtc::SocketAddress& to,
+              const void* data, size_t size);
+
+    void CountDelivered(size_t size) {
+        packets_delivered_.fetch_add(1, std::memory_order_relaxed);
+        bytes_delivered_.fetch_add(size, std::memory_order_relaxed);
+    }
+
+    void GetStats(ShimLoopbackNetworkStats* out) const;
+
+private:
+    struct Binding {
+        LoopbackSocket* socket;
+        webrtc::Thread* thread;
+        webrtc::scoped_refptr<webrtc::PendingTaskSafetyFlag> alive;
+    };
+
+    const int64_t delay_us_;
+    const double loss_rate_;
+    const int bandwidth_kbps_;
+    const int64_t queue_us_;
+
+    std::mutex mutex_;
+    uint32_t next_host_ = 1;
+    std::map<webrtc::SocketAddress, Binding> bindings_;
+    std::map<webrtc::IPAddress, int64_t> uplink_free_us_;   // When each host's uplink idles
+    std::mt19937 rng_;
+    std::uniform_real_distribution<double> loss_dist_{0.0, 1.0};
+
+    std::atomic<uint64_t> packets_sent_{0};
+    std::atomic<uint64_t> packets_delivered_{0};
+    std::atomic<uint64_t> bytes_delivered_{0};
+    std::atomic<uint64_t> packets_lost_{0};
+    std::atomic<uint64_t> packets_dropped_{0};
+};
+
+/* ============================================================================
+ * LoopbackSocket - what a UDPPort sees
+ * ========================================================================== */
+
+class LoopbackSocket : public webrtc::AsyncPacketSocket {
+public:
+    explicit LoopbackSocket(std::shared_ptr<LoopbackNetwork> network)
+        : network_(std::move(network)) {}
+
+    ~LoopbackSocket() override { Close(); }
+
+    // Set once LoopbackNetwork::Bind has picked the port.
+    void set_local_address(const webrtc::SocketAddress& local) { local_ = local; }
+
+    // Network thread, from a task posted by LoopbackNetwork::Send.
+    void Deliver(const webrtc::CopyOnWriteBuffer& packet, const webrtc::SocketAddress& from) {
+        if (closed_) {
+            return;
+        }
+        network_->CountDelivered(packet.size());
+        NotifyPacketReceived(webrtc::ReceivedIpPacket(
+            webrtc::ArrayView<const uint8_t>(packet.cdata(), packet.size()), from,
+            webrtc::Timestamp::Micros(webrtc::TimeMicros())));
+    }
+
+    // webrtc::AsyncPacketSocket
+    webrtc::SocketAddress GetLocalAddress() const override { return local_; }
+    webrtc::SocketAddress GetRemoteAddress() const override { return webrtc::SocketAddress(); }
+
+    int Send(const void* pv, size_t cb, const webrtc::AsyncSocketPacketOptions& options) override {
+        error_ = ENOTCONN;
+        return -1;
+    }
+
+    int SendTo(const void* pv, size_t cb, const webrtc::SocketAddress& addr,
+               const webrtc::AsyncSocketPacketOptions& options) override {
+        if (closed_) {
+            error_ = EBADF;
+            return -1;
+        }
+
+        webrtc::SentPacketInfo sent_packet(options.packet_id, webrtc::TimeMillis(),
+                                           options.info_signaled_after_sent);
+        webrtc::CopySocketInformationToPacketInfo(cb, *this, &sent_packet.info);
+
+        network_->Send(local_, addr, pv, cb);
+        SignalSentPacket(this, sent_packet);
+        return static_cast<int>(cb);
+    }
+
+    int Close() override {
+        if (!closed_) {
+            closed_ = true;
+            network_->Unbind(local_);
+        }
+        return 0;
+    }
+
+    State GetState() const override { return closed_ ? STATE_CLOSED : STATE_BOUND; }
+
+    // There is no kernel socket to apply options to.
+    int GetOption(webrtc::Socket::Option opt, int* value) override {
+        error_ = ENOPROTOOPT;
+        return -1;
+    }
+    int SetOption(webrtc::Socket::Option opt, int value) override { return 0; }
+
+    int GetError() const override { return error_; }
+    void SetError(int error) override { error_ = error; }
+
+private:
+    std::shared_ptr<LoopbackNetwork> network_;
+    webrtc::SocketAddress local_;
+    bool closed_ = false;
+    int error_ = 0;
+};
+
+/* ============================================================================
+ * LoopbackNetworkManager - reports the session's single virtual interface
+ * ========================================================================== */
+
+class LoopbackNetworkManager : public webrtc::NetworkManagerBase {
+public:
+    explicit LoopbackNetworkManager(const webrtc::IPAddress& ip) : ip_(ip) {}
+
+    void StartUpdating() override {
+        if (start_count_++ > 0) {
+            if (updated_) {
+                webrtc::Thread::Current()->PostTask(
+                    webrtc::SafeTask(safety_.flag(), [this] { SignalNetworksChanged(); }));
+            }
+            return;
+        }
+        webrtc::Thread::Current()->PostTask(
+            webrtc::SafeTask(safety_.flag(), [this] { UpdateNetworks(); }));
+    }
+
+    void StopUpdating() override {
+        if (start_count_ > 0) {
+            start_count_--;
+        }
+    }
+
+private:
+    void UpdateNetworks() {
+        std::vector<std::unique_ptr<webrtc::Network>> networks;
+        auto network = std::make_unique<webrtc::Network>(
+            "shim-loopback", "shim loopback network",
+            webrtc::TruncateIP(ip_, kLoopbackPrefixLength), kLoopbackPrefixLength,
+            webrtc::ADAPTER_TYPE_ETHERNET);
+        network->AddIP(webrtc::InterfaceAddress(ip_));
+        networks.push_back(std::move(network));
+
+        bool changed = false;
+        MergeNetworkList(std::move(networks), &changed);
+        if (changed || !updated_) {
+            updated_ = true;
+            SignalNetworksChanged();
+        }
+    }
+
+    webrtc::IPAddress ip_;
+    int start_count_ = 0;
+    bool updated_ = false;
+    webrtc::ScopedTaskSafety safety_;
+};
+
+/* ============================================================================
+ * LoopbackSession - per-PeerConnection virtual host
+ * ========================================================================== */
+
+class LoopbackSession : public webrtc::BasicPacketSocketFactory {
+public:
+    LoopbackSession(std::shared_ptr<LoopbackNetwork> network, webrtc::Thread* network_thread,
+                    const webrtc::IPAddress& ip)
+        : webrtc::BasicPacketSocketFactory(network_thread->socketserver()),
+          network_(std::move(network)),
+          network_thread_(network_thread),
+          ip_(ip),
+          network_manager_(std::make_unique<LoopbackNetworkManager>(ip)) {}
+
+    ~LoopbackSession() override {
+        // The network manager posts to, and must die on, the network thread.
+        network_thread_->BlockingCall([this] { network_manager_.reset(); });
+    }
+
+    // UDP goes through the loopback network; TCP is disabled on the allocator.
+    webrtc::AsyncPacketSocket* CreateUdpSocket(const webrtc::SocketAddress& address,
+                                               uint16_t min_port,
+                                               uint16_t max_port) override {
+        if (address.ipaddr() != ip_) {
+            return nullptr;
+        }
+        webrtc::SocketAddress local(ip_, 0);
+        auto socket = std::make_unique<LoopbackSocket>(network_);
+        if (!network_->Bind(socket.get(), &local, min_port, max_port)) {
+            return nullptr;
+        }
+        socket->set_local_address(local);
+        return socket.release();
+    }
+
+    webrtc::NetworkManager* network_manager() const { return network_manager_.get(); }
+
+private:
+    std::shared_ptr<LoopbackNetwork> network_;
+    webrtc::Thread* network_thread_;
+    webrtc::IPAddress ip_;
+    std::unique_ptr<LoopbackNetworkManager> network_manager_;
+};
+
+/* ============================================================================
+ * LoopbackNetwork implementation
+ * ========================================================================== */
+
+bool LoopbackNetwork::AllocateHost(webrtc::IPAddress* ip) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (next_host_ > kMaxLoopbackHosts) {
+        return false;
+    }
+    *ip = webrtc::IPAddress(kLoopbackPrefix | next_host_++);
+    return true;
+}
+
+bool LoopbackNetwork::Bind(LoopbackSocket* socket, webrtc::SocketAddress* address,
+                           uint16_t min_port, uint16_t max_port) {
+    if (min_port == 0 && max_port == 0) {
+        min_port = kFirstEphemeralPort;
+        max_port = 65535;
+    }
+    std::lock_guard<std::mutex> lock(mutex_);
+    for (uint32_t port = min_port; port <= max_port; port++) {
+        webrtc::SocketAddress candidate(address->ipaddr(), static_cast<int>(port));
+        if (bindings_.count(candidate)) {
+            continue;
+        }
+        bindings_[candidate] = Binding{socket, webrtc::Thread::Current(),
+                                       webrtc::PendingTaskSafetyFlag::Create()};
+        *address = candidate;
+        return true;
+    }
+    return false;
+}
+
+void LoopbackNetwork::Unbind(const webrtc::SocketAddress& address) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    auto it = bindings_.find(address);
+    if (it == bindings_.end()) {
+        return;
+    }
+    // Packets already posted to the socket are dropped when they run.
+    it->second.alive->SetNotAlive();
+    bindings_.erase(it);
+}
+
+void LoopbackNetwork::Send(const webrtc::SocketAddress& from, const webrtc::SocketAddress& to,
+                           const void* data, size_t size) {
+    packets_sent_.fetch_add(1, std::memory_order_relaxed);
+
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (loss_rate_ > 0 && loss_dist_(rng_) < loss_rate_) {
+        packets_lost_.fetch_add(1, std::memory_order_relaxed);
+        return;
+    }
+
+    // The uplink serializes the host's packets at bandwidth_kbps; a packet
+    // leaves once the ones ahead of it have.
+    int64_t now_us = webrtc::TimeMicros();
+    int64_t departure_us = now_us;
+    if (bandwidth_kbps_ > 0) {
+        int64_t& free_us = uplink_free_us_[from.ipaddr()];
+        int64_t start_us = std::max(now_us, free_us);
+        if (queue_us_ > 0 && start_us - now_us > queue_us_) {
+            packets_dropped_.fetch_add(1, std::memory_order_relaxed);
+            return;
+        }
+        departure_us = start_us + static_cast<int64_t>(size) * 8 * 1000 / bandwidth_kbps_;
+        free_us = departure_us;
+    }
+
+    auto it = bindings_.find(to);
+    if (it == bindings_.end()) {
+        packets_dropped_.fetch_add(1, std::memory_order_relaxed);
+        return;
+    }
+
+    // Posted under the lock: the destination unbinds, under the same lock,
+    // before its network thread can go away.
+    LoopbackSocket* socket = it->second.socket;
+    auto task = webrtc::SafeTask(
+        it->second.alive,
+        [socket, packet = webrtc::CopyOnWriteBuffer(static_cast<const uint8_t*>(data), size), from] {
+            socket->Deliver(packet, from);
+        });
+    int64_t wait_us = departure_us + delay_us_ - now_us;
+    if (wait_us > 0) {
+        it->second.thread->PostDelayedHighPrecisionTask(std::move(task),
+                                                        webrtc::TimeDelta::Micros(wait_us));
+    } else {
+        it->second.thread->PostTask(std::move(task));
+    }
+}
+
+void LoopbackNetwork::GetStats(ShimLoopbackNetworkStats* out) const {
+    out->packets_sent = packets_sent_.load(std::memory_order_relaxed);
+    out->packets_delivered = packets_delivered_.load(std::memory_order_relaxed);
+    out->bytes_delivered = bytes_delivered_.load(std::memory_order_relaxed);
+    out->packets_lost = packets_lost_.load(std::memory_order_relaxed);
+    out->packets_dropped = packets_dropped_.load(std::memory_order_relaxed);
+}
+
+/* ============================================================================
+ * Internal API
+ * ========================================================================== */
+
+std::shared_ptr<LoopbackSession> CreateLoopbackSession(
+    std::shared_ptr<LoopbackNetwork> network, webrtc::Thread* network_thread) {
+    webrtc::IPAddress ip;
+    if (!network->AllocateHost(&ip)) {
+        return nullptr;
+    }
+    return std::make_shared<LoopbackSession>(std::move(network), network_thread, ip);
+}
+
+std::unique_ptr<webrtc::PortAllocator> CreateLoopbackPortAllocator(LoopbackSession* session) {
+    auto allocator = std::make_unique<webrtc::BasicPortAllocator>(
+        GetEnvironment(), session->network_manager(), session);
+    // Only host candidates exist on the loopback network.
+    allocator->set_flags(allocator->flags() | webrtc::PORTALLOCATOR_DISABLE_TCP |
+                         webrtc::PORTALLOCATOR_DISABLE_STUN |
+                         webrtc::PORTALLOCATOR_DISABLE_RELAY);
+    return allocator;
+}
+
+}  // namespace shim
+
+/* ============================================================================
+ * Loopback Network API Implementation
+ * ========================================================================== */
+
+extern "C" {
+
+SHIM_EXPORT ShimLoopbackNetwork* shim_loopback_network_create(ShimLoopbackNetworkCreateParams* params) {
+    if (!params) {
+        return nullptr;
+    }
+    if (params->delay_ms < 0 || params->bandwidth_kbps < 0 || params->queue_ms < 0) {
+        shim::SetErrorMessage(params->error_out,
+                              "delay_ms, bandwidth_kbps and queue_ms must be >= 0",
+                              SHIM_ERROR_INVALID_PARAM);
+        return nullptr;
+    }
+    if (!(params->loss_rate >= 0 && params->loss_rate < 1)) {
+        shim::SetErrorMessage(params->error_out, "loss_rate must be in [0, 1)",
+                              SHIM_ERROR_INVALID_PARAM);
+        return nullptr;
+    }
+
+    auto network = std::make_unique<ShimLoopbackNetwork>();
+    network->network = std::make_shared<shim::LoopbackNetwork>(*params);
+    shim::ClearError(params->error_out);
+    return network.release();
+}
+
+SHIM_EXPORT void shim_loopback_network_destroy(ShimLoopbackNetwork* network) {
+    delete network;
+}
+
+SHIM_EXPORT void shim_loopback_network_get_stats(ShimLoopbackNetwork* network,
+                                                 ShimLoopbackNetworkStats* out) {
+    if (!out) {
+        return;
+    }
+    *out = {};
+    if (network) {
+        network->network->GetStats(out);
+    }
+}
+
+}  // extern "C"
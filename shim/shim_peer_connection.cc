@@ -8,31 +8,26 @@
 
 #include "shim_common.h"
 
+#include <algorithm>
+#include <chrono>
 #include <condition_variable>
+#include <cstdlib>
 #include <cstring>
+#include <deque>
 #include <map>
+#include <thread>
 #include <vector>
 
 #include "rtc_base/thread.h"
 #include "api/peer_connection_interface.h"
-#include "api/create_peerconnection_factory.h"
-#include "api/audio_codecs/builtin_audio_encoder_factory.h"
-#include "api/audio_codecs/builtin_audio_decoder_factory.h"
 #include "api/media_types.h"
-#include "api/video_codecs/builtin_video_encoder_factory.h"
-#include "api/video_codecs/builtin_video_decoder_factory.h"
 #include "api/data_channel_interface.h"
 #include "api/rtp_sender_interface.h"
 #include "api/rtp_receiver_interface.h"
 #include "api/rtp_transceiver_interface.h"
-#include "api/stats/rtc_stats.h"
-#include "api/stats/rtc_stats_report.h"
-#include "api/stats/rtcstats_objects.h"
 #include "api/scoped_refptr.h"
 #include "rtc_base/ref_counted_object.h"
 #include "media/base/media_channel.h"
-#include "media/engine/internal_encoder_factory.h"
-#include "media/engine/internal_decoder_factory.h"
 #include "rtc_base/time_utils.h"
 
 // Include internal structure definition
@@ -47,12 +42,22 @@ public:
     explicit PeerConnectionObserver(ShimPeerConnection* pc) : pc_(pc) {}
 
     void OnSignalingChange(webrtc::PeerConnectionInterface::SignalingState state) override {
+        if (EmitState(SHIM_EVENT_SIGNALING_STATE, static_cast<int>(state))) {
+            return;
+        }
         if (pc_->on_signaling_state_change) {
             pc_->on_signaling_state_change(pc_->on_signaling_state_change_ctx, static_cast<int>(state));
         }
     }
 
     void OnDataChannel(webrtc::scoped_refptr<webrtc::DataChannelInterface> channel) override {
+        ShimEvent event{};
+        event.type = SHIM_EVENT_DATA_CHANNEL;
+        event.object = channel.get();
+        if (pc_->events.Emit(event)) {
+            pc_->data_channels.push_back(channel);
+            return;
+        }
         if (pc_->on_data_channel) {
             // Store in PC's data_channels vector to maintain proper reference count
             pc_->data_channels.push_back(channel);
@@ -62,28 +67,48 @@ public:
     }
 
     void OnRenegotiationNeeded() override {
+        if (EmitState(SHIM_EVENT_NEGOTIATION_NEEDED, 0)) {
+            return;
+        }
         if (pc_->on_negotiation_needed) {
             pc_->on_negotiation_needed(pc_->on_negotiation_needed_ctx);
         }
     }
 
     void OnIceConnectionChange(webrtc::PeerConnectionInterface::IceConnectionState state) override {
+        if (EmitState(SHIM_EVENT_ICE_CONNECTION_STATE, static_cast<int>(state))) {
+            return;
+        }
         if (pc_->on_ice_connection_state_change) {
             pc_->on_ice_connection_state_change(pc_->on_ice_connection_state_change_ctx, static_cast<int>(state));
         }
     }
 
     void OnIceGatheringChange(webrtc::PeerConnectionInterface::IceGatheringState state) override {
+        if (EmitState(SHIM_EVENT_ICE_GATHERING_STATE, static_cast<int>(state))) {
+            return;
+        }
         if (pc_->on_ice_gathering_state_change) {
             pc_->on_ice_gathering_state_change(pc_->on_ice_gathering_state_change_ctx, static_cast<int>(state));
         }
     }
 
     void OnIceCandidate(const webrtc::IceCandidateInterface* candidate) override {
-        if (pc_->on_ice_candidate) {
-            std::string sdp;
-            candidate->ToString(&sdp);
+        std::string sdp;
+        candidate->ToString(&sdp);
+
+        // Payload is "candidate\0sdp_mid"
+        std::vector<uint8_t> payload(sdp.begin(), sdp.end());
+        payload.push_back(0);
+        payload.insert(payload.end(), candidate->sdp_mid().begin(), candidate->sdp_mid().end());
+        ShimEvent event{};
+        event.type = SHIM_EVENT_ICE_CANDIDATE;
+        event.value = candidate->sdp_mline_index();
+        if (pc_->events.Emit(event, std::move(payload))) {
+            return;
+        }
 
+        if (pc_->on_ice_candidate) {
             ShimICECandidate shim_candidate;
             shim_candidate.candidate = sdp.c_str();
             shim_candidate.sdp_mid = candidate->sdp_mid().c_str();
@@ -94,20 +119,38 @@ public:
     }
 
     void OnConnectionChange(webrtc::PeerConnectionInterface::PeerConnectionState state) override {
+        if (EmitState(SHIM_EVENT_CONNECTION_STATE, static_cast<int>(state))) {
+            return;
+        }
         if (pc_->on_connection_state_change) {
             pc_->on_connection_state_change(pc_->on_connection_state_change_ctx, static_cast<int>(state));
         }
     }
 
     void OnTrack(webrtc::scoped_refptr<webrtc::RtpTransceiverInterface> transceiver) override {
+        auto receiver = transceiver->receiver();
+        auto track = receiver->track();
+
+        ShimEvent event{};
+        event.type = SHIM_EVENT_TRACK;
+        event.object = track.get();
+        event.object2 = receiver.get();
+        if (pc_->events.Emit(event)) {
+            return;
+        }
         if (pc_->on_track) {
-            auto receiver = transceiver->receiver();
-            auto track = receiver->track();
             pc_->on_track(pc_->on_track_ctx, track.get(), receiver.get(), "");
         }
     }
 
 private:
+    bool EmitState(int type, int value) {
+        ShimEvent event{};
+        event.type = type;
+        event.value = value;
+        return pc_->events.Emit(event);
+    }
+
     ShimPeerConnection* pc_;
 };
 
@@ -115,75 +158,282 @@ private:
 static std::map<ShimPeerConnection*, std::unique_ptr<PeerConnectionObserver>> g_pc_observers;
 static std::mutex g_pc_observers_mutex;
 
-/* ============================================================================
- * C API Implementation
- * ========================================================================== */
+namespace {
 
-extern "C" {
+std::string RTCErrorMessage(const webrtc::RTCError& error) {
+    std::string message = error.message();
+    if (message.empty()) {
+        message = webrtc::ToString(error.type());
+    }
+    return message;
+}
 
-SHIM_EXPORT ShimPeerConnection* shim_peer_connection_create(ShimPeerConnectionCreateParams* params) {
-    shim::InitializeGlobals();
+// Parse an SDP string into a session description. Returns nullptr with
+// error_out set if the type or SDP is invalid.
+std::unique_ptr<webrtc::SessionDescriptionInterface> ParseSessionDescription(
+    int type,
+    const char* sdp,
+    ShimErrorBuffer* error_out
+) {
+    webrtc::SdpType sdp_type;
+    switch (type) {
+        case 0: sdp_type = webrtc::SdpType::kOffer; break;
+        case 1: sdp_type = webrtc::SdpType::kPrAnswer; break;
+        case 2: sdp_type = webrtc::SdpType::kAnswer; break;
+        default:
+            shim::SetErrorMessage(error_out, "invalid SDP type", SHIM_ERROR_INVALID_PARAM);
+            return nullptr;
+    }
 
-    if (!params) {
+    webrtc::SdpParseError parse_error;
+    auto desc = webrtc::CreateSessionDescription(sdp_type, sdp, &parse_error);
+    if (!desc) {
+        std::string msg = "SDP parse error";
+        if (!parse_error.description.empty()) {
+            msg += ": " + parse_error.description;
+        }
+        shim::SetErrorMessage(error_out, msg, SHIM_ERROR_INVALID_PARAM);
         return nullptr;
     }
+    return desc;
+}
 
-    auto pc = std::make_unique<ShimPeerConnection>();
-    const ShimPeerConnectionConfig* config = params->config;
-    ShimErrorBuffer* error_out = params->error_out;
+// Map a ShimPeerConnectionConfig onto an RTCConfiguration. Returns false with
+// error_out set if a policy string or the port range is invalid.
+bool BuildRTCConfiguration(
+    const ShimPeerConnectionConfig* config,
+    webrtc::PeerConnectionInterface::RTCConfiguration* rtc_config,
+    ShimErrorBuffer* error_out
+) {
+    using Config = webrtc::PeerConnectionInterface::RTCConfiguration;
+    using PCI = webrtc::PeerConnectionInterface;
+
+    rtc_config->sdp_semantics = webrtc::SdpSemantics::kUnifiedPlan;
+    if (!config) {
+        return true;
+    }
+
+    for (int i = 0; i < config->ice_server_count; i++) {
+        PCI::IceServer server;
+        for (int j = 0; j < config->ice_servers[i].url_count; j++) {
+            server.urls.push_back(config->ice_servers[i].urls[j]);
+        }
+        if (config->ice_servers[i].username) {
+            server.username = config->ice_servers[i].username;
+        }
+        if (config->ice_servers[i].credential) {
+            server.password = config->ice_servers[i].credential;
+        }
+        rtc_config->servers.push_back(server);
+    }
 
-    // Create encoder/decoder factories.
-    bool use_software = shim::ShouldUseSoftwareCodecs();
-    auto video_encoder_factory = use_software
-        ? std::make_unique<webrtc::InternalEncoderFactory>()
-        : webrtc::CreateBuiltinVideoEncoderFactory();
-    auto video_decoder_factory = use_software
-        ? std::make_unique<webrtc::InternalDecoderFactory>()
-        : webrtc::CreateBuiltinVideoDecoderFactory();
-
-    // Create PeerConnectionFactory
-    pc->factory = webrtc::CreatePeerConnectionFactory(
-        shim::GetNetworkThread(),
-        shim::GetWorkerThread(),
-        shim::GetSignalingThread(),
-        nullptr,  // default_adm
-        webrtc::CreateBuiltinAudioEncoderFactory(),
-        webrtc::CreateBuiltinAudioDecoderFactory(),
-        std::move(video_encoder_factory),
-        std::move(video_decoder_factory),
-        nullptr,  // audio_mixer
-        nullptr   // audio_processing
-    );
+    auto invalid = [error_out](const char* field, const char* value) {
+        shim::SetErrorMessage(error_out, std::string("invalid ") + field + ": " + value,
+                              SHIM_ERROR_INVALID_PARAM);
+        return false;
+    };
 
-    if (!pc->factory) {
-        shim::SetErrorMessage(error_out, "PeerConnectionFactory creation failed");
-        return nullptr;
+    if (config->ice_candidate_pool_size < 0) {
+        return invalid("ice_candidate_pool_size", std::to_string(config->ice_candidate_pool_size).c_str());
     }
+    rtc_config->ice_candidate_pool_size = config->ice_candidate_pool_size;
 
-    // Configure ICE servers
-    webrtc::PeerConnectionInterface::RTCConfiguration rtc_config;
-    rtc_config.sdp_semantics = webrtc::SdpSemantics::kUnifiedPlan;
+    if (const char* v = config->bundle_policy; v && *v) {
+        if (strcmp(v, "balanced") == 0) {
+            rtc_config->bundle_policy = PCI::kBundlePolicyBalanced;
+        } else if (strcmp(v, "max-compat") == 0) {
+            rtc_config->bundle_policy = PCI::kBundlePolicyMaxCompat;
+        } else if (strcmp(v, "max-bundle") == 0) {
+            rtc_config->bundle_policy = PCI::kBundlePolicyMaxBundle;
+        } else {
+            return invalid("bundle_policy", v);
+        }
+    }
 
-    if (config) {
-        for (int i = 0; i < config->ice_server_count; i++) {
-            webrtc::PeerConnectionInterface::IceServer server;
-            for (int j = 0; j < config->ice_servers[i].url_count; j++) {
-                server.urls.push_back(config->ice_servers[i].urls[j]);
-            }
-            if (config->ice_servers[i].username) {
-                server.username = config->ice_servers[i].username;
-            }
-            if (config->ice_servers[i].credential) {
-                server.password = config->ice_servers[i].credential;
+    if (const char* v = config->rtcp_mux_policy; v && *v) {
+        if (strcmp(v, "require") == 0) {
+            rtc_config->rtcp_mux_policy = PCI::kRtcpMuxPolicyRequire;
+        } else if (strcmp(v, "negotiate") == 0) {
+            rtc_config->rtcp_mux_policy = PCI::kRtcpMuxPolicyNegotiate;
+        } else {
+            return invalid("rtcp_mux_policy", v);
+        }
+    }
+
+    if (const char* v = config->ice_transport_policy; v && *v) {
+        if (strcmp(v, "all") == 0) {
+            rtc_config->type = PCI::kAll;
+        } else if (strcmp(v, "relay") == 0) {
+            rtc_config->type = PCI::kRelay;
+        } else if (strcmp(v, "nohost") == 0) {
+            rtc_config->type = PCI::kNoHost;
+        } else {
+            return invalid("ice_transport_policy", v);
+        }
+    }
+
+    if (const char* v = config->candidate_network_policy; v && *v) {
+        if (strcmp(v, "all") == 0) {
+            rtc_config->candidate_network_policy = PCI::kCandidateNetworkPolicyAll;
+        } else if (strcmp(v, "low-cost") == 0) {
+            rtc_config->candidate_network_policy = PCI::kCandidateNetworkPolicyLowCost;
+        } else {
+            return invalid("candidate_network_policy", v);
+        }
+    }
+
+    if (const char* v = config->tcp_candidate_policy; v && *v) {
+        if (strcmp(v, "enabled") == 0) {
+            rtc_config->tcp_candidate_policy = PCI::kTcpCandidatePolicyEnabled;
+        } else if (strcmp(v, "disabled") == 0) {
+            rtc_config->tcp_candidate_policy = PCI::kTcpCandidatePolicyDisabled;
+        } else {
+            return invalid("tcp_candidate_policy", v);
+        }
+    }
+
+    if (config->port_range_min != 0 || config->port_range_max != 0) {
+        if (config->port_range_min <= 0 || config->port_range_max > 65535 ||
+            config->port_range_min > config->port_range_max) {
+            std::string range = std::to_string(config->port_range_min) + "-" +
+                                std::to_string(config->port_range_max);
+            return invalid("port range", range.c_str());
+        }
+        rtc_config->port_allocator_config.min_port = config->port_range_min;
+        rtc_config->port_allocator_config.max_port = config->port_range_max;
+    }
+
+    if (config->continual_gathering) {
+        rtc_config->continual_gathering_policy = Config::GATHER_CONTINUALLY;
+    }
+
+    if (config->ice_check_interval_ms < 0 || config->ice_check_min_interval_ms < 0) {
+        return invalid("ICE check interval", "must be >= 0");
+    }
+    if (config->ice_check_interval_ms > 0) {
+        rtc_config->ice_check_interval_strong_connectivity = config->ice_check_interval_ms;
+    }
+    if (config->ice_check_min_interval_ms > 0) {
+        rtc_config->ice_check_min_interval = config->ice_check_min_interval_ms;
+    }
+
+    return true;
+}
+
+webrtc::PeerConnectionInterface::RTCOfferAnswerOptions OfferAnswerOptions(
+    int ice_restart, int voice_activity_detection
+) {
+    webrtc::PeerConnectionInterface::RTCOfferAnswerOptions options;
+    options.ice_restart = ice_restart != 0;
+    options.voice_activity_detection = voice_activity_detection != 0;
+    return options;
+}
+
+// The signaling thread operations of pc run on.
+webrtc::Thread* SignalingThread(const ShimPeerConnection* pc) {
+    return pc->threads ? pc->threads->signaling.get() : shim::GetSignalingThread();
+}
+
+// Completion observers for the async offer/answer/description APIs. They run
+// on the signaling thread and hand the result straight to the C callback.
+class AsyncCreateSessionDescriptionObserver
+    : public webrtc::CreateSessionDescriptionObserver {
+public:
+    AsyncCreateSessionDescriptionObserver(ShimOnSessionDescriptionComplete callback, void* ctx)
+        : callback_(callback), ctx_(ctx) {}
+
+    void OnSuccess(webrtc::SessionDescriptionInterface* desc) override {
+        std::string sdp;
+        desc->ToString(&sdp);
+        // Ownership of the description passes to the observer.
+        delete desc;
+
+        char* buffer = static_cast<char*>(malloc(sdp.size() + 1));
+        if (!buffer) {
+            callback_(ctx_, SHIM_ERROR_OUT_OF_MEMORY, nullptr, 0, "failed to allocate SDP buffer");
+            return;
+        }
+        memcpy(buffer, sdp.c_str(), sdp.size() + 1);
+        callback_(ctx_, SHIM_OK, buffer, static_cast<int>(sdp.size()), nullptr);
+    }
+
+    void OnFailure(webrtc::RTCError error) override {
+        std::string message = RTCErrorMessage(error);
+        callback_(ctx_, SHIM_ERROR_INIT_FAILED, nullptr, 0, message.c_str());
+    }
+
+private:
+    ShimOnSessionDescriptionComplete callback_;
+    void* ctx_;
+};
+
+class AsyncSetSessionDescriptionObserver
+    : public webrtc::SetSessionDescriptionObserver {
+public:
+    AsyncSetSessionDescriptionObserver(ShimOnSessionDescriptionComplete callback, void* ctx)
+        : callback_(callback), ctx_(ctx) {}
+
+    void OnSuccess() override {
+        callback_(ctx_, SHIM_OK, nullptr, 0, nullptr);
+    }
+
+    void OnFailure(webrtc::RTCError error) override {
+        std::string message = RTCErrorMessage(error);
+        callback_(ctx_, SHIM_ERROR_INIT_FAILED, nullptr, 0, message.c_str());
+    }
+
+private:
+    ShimOnSessionDescriptionComplete callback_;
+    void* ctx_;
+};
+
+// Create a PeerConnection on factory, or on a private factory when factory
+// is NULL. Returns nullptr with error_out set on failure.
+ShimPeerConnection* CreatePeerConnection(
+    ShimPeerConnectionFactory* factory,
+    const webrtc::PeerConnectionInterface::RTCConfiguration& rtc_config,
+    const shim::NetworkControllerSettings& network_controller,
+    ShimErrorBuffer* error_out
+) {
+    auto pc = std::make_unique<ShimPeerConnection>();
+
+    // Share the caller's factory, or build a private one for this connection.
+    if (factory) {
+        pc->threads = factory->threads;
+        pc->factory = factory->factory;
+        if (factory->udp_mux) {
+            pc->udp_mux_session = shim::CreateUDPMuxSession(factory->udp_mux);
+        }
+        if (factory->loopback_network) {
+            webrtc::Thread* network_thread = factory->threads
+                ? factory->threads->network.get()
+                : shim::GetNetworkThread();
+            pc->loopback_session = shim::CreateLoopbackSession(
+                factory->loopback_network, network_thread);
+            if (!pc->loopback_session) {
+                shim::SetErrorMessage(error_out, "loopback network has no free addresses");
+                return nullptr;
             }
-            rtc_config.servers.push_back(server);
         }
+    } else {
+        pc->factory = shim::CreatePeerConnectionFactory(nullptr, nullptr, error_out);
+    }
+
+    if (!pc->factory) {
+        return nullptr;
     }
 
     // Create observer and PeerConnection
     auto observer = std::make_unique<PeerConnectionObserver>(pc.get());
 
     webrtc::PeerConnectionDependencies deps(observer.get());
+    pc->bandwidth = std::make_shared<shim::BandwidthEstimator>();
+    deps.network_controller_factory = shim::CreateNetworkControllerFactory(network_controller, pc->bandwidth);
+    if (pc->udp_mux_session) {
+        deps.allocator = shim::CreateUDPMuxPortAllocator(pc->udp_mux_session.get());
+    } else if (pc->loopback_session) {
+        deps.allocator = shim::CreateLoopbackPortAllocator(pc->loopback_session.get());
+    }
 
     auto result = pc->factory->CreatePeerConnectionOrError(rtc_config, std::move(deps));
     if (!result.ok()) {
@@ -202,11 +452,42 @@ SHIM_EXPORT ShimPeerConnection* shim_peer_connection_create(ShimPeerConnectionCr
     return pc.release();
 }
 
+}  // namespace
+
+/* ============================================================================
+ * C API Implementation
+ * ========================================================================== */
+
+extern "C" {
+
+SHIM_EXPORT ShimPeerConnection* shim_peer_connection_create(ShimPeerConnectionCreateParams* params) {
+    shim::InitializeGlobals();
+
+    if (!params) {
+        return nullptr;
+    }
+
+    // Validate the configuration before paying for a factory.
+    webrtc::PeerConnectionInterface::RTCConfiguration rtc_config;
+    if (!BuildRTCConfiguration(params->config, &rtc_config, params->error_out)) {
+        return nullptr;
+    }
+    shim::NetworkControllerSettings network_controller;
+    if (!shim::BuildNetworkControllerSettings(params->config, &network_controller, params->error_out)) {
+        return nullptr;
+    }
+    return CreatePeerConnection(params->factory, rtc_config, network_controller, params->error_out);
+}
+
 SHIM_EXPORT void shim_peer_connection_destroy(ShimPeerConnection* pc) {
     if (pc) {
         if (pc->peer_connection) {
             pc->peer_connection->Close();
         }
+        if (pc->bandwidth) {
+            pc->bandwidth->SetCallback(nullptr, nullptr);
+        }
+        shim::StopRTCPFeedback(pc);
 
         // Clean up observer
         {
@@ -317,8 +598,8 @@ SHIM_EXPORT int shim_peer_connection_create_offer(ShimPeerConnectionCreateOfferP
 
     auto observer = webrtc::make_ref_counted<CreateSessionDescriptionObserver>();
 
-    webrtc::PeerConnectionInterface::RTCOfferAnswerOptions options;
-    params->pc->peer_connection->CreateOffer(observer.get(), options);
+    params->pc->peer_connection->CreateOffer(
+        observer.get(), OfferAnswerOptions(params->ice_restart, params->voice_activity_detection));
 
     // Wait for completion
     {
@@ -386,8 +667,8 @@ SHIM_EXPORT int shim_peer_connection_create_answer(ShimPeerConnectionCreateAnswe
 
     auto observer = webrtc::make_ref_counted<CreateSessionDescriptionObserver>();
 
-    webrtc::PeerConnectionInterface::RTCOfferAnswerOptions options;
-    params->pc->peer_connection->CreateAnswer(observer.get(), options);
+    params->pc->peer_connection->CreateAnswer(
+        observer.get(), OfferAnswerOptions(0, params->voice_activity_detection));
 
     // Wait for completion
     {
@@ -421,26 +702,14 @@ SHIM_EXPORT int shim_peer_connection_set_local_description(ShimPeerConnectionSet
         return SHIM_ERROR_INVALID_PARAM;
     }
 
-    webrtc::SdpType sdp_type;
-    switch (params->type) {
-        case 0: sdp_type = webrtc::SdpType::kOffer; break;
-        case 1: sdp_type = webrtc::SdpType::kPrAnswer; break;
-        case 2: sdp_type = webrtc::SdpType::kAnswer; break;
-        default:
-            shim::SetErrorMessage(params->error_out, "invalid SDP type", SHIM_ERROR_INVALID_PARAM);
-            return SHIM_ERROR_INVALID_PARAM;
-    }
-
-    webrtc::SdpParseError parse_error;
-    auto desc = webrtc::CreateSessionDescription(sdp_type, params->sdp, &parse_error);
+    auto desc = ParseSessionDescription(params->type, params->sdp, params->error_out);
     if (!desc) {
-        std::string msg = "SDP parse error";
-        if (!parse_error.description.empty()) {
-            msg += ": " + parse_error.description;
-        }
-        shim::SetErrorMessage(params->error_out, msg, SHIM_ERROR_INVALID_PARAM);
         return SHIM_ERROR_INVALID_PARAM;
     }
+    if (params->pc->udp_mux_session) {
+        // Checks can arrive as soon as the remote sees this description.
+        shim::UDPMuxSessionAddLocalDescription(params->pc->udp_mux_session.get(), params->sdp);
+    }
 
     class SetSessionDescriptionObserver
         : public webrtc::SetSessionDescriptionObserver {
@@ -494,24 +763,8 @@ SHIM_EXPORT int shim_peer_connection_set_remote_description(ShimPeerConnectionSe
         return SHIM_ERROR_INVALID_PARAM;
     }
 
-    webrtc::SdpType sdp_type;
-    switch (params->type) {
-        case 0: sdp_type = webrtc::SdpType::kOffer; break;
-        case 1: sdp_type = webrtc::SdpType::kPrAnswer; break;
-        case 2: sdp_type = webrtc::SdpType::kAnswer; break;
-        default:
-            shim::SetErrorMessage(params->error_out, "invalid SDP type", SHIM_ERROR_INVALID_PARAM);
-            return SHIM_ERROR_INVALID_PARAM;
-    }
-
-    webrtc::SdpParseError parse_error;
-    auto desc = webrtc::CreateSessionDescription(sdp_type, params->sdp, &parse_error);
+    auto desc = ParseSessionDescription(params->type, params->sdp, params->error_out);
     if (!desc) {
-        std::string msg = "SDP parse error";
-        if (!parse_error.description.empty()) {
-            msg += ": " + parse_error.description;
-        }
-        shim::SetErrorMessage(params->error_out, msg, SHIM_ERROR_INVALID_PARAM);
         return SHIM_ERROR_INVALID_PARAM;
     }
 
@@ -558,6 +811,101 @@ SHIM_EXPORT int shim_peer_connection_set_remote_description(ShimPeerConnectionSe
     return SHIM_OK;
 }
 
+SHIM_EXPORT int shim_peer_connection_create_offer_async(ShimPeerConnectionCreateOfferAsyncParams* params) {
+    if (!params) {
+        return SHIM_ERROR_INVALID_PARAM;
+    }
+    if (!params->pc || !params->pc->peer_connection || !params->callback) {
+        return shim::SetErrorMessage(params->error_out, "invalid parameter", SHIM_ERROR_INVALID_PARAM);
+    }
+
+    // Calling through the proxy would block until the signaling thread gets
+    // to the call; post it instead so a busy signaling thread never stalls us.
+    auto observer = webrtc::make_ref_counted<AsyncCreateSessionDescriptionObserver>(
+        params->callback, params->ctx);
+    SignalingThread(params->pc)->PostTask(
+        [peer_connection = params->pc->peer_connection, observer,
+         options = OfferAnswerOptions(params->ice_restart, params->voice_activity_detection)]() {
+            peer_connection->CreateOffer(observer.get(), options);
+        });
+
+    shim::ClearError(params->error_out);
+    return SHIM_OK;
+}
+
+SHIM_EXPORT int shim_peer_connection_create_answer_async(ShimPeerConnectionCreateAnswerAsyncParams* params) {
+    if (!params) {
+        return SHIM_ERROR_INVALID_PARAM;
+    }
+    if (!params->pc || !params->pc->peer_connection || !params->callback) {
+        return shim::SetErrorMessage(params->error_out, "invalid parameter", SHIM_ERROR_INVALID_PARAM);
+    }
+
+    auto observer = webrtc::make_ref_counted<AsyncCreateSessionDescriptionObserver>(
+        params->callback, params->ctx);
+    SignalingThread(params->pc)->PostTask(
+        [peer_connection = params->pc->peer_connection, observer,
+         options = OfferAnswerOptions(0, params->voice_activity_detection)]() {
+            peer_connection->CreateAnswer(observer.get(), options);
+        });
+
+    shim::ClearError(params->error_out);
+    return SHIM_OK;
+}
+
+SHIM_EXPORT int shim_peer_connection_set_local_description_async(ShimPeerConnectionSetLocalDescriptionAsyncParams* params) {
+    if (!params) {
+        return SHIM_ERROR_INVALID_PARAM;
+    }
+    if (!params->pc || !params->pc->peer_connection || !params->sdp || !params->callback) {
+        return shim::SetErrorMessage(params->error_out, "invalid parameter", SHIM_ERROR_INVALID_PARAM);
+    }
+
+    // Parsing copies the SDP, so the caller's string is not referenced after return.
+    auto desc = ParseSessionDescription(params->type, params->sdp, params->error_out);
+    if (!desc) {
+        return SHIM_ERROR_INVALID_PARAM;
+    }
+    if (params->pc->udp_mux_session) {
+        shim::UDPMuxSessionAddLocalDescription(params->pc->udp_mux_session.get(), params->sdp);
+    }
+
+    auto observer = webrtc::make_ref_counted<AsyncSetSessionDescriptionObserver>(
+        params->callback, params->ctx);
+    SignalingThread(params->pc)->PostTask(
+        [peer_connection = params->pc->peer_connection, observer, desc = std::move(desc)]() mutable {
+            peer_connection->SetLocalDescription(observer.get(), desc.release());
+        });
+
+    shim::ClearError(params->error_out);
+    return SHIM_OK;
+}
+
+SHIM_EXPORT int shim_peer_connection_set_remote_description_async(ShimPeerConnectionSetRemoteDescriptionAsyncParams* params) {
+    if (!params) {
+        return SHIM_ERROR_INVALID_PARAM;
+    }
+    if (!params->pc || !params->pc->peer_connection || !params->sdp || !params->callback) {
+        return shim::SetErrorMessage(params->error_out, "invalid parameter", SHIM_ERROR_INVALID_PARAM);
+    }
+
+    // Parsing copies the SDP, so the caller's string is not referenced after return.
+    auto desc = ParseSessionDescription(params->type, params->sdp, params->error_out);
+    if (!desc) {
+        return SHIM_ERROR_INVALID_PARAM;
+    }
+
+    auto observer = webrtc::make_ref_counted<AsyncSetSessionDescriptionObserver>(
+        params->callback, params->ctx);
+    SignalingThread(params->pc)->PostTask(
+        [peer_connection = params->pc->peer_connection, observer, desc = std::move(desc)]() mutable {
+            peer_connection->SetRemoteDescription(observer.get(), desc.release());
+        });
+
+    shim::ClearError(params->error_out);
+    return SHIM_OK;
+}
+
 SHIM_EXPORT int shim_peer_connection_add_ice_candidate(ShimPeerConnectionAddICECandidateParams* params) {
     if (!params) {
         return SHIM_ERROR_INVALID_PARAM;
@@ -658,6 +1006,7 @@ SHIM_EXPORT int shim_peer_connection_remove_track(ShimPeerConnectionRemoveTrackP
         shim::SetErrorFromRTCError(params->error_out, result);
         return SHIM_ERROR_INIT_FAILED;
     }
+    shim::SetSenderTrack(webrtc_sender, nullptr);
     return SHIM_OK;
 }
 
@@ -787,248 +1136,183 @@ SHIM_EXPORT int shim_peer_connection_restart_ice(ShimPeerConnection* pc) {
     return SHIM_OK;
 }
 
-/* RTCStatsCollector callback for synchronous stats retrieval */
-class StatsCollectorCallback : public webrtc::RTCStatsCollectorCallback {
-public:
+}  // extern "C"
+
+/* ============================================================================
+ * PeerConnection Pool
+ * ========================================================================== */
+
+struct ShimPeerConnectionPool {
+    ShimPeerConnectionFactory factory;  // The pool's own reference to the engine
+    webrtc::PeerConnectionInterface::RTCConfiguration rtc_config;
+    shim::NetworkControllerSettings network_controller;
+    size_t target_size = 0;
+    int audio_transceivers = 0;
+    int video_transceivers = 0;
+    webrtc::RtpTransceiverDirection direction = webrtc::RtpTransceiverDirection::kSendRecv;
+
     std::mutex mutex;
     std::condition_variable cv;
-    bool done = false;
-    webrtc::scoped_refptr<const webrtc::RTCStatsReport> report;
-
-    void OnStatsDelivered(const webrtc::scoped_refptr<const webrtc::RTCStatsReport>& r) override {
-        std::lock_guard<std::mutex> lock(mutex);
-        report = r;
-        done = true;
-        cv.notify_one();
-    }
+    std::deque<ShimPeerConnection*> ready;
+    bool stopping = false;
+    std::thread refill_thread;
 };
 
-SHIM_EXPORT int shim_peer_connection_get_stats(ShimPeerConnectionGetStatsParams* params) {
-    if (!params) {
-        return SHIM_ERROR_INVALID_PARAM;
-    }
-    if (!params->pc || !params->pc->peer_connection) {
-        memset(&params->out_stats, 0, sizeof(ShimRTCStats));
-        return SHIM_ERROR_INVALID_PARAM;
-    }
-
-    memset(&params->out_stats, 0, sizeof(ShimRTCStats));
+namespace {
 
-    // Create callback and get stats asynchronously
-    auto callback = webrtc::make_ref_counted<StatsCollectorCallback>();
-    params->pc->peer_connection->GetStats(callback.get());
+// Pooled connections stay idle until acquired; retry failed creations at
+// this interval instead of spinning.
+constexpr auto kPoolRetryInterval = std::chrono::seconds(1);
 
-    // Wait for completion
-    {
-        std::unique_lock<std::mutex> lock(callback->mutex);
-        callback->cv.wait(lock, [&]() { return callback->done; });
+// Create a connection from the pool's template. Any thread.
+ShimPeerConnection* CreatePooledPeerConnection(ShimPeerConnectionPool* pool, ShimErrorBuffer* error_out) {
+    ShimPeerConnection* pc = CreatePeerConnection(
+        &pool->factory, pool->rtc_config, pool->network_controller, error_out);
+    if (!pc) {
+        return nullptr;
     }
 
-    if (!callback->report) {
-        return SHIM_ERROR_INIT_FAILED;
+    webrtc::RtpTransceiverInit init;
+    init.direction = pool->direction;
+    for (int i = 0; i < pool->audio_transceivers + pool->video_transceivers; i++) {
+        webrtc::MediaType media_type = i < pool->audio_transceivers
+            ? webrtc::MediaType::AUDIO
+            : webrtc::MediaType::VIDEO;
+        auto result = pc->peer_connection->AddTransceiver(media_type, init);
+        if (!result.ok()) {
+            shim::SetErrorFromRTCError(error_out, result.error());
+            shim_peer_connection_destroy(pc);
+            return nullptr;
+        }
     }
+    return pc;
+}
 
-    params->out_stats.timestamp_us = webrtc::TimeMicros();
-
-    // Iterate through all stats and aggregate them
-    for (const auto& stat : *callback->report) {
-        // Outbound RTP stream stats (sending)
-        if (stat.type() == webrtc::RTCOutboundRtpStreamStats::kType) {
-            const auto& outbound = stat.cast_to<webrtc::RTCOutboundRtpStreamStats>();
-            if (outbound.bytes_sent.has_value()) {
-                params->out_stats.bytes_sent += *outbound.bytes_sent;
-            }
-            if (outbound.packets_sent.has_value()) {
-                params->out_stats.packets_sent += *outbound.packets_sent;
-            }
-            if (outbound.frames_encoded.has_value()) {
-                params->out_stats.frames_encoded += *outbound.frames_encoded;
-            }
-            if (outbound.key_frames_encoded.has_value()) {
-                params->out_stats.key_frames_encoded += *outbound.key_frames_encoded;
-            }
-            if (outbound.nack_count.has_value()) {
-                params->out_stats.nack_count += *outbound.nack_count;
-            }
-            if (outbound.pli_count.has_value()) {
-                params->out_stats.pli_count += *outbound.pli_count;
-            }
-            if (outbound.fir_count.has_value()) {
-                params->out_stats.fir_count += *outbound.fir_count;
-            }
-            if (outbound.qp_sum.has_value()) {
-                params->out_stats.qp_sum += *outbound.qp_sum;
-            }
-            if (outbound.quality_limitation_reason.has_value()) {
-                const std::string& reason = *outbound.quality_limitation_reason;
-                if (reason == "none") params->out_stats.quality_limitation_reason = SHIM_QUALITY_LIMITATION_NONE;
-                else if (reason == "cpu") params->out_stats.quality_limitation_reason = SHIM_QUALITY_LIMITATION_CPU;
-                else if (reason == "bandwidth") params->out_stats.quality_limitation_reason = SHIM_QUALITY_LIMITATION_BANDWIDTH;
-                else params->out_stats.quality_limitation_reason = SHIM_QUALITY_LIMITATION_OTHER;
-            }
+void RefillPool(ShimPeerConnectionPool* pool) {
+    std::unique_lock<std::mutex> lock(pool->mutex);
+    while (!pool->stopping) {
+        if (pool->ready.size() >= pool->target_size) {
+            pool->cv.wait(lock);
+            continue;
         }
 
-        // Inbound RTP stream stats (receiving) - includes jitter buffer stats
-        if (stat.type() == webrtc::RTCInboundRtpStreamStats::kType) {
-            const auto& inbound = stat.cast_to<webrtc::RTCInboundRtpStreamStats>();
-            if (inbound.bytes_received.has_value()) {
-                params->out_stats.bytes_received += *inbound.bytes_received;
-            }
-            if (inbound.packets_received.has_value()) {
-                params->out_stats.packets_received += *inbound.packets_received;
-            }
-            if (inbound.packets_lost.has_value()) {
-                params->out_stats.packets_lost += *inbound.packets_lost;
-            }
-            if (inbound.jitter.has_value()) {
-                // jitter is in seconds, convert to ms
-                params->out_stats.jitter_ms = *inbound.jitter * 1000.0;
-            }
-            if (inbound.frames_decoded.has_value()) {
-                params->out_stats.frames_decoded += *inbound.frames_decoded;
-            }
-            if (inbound.key_frames_decoded.has_value()) {
-                params->out_stats.key_frames_decoded += *inbound.key_frames_decoded;
-            }
-            if (inbound.frames_dropped.has_value()) {
-                params->out_stats.frames_dropped += *inbound.frames_dropped;
-            }
-            if (inbound.nack_count.has_value()) {
-                params->out_stats.nack_count += *inbound.nack_count;
-            }
-            if (inbound.pli_count.has_value()) {
-                params->out_stats.pli_count += *inbound.pli_count;
-            }
-            if (inbound.fir_count.has_value()) {
-                params->out_stats.fir_count += *inbound.fir_count;
-            }
-            if (inbound.qp_sum.has_value()) {
-                params->out_stats.qp_sum += *inbound.qp_sum;
-            }
-            // Audio specific
-            if (inbound.audio_level.has_value()) {
-                params->out_stats.audio_level = *inbound.audio_level;
-            }
-            if (inbound.total_audio_energy.has_value()) {
-                params->out_stats.total_audio_energy = *inbound.total_audio_energy;
-            }
-            if (inbound.concealment_events.has_value()) {
-                params->out_stats.concealment_events += *inbound.concealment_events;
-            }
+        lock.unlock();
+        ShimPeerConnection* pc = CreatePooledPeerConnection(pool, nullptr);
+        lock.lock();
 
-            // JITTER BUFFER STATS (what the user specifically wants!)
-            if (inbound.jitter_buffer_delay.has_value()) {
-                // jitter_buffer_delay is total delay in seconds, convert to ms
-                params->out_stats.jitter_buffer_delay_ms = *inbound.jitter_buffer_delay * 1000.0;
-            }
-            if (inbound.jitter_buffer_target_delay.has_value()) {
-                params->out_stats.jitter_buffer_target_delay_ms = *inbound.jitter_buffer_target_delay * 1000.0;
-            }
-            if (inbound.jitter_buffer_minimum_delay.has_value()) {
-                params->out_stats.jitter_buffer_minimum_delay_ms = *inbound.jitter_buffer_minimum_delay * 1000.0;
-            }
-            if (inbound.jitter_buffer_emitted_count.has_value()) {
-                params->out_stats.jitter_buffer_emitted_count = *inbound.jitter_buffer_emitted_count;
-            }
+        if (!pc) {
+            pool->cv.wait_for(lock, kPoolRetryInterval);
+            continue;
         }
+        pool->ready.push_back(pc);
+    }
+}
 
-        // Remote inbound RTP stats (from RTCP receiver reports)
-        if (stat.type() == webrtc::RTCRemoteInboundRtpStreamStats::kType) {
-            const auto& remote = stat.cast_to<webrtc::RTCRemoteInboundRtpStreamStats>();
-            if (remote.packets_lost.has_value()) {
-                params->out_stats.remote_packets_lost = *remote.packets_lost;
-            }
-            if (remote.jitter.has_value()) {
-                params->out_stats.remote_jitter_ms = *remote.jitter * 1000.0;
-            }
-            if (remote.round_trip_time.has_value()) {
-                params->out_stats.remote_round_trip_time_ms = *remote.round_trip_time * 1000.0;
-            }
-        }
+}  // namespace
 
-        // ICE candidate pair stats
-        if (stat.type() == webrtc::RTCIceCandidatePairStats::kType) {
-            const auto& pair = stat.cast_to<webrtc::RTCIceCandidatePairStats>();
-            if (pair.current_round_trip_time.has_value()) {
-                params->out_stats.current_rtt_ms = static_cast<int64_t>(*pair.current_round_trip_time * 1000.0);
-            }
-            if (pair.total_round_trip_time.has_value()) {
-                params->out_stats.total_rtt_ms = static_cast<int64_t>(*pair.total_round_trip_time * 1000.0);
-            }
-            if (pair.responses_received.has_value()) {
-                params->out_stats.responses_received = *pair.responses_received;
-            }
-            if (pair.available_outgoing_bitrate.has_value()) {
-                params->out_stats.available_outgoing_bitrate = *pair.available_outgoing_bitrate;
-            }
-            if (pair.available_incoming_bitrate.has_value()) {
-                params->out_stats.available_incoming_bitrate = *pair.available_incoming_bitrate;
-            }
-        }
+extern "C" {
 
-        // Data channel stats
-        if (stat.type() == webrtc::RTCDataChannelStats::kType) {
-            const auto& dc = stat.cast_to<webrtc::RTCDataChannelStats>();
-            if (dc.messages_sent.has_value()) {
-                params->out_stats.messages_sent += *dc.messages_sent;
-            }
-            if (dc.messages_received.has_value()) {
-                params->out_stats.messages_received += *dc.messages_received;
-            }
-            if (dc.bytes_sent.has_value()) {
-                params->out_stats.bytes_sent_data_channel += *dc.bytes_sent;
-            }
-            if (dc.bytes_received.has_value()) {
-                params->out_stats.bytes_received_data_channel += *dc.bytes_received;
-            }
-        }
-    }
+SHIM_EXPORT ShimPeerConnectionPool* shim_peer_connection_pool_create(
+    ShimPeerConnectionPoolCreateParams* params
+) {
+    shim::InitializeGlobals();
 
-    // Calculate average RTT if we have data
-    if (params->out_stats.responses_received > 0 && params->out_stats.total_rtt_ms > 0) {
-        params->out_stats.round_trip_time_ms = static_cast<double>(params->out_stats.total_rtt_ms) /
-                                        static_cast<double>(params->out_stats.responses_received);
+    if (!params) {
+        return nullptr;
     }
+    ShimErrorBuffer* error_out = params->error_out;
 
-    return SHIM_OK;
-}
+    if (params->target_size <= 0) {
+        shim::SetErrorMessage(error_out, "target_size must be > 0", SHIM_ERROR_INVALID_PARAM);
+        return nullptr;
+    }
+    if (params->audio_transceivers < 0 || params->video_transceivers < 0) {
+        shim::SetErrorMessage(error_out, "transceiver counts must be >= 0", SHIM_ERROR_INVALID_PARAM);
+        return nullptr;
+    }
+    if (params->transceiver_direction < SHIM_TRANSCEIVER_DIRECTION_SENDRECV ||
+        params->transceiver_direction > SHIM_TRANSCEIVER_DIRECTION_INACTIVE) {
+        shim::SetErrorMessage(error_out, "invalid transceiver_direction", SHIM_ERROR_INVALID_PARAM);
+        return nullptr;
+    }
 
-/* ============================================================================
- * Bandwidth Estimation API
- * ========================================================================== */
+    auto pool = std::make_unique<ShimPeerConnectionPool>();
+    if (!BuildRTCConfiguration(params->config, &pool->rtc_config, error_out) ||
+        !shim::BuildNetworkControllerSettings(params->config, &pool->network_controller, error_out)) {
+        return nullptr;
+    }
+    // Gather candidates while the connection waits in the pool.
+    pool->rtc_config.ice_candidate_pool_size = std::max(pool->rtc_config.ice_candidate_pool_size, 1);
 
-SHIM_EXPORT void shim_peer_connection_set_on_bandwidth_estimate(ShimPeerConnectionSetOnBandwidthEstimateParams* params) {
-    if (!params || !params->pc) {
-        return;
+    if (params->factory) {
+        pool->factory = *params->factory;
+    } else {
+        pool->factory.factory = shim::CreatePeerConnectionFactory(nullptr, nullptr, error_out);
+        if (!pool->factory.factory) {
+            return nullptr;
+        }
     }
-    // TODO: Wire up BWE callback from libwebrtc's BitrateController
-    // This requires implementing a NetworkControllerObserver
-    (void)params->callback;
-    (void)params->ctx;
+
+    pool->target_size = static_cast<size_t>(params->target_size);
+    pool->audio_transceivers = params->audio_transceivers;
+    pool->video_transceivers = params->video_transceivers;
+    pool->direction = static_cast<webrtc::RtpTransceiverDirection>(params->transceiver_direction);
+    pool->refill_thread = std::thread(RefillPool, pool.get());
+
+    shim::ClearError(error_out);
+    return pool.release();
 }
 
-SHIM_EXPORT int shim_peer_connection_get_bandwidth_estimate(ShimPeerConnectionGetBandwidthEstimateParams* params) {
+SHIM_EXPORT ShimPeerConnection* shim_peer_connection_acquire(ShimPeerConnectionAcquireParams* params) {
     if (!params) {
-        return SHIM_ERROR_INVALID_PARAM;
+        return nullptr;
     }
-    if (!params->pc) {
-        memset(&params->out_estimate, 0, sizeof(ShimBandwidthEstimate));
-        return SHIM_ERROR_INVALID_PARAM;
+    params->out_pooled = 0;
+    if (!params->pool) {
+        shim::SetErrorMessage(params->error_out, "pool is required", SHIM_ERROR_INVALID_PARAM);
+        return nullptr;
     }
 
-    memset(&params->out_estimate, 0, sizeof(ShimBandwidthEstimate));
-    params->out_estimate.timestamp_us = webrtc::TimeMicros();
+    ShimPeerConnectionPool* pool = params->pool;
+    {
+        std::lock_guard<std::mutex> lock(pool->mutex);
+        pool->cv.notify_one();
+        if (!pool->ready.empty()) {
+            ShimPeerConnection* pc = pool->ready.front();
+            pool->ready.pop_front();
+            params->out_pooled = 1;
+            shim::ClearError(params->error_out);
+            return pc;
+        }
+    }
 
-    // TODO: Get actual BWE from libwebrtc's transport controller
-    // For now, return placeholder values
-    params->out_estimate.target_bitrate_bps = 0;
-    params->out_estimate.available_send_bps = 0;
-    params->out_estimate.available_recv_bps = 0;
-    params->out_estimate.pacing_rate_bps = 0;
-    params->out_estimate.congestion_window = 0;
-    params->out_estimate.loss_rate = 0.0;
+    // Pool drained faster than it refills: pay the full cost inline.
+    return CreatePooledPeerConnection(pool, params->error_out);
+}
 
-    return SHIM_OK;
+SHIM_EXPORT int shim_peer_connection_pool_ready(ShimPeerConnectionPool* pool) {
+    if (!pool) {
+        return 0;
+    }
+    std::lock_guard<std::mutex> lock(pool->mutex);
+    return static_cast<int>(pool->ready.size());
+}
+
+SHIM_EXPORT void shim_peer_connection_pool_destroy(ShimPeerConnectionPool* pool) {
+    if (!pool) {
+        return;
+    }
+    {
+        std::lock_guard<std::mutex> lock(pool->mutex);
+        pool->stopping = true;
+    }
+    pool->cv.notify_all();
+    pool->refill_thread.join();
+
+    for (ShimPeerConnection* pc : pool->ready) {
+        shim_peer_connection_destroy(pc);
+    }
+    delete pool;
 }
 
 }  // extern "C"
@@ -0,0 +1,138 @@
+/*
+ * shim_peer_connection_factory.cc - PeerConnectionFactory implementation
+ *
+ * Builds the media engine (codec factories, ADM, APM) once so it can be
+ * shared by many PeerConnections instead of being rebuilt per connection.
+ */
+
+#include "shim_common.h"
+#include "shim_internal.h"
+
+#include <memory>
+
+#include "api/audio/audio_device.h"
+#include "api/audio/builtin_audio_processing_builder.h"
+#include "api/audio/create_audio_device_module.h"
+#include "api/audio_codecs/builtin_audio_decoder_factory.h"
+#include "api/audio_codecs/builtin_audio_encoder_factory.h"
+#include "api/create_modular_peer_connection_factory.h"
+#include "api/enable_media.h"
+#include "api/rtc_event_log/rtc_event_log_factory.h"
+#include "api/video_codecs/builtin_video_decoder_factory.h"
+#include "api/video_codecs/builtin_video_encoder_factory.h"
+#include "media/engine/internal_decoder_factory.h"
+#include "media/engine/internal_encoder_factory.h"
+
+namespace shim {
+
+webrtc::scoped_refptr<webrtc::PeerConnectionFactoryInterface> CreatePeerConnectionFactory(
+    const ShimPeerConnectionFactoryConfig* config,
+    const ShimThreadSet* threads,
+    ShimErrorBuffer* error_out
+) {
+    InitializeGlobals();
+
+    ShimPeerConnectionFactoryConfig defaults = {};
+    if (!config) {
+        config = &defaults;
+    }
+
+    bool use_software;
+    switch (config->video_codec_factory) {
+        case SHIM_VIDEO_CODEC_FACTORY_AUTO:
+            use_software = ShouldUseSoftwareCodecs();
+            break;
+        case SHIM_VIDEO_CODEC_FACTORY_BUILTIN:
+            use_software = false;
+            break;
+        case SHIM_VIDEO_CODEC_FACTORY_SOFTWARE:
+            use_software = true;
+            break;
+        default:
+            SetErrorMessage(error_out, "unknown video_codec_factory", SHIM_ERROR_INVALID_PARAM);
+            return nullptr;
+    }
+
+    webrtc::Thread* worker_thread = threads ? threads->worker.get() : GetWorkerThread();
+
+    webrtc::PeerConnectionFactoryDependencies deps;
+    deps.network_thread = threads ? threads->network.get() : GetNetworkThread();
+    deps.worker_thread = worker_thread;
+    deps.signaling_thread = threads ? threads->signaling.get() : GetSignalingThread();
+    deps.env = GetEnvironment();
+    deps.event_log_factory = std::make_unique<webrtc::RtcEventLogFactory>();
+
+    if (config->disable_audio_device) {
+        // The ADM must be created on the worker thread it will run on.
+        deps.adm = worker_thread->BlockingCall([] {
+            return webrtc::CreateAudioDeviceModule(
+                GetEnvironment(), webrtc::AudioDeviceModule::kDummyAudio);
+        });
+        if (!deps.adm) {
+            SetErrorMessage(error_out, "dummy AudioDeviceModule creation failed");
+            return nullptr;
+        }
+    }
+    // A null ADM makes the voice engine create the platform default.
+
+    if (!config->disable_audio_processing) {
+        deps.audio_processing_builder = std::make_unique<webrtc::BuiltinAudioProcessingBuilder>();
+    }
+
+    deps.audio_encoder_factory = webrtc::CreateBuiltinAudioEncoderFactory();
+    deps.audio_decoder_factory = webrtc::CreateBuiltinAudioDecoderFactory();
+    if (use_software) {
+        deps.video_encoder_factory = std::make_unique<webrtc::InternalEncoderFactory>();
+        deps.video_decoder_factory = std::make_unique<webrtc::InternalDecoderFactory>();
+    } else {
+        deps.video_encoder_factory = webrtc::CreateBuiltinVideoEncoderFactory();
+        deps.video_decoder_factory = webrtc::CreateBuiltinVideoDecoderFactory();
+    }
+    deps.video_encoder_factory = CreatePassthroughEncoderFactory(std::move(deps.video_encoder_factory));
+    if (config->disable_video_decoding) {
+        deps.video_decoder_factory = CreateDiscardingDecoderFactory(std::move(deps.video_decoder_factory));
+    }
+
+    webrtc::EnableMedia(deps);
+
+    auto factory = webrtc::CreateModularPeerConnectionFactory(std::move(deps));
+    if (!factory) {
+        SetErrorMessage(error_out, "PeerConnectionFactory creation failed");
+        return nullptr;
+    }
+    return factory;
+}
+
+}  // namespace shim
+
+extern "C" {
+
+SHIM_EXPORT ShimPeerConnectionFactory* shim_peer_connection_factory_create(
+    ShimPeerConnectionFactoryCreateParams* params
+) {
+    if (!params) {
+        return nullptr;
+    }
+
+    auto factory = shim::CreatePeerConnectionFactory(params->config, nullptr, params->error_out);
+    if (!factory) {
+        return nullptr;
+    }
+
+    auto shim_factory = std::make_unique<ShimPeerConnectionFactory>();
+    if (!shim::CreateUDPMux(params->config, 0, shim::GetNetworkThread(),
+                            &shim_factory->udp_mux, params->error_out)) {
+        return nullptr;
+    }
+    if (params->config && params->config->loopback_network) {
+        shim_factory->loopback_network = params->config->loopback_network->network;
+    }
+    shim_factory->factory = std::move(factory);
+    return shim_factory.release();
+}
+
+SHIM_EXPORT void shim_peer_connection_factory_destroy(ShimPeerConnectionFactory* factory) {
+    delete factory;
+}
+
+}  // extern "C"
@@ -2,17 +2,42 @@
  * shim_remote_sink.cc - Remote track sink implementation
  *
  * Provides video and audio sinks for receiving frames from remote tracks.
+ *
+ * Callback and queue sinks convert and hand over each frame on the decode
+ * thread. A video mailbox sink only keeps a reference to the decoded frame;
+ * the application pulls frames, converting them on its own thread, so a slow
+ * consumer drops frames instead of stalling the decoder.
+ *
+ * Every video sink honors the sink wants set with
+ * shim_track_set_video_sink_wants: frames above the wanted frame rate are
+ * dropped before any conversion and larger frames are scaled down.
+ *
+ * Audio sinks receive 10 ms chunks. They can batch several chunks into one
+ * delivery and convert them to a requested rate and channel count, set with
+ * shim_track_set_audio_sink_format.
  */
 
 #include "shim_common.h"
+#include "shim_internal.h"
 
+#include <algorithm>
+#include <atomic>
+#include <cmath>
 #include <map>
+#include <memory>
+#include <mutex>
+#include <optional>
 #include <unordered_map>
 #include <cstring>
+#include <vector>
 
 #include "api/video/i420_buffer.h"
+#include "common_audio/resampler/include/resampler.h"
 #include "api/video/video_frame.h"
 #include "api/media_stream_interface.h"
+#include "api/video/video_frame_buffer.h"
+#include "api/video/video_source_interface.h"
+#include "rtc_base/time_utils.h"
 
 /* ============================================================================
  * Forward Declarations for Callback Types
@@ -32,23 +57,194 @@ typedef void (*ShimOnAudioFrame)(
     int num_samples,
     int sample_rate,
     int channels,
-    int64_t timestamp_us
+    int64_t timestamp_us,
+    int64_t capture_time_us,
+    int has_capture_time
 );
 
 /* ============================================================================
  * Video Sink Implementation
  * ========================================================================== */
 
+namespace {
+
+// Decoded frames a queue-mode video sink keeps for the drainer to pull.
+constexpr int kQueuedVideoFrames = 4;
+
+// Decoded frames waiting to be pulled, oldest first. When all slots are
+// full the oldest frame is dropped. With a single slot the newest frame
+// replaces the previous one through an atomic exchange, without locking;
+// with more slots a lock guards the ring for a few pointer moves.
+class VideoMailbox {
+public:
+    explicit VideoMailbox(int slots) : slots_(static_cast<size_t>(slots)) {
+        if (slots_ > 1) {
+            ring_.resize(slots_);
+        }
+    }
+
+    ~VideoMailbox() { delete latest_.exchange(nullptr); }
+
+    // Called on the decode thread.
+    void Put(const webrtc::VideoFrame& frame) {
+        if (slots_ == 1) {
+            auto* previous = latest_.exchange(new webrtc::VideoFrame(frame), std::memory_order_acq_rel);
+            if (previous) {
+                delete previous;
+                dropped_.fetch_add(1, std::memory_order_relaxed);
+            }
+            return;
+        }
+
+        std::lock_guard<std::mutex> lock(mutex_);
+        if (count_ == slots_) {
+            ring_[head_].reset();
+            head_ = (head_ + 1) % slots_;
+            count_--;
+            dropped_.fetch_add(1, std::memory_order_relaxed);
+        }
+        ring_[(head_ + count_) % slots_] = frame;
+        count_++;
+    }
+
+    std::optional<webrtc::VideoFrame> Take() {
+        if (slots_ == 1) {
+            std::unique_ptr<webrtc::VideoFrame> frame(latest_.exchange(nullptr, std::memory_order_acq_rel));
+            if (!frame) {
+                return std::nullopt;
+            }
+            return std::move(*frame);
+        }
+
+        std::lock_guard<std::mutex> lock(mutex_);
+        if (count_ == 0) {
+            return std::nullopt;
+        }
+        std::optional<webrtc::VideoFrame> frame = std::move(ring_[head_]);
+        ring_[head_].reset();
+        head_ = (head_ + 1) % slots_;
+        count_--;
+        return frame;
+    }
+
+    uint64_t dropped() const { return dropped_.load(std::memory_order_relaxed); }
+
+private:
+    const size_t slots_;
+    std::atomic<uint64_t> dropped_{0};
+
+    // Single slot
+    std::atomic<webrtc::VideoFrame*> latest_{nullptr};
+
+    // Several slots
+    std::mutex mutex_;
+    std::vector<std::optional<webrtc::VideoFrame>> ring_;
+    size_t head_ = 0;
+    size_t count_ = 0;
+};
+
+// Scale a frame down so it holds at most max_pixels pixels, keeping the
+// aspect ratio and even dimensions, then convert it to I420. Scaling before
+// the conversion means only the smaller frame is converted.
+webrtc::scoped_refptr<webrtc::I420BufferInterface> ScaleToI420(
+    const webrtc::scoped_refptr<webrtc::VideoFrameBuffer>& buffer, int max_pixels
+) {
+    const int width = buffer->width();
+    const int height = buffer->height();
+    if (max_pixels <= 0 || static_cast<int64_t>(width) * height <= max_pixels) {
+        return buffer->ToI420();
+    }
+    const double factor = std::sqrt(static_cast<double>(max_pixels) / (static_cast<double>(width) * height));
+    const int scaled_width = std::max(2, static_cast<int>(width * factor) & ~1);
+    const int scaled_height = std::max(2, static_cast<int>(height * factor) & ~1);
+    return buffer->Scale(scaled_width, scaled_height)->ToI420();
+}
+
+}  // namespace
+
+// A frame pulled from a video mailbox, kept alive until released.
+struct ShimVideoFrame {
+    webrtc::scoped_refptr<webrtc::I420BufferInterface> buffer;
+};
+
 class GoVideoSink : public webrtc::VideoSinkInterface<webrtc::VideoFrame> {
 public:
     GoVideoSink(ShimOnVideoFrame callback, void* ctx)
         : callback_(callback), ctx_(ctx) {}
 
+    // Queue mode: frames wait in a small mailbox and each one is announced
+    // by a SHIM_EVENT_VIDEO_FRAME event without payload, so a stalled
+    // drainer holds a few frames instead of a copy of each one.
+    explicit GoVideoSink(std::shared_ptr<shim::EventRing> ring, uint64_t tag)
+        : mailbox_(std::make_unique<VideoMailbox>(kQueuedVideoFrames)) {
+        events_.Attach(std::move(ring), tag);
+        notify_ = true;
+    }
+
+    // Mailbox mode: frames are kept for shim_track_pull_video_frame.
+    explicit GoVideoSink(int mailbox_slots)
+        : mailbox_(std::make_unique<VideoMailbox>(mailbox_slots)) {}
+
+    VideoMailbox* mailbox() { return mailbox_.get(); }
+
+    // Updates the frame limits; zero means no limit. Called with the sink
+    // lock held while frames keep arriving on the decode thread.
+    void SetWants(int max_pixel_count, int target_pixel_count, int max_framerate) {
+        max_pixel_count_.store(max_pixel_count, std::memory_order_relaxed);
+        target_pixel_count_.store(target_pixel_count, std::memory_order_relaxed);
+        max_framerate_.store(max_framerate, std::memory_order_relaxed);
+    }
+
+    webrtc::VideoSinkWants wants() const {
+        webrtc::VideoSinkWants wants;
+        const int max_pixels = max_pixel_count_.load(std::memory_order_relaxed);
+        const int target_pixels = target_pixel_count_.load(std::memory_order_relaxed);
+        const int max_framerate = max_framerate_.load(std::memory_order_relaxed);
+        if (max_pixels > 0) {
+            wants.max_pixel_count = max_pixels;
+        }
+        if (target_pixels > 0) {
+            wants.target_pixel_count = target_pixels;
+        }
+        if (max_framerate > 0) {
+            wants.max_framerate_fps = max_framerate;
+        }
+        return wants;
+    }
+
+    // Pixel count frames are scaled down to before delivery, 0 for none. The
+    // target is preferred, as libwebrtc's own adaptation does.
+    int ScalePixelCount() const {
+        const int target_pixels = target_pixel_count_.load(std::memory_order_relaxed);
+        const int max_pixels = max_pixel_count_.load(std::memory_order_relaxed);
+        if (target_pixels > 0 && (max_pixels <= 0 || target_pixels < max_pixels)) {
+            return target_pixels;
+        }
+        return max_pixels;
+    }
+
     void OnFrame(const webrtc::VideoFrame& frame) override {
-        if (!callback_) return;
+        if (DropForFramerate(frame)) {
+            return;
+        }
+        if (mailbox_) {
+            mailbox_->Put(frame);
+            if (notify_) {
+                ShimEvent event{};
+                event.type = SHIM_EVENT_VIDEO_FRAME;
+                event.width = frame.width();
+                event.height = frame.height();
+                event.timestamp_us = frame.timestamp_us();
+                events_.Emit(event);
+            }
+            return;
+        }
 
         webrtc::scoped_refptr<webrtc::I420BufferInterface> buffer =
-            frame.video_frame_buffer()->ToI420();
+            ScaleToI420(frame.video_frame_buffer(), ScalePixelCount());
+        if (!buffer) {
+            return;
+        }
 
         callback_(
             ctx_,
@@ -65,42 +261,303 @@ public:
     }
 
 private:
-    ShimOnVideoFrame callback_;
-    void* ctx_;
+    // Drops frames arriving faster than the wanted frame rate, judged by
+    // their timestamps. A quarter interval of slack keeps every other frame
+    // of a 30 fps stream limited to 15 fps despite jitter.
+    bool DropForFramerate(const webrtc::VideoFrame& frame) {
+        const int max_framerate = max_framerate_.load(std::memory_order_relaxed);
+        if (max_framerate <= 0) {
+            last_kept_us_ = -1;
+            return false;
+        }
+        const int64_t timestamp_us = frame.timestamp_us() > 0 ? frame.timestamp_us() : webrtc::TimeMicros();
+        const int64_t interval_us = 1000000 / max_framerate;
+        if (last_kept_us_ >= 0 && timestamp_us >= last_kept_us_ &&
+            timestamp_us - last_kept_us_ < interval_us - interval_us / 4) {
+            return true;
+        }
+        last_kept_us_ = timestamp_us;
+        return false;
+    }
+
+    ShimOnVideoFrame callback_ = nullptr;
+    void* ctx_ = nullptr;
+    shim::EventTarget events_;
+    std::unique_ptr<VideoMailbox> mailbox_;
+    bool notify_ = false;
+
+    std::atomic<int> max_pixel_count_{0};
+    std::atomic<int> target_pixel_count_{0};
+    std::atomic<int> max_framerate_{0};
+    int64_t last_kept_us_ = -1;  // Decode thread only
 };
 
 /* ============================================================================
  * Audio Sink Implementation
  * ========================================================================== */
 
+namespace {
+
+// Convert interleaved samples of the given depth to int16. Returns false for
+// depths we cannot read.
+bool ConvertToS16(const void* data, int bits_per_sample, size_t count, int16_t* out) {
+    const uint8_t* bytes = static_cast<const uint8_t*>(data);
+    switch (bits_per_sample) {
+    case 8:
+        // Unsigned, as in WAV
+        for (size_t i = 0; i < count; i++) {
+            out[i] = static_cast<int16_t>((bytes[i] - 128) * 256);
+        }
+        return true;
+    case 16:
+        std::memcpy(out, data, count * sizeof(int16_t));
+        return true;
+    case 24:
+        for (size_t i = 0; i < count; i++) {
+            const uint8_t* sample = bytes + 3 * i;
+            out[i] = static_cast<int16_t>(sample[1] | (sample[2] << 8));
+        }
+        return true;
+    case 32: {
+        const int32_t* samples = static_cast<const int32_t*>(data);
+        for (size_t i = 0; i < count; i++) {
+            out[i] = static_cast<int16_t>(samples[i] >> 16);
+        }
+        return true;
+    }
+    default:
+        return false;
+    }
+}
+
+// Mix interleaved frames to 1 or 2 channels: mono averages all channels,
+// stereo duplicates mono input or keeps the first two channels.
+void Remix(const int16_t* in, size_t frames, size_t in_channels, size_t out_channels, int16_t* out) {
+    for (size_t f = 0; f < frames; f++) {
+        const int16_t* frame = in + f * in_channels;
+        if (out_channels == 1) {
+            int32_t sum = 0;
+            for (size_t c = 0; c < in_channels; c++) {
+                sum += frame[c];
+            }
+            out[f] = static_cast<int16_t>(sum / static_cast<int32_t>(in_channels));
+        } else {
+            out[2 * f] = frame[0];
+            out[2 * f + 1] = frame[in_channels > 1 ? 1 : 0];
+        }
+    }
+}
+
+}  // namespace
+
 class GoAudioSink : public webrtc::AudioTrackSinkInterface {
 public:
     GoAudioSink(ShimOnAudioFrame callback, void* ctx)
         : callback_(callback), ctx_(ctx) {}
 
+    // Queue mode: samples are copied into SHIM_EVENT_AUDIO_FRAME events.
+    explicit GoAudioSink(std::shared_ptr<shim::EventRing> ring, uint64_t tag) {
+        events_.Attach(std::move(ring), tag);
+    }
+
+    // Sets the batch duration and output format; zero keeps 10 ms chunks and
+    // the source format. Takes effect on the next chunk, after the pending
+    // batch is delivered.
+    void SetFormat(int batch_ms, int sample_rate, int channels) {
+        batch_ms_.store(batch_ms, std::memory_order_relaxed);
+        out_rate_.store(sample_rate, std::memory_order_relaxed);
+        out_channels_.store(channels, std::memory_order_relaxed);
+        format_generation_.fetch_add(1, std::memory_order_release);
+    }
+
+    // Lets the source downmix before handing us the audio.
+    int NumPreferredChannels() const override {
+        const int channels = out_channels_.load(std::memory_order_relaxed);
+        return channels > 0 ? channels : -1;
+    }
+
     void OnData(const void* audio_data,
                 int bits_per_sample,
                 int sample_rate,
                 size_t number_of_channels,
                 size_t number_of_frames) override {
-        if (!callback_) return;
+        OnData(audio_data, bits_per_sample, sample_rate, number_of_channels, number_of_frames, std::nullopt);
+    }
+
+    // Called on the audio thread with 10 ms chunks.
+    void OnData(const void* audio_data,
+                int bits_per_sample,
+                int sample_rate,
+                size_t number_of_channels,
+                size_t number_of_frames,
+                std::optional<int64_t> absolute_capture_timestamp_ms) override {
+        if (!audio_data || sample_rate <= 0 || number_of_channels == 0 || number_of_frames == 0) {
+            return;
+        }
+
+        const uint32_t generation = format_generation_.load(std::memory_order_acquire);
+        if (generation != applied_generation_ || sample_rate != in_rate_ ||
+            number_of_channels != in_channels_) {
+            Flush();
+            Configure(generation, sample_rate, number_of_channels, number_of_frames);
+        }
+
+        // The capture time is on the sender's NTP clock, so it is passed on
+        // beside the arrival time rather than in its place.
+        const int64_t timestamp_us = webrtc::TimeMicros();
+        std::optional<int64_t> capture_time_us;
+        if (absolute_capture_timestamp_ms) {
+            capture_time_us = *absolute_capture_timestamp_ms * 1000;
+        }
+
+        const size_t in_samples = number_of_frames * number_of_channels;
+        if (convert_.size() < in_samples) {
+            convert_.resize(in_samples);
+        }
+        if (!ConvertToS16(audio_data, bits_per_sample, in_samples, convert_.data())) {
+            return;
+        }
 
-        // Convert to int16
-        if (bits_per_sample == 16) {
-            callback_(
-                ctx_,
-                static_cast<const int16_t*>(audio_data),
-                static_cast<int>(number_of_frames),
-                sample_rate,
-                static_cast<int>(number_of_channels),
-                0  // timestamp not available in this callback
-            );
+        const int16_t* samples = convert_.data();
+        size_t frames = number_of_frames;
+        if (channels_ != in_channels_) {
+            if (remix_.size() < frames * channels_) {
+                remix_.resize(frames * channels_);
+            }
+            Remix(samples, frames, in_channels_, channels_, remix_.data());
+            samples = remix_.data();
+        }
+        if (resample_) {
+            const size_t max_out = (frames * rate_ / in_rate_ + 1) * channels_;
+            if (resampled_.size() < max_out) {
+                resampled_.resize(max_out);
+            }
+            size_t out_len = 0;
+            if (resampler_.Push(samples, frames * channels_, resampled_.data(), resampled_.size(), out_len) != 0) {
+                return;
+            }
+            samples = resampled_.data();
+            frames = out_len / channels_;
+        }
+
+        if (batch_frames_ == 0) {
+            Deliver(samples, frames, timestamp_us, capture_time_us);
+            return;
+        }
+
+        // Fill the batch, delivering each time it is full. Samples spilling
+        // into the next batch get their offset added to the timestamps.
+        size_t offset = 0;
+        while (offset < frames) {
+            if (batch_len_ == 0) {
+                const int64_t offset_us = static_cast<int64_t>(offset) * 1000000 / rate_;
+                batch_timestamp_us_ = timestamp_us + offset_us;
+                batch_capture_time_us_.reset();
+                if (capture_time_us) {
+                    batch_capture_time_us_ = *capture_time_us + offset_us;
+                }
+            }
+            const size_t n = std::min(frames - offset, batch_frames_ - batch_len_);
+            std::memcpy(batch_.data() + batch_len_ * channels_, samples + offset * channels_,
+                        n * channels_ * sizeof(int16_t));
+            batch_len_ += n;
+            offset += n;
+            if (batch_len_ == batch_frames_) {
+                Flush();
+            }
         }
     }
 
 private:
-    ShimOnAudioFrame callback_;
-    void* ctx_;
+    // Audio thread only: size buffers for the source and requested format.
+    void Configure(uint32_t generation, int sample_rate, size_t channels, size_t chunk_frames) {
+        applied_generation_ = generation;
+        in_rate_ = sample_rate;
+        in_channels_ = channels;
+
+        const int out_channels = out_channels_.load(std::memory_order_relaxed);
+        channels_ = out_channels > 0 ? static_cast<size_t>(out_channels) : channels;
+        const int out_rate = out_rate_.load(std::memory_order_relaxed);
+        rate_ = sample_rate;
+        resample_ = false;
+        // webrtc::Resampler handles up to two channels; rates it cannot
+        // convert are delivered as received.
+        if (out_rate > 0 && out_rate != sample_rate && channels_ <= 2 &&
+            resampler_.Reset(sample_rate, out_rate, channels_) == 0) {
+            rate_ = out_rate;
+            resample_ = true;
+        }
+
+        convert_.resize(chunk_frames * channels);
+        batch_frames_ = static_cast<size_t>(rate_) * batch_ms_.load(std::memory_order_relaxed) / 1000;
+        batch_.assign(batch_frames_ * channels_, 0);
+        batch_len_ = 0;
+    }
+
+    void Flush() {
+        if (batch_len_ == 0) {
+            return;
+        }
+        Deliver(batch_.data(), batch_len_, batch_timestamp_us_, batch_capture_time_us_);
+        batch_len_ = 0;
+    }
+
+    void Deliver(const int16_t* samples, size_t frames, int64_t timestamp_us,
+                 std::optional<int64_t> capture_time_us) {
+        if (!callback_) {
+            const uint8_t* bytes = reinterpret_cast<const uint8_t*>(samples);
+            size_t size = frames * channels_ * sizeof(int16_t);
+
+            ShimEvent event{};
+            event.type = SHIM_EVENT_AUDIO_FRAME;
+            event.value = rate_;
+            event.width = static_cast<int>(channels_);
+            event.height = static_cast<int>(frames);
+            event.timestamp_us = timestamp_us;
+            event.capture_time_us = capture_time_us.value_or(0);
+            event.has_capture_time = capture_time_us.has_value() ? 1 : 0;
+            events_.Emit(event, std::vector<uint8_t>(bytes, bytes + size));
+            return;
+        }
+
+        callback_(
+            ctx_,
+            samples,
+            static_cast<int>(frames),
+            rate_,
+            static_cast<int>(channels_),
+            timestamp_us,
+            capture_time_us.value_or(0),
+            capture_time_us.has_value() ? 1 : 0
+        );
+    }
+
+    ShimOnAudioFrame callback_ = nullptr;
+    void* ctx_ = nullptr;
+    shim::EventTarget events_;
+
+    // Requested format, set from any thread
+    std::atomic<int> batch_ms_{0};
+    std::atomic<int> out_rate_{0};
+    std::atomic<int> out_channels_{0};
+    std::atomic<uint32_t> format_generation_{0};
+
+    // Audio thread only
+    uint32_t applied_generation_ = 0;
+    int in_rate_ = 0;
+    size_t in_channels_ = 0;
+    int rate_ = 0;
+    size_t channels_ = 0;
+    bool resample_ = false;
+    webrtc::Resampler resampler_;
+    std::vector<int16_t> convert_;
+    std::vector<int16_t> remix_;
+    std::vector<int16_t> resampled_;
+    std::vector<int16_t> batch_;
+    size_t batch_frames_ = 0;
+    size_t batch_len_ = 0;
+    int64_t batch_timestamp_us_ = 0;
+    std::optional<int64_t> batch_capture_time_us_;
 };
 
 /* ============================================================================
@@ -187,6 +644,196 @@ SHIM_EXPORT int shim_track_set_audio_sink(
     return SHIM_OK;
 }
 
+SHIM_EXPORT int shim_track_set_video_sink_event_queue(
+    ShimTrackSetEventQueueSinkParams* params
+) {
+    if (!params || !params->track || !params->queue) {
+        return SHIM_ERROR_INVALID_PARAM;
+    }
+
+    auto track_ptr = params->track;
+    auto* track = static_cast<webrtc::MediaStreamTrackInterface*>(track_ptr);
+    if (track->kind() != webrtc::MediaStreamTrackInterface::kVideoKind) {
+        return SHIM_ERROR_INVALID_PARAM;
+    }
+
+    auto* video_track = static_cast<webrtc::VideoTrackInterface*>(track);
+
+    std::lock_guard<std::mutex> lock(g_sink_mutex);
+
+    // Remove existing sink if any
+    auto it = g_video_sinks.find(track_ptr);
+    if (it != g_video_sinks.end()) {
+        video_track->RemoveSink(it->second.get());
+        g_video_sinks.erase(it);
+    }
+
+    auto sink = std::make_unique<GoVideoSink>(params->queue->ring, params->tag);
+    video_track->AddOrUpdateSink(sink.get(), webrtc::VideoSinkWants());
+    g_video_sinks[track_ptr] = std::move(sink);
+
+    return SHIM_OK;
+}
+
+SHIM_EXPORT int shim_track_set_audio_sink_event_queue(
+    ShimTrackSetEventQueueSinkParams* params
+) {
+    if (!params || !params->track || !params->queue) {
+        return SHIM_ERROR_INVALID_PARAM;
+    }
+
+    auto track_ptr = params->track;
+    auto* track = static_cast<webrtc::MediaStreamTrackInterface*>(track_ptr);
+    if (track->kind() != webrtc::MediaStreamTrackInterface::kAudioKind) {
+        return SHIM_ERROR_INVALID_PARAM;
+    }
+
+    auto* audio_track = static_cast<webrtc::AudioTrackInterface*>(track);
+
+    std::lock_guard<std::mutex> lock(g_sink_mutex);
+
+    // Remove existing sink if any
+    auto it = g_audio_sinks.find(track_ptr);
+    if (it != g_audio_sinks.end()) {
+        audio_track->RemoveSink(it->second.get());
+        g_audio_sinks.erase(it);
+    }
+
+    auto sink = std::make_unique<GoAudioSink>(params->queue->ring, params->tag);
+    audio_track->AddSink(sink.get());
+    g_audio_sinks[track_ptr] = std::move(sink);
+
+    return SHIM_OK;
+}
+
+SHIM_EXPORT int shim_track_set_video_mailbox(
+    ShimTrackSetVideoMailboxParams* params
+) {
+    if (!params || !params->track || params->slots < 1 || params->slots > SHIM_MAX_VIDEO_MAILBOX_SLOTS) {
+        return SHIM_ERROR_INVALID_PARAM;
+    }
+
+    auto track_ptr = params->track;
+    auto* track = static_cast<webrtc::MediaStreamTrackInterface*>(track_ptr);
+    if (track->kind() != webrtc::MediaStreamTrackInterface::kVideoKind) {
+        return SHIM_ERROR_INVALID_PARAM;
+    }
+
+    auto* video_track = static_cast<webrtc::VideoTrackInterface*>(track);
+
+    std::lock_guard<std::mutex> lock(g_sink_mutex);
+
+    // Remove existing sink if any
+    auto it = g_video_sinks.find(track_ptr);
+    if (it != g_video_sinks.end()) {
+        video_track->RemoveSink(it->second.get());
+        g_video_sinks.erase(it);
+    }
+
+    auto sink = std::make_unique<GoVideoSink>(params->slots);
+    video_track->AddOrUpdateSink(sink.get(), webrtc::VideoSinkWants());
+    g_video_sinks[track_ptr] = std::move(sink);
+
+    return SHIM_OK;
+}
+
+SHIM_EXPORT int shim_track_pull_video_frame(
+    ShimTrackPullVideoFrameParams* params
+) {
+    if (!params || !params->track) {
+        return SHIM_ERROR_INVALID_PARAM;
+    }
+    params->frame = nullptr;
+
+    std::optional<webrtc::VideoFrame> frame;
+    int scale_pixels = 0;
+    {
+        std::lock_guard<std::mutex> lock(g_sink_mutex);
+        auto it = g_video_sinks.find(params->track);
+        if (it == g_video_sinks.end() || !it->second->mailbox()) {
+            return SHIM_ERROR_NOT_FOUND;
+        }
+        frame = it->second->mailbox()->Take();
+        params->frames_dropped = it->second->mailbox()->dropped();
+        scale_pixels = it->second->ScalePixelCount();
+    }
+    if (!frame) {
+        return SHIM_OK;
+    }
+
+    // Scale and convert on the caller's thread, outside the sink lock.
+    auto buffer = ScaleToI420(frame->video_frame_buffer(), scale_pixels);
+    if (!buffer) {
+        return SHIM_ERROR_DECODE_FAILED;
+    }
+    params->frame = new ShimVideoFrame{buffer};
+    params->width = buffer->width();
+    params->height = buffer->height();
+    params->y_plane = buffer->DataY();
+    params->u_plane = buffer->DataU();
+    params->v_plane = buffer->DataV();
+    params->y_stride = buffer->StrideY();
+    params->u_stride = buffer->StrideU();
+    params->v_stride = buffer->StrideV();
+    params->timestamp_us = frame->timestamp_us();
+    return SHIM_OK;
+}
+
+SHIM_EXPORT void shim_video_frame_release(ShimVideoFrame* frame) {
+    delete frame;
+}
+
+SHIM_EXPORT int shim_track_set_audio_sink_format(
+    ShimTrackSetAudioSinkFormatParams* params
+) {
+    if (!params || !params->track ||
+        params->batch_ms < 0 || params->batch_ms > SHIM_MAX_AUDIO_SINK_BATCH_MS ||
+        params->sample_rate < 0 || params->channels < 0 || params->channels > 2) {
+        return SHIM_ERROR_INVALID_PARAM;
+    }
+
+    std::lock_guard<std::mutex> lock(g_sink_mutex);
+
+    auto it = g_audio_sinks.find(params->track);
+    if (it == g_audio_sinks.end()) {
+        return SHIM_ERROR_NOT_FOUND;
+    }
+    it->second->SetFormat(params->batch_ms, params->sample_rate, params->channels);
+
+    return SHIM_OK;
+}
+
+SHIM_EXPORT int shim_track_set_video_sink_wants(
+    ShimTrackSetVideoSinkWantsParams* params
+) {
+    if (!params || !params->track || params->max_pixel_count < 0 ||
+        params->target_pixel_count < 0 || params->max_framerate < 0) {
+        return SHIM_ERROR_INVALID_PARAM;
+    }
+
+    auto track_ptr = params->track;
+    auto* track = static_cast<webrtc::MediaStreamTrackInterface*>(track_ptr);
+    if (track->kind() != webrtc::MediaStreamTrackInterface::kVideoKind) {
+        return SHIM_ERROR_INVALID_PARAM;
+    }
+
+    auto* video_track = static_cast<webrtc::VideoTrackInterface*>(track);
+
+    std::lock_guard<std::mutex> lock(g_sink_mutex);
+
+    auto it = g_video_sinks.find(track_ptr);
+    if (it == g_video_sinks.end()) {
+        return SHIM_ERROR_NOT_FOUND;
+    }
+
+    GoVideoSink* sink = it->second.get();
+    sink->SetWants(params->max_pixel_count, params->target_pixel_count, params->max_framerate);
+    // Let the source adapt upstream where it can, before our own scaling.
+    video_track->AddOrUpdateSink(sink, sink->wants());
+
+    return SHIM_OK;
+}
+
 SHIM_EXPORT void shim_track_remove_video_sink(void* track_ptr) {
     if (!track_ptr) return;
 
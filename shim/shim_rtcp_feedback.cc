@@ -0,0 +1,608 @@
+/*
+ * shim_rtcp_feedback.cc - RTCP feedback notifications for senders
+ *
+ * libwebrtc has no public per-sender hook for incoming RTCP feedback, so it
+ * is reconstructed from what is exposed:
+ *
+ * - PLI and FIR end up as keyframe requests to the sender's encoder. The
+ *   passthrough encoders (shim_encoded_source.cc) report them with the id of
+ *   the video source whose frame they encode, and they are delivered at once
+ *   to the senders of that source. Subscriptions are indexed by the source
+ *   their sender's track sends, updated when the track is replaced, so a
+ *   request only reaches the senders of its source.
+ * - NACK counts come from the sender's outbound-rtp stats. Each subscription
+ *   requests them on the signaling thread with the sender selector, without
+ *   blocking, once per interval (1s by default), and reports the counters
+ *   that grew since the previous round.
+ * - REMB and transport-wide congestion control (TWCC) feedback is counted
+ *   where the call hands it to the network controller (shim_bandwidth.cc) and
+ *   reported once per PeerConnection, in batches.
+ *
+ * Feedback is delivered to the sender's event queue if one is attached and to
+ * its callback otherwise.
+ */
+
+#include "shim_common.h"
+#include "shim_internal.h"
+
+#include <algorithm>
+#include <atomic>
+#include <cstring>
+#include <memory>
+#include <mutex>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+#include "api/media_stream_interface.h"
+#include "api/rtp_parameters.h"
+#include "api/rtp_sender_interface.h"
+#include "api/scoped_refptr.h"
+#include "api/stats/rtc_stats_collector_callback.h"
+#include "api/stats/rtc_stats_report.h"
+#include "api/stats/rtcstats_objects.h"
+#include "api/units/time_delta.h"
+#include "rtc_base/ref_counted_object.h"
+#include "rtc_base/thread.h"
+#include "rtc_base/time_utils.h"
+
+namespace shim {
+
+constexpr int kDefaultNACKIntervalMs = 1000;
+constexpr int kDefaultTransportFeedbackIntervalMs = 100;
+
+struct RTCPFeedbackSubscription {
+    webrtc::scoped_refptr<webrtc::PeerConnectionInterface> peer_connection;
+    webrtc::scoped_refptr<webrtc::RtpSenderInterface> sender;
+    webrtc::Thread* signaling = nullptr;
+    std::atomic<int> interval_ms{kDefaultNACKIntervalMs};
+    // Cleared when the subscription is dropped so feedback in flight is discarded.
+    std::atomic<bool> active{true};
+    // Video source of the sender's track; guarded by the video source registry.
+    uint16_t source_id = 0;
+
+    // Replaces the callback while a queue is attached
+    EventTarget events;
+
+    std::mutex mutex;  // guards the fields below
+    ShimOnRTCPFeedback callback = nullptr;
+    void* ctx = nullptr;
+    bool queued = false;
+
+    // Only touched by NACK rounds, which run one at a time on the signaling thread.
+    bool primed = false;
+    std::unordered_map<uint32_t, int64_t> nacks;  // Count at the previous round, by SSRC
+};
+
+struct TransportFeedbackSubscription {
+    std::shared_ptr<BandwidthEstimator> bandwidth;
+    webrtc::Thread* signaling = nullptr;
+    std::atomic<int> interval_ms{kDefaultTransportFeedbackIntervalMs};
+    std::atomic<bool> active{true};
+
+    std::mutex mutex;  // guards the fields below
+    ShimOnRTCPFeedback callback = nullptr;
+    void* ctx = nullptr;
+
+    // Only touched by rounds, which run one at a time on the signaling thread.
+    bool primed = false;
+    TransportFeedbackTotals totals;
+};
+
+}  // namespace shim
+
+namespace {
+
+// Video source ids, the tracks sending each source, and the sender
+// subscriptions keyframe requests are offered to.
+struct VideoSourceRegistry {
+    std::mutex mutex;  // guards the fields below
+    uint16_t next_id = 1;  // 0 once every id was handed out
+    std::vector<uint16_t> free_ids;
+    // Entries of tracks destroyed before their source are only replaced when
+    // a new track reuses the address; sender tracks always come from the shim.
+    std::unordered_map<const webrtc::MediaStreamTrackInterface*, uint16_t> tracks;
+    // Subscriptions by the source their sender's track sends, and by sender
+    // so a track change can move them.
+    std::unordered_map<uint16_t, std::vector<std::weak_ptr<shim::RTCPFeedbackSubscription>>> subscriptions;
+    std::unordered_map<const webrtc::RtpSenderInterface*, std::weak_ptr<shim::RTCPFeedbackSubscription>> senders;
+};
+
+VideoSourceRegistry& Registry() {
+    static VideoSourceRegistry registry;
+    return registry;
+}
+
+// Remove subscription, and expired entries, from the list of its source.
+// Registry lock held.
+void RemoveFromSource(VideoSourceRegistry& registry, const shim::RTCPFeedbackSubscription* subscription) {
+    auto it = registry.subscriptions.find(subscription->source_id);
+    if (it == registry.subscriptions.end()) {
+        return;
+    }
+    auto& list = it->second;
+    list.erase(std::remove_if(list.begin(), list.end(),
+                              [subscription](const std::weak_ptr<shim::RTCPFeedbackSubscription>& entry) {
+                                  auto live = entry.lock();
+                                  return !live || live.get() == subscription;
+                              }),
+               list.end());
+    if (list.empty()) {
+        registry.subscriptions.erase(it);
+    }
+}
+
+// File subscription under the source track sends, if any. Registry lock held.
+void IndexBySource(VideoSourceRegistry& registry,
+                   const std::shared_ptr<shim::RTCPFeedbackSubscription>& subscription,
+                   const webrtc::MediaStreamTrackInterface* track) {
+    uint16_t id = 0;
+    if (track) {
+        auto it = registry.tracks.find(track);
+        if (it != registry.tracks.end()) {
+            id = it->second;
+        }
+    }
+    if (id == subscription->source_id) {
+        return;
+    }
+    RemoveFromSource(registry, subscription.get());
+    subscription->source_id = id;
+    if (id != 0) {
+        registry.subscriptions[id].push_back(subscription);
+    }
+}
+
+// Forget a dropped subscription. Registry lock held.
+void Unindex(VideoSourceRegistry& registry, const shim::RTCPFeedbackSubscription* subscription) {
+    RemoveFromSource(registry, subscription);
+    auto it = registry.senders.find(subscription->sender.get());
+    if (it != registry.senders.end() && it->second.lock().get() == subscription) {
+        registry.senders.erase(it);
+    }
+}
+
+uint16_t VideoSourceIdOf(const webrtc::MediaStreamTrackInterface* track) {
+    if (!track) {
+        return 0;
+    }
+    auto& registry = Registry();
+    std::lock_guard<std::mutex> lock(registry.mutex);
+    auto it = registry.tracks.find(track);
+    return it != registry.tracks.end() ? it->second : 0;
+}
+
+void AddRecord(std::vector<ShimRTCPFeedback>* records, int type, uint32_t ssrc, int64_t count,
+               int64_t timestamp_us) {
+    if (count <= 0) {
+        return;
+    }
+    ShimRTCPFeedback record;
+    memset(&record, 0, sizeof(record));
+    record.type = type;
+    record.ssrc = ssrc;
+    record.count = static_cast<int>(count);
+    record.timestamp_us = timestamp_us;
+    records->push_back(record);
+}
+
+// One PLI record per SSRC of the streams asking for a keyframe. libwebrtc
+// only exposes the SSRC of some encodings; the others count toward the
+// sender's first SSRC. Runs on the signaling thread.
+std::vector<ShimRTCPFeedback> KeyFrameRequestFeedback(shim::RTCPFeedbackSubscription* subscription,
+                                                      uint32_t streams, int64_t timestamp_us) {
+    const webrtc::RtpParameters parameters = subscription->sender->GetParameters();
+    const uint32_t first_ssrc = subscription->sender->ssrc();
+
+    std::vector<ShimRTCPFeedback> records;
+    for (size_t i = 0; i < 32; ++i) {
+        if (!(streams & (1u << i))) {
+            continue;
+        }
+        uint32_t ssrc = first_ssrc;
+        if (i < parameters.encodings.size() && parameters.encodings[i].ssrc) {
+            ssrc = *parameters.encodings[i].ssrc;
+        }
+        auto it = std::find_if(records.begin(), records.end(),
+                               [ssrc](const ShimRTCPFeedback& record) { return record.ssrc == ssrc; });
+        if (it != records.end()) {
+            it->count++;
+        } else {
+            AddRecord(&records, SHIM_RTCP_FEEDBACK_PLI, ssrc, 1, timestamp_us);
+        }
+    }
+    return records;
+}
+
+// Diff a round's NACK counters against the previous round. The first round
+// only sets the baseline, so feedback from before the subscription is not
+// reported.
+std::vector<ShimRTCPFeedback> CollectNACKs(shim::RTCPFeedbackSubscription* subscription,
+                                           const webrtc::RTCStatsReport& report) {
+    const int64_t now = webrtc::TimeMicros();
+    std::vector<ShimRTCPFeedback> records;
+
+    for (const auto& stat : report) {
+        if (stat.type() != webrtc::RTCOutboundRtpStreamStats::kType) continue;
+        const auto& stream = stat.cast_to<webrtc::RTCOutboundRtpStreamStats>();
+        if (!stream.ssrc.has_value()) continue;
+
+        const uint32_t ssrc = *stream.ssrc;
+        const int64_t current = stream.nack_count.value_or(0);
+
+        // Streams that appear after the first round count from zero.
+        auto it = subscription->nacks.find(ssrc);
+        int64_t previous = 0;
+        if (it != subscription->nacks.end()) {
+            previous = it->second;
+        } else if (!subscription->primed) {
+            previous = current;
+        }
+        AddRecord(&records, SHIM_RTCP_FEEDBACK_NACK, ssrc, current - previous, now);
+        subscription->nacks[ssrc] = current;
+    }
+    subscription->primed = true;
+    return records;
+}
+
+void Deliver(shim::RTCPFeedbackSubscription* subscription, const std::vector<ShimRTCPFeedback>& records) {
+    if (records.empty()) {
+        return;
+    }
+
+    ShimEvent header{};
+    header.type = SHIM_EVENT_RTCP_FEEDBACK;
+    header.value = static_cast<int>(records.size());
+    header.object = subscription->sender.get();
+    header.timestamp_us = records.front().timestamp_us;
+    std::vector<uint8_t> payload(records.size() * sizeof(ShimRTCPFeedback));
+    memcpy(payload.data(), records.data(), payload.size());
+    if (subscription->events.Emit(header, std::move(payload))) {
+        return;
+    }
+
+    ShimOnRTCPFeedback callback;
+    void* ctx;
+    {
+        std::lock_guard<std::mutex> lock(subscription->mutex);
+        callback = subscription->callback;
+        ctx = subscription->ctx;
+    }
+    if (callback) {
+        callback(ctx, records.data(), static_cast<int>(records.size()));
+    }
+}
+
+void ScheduleRound(const std::shared_ptr<shim::RTCPFeedbackSubscription>& subscription, int delay_ms);
+
+// Reports one NACK round and schedules the next, so a slow signaling thread
+// delays rounds instead of piling up requests.
+class FeedbackStatsCallback : public webrtc::RTCStatsCollectorCallback {
+public:
+    explicit FeedbackStatsCallback(std::shared_ptr<shim::RTCPFeedbackSubscription> subscription)
+        : subscription_(std::move(subscription)) {}
+
+    void OnStatsDelivered(const webrtc::scoped_refptr<const webrtc::RTCStatsReport>& report) override {
+        if (!subscription_->active.load(std::memory_order_acquire)) {
+            return;
+        }
+        if (report) {
+            Deliver(subscription_.get(), CollectNACKs(subscription_.get(), *report));
+        }
+        ScheduleRound(subscription_, subscription_->interval_ms.load(std::memory_order_relaxed));
+    }
+
+private:
+    std::shared_ptr<shim::RTCPFeedbackSubscription> subscription_;
+};
+
+// Pending rounds hold the subscription weakly; only a report in flight keeps
+// it alive after it is dropped.
+void ScheduleRound(const std::shared_ptr<shim::RTCPFeedbackSubscription>& subscription, int delay_ms) {
+    std::weak_ptr<shim::RTCPFeedbackSubscription> weak = subscription;
+    subscription->signaling->PostDelayedTask(
+        [weak]() {
+            auto subscription = weak.lock();
+            if (!subscription || !subscription->active.load(std::memory_order_acquire)) {
+                return;
+            }
+            subscription->peer_connection->GetStats(
+                subscription->sender, webrtc::make_ref_counted<FeedbackStatsCallback>(subscription));
+        },
+        webrtc::TimeDelta::Millis(delay_ms));
+}
+
+// Find or create the sender's subscription and apply update to it. The
+// subscription is dropped once it has neither a callback nor a queue.
+template <typename Update>
+void UpdateSubscription(ShimPeerConnection* pc, ShimRTPSender* sender, int interval_ms, Update update) {
+    auto webrtc_sender = reinterpret_cast<webrtc::RtpSenderInterface*>(sender);
+    // Read before locking: the sender proxy may block on the signaling thread.
+    const auto track = webrtc_sender->track();
+
+    std::lock_guard<std::mutex> lock(pc->rtcp_feedback_mutex);
+    auto& subscription = pc->rtcp_feedback[webrtc_sender];
+    const bool created = !subscription;
+    if (created) {
+        subscription = std::make_shared<shim::RTCPFeedbackSubscription>();
+        subscription->peer_connection = pc->peer_connection;
+        subscription->sender = webrtc::scoped_refptr<webrtc::RtpSenderInterface>(webrtc_sender);
+        subscription->signaling = pc->threads ? pc->threads->signaling.get() : shim::GetSignalingThread();
+    }
+    subscription->interval_ms.store(interval_ms > 0 ? interval_ms : shim::kDefaultNACKIntervalMs,
+                                    std::memory_order_relaxed);
+
+    bool keep;
+    {
+        std::lock_guard<std::mutex> sub_lock(subscription->mutex);
+        update(subscription.get());
+        keep = subscription->callback || subscription->queued;
+    }
+
+    if (!keep) {
+        subscription->active.store(false, std::memory_order_release);
+        {
+            auto& registry = Registry();
+            std::lock_guard<std::mutex> registry_lock(registry.mutex);
+            Unindex(registry, subscription.get());
+        }
+        pc->rtcp_feedback.erase(webrtc_sender);
+    } else if (created) {
+        {
+            auto& registry = Registry();
+            std::lock_guard<std::mutex> registry_lock(registry.mutex);
+            registry.senders[webrtc_sender] = subscription;
+            IndexBySource(registry, subscription, track.get());
+        }
+        // Take the NACK baseline right away.
+        ScheduleRound(subscription, 0);
+    }
+}
+
+// Report the REMB and TWCC feedback counted since the previous round and
+// schedule the next. The first round only sets the baseline.
+void ScheduleTransportRound(const std::shared_ptr<shim::TransportFeedbackSubscription>& subscription,
+                            int delay_ms) {
+    std::weak_ptr<shim::TransportFeedbackSubscription> weak = subscription;
+    subscription->signaling->PostDelayedTask(
+        [weak]() {
+            auto subscription = weak.lock();
+            if (!subscription || !subscription->active.load(std::memory_order_acquire)) {
+                return;
+            }
+            const int64_t now = webrtc::TimeMicros();
+            const shim::TransportFeedbackTotals totals = subscription->bandwidth
+                ? subscription->bandwidth->FeedbackTotals()
+                : shim::TransportFeedbackTotals();
+            std::vector<ShimRTCPFeedback> records;
+            if (subscription->primed) {
+                const shim::TransportFeedbackTotals& previous = subscription->totals;
+                if (totals.remb_reports > previous.remb_reports) {
+                    AddRecord(&records, SHIM_RTCP_FEEDBACK_REMB, 0, totals.remb_reports - previous.remb_reports, now);
+                    records.back().bitrate_bps = totals.remb_bitrate_bps;
+                }
+                if (totals.twcc_reports > previous.twcc_reports) {
+                    AddRecord(&records, SHIM_RTCP_FEEDBACK_TWCC, 0, totals.twcc_packets - previous.twcc_packets, now);
+                    records.back().lost = static_cast<int>(totals.twcc_lost - previous.twcc_lost);
+                }
+            }
+            subscription->totals = totals;
+            subscription->primed = true;
+
+            if (!records.empty()) {
+                ShimOnRTCPFeedback callback;
+                void* ctx;
+                {
+                    std::lock_guard<std::mutex> lock(subscription->mutex);
+                    callback = subscription->callback;
+                    ctx = subscription->ctx;
+                }
+                if (callback) {
+                    callback(ctx, records.data(), static_cast<int>(records.size()));
+                }
+            }
+            ScheduleTransportRound(subscription, subscription->interval_ms.load(std::memory_order_relaxed));
+        },
+        webrtc::TimeDelta::Millis(delay_ms));
+}
+
+}  // namespace
+
+namespace shim {
+
+void StopRTCPFeedback(ShimPeerConnection* pc) {
+    std::lock_guard<std::mutex> lock(pc->rtcp_feedback_mutex);
+    {
+        auto& registry = Registry();
+        std::lock_guard<std::mutex> registry_lock(registry.mutex);
+        for (auto& entry : pc->rtcp_feedback) {
+            Unindex(registry, entry.second.get());
+        }
+    }
+    for (auto& entry : pc->rtcp_feedback) {
+        entry.second->active.store(false, std::memory_order_release);
+        entry.second->events.Attach(nullptr, 0);
+    }
+    pc->rtcp_feedback.clear();
+    if (pc->transport_feedback) {
+        pc->transport_feedback->active.store(false, std::memory_order_release);
+        pc->transport_feedback.reset();
+    }
+}
+
+uint16_t AcquireVideoSourceId() {
+    auto& registry = Registry();
+    std::lock_guard<std::mutex> lock(registry.mutex);
+    if (!registry.free_ids.empty()) {
+        const uint16_t id = registry.free_ids.back();
+        registry.free_ids.pop_back();
+        return id;
+    }
+    return registry.next_id != 0 ? registry.next_id++ : 0;
+}
+
+void ReleaseVideoSourceId(uint16_t id) {
+    if (id == 0) {
+        return;
+    }
+    auto& registry = Registry();
+    std::lock_guard<std::mutex> lock(registry.mutex);
+    for (auto it = registry.tracks.begin(); it != registry.tracks.end();) {
+        it = it->second == id ? registry.tracks.erase(it) : std::next(it);
+    }
+    auto it = registry.subscriptions.find(id);
+    if (it != registry.subscriptions.end()) {
+        for (const auto& entry : it->second) {
+            if (auto subscription = entry.lock()) {
+                subscription->source_id = 0;
+            }
+        }
+        registry.subscriptions.erase(it);
+    }
+    registry.free_ids.push_back(id);
+}
+
+void RegisterVideoSourceTrack(uint16_t id, const webrtc::MediaStreamTrackInterface* track) {
+    if (id == 0 || !track) {
+        return;
+    }
+    auto& registry = Registry();
+    std::lock_guard<std::mutex> lock(registry.mutex);
+    registry.tracks[track] = id;
+}
+
+void SetSenderTrack(const webrtc::RtpSenderInterface* sender, const webrtc::MediaStreamTrackInterface* track) {
+    if (!sender) {
+        return;
+    }
+    auto& registry = Registry();
+    std::lock_guard<std::mutex> lock(registry.mutex);
+    auto it = registry.senders.find(sender);
+    if (it == registry.senders.end()) {
+        return;
+    }
+    auto subscription = it->second.lock();
+    if (!subscription) {
+        registry.senders.erase(it);
+        return;
+    }
+    IndexBySource(registry, subscription, track);
+}
+
+// Offer the requests to the subscriptions indexed under the source, on their
+// signaling thread, where the sender's current track is checked again in case
+// it changed since.
+void OnKeyFrameRequest(uint16_t id, uint32_t streams) {
+    if (id == 0 || streams == 0) {
+        return;
+    }
+    const int64_t now = webrtc::TimeMicros();
+
+    std::vector<std::shared_ptr<RTCPFeedbackSubscription>> subscriptions;
+    {
+        auto& registry = Registry();
+        std::lock_guard<std::mutex> lock(registry.mutex);
+        auto indexed = registry.subscriptions.find(id);
+        if (indexed == registry.subscriptions.end()) {
+            return;
+        }
+        auto& weak = indexed->second;
+        weak.erase(std::remove_if(weak.begin(), weak.end(),
+                                  [&subscriptions](const std::weak_ptr<RTCPFeedbackSubscription>& entry) {
+                                      auto subscription = entry.lock();
+                                      if (!subscription || !subscription->active.load(std::memory_order_acquire)) {
+                                          return true;
+                                      }
+                                      subscriptions.push_back(std::move(subscription));
+                                      return false;
+                                  }),
+                   weak.end());
+        if (weak.empty()) {
+            registry.subscriptions.erase(indexed);
+        }
+    }
+
+    for (const auto& subscription : subscriptions) {
+        std::weak_ptr<RTCPFeedbackSubscription> weak = subscription;
+        subscription->signaling->PostTask([weak, id, streams, now]() {
+            auto subscription = weak.lock();
+            if (!subscription || !subscription->active.load(std::memory_order_acquire)) {
+                return;
+            }
+            if (VideoSourceIdOf(subscription->sender->track().get()) != id) {
+                return;
+            }
+            Deliver(subscription.get(), KeyFrameRequestFeedback(subscription.get(), streams, now));
+        });
+    }
+}
+
+}  // namespace shim
+
+/* ============================================================================
+ * C API Implementation
+ * ========================================================================== */
+
+extern "C" {
+
+SHIM_EXPORT void shim_rtp_sender_set_on_rtcp_feedback(ShimRTPSenderSetOnRTCPFeedbackParams* params) {
+    if (!params || !params->pc || !params->pc->peer_connection || !params->sender || params->interval_ms < 0) {
+        return;
+    }
+    UpdateSubscription(params->pc, params->sender, params->interval_ms,
+                       [params](shim::RTCPFeedbackSubscription* subscription) {
+                           subscription->callback = params->callback;
+                           subscription->ctx = params->ctx;
+                       });
+}
+
+SHIM_EXPORT void shim_rtp_sender_set_rtcp_feedback_event_queue(ShimRTPSenderSetRTCPFeedbackEventQueueParams* params) {
+    if (!params || !params->pc || !params->pc->peer_connection || !params->sender || params->interval_ms < 0) {
+        return;
+    }
+    UpdateSubscription(params->pc, params->sender, params->interval_ms,
+                       [params](shim::RTCPFeedbackSubscription* subscription) {
+                           subscription->events.Attach(params->queue ? params->queue->ring : nullptr, params->tag);
+                           subscription->queued = params->queue != nullptr;
+                       });
+}
+
+SHIM_EXPORT void shim_peer_connection_set_on_transport_feedback(
+    ShimPeerConnectionSetOnTransportFeedbackParams* params
+) {
+    if (!params || !params->pc || !params->pc->peer_connection || params->interval_ms < 0) {
+        return;
+    }
+    auto pc = params->pc;
+
+    std::lock_guard<std::mutex> lock(pc->rtcp_feedback_mutex);
+    auto& subscription = pc->transport_feedback;
+    if (!params->callback) {
+        if (subscription) {
+            subscription->active.store(false, std::memory_order_release);
+            subscription.reset();
+        }
+        return;
+    }
+
+    const bool created = !subscription;
+    if (created) {
+        subscription = std::make_shared<shim::TransportFeedbackSubscription>();
+        subscription->bandwidth = pc->bandwidth;
+        subscription->signaling = pc->threads ? pc->threads->signaling.get() : shim::GetSignalingThread();
+    }
+    subscription->interval_ms.store(
+        params->interval_ms > 0 ? params->interval_ms : shim::kDefaultTransportFeedbackIntervalMs,
+        std::memory_order_relaxed);
+    {
+        std::lock_guard<std::mutex> sub_lock(subscription->mutex);
+        subscription->callback = params->callback;
+        subscription->ctx = params->ctx;
+    }
+    if (created) {
+        // Take the baseline right away.
+        ScheduleTransportRound(subscription, 0);
+    }
+}
+
+}  // extern "C"
@@ -1,7 +1,9 @@
 /*
  * shim_rtp_receiver.cc - RTPReceiver implementation
  *
- * RTP receiver functionality: track access, stats, and limited jitter buffer control.
+ * RTP receiver functionality: track access, limited jitter buffer control and
+ * keyframe requests.
+ * Receiver stats are collected in shim_stats.cc.
  *
  * NOTE ON JITTER BUFFER:
  * libwebrtc only exposes SetJitterBufferMinimumDelay() via RtpReceiverInterface.
@@ -16,6 +18,7 @@
 
 #include <cstring>
 
+#include "api/media_stream_interface.h"
 #include "api/rtp_receiver_interface.h"
 
 extern "C" {
@@ -55,30 +58,20 @@ SHIM_EXPORT void* shim_rtp_receiver_get_track(ShimRTPReceiver* receiver) {
 }
 
 /* ============================================================================
- * RTPReceiver Stats
- *
- * NOTE: For detailed receiver stats including jitter buffer info, use
- * PeerConnection::GetStats() which provides RTCInboundRtpStreamStats.
+ * RTCP Feedback
  * ========================================================================== */
 
-SHIM_EXPORT int shim_rtp_receiver_get_stats(ShimRTPReceiverGetStatsParams* params) {
-    if (!params) {
-        return SHIM_ERROR_INVALID_PARAM;
-    }
-
-    if (!params->receiver) {
-        memset(&params->out_stats, 0, sizeof(ShimRTCStats));
+SHIM_EXPORT int shim_rtp_receiver_request_key_frame(ShimRTPReceiver* receiver) {
+    if (!receiver) return SHIM_ERROR_INVALID_PARAM;
+    auto webrtc_receiver = reinterpret_cast<webrtc::RtpReceiverInterface*>(receiver);
+    auto track = webrtc_receiver->track();
+    if (!track || track->kind() != webrtc::MediaStreamTrackInterface::kVideoKind) {
         return SHIM_ERROR_INVALID_PARAM;
     }
-
-    memset(&params->out_stats, 0, sizeof(ShimRTCStats));
-    // Stats come from PeerConnection::GetStats(), not directly from receiver
-    // This function exists for API consistency but returns empty stats
+    // The remote source asks its receive stream, which sends a PLI.
+    auto video_track = static_cast<webrtc::VideoTrackInterface*>(track.get());
+    video_track->GetSource()->GenerateKeyFrame();
     return SHIM_OK;
 }
 
-/* ============================================================================
- * RTCP Feedback
- * ========================================================================== */
-
 }  // extern "C"
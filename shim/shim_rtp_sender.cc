@@ -6,6 +6,7 @@
  */
 
 #include "shim_common.h"
+#include "shim_internal.h"
 
 #include <algorithm>
 #include <cstring>
@@ -50,6 +51,9 @@ SHIM_EXPORT int shim_rtp_sender_replace_track(ShimRTPSenderReplaceTrackParams* p
     auto media_track = static_cast<webrtc::MediaStreamTrackInterface*>(params->track);
 
     bool result = webrtc_sender->SetTrack(media_track);
+    if (result) {
+        shim::SetSenderTrack(webrtc_sender, media_track);
+    }
     return result ? SHIM_OK : SHIM_ERROR_INIT_FAILED;
 }
 
@@ -139,26 +143,6 @@ SHIM_EXPORT void* shim_rtp_sender_get_track(ShimRTPSender* sender) {
     return webrtc_sender->track().get();
 }
 
-SHIM_EXPORT int shim_rtp_sender_get_stats(ShimRTPSenderGetStatsParams* params) {
-    if (!params) {
-        return SHIM_ERROR_INVALID_PARAM;
-    }
-
-    if (!params->sender) {
-        memset(&params->out_stats, 0, sizeof(ShimRTCStats));
-        return SHIM_ERROR_INVALID_PARAM;
-    }
-
-    memset(&params->out_stats, 0, sizeof(ShimRTCStats));
-    // TODO: Implement stats collection
-    return SHIM_OK;
-}
-
-SHIM_EXPORT void shim_rtp_sender_set_on_rtcp_feedback(ShimRTPSenderSetOnRTCPFeedbackParams* params) {
-    // TODO: Implement RTCP feedback notification
-    (void)params;
-}
-
 SHIM_EXPORT int shim_rtp_sender_set_layer_active(ShimRTPSenderSetLayerActiveParams* params) {
     if (!params || !params->sender) {
         shim::SetErrorMessage(params ? params->error_out : nullptr, "invalid parameter", SHIM_ERROR_INVALID_PARAM);
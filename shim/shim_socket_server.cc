@@ -0,0 +1,540 @@
+/*
+ * shim_socket_server.cc - Batched UDP socket server for network threads
+ *
+ * libwebrtc's PhysicalSocketServer makes one recvfrom per readable event and
+ * one sendto per packet. BatchedSocketServer keeps its poll loop but replaces
+ * UDP sockets with ones that:
+ *   - drain the socket with recvmmsg (UDP_GRO where the kernel supports it)
+ *     and hand the packets to the owner one by one from the batch;
+ *   - queue outgoing packets and flush them with one sendmmsg when the
+ *     network thread goes idle or the batch is full, coalescing runs of
+ *     equal-sized packets to one destination with UDP_SEGMENT (GSO).
+ *
+ * Linux only. Other platforms always use PhysicalSocketServer.
+ */
+
+#include "shim_common.h"
+
+#include <atomic>
+#include <mutex>
+
+#if defined(WEBRTC_LINUX)
+#include <netinet/in.h>
+#include <netinet/udp.h>
+#include <sys/socket.h>
+#include <sys/uio.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <cerrno>
+#include <cstring>
+#include <vector>
+
+#include "api/units/timestamp.h"
+#include "rtc_base/physical_socket_server.h"
+#include "rtc_base/socket_address.h"
+#include "rtc_base/time_utils.h"
+
+#ifndef SOL_UDP
+#define SOL_UDP 17
+#endif
+#ifndef UDP_SEGMENT
+#define UDP_SEGMENT 103
+#endif
+#ifndef UDP_GRO
+#define UDP_GRO 104
+#endif
+#endif  // WEBRTC_LINUX
+
+namespace shim {
+
+namespace {
+
+std::mutex g_selection_mutex;
+int g_selected_type = SHIM_SOCKET_SERVER_DEFAULT;
+bool g_selection_locked = false;
+
+std::atomic<uint64_t> g_recv_calls{0};
+std::atomic<uint64_t> g_recv_packets{0};
+std::atomic<uint64_t> g_send_calls{0};
+std::atomic<uint64_t> g_send_packets{0};
+std::atomic<uint64_t> g_gso_sends{0};
+std::atomic<uint64_t> g_send_drops{0};
+
+#if defined(WEBRTC_LINUX)
+
+constexpr int kRecvBatch = 32;
+constexpr size_t kRecvSlotSize = 2048;
+// With GRO one datagram may carry up to 64 KB of coalesced segments.
+constexpr int kRecvBatchGRO = 16;
+constexpr size_t kRecvSlotSizeGRO = 65536;
+// Rounds of recvmmsg per readable event, so one socket cannot starve the rest.
+constexpr int kMaxRecvRounds = 4;
+
+constexpr int kSendBatch = 64;
+constexpr size_t kMaxQueuedPacketSize = 2048;
+constexpr int kMaxGSOSegments = 64;
+constexpr size_t kMaxGSOBytes = 65000;
+
+class BatchedUDPSocket;
+
+class BatchedSocketServer : public webrtc::PhysicalSocketServer {
+public:
+    BatchedSocketServer() {
+        // Probe once; sockets inherit the result.
+        int fd = socket(AF_INET, SOCK_DGRAM, 0);
+        if (fd >= 0) {
+            int one = 1;
+            gro_ = setsockopt(fd, SOL_UDP, UDP_GRO, &one, sizeof(one)) == 0;
+            int zero = 0;
+            gso_ = setsockopt(fd, SOL_UDP, UDP_SEGMENT, &zero, sizeof(zero)) == 0;
+            close(fd);
+        }
+        recv_slots_ = gro_ ? kRecvBatchGRO : kRecvBatch;
+        recv_slot_size_ = gro_ ? kRecvSlotSizeGRO : kRecvSlotSize;
+        recv_area_.resize(recv_slots_ * recv_slot_size_);
+    }
+
+    webrtc::Socket* CreateSocket(int family, int type) override;
+
+    bool Wait(webrtc::TimeDelta max_wait_duration, bool process_io) override {
+        // Everything queued while running tasks goes out before blocking.
+        if (process_io) {
+            FlushSends();
+        }
+        return webrtc::PhysicalSocketServer::Wait(max_wait_duration, process_io);
+    }
+
+    bool gro() const { return gro_; }
+    bool gso() const { return gso_; }
+
+    // Receive buffers shared by all sockets on this (single) network thread.
+    // Contents are only valid during one socket's OnEvent.
+    uint8_t* recv_slot(int i) { return recv_area_.data() + i * recv_slot_size_; }
+    int recv_slots() const { return recv_slots_; }
+    size_t recv_slot_size() const { return recv_slot_size_; }
+
+    void AddPendingSend(BatchedUDPSocket* socket) { pending_.push_back(socket); }
+    void RemovePendingSend(BatchedUDPSocket* socket);
+    void FlushSends();
+
+private:
+    bool gro_ = false;
+    bool gso_ = false;
+    int recv_slots_ = 0;
+    size_t recv_slot_size_ = 0;
+    std::vector<uint8_t> recv_area_;
+    std::vector<BatchedUDPSocket*> pending_;
+};
+
+class BatchedUDPSocket : public webrtc::SocketDispatcher {
+public:
+    explicit BatchedUDPSocket(BatchedSocketServer* server)
+        : webrtc::SocketDispatcher(server), server_(server) {}
+
+    ~BatchedUDPSocket() override {
+        Flush();
+        server_->RemovePendingSend(this);
+    }
+
+    bool Create(int family, int type) override {
+        if (!webrtc::SocketDispatcher::Create(family, type)) {
+            return false;
+        }
+        family_ = family;
+        int fd = GetDescriptor();
+        if (server_->gro()) {
+            int one = 1;
+            gro_ = setsockopt(fd, SOL_UDP, UDP_GRO, &one, sizeof(one)) == 0;
+        }
+        gso_ = server_->gso();
+        return true;
+    }
+
+    // webrtc::Dispatcher
+    void OnEvent(uint32_t ff, int err) override {
+        if (ff & webrtc::DE_READ) {
+            ReadBatches();
+            ff &= ~webrtc::DE_READ;
+        }
+        if (ff) {
+            webrtc::SocketDispatcher::OnEvent(ff, err);
+        }
+    }
+
+    // webrtc::Socket
+    int RecvFrom(void* buffer, size_t length, webrtc::SocketAddress* out_addr,
+                 int64_t* timestamp) override {
+        if (next_ >= batch_.size()) {
+            return webrtc::SocketDispatcher::RecvFrom(buffer, length, out_addr, timestamp);
+        }
+        const Packet& packet = batch_[next_++];
+        size_t size = std::min(length, packet.size);
+        memcpy(buffer, packet.data, size);
+        if (out_addr) {
+            *out_addr = packet.from;
+        }
+        if (timestamp) {
+            *timestamp = packet.arrival_us;
+        }
+        return static_cast<int>(size);
+    }
+
+    int RecvFrom(ReceiveBuffer& buffer) override {
+        if (next_ >= batch_.size()) {
+            return webrtc::SocketDispatcher::RecvFrom(buffer);
+        }
+        const Packet& packet = batch_[next_++];
+        buffer.payload.SetData(packet.data, packet.size);
+        buffer.source_address = packet.from;
+        buffer.arrival_time = webrtc::Timestamp::Micros(packet.arrival_us);
+        return static_cast<int>(packet.size);
+    }
+
+    int SendTo(const void* buffer, size_t length, const webrtc::SocketAddress& addr) override {
+        if (length > kMaxQueuedPacketSize || GetState() == CS_CLOSED) {
+            Flush();
+            return webrtc::SocketDispatcher::SendTo(buffer, length, addr);
+        }
+
+        Outgoing out;
+        out.addr_len = static_cast<socklen_t>(family_ == AF_INET6
+            ? addr.ToDualStackSockAddrStorage(&out.addr)
+            : addr.ToSockAddrStorage(&out.addr));
+        if (out.addr_len == 0) {
+            SetError(EINVAL);
+            return -1;
+        }
+        out.offset = send_area_.size();
+        out.size = length;
+        send_area_.insert(send_area_.end(), static_cast<const uint8_t*>(buffer),
+                          static_cast<const uint8_t*>(buffer) + length);
+        outgoing_.push_back(out);
+
+        if (outgoing_.size() == 1) {
+            server_->AddPendingSend(this);
+        }
+        if (outgoing_.size() >= kSendBatch) {
+            server_->RemovePendingSend(this);
+            Flush();
+        }
+        // UDP is fire and forget; a failed flush is counted, not reported.
+        return static_cast<int>(length);
+    }
+
+    int SetOption(webrtc::Socket::Option opt, int value) override {
+        // Options such as DSCP apply to whatever is sent next.
+        Flush();
+        return webrtc::SocketDispatcher::SetOption(opt, value);
+    }
+
+    int Close() override {
+        Flush();
+        server_->RemovePendingSend(this);
+        return webrtc::SocketDispatcher::Close();
+    }
+
+    // Send everything queued. Called by the server or when the queue is full.
+    void Flush();
+
+private:
+    struct Packet {
+        const uint8_t* data;
+        size_t size;
+        webrtc::SocketAddress from;
+        int64_t arrival_us;
+    };
+
+    struct alignas(cmsghdr) SegmentControl {
+        char buf[CMSG_SPACE(sizeof(uint16_t))];
+    };
+
+    struct Outgoing {
+        sockaddr_storage addr;
+        socklen_t addr_len;
+        size_t offset;
+        size_t size;
+    };
+
+    void ReadBatches();
+    bool SameDestination(const Outgoing& a, const Outgoing& b) const {
+        return a.addr_len == b.addr_len && memcmp(&a.addr, &b.addr, a.addr_len) == 0;
+    }
+
+    BatchedSocketServer* server_;
+    int family_ = AF_INET;
+    bool gro_ = false;
+    bool gso_ = false;
+
+    std::vector<Packet> batch_;
+    size_t next_ = 0;
+
+    std::vector<Outgoing> outgoing_;
+    std::vector<uint8_t> send_area_;
+};
+
+void BatchedSocketServer::RemovePendingSend(BatchedUDPSocket* socket) {
+    pending_.erase(std::remove(pending_.begin(), pending_.end(), socket), pending_.end());
+}
+
+void BatchedSocketServer::FlushSends() {
+    std::vector<BatchedUDPSocket*> sockets;
+    sockets.swap(pending_);
+    for (BatchedUDPSocket* socket : sockets) {
+        socket->Flush();
+    }
+}
+
+webrtc::Socket* BatchedSocketServer::CreateSocket(int family, int type) {
+    if (type != SOCK_DGRAM) {
+        return webrtc::PhysicalSocketServer::CreateSocket(family, type);
+    }
+    auto* socket = new BatchedUDPSocket(this);
+    if (!socket->Create(family, type)) {
+        delete socket;
+        return nullptr;
+    }
+    return socket;
+}
+
+void BatchedUDPSocket::ReadBatches() {
+    int slots = server_->recv_slots();
+    size_t slot_size = server_->recv_slot_size();
+    int fd = GetDescriptor();
+
+    mmsghdr msgs[kRecvBatch];
+    iovec iovs[kRecvBatch];
+    sockaddr_storage addrs[kRecvBatch];
+    alignas(cmsghdr) char controls[kRecvBatch][CMSG_SPACE(sizeof(int))];
+
+    for (int round = 0; round < kMaxRecvRounds; round++) {
+        for (int i = 0; i < slots; i++) {
+            iovs[i].iov_base = server_->recv_slot(i);
+            iovs[i].iov_len = slot_size;
+            msgs[i].msg_hdr = {};
+            msgs[i].msg_hdr.msg_name = &addrs[i];
+            msgs[i].msg_hdr.msg_namelen = sizeof(addrs[i]);
+            msgs[i].msg_hdr.msg_iov = &iovs[i];
+            msgs[i].msg_hdr.msg_iovlen = 1;
+            msgs[i].msg_hdr.msg_control = controls[i];
+            msgs[i].msg_hdr.msg_controllen = sizeof(controls[i]);
+            msgs[i].msg_len = 0;
+        }
+
+        int count = recvmmsg(fd, msgs, slots, MSG_DONTWAIT, nullptr);
+        g_recv_calls.fetch_add(1, std::memory_order_relaxed);
+        if (count <= 0) {
+            return;
+        }
+
+        int64_t arrival_us = webrtc::TimeMicros();
+        batch_.clear();
+        next_ = 0;
+        for (int i = 0; i < count; i++) {
+            if (msgs[i].msg_hdr.msg_flags & MSG_TRUNC) {
+                continue;
+            }
+            webrtc::SocketAddress from;
+            webrtc::SocketAddressFromSockAddrStorage(addrs[i], &from);
+
+            size_t segment = msgs[i].msg_len;
+            if (gro_) {
+                for (cmsghdr* cmsg = CMSG_FIRSTHDR(&msgs[i].msg_hdr); cmsg;
+                     cmsg = CMSG_NXTHDR(&msgs[i].msg_hdr, cmsg)) {
+                    if (cmsg->cmsg_level == SOL_UDP && cmsg->cmsg_type == UDP_GRO) {
+                        int gso_size;
+                        memcpy(&gso_size, CMSG_DATA(cmsg), sizeof(gso_size));
+                        if (gso_size > 0) {
+                            segment = static_cast<size_t>(gso_size);
+                        }
+                    }
+                }
+            }
+
+            // A GRO datagram is a run of segment-sized packets, last one shorter.
+            const uint8_t* data = server_->recv_slot(i);
+            for (size_t off = 0; off < msgs[i].msg_len; off += segment) {
+                size_t size = std::min(segment, static_cast<size_t>(msgs[i].msg_len) - off);
+                batch_.push_back(Packet{data + off, size, from, arrival_us});
+            }
+        }
+        g_recv_packets.fetch_add(batch_.size(), std::memory_order_relaxed);
+
+        // AsyncUDPSocket reads one packet per read event.
+        while (next_ < batch_.size() && GetState() != CS_CLOSED) {
+            size_t before = next_;
+            SignalReadEvent(this);
+            if (next_ == before) {
+                next_++;
+            }
+        }
+        batch_.clear();
+        next_ = 0;
+
+        if (count < slots || GetState() == CS_CLOSED) {
+            return;
+        }
+    }
+}
+
+void BatchedUDPSocket::Flush() {
+    if (outgoing_.empty()) {
+        return;
+    }
+    int fd = GetDescriptor();
+
+    std::vector<mmsghdr> msgs;
+    std::vector<iovec> iovs(outgoing_.size());
+    std::vector<SegmentControl> controls;
+    msgs.reserve(outgoing_.size());
+    controls.reserve(outgoing_.size());
+
+    size_t i = 0;
+    while (i < outgoing_.size()) {
+        // Extend a GSO run: same destination, equal sizes, last may be shorter.
+        size_t run = 1;
+        size_t bytes = outgoing_[i].size;
+        if (gso_) {
+            while (i + run < outgoing_.size() && run < kMaxGSOSegments &&
+                   SameDestination(outgoing_[i], outgoing_[i + run]) &&
+                   outgoing_[i + run].size <= outgoing_[i].size &&
+                   outgoing_[i + run - 1].size == outgoing_[i].size &&
+                   bytes + outgoing_[i + run].size <= kMaxGSOBytes) {
+                bytes += outgoing_[i + run].size;
+                run++;
+            }
+        }
+
+        for (size_t j = 0; j < run; j++) {
+            iovs[i + j].iov_base = send_area_.data() + outgoing_[i + j].offset;
+            iovs[i + j].iov_len = outgoing_[i + j].size;
+        }
+
+        mmsghdr msg = {};
+        msg.msg_hdr.msg_name = &outgoing_[i].addr;
+        msg.msg_hdr.msg_namelen = outgoing_[i].addr_len;
+        msg.msg_hdr.msg_iov = &iovs[i];
+        msg.msg_hdr.msg_iovlen = run;
+        if (run > 1) {
+            controls.emplace_back();
+            msg.msg_hdr.msg_control = controls.back().buf;
+            msg.msg_hdr.msg_controllen = sizeof(controls.back().buf);
+            cmsghdr* cmsg = CMSG_FIRSTHDR(&msg.msg_hdr);
+            cmsg->cmsg_level = SOL_UDP;
+            cmsg->cmsg_type = UDP_SEGMENT;
+            cmsg->cmsg_len = CMSG_LEN(sizeof(uint16_t));
+            uint16_t segment = static_cast<uint16_t>(outgoing_[i].size);
+            memcpy(CMSG_DATA(cmsg), &segment, sizeof(segment));
+            g_gso_sends.fetch_add(1, std::memory_order_relaxed);
+        }
+        msgs.push_back(msg);
+        i += run;
+    }
+
+    size_t done = 0;
+    while (done < msgs.size()) {
+        int sent = sendmmsg(fd, msgs.data() + done, msgs.size() - done, 0);
+        g_send_calls.fetch_add(1, std::memory_order_relaxed);
+        if (sent > 0) {
+            done += sent;
+            continue;
+        }
+        if (errno == EINTR) {
+            continue;
+        }
+        if (errno == EIO && gso_) {
+            // No checksum offload on the egress device: GSO is unusable here.
+            gso_ = false;
+        }
+        if (errno == EAGAIN || errno == EWOULDBLOCK) {
+            for (size_t k = done; k < msgs.size(); k++) {
+                g_send_drops.fetch_add(msgs[k].msg_hdr.msg_iovlen, std::memory_order_relaxed);
+            }
+            break;
+        }
+        // Skip the message the kernel rejected and keep going.
+        g_send_drops.fetch_add(msgs[done].msg_hdr.msg_iovlen, std::memory_order_relaxed);
+        done++;
+    }
+    g_send_packets.fetch_add(outgoing_.size(), std::memory_order_relaxed);
+
+    outgoing_.clear();
+    send_area_.clear();
+}
+
+#endif  // WEBRTC_LINUX
+
+std::unique_ptr<webrtc::Thread> CreateThreadForType(int type) {
+#if defined(WEBRTC_LINUX)
+    if (type == SHIM_SOCKET_SERVER_BATCHED) {
+        return std::make_unique<webrtc::Thread>(std::make_unique<BatchedSocketServer>());
+    }
+#endif
+    return webrtc::Thread::CreateWithSocketServer();
+}
+
+}  // namespace
+
+std::unique_ptr<webrtc::Thread> CreateNetworkThread(int type) {
+    if (type == SHIM_SOCKET_SERVER_DEFAULT) {
+        std::lock_guard<std::mutex> lock(g_selection_mutex);
+        g_selection_locked = true;
+        type = g_selected_type;
+        if (type == SHIM_SOCKET_SERVER_DEFAULT) {
+            type = ShouldUseBatchedSocketServer() ? SHIM_SOCKET_SERVER_BATCHED
+                                                  : SHIM_SOCKET_SERVER_PHYSICAL;
+        }
+    }
+#if !defined(WEBRTC_LINUX)
+    if (type == SHIM_SOCKET_SERVER_BATCHED) {
+        return nullptr;
+    }
+#endif
+    return CreateThreadForType(type);
+}
+
+}  // namespace shim
+
+extern "C" {
+
+SHIM_EXPORT int shim_set_socket_server(ShimSetSocketServerParams* params) {
+    if (!params) {
+        return SHIM_ERROR_INVALID_PARAM;
+    }
+    if (params->type < SHIM_SOCKET_SERVER_DEFAULT || params->type > SHIM_SOCKET_SERVER_BATCHED) {
+        return shim::SetErrorMessage(params->error_out, "invalid socket server type",
+                                     SHIM_ERROR_INVALID_PARAM);
+    }
+#if !defined(WEBRTC_LINUX)
+    if (params->type == SHIM_SOCKET_SERVER_BATCHED) {
+        return shim::SetErrorMessage(params->error_out,
+                                     "batched socket server is only supported on Linux",
+                                     SHIM_ERROR_NOT_SUPPORTED);
+    }
+#endif
+
+    std::lock_guard<std::mutex> lock(shim::g_selection_mutex);
+    if (shim::g_selection_locked) {
+        return shim::SetErrorMessage(params->error_out,
+                                     "socket server must be selected before the first "
+                                     "PeerConnection or factory is created",
+                                     SHIM_ERROR_INVALID_PARAM);
+    }
+    shim::g_selected_type = params->type;
+    shim::ClearError(params->error_out);
+    return SHIM_OK;
+}
+
+SHIM_EXPORT void shim_socket_server_get_stats(ShimSocketServerStats* out) {
+    if (!out) {
+        return;
+    }
+    out->recv_calls = shim::g_recv_calls.load(std::memory_order_relaxed);
+    out->recv_packets = shim::g_recv_packets.load(std::memory_order_relaxed);
+    out->send_calls = shim::g_send_calls.load(std::memory_order_relaxed);
+    out->send_packets = shim::g_send_packets.load(std::memory_order_relaxed);
+    out->gso_sends = shim::g_gso_sends.load(std::memory_order_relaxed);
+    out->send_drops = shim::g_send_drops.load(std::memory_order_relaxed);
+}
+
+}  // extern "C"
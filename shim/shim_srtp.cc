@@ -0,0 +1,226 @@
+/*
+ * shim_srtp.cc - SRTP protect/unprotect implementation
+ *
+ * Wraps libwebrtc's SrtpSession (libsrtp with its hardware-accelerated AES
+ * backends) so bulk RTP/RTCP encryption can run in C for media that is not
+ * carried by a libwebrtc PeerConnection.
+ *
+ * Each context owns one session per direction. SrtpSession keeps its own
+ * replay and rollover state, so no shim-level locking is needed as long as a
+ * context is not driven from two threads at once.
+ */
+
+#include "shim_common.h"
+
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "pc/srtp_session.h"
+#include "rtc_base/buffer.h"
+#include "rtc_base/ssl_stream_adapter.h"
+
+struct ShimSRTPContext {
+    std::unique_ptr<webrtc::SrtpSession> send_session;
+    std::unique_ptr<webrtc::SrtpSession> recv_session;
+};
+
+namespace {
+
+enum class SRTPOp {
+    kProtectRTP,
+    kProtectRTCP,
+    kUnprotectRTP,
+    kUnprotectRTCP,
+};
+
+bool IsSupportedProfile(int profile) {
+    switch (profile) {
+        case SHIM_SRTP_AES128_CM_SHA1_80:
+        case SHIM_SRTP_AES128_CM_SHA1_32:
+        case SHIM_SRTP_AEAD_AES_128_GCM:
+        case SHIM_SRTP_AEAD_AES_256_GCM:
+            return true;
+        default:
+            return false;
+    }
+}
+
+// Create a session for one direction. Returns nullptr (with error_out set)
+// if the key does not match the profile or libsrtp rejects it.
+std::unique_ptr<webrtc::SrtpSession> CreateSession(
+    int crypto_suite,
+    const uint8_t* key,
+    int key_len,
+    bool send,
+    ShimErrorBuffer* error_out
+) {
+    int expected_key_len = 0;
+    int expected_salt_len = 0;
+    if (!webrtc::GetSrtpKeyAndSaltLengths(crypto_suite, &expected_key_len, &expected_salt_len)) {
+        shim::SetErrorMessage(error_out, "unsupported SRTP profile", SHIM_ERROR_NOT_SUPPORTED);
+        return nullptr;
+    }
+    if (key_len != expected_key_len + expected_salt_len) {
+        shim::SetErrorMessage(error_out,
+            std::string(send ? "send" : "receive") + " key must be " +
+            std::to_string(expected_key_len + expected_salt_len) + " bytes (master key + salt), got " +
+            std::to_string(key_len), SHIM_ERROR_INVALID_PARAM);
+        return nullptr;
+    }
+
+    auto session = std::make_unique<webrtc::SrtpSession>(shim::GetEnvironment().field_trials());
+    webrtc::ZeroOnFreeBuffer<uint8_t> key_buffer(key, static_cast<size_t>(key_len));
+    std::vector<int> no_encrypted_header_extensions;
+    bool ok = send
+        ? session->SetSend(crypto_suite, key_buffer, no_encrypted_header_extensions)
+        : session->SetReceive(crypto_suite, key_buffer, no_encrypted_header_extensions);
+    if (!ok) {
+        shim::SetErrorMessage(error_out,
+            std::string("failed to initialize SRTP ") + (send ? "send" : "receive") + " session",
+            SHIM_ERROR_INIT_FAILED);
+        return nullptr;
+    }
+    return session;
+}
+
+int ProcessBatch(ShimSRTPBatchParams* params, SRTPOp op) {
+    if (!params) {
+        return SHIM_ERROR_INVALID_PARAM;
+    }
+    params->out_failed = 0;
+
+    bool protect = op == SRTPOp::kProtectRTP || op == SRTPOp::kProtectRTCP;
+    if (!params->context || params->count < 0) {
+        return shim::SetErrorMessage(params->error_out, "invalid SRTP batch parameters", SHIM_ERROR_INVALID_PARAM);
+    }
+    if (params->count == 0) {
+        shim::ClearError(params->error_out);
+        return SHIM_OK;
+    }
+    if (!params->packets || !params->sizes || (protect && !params->capacities)) {
+        return shim::SetErrorMessage(params->error_out,
+            protect ? "packets, sizes and capacities are required" : "packets and sizes are required",
+            SHIM_ERROR_INVALID_PARAM);
+    }
+
+    webrtc::SrtpSession* session = protect
+        ? params->context->send_session.get()
+        : params->context->recv_session.get();
+    if (!session) {
+        return shim::SetErrorMessage(params->error_out,
+            protect ? "SRTP context has no send key" : "SRTP context has no receive key",
+            SHIM_ERROR_INVALID_PARAM);
+    }
+
+    int failed = 0;
+    for (int i = 0; i < params->count; i++) {
+        uint8_t* data = params->packets[i];
+        int in_len = params->sizes[i];
+        int out_len = 0;
+        bool ok = false;
+
+        if (data && in_len > 0) {
+            switch (op) {
+                case SRTPOp::kProtectRTP:
+                    ok = session->ProtectRtp(data, in_len, params->capacities[i], &out_len);
+                    break;
+                case SRTPOp::kProtectRTCP:
+                    ok = session->ProtectRtcp(data, in_len, params->capacities[i], &out_len);
+                    break;
+                case SRTPOp::kUnprotectRTP:
+                    ok = session->UnprotectRtp(data, in_len, &out_len);
+                    break;
+                case SRTPOp::kUnprotectRTCP:
+                    ok = session->UnprotectRtcp(data, in_len, &out_len);
+                    break;
+            }
+        }
+
+        if (ok) {
+            params->sizes[i] = out_len;
+        } else {
+            params->sizes[i] = -1;
+            failed++;
+        }
+    }
+
+    params->out_failed = failed;
+    if (failed > 0) {
+        return shim::SetErrorMessage(params->error_out,
+            std::to_string(failed) + " of " + std::to_string(params->count) + " packets failed to " +
+            (protect ? "protect" : "unprotect"),
+            protect ? SHIM_ERROR_ENCODE_FAILED : SHIM_ERROR_DECODE_FAILED);
+    }
+
+    shim::ClearError(params->error_out);
+    return SHIM_OK;
+}
+
+}  // namespace
+
+extern "C" {
+
+/* ============================================================================
+ * SRTP Context
+ * ========================================================================== */
+
+SHIM_EXPORT ShimSRTPContext* shim_srtp_context_create(ShimSRTPContextCreateParams* params) {
+    if (!params) {
+        return nullptr;
+    }
+    if (!IsSupportedProfile(params->profile)) {
+        shim::SetErrorMessage(params->error_out, "unsupported SRTP profile", SHIM_ERROR_NOT_SUPPORTED);
+        return nullptr;
+    }
+    if (!params->send_key && !params->recv_key) {
+        shim::SetErrorMessage(params->error_out, "at least one of send_key or recv_key is required",
+                              SHIM_ERROR_INVALID_PARAM);
+        return nullptr;
+    }
+
+    auto context = std::make_unique<ShimSRTPContext>();
+    if (params->send_key) {
+        context->send_session = CreateSession(
+            params->profile, params->send_key, params->send_key_len, true, params->error_out);
+        if (!context->send_session) {
+            return nullptr;
+        }
+    }
+    if (params->recv_key) {
+        context->recv_session = CreateSession(
+            params->profile, params->recv_key, params->recv_key_len, false, params->error_out);
+        if (!context->recv_session) {
+            return nullptr;
+        }
+    }
+
+    shim::ClearError(params->error_out);
+    return context.release();
+}
+
+SHIM_EXPORT void shim_srtp_context_destroy(ShimSRTPContext* context) {
+    delete context;
+}
+
+/* ============================================================================
+ * Batch Protect/Unprotect
+ * ========================================================================== */
+
+SHIM_EXPORT int shim_srtp_protect_rtp(ShimSRTPBatchParams* params) {
+    return ProcessBatch(params, SRTPOp::kProtectRTP);
+}
+
+SHIM_EXPORT int shim_srtp_protect_rtcp(ShimSRTPBatchParams* params) {
+    return ProcessBatch(params, SRTPOp::kProtectRTCP);
+}
+
+SHIM_EXPORT int shim_srtp_unprotect_rtp(ShimSRTPBatchParams* params) {
+    return ProcessBatch(params, SRTPOp::kUnprotectRTP);
+}
+
+SHIM_EXPORT int shim_srtp_unprotect_rtcp(ShimSRTPBatchParams* params) {
+    return ProcessBatch(params, SRTPOp::kUnprotectRTCP);
+}
+
+}  // extern "C"
@@ -2,15 +2,816 @@
  * shim_stats.cc - Statistics and memory helpers
  *
  * Provides RTCStats collection and memory management functions.
+ *
+ * Stats come from PeerConnection::GetStats(). Sender and receiver stats use
+ * the selector overloads, which only build the stats reachable from the
+ * selected streams instead of a full report.
+ *
+ * Stats rings push stats instead: a collector thread requests each
+ * subscribed PeerConnection's report on its signaling thread without waiting,
+ * and the report callback writes fixed-layout records into shared memory
+ * that the consumer reads directly.
  */
 
 #include "shim_common.h"
+#include "shim_internal.h"
 
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstddef>
 #include <cstdlib>
 #include <cstring>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <new>
+#include <optional>
+#include <set>
+#include <string>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+
+#include "api/rtp_receiver_interface.h"
+#include "api/rtp_sender_interface.h"
+#include "api/scoped_refptr.h"
+#include "api/stats/rtc_stats.h"
+#include "api/stats/rtc_stats_collector_callback.h"
+#include "api/stats/rtc_stats_report.h"
+#include "api/stats/rtcstats_objects.h"
+#include "rtc_base/ref_counted_object.h"
+#include "rtc_base/thread.h"
+#include "rtc_base/time_utils.h"
+
+namespace {
+
+/* RTCStatsCollector callback for synchronous stats retrieval */
+class StatsCollectorCallback : public webrtc::RTCStatsCollectorCallback {
+public:
+    std::mutex mutex;
+    std::condition_variable cv;
+    bool done = false;
+    webrtc::scoped_refptr<const webrtc::RTCStatsReport> report;
+
+    void OnStatsDelivered(const webrtc::scoped_refptr<const webrtc::RTCStatsReport>& r) override {
+        std::lock_guard<std::mutex> lock(mutex);
+        report = r;
+        done = true;
+        cv.notify_one();
+    }
+};
+
+// Run GetStats and wait for the report. A sender or receiver selects only
+// the stats of its streams; with neither the full report is collected.
+webrtc::scoped_refptr<const webrtc::RTCStatsReport> CollectStats(
+    ShimPeerConnection* pc,
+    ShimRTPSender* sender,
+    ShimRTPReceiver* receiver) {
+    auto callback = webrtc::make_ref_counted<StatsCollectorCallback>();
+    if (sender) {
+        webrtc::scoped_refptr<webrtc::RtpSenderInterface> selector(
+            reinterpret_cast<webrtc::RtpSenderInterface*>(sender));
+        pc->peer_connection->GetStats(selector, callback);
+    } else if (receiver) {
+        webrtc::scoped_refptr<webrtc::RtpReceiverInterface> selector(
+            reinterpret_cast<webrtc::RtpReceiverInterface*>(receiver));
+        pc->peer_connection->GetStats(selector, callback);
+    } else {
+        pc->peer_connection->GetStats(callback.get());
+    }
+
+    std::unique_lock<std::mutex> lock(callback->mutex);
+    callback->cv.wait(lock, [&]() { return callback->done; });
+    return callback->report;
+}
+
+int ToQualityLimitationReason(const std::string& reason) {
+    if (reason == "none") return SHIM_QUALITY_LIMITATION_NONE;
+    if (reason == "cpu") return SHIM_QUALITY_LIMITATION_CPU;
+    if (reason == "bandwidth") return SHIM_QUALITY_LIMITATION_BANDWIDTH;
+    return SHIM_QUALITY_LIMITATION_OTHER;
+}
+
+// IDs of the candidate pairs the transports are actually using.
+std::set<std::string> SelectedCandidatePairs(const webrtc::RTCStatsReport& report) {
+    std::set<std::string> ids;
+    for (const auto& stat : report) {
+        if (stat.type() != webrtc::RTCTransportStats::kType) continue;
+        const auto& transport = stat.cast_to<webrtc::RTCTransportStats>();
+        if (transport.selected_candidate_pair_id.has_value()) {
+            ids.insert(*transport.selected_candidate_pair_id);
+        }
+    }
+    return ids;
+}
+
+// Sum the counters of every stream into one ShimRTCStats. Per-stream gauges
+// (jitter, remote RTT) report the worst stream, and ICE RTT comes from the
+// selected candidate pair.
+void AggregateStats(const webrtc::RTCStatsReport& report, ShimRTCStats* out) {
+    out->timestamp_us = webrtc::TimeMicros();
+
+    const std::set<std::string> selected_pairs = SelectedCandidatePairs(report);
+
+    for (const auto& stat : report) {
+        // Outbound RTP stream stats (sending)
+        if (stat.type() == webrtc::RTCOutboundRtpStreamStats::kType) {
+            const auto& outbound = stat.cast_to<webrtc::RTCOutboundRtpStreamStats>();
+            if (outbound.bytes_sent.has_value()) {
+                out->bytes_sent += *outbound.bytes_sent;
+            }
+            if (outbound.packets_sent.has_value()) {
+                out->packets_sent += *outbound.packets_sent;
+            }
+            if (outbound.frames_encoded.has_value()) {
+                out->frames_encoded += *outbound.frames_encoded;
+            }
+            if (outbound.key_frames_encoded.has_value()) {
+                out->key_frames_encoded += *outbound.key_frames_encoded;
+            }
+            if (outbound.nack_count.has_value()) {
+                out->nack_count += *outbound.nack_count;
+            }
+            if (outbound.pli_count.has_value()) {
+                out->pli_count += *outbound.pli_count;
+            }
+            if (outbound.fir_count.has_value()) {
+                out->fir_count += *outbound.fir_count;
+            }
+            if (outbound.qp_sum.has_value()) {
+                out->qp_sum += *outbound.qp_sum;
+            }
+            if (outbound.quality_limitation_reason.has_value()) {
+                out->quality_limitation_reason = std::max(
+                    out->quality_limitation_reason,
+                    ToQualityLimitationReason(*outbound.quality_limitation_reason));
+            }
+        }
+
+        // Inbound RTP stream stats (receiving) - includes jitter buffer stats
+        if (stat.type() == webrtc::RTCInboundRtpStreamStats::kType) {
+            const auto& inbound = stat.cast_to<webrtc::RTCInboundRtpStreamStats>();
+            if (inbound.bytes_received.has_value()) {
+                out->bytes_received += *inbound.bytes_received;
+            }
+            if (inbound.packets_received.has_value()) {
+                out->packets_received += *inbound.packets_received;
+            }
+            if (inbound.packets_lost.has_value()) {
+                out->packets_lost += *inbound.packets_lost;
+            }
+            if (inbound.jitter.has_value()) {
+                // jitter is in seconds, convert to ms
+                out->jitter_ms = std::max(out->jitter_ms, *inbound.jitter * 1000.0);
+            }
+            if (inbound.frames_decoded.has_value()) {
+                out->frames_decoded += *inbound.frames_decoded;
+            }
+            if (inbound.key_frames_decoded.has_value()) {
+                out->key_frames_decoded += *inbound.key_frames_decoded;
+            }
+            if (inbound.frames_dropped.has_value()) {
+                out->frames_dropped += *inbound.frames_dropped;
+            }
+            if (inbound.nack_count.has_value()) {
+                out->nack_count += *inbound.nack_count;
+            }
+            if (inbound.pli_count.has_value()) {
+                out->pli_count += *inbound.pli_count;
+            }
+            if (inbound.fir_count.has_value()) {
+                out->fir_count += *inbound.fir_count;
+            }
+            if (inbound.qp_sum.has_value()) {
+                out->qp_sum += *inbound.qp_sum;
+            }
+            // Audio specific
+            if (inbound.audio_level.has_value()) {
+                out->audio_level = *inbound.audio_level;
+            }
+            if (inbound.total_audio_energy.has_value()) {
+                out->total_audio_energy = *inbound.total_audio_energy;
+            }
+            if (inbound.concealment_events.has_value()) {
+                out->concealment_events += *inbound.concealment_events;
+            }
+
+            // Jitter buffer stats
+            if (inbound.jitter_buffer_delay.has_value()) {
+                // jitter_buffer_delay is total delay in seconds, convert to ms
+                out->jitter_buffer_delay_ms = *inbound.jitter_buffer_delay * 1000.0;
+            }
+            if (inbound.jitter_buffer_target_delay.has_value()) {
+                out->jitter_buffer_target_delay_ms = *inbound.jitter_buffer_target_delay * 1000.0;
+            }
+            if (inbound.jitter_buffer_minimum_delay.has_value()) {
+                out->jitter_buffer_minimum_delay_ms = *inbound.jitter_buffer_minimum_delay * 1000.0;
+            }
+            if (inbound.jitter_buffer_emitted_count.has_value()) {
+                out->jitter_buffer_emitted_count = *inbound.jitter_buffer_emitted_count;
+            }
+        }
+
+        // Remote inbound RTP stats (from RTCP receiver reports)
+        if (stat.type() == webrtc::RTCRemoteInboundRtpStreamStats::kType) {
+            const auto& remote = stat.cast_to<webrtc::RTCRemoteInboundRtpStreamStats>();
+            if (remote.packets_lost.has_value()) {
+                out->remote_packets_lost += *remote.packets_lost;
+            }
+            if (remote.jitter.has_value()) {
+                out->remote_jitter_ms = std::max(out->remote_jitter_ms, *remote.jitter * 1000.0);
+            }
+            if (remote.round_trip_time.has_value()) {
+                out->remote_round_trip_time_ms =
+                    std::max(out->remote_round_trip_time_ms, *remote.round_trip_time * 1000.0);
+            }
+        }
+
+        // ICE candidate pair stats; only the pairs in use count
+        if (stat.type() == webrtc::RTCIceCandidatePairStats::kType) {
+            const auto& pair = stat.cast_to<webrtc::RTCIceCandidatePairStats>();
+            if (selected_pairs.count(pair.id()) == 0) {
+                continue;
+            }
+            if (pair.current_round_trip_time.has_value()) {
+                out->current_rtt_ms = static_cast<int64_t>(*pair.current_round_trip_time * 1000.0);
+            }
+            if (pair.total_round_trip_time.has_value()) {
+                out->total_rtt_ms = static_cast<int64_t>(*pair.total_round_trip_time * 1000.0);
+            }
+            if (pair.responses_received.has_value()) {
+                out->responses_received = *pair.responses_received;
+            }
+            if (pair.available_outgoing_bitrate.has_value()) {
+                out->available_outgoing_bitrate = *pair.available_outgoing_bitrate;
+            }
+            if (pair.available_incoming_bitrate.has_value()) {
+                out->available_incoming_bitrate = *pair.available_incoming_bitrate;
+            }
+        }
+
+        // Data channel stats
+        if (stat.type() == webrtc::RTCDataChannelStats::kType) {
+            const auto& dc = stat.cast_to<webrtc::RTCDataChannelStats>();
+            if (dc.messages_sent.has_value()) {
+                out->messages_sent += *dc.messages_sent;
+            }
+            if (dc.messages_received.has_value()) {
+                out->messages_received += *dc.messages_received;
+            }
+            if (dc.bytes_sent.has_value()) {
+                out->bytes_sent_data_channel += *dc.bytes_sent;
+            }
+            if (dc.bytes_received.has_value()) {
+                out->bytes_received_data_channel += *dc.bytes_received;
+            }
+        }
+    }
+
+    // Calculate average RTT if we have data
+    if (out->responses_received > 0 && out->total_rtt_ms > 0) {
+        out->round_trip_time_ms = static_cast<double>(out->total_rtt_ms) /
+                                  static_cast<double>(out->responses_received);
+    }
+}
+
+void CopyString(char* dst, size_t size, const std::optional<std::string>& src) {
+    if (src.has_value()) {
+        strncpy(dst, src->c_str(), size - 1);
+    }
+}
+
+void FillStreamCommon(const webrtc::RTCRtpStreamStats& stream, ShimStreamStats* out) {
+    out->ssrc = stream.ssrc.value_or(0);
+    out->kind = stream.kind.has_value() && *stream.kind == "video" ? 1 : 0;
+}
+
+void FillOutbound(const webrtc::RTCOutboundRtpStreamStats& outbound,
+                  const webrtc::RTCRemoteInboundRtpStreamStats* remote,
+                  ShimStreamStats* out) {
+    FillStreamCommon(outbound, out);
+    out->direction = SHIM_STREAM_OUTBOUND;
+    CopyString(out->mid, sizeof(out->mid), outbound.mid);
+    CopyString(out->rid, sizeof(out->rid), outbound.rid);
+
+    out->bytes = static_cast<int64_t>(outbound.bytes_sent.value_or(0));
+    out->packets = static_cast<int64_t>(outbound.packets_sent.value_or(0));
+    out->retransmitted_bytes = static_cast<int64_t>(outbound.retransmitted_bytes_sent.value_or(0));
+    out->qp_sum = static_cast<int64_t>(outbound.qp_sum.value_or(0));
+    out->target_bitrate_bps = outbound.target_bitrate.value_or(0);
+    out->frames_per_second = outbound.frames_per_second.value_or(0);
+    out->frames = static_cast<int>(outbound.frames_encoded.value_or(0));
+    out->key_frames = static_cast<int>(outbound.key_frames_encoded.value_or(0));
+    out->frame_width = static_cast<int>(outbound.frame_width.value_or(0));
+    out->frame_height = static_cast<int>(outbound.frame_height.value_or(0));
+    out->nack_count = static_cast<int>(outbound.nack_count.value_or(0));
+    out->pli_count = static_cast<int>(outbound.pli_count.value_or(0));
+    out->fir_count = static_cast<int>(outbound.fir_count.value_or(0));
+    if (outbound.quality_limitation_reason.has_value()) {
+        out->quality_limitation_reason = ToQualityLimitationReason(*outbound.quality_limitation_reason);
+    }
+
+    if (remote) {
+        out->packets_lost = static_cast<int64_t>(remote->packets_lost.value_or(0));
+        out->jitter_ms = remote->jitter.value_or(0) * 1000.0;
+        out->round_trip_time_ms = remote->round_trip_time.value_or(0) * 1000.0;
+        out->fraction_lost = remote->fraction_lost.value_or(0);
+    }
+}
+
+void FillInbound(const webrtc::RTCInboundRtpStreamStats& inbound, ShimStreamStats* out) {
+    FillStreamCommon(inbound, out);
+    out->direction = SHIM_STREAM_INBOUND;
+    CopyString(out->mid, sizeof(out->mid), inbound.mid);
+
+    out->bytes = static_cast<int64_t>(inbound.bytes_received.value_or(0));
+    out->packets = static_cast<int64_t>(inbound.packets_received.value_or(0));
+    out->packets_lost = static_cast<int64_t>(inbound.packets_lost.value_or(0));
+    out->jitter_buffer_emitted_count = static_cast<int64_t>(inbound.jitter_buffer_emitted_count.value_or(0));
+    out->qp_sum = static_cast<int64_t>(inbound.qp_sum.value_or(0));
+    out->jitter_ms = inbound.jitter.value_or(0) * 1000.0;
+    out->frames_per_second = inbound.frames_per_second.value_or(0);
+    if (out->jitter_buffer_emitted_count > 0) {
+        out->jitter_buffer_delay_ms = inbound.jitter_buffer_delay.value_or(0) * 1000.0 /
+                                      static_cast<double>(out->jitter_buffer_emitted_count);
+    }
+    out->audio_level = inbound.audio_level.value_or(0);
+    out->frames = static_cast<int>(inbound.frames_decoded.value_or(0));
+    out->key_frames = static_cast<int>(inbound.key_frames_decoded.value_or(0));
+    out->frames_dropped = static_cast<int>(inbound.frames_dropped.value_or(0));
+    out->frame_width = static_cast<int>(inbound.frame_width.value_or(0));
+    out->frame_height = static_cast<int>(inbound.frame_height.value_or(0));
+    out->nack_count = static_cast<int>(inbound.nack_count.value_or(0));
+    out->pli_count = static_cast<int>(inbound.pli_count.value_or(0));
+    out->fir_count = static_cast<int>(inbound.fir_count.value_or(0));
+}
+
+// Write up to max_streams of the report's RTP streams into streams and
+// return how many were written; *total receives the number in the report.
+int FillStreams(const webrtc::RTCStatsReport& report, ShimStreamStats* streams,
+                int max_streams, int* total) {
+    const int64_t timestamp_us = report.timestamp().us();
+
+    // Remote-inbound stats carry the remote's view (loss, jitter, RTT) of
+    // our outbound streams; index them by the outbound stream they describe.
+    std::map<std::string, const webrtc::RTCRemoteInboundRtpStreamStats*> remote_by_local;
+    for (const auto& stat : report) {
+        if (stat.type() != webrtc::RTCRemoteInboundRtpStreamStats::kType) continue;
+        const auto& remote = stat.cast_to<webrtc::RTCRemoteInboundRtpStreamStats>();
+        if (remote.local_id.has_value()) {
+            remote_by_local[*remote.local_id] = &remote;
+        }
+    }
+
+    int count = 0;
+    *total = 0;
+    for (const auto& stat : report) {
+        const bool outbound = stat.type() == webrtc::RTCOutboundRtpStreamStats::kType;
+        const bool inbound = stat.type() == webrtc::RTCInboundRtpStreamStats::kType;
+        if (!outbound && !inbound) continue;
+        (*total)++;
+        if (count >= max_streams) continue;
+
+        ShimStreamStats* out = &streams[count++];
+        memset(out, 0, sizeof(ShimStreamStats));
+        out->timestamp_us = timestamp_us;
+        if (outbound) {
+            auto it = remote_by_local.find(stat.id());
+            FillOutbound(stat.cast_to<webrtc::RTCOutboundRtpStreamStats>(),
+                         it != remote_by_local.end() ? it->second : nullptr, out);
+        } else {
+            FillInbound(stat.cast_to<webrtc::RTCInboundRtpStreamStats>(), out);
+        }
+    }
+    return count;
+}
+
+uint64_t StreamKey(const ShimStreamStats& stream) {
+    return (static_cast<uint64_t>(stream.direction) << 32) | stream.ssrc;
+}
+
+// Fill the interval fields from the counters saved in history by the
+// previous delta call, then save the current ones.
+void ApplyDelta(std::unordered_map<uint64_t, shim::StreamCounters>& history, ShimStreamStats* stream) {
+    shim::StreamCounters& prev = history[StreamKey(*stream)];
+    if (prev.timestamp_us == stream->timestamp_us) {
+        // Same cached report as the previous call; repeat its rates.
+        stream->interval_us = prev.interval_us;
+        stream->bitrate_bps = prev.bitrate_bps;
+        stream->packet_rate = prev.packet_rate;
+        stream->interval_loss_rate = prev.interval_loss_rate;
+        return;
+    }
+    if (prev.timestamp_us > 0 && stream->timestamp_us > prev.timestamp_us) {
+        const int64_t interval_us = stream->timestamp_us - prev.timestamp_us;
+        const double seconds = static_cast<double>(interval_us) / 1e6;
+        const int64_t packets = stream->packets - prev.packets;
+        const int64_t lost = std::max<int64_t>(0, stream->packets_lost - prev.packets_lost);
+        stream->interval_us = interval_us;
+        stream->bitrate_bps = static_cast<double>(stream->bytes - prev.bytes) * 8.0 / seconds;
+        stream->packet_rate = static_cast<double>(packets) / seconds;
+        if (packets + lost > 0) {
+            stream->interval_loss_rate = static_cast<double>(lost) / static_cast<double>(packets + lost);
+        }
+    }
+    prev.timestamp_us = stream->timestamp_us;
+    prev.bytes = stream->bytes;
+    prev.packets = stream->packets;
+    prev.packets_lost = stream->packets_lost;
+    prev.interval_us = stream->interval_us;
+    prev.bitrate_bps = stream->bitrate_bps;
+    prev.packet_rate = stream->packet_rate;
+    prev.interval_loss_rate = stream->interval_loss_rate;
+}
+
+// Forget streams that were not in the report taken at timestamp_us.
+void PruneHistory(std::unordered_map<uint64_t, shim::StreamCounters>& history, int64_t timestamp_us) {
+    for (auto it = history.begin(); it != history.end();) {
+        if (it->second.timestamp_us < timestamp_us) {
+            it = history.erase(it);
+        } else {
+            ++it;
+        }
+    }
+}
+
+}  // namespace
+
+/* ============================================================================
+ * Stats Ring
+ * ========================================================================== */
+
+namespace shim {
+
+// ShimStatsRingHeader with the sequence counters as atomics.
+struct StatsRingHeader {
+    uint32_t capacity;
+    uint32_t record_size;
+    uint32_t records_offset;
+    uint32_t reserved;
+    std::atomic<uint64_t> write_seq;
+    std::atomic<uint64_t> read_seq;
+    std::atomic<uint64_t> dropped;
+};
+
+static_assert(std::atomic<uint64_t>::is_always_lock_free,
+              "stats ring counters are shared with the reader as plain memory");
+static_assert(sizeof(StatsRingHeader) == sizeof(ShimStatsRingHeader), "stats ring header layout");
+static_assert(offsetof(StatsRingHeader, write_seq) == offsetof(ShimStatsRingHeader, write_seq),
+              "stats ring header layout");
+static_assert(offsetof(StatsRingHeader, dropped) == offsetof(ShimStatsRingHeader, dropped),
+              "stats ring header layout");
+
+constexpr int kDefaultStatsRingCapacity = 4096;
+constexpr uint32_t kStatsRecordsOffset = 64;
+
+// Ring memory and its writer. Shared with in-flight stats callbacks, so it
+// outlives the ShimStatsRing until they finish.
+class StatsRingBuffer {
+public:
+    explicit StatsRingBuffer(size_t capacity)
+        : words_((kStatsRecordsOffset + capacity * sizeof(ShimStatsRecord) + 7) / 8),
+          memory_(new uint64_t[words_]()),
+          mask_(capacity - 1) {
+        header_ = new (memory_.get()) StatsRingHeader();
+        header_->capacity = static_cast<uint32_t>(capacity);
+        header_->record_size = sizeof(ShimStatsRecord);
+        header_->records_offset = kStatsRecordsOffset;
+        header_->write_seq.store(0, std::memory_order_relaxed);
+        header_->read_seq.store(0, std::memory_order_relaxed);
+        header_->dropped.store(0, std::memory_order_relaxed);
+        records_ = reinterpret_cast<ShimStatsRecord*>(
+            reinterpret_cast<uint8_t*>(memory_.get()) + kStatsRecordsOffset);
+    }
+
+    ShimStatsRingHeader* header() const {
+        return reinterpret_cast<ShimStatsRingHeader*>(header_);
+    }
+
+    // Publish records, dropping the ones that do not fit behind the reader.
+    void Write(const ShimStatsRecord* records, size_t count) {
+        // Rounds of PeerConnections on different signaling threads race here.
+        std::lock_guard<std::mutex> lock(write_mutex_);
+        const uint64_t write = header_->write_seq.load(std::memory_order_relaxed);
+        const uint64_t read = header_->read_seq.load(std::memory_order_acquire);
+        const size_t space = static_cast<size_t>(mask_ + 1 - (write - read));
+        const size_t n = std::min(count, space);
+        for (size_t i = 0; i < n; i++) {
+            records_[(write + i) & mask_] = records[i];
+        }
+        if (n < count) {
+            header_->dropped.fetch_add(count - n, std::memory_order_relaxed);
+        }
+        header_->write_seq.store(write + n, std::memory_order_release);
+    }
+
+private:
+    size_t words_;
+    std::unique_ptr<uint64_t[]> memory_;
+    uint64_t mask_;
+    StatsRingHeader* header_ = nullptr;
+    ShimStatsRecord* records_ = nullptr;
+    std::mutex write_mutex_;
+};
+
+struct StatsSubscription {
+    webrtc::scoped_refptr<webrtc::PeerConnectionInterface> peer_connection;
+    webrtc::Thread* signaling = nullptr;
+    std::atomic<uint64_t> tag{0};
+    int64_t interval_us = 0;
+    int64_t next_us = 0;
+    // Set while a report is being collected; rounds that come due meanwhile
+    // are skipped so a slow signaling thread does not pile up requests.
+    std::atomic<bool> in_flight{false};
+    // Cleared on unsubscribe so a report still in flight is discarded.
+    std::atomic<bool> active{true};
+    // Only touched by this subscription's callbacks, which run one at a time.
+    std::unordered_map<uint64_t, StreamCounters> history;
+};
+
+}  // namespace shim
+
+struct ShimStatsRing {
+    std::shared_ptr<shim::StatsRingBuffer> buffer;
+    std::mutex mutex;
+    std::condition_variable cv;
+    bool stopping = false;
+    std::map<ShimPeerConnection*, std::shared_ptr<shim::StatsSubscription>> subscriptions;
+    std::thread collector;
+};
+
+namespace {
+
+// Turns one report into a round of ring records.
+class RingStatsCallback : public webrtc::RTCStatsCollectorCallback {
+public:
+    RingStatsCallback(std::shared_ptr<shim::StatsRingBuffer> buffer,
+                      std::shared_ptr<shim::StatsSubscription> subscription)
+        : buffer_(std::move(buffer)), subscription_(std::move(subscription)) {}
+
+    void OnStatsDelivered(const webrtc::scoped_refptr<const webrtc::RTCStatsReport>& report) override {
+        if (report && subscription_->active.load(std::memory_order_acquire)) {
+            WriteRound(*report);
+        }
+        subscription_->in_flight.store(false, std::memory_order_release);
+    }
+
+private:
+    void WriteRound(const webrtc::RTCStatsReport& report) {
+        int total = 0;
+        streams_.resize(std::max<size_t>(streams_.size(), 8));
+        int count = FillStreams(report, streams_.data(), static_cast<int>(streams_.size()), &total);
+        if (total > count) {
+            streams_.resize(total);
+            count = FillStreams(report, streams_.data(), total, &total);
+        }
+
+        ShimStatsRecord transport;
+        memset(&transport, 0, sizeof(transport));
+        transport.tag = subscription_->tag.load(std::memory_order_relaxed);
+        transport.round_us = report.timestamp().us();
+        transport.stream_count = count;
+        for (const std::string& id : SelectedCandidatePairs(report)) {
+            const auto* pair = report.GetAs<webrtc::RTCIceCandidatePairStats>(id);
+            if (!pair) continue;
+            transport.current_rtt_ms = pair->current_round_trip_time.value_or(0) * 1000.0;
+            transport.available_outgoing_bitrate = pair->available_outgoing_bitrate.value_or(0);
+            transport.available_incoming_bitrate = pair->available_incoming_bitrate.value_or(0);
+            break;
+        }
+
+        std::vector<ShimStatsRecord> records(std::max(count, 1), transport);
+        for (int i = 0; i < count; i++) {
+            ApplyDelta(subscription_->history, &streams_[i]);
+            records[i].stream_index = i;
+            records[i].stream = streams_[i];
+        }
+        PruneHistory(subscription_->history, transport.round_us);
+        buffer_->Write(records.data(), records.size());
+    }
+
+    std::shared_ptr<shim::StatsRingBuffer> buffer_;
+    std::shared_ptr<shim::StatsSubscription> subscription_;
+    std::vector<ShimStreamStats> streams_;
+};
+
+// Ask for a subscription's report on its signaling thread. Never blocks:
+// the request is posted and the callback writes the ring when it is ready.
+void RequestStats(const std::shared_ptr<shim::StatsRingBuffer>& buffer,
+                  const std::shared_ptr<shim::StatsSubscription>& subscription) {
+    if (subscription->in_flight.exchange(true, std::memory_order_acq_rel)) {
+        return;
+    }
+    auto callback = webrtc::make_ref_counted<RingStatsCallback>(buffer, subscription);
+    subscription->signaling->PostTask(
+        [peer_connection = subscription->peer_connection, callback]() {
+            peer_connection->GetStats(callback.get());
+        });
+}
+
+void RunCollector(ShimStatsRing* ring) {
+    std::unique_lock<std::mutex> lock(ring->mutex);
+    while (!ring->stopping) {
+        const int64_t now = webrtc::TimeMicros();
+        int64_t next = now + webrtc::kNumMicrosecsPerSec;
+        for (auto& entry : ring->subscriptions) {
+            shim::StatsSubscription& subscription = *entry.second;
+            if (subscription.next_us <= now) {
+                RequestStats(ring->buffer, entry.second);
+                subscription.next_us = std::max(subscription.next_us + subscription.interval_us, now);
+            }
+            next = std::min(next, subscription.next_us);
+        }
+        ring->cv.wait_for(lock, std::chrono::microseconds(std::max<int64_t>(next - now, 0)));
+    }
+}
+
+}  // namespace
 
 extern "C" {
 
+/* ============================================================================
+ * Stats
+ * ========================================================================== */
+
+SHIM_EXPORT int shim_peer_connection_get_stats(ShimPeerConnectionGetStatsParams* params) {
+    if (!params) {
+        return SHIM_ERROR_INVALID_PARAM;
+    }
+    memset(&params->out_stats, 0, sizeof(ShimRTCStats));
+    if (!params->pc || !params->pc->peer_connection) {
+        return SHIM_ERROR_INVALID_PARAM;
+    }
+
+    auto report = CollectStats(params->pc, nullptr, nullptr);
+    if (!report) {
+        return SHIM_ERROR_INIT_FAILED;
+    }
+    AggregateStats(*report, &params->out_stats);
+    return SHIM_OK;
+}
+
+SHIM_EXPORT int shim_rtp_sender_get_stats(ShimRTPSenderGetStatsParams* params) {
+    if (!params) {
+        return SHIM_ERROR_INVALID_PARAM;
+    }
+    memset(&params->out_stats, 0, sizeof(ShimRTCStats));
+    if (!params->pc || !params->pc->peer_connection || !params->sender) {
+        return SHIM_ERROR_INVALID_PARAM;
+    }
+
+    auto report = CollectStats(params->pc, params->sender, nullptr);
+    if (!report) {
+        return SHIM_ERROR_INIT_FAILED;
+    }
+    AggregateStats(*report, &params->out_stats);
+    return SHIM_OK;
+}
+
+SHIM_EXPORT int shim_rtp_receiver_get_stats(ShimRTPReceiverGetStatsParams* params) {
+    if (!params) {
+        return SHIM_ERROR_INVALID_PARAM;
+    }
+    memset(&params->out_stats, 0, sizeof(ShimRTCStats));
+    if (!params->pc || !params->pc->peer_connection || !params->receiver) {
+        return SHIM_ERROR_INVALID_PARAM;
+    }
+
+    auto report = CollectStats(params->pc, nullptr, params->receiver);
+    if (!report) {
+        return SHIM_ERROR_INIT_FAILED;
+    }
+    AggregateStats(*report, &params->out_stats);
+    return SHIM_OK;
+}
+
+SHIM_EXPORT int shim_peer_connection_get_stream_stats(ShimPeerConnectionGetStreamStatsParams* params) {
+    if (!params) {
+        return SHIM_ERROR_INVALID_PARAM;
+    }
+    params->out_count = 0;
+    params->out_total = 0;
+    if (!params->pc || !params->pc->peer_connection ||
+        (params->max_streams > 0 && !params->streams)) {
+        return shim::SetErrorMessage(params->error_out, "invalid parameter", SHIM_ERROR_INVALID_PARAM);
+    }
+
+    auto report = CollectStats(params->pc, params->sender, params->receiver);
+    if (!report) {
+        return shim::SetErrorMessage(params->error_out, "stats collection failed");
+    }
+    const int64_t timestamp_us = report->timestamp().us();
+    int total = 0;
+    const int count = FillStreams(*report, params->streams, params->max_streams, &total);
+
+    if (params->flags & SHIM_STATS_FLAG_DELTA) {
+        std::lock_guard<std::mutex> lock(params->pc->stats_mutex);
+        for (int i = 0; i < count; i++) {
+            ApplyDelta(params->pc->stats_history, &params->streams[i]);
+        }
+        // A full report lists every stream, so forget the ones that ended.
+        if (!params->sender && !params->receiver && count == total) {
+            PruneHistory(params->pc->stats_history, timestamp_us);
+        }
+    }
+
+    params->out_count = count;
+    params->out_total = total;
+    return SHIM_OK;
+}
+
+/* ============================================================================
+ * Stats Ring
+ * ========================================================================== */
+
+SHIM_EXPORT ShimStatsRing* shim_stats_ring_create(ShimStatsRingCreateParams* params) {
+    if (!params) {
+        return nullptr;
+    }
+    if (params->capacity < 0) {
+        shim::SetErrorMessage(params->error_out, "capacity must be >= 0", SHIM_ERROR_INVALID_PARAM);
+        return nullptr;
+    }
+
+    size_t capacity = 2;
+    size_t requested = params->capacity > 0 ? static_cast<size_t>(params->capacity)
+                                            : shim::kDefaultStatsRingCapacity;
+    while (capacity < requested) {
+        capacity <<= 1;
+    }
+
+    auto ring = std::make_unique<ShimStatsRing>();
+    ring->buffer = std::make_shared<shim::StatsRingBuffer>(capacity);
+    ring->collector = std::thread(RunCollector, ring.get());
+    shim::ClearError(params->error_out);
+    return ring.release();
+}
+
+SHIM_EXPORT ShimStatsRingHeader* shim_stats_ring_header(ShimStatsRing* ring) {
+    if (!ring) {
+        return nullptr;
+    }
+    return ring->buffer->header();
+}
+
+SHIM_EXPORT void shim_stats_ring_destroy(ShimStatsRing* ring) {
+    if (!ring) {
+        return;
+    }
+    {
+        std::lock_guard<std::mutex> lock(ring->mutex);
+        ring->stopping = true;
+        for (auto& entry : ring->subscriptions) {
+            entry.second->active.store(false, std::memory_order_release);
+        }
+        ring->subscriptions.clear();
+    }
+    ring->cv.notify_all();
+    ring->collector.join();
+    delete ring;
+}
+
+SHIM_EXPORT int shim_stats_ring_subscribe(ShimStatsRingSubscribeParams* params) {
+    if (!params) {
+        return SHIM_ERROR_INVALID_PARAM;
+    }
+    if (!params->ring || !params->pc || !params->pc->peer_connection || params->interval_ms <= 0) {
+        return shim::SetErrorMessage(params->error_out, "invalid parameter", SHIM_ERROR_INVALID_PARAM);
+    }
+
+    ShimStatsRing* ring = params->ring;
+    {
+        std::lock_guard<std::mutex> lock(ring->mutex);
+        auto& subscription = ring->subscriptions[params->pc];
+        if (!subscription) {
+            subscription = std::make_shared<shim::StatsSubscription>();
+            subscription->peer_connection = params->pc->peer_connection;
+            subscription->signaling = params->pc->threads ? params->pc->threads->signaling.get()
+                                                          : shim::GetSignalingThread();
+            subscription->next_us = webrtc::TimeMicros();
+        }
+        subscription->tag.store(params->tag, std::memory_order_relaxed);
+        subscription->interval_us = static_cast<int64_t>(params->interval_ms) * webrtc::kNumMicrosecsPerMillisec;
+    }
+    ring->cv.notify_all();
+    shim::ClearError(params->error_out);
+    return SHIM_OK;
+}
+
+SHIM_EXPORT void shim_stats_ring_unsubscribe(ShimStatsRingUnsubscribeParams* params) {
+    if (!params || !params->ring) {
+        return;
+    }
+    std::lock_guard<std::mutex> lock(params->ring->mutex);
+    auto it = params->ring->subscriptions.find(params->pc);
+    if (it != params->ring->subscriptions.end()) {
+        it->second->active.store(false, std::memory_order_release);
+        params->ring->subscriptions.erase(it);
+    }
+}
+
 /* ============================================================================
  * Memory Helpers
  * ========================================================================== */
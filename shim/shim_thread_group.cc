@@ -0,0 +1,171 @@
+/*
+ * shim_thread_group.cc - Sharded signaling/worker/network threads
+ *
+ * Each shard owns a signaling/worker/network thread triplet and a
+ * PeerConnectionFactory bound to it. PeerConnections created from different
+ * shards never share a thread, so media and network work scales across cores
+ * instead of serializing on the three global shim threads.
+ */
+
+#include "shim_common.h"
+#include "shim_internal.h"
+
+#include <atomic>
+#include <memory>
+#include <string>
+#include <thread>
+#include <vector>
+
+#if defined(WEBRTC_LINUX)
+#include <pthread.h>
+#include <sched.h>
+#endif
+
+#include "rtc_base/thread.h"
+
+struct ShimThreadGroup {
+    std::vector<std::unique_ptr<ShimPeerConnectionFactory>> shards;
+    std::atomic<uint32_t> next_shard{0};
+};
+
+namespace {
+
+std::unique_ptr<webrtc::Thread> StartThread(std::unique_ptr<webrtc::Thread> thread,
+                                            const std::string& name) {
+    thread->SetName(name, nullptr);
+    thread->Start();
+    return thread;
+}
+
+#if defined(WEBRTC_LINUX)
+bool PinToCPU(webrtc::Thread* thread, int cpu) {
+    return thread->BlockingCall([cpu] {
+        cpu_set_t set;
+        CPU_ZERO(&set);
+        CPU_SET(cpu, &set);
+        return pthread_setaffinity_np(pthread_self(), sizeof(set), &set) == 0;
+    });
+}
+#endif
+
+std::shared_ptr<ShimThreadSet> CreateThreadSet(int shard, int cpu, int socket_server,
+                                               ShimErrorBuffer* error_out) {
+    auto network = shim::CreateNetworkThread(socket_server);
+    if (!network) {
+        shim::SetErrorMessage(error_out, "socket server type not supported on this platform",
+                              SHIM_ERROR_NOT_SUPPORTED);
+        return nullptr;
+    }
+
+    auto threads = std::make_shared<ShimThreadSet>();
+    std::string suffix = "_" + std::to_string(shard);
+    threads->signaling = StartThread(webrtc::Thread::Create(), "signaling_thread" + suffix);
+    threads->worker = StartThread(webrtc::Thread::Create(), "worker_thread" + suffix);
+    threads->network = StartThread(std::move(network), "network_thread" + suffix);
+
+    if (cpu >= 0) {
+#if defined(WEBRTC_LINUX)
+        if (!PinToCPU(threads->signaling.get(), cpu) ||
+            !PinToCPU(threads->worker.get(), cpu) ||
+            !PinToCPU(threads->network.get(), cpu)) {
+            shim::SetErrorMessage(error_out, "failed to set affinity to CPU " + std::to_string(cpu),
+                                  SHIM_ERROR_INVALID_PARAM);
+            return nullptr;
+        }
+#else
+        shim::SetErrorMessage(error_out, "thread pinning is only supported on Linux",
+                              SHIM_ERROR_NOT_SUPPORTED);
+        return nullptr;
+#endif
+    }
+    return threads;
+}
+
+}  // namespace
+
+extern "C" {
+
+SHIM_EXPORT ShimThreadGroup* shim_thread_group_create(ShimThreadGroupCreateParams* params) {
+    if (!params) {
+        return nullptr;
+    }
+    if (params->shard_count < 0 || params->cpu_id_count < 0 ||
+        (params->cpu_id_count > 0 && !params->cpu_ids) ||
+        params->socket_server < SHIM_SOCKET_SERVER_DEFAULT ||
+        params->socket_server > SHIM_SOCKET_SERVER_BATCHED) {
+        shim::SetErrorMessage(params->error_out, "invalid thread group parameters", SHIM_ERROR_INVALID_PARAM);
+        return nullptr;
+    }
+
+    // The shared Environment and global threads back the default factory path;
+    // make sure they exist before any shard is built.
+    shim::InitializeGlobals();
+
+    int cpu_count = static_cast<int>(std::thread::hardware_concurrency());
+    if (cpu_count <= 0) {
+        cpu_count = 1;
+    }
+    int shard_count = params->shard_count > 0 ? params->shard_count : cpu_count;
+
+    auto group = std::make_unique<ShimThreadGroup>();
+    group->shards.reserve(shard_count);
+
+    for (int i = 0; i < shard_count; i++) {
+        int cpu = -1;
+        if (params->pin_threads) {
+            cpu = params->cpu_id_count > 0
+                ? params->cpu_ids[i % params->cpu_id_count]
+                : i % cpu_count;
+        }
+
+        auto shard = std::make_unique<ShimPeerConnectionFactory>();
+        shard->threads = CreateThreadSet(i, cpu, params->socket_server, params->error_out);
+        if (!shard->threads) {
+            return nullptr;
+        }
+        if (!shim::CreateUDPMux(params->factory_config, i, shard->threads->network.get(),
+                                &shard->udp_mux, params->error_out)) {
+            return nullptr;
+        }
+        if (params->factory_config && params->factory_config->loopback_network) {
+            shard->loopback_network = params->factory_config->loopback_network->network;
+        }
+        shard->factory = shim::CreatePeerConnectionFactory(
+            params->factory_config, shard->threads.get(), params->error_out);
+        if (!shard->factory) {
+            return nullptr;
+        }
+        group->shards.push_back(std::move(shard));
+    }
+
+    shim::ClearError(params->error_out);
+    return group.release();
+}
+
+SHIM_EXPORT int shim_thread_group_shard_count(ShimThreadGroup* group) {
+    if (!group) {
+        return 0;
+    }
+    return static_cast<int>(group->shards.size());
+}
+
+SHIM_EXPORT ShimPeerConnectionFactory* shim_thread_group_next_factory(ShimThreadGroup* group) {
+    if (!group || group->shards.empty()) {
+        return nullptr;
+    }
+    uint32_t index = group->next_shard.fetch_add(1, std::memory_order_relaxed);
+    return group->shards[index % group->shards.size()].get();
+}
+
+SHIM_EXPORT ShimPeerConnectionFactory* shim_thread_group_factory(ShimThreadGroup* group, int shard) {
+    if (!group || shard < 0 || shard >= static_cast<int>(group->shards.size())) {
+        return nullptr;
+    }
+    return group->shards[shard].get();
+}
+
+SHIM_EXPORT void shim_thread_group_destroy(ShimThreadGroup* group) {
+    delete group;
+}
+
+}  // extern "C"
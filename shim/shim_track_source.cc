@@ -8,140 +8,197 @@
 #include "shim_internal.h"
 
 #include <algorithm>
+#include <atomic>
+#include <cerrno>
+#include <chrono>
+#include <cstddef>
 #include <cstring>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <new>
 #include <optional>
+#include <string>
+#include <thread>
 #include <vector>
 
+#if defined(WEBRTC_LINUX)
+#include <poll.h>
+#include <sys/eventfd.h>
+#include <sys/mman.h>
+#include <unistd.h>
+#elif defined(WEBRTC_POSIX)
+#include <fcntl.h>
+#include <poll.h>
+#include <sys/mman.h>
+#include <unistd.h>
+#endif
+
 #include "api/audio_options.h"
 #include "rtc_base/time_utils.h"
 #include "api/video/i420_buffer.h"
+#include "common_video/include/video_frame_buffer.h"
 #include "api/video/video_frame.h"
 #include "api/media_stream_interface.h"
 #include "api/video/recordable_encoded_frame.h"
 #include "api/peer_connection_interface.h"
 #include "api/rtp_sender_interface.h"
+#include "media/base/adapted_video_track_source.h"
+#include "rtc_base/ref_counted_object.h"
+#include "libyuv/planar_functions.h"
+#include "libyuv/scale.h"
 
 /* ============================================================================
  * Pushable Video Track Source Implementation
  * ========================================================================== */
 
-// Custom video track source that accepts pushed frames
-class PushableVideoTrackSource : public webrtc::VideoTrackSourceInterface {
+// Custom video track source that accepts pushed frames. AdaptedVideoTrackSource
+// aggregates the wants of its sinks (the encoder's resolution and frame rate
+// adaptation among them) and fans frames out through a VideoBroadcaster;
+// PushFrame asks its VideoAdapter whether to drop each frame and what size to
+// scale it to before copying it out of Go memory. Frames are copied into
+// pooled buffers, recycled once the encoder releases them, instead of a fresh
+// allocation per frame.
+class PushableVideoTrackSource : public webrtc::AdaptedVideoTrackSource {
 public:
+    // Buffers in flight at once: the frame being copied plus those queued
+    // in or held by the encoders. Beyond that frames get plain buffers.
+    static constexpr size_t kMaxPooledBuffers = 8;
+
     PushableVideoTrackSource(int width, int height)
-        : width_(width), height_(height), state_(webrtc::MediaSourceInterface::kLive) {}
+        : width_(width), height_(height) {}
+
+    ~PushableVideoTrackSource() override { shim::ReleaseVideoSourceId(id_); }
+
+    // Carried by the source's frames; see shim::AcquireVideoSourceId.
+    uint16_t id() const { return id_; }
 
     // VideoTrackSourceInterface
     bool is_screencast() const override { return false; }
     std::optional<bool> needs_denoising() const override { return std::nullopt; }
 
-    // Returns stats about the video source
-    bool GetStats(Stats* stats) override {
-        if (!stats) return false;
-        stats->input_width = width_;
-        stats->input_height = height_;
-        return true;
-    }
-
     // MediaSourceInterface
-    SourceState state() const override { return state_; }
+    SourceState state() const override { return kLive; }
     bool remote() const override { return false; }
 
-    // NotifierInterface (part of VideoTrackSourceInterface)
-    void RegisterObserver(webrtc::ObserverInterface* observer) override {
-        std::lock_guard<std::mutex> lock(mutex_);
-        observers_.push_back(observer);
-    }
+    // Wraps the pushed planes in a buffer handed to the sinks as is.
+    using WrapPlanes = std::function<webrtc::scoped_refptr<webrtc::VideoFrameBuffer>()>;
+
+    // Push an I420 frame to all sinks, scaled down or dropped as they want.
+    // The planes are only read during the call, unless `wrap` is set: a
+    // full-size frame is then sent as the buffer it returns, without a copy.
+    // Returns true if `wrap` was used.
+    bool PushFrame(const uint8_t* y_plane, int y_stride,
+                   const uint8_t* u_plane, int u_stride,
+                   const uint8_t* v_plane, int v_stride,
+                   uint32_t rtp_timestamp,
+                   const WrapPlanes& wrap = nullptr) {
+        // Use real wall-clock time for timestamp_us - this is what WebRTC expects
+        const int64_t capture_time_us = webrtc::TimeMicros();
 
-    void UnregisterObserver(webrtc::ObserverInterface* observer) override {
-        std::lock_guard<std::mutex> lock(mutex_);
-        observers_.erase(
-            std::remove(observers_.begin(), observers_.end(), observer),
-            observers_.end()
-        );
-    }
+        int adapted_width, adapted_height, crop_width, crop_height, crop_x, crop_y;
+        if (!AdaptFrame(width_, height_, capture_time_us,
+                        &adapted_width, &adapted_height,
+                        &crop_width, &crop_height, &crop_x, &crop_y)) {
+            return false;
+        }
 
-    // webrtc::VideoSourceInterface<VideoFrame>
-    void AddOrUpdateSink(webrtc::VideoSinkInterface<webrtc::VideoFrame>* sink,
-                         const webrtc::VideoSinkWants& wants) override {
-        std::lock_guard<std::mutex> lock(mutex_);
-        // Check if sink already exists (avoid duplicates)
-        auto it = std::find(sinks_.begin(), sinks_.end(), sink);
-        if (it == sinks_.end()) {
-            sinks_.push_back(sink);
-            fprintf(stderr, "SHIM DEBUG: AddOrUpdateSink NEW sink=%p, total sinks=%zu\n",
-                    (void*)sink, sinks_.size());
+        const bool full_size = adapted_width == width_ && adapted_height == height_;
+        webrtc::scoped_refptr<webrtc::VideoFrameBuffer> frame_buffer;
+        if (full_size && wrap) {
+            frame_buffer = wrap();
+        } else if (full_size) {
+            webrtc::scoped_refptr<webrtc::I420Buffer> buffer = AcquireBuffer(width_, height_);
+            libyuv::I420Copy(
+                y_plane, y_stride,
+                u_plane, u_stride,
+                v_plane, v_stride,
+                buffer->MutableDataY(), buffer->StrideY(),
+                buffer->MutableDataU(), buffer->StrideU(),
+                buffer->MutableDataV(), buffer->StrideV(),
+                width_, height_
+            );
+            frame_buffer = buffer;
         } else {
-            fprintf(stderr, "SHIM DEBUG: AddOrUpdateSink UPDATE sink=%p (already registered)\n",
-                    (void*)sink);
+            // Crop offsets must be even to address the chroma planes.
+            const int uv_x = crop_x / 2;
+            const int uv_y = crop_y / 2;
+            crop_x = uv_x * 2;
+            crop_y = uv_y * 2;
+            webrtc::scoped_refptr<webrtc::I420Buffer> buffer = AcquireBuffer(adapted_width, adapted_height);
+            libyuv::I420Scale(
+                y_plane + crop_y * y_stride + crop_x, y_stride,
+                u_plane + uv_y * u_stride + uv_x, u_stride,
+                v_plane + uv_y * v_stride + uv_x, v_stride,
+                crop_width, crop_height,
+                buffer->MutableDataY(), buffer->StrideY(),
+                buffer->MutableDataU(), buffer->StrideU(),
+                buffer->MutableDataV(), buffer->StrideV(),
+                adapted_width, adapted_height,
+                libyuv::kFilterBox
+            );
+            frame_buffer = buffer;
         }
-        fflush(stderr);
-    }
 
-    void RemoveSink(webrtc::VideoSinkInterface<webrtc::VideoFrame>* sink) override {
-        std::lock_guard<std::mutex> lock(mutex_);
-        sinks_.erase(
-            std::remove(sinks_.begin(), sinks_.end(), sink),
-            sinks_.end()
-        );
+        OnFrame(webrtc::VideoFrame::Builder()
+            .set_video_frame_buffer(frame_buffer)
+            .set_timestamp_us(capture_time_us)
+            .set_timestamp_rtp(rtp_timestamp)
+            .set_rotation(webrtc::kVideoRotation_0)
+            .set_id(id_)
+            .build());
+        return full_size && wrap;
     }
 
-    bool SupportsEncodedOutput() const override { return false; }
-    void GenerateKeyFrame() override {}
-    void AddEncodedSink(webrtc::VideoSinkInterface<webrtc::RecordableEncodedFrame>*) override {}
-    void RemoveEncodedSink(webrtc::VideoSinkInterface<webrtc::RecordableEncodedFrame>*) override {}
+    int width() const { return width_; }
+    int height() const { return height_; }
 
-    // Push a frame to all registered sinks
-    void PushFrame(webrtc::scoped_refptr<webrtc::I420Buffer> buffer, int64_t timestamp_us, uint32_t rtp_timestamp) {
-        std::lock_guard<std::mutex> lock(mutex_);
+    uint64_t pool_hits() const { return pool_hits_.load(std::memory_order_relaxed); }
+    uint64_t pool_misses() const { return pool_misses_.load(std::memory_order_relaxed); }
 
-        // Use real wall-clock time for timestamp_us - this is what WebRTC expects
-        // The passed-in timestamp_us is used to derive RTP timestamp if not explicitly provided
-        int64_t capture_time_us = webrtc::TimeMicros();
-
-        // DEBUG: Log sink count periodically
-        static int frame_count = 0;
-        frame_count++;
-        if (frame_count % 100 == 0) {
-            fprintf(stderr, "SHIM DEBUG: PushFrame frame=%d sinks=%zu capture_us=%lld rtp_ts=%u\n",
-                    frame_count, sinks_.size(), (long long)capture_time_us, rtp_timestamp);
-            fflush(stderr);
+private:
+    // Take a recycled buffer from the pool, or allocate one when every
+    // pooled buffer is still in use; only the latter counts as a miss. A
+    // buffer is free once the pool holds its only reference, as in
+    // webrtc::VideoFrameBufferPool, whose allocations cannot be observed.
+    webrtc::scoped_refptr<webrtc::I420Buffer> AcquireBuffer(int width, int height) {
+        std::lock_guard<std::mutex> lock(pool_mutex_);
+        if (width != pool_width_ || height != pool_height_) {
+            // Buffers of the previous size still in use are freed by their
+            // last holder.
+            pool_.clear();
+            pool_width_ = width;
+            pool_height_ = height;
         }
-
-        webrtc::VideoFrame frame = webrtc::VideoFrame::Builder()
-            .set_video_frame_buffer(buffer)
-            .set_timestamp_us(capture_time_us)
-            .set_timestamp_rtp(rtp_timestamp)
-            .set_rotation(webrtc::kVideoRotation_0)
-            .build();
-
-        // DEBUG: Log frame delivery to sinks
-        static int deliver_count = 0;
-        deliver_count++;
-        if (deliver_count % 100 == 0) {
-            fprintf(stderr, "SHIM DEBUG: Delivering frame %d to %zu sinks, size=%dx%d rtp=%u\n",
-                    deliver_count, sinks_.size(), buffer->width(), buffer->height(), rtp_timestamp);
-            fflush(stderr);
+        for (const auto& buffer : pool_) {
+            // I420Buffer::Create makes RefCountedObject<I420Buffer>.
+            if (static_cast<webrtc::RefCountedObject<webrtc::I420Buffer>*>(buffer.get())->HasOneRef()) {
+                pool_hits_.fetch_add(1, std::memory_order_relaxed);
+                return buffer;
+            }
         }
-
-        for (auto* sink : sinks_) {
-            sink->OnFrame(frame);
+        pool_misses_.fetch_add(1, std::memory_order_relaxed);
+        webrtc::scoped_refptr<webrtc::I420Buffer> buffer = webrtc::I420Buffer::Create(width, height);
+        if (pool_.size() < kMaxPooledBuffers) {
+            pool_.push_back(buffer);
         }
+        return buffer;
     }
 
-    int width() const { return width_; }
-    int height() const { return height_; }
+    const int width_;
+    const int height_;
+    const uint16_t id_ = shim::AcquireVideoSourceId();
 
-private:
-    int width_;
-    int height_;
-    SourceState state_;
-    std::mutex mutex_;
-    std::vector<webrtc::ObserverInterface*> observers_;
-    std::vector<webrtc::VideoSinkInterface<webrtc::VideoFrame>*> sinks_;
+    std::mutex pool_mutex_;
+    std::vector<webrtc::scoped_refptr<webrtc::I420Buffer>> pool_;
+    int pool_width_ = 0;
+    int pool_height_ = 0;
+    std::atomic<uint64_t> pool_hits_{0};
+    std::atomic<uint64_t> pool_misses_{0};
 };
 
 struct ShimVideoTrackSource {
+    std::shared_ptr<ShimThreadSet> threads;  // Thread-group threads (if any); outlive the track
     webrtc::scoped_refptr<PushableVideoTrackSource> source;
     webrtc::scoped_refptr<webrtc::VideoTrackInterface> track;
     webrtc::scoped_refptr<webrtc::PeerConnectionFactoryInterface> factory;  // Keep reference to factory for track creation
@@ -149,6 +206,277 @@ struct ShimVideoTrackSource {
     int height;
 };
 
+/* ============================================================================
+ * Video Frame Ring
+ * ========================================================================== */
+
+// ShimVideoFrameRingHeader with the counters shared with the producer as
+// atomics.
+struct VideoFrameRingHeader {
+    uint32_t slot_count;
+    uint32_t slot_size;
+    uint32_t slots_offset;
+    int32_t width;
+    int32_t height;
+    int32_t y_stride;
+    int32_t u_stride;
+    int32_t v_stride;
+    uint32_t y_offset;
+    uint32_t u_offset;
+    uint32_t v_offset;
+    int32_t notify_fd;
+    uint32_t reserved0[4];
+    std::atomic<uint64_t> write_seq;
+    uint64_t reserved1[7];
+    std::atomic<uint64_t> read_seq;
+    std::atomic<uint32_t> consumer_waiting;
+    uint32_t reserved2;
+    uint64_t reserved3[6];
+};
+
+static_assert(std::atomic<uint64_t>::is_always_lock_free && std::atomic<uint32_t>::is_always_lock_free,
+              "video frame ring counters are shared with the producer as plain memory");
+static_assert(sizeof(VideoFrameRingHeader) == sizeof(ShimVideoFrameRingHeader), "video frame ring header layout");
+static_assert(offsetof(VideoFrameRingHeader, write_seq) == offsetof(ShimVideoFrameRingHeader, write_seq),
+              "video frame ring header layout");
+static_assert(offsetof(VideoFrameRingHeader, read_seq) == offsetof(ShimVideoFrameRingHeader, read_seq),
+              "video frame ring header layout");
+static_assert(offsetof(VideoFrameRingHeader, consumer_waiting) ==
+              offsetof(ShimVideoFrameRingHeader, consumer_waiting),
+              "video frame ring header layout");
+static_assert(offsetof(ShimVideoFrameRingHeader, write_seq) % 64 == 0 &&
+              offsetof(ShimVideoFrameRingHeader, read_seq) % 64 == 0,
+              "producer and consumer counters sit on their own cache lines");
+static_assert(sizeof(ShimVideoFrameSlotHeader) == 64, "video frame slot header layout");
+
+// Slots are consumed by a shim thread that pushes them through the source
+// like shim_video_track_source_push_frame. A full-size frame goes to the
+// sinks as a wrapper around the slot, which is released to the producer
+// when the last reference to the buffer goes away.
+class VideoFrameRing {
+public:
+    static constexpr size_t kDefaultSlots = 4;
+    static constexpr size_t kMaxSlots = 64;
+    static constexpr uint32_t kAlignment = 64;
+    // Upper bound on a sleep, in case a wake-up write failed.
+    static constexpr int kWaitTimeoutMs = 100;
+
+    VideoFrameRing(webrtc::scoped_refptr<PushableVideoTrackSource> source, size_t slots)
+        : source_(std::move(source)), mask_(slots - 1), released_(slots, false) {}
+
+    ~VideoFrameRing() {
+        if (memory_) {
+#if defined(WEBRTC_POSIX)
+            munmap(memory_, size_);
+#else
+            ::operator delete(memory_, std::align_val_t(kAlignment));
+#endif
+        }
+#if defined(WEBRTC_POSIX)
+        if (write_fd_ >= 0 && write_fd_ != read_fd_) {
+            close(write_fd_);
+        }
+        if (read_fd_ >= 0) {
+            close(read_fd_);
+        }
+#endif
+    }
+
+    // Maps the ring and lays out the slots for the source's frame size.
+    bool Init(ShimErrorBuffer* error_out) {
+        const int width = source_->width();
+        const int height = source_->height();
+        const uint32_t y_stride = Align(static_cast<uint32_t>(width));
+        const uint32_t uv_stride = Align(static_cast<uint32_t>((width + 1) / 2));
+        const uint32_t uv_height = static_cast<uint32_t>((height + 1) / 2);
+        const uint32_t y_offset = static_cast<uint32_t>(sizeof(ShimVideoFrameSlotHeader));
+        const uint32_t u_offset = Align(y_offset + y_stride * static_cast<uint32_t>(height));
+        const uint32_t v_offset = Align(u_offset + uv_stride * uv_height);
+        const uint32_t slot_size = Align(v_offset + uv_stride * uv_height);
+        const uint32_t slots_offset = Align(static_cast<uint32_t>(sizeof(ShimVideoFrameRingHeader)));
+        size_ = slots_offset + static_cast<size_t>(slot_size) * (mask_ + 1);
+
+#if defined(WEBRTC_POSIX)
+        void* memory = mmap(nullptr, size_, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+        if (memory == MAP_FAILED) {
+            shim::SetErrorMessage(error_out, std::string("mmap failed: ") + strerror(errno));
+            return false;
+        }
+        memory_ = memory;
+#else
+        memory_ = ::operator new(size_, std::align_val_t(kAlignment), std::nothrow);
+        if (!memory_) {
+            shim::SetErrorMessage(error_out, "failed to allocate video frame ring");
+            return false;
+        }
+        std::memset(memory_, 0, size_);
+#endif
+
+#if defined(WEBRTC_LINUX)
+        read_fd_ = eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC);
+        if (read_fd_ < 0) {
+            shim::SetErrorMessage(error_out, std::string("eventfd failed: ") + strerror(errno));
+            return false;
+        }
+        write_fd_ = read_fd_;
+#elif defined(WEBRTC_POSIX)
+        int fds[2];
+        if (pipe(fds) != 0) {
+            shim::SetErrorMessage(error_out, std::string("pipe failed: ") + strerror(errno));
+            return false;
+        }
+        for (int fd : fds) {
+            fcntl(fd, F_SETFL, fcntl(fd, F_GETFL) | O_NONBLOCK);
+            fcntl(fd, F_SETFD, FD_CLOEXEC);
+        }
+        read_fd_ = fds[0];
+        write_fd_ = fds[1];
+#endif
+
+        header_ = new (memory_) VideoFrameRingHeader();
+        header_->slot_count = static_cast<uint32_t>(mask_ + 1);
+        header_->slot_size = slot_size;
+        header_->slots_offset = slots_offset;
+        header_->width = width;
+        header_->height = height;
+        header_->y_stride = static_cast<int32_t>(y_stride);
+        header_->u_stride = static_cast<int32_t>(uv_stride);
+        header_->v_stride = static_cast<int32_t>(uv_stride);
+        header_->y_offset = y_offset;
+        header_->u_offset = u_offset;
+        header_->v_offset = v_offset;
+        header_->notify_fd = write_fd_;
+        header_->write_seq.store(0, std::memory_order_relaxed);
+        header_->read_seq.store(0, std::memory_order_relaxed);
+        header_->consumer_waiting.store(0, std::memory_order_relaxed);
+        slots_ = static_cast<uint8_t*>(memory_) + slots_offset;
+        return true;
+    }
+
+    ShimVideoFrameRingHeader* header() const {
+        return reinterpret_cast<ShimVideoFrameRingHeader*>(header_);
+    }
+
+    // `self` keeps the ring mapped for buffers still held by the sinks.
+    void Start(const std::shared_ptr<VideoFrameRing>& self) {
+        consumer_ = std::thread([this, weak = std::weak_ptr<VideoFrameRing>(self)] { Run(weak); });
+    }
+
+    void Stop() {
+        stopping_.store(true, std::memory_order_seq_cst);
+        Wake();
+        consumer_.join();
+    }
+
+private:
+    static uint32_t Align(uint32_t n) {
+        return (n + kAlignment - 1) & ~(kAlignment - 1);
+    }
+
+    void Run(const std::weak_ptr<VideoFrameRing>& weak) {
+        std::shared_ptr<VideoFrameRing> self = weak.lock();
+        uint64_t next = 0;
+        while (!stopping_.load(std::memory_order_acquire)) {
+            const uint64_t write = header_->write_seq.load(std::memory_order_acquire);
+            if (next == write) {
+                Wait(next);
+                continue;
+            }
+            for (; next != write; next++) {
+                Consume(self, next);
+            }
+        }
+    }
+
+    // Sleeps until the producer publishes past `seq`. consumer_waiting is
+    // set before write_seq is checked again, and the producer stores
+    // write_seq before it checks consumer_waiting, so one of the two sees
+    // the other's store.
+    void Wait(uint64_t seq) {
+        header_->consumer_waiting.store(1, std::memory_order_seq_cst);
+        if (header_->write_seq.load(std::memory_order_seq_cst) == seq &&
+            !stopping_.load(std::memory_order_seq_cst)) {
+#if defined(WEBRTC_POSIX)
+            pollfd pfd = {read_fd_, POLLIN, 0};
+            if (poll(&pfd, 1, kWaitTimeoutMs) > 0) {
+                uint64_t drained[8];
+                while (read(read_fd_, drained, sizeof(drained)) > 0) {
+                }
+            }
+#else
+            std::this_thread::sleep_for(std::chrono::milliseconds(1));
+#endif
+        }
+        header_->consumer_waiting.store(0, std::memory_order_relaxed);
+    }
+
+    void Wake() {
+#if defined(WEBRTC_POSIX)
+        uint64_t one = 1;
+        ssize_t ignored = write(write_fd_, &one, sizeof(one));
+        (void)ignored;
+#endif
+    }
+
+    void Consume(const std::shared_ptr<VideoFrameRing>& self, uint64_t seq) {
+        uint8_t* slot = slots_ + (seq & mask_) * header_->slot_size;
+        const int64_t timestamp_us = reinterpret_cast<const ShimVideoFrameSlotHeader*>(slot)->timestamp_us;
+        const uint8_t* y_plane = slot + header_->y_offset;
+        const uint8_t* u_plane = slot + header_->u_offset;
+        const uint8_t* v_plane = slot + header_->v_offset;
+
+        // Same RTP conversion as shim_video_track_source_push_frame.
+        const bool wrapped = source_->PushFrame(
+            y_plane, header_->y_stride,
+            u_plane, header_->u_stride,
+            v_plane, header_->v_stride,
+            static_cast<uint32_t>(timestamp_us * 9 / 100),
+            [&]() -> webrtc::scoped_refptr<webrtc::VideoFrameBuffer> {
+                return webrtc::WrapI420Buffer(
+                    header_->width, header_->height,
+                    y_plane, header_->y_stride,
+                    u_plane, header_->u_stride,
+                    v_plane, header_->v_stride,
+                    [self, seq] { self->Release(seq); });
+            });
+        if (!wrapped) {
+            Release(seq);
+        }
+    }
+
+    // Hands a slot back to the producer. Slots can come back out of order;
+    // read_seq only moves past a contiguous run of released ones.
+    void Release(uint64_t seq) {
+        std::lock_guard<std::mutex> lock(release_mutex_);
+        released_[seq & mask_] = true;
+        uint64_t read = header_->read_seq.load(std::memory_order_relaxed);
+        while (released_[read & mask_]) {
+            released_[read & mask_] = false;
+            read++;
+        }
+        header_->read_seq.store(read, std::memory_order_release);
+    }
+
+    webrtc::scoped_refptr<PushableVideoTrackSource> source_;
+    const uint64_t mask_;
+    size_t size_ = 0;
+    void* memory_ = nullptr;
+    VideoFrameRingHeader* header_ = nullptr;
+    uint8_t* slots_ = nullptr;
+    int read_fd_ = -1;
+    int write_fd_ = -1;
+
+    std::mutex release_mutex_;
+    std::vector<bool> released_;
+
+    std::atomic<bool> stopping_{false};
+    std::thread consumer_;
+};
+
+struct ShimVideoFrameRing {
+    std::shared_ptr<VideoFrameRing> ring;
+};
+
 /* ============================================================================
  * Pushable Audio Track Source Implementation
  * ========================================================================== */
@@ -232,6 +560,7 @@ private:
 };
 
 struct ShimAudioTrackSource {
+    std::shared_ptr<ShimThreadSet> threads;  // Thread-group threads (if any); outlive the track
     webrtc::scoped_refptr<PushableAudioSource> source;
     webrtc::scoped_refptr<webrtc::AudioTrackInterface> track;
     webrtc::scoped_refptr<webrtc::PeerConnectionFactoryInterface> factory;  // Keep reference to factory for track creation
@@ -258,6 +587,7 @@ SHIM_EXPORT ShimVideoTrackSource* shim_video_track_source_create(
 
     auto shim_source = std::make_unique<ShimVideoTrackSource>();
     shim_source->source = webrtc::make_ref_counted<PushableVideoTrackSource>(width, height);
+    shim_source->threads = pc->threads;
     shim_source->factory = pc->factory;  // Keep reference to factory
     shim_source->width = width;
     shim_source->height = height;
@@ -274,35 +604,83 @@ SHIM_EXPORT int shim_video_track_source_push_frame(
     }
 
     auto source = params->source;
-    const uint8_t* y_plane = params->y_plane;
-    const uint8_t* u_plane = params->u_plane;
-    const uint8_t* v_plane = params->v_plane;
-    int y_stride = params->y_stride;
-    int u_stride = params->u_stride;
-    int v_stride = params->v_stride;
     int64_t timestamp_us = params->timestamp_us;
 
-    // Create I420 buffer from input planes
-    webrtc::scoped_refptr<webrtc::I420Buffer> buffer = webrtc::I420Buffer::Copy(
-        source->width, source->height,
-        y_plane, y_stride,
-        u_plane, u_stride,
-        v_plane, v_stride
-    );
-
-    if (!buffer) {
-        return SHIM_ERROR_OUT_OF_MEMORY;
-    }
-
     // Convert timestamp_us back to RTP timestamp (90kHz)
     // The Go side passes timestamp_us as PTS * 1000000 / 90000
     // So RTP = timestamp_us * 90000 / 1000000 = timestamp_us * 9 / 100
     uint32_t rtp_timestamp = static_cast<uint32_t>(timestamp_us * 9 / 100);
 
-    source->source->PushFrame(buffer, timestamp_us, rtp_timestamp);
+    // Frames the sinks do not want are dropped here, before any copy.
+    source->source->PushFrame(
+        params->y_plane, params->y_stride,
+        params->u_plane, params->u_stride,
+        params->v_plane, params->v_stride,
+        rtp_timestamp
+    );
     return SHIM_OK;
 }
 
+SHIM_EXPORT int shim_video_track_source_get_pool_stats(
+    ShimVideoTrackSourceGetPoolStatsParams* params
+) {
+    if (!params || !params->source || !params->source->source) {
+        return SHIM_ERROR_INVALID_PARAM;
+    }
+
+    params->pool_hits = params->source->source->pool_hits();
+    params->pool_misses = params->source->source->pool_misses();
+    return SHIM_OK;
+}
+
+SHIM_EXPORT ShimVideoFrameRing* shim_video_frame_ring_create(
+    ShimVideoFrameRingCreateParams* params
+) {
+    if (!params) {
+        return nullptr;
+    }
+    if (!params->source || !params->source->source) {
+        shim::SetErrorMessage(params->error_out, "invalid video track source", SHIM_ERROR_INVALID_PARAM);
+        return nullptr;
+    }
+    if (params->slots < 0 || static_cast<size_t>(params->slots) > VideoFrameRing::kMaxSlots) {
+        shim::SetErrorMessage(params->error_out, "slots must be between 0 and 64", SHIM_ERROR_INVALID_PARAM);
+        return nullptr;
+    }
+
+    size_t slots = 1;
+    size_t requested = params->slots > 0 ? static_cast<size_t>(params->slots) : VideoFrameRing::kDefaultSlots;
+    while (slots < requested) {
+        slots <<= 1;
+    }
+
+    auto ring = std::make_shared<VideoFrameRing>(params->source->source, slots);
+    if (!ring->Init(params->error_out)) {
+        return nullptr;
+    }
+    ring->Start(ring);
+
+    auto shim_ring = std::make_unique<ShimVideoFrameRing>();
+    shim_ring->ring = std::move(ring);
+    shim::ClearError(params->error_out);
+    return shim_ring.release();
+}
+
+SHIM_EXPORT ShimVideoFrameRingHeader* shim_video_frame_ring_header(ShimVideoFrameRing* ring) {
+    if (!ring) {
+        return nullptr;
+    }
+    return ring->ring->header();
+}
+
+SHIM_EXPORT void shim_video_frame_ring_destroy(ShimVideoFrameRing* ring) {
+    if (!ring) {
+        return;
+    }
+    ring->ring->Stop();
+    delete ring;
+}
+
 SHIM_EXPORT void shim_video_track_source_destroy(ShimVideoTrackSource* source) {
     if (source) {
         source->track = nullptr;
@@ -324,6 +702,7 @@ SHIM_EXPORT ShimAudioTrackSource* shim_audio_track_source_create(
 
     auto shim_source = std::make_unique<ShimAudioTrackSource>();
     shim_source->source = webrtc::make_ref_counted<PushableAudioSource>(sample_rate, channels);
+    shim_source->threads = pc->threads;
     shim_source->factory = pc->factory;  // Keep reference to factory
     shim_source->sample_rate = sample_rate;
     shim_source->channels = channels;
@@ -380,6 +759,7 @@ SHIM_EXPORT ShimRTPSender* shim_peer_connection_add_video_track_from_source(
         shim::SetErrorMessage(error_out, "CreateVideoTrack failed");
         return nullptr;
     }
+    shim::RegisterVideoSourceTrack(source->source->id(), source->track.get());
 
     // Ensure track is enabled
     source->track->set_enabled(true);
@@ -0,0 +1,885 @@
+/*
+ * shim_udp_mux.cc - Single-port UDP mux shared by PeerConnections
+ *
+ * By default every PeerConnection's port allocator opens its own UDP socket
+ * per network interface. A factory configured with udp_mux_port instead binds
+ * one wildcard socket per address family on that port (or a single socket on
+ * udp_mux_address), and each PeerConnection's allocator gets virtual sockets
+ * on top of it. Incoming packets are routed by remote address once it is
+ * known, by transaction ID for STUN responses, and by the local ICE username
+ * fragment of connectivity checks from new remotes.
+ */
+
+#include "shim_common.h"
+#include "shim_internal.h"
+
+#include <cerrno>
+#include <cstring>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <set>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#if defined(WEBRTC_POSIX)
+#include <fcntl.h>
+#include <netinet/in.h>
+#include <sys/socket.h>
+#include <sys/uio.h>
+#include <unistd.h>
+#endif
+
+#include "api/packet_socket_factory.h"
+#include "api/units/timestamp.h"
+#include "p2p/base/basic_packet_socket_factory.h"
+#include "p2p/client/basic_port_allocator.h"
+#include "rtc_base/async_packet_socket.h"
+#include "rtc_base/ip_address.h"
+#include "rtc_base/network.h"
+#include "rtc_base/network/received_packet.h"
+#include "rtc_base/network/sent_packet.h"
+#include "rtc_base/physical_socket_server.h"
+#include "rtc_base/socket_address.h"
+#include "rtc_base/thread.h"
+#include "rtc_base/time_utils.h"
+
+namespace shim {
+
+#if defined(WEBRTC_POSIX)
+
+namespace {
+
+constexpr int kRecvBatch = 32;
+constexpr size_t kMaxPacketSize = 2048;
+constexpr int kSocketBufferSize = 4 * 1024 * 1024;
+// Longest a STUN transaction can stay outstanding (RFC 5389 Rc=7 at 500 ms).
+constexpr int64_t kStunTransactionTimeoutMs = 40000;
+
+constexpr uint32_t kStunMagicCookie = 0x2112A442;
+constexpr uint16_t kStunBindingRequest = 0x0001;
+constexpr uint16_t kStunAttrUsername = 0x0006;
+constexpr size_t kStunHeaderSize = 20;
+
+// Minimal STUN view: enough to route a packet without a full parse.
+struct StunInfo {
+    bool is_stun = false;
+    uint16_t type = 0;
+    std::string transaction_id;
+    std::string local_ufrag;    // From USERNAME "local:remote" of a request
+};
+
+uint16_t ReadU16(const uint8_t* p) {
+    return static_cast<uint16_t>((p[0] << 8) | p[1]);
+}
+
+uint32_t ReadU32(const uint8_t* p) {
+    return (static_cast<uint32_t>(p[0]) << 24) | (static_cast<uint32_t>(p[1]) << 16) |
+           (static_cast<uint32_t>(p[2]) << 8) | p[3];
+}
+
+StunInfo ParseStun(const uint8_t* data, size_t size) {
+    StunInfo info;
+    // Top two bits zero, length a multiple of 4, magic cookie present.
+    if (size < kStunHeaderSize || (data[0] & 0xC0) != 0 ||
+        ReadU32(data + 4) != kStunMagicCookie) {
+        return info;
+    }
+    size_t length = ReadU16(data + 2);
+    if (length % 4 != 0 || kStunHeaderSize + length > size) {
+        return info;
+    }
+
+    info.is_stun = true;
+    info.type = ReadU16(data);
+    info.transaction_id.assign(reinterpret_cast<const char*>(data + 8), 12);
+
+    if (info.type != kStunBindingRequest) {
+        return info;
+    }
+    const uint8_t* attr = data + kStunHeaderSize;
+    const uint8_t* end = attr + length;
+    while (attr + 4 <= end) {
+        uint16_t attr_type = ReadU16(attr);
+        size_t attr_len = ReadU16(attr + 2);
+        if (attr + 4 + attr_len > end) {
+            break;
+        }
+        if (attr_type == kStunAttrUsername) {
+            std::string username(reinterpret_cast<const char*>(attr + 4), attr_len);
+            info.local_ufrag = username.substr(0, username.find(':'));
+            break;
+        }
+        attr += 4 + ((attr_len + 3) & ~size_t{3});
+    }
+    return info;
+}
+
+bool IsStunRequest(uint16_t type) {
+    return (type & 0x0110) == 0x0000;
+}
+
+bool IsStunResponse(uint16_t type) {
+    return (type & 0x0110) == 0x0100 || (type & 0x0110) == 0x0110;
+}
+
+}  // namespace
+
+class UDPMuxEndpoint;
+class UDPMuxSocket;
+
+/* ============================================================================
+ * UDPMux
+ * ========================================================================== */
+
+class UDPMux {
+public:
+    UDPMux(webrtc::Thread* network_thread, int port, const webrtc::IPAddress& address)
+        : network_thread_(network_thread), port_(port), address_(address) {}
+    ~UDPMux();
+
+    // Network thread. Binds the shared sockets.
+    bool Start(std::string* error);
+
+    webrtc::Thread* network_thread() const { return network_thread_; }
+    webrtc::NetworkManager* network_manager() const { return network_manager_.get(); }
+    int port() const { return port_; }
+
+    // Network thread. Endpoint for a local address, or null if the mux does
+    // not serve it.
+    UDPMuxEndpoint* EndpointFor(const webrtc::IPAddress& ip) const;
+
+    // Any thread.
+    void AddUfrag(const std::string& ufrag, UDPMuxSession* session);
+    void RemoveSession(UDPMuxSession* session);
+
+    // Network thread. Socket of the session owning ufrag on endpoint.
+    UDPMuxSocket* SocketForUfrag(const std::string& ufrag, UDPMuxEndpoint* endpoint,
+                                 const webrtc::IPAddress& local_ip);
+
+private:
+    webrtc::Thread* network_thread_;
+    int port_;
+    webrtc::IPAddress address_;   // Unspecified: wildcard sockets
+
+    std::unique_ptr<webrtc::NetworkManager> network_manager_;
+    std::unique_ptr<UDPMuxEndpoint> endpoint_v4_;
+    std::unique_ptr<UDPMuxEndpoint> endpoint_v6_;
+
+    std::mutex ufrag_mutex_;
+    std::unordered_map<std::string, UDPMuxSession*> sessions_by_ufrag_;
+};
+
+/* ============================================================================
+ * UDPMuxSession - per-PeerConnection socket factory
+ * ========================================================================== */
+
+class UDPMuxSession : public webrtc::BasicPacketSocketFactory {
+public:
+    explicit UDPMuxSession(std::shared_ptr<UDPMux> mux)
+        : webrtc::BasicPacketSocketFactory(mux->network_thread()->socketserver()),
+          mux_(std::move(mux)) {}
+    ~UDPMuxSession() override;
+
+    // UDP goes through the mux; TCP and DNS use the base factory.
+    webrtc::AsyncPacketSocket* CreateUdpSocket(const webrtc::SocketAddress& address,
+                                               uint16_t min_port,
+                                               uint16_t max_port) override;
+
+    UDPMux* mux() const { return mux_.get(); }
+
+    // Network thread.
+    void RemoveSocket(UDPMuxSocket* socket);
+    UDPMuxSocket* SocketOn(UDPMuxEndpoint* endpoint, const webrtc::IPAddress& local_ip) const;
+
+private:
+    std::shared_ptr<UDPMux> mux_;
+    std::vector<UDPMuxSocket*> sockets_;   // Network thread; newest last
+};
+
+/* ============================================================================
+ * UDPMuxEndpoint - one real socket, registered with the network thread
+ * ========================================================================== */
+
+class UDPMuxEndpoint : public webrtc::Dispatcher {
+public:
+    UDPMuxEndpoint(webrtc::PhysicalSocketServer* socket_server, int fd,
+                   const webrtc::SocketAddress& bound)
+        : socket_server_(socket_server), fd_(fd), bound_(bound),
+          buffers_(kRecvBatch * kMaxPacketSize) {
+        socket_server_->Add(this);
+    }
+
+    ~UDPMuxEndpoint() override {
+        socket_server_->Remove(this);
+        close(fd_);
+    }
+
+    const webrtc::SocketAddress& bound() const { return bound_; }
+
+    int SendTo(const void* data, size_t size, const webrtc::SocketAddress& to,
+               const webrtc::IPAddress& from, int* error);
+
+    // Routing state, network thread only.
+    void MapRemote(const webrtc::SocketAddress& remote, UDPMuxSocket* socket);
+    void MapTransaction(const std::string& transaction_id, UDPMuxSocket* socket);
+    void Unmap(UDPMuxSocket* socket, const std::vector<webrtc::SocketAddress>& remotes,
+               const std::set<std::string>& transactions);
+    void AddSocket(UDPMuxSocket* socket) { sockets_.insert(socket); }
+    void RemoveSocket(UDPMuxSocket* socket) { sockets_.erase(socket); }
+
+    void SetMux(UDPMux* mux) { mux_ = mux; }
+
+    // webrtc::Dispatcher
+    uint32_t GetRequestedEvents() override {
+        return webrtc::DE_READ | (want_write_ ? webrtc::DE_WRITE : 0);
+    }
+    void OnEvent(uint32_t ff, int err) override;
+    int GetDescriptor() override { return fd_; }
+    bool IsDescriptorClosed() override { return false; }
+
+private:
+    struct Transaction {
+        UDPMuxSocket* socket;
+        int64_t sent_ms;
+    };
+
+    void ReadPackets();
+    void Route(const uint8_t* data, size_t size, const webrtc::SocketAddress& from,
+               const webrtc::IPAddress& to, int64_t arrival_us);
+    void SweepTransactions(int64_t now_ms);
+
+    webrtc::PhysicalSocketServer* socket_server_;
+    UDPMux* mux_ = nullptr;
+    int fd_;
+    webrtc::SocketAddress bound_;
+    bool want_write_ = false;
+
+    std::vector<uint8_t> buffers_;
+    std::map<webrtc::SocketAddress, UDPMuxSocket*> by_remote_;
+    std::unordered_map<std::string, Transaction> by_transaction_;
+    std::set<UDPMuxSocket*> sockets_;
+    int64_t last_sweep_ms_ = 0;
+};
+
+/* ============================================================================
+ * UDPMuxSocket - what a UDPPort sees
+ * ========================================================================== */
+
+class UDPMuxSocket : public webrtc::AsyncPacketSocket {
+public:
+    UDPMuxSocket(std::shared_ptr<UDPMux> mux, UDPMuxEndpoint* endpoint,
+                 UDPMuxSession* session, const webrtc::SocketAddress& local)
+        : mux_(std::move(mux)), endpoint_(endpoint), session_(session), local_(local) {
+        endpoint_->AddSocket(this);
+    }
+
+    ~UDPMuxSocket() override {
+        endpoint_->RemoveSocket(this);
+        endpoint_->Unmap(this, remotes_, transactions_);
+        if (session_) {
+            session_->RemoveSocket(this);
+        }
+    }
+
+    UDPMuxEndpoint* endpoint() const { return endpoint_; }
+    void DetachSession() { session_ = nullptr; }
+
+    void Deliver(const uint8_t* data, size_t size, const webrtc::SocketAddress& from,
+                 int64_t arrival_us) {
+        if (closed_) {
+            return;
+        }
+        NotifyPacketReceived(webrtc::ReceivedIpPacket(
+            webrtc::ArrayView<const uint8_t>(data, size), from,
+            webrtc::Timestamp::Micros(arrival_us)));
+    }
+
+    void OnReadyToSend() {
+        if (!closed_) {
+            SignalReadyToSend(this);
+        }
+    }
+
+    void ForgetRemote(const webrtc::SocketAddress& remote) {
+        for (auto it = remotes_.begin(); it != remotes_.end(); ++it) {
+            if (*it == remote) {
+                remotes_.erase(it);
+                return;
+            }
+        }
+    }
+
+    void ForgetTransaction(const std::string& transaction_id) {
+        transactions_.erase(transaction_id);
+    }
+
+    void RememberRemote(const webrtc::SocketAddress& remote) {
+        for (const auto& known : remotes_) {
+            if (known == remote) {
+                return;
+            }
+        }
+        remotes_.push_back(remote);
+        endpoint_->MapRemote(remote, this);
+    }
+
+    // webrtc::AsyncPacketSocket
+    webrtc::SocketAddress GetLocalAddress() const override { return local_; }
+    webrtc::SocketAddress GetRemoteAddress() const override { return webrtc::SocketAddress(); }
+
+    int Send(const void* pv, size_t cb, const webrtc::AsyncSocketPacketOptions& options) override {
+        error_ = ENOTCONN;
+        return -1;
+    }
+
+    int SendTo(const void* pv, size_t cb, const webrtc::SocketAddress& addr,
+               const webrtc::AsyncSocketPacketOptions& options) override {
+        if (closed_) {
+            error_ = EBADF;
+            return -1;
+        }
+
+        const uint8_t* data = static_cast<const uint8_t*>(pv);
+        StunInfo stun = ParseStun(data, cb);
+        if (stun.is_stun && IsStunRequest(stun.type)) {
+            // Responses come back from servers shared by many sessions.
+            if (transactions_.insert(stun.transaction_id).second) {
+                endpoint_->MapTransaction(stun.transaction_id, this);
+            }
+        }
+        RememberRemote(addr);
+
+        webrtc::SentPacketInfo sent_packet(options.packet_id, webrtc::TimeMillis(),
+                                           options.info_signaled_after_sent);
+        webrtc::CopySocketInformationToPacketInfo(cb, *this, &sent_packet.info);
+
+        int ret = endpoint_->SendTo(pv, cb, addr, local_.ipaddr(), &error_);
+        SignalSentPacket(this, sent_packet);
+        return ret;
+    }
+
+    int Close() override {
+        closed_ = true;
+        return 0;
+    }
+
+    State GetState() const override { return closed_ ? STATE_CLOSED : STATE_BOUND; }
+
+    // The real socket is shared, so per-port options are not applied to it.
+    int GetOption(webrtc::Socket::Option opt, int* value) override {
+        error_ = ENOPROTOOPT;
+        return -1;
+    }
+    int SetOption(webrtc::Socket::Option opt, int value) override { return 0; }
+
+    int GetError() const override { return error_; }
+    void SetError(int error) override { error_ = error; }
+
+private:
+    std::shared_ptr<UDPMux> mux_;   // Keeps endpoint_ alive
+    UDPMuxEndpoint* endpoint_;
+    UDPMuxSession* session_;
+    webrtc::SocketAddress local_;
+    bool closed_ = false;
+    int error_ = 0;
+
+    std::vector<webrtc::SocketAddress> remotes_;
+    std::set<std::string> transactions_;
+};
+
+/* ============================================================================
+ * UDPMuxEndpoint implementation
+ * ========================================================================== */
+
+int UDPMuxEndpoint::SendTo(const void* data, size_t size, const webrtc::SocketAddress& to,
+                           const webrtc::IPAddress& from, int* error) {
+    sockaddr_storage addr;
+    socklen_t addr_len = static_cast<socklen_t>(to.ToSockAddrStorage(&addr));
+    if (addr_len == 0) {
+        *error = EINVAL;
+        return -1;
+    }
+
+    iovec iov;
+    iov.iov_base = const_cast<void*>(data);
+    iov.iov_len = size;
+
+    msghdr msg = {};
+    msg.msg_name = &addr;
+    msg.msg_namelen = addr_len;
+    msg.msg_iov = &iov;
+    msg.msg_iovlen = 1;
+
+#if defined(WEBRTC_LINUX)
+    // A wildcard socket would let the kernel pick the source address; pin it
+    // to the address of the candidate the packet belongs to.
+    alignas(cmsghdr) char control[CMSG_SPACE(sizeof(in6_pktinfo))] = {};
+    if (bound_.ipaddr().IsNil() || webrtc::IPIsAny(bound_.ipaddr())) {
+        if (from.family() == AF_INET && to.family() == AF_INET) {
+            msg.msg_control = control;
+            msg.msg_controllen = CMSG_SPACE(sizeof(in_pktinfo));
+            cmsghdr* cmsg = CMSG_FIRSTHDR(&msg);
+            cmsg->cmsg_level = IPPROTO_IP;
+            cmsg->cmsg_type = IP_PKTINFO;
+            cmsg->cmsg_len = CMSG_LEN(sizeof(in_pktinfo));
+            in_pktinfo pktinfo = {};
+            pktinfo.ipi_spec_dst = from.ipv4_address();
+            memcpy(CMSG_DATA(cmsg), &pktinfo, sizeof(pktinfo));
+        } else if (from.family() == AF_INET6 && to.family() == AF_INET6) {
+            msg.msg_control = control;
+            msg.msg_controllen = CMSG_SPACE(sizeof(in6_pktinfo));
+            cmsghdr* cmsg = CMSG_FIRSTHDR(&msg);
+            cmsg->cmsg_level = IPPROTO_IPV6;
+            cmsg->cmsg_type = IPV6_PKTINFO;
+            cmsg->cmsg_len = CMSG_LEN(sizeof(in6_pktinfo));
+            in6_pktinfo pktinfo = {};
+            pktinfo.ipi6_addr = from.ipv6_address();
+            memcpy(CMSG_DATA(cmsg), &pktinfo, sizeof(pktinfo));
+        }
+    }
+#endif
+
+    ssize_t sent = sendmsg(fd_, &msg, 0);
+    if (sent < 0) {
+        *error = errno;
+        if (errno == EAGAIN || errno == EWOULDBLOCK) {
+            if (!want_write_) {
+                want_write_ = true;
+                socket_server_->Update(this);
+            }
+        }
+        return -1;
+    }
+    return static_cast<int>(sent);
+}
+
+void UDPMuxEndpoint::OnEvent(uint32_t ff, int err) {
+    if (ff & webrtc::DE_READ) {
+        ReadPackets();
+    }
+    if ((ff & webrtc::DE_WRITE) && want_write_) {
+        want_write_ = false;
+        socket_server_->Update(this);
+        std::vector<UDPMuxSocket*> sockets(sockets_.begin(), sockets_.end());
+        for (UDPMuxSocket* socket : sockets) {
+            if (sockets_.count(socket)) {
+                socket->OnReadyToSend();
+            }
+        }
+    }
+}
+
+void UDPMuxEndpoint::ReadPackets() {
+#if defined(WEBRTC_LINUX)
+    mmsghdr msgs[kRecvBatch];
+    iovec iovs[kRecvBatch];
+    sockaddr_storage addrs[kRecvBatch];
+    alignas(cmsghdr) char controls[kRecvBatch][CMSG_SPACE(sizeof(in6_pktinfo))];
+
+    // Bounded so one busy socket cannot starve the rest of the network thread.
+    for (int round = 0; round < 8; round++) {
+        for (int i = 0; i < kRecvBatch; i++) {
+            iovs[i].iov_base = buffers_.data() + i * kMaxPacketSize;
+            iovs[i].iov_len = kMaxPacketSize;
+            msgs[i].msg_hdr = {};
+            msgs[i].msg_hdr.msg_name = &addrs[i];
+            msgs[i].msg_hdr.msg_namelen = sizeof(addrs[i]);
+            msgs[i].msg_hdr.msg_iov = &iovs[i];
+            msgs[i].msg_hdr.msg_iovlen = 1;
+            msgs[i].msg_hdr.msg_control = controls[i];
+            msgs[i].msg_hdr.msg_controllen = sizeof(controls[i]);
+            msgs[i].msg_len = 0;
+        }
+
+        int count = recvmmsg(fd_, msgs, kRecvBatch, MSG_DONTWAIT, nullptr);
+        if (count <= 0) {
+            return;
+        }
+
+        int64_t arrival_us = webrtc::TimeMicros();
+        for (int i = 0; i < count; i++) {
+            if (msgs[i].msg_hdr.msg_flags & MSG_TRUNC) {
+                continue;
+            }
+            webrtc::SocketAddress from;
+            webrtc::SocketAddressFromSockAddrStorage(addrs[i], &from);
+
+            webrtc::IPAddress to;
+            for (cmsghdr* cmsg = CMSG_FIRSTHDR(&msgs[i].msg_hdr); cmsg;
+                 cmsg = CMSG_NXTHDR(&msgs[i].msg_hdr, cmsg)) {
+                if (cmsg->cmsg_level == IPPROTO_IP && cmsg->cmsg_type == IP_PKTINFO) {
+                    in_pktinfo pktinfo;
+                    memcpy(&pktinfo, CMSG_DATA(cmsg), sizeof(pktinfo));
+                    to = webrtc::IPAddress(pktinfo.ipi_addr);
+                } else if (cmsg->cmsg_level == IPPROTO_IPV6 && cmsg->cmsg_type == IPV6_PKTINFO) {
+                    in6_pktinfo pktinfo;
+                    memcpy(&pktinfo, CMSG_DATA(cmsg), sizeof(pktinfo));
+                    to = webrtc::IPAddress(pktinfo.ipi6_addr);
+                }
+            }
+            Route(buffers_.data() + i * kMaxPacketSize, msgs[i].msg_len, from, to, arrival_us);
+        }
+        if (count < kRecvBatch) {
+            return;
+        }
+    }
+#else
+    for (int i = 0; i < 8 * kRecvBatch; i++) {
+        sockaddr_storage addr;
+        socklen_t addr_len = sizeof(addr);
+        ssize_t size = recvfrom(fd_, buffers_.data(), kMaxPacketSize, 0,
+                                reinterpret_cast<sockaddr*>(&addr), &addr_len);
+        if (size < 0) {
+            return;
+        }
+        webrtc::SocketAddress from;
+        webrtc::SocketAddressFromSockAddrStorage(addr, &from);
+        Route(buffers_.data(), static_cast<size_t>(size), from, webrtc::IPAddress(),
+              webrtc::TimeMicros());
+    }
+#endif
+}
+
+void UDPMuxEndpoint::Route(const uint8_t* data, size_t size, const webrtc::SocketAddress& from,
+                           const webrtc::IPAddress& to, int64_t arrival_us) {
+    StunInfo stun = ParseStun(data, size);
+
+    if (stun.is_stun && IsStunResponse(stun.type)) {
+        auto it = by_transaction_.find(stun.transaction_id);
+        if (it != by_transaction_.end()) {
+            UDPMuxSocket* socket = it->second.socket;
+            by_transaction_.erase(it);
+            socket->ForgetTransaction(stun.transaction_id);
+            socket->Deliver(data, size, from, arrival_us);
+            return;
+        }
+    }
+
+    auto it = by_remote_.find(from);
+    if (it != by_remote_.end()) {
+        it->second->Deliver(data, size, from, arrival_us);
+        return;
+    }
+
+    // A connectivity check from a new remote names the session in USERNAME.
+    if (stun.is_stun && !stun.local_ufrag.empty() && mux_) {
+        UDPMuxSocket* socket = mux_->SocketForUfrag(stun.local_ufrag, this, to);
+        if (socket) {
+            socket->RememberRemote(from);
+            socket->Deliver(data, size, from, arrival_us);
+        }
+    }
+    // Anything else has no owner yet and is dropped.
+}
+
+void UDPMuxEndpoint::MapRemote(const webrtc::SocketAddress& remote, UDPMuxSocket* socket) {
+    auto it = by_remote_.find(remote);
+    if (it != by_remote_.end() && it->second != socket) {
+        // The remote moved to another session; the old one stops receiving from it.
+        it->second->ForgetRemote(remote);
+    }
+    by_remote_[remote] = socket;
+}
+
+void UDPMuxEndpoint::MapTransaction(const std::string& transaction_id, UDPMuxSocket* socket) {
+    int64_t now_ms = webrtc::TimeMillis();
+    by_transaction_[transaction_id] = Transaction{socket, now_ms};
+    if (now_ms - last_sweep_ms_ > kStunTransactionTimeoutMs / 4) {
+        SweepTransactions(now_ms);
+    }
+}
+
+void UDPMuxEndpoint::SweepTransactions(int64_t now_ms) {
+    last_sweep_ms_ = now_ms;
+    for (auto it = by_transaction_.begin(); it != by_transaction_.end();) {
+        if (now_ms - it->second.sent_ms > kStunTransactionTimeoutMs) {
+            it->second.socket->ForgetTransaction(it->first);
+            it = by_transaction_.erase(it);
+        } else {
+            ++it;
+        }
+    }
+}
+
+void UDPMuxEndpoint::Unmap(UDPMuxSocket* socket,
+                           const std::vector<webrtc::SocketAddress>& remotes,
+                           const std::set<std::string>& transactions) {
+    for (const auto& remote : remotes) {
+        auto it = by_remote_.find(remote);
+        if (it != by_remote_.end() && it->second == socket) {
+            by_remote_.erase(it);
+        }
+    }
+    for (const auto& transaction_id : transactions) {
+        auto it = by_transaction_.find(transaction_id);
+        if (it != by_transaction_.end() && it->second.socket == socket) {
+            by_transaction_.erase(it);
+        }
+    }
+}
+
+/* ============================================================================
+ * UDPMux implementation
+ * ========================================================================== */
+
+namespace {
+
+// Bind a non-blocking UDP socket. Returns -1 with error set on failure.
+int BindUDPSocket(const webrtc::SocketAddress& address, std::string* error) {
+    int family = address.ipaddr().family();
+    int fd = socket(family, SOCK_DGRAM, 0);
+    if (fd < 0) {
+        *error = std::string("socket failed: ") + strerror(errno);
+        return -1;
+    }
+    fcntl(fd, F_SETFL, fcntl(fd, F_GETFL) | O_NONBLOCK);
+    fcntl(fd, F_SETFD, FD_CLOEXEC);
+
+    int one = 1;
+    int buffer_size = kSocketBufferSize;
+    setsockopt(fd, SOL_SOCKET, SO_RCVBUF, &buffer_size, sizeof(buffer_size));
+    setsockopt(fd, SOL_SOCKET, SO_SNDBUF, &buffer_size, sizeof(buffer_size));
+    if (family == AF_INET6) {
+        setsockopt(fd, IPPROTO_IPV6, IPV6_V6ONLY, &one, sizeof(one));
+    }
+#if defined(WEBRTC_LINUX)
+    // Destination addresses let a wildcard socket tell interfaces apart.
+    if (family == AF_INET) {
+        setsockopt(fd, IPPROTO_IP, IP_PKTINFO, &one, sizeof(one));
+    } else {
+        setsockopt(fd, IPPROTO_IPV6, IPV6_RECVPKTINFO, &one, sizeof(one));
+    }
+#endif
+
+    sockaddr_storage addr;
+    socklen_t addr_len = static_cast<socklen_t>(address.ToSockAddrStorage(&addr));
+    if (bind(fd, reinterpret_cast<sockaddr*>(&addr), addr_len) != 0) {
+        *error = "bind " + address.ToString() + " failed: " + strerror(errno);
+        close(fd);
+        return -1;
+    }
+    return fd;
+}
+
+}  // namespace
+
+UDPMux::~UDPMux() {
+    // Endpoints are registered with the network thread's socket server.
+    network_thread_->BlockingCall([this] {
+        endpoint_v4_.reset();
+        endpoint_v6_.reset();
+        network_manager_.reset();
+    });
+}
+
+bool UDPMux::Start(std::string* error) {
+    // Created on the network thread, which is the only thread using it.
+    auto* socket_server = static_cast<webrtc::PhysicalSocketServer*>(network_thread_->socketserver());
+    network_manager_ = std::make_unique<webrtc::BasicNetworkManager>(
+        GetEnvironment(), socket_server);
+
+    auto bind_endpoint = [&](const webrtc::IPAddress& ip, std::unique_ptr<UDPMuxEndpoint>* out) {
+        webrtc::SocketAddress address(ip, port_);
+        int fd = BindUDPSocket(address, error);
+        if (fd < 0) {
+            return false;
+        }
+        *out = std::make_unique<UDPMuxEndpoint>(socket_server, fd, address);
+        (*out)->SetMux(this);
+        return true;
+    };
+
+    if (!address_.IsNil()) {
+        return bind_endpoint(address_, address_.family() == AF_INET6 ? &endpoint_v6_ : &endpoint_v4_);
+    }
+
+    if (!bind_endpoint(webrtc::IPAddress(INADDR_ANY), &endpoint_v4_)) {
+        return false;
+    }
+    // IPv6 is best effort; hosts without it still get the IPv4 mux.
+    if (!bind_endpoint(webrtc::IPAddress(in6addr_any), &endpoint_v6_)) {
+        error->clear();
+    }
+    return true;
+}
+
+UDPMuxEndpoint* UDPMux::EndpointFor(const webrtc::IPAddress& ip) const {
+    if (!address_.IsNil() && ip != address_) {
+        return nullptr;
+    }
+    return ip.family() == AF_INET6 ? endpoint_v6_.get() : endpoint_v4_.get();
+}
+
+void UDPMux::AddUfrag(const std::string& ufrag, UDPMuxSession* session) {
+    std::lock_guard<std::mutex> lock(ufrag_mutex_);
+    sessions_by_ufrag_[ufrag] = session;
+}
+
+void UDPMux::RemoveSession(UDPMuxSession* session) {
+    std::lock_guard<std::mutex> lock(ufrag_mutex_);
+    for (auto it = sessions_by_ufrag_.begin(); it != sessions_by_ufrag_.end();) {
+        if (it->second == session) {
+            it = sessions_by_ufrag_.erase(it);
+        } else {
+            ++it;
+        }
+    }
+}
+
+UDPMuxSocket* UDPMux::SocketForUfrag(const std::string& ufrag, UDPMuxEndpoint* endpoint,
+                                     const webrtc::IPAddress& local_ip) {
+    // Held while the session is used so it cannot be destroyed underneath.
+    std::lock_guard<std::mutex> lock(ufrag_mutex_);
+    auto it = sessions_by_ufrag_.find(ufrag);
+    if (it == sessions_by_ufrag_.end()) {
+        return nullptr;
+    }
+    return it->second->SocketOn(endpoint, local_ip);
+}
+
+/* ============================================================================
+ * UDPMuxSession implementation
+ * ========================================================================== */
+
+UDPMuxSession::~UDPMuxSession() {
+    mux_->RemoveSession(this);
+    mux_->network_thread()->BlockingCall([this] {
+        for (UDPMuxSocket* socket : sockets_) {
+            socket->DetachSession();
+        }
+        sockets_.clear();
+    });
+}
+
+webrtc::AsyncPacketSocket* UDPMuxSession::CreateUdpSocket(const webrtc::SocketAddress& address,
+                                                          uint16_t min_port,
+                                                          uint16_t max_port) {
+    UDPMuxEndpoint* endpoint = mux_->EndpointFor(address.ipaddr());
+    if (!endpoint) {
+        return nullptr;
+    }
+    webrtc::SocketAddress local(address.ipaddr(), mux_->port());
+    auto* socket = new UDPMuxSocket(mux_, endpoint, this, local);
+    sockets_.push_back(socket);
+    return socket;
+}
+
+void UDPMuxSession::RemoveSocket(UDPMuxSocket* socket) {
+    for (auto it = sockets_.begin(); it != sockets_.end(); ++it) {
+        if (*it == socket) {
+            sockets_.erase(it);
+            return;
+        }
+    }
+}
+
+UDPMuxSocket* UDPMuxSession::SocketOn(UDPMuxEndpoint* endpoint, const webrtc::IPAddress& local_ip) const {
+    // Prefer the newest socket (latest ICE generation) for the interface the
+    // packet arrived on.
+    UDPMuxSocket* fallback = nullptr;
+    for (auto it = sockets_.rbegin(); it != sockets_.rend(); ++it) {
+        if ((*it)->endpoint() != endpoint) {
+            continue;
+        }
+        if (local_ip.IsNil() || (*it)->GetLocalAddress().ipaddr() == local_ip) {
+            return *it;
+        }
+        if (!fallback) {
+            fallback = *it;
+        }
+    }
+    return fallback;
+}
+
+#endif  // WEBRTC_POSIX
+
+/* ============================================================================
+ * Internal API
+ * ========================================================================== */
+
+bool CreateUDPMux(
+    const ShimPeerConnectionFactoryConfig* config,
+    int port_offset,
+    webrtc::Thread* network_thread,
+    std::shared_ptr<UDPMux>* mux,
+    ShimErrorBuffer* error_out
+) {
+    mux->reset();
+    if (!config || config->udp_mux_port == 0) {
+        return true;
+    }
+    if (config->loopback_network) {
+        SetErrorMessage(error_out, "udp_mux_port cannot be combined with loopback_network",
+                        SHIM_ERROR_INVALID_PARAM);
+        return false;
+    }
+
+#if defined(WEBRTC_POSIX)
+    int port = config->udp_mux_port + port_offset;
+    if (config->udp_mux_port < 0 || port > 65535) {
+        SetErrorMessage(error_out, "udp_mux_port out of range", SHIM_ERROR_INVALID_PARAM);
+        return false;
+    }
+
+    webrtc::IPAddress address;
+    if (config->udp_mux_address && *config->udp_mux_address &&
+        !webrtc::IPFromString(config->udp_mux_address, &address)) {
+        SetErrorMessage(error_out, std::string("invalid udp_mux_address: ") + config->udp_mux_address,
+                        SHIM_ERROR_INVALID_PARAM);
+        return false;
+    }
+
+    auto created = std::make_shared<UDPMux>(network_thread, port, address);
+    std::string error;
+    bool started = network_thread->BlockingCall([&] { return created->Start(&error); });
+    if (!started) {
+        SetErrorMessage(error_out, "udp mux: " + error);
+        return false;
+    }
+    *mux = std::move(created);
+    return true;
+#else
+    SetErrorMessage(error_out, "udp mux is only supported on POSIX platforms", SHIM_ERROR_NOT_SUPPORTED);
+    return false;
+#endif
+}
+
+#if defined(WEBRTC_POSIX)
+
+std::shared_ptr<UDPMuxSession> CreateUDPMuxSession(std::shared_ptr<UDPMux> mux) {
+    return std::make_shared<UDPMuxSession>(std::move(mux));
+}
+
+std::unique_ptr<webrtc::PortAllocator> CreateUDPMuxPortAllocator(UDPMuxSession* session) {
+    return std::make_unique<webrtc::BasicPortAllocator>(
+        GetEnvironment(), session->mux()->network_manager(), session);
+}
+
+void UDPMuxSessionAddLocalDescription(UDPMuxSession* session, const std::string& sdp) {
+    static const char kUfragPrefix[] = "a=ice-ufrag:";
+    size_t pos = 0;
+    while ((pos = sdp.find(kUfragPrefix, pos)) != std::string::npos) {
+        pos += sizeof(kUfragPrefix) - 1;
+        size_t end = sdp.find_first_of("\r\n", pos);
+        session->mux()->AddUfrag(sdp.substr(pos, end - pos), session);
+    }
+}
+
+#else
+
+// CreateUDPMux never produces a mux here, so these are unreachable.
+std::shared_ptr<UDPMuxSession> CreateUDPMuxSession(std::shared_ptr<UDPMux> mux) {
+    return nullptr;
+}
+
+std::unique_ptr<webrtc::PortAllocator> CreateUDPMuxPortAllocator(UDPMuxSession* session) {
+    return nullptr;
+}
+
+void UDPMuxSessionAddLocalDescription(UDPMuxSession* session, const std::string& sdp) {}
+
+#endif
+
+}  // namespace shim
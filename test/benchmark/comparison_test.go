@@ -1,6 +1,13 @@
 package benchmark
 
 import (
+	"fmt"
+	"os"
+	"runtime"
+	"strconv"
+	"strings"
+	"sync"
+	"sync/atomic"
 	"testing"
 	"time"
 
@@ -9,6 +16,7 @@ import (
 
 	"github.com/thesyncim/libgowebrtc/internal/ffi"
 	"github.com/thesyncim/libgowebrtc/pkg/codec"
+	"github.com/thesyncim/libgowebrtc/pkg/frame"
 	"github.com/thesyncim/libgowebrtc/pkg/pc"
 )
 
@@ -46,6 +54,129 @@ func BenchmarkPionPeerConnectionCreate(b *testing.B) {
 	}
 }
 
+// BenchmarkLibwebrtcPeerConnectionCreateSharedFactory benchmarks libwebrtc PC
+// creation when the media engine is built once and shared.
+func BenchmarkLibwebrtcPeerConnectionCreateSharedFactory(b *testing.B) {
+	factory, err := pc.NewFactory(pc.FactoryConfig{})
+	if err != nil {
+		b.Fatalf("NewFactory failed: %v", err)
+	}
+	defer factory.Close()
+
+	cfg := pc.DefaultConfiguration()
+	b.ResetTimer()
+	for i := 0; i < b.N; i++ {
+		pcConn, _ := factory.NewPeerConnection(cfg)
+		pcConn.Close()
+	}
+}
+
+// BenchmarkLibwebrtcPeerConnectionAcquire measures taking a pre-created
+// PeerConnection from a pool, against creating one on a shared factory
+// (BenchmarkLibwebrtcPeerConnectionCreateSharedFactory). The pool refills
+// outside the timed region.
+func BenchmarkLibwebrtcPeerConnectionAcquire(b *testing.B) {
+	factory, err := pc.NewFactory(pc.FactoryConfig{DisableAudioDevice: true})
+	if err != nil {
+		b.Fatalf("NewFactory failed: %v", err)
+	}
+	defer factory.Close()
+
+	const size = 16
+	pool, err := pc.NewPeerConnectionPool(pc.PoolConfig{
+		Configuration:     pc.DefaultConfiguration(),
+		Factory:           factory,
+		Size:              size,
+		AudioTransceivers: 1,
+		VideoTransceivers: 1,
+	})
+	if err != nil {
+		b.Fatalf("NewPeerConnectionPool failed: %v", err)
+	}
+	defer pool.Close()
+
+	waitReady := func() {
+		for pool.Ready() < size {
+			time.Sleep(time.Millisecond)
+		}
+	}
+
+	waitReady()
+	b.ResetTimer()
+	for i := 0; i < b.N; i++ {
+		pcConn, err := pool.Acquire()
+		if err != nil {
+			b.Fatalf("Acquire failed: %v", err)
+		}
+		b.StopTimer()
+		pcConn.Close()
+		waitReady()
+		b.StartTimer()
+	}
+}
+
+// BenchmarkLibwebrtcPeerConnectionRSS reports resident memory per live PC
+// with a private factory per PC vs one shared factory.
+func BenchmarkLibwebrtcPeerConnectionRSS(b *testing.B) {
+	if _, err := residentSetBytes(); err != nil {
+		b.Skipf("RSS not available: %v", err)
+	}
+
+	b.Run("PerPCFactory", func(b *testing.B) {
+		benchmarkPeerConnectionRSS(b, pc.NewPeerConnection)
+	})
+	b.Run("SharedFactory", func(b *testing.B) {
+		factory, err := pc.NewFactory(pc.FactoryConfig{})
+		if err != nil {
+			b.Fatalf("NewFactory failed: %v", err)
+		}
+		defer factory.Close()
+		benchmarkPeerConnectionRSS(b, factory.NewPeerConnection)
+	})
+}
+
+func benchmarkPeerConnectionRSS(b *testing.B, create func(pc.Configuration) (*pc.PeerConnection, error)) {
+	const count = 32
+	cfg := pc.DefaultConfiguration()
+	conns := make([]*pc.PeerConnection, count)
+
+	for i := 0; i < b.N; i++ {
+		runtime.GC()
+		before, _ := residentSetBytes()
+		for j := range conns {
+			pcConn, err := create(cfg)
+			if err != nil {
+				b.Fatalf("create PeerConnection failed: %v", err)
+			}
+			conns[j] = pcConn
+		}
+		after, _ := residentSetBytes()
+		b.ReportMetric(float64(after-before)/count/1024, "KiB-RSS/pc")
+
+		for j, pcConn := range conns {
+			pcConn.Close()
+			conns[j] = nil
+		}
+	}
+}
+
+// residentSetBytes returns the process resident set size (Linux only).
+func residentSetBytes() (int64, error) {
+	data, err := os.ReadFile("/proc/self/statm")
+	if err != nil {
+		return 0, err
+	}
+	fields := strings.Fields(string(data))
+	if len(fields) < 2 {
+		return 0, fmt.Errorf("unexpected statm format: %q", data)
+	}
+	pages, err := strconv.ParseInt(fields[1], 10, 64)
+	if err != nil {
+		return 0, err
+	}
+	return pages * int64(os.Getpagesize()), nil
+}
+
 // ============================================================================
 // Offer Creation Benchmarks
 // ============================================================================
@@ -75,6 +206,65 @@ func BenchmarkPionCreateOffer(b *testing.B) {
 	}
 }
 
+// BenchmarkLibwebrtcCreateOfferParallel benchmarks concurrent offer creation
+// across many PCs, comparing the shared global threads with sharded thread
+// groups. Throughput should scale with the shard count until cores run out.
+func BenchmarkLibwebrtcCreateOfferParallel(b *testing.B) {
+	const pcCount = 64
+
+	run := func(b *testing.B, newPC func() (*pc.PeerConnection, error)) {
+		pcs := make([]*pc.PeerConnection, pcCount)
+		for i := range pcs {
+			pcConn, err := newPC()
+			if err != nil {
+				b.Fatalf("NewPeerConnection failed: %v", err)
+			}
+			defer pcConn.Close()
+			pcs[i] = pcConn
+		}
+
+		var next atomic.Uint32
+		b.ResetTimer()
+		b.RunParallel(func(pb *testing.PB) {
+			pcConn := pcs[next.Add(1)%pcCount]
+			for pb.Next() {
+				_, _ = pcConn.CreateOffer(nil)
+			}
+		})
+	}
+
+	b.Run("GlobalThreads", func(b *testing.B) {
+		factory, err := pc.NewFactory(pc.FactoryConfig{DisableAudioDevice: true})
+		if err != nil {
+			b.Fatalf("NewFactory failed: %v", err)
+		}
+		defer factory.Close()
+		run(b, func() (*pc.PeerConnection, error) {
+			return factory.NewPeerConnection(pc.DefaultConfiguration())
+		})
+	})
+
+	shardCounts := []int{1, 2, 4}
+	if n := runtime.NumCPU(); n > 4 {
+		shardCounts = append(shardCounts, n)
+	}
+	for _, shards := range shardCounts {
+		b.Run(fmt.Sprintf("Shards-%d", shards), func(b *testing.B) {
+			group, err := pc.NewThreadGroup(pc.ThreadGroupConfig{
+				Shards:  shards,
+				Factory: pc.FactoryConfig{DisableAudioDevice: true},
+			})
+			if err != nil {
+				b.Fatalf("NewThreadGroup failed: %v", err)
+			}
+			defer group.Close()
+			run(b, func() (*pc.PeerConnection, error) {
+				return group.NewPeerConnection(pc.DefaultConfiguration())
+			})
+		})
+	}
+}
+
 // ============================================================================
 // Full Offer/Answer Exchange Benchmarks
 // ============================================================================
@@ -221,6 +411,27 @@ func BenchmarkFFIPeerConnectionCreate(b *testing.B) {
 	}
 }
 
+// BenchmarkFFIPeerConnectionCreateSharedFactory benchmarks raw FFI PC creation
+// on a shared factory.
+func BenchmarkFFIPeerConnectionCreateSharedFactory(b *testing.B) {
+	factory, err := ffi.CreatePeerConnectionFactory(nil)
+	if err != nil {
+		b.Fatalf("CreatePeerConnectionFactory failed: %v", err)
+	}
+	defer ffi.PeerConnectionFactoryDestroy(factory)
+
+	cfg := &ffi.PeerConnectionConfig{}
+
+	b.ResetTimer()
+	for i := 0; i < b.N; i++ {
+		handle, err := ffi.CreatePeerConnectionWithFactory(factory, cfg)
+		if err != nil {
+			b.Fatalf("CreatePeerConnectionWithFactory failed: %v", err)
+		}
+		ffi.PeerConnectionDestroy(handle)
+	}
+}
+
 // BenchmarkFFICreateOffer benchmarks raw FFI offer creation.
 func BenchmarkFFICreateOffer(b *testing.B) {
 	cfg := &ffi.PeerConnectionConfig{}
@@ -234,7 +445,7 @@ func BenchmarkFFICreateOffer(b *testing.B) {
 
 	b.ResetTimer()
 	for i := 0; i < b.N; i++ {
-		_, _ = ffi.PeerConnectionCreateOffer(handle, sdpBuf)
+		_, _ = ffi.PeerConnectionCreateOffer(handle, nil, sdpBuf)
 	}
 }
 
@@ -410,3 +621,454 @@ func BenchmarkPionDataChannelSend(b *testing.B) {
 		_ = dc.Send(data)
 	}
 }
+
+// BenchmarkLibwebrtcDataChannelThroughput measures data channel throughput
+// between two local PeerConnections over UDP, with libwebrtc's socket server
+// and the batched one (Linux only), and over an in-process loopback network.
+func BenchmarkLibwebrtcDataChannelThroughput(b *testing.B) {
+	servers := []struct {
+		name   string
+		server pc.SocketServer
+	}{
+		{"physical", pc.SocketServerPhysical},
+		{"batched", pc.SocketServerBatched},
+	}
+	for _, s := range servers {
+		b.Run(s.name, func(b *testing.B) {
+			group, err := pc.NewThreadGroup(pc.ThreadGroupConfig{
+				Shards:       1,
+				Factory:      pc.FactoryConfig{DisableAudioDevice: true},
+				SocketServer: s.server,
+			})
+			if err != nil {
+				b.Skipf("NewThreadGroup failed: %v", err)
+			}
+			defer group.Close()
+			benchmarkDataChannelThroughput(b, group)
+		})
+	}
+
+	b.Run("loopback", func(b *testing.B) {
+		network, err := pc.NewLoopbackNetwork(pc.LoopbackNetworkConfig{})
+		if err != nil {
+			b.Fatalf("NewLoopbackNetwork failed: %v", err)
+		}
+		defer network.Close()
+		group, err := pc.NewThreadGroup(pc.ThreadGroupConfig{
+			Shards:  1,
+			Factory: pc.FactoryConfig{DisableAudioDevice: true, Loopback: network},
+		})
+		if err != nil {
+			b.Fatalf("NewThreadGroup failed: %v", err)
+		}
+		defer group.Close()
+		benchmarkDataChannelThroughput(b, group)
+	})
+}
+
+func benchmarkDataChannelThroughput(b *testing.B, group *pc.ThreadGroup) {
+	const (
+		messageSize = 1024
+		window      = 256 // messages in flight, so the SCTP send buffer never fills
+	)
+
+	credits := make(chan struct{}, window)
+	dc, closePair := connectDataChannelPair(b, group, func([]byte) { <-credits })
+	defer closePair()
+
+	data := make([]byte, messageSize)
+	before := pc.GetSocketServerStats()
+	b.SetBytes(messageSize)
+	b.ResetTimer()
+	start := time.Now()
+
+	for i := 0; i < b.N; i++ {
+		credits <- struct{}{}
+		if err := dc.Send(data); err != nil {
+			b.Fatalf("Send failed: %v", err)
+		}
+	}
+	// Wait for the receiver to drain the window.
+	for i := 0; i < window; i++ {
+		credits <- struct{}{}
+	}
+
+	elapsed := time.Since(start)
+	b.StopTimer()
+	b.ReportMetric(float64(b.N*messageSize)/elapsed.Seconds()/1e6, "MB/s")
+
+	after := pc.GetSocketServerStats()
+	if recvCalls := after.RecvCalls - before.RecvCalls; recvCalls > 0 {
+		b.ReportMetric(float64(after.RecvPackets-before.RecvPackets)/float64(recvCalls), "pkts/recv")
+	}
+	if sendCalls := after.SendCalls - before.SendCalls; sendCalls > 0 {
+		b.ReportMetric(float64(after.SendPackets-before.SendPackets)/float64(sendCalls), "pkts/send")
+	}
+}
+
+// BenchmarkLibwebrtcLoopbackConnect measures how long a PeerConnection pair
+// takes to reach an open data channel over an in-process loopback network,
+// which keeps host networking noise out of connection setup numbers.
+func BenchmarkLibwebrtcLoopbackConnect(b *testing.B) {
+	network, err := pc.NewLoopbackNetwork(pc.LoopbackNetworkConfig{})
+	if err != nil {
+		b.Fatalf("NewLoopbackNetwork failed: %v", err)
+	}
+	defer network.Close()
+
+	group, err := pc.NewThreadGroup(pc.ThreadGroupConfig{
+		Factory: pc.FactoryConfig{DisableAudioDevice: true, Loopback: network},
+	})
+	if err != nil {
+		b.Fatalf("NewThreadGroup failed: %v", err)
+	}
+	defer group.Close()
+
+	b.ResetTimer()
+	for i := 0; i < b.N; i++ {
+		_, closePair := connectDataChannelPair(b, group, func([]byte) {})
+		closePair()
+	}
+}
+
+// connectDataChannelPair connects two PeerConnections from group and returns
+// the offerer's data channel once it is open. onMessage receives the
+// answerer's messages.
+func connectDataChannelPair(b *testing.B, group *pc.ThreadGroup, onMessage func([]byte)) (*pc.DataChannel, func()) {
+	b.Helper()
+
+	sender, err := group.NewPeerConnection(pc.DefaultConfiguration())
+	if err != nil {
+		b.Fatalf("NewPeerConnection failed: %v", err)
+	}
+	receiver, err := group.NewPeerConnection(pc.DefaultConfiguration())
+	if err != nil {
+		sender.Close()
+		b.Fatalf("NewPeerConnection failed: %v", err)
+	}
+	closePair := func() {
+		sender.Close()
+		receiver.Close()
+	}
+
+	sender.OnICECandidate = func(c *pc.ICECandidate) { _ = receiver.AddICECandidate(c) }
+	receiver.OnICECandidate = func(c *pc.ICECandidate) { _ = sender.AddICECandidate(c) }
+	receiver.OnDataChannel = func(dc *pc.DataChannel) { dc.SetOnMessage(onMessage) }
+
+	dc, err := sender.CreateDataChannel("bench", nil)
+	if err != nil {
+		closePair()
+		b.Fatalf("CreateDataChannel failed: %v", err)
+	}
+	opened := make(chan struct{})
+	var once sync.Once
+	dc.SetOnOpen(func() { once.Do(func() { close(opened) }) })
+
+	offer, err := sender.CreateOffer(nil)
+	if err == nil {
+		err = sender.SetLocalDescription(offer)
+	}
+	if err == nil {
+		err = receiver.SetRemoteDescription(offer)
+	}
+	var answer *pc.SessionDescription
+	if err == nil {
+		answer, err = receiver.CreateAnswer(nil)
+	}
+	if err == nil {
+		err = receiver.SetLocalDescription(answer)
+	}
+	if err == nil {
+		err = sender.SetRemoteDescription(answer)
+	}
+	if err != nil {
+		closePair()
+		b.Fatalf("offer/answer failed: %v", err)
+	}
+
+	select {
+	case <-opened:
+	case <-time.After(10 * time.Second):
+		closePair()
+		b.Fatal("data channel did not open")
+	}
+	return dc, closePair
+}
+
+// BenchmarkLibwebrtcStreamStats compares a full aggregated GetStats with
+// per-stream stats and with a sender selector, on a connection carrying
+// several video tracks. Polling many connections is dominated by this cost.
+func BenchmarkLibwebrtcStreamStats(b *testing.B) {
+	const tracks = 4
+
+	network, err := pc.NewLoopbackNetwork(pc.LoopbackNetworkConfig{})
+	if err != nil {
+		b.Fatalf("NewLoopbackNetwork failed: %v", err)
+	}
+	defer network.Close()
+	factory, err := pc.NewFactory(pc.FactoryConfig{DisableAudioDevice: true, Loopback: network})
+	if err != nil {
+		b.Fatalf("NewFactory failed: %v", err)
+	}
+	defer factory.Close()
+
+	offerer, err := factory.NewPeerConnection(pc.DefaultConfiguration())
+	if err != nil {
+		b.Fatalf("NewPeerConnection failed: %v", err)
+	}
+	defer offerer.Close()
+	answerer, err := factory.NewPeerConnection(pc.DefaultConfiguration())
+	if err != nil {
+		b.Fatalf("NewPeerConnection failed: %v", err)
+	}
+	defer answerer.Close()
+	offerer.OnICECandidate = func(c *pc.ICECandidate) { _ = answerer.AddICECandidate(c) }
+	answerer.OnICECandidate = func(c *pc.ICECandidate) { _ = offerer.AddICECandidate(c) }
+
+	var senders []*pc.RTPSender
+	for i := 0; i < tracks; i++ {
+		track, err := offerer.CreateVideoTrack(fmt.Sprintf("video-%d", i), codec.VP8, 320, 240)
+		if err != nil {
+			b.Fatalf("CreateVideoTrack failed: %v", err)
+		}
+		sender, err := offerer.AddTrack(track, "stream")
+		if err != nil {
+			b.Fatalf("AddTrack failed: %v", err)
+		}
+		senders = append(senders, sender)
+	}
+
+	offer, err := offerer.CreateOffer(nil)
+	if err == nil {
+		err = offerer.SetLocalDescription(offer)
+	}
+	if err == nil {
+		err = answerer.SetRemoteDescription(offer)
+	}
+	var answer *pc.SessionDescription
+	if err == nil {
+		answer, err = answerer.CreateAnswer(nil)
+	}
+	if err == nil {
+		err = answerer.SetLocalDescription(answer)
+	}
+	if err == nil {
+		err = offerer.SetRemoteDescription(answer)
+	}
+	if err != nil {
+		b.Fatalf("offer/answer failed: %v", err)
+	}
+
+	b.Run("aggregate", func(b *testing.B) {
+		b.ReportAllocs()
+		for i := 0; i < b.N; i++ {
+			if _, err := offerer.GetStats(); err != nil {
+				b.Fatalf("GetStats failed: %v", err)
+			}
+		}
+	})
+
+	b.Run("streams-delta", func(b *testing.B) {
+		var streams []pc.StreamStats
+		b.ReportAllocs()
+		for i := 0; i < b.N; i++ {
+			streams, err = offerer.AppendStreamStats(streams[:0], pc.StreamStatsOptions{Delta: true})
+			if err != nil {
+				b.Fatalf("AppendStreamStats failed: %v", err)
+			}
+		}
+	})
+
+	b.Run("sender-selector", func(b *testing.B) {
+		var streams []pc.StreamStats
+		b.ReportAllocs()
+		for i := 0; i < b.N; i++ {
+			streams, err = senders[i%tracks].AppendStreamStats(streams[:0], pc.StreamStatsOptions{})
+			if err != nil {
+				b.Fatalf("AppendStreamStats failed: %v", err)
+			}
+		}
+	})
+
+	// Pushed stats: the shim collects in the background and each poll only
+	// copies the new records out of the ring.
+	b.Run("ring-read", func(b *testing.B) {
+		ring, err := pc.NewStatsRing(0)
+		if err != nil {
+			b.Fatalf("NewStatsRing failed: %v", err)
+		}
+		defer ring.Close()
+		if err := ring.Subscribe(offerer, 10*time.Millisecond, 1); err != nil {
+			b.Fatalf("Subscribe failed: %v", err)
+		}
+		defer ring.Unsubscribe(offerer)
+
+		var records []pc.StatsRecord
+		b.ReportAllocs()
+		for i := 0; i < b.N; i++ {
+			records, err = ring.Read(records[:0])
+			if err != nil {
+				b.Fatalf("Read failed: %v", err)
+			}
+		}
+	})
+}
+
+// BenchmarkLibwebrtcCongestionControl compares congestion controllers on an
+// emulated 4 Mbps, 40 ms RTT link carrying one high-motion video track.
+// Each iteration connects a fresh pair and reports how long the target rate
+// takes to reach 80% of the link (ms-ramp) and the video bitrate actually
+// sent over the following seconds (kbps-steady).
+func BenchmarkLibwebrtcCongestionControl(b *testing.B) {
+	const linkKbps = 4000
+
+	controllers := []struct {
+		name string
+		cc   pc.CongestionControl
+	}{
+		{"googcc", pc.CongestionControl{}},
+		{"googcc-tuned", pc.CongestionControl{StartBitrateBps: 2_000_000, MinBitrateBps: 500_000}},
+		{"googcc-no-probing", pc.CongestionControl{DisableProbing: true}},
+		{"fixed", pc.CongestionControl{Controller: pc.CongestionControllerFixed, StartBitrateBps: linkKbps * 900}},
+	}
+	for _, c := range controllers {
+		b.Run(c.name, func(b *testing.B) {
+			var ramp time.Duration
+			var steadyKbps float64
+			for i := 0; i < b.N; i++ {
+				r, kbps := runCongestionControl(b, linkKbps, c.cc)
+				ramp += r
+				steadyKbps += kbps
+			}
+			b.ReportMetric(float64(ramp.Milliseconds())/float64(b.N), "ms-ramp")
+			b.ReportMetric(steadyKbps/float64(b.N), "kbps-steady")
+		})
+	}
+}
+
+func runCongestionControl(b *testing.B, linkKbps int, cc pc.CongestionControl) (time.Duration, float64) {
+	b.Helper()
+
+	network, err := pc.NewLoopbackNetwork(pc.LoopbackNetworkConfig{
+		BandwidthKbps: linkKbps,
+		Delay:         20 * time.Millisecond,
+		QueueLimit:    200 * time.Millisecond,
+	})
+	if err != nil {
+		b.Fatalf("NewLoopbackNetwork failed: %v", err)
+	}
+	defer network.Close()
+	factory, err := pc.NewFactory(pc.FactoryConfig{DisableAudioDevice: true, Loopback: network})
+	if err != nil {
+		b.Fatalf("NewFactory failed: %v", err)
+	}
+	defer factory.Close()
+
+	config := pc.DefaultConfiguration()
+	config.CongestionControl = cc
+	sender, err := factory.NewPeerConnection(config)
+	if err != nil {
+		b.Fatalf("NewPeerConnection failed: %v", err)
+	}
+	defer sender.Close()
+	receiver, err := factory.NewPeerConnection(pc.DefaultConfiguration())
+	if err != nil {
+		b.Fatalf("NewPeerConnection failed: %v", err)
+	}
+	defer receiver.Close()
+	sender.OnICECandidate = func(c *pc.ICECandidate) { _ = receiver.AddICECandidate(c) }
+	receiver.OnICECandidate = func(c *pc.ICECandidate) { _ = sender.AddICECandidate(c) }
+
+	rampTarget := int64(linkKbps) * 800
+	var firstEstimate, rampDone atomic.Int64
+	sender.SetOnBandwidthEstimate(func(bwe *pc.BandwidthEstimate) {
+		if bwe.TargetBitrateBps == 0 {
+			return
+		}
+		firstEstimate.CompareAndSwap(0, bwe.TimestampUs)
+		if bwe.TargetBitrateBps >= rampTarget {
+			rampDone.CompareAndSwap(0, bwe.TimestampUs)
+		}
+	})
+
+	track, err := sender.CreateVideoTrack("video", codec.VP8, 1280, 720)
+	if err != nil {
+		b.Fatalf("CreateVideoTrack failed: %v", err)
+	}
+	if _, err := sender.AddTrack(track, "stream"); err != nil {
+		b.Fatalf("AddTrack failed: %v", err)
+	}
+
+	offer, err := sender.CreateOffer(nil)
+	if err == nil {
+		err = sender.SetLocalDescription(offer)
+	}
+	if err == nil {
+		err = receiver.SetRemoteDescription(offer)
+	}
+	var answer *pc.SessionDescription
+	if err == nil {
+		answer, err = receiver.CreateAnswer(nil)
+	}
+	if err == nil {
+		err = receiver.SetLocalDescription(answer)
+	}
+	if err == nil {
+		err = sender.SetRemoteDescription(answer)
+	}
+	if err != nil {
+		b.Fatalf("offer/answer failed: %v", err)
+	}
+
+	// Noise defeats the encoder's compression, so the sent bitrate follows
+	// the target rate instead of the content.
+	done := make(chan struct{})
+	defer close(done)
+	go func() {
+		f := frame.NewI420Frame(1280, 720)
+		seed := uint32(1)
+		ticker := time.NewTicker(33 * time.Millisecond)
+		defer ticker.Stop()
+		for {
+			select {
+			case <-done:
+				return
+			case <-ticker.C:
+				for _, plane := range f.Data {
+					for j := range plane {
+						seed = seed*1664525 + 1013904223
+						plane[j] = byte(seed >> 24)
+					}
+				}
+				_ = track.WriteVideoFrame(f)
+			}
+		}
+	}()
+
+	deadline := time.Now().Add(30 * time.Second)
+	for rampDone.Load() == 0 {
+		if time.Now().After(deadline) {
+			b.Fatalf("target rate never reached %d bps", rampTarget)
+		}
+		time.Sleep(10 * time.Millisecond)
+	}
+	ramp := time.Duration(rampDone.Load()-firstEstimate.Load()) * time.Microsecond
+
+	// Delta stats over a steady window give the bitrate actually sent.
+	opts := pc.StreamStatsOptions{Delta: true}
+	if _, err := sender.AppendStreamStats(nil, opts); err != nil {
+		b.Fatalf("AppendStreamStats failed: %v", err)
+	}
+	time.Sleep(3 * time.Second)
+	streams, err := sender.AppendStreamStats(nil, opts)
+	if err != nil {
+		b.Fatalf("AppendStreamStats failed: %v", err)
+	}
+	var kbps float64
+	for _, s := range streams {
+		if s.Direction == pc.StreamOutbound {
+			kbps += s.BitrateBps / 1000
+		}
+	}
+	return ramp, kbps
+}
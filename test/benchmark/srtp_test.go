@@ -0,0 +1,257 @@
+package benchmark
+
+import (
+	"encoding/binary"
+	"testing"
+
+	pionsrtp "github.com/pion/srtp/v3"
+
+	"github.com/thesyncim/libgowebrtc/pkg/srtp"
+)
+
+// ============================================================================
+// SRTP Benchmarks (libsrtp via shim vs pion/srtp)
+// ============================================================================
+
+const (
+	srtpBatchSize   = 64
+	srtpPayloadSize = 1200
+)
+
+var srtpProfiles = []struct {
+	name string
+	lib  srtp.Profile
+	pion pionsrtp.ProtectionProfile
+}{
+	{"AES128_CM_SHA1_80", srtp.ProfileAES128CMHMACSHA1_80, pionsrtp.ProtectionProfileAes128CmHmacSha1_80},
+	{"AEAD_AES_128_GCM", srtp.ProfileAEADAES128GCM, pionsrtp.ProtectionProfileAeadAes128Gcm},
+}
+
+func srtpBenchKeys(p srtp.Profile) srtp.Keys {
+	k := srtp.Keys{Key: make([]byte, p.KeyLen()), Salt: make([]byte, p.SaltLen())}
+	for i := range k.Key {
+		k.Key[i] = byte(i + 1)
+	}
+	for i := range k.Salt {
+		k.Salt[i] = byte(0xA0 + i)
+	}
+	return k
+}
+
+// srtpBenchPacket writes an RTP header with the given sequence number
+// followed by a fixed payload into buf.
+func srtpBenchPacket(buf []byte, seq uint16) []byte {
+	buf = buf[:12+srtpPayloadSize]
+	buf[0] = 0x80
+	buf[1] = 96
+	binary.BigEndian.PutUint16(buf[2:], seq)
+	binary.BigEndian.PutUint32(buf[4:], uint32(seq)*3000)
+	binary.BigEndian.PutUint32(buf[8:], 0x12345678)
+	for i := 12; i < len(buf); i++ {
+		buf[i] = byte(i)
+	}
+	return buf
+}
+
+func newSRTPBatch() ([][]byte, [][]byte) {
+	storage := make([][]byte, srtpBatchSize)
+	batch := make([][]byte, srtpBatchSize)
+	for i := range storage {
+		storage[i] = make([]byte, 12+srtpPayloadSize+srtp.MaxTrailerLen)
+	}
+	return storage, batch
+}
+
+// BenchmarkLibwebrtcSRTPProtectRTP benchmarks batched in-place SRTP encryption
+// through libsrtp.
+func BenchmarkLibwebrtcSRTPProtectRTP(b *testing.B) {
+	for _, p := range srtpProfiles {
+		b.Run(p.name, func(b *testing.B) {
+			ctx, err := srtp.NewContext(srtp.Config{Profile: p.lib, Local: srtpBenchKeys(p.lib)})
+			if err != nil {
+				b.Fatalf("NewContext failed: %v", err)
+			}
+			defer ctx.Close()
+
+			storage, batch := newSRTPBatch()
+			var seq uint16
+
+			b.SetBytes(int64(srtpBatchSize * (12 + srtpPayloadSize)))
+			b.ReportAllocs()
+			b.ResetTimer()
+			for i := 0; i < b.N; i++ {
+				for j := range batch {
+					seq++
+					batch[j] = srtpBenchPacket(storage[j], seq)
+				}
+				if err := ctx.ProtectRTP(batch); err != nil {
+					b.Fatalf("ProtectRTP failed: %v", err)
+				}
+			}
+		})
+	}
+}
+
+// BenchmarkPionSRTPProtectRTP benchmarks pion SRTP encryption over the same
+// batch of packets.
+func BenchmarkPionSRTPProtectRTP(b *testing.B) {
+	for _, p := range srtpProfiles {
+		b.Run(p.name, func(b *testing.B) {
+			keys := srtpBenchKeys(p.lib)
+			ctx, err := pionsrtp.CreateContext(keys.Key, keys.Salt, p.pion)
+			if err != nil {
+				b.Fatalf("CreateContext failed: %v", err)
+			}
+
+			storage, batch := newSRTPBatch()
+			plain := make([]byte, 12+srtpPayloadSize)
+			var seq uint16
+
+			b.SetBytes(int64(srtpBatchSize * (12 + srtpPayloadSize)))
+			b.ReportAllocs()
+			b.ResetTimer()
+			for i := 0; i < b.N; i++ {
+				for j := range batch {
+					seq++
+					plain = srtpBenchPacket(plain, seq)
+					batch[j], err = ctx.EncryptRTP(storage[j][:0], plain, nil)
+					if err != nil {
+						b.Fatalf("EncryptRTP failed: %v", err)
+					}
+				}
+			}
+		})
+	}
+}
+
+// BenchmarkLibwebrtcSRTPRoundTripRTP benchmarks protect + unprotect of a batch
+// through libsrtp.
+func BenchmarkLibwebrtcSRTPRoundTripRTP(b *testing.B) {
+	for _, p := range srtpProfiles {
+		b.Run(p.name, func(b *testing.B) {
+			keys := srtpBenchKeys(p.lib)
+			tx, err := srtp.NewContext(srtp.Config{Profile: p.lib, Local: keys})
+			if err != nil {
+				b.Fatalf("NewContext failed: %v", err)
+			}
+			defer tx.Close()
+			rx, err := srtp.NewContext(srtp.Config{Profile: p.lib, Remote: keys})
+			if err != nil {
+				b.Fatalf("NewContext failed: %v", err)
+			}
+			defer rx.Close()
+
+			storage, batch := newSRTPBatch()
+			var seq uint16
+
+			b.SetBytes(int64(srtpBatchSize * (12 + srtpPayloadSize)))
+			b.ReportAllocs()
+			b.ResetTimer()
+			for i := 0; i < b.N; i++ {
+				for j := range batch {
+					seq++
+					batch[j] = srtpBenchPacket(storage[j], seq)
+				}
+				if err := tx.ProtectRTP(batch); err != nil {
+					b.Fatalf("ProtectRTP failed: %v", err)
+				}
+				if err := rx.UnprotectRTP(batch); err != nil {
+					b.Fatalf("UnprotectRTP failed: %v", err)
+				}
+			}
+		})
+	}
+}
+
+// BenchmarkPionSRTPRoundTripRTP benchmarks pion encrypt + decrypt of the same
+// batch of packets.
+func BenchmarkPionSRTPRoundTripRTP(b *testing.B) {
+	for _, p := range srtpProfiles {
+		b.Run(p.name, func(b *testing.B) {
+			keys := srtpBenchKeys(p.lib)
+			tx, err := pionsrtp.CreateContext(keys.Key, keys.Salt, p.pion)
+			if err != nil {
+				b.Fatalf("CreateContext failed: %v", err)
+			}
+			rx, err := pionsrtp.CreateContext(keys.Key, keys.Salt, p.pion)
+			if err != nil {
+				b.Fatalf("CreateContext failed: %v", err)
+			}
+
+			storage, batch := newSRTPBatch()
+			plain := make([]byte, 12+srtpPayloadSize)
+			out := make([]byte, 12+srtpPayloadSize)
+			var seq uint16
+
+			b.SetBytes(int64(srtpBatchSize * (12 + srtpPayloadSize)))
+			b.ReportAllocs()
+			b.ResetTimer()
+			for i := 0; i < b.N; i++ {
+				for j := range batch {
+					seq++
+					plain = srtpBenchPacket(plain, seq)
+					batch[j], err = tx.EncryptRTP(storage[j][:0], plain, nil)
+					if err != nil {
+						b.Fatalf("EncryptRTP failed: %v", err)
+					}
+					if _, err = rx.DecryptRTP(out[:0], batch[j], nil); err != nil {
+						b.Fatalf("DecryptRTP failed: %v", err)
+					}
+				}
+			}
+		})
+	}
+}
+
+// TestSRTPInteropWithPion verifies packets protected by libsrtp decrypt with
+// pion and vice versa, so the benchmarks compare equivalent work.
+func TestSRTPInteropWithPion(t *testing.T) {
+	for _, p := range srtpProfiles {
+		t.Run(p.name, func(t *testing.T) {
+			keys := srtpBenchKeys(p.lib)
+			lib, err := srtp.NewContext(srtp.Config{Profile: p.lib, Local: keys, Remote: keys})
+			if err != nil {
+				t.Fatalf("NewContext failed: %v", err)
+			}
+			defer lib.Close()
+			pionTx, err := pionsrtp.CreateContext(keys.Key, keys.Salt, p.pion)
+			if err != nil {
+				t.Fatalf("CreateContext failed: %v", err)
+			}
+			pionRx, err := pionsrtp.CreateContext(keys.Key, keys.Salt, p.pion)
+			if err != nil {
+				t.Fatalf("CreateContext failed: %v", err)
+			}
+
+			storage, batch := newSRTPBatch()
+			want := srtpBenchPacket(make([]byte, 12+srtpPayloadSize), 1)
+
+			// libsrtp -> pion
+			batch = batch[:1]
+			batch[0] = srtpBenchPacket(storage[0], 1)
+			if err := lib.ProtectRTP(batch); err != nil {
+				t.Fatalf("ProtectRTP failed: %v", err)
+			}
+			got, err := pionRx.DecryptRTP(nil, batch[0], nil)
+			if err != nil {
+				t.Fatalf("pion DecryptRTP failed: %v", err)
+			}
+			if string(got) != string(want) {
+				t.Fatal("pion decrypted payload mismatch")
+			}
+
+			// pion -> libsrtp
+			enc, err := pionTx.EncryptRTP(storage[1][:0], want, nil)
+			if err != nil {
+				t.Fatalf("pion EncryptRTP failed: %v", err)
+			}
+			batch[0] = enc
+			if err := lib.UnprotectRTP(batch); err != nil {
+				t.Fatalf("UnprotectRTP failed: %v", err)
+			}
+			if string(batch[0]) != string(want) {
+				t.Fatal("libsrtp decrypted payload mismatch")
+			}
+		})
+	}
+}